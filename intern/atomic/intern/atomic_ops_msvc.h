@@ -166,6 +166,28 @@ ATOMIC_INLINE int32_t atomic_fetch_and_and_int32(int32_t *p, int32_t x)
   return InterlockedAnd((long *)p, x);
 }
 
+/* Aligned 32-bit reads are atomic on all supported platforms, the volatile access keeps the
+ * compiler from caching them. */
+ATOMIC_INLINE uint32_t atomic_load_uint32(const uint32_t *v)
+{
+  return *(volatile const uint32_t *)v;
+}
+
+ATOMIC_INLINE void atomic_store_uint32(uint32_t *p, uint32_t v)
+{
+  InterlockedExchange((long *)p, v);
+}
+
+ATOMIC_INLINE int32_t atomic_load_int32(const int32_t *v)
+{
+  return *(volatile const int32_t *)v;
+}
+
+ATOMIC_INLINE void atomic_store_int32(int32_t *p, int32_t v)
+{
+  InterlockedExchange((long *)p, v);
+}
+
 /******************************************************************************/
 /* 16-bit operations. */
 
@@ -421,6 +421,34 @@ TEST(atomic, atomic_fetch_and_and_uint32)
   }
 }
 
+TEST(atomic, atomic_load_uint32)
+{
+  {
+    uint32_t value = 2;
+    EXPECT_EQ(atomic_load_uint32(&value), 2);
+  }
+
+  {
+    uint32_t value = 0x92345678;
+    EXPECT_EQ(atomic_load_uint32(&value), 0x92345678);
+  }
+}
+
+TEST(atomic, atomic_store_uint32)
+{
+  {
+    uint32_t value = 1;
+    atomic_store_uint32(&value, 2);
+    EXPECT_EQ(value, 2);
+  }
+
+  {
+    uint32_t value = 0;
+    atomic_store_uint32(&value, 0x92345678);
+    EXPECT_EQ(value, 0x92345678);
+  }
+}
+
 /** \} */
 
 /** \name 32 bit signed int atomics
@@ -557,6 +585,34 @@ TEST(atomic, atomic_fetch_and_and_int32)
   }
 }
 
+TEST(atomic, atomic_load_int32)
+{
+  {
+    int32_t value = 2;
+    EXPECT_EQ(atomic_load_int32(&value), 2);
+  }
+
+  {
+    int32_t value = -0x12345678;
+    EXPECT_EQ(atomic_load_int32(&value), -0x12345678);
+  }
+}
+
+TEST(atomic, atomic_store_int32)
+{
+  {
+    int32_t value = 1;
+    atomic_store_int32(&value, 2);
+    EXPECT_EQ(value, 2);
+  }
+
+  {
+    int32_t value = 0;
+    atomic_store_int32(&value, -0x12345678);
+    EXPECT_EQ(value, -0x12345678);
+  }
+}
+
 /** \} */
 
 /** \name 16 bit signed int atomics
@@ -20,6 +20,7 @@
 #include "scene/camera.h"
 #include "scene/integrator.h"
 #include "scene/scene.h"
+#include "scene/stats.h"
 #include "session/buffers.h"
 #include "session/session.h"
 
@@ -58,6 +59,8 @@ struct Options {
   bool show_help, interactive, pause;
   string output_filepath;
   string output_pass;
+  string stats_filepath;
+  vector<string> full_buffer_files;
 } options;
 
 static void session_print(const string &str)
@@ -135,6 +138,10 @@ static void session_init()
         options.output_filepath, options.output_pass, session_print));
   }
 
+  options.session->full_buffer_written_cb = [](string_view filename) {
+    options.full_buffer_files.push_back(string(filename));
+  };
+
   if (options.session_params.background && !options.quiet)
     options.session->progress.set_update_callback(function_bind(&session_print_status));
 #ifdef WITH_CYCLES_STANDALONE_GUI
@@ -145,6 +152,10 @@ static void session_init()
   /* load scene */
   scene_init();
 
+  if (!options.stats_filepath.empty()) {
+    options.scene->enable_update_stats();
+  }
+
   /* add pass for output. */
   Pass *pass = options.scene->create_node<Pass>();
   pass->set_name(ustring(options.output_pass.c_str()));
@@ -156,6 +167,30 @@ static void session_init()
 
 static void session_exit()
 {
+  /* With tiled rendering, tiles are streamed to a file on disk while rendering. Only read the full
+   * frame back once rendering has finished and the scene has been freed from the device, so that
+   * they are never in memory at the same time. */
+  if (options.session && options.session_params.background) {
+    if (!options.full_buffer_files.empty()) {
+      options.session->device_free();
+    }
+    for (const string &filename : options.full_buffer_files) {
+      options.session->process_full_buffer_from_disk(filename);
+      path_remove(filename);
+    }
+  }
+  options.full_buffer_files.clear();
+
+  if (options.session && !options.stats_filepath.empty()) {
+    RenderStats stats;
+    options.session->collect_statistics(&stats);
+
+    string report = stats.json_report();
+    if (!path_write_text(options.stats_filepath, report)) {
+      fprintf(stderr, "Failed to write render statistics to %s\n", options.stats_filepath.c_str());
+    }
+  }
+
   if (options.session) {
     delete options.session;
     options.session = NULL;
@@ -400,9 +435,16 @@ static void options_parse(int argc, const char **argv)
              "--samples %d",
              &options.session_params.samples,
              "Number of samples to render",
+             "--sample-offset %d",
+             &options.session_params.sample_offset,
+             "Index of the first sample to render, to split the samples of a frame between "
+             "multiple renders",
              "--output %s",
              &options.output_filepath,
              "File path to write output image",
+             "--render-stats %s",
+             &options.stats_filepath,
+             "File path to write render statistics to, as JSON",
              "--threads %d",
              &options.session_params.threads,
              "CPU Rendering Threads",
@@ -510,6 +552,10 @@ static void options_parse(int argc, const char **argv)
     fprintf(stderr, "Invalid number of samples: %d\n", options.session_params.samples);
     exit(EXIT_FAILURE);
   }
+  else if (options.session_params.sample_offset < 0) {
+    fprintf(stderr, "Invalid sample offset: %d\n", options.session_params.sample_offset);
+    exit(EXIT_FAILURE);
+  }
   else if (options.filepath == "") {
     fprintf(stderr, "No file path specified\n");
     exit(EXIT_FAILURE);
@@ -392,6 +392,13 @@ class CyclesRenderSettings(bpy.types.PropertyGroup):
         default=0.01,
     )
 
+    use_light_tree: BoolProperty(
+        name="Light Tree",
+        description="Sample lights by their estimated contribution to the shading point, using a hierarchy of the lamps and emissive objects. "
+        "Reduces noise in scenes with many lights",
+        default=False,
+    )
+
     use_adaptive_sampling: BoolProperty(
         name="Use Adaptive Sampling",
         description="Automatically reduce the number of samples per pixel based on estimated noise level",
@@ -412,6 +419,26 @@ class CyclesRenderSettings(bpy.types.PropertyGroup):
         default=0,
     )
 
+    use_guiding: BoolProperty(
+        name="Path Guiding",
+        description="Sample directions at diffuse surfaces from a distribution of the incoming light learned during the first samples. "
+        "Reduces noise in scenes lit indirectly through small openings. Only supported by CPU rendering",
+        default=False,
+    )
+    guiding_training_samples: IntProperty(
+        name="Training Samples",
+        description="Number of samples used to learn the distribution of incoming light",
+        min=1, max=(1 << 24),
+        default=128,
+    )
+    surface_guiding_probability: FloatProperty(
+        name="Surface Guiding Probability",
+        description="Probability of sampling a direction from the learned distribution instead of the BSDF at diffuse surfaces",
+        min=0.0, max=1.0,
+        default=0.5,
+        subtype='FACTOR',
+    )
+
     use_preview_adaptive_sampling: BoolProperty(
         name="Use Adaptive Sampling",
         description="Automatically reduce the number of samples per pixel based on estimated noise level, for viewport renders",
@@ -537,6 +564,13 @@ class CyclesRenderSettings(bpy.types.PropertyGroup):
         min=2, max=65536
     )
 
+    use_volume_empty_skip: BoolProperty(
+        name="Skip Empty Space",
+        description="Take increasingly larger steps through parts of volumes without density. "
+        "Renders faster, but thin details after empty space can be missed",
+        default=False,
+    )
+
     dicing_rate: FloatProperty(
         name="Dicing Rate",
         description="Size of a micropolygon in pixels",
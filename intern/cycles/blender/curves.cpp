@@ -841,6 +841,9 @@ void BlenderSync::sync_hair(BL::Depsgraph b_depsgraph, BObjectInfo &b_ob_info, H
 
   /* update original sockets */
 
+  const size_t old_num_keys = hair->num_keys();
+  const size_t old_num_curves = hair->num_curves();
+
   for (const SocketType &socket : new_hair.type->inputs) {
     /* Those sockets are updated in sync_object, so do not modify them. */
     if (socket.name == "use_motion_blur" || socket.name == "motion_steps" ||
@@ -854,9 +857,10 @@ void BlenderSync::sync_hair(BL::Depsgraph b_depsgraph, BObjectInfo &b_ob_info, H
 
   /* tag update */
 
-  /* Compares curve_keys rather than strands in order to handle quick hair
-   * adjustments in dynamic BVH - other methods could probably do this better. */
-  const bool rebuild = (hair->curve_keys_is_modified() || hair->curve_radius_is_modified());
+  /* Only rebuild the BVH when the curves changed, deformed keys are handled by refitting. This
+   * keeps the BVH of animated hair when rendering frames with persistent data. */
+  const bool rebuild = (hair->curve_first_key_is_modified() ||
+                        hair->num_keys() != old_num_keys || hair->num_curves() != old_num_curves);
 
   hair->tag_update(scene, rebuild);
 }
@@ -199,6 +199,13 @@ Geometry *BlenderSync::sync_geometry(BL::Depsgraph &b_depsgraph,
   return geom;
 }
 
+/* Geometry that is synced in this update may still be modified by the task pool, so it can't be
+ * tested for changes before the pool is done and is assumed to be modified. */
+bool BlenderSync::geometry_is_modified(Geometry *geom)
+{
+  return geometry_synced.find(geom) != geometry_synced.end() || geom->is_modified();
+}
+
 void BlenderSync::sync_geometry_motion(BL::Depsgraph &b_depsgraph,
                                        BObjectInfo &b_ob_info,
                                        Object *object,
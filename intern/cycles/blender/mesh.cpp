@@ -34,11 +34,26 @@
 #include "util/hash.h"
 #include "util/log.h"
 #include "util/math.h"
+#include "util/tbb.h"
 
 #include "mikktspace.h"
 
+#include "DNA_meshdata_types.h"
+
 CCL_NAMESPACE_BEGIN
 
+/* Direct access to the vertex array of a mesh, which avoids going through RNA for every
+ * vertex. Only valid for meshes with vertices. */
+static const MVert *mesh_verts(BL::Mesh &b_mesh)
+{
+  return static_cast<const MVert *>(b_mesh.vertices[0].ptr.data);
+}
+
+static inline float3 mvert_normal(const MVert &mvert)
+{
+  return make_float3(mvert.no[0], mvert.no[1], mvert.no[2]) * (1.0f / 32767.0f);
+}
+
 /* Tangent Space */
 
 struct MikkUserData {
@@ -938,17 +953,16 @@ static void create_mesh(Scene *scene,
   mesh->reserve_mesh(numverts, numtris);
 
   /* create vertex coordinates and normals */
-  BL::Mesh::vertices_iterator v;
-  for (b_mesh.vertices.begin(v); v != b_mesh.vertices.end(); ++v)
-    mesh->add_vertex(get_float3(v->co()));
+  const MVert *verts = mesh_verts(b_mesh);
+  for (int i = 0; i < numverts; i++) {
+    mesh->add_vertex(make_float3(verts[i].co[0], verts[i].co[1], verts[i].co[2]));
+  }
 
   AttributeSet &attributes = (subdivision) ? mesh->subd_attributes : mesh->attributes;
   Attribute *attr_N = attributes.add(ATTR_STD_VERTEX_NORMAL);
   float3 *N = attr_N->data_float3();
 
-  for (b_mesh.vertices.begin(v); v != b_mesh.vertices.end(); ++v, ++N)
-    *N = get_float3(v->normal());
-  N = attr_N->data_float3();
+  parallel_for(0, numverts, [&](int i) { N[i] = mvert_normal(verts[i]); });
 
   /* create generated coordinates from undeformed coordinates */
   const bool need_default_tangent = (subdivision == false) && (b_mesh.uv_layers.empty()) &&
@@ -963,6 +977,7 @@ static void create_mesh(Scene *scene,
     float3 *generated = attr->data_float3();
     size_t i = 0;
 
+    BL::Mesh::vertices_iterator v;
     for (b_mesh.vertices.begin(v); v != b_mesh.vertices.end(); ++v) {
       generated[i++] = get_float3(v->undeformed_co()) * size - loc;
     }
@@ -970,20 +985,18 @@ static void create_mesh(Scene *scene,
 
   /* create faces */
   if (!subdivision) {
-    for (BL::MeshLoopTriangle &t : b_mesh.loop_triangles) {
-      BL::MeshPolygon p = b_mesh.polygons[t.polygon_index()];
-      int3 vi = get_int3(t.vertices());
+    const MLoopTri *looptris = static_cast<const MLoopTri *>(b_mesh.loop_triangles[0].ptr.data);
+    const MLoop *loops = static_cast<const MLoop *>(b_mesh.loops[0].ptr.data);
+    const MPoly *polys = static_cast<const MPoly *>(b_mesh.polygons[0].ptr.data);
 
-      int shader = clamp(p.material_index(), 0, used_shaders.size() - 1);
-      bool smooth = p.use_smooth() || use_loop_normals;
+    for (int t = 0; t < numtris; t++) {
+      const MLoopTri &looptri = looptris[t];
+      const MPoly &poly = polys[looptri.poly];
+      int3 vi = make_int3(
+          loops[looptri.tri[0]].v, loops[looptri.tri[1]].v, loops[looptri.tri[2]].v);
 
-      if (use_loop_normals) {
-        BL::Array<float, 9> loop_normals = t.split_normals();
-        for (int i = 0; i < 3; i++) {
-          N[vi[i]] = make_float3(
-              loop_normals[i * 3], loop_normals[i * 3 + 1], loop_normals[i * 3 + 2]);
-        }
-      }
+      int shader = clamp(int(poly.mat_nr), 0, used_shaders.size() - 1);
+      bool smooth = (poly.flag & ME_SMOOTH) || use_loop_normals;
 
       /* Create triangles.
        *
@@ -991,6 +1004,21 @@ static void create_mesh(Scene *scene,
        */
       mesh->add_triangle(vi[0], vi[1], vi[2], shader, smooth);
     }
+
+    if (use_loop_normals) {
+      /* Loop normals are only available through RNA, they are written in the same order as
+       * before so that shared vertices get the normal of the last triangle. */
+      int t = 0;
+      for (BL::MeshLoopTriangle &b_tri : b_mesh.loop_triangles) {
+        BL::Array<float, 9> loop_normals = b_tri.split_normals();
+        const int *vi = &mesh->get_triangles()[t * 3];
+        for (int i = 0; i < 3; i++) {
+          N[vi[i]] = make_float3(
+              loop_normals[i * 3], loop_normals[i * 3 + 1], loop_normals[i * 3 + 2]);
+        }
+        t++;
+      }
+    }
   }
   else {
     vector<int> vi;
@@ -1211,12 +1239,14 @@ void BlenderSync::sync_mesh_motion(BL::Depsgraph b_depsgraph,
     /* NOTE: We don't copy more that existing amount of vertices to prevent
      * possible memory corruption.
      */
-    BL::Mesh::vertices_iterator v;
-    int i = 0;
-    for (b_mesh.vertices.begin(v); v != b_mesh.vertices.end() && i < numverts; ++v, ++i) {
-      mP[i] = get_float3(v->co());
-      if (mN)
-        mN[i] = get_float3(v->normal());
+    const int copy_numverts = min(b_mesh.vertices.length(), numverts);
+    if (copy_numverts > 0) {
+      const MVert *verts = mesh_verts(b_mesh);
+      parallel_for(0, copy_numverts, [&](int i) {
+        mP[i] = make_float3(verts[i].co[0], verts[i].co[1], verts[i].co[2]);
+        if (mN)
+          mN[i] = mvert_normal(verts[i]);
+      });
     }
     if (new_attribute) {
       /* In case of new attribute, we verify if there really was any motion. */
@@ -16,8 +16,31 @@
 
 #include "blender/output_driver.h"
 
+extern "C" {
+struct RenderLayer;
+
+float *RE_RenderLayerGetPass(struct RenderLayer *rl, const char *name, const char *viewname);
+}
+
 CCL_NAMESPACE_BEGIN
 
+/* Pixels of a pass in the render result. Reading and writing them in place avoids copying every
+ * pass through a temporary buffer and the RNA array accessors, which matters for large renders
+ * with many passes. */
+static float *render_pass_pixels(BL::RenderResult &b_rr,
+                                 BL::RenderLayer &b_rlay,
+                                 BL::RenderPass &b_pass,
+                                 const OutputDriver::Tile &tile)
+{
+  /* The result may have been clipped to the image, use the RNA accessors then. */
+  if (b_rr.resolution_x() != tile.size.x || b_rr.resolution_y() != tile.size.y) {
+    return nullptr;
+  }
+
+  return RE_RenderLayerGetPass(
+      static_cast<RenderLayer *>(b_rlay.ptr.data), b_pass.name().c_str(), tile.view.c_str());
+}
+
 BlenderOutputDriver::BlenderOutputDriver(BL::RenderEngine &b_engine) : b_engine_(b_engine)
 {
 }
@@ -51,12 +74,16 @@ bool BlenderOutputDriver::read_render_tile(const Tile &tile)
 
   BL::RenderLayer b_rlay = *b_single_rlay;
 
-  vector<float> pixels(tile.size.x * tile.size.y * 4);
-
   /* Copy each pass.
    * TODO:copy only the required ones for better performance? */
   for (BL::RenderPass &b_pass : b_rlay.passes) {
-    tile.set_pass_pixels(b_pass.name(), b_pass.channels(), (float *)b_pass.rect());
+    const float *pixels = render_pass_pixels(b_rr, b_rlay, b_pass, tile);
+    if (pixels) {
+      tile.set_pass_pixels(b_pass.name(), b_pass.channels(), pixels);
+    }
+    else {
+      tile.set_pass_pixels(b_pass.name(), b_pass.channels(), (float *)b_pass.rect());
+    }
   }
 
   b_engine_.end_result(b_rr, false, false, false);
@@ -109,15 +136,27 @@ void BlenderOutputDriver::write_render_tile(const Tile &tile)
 
   BL::RenderLayer b_rlay = *b_single_rlay;
 
-  vector<float> pixels(tile.size.x * tile.size.y * 4);
+  vector<float> pixels;
 
-  /* Copy each pass. */
+  /* Copy each pass, directly into the render result when possible. */
   for (BL::RenderPass &b_pass : b_rlay.passes) {
-    if (!tile.get_pass_pixels(b_pass.name(), b_pass.channels(), &pixels[0])) {
-      memset(&pixels[0], 0, pixels.size() * sizeof(float));
+    const int channels = b_pass.channels();
+    const size_t num_pixel_values = size_t(tile.size.x) * tile.size.y * channels;
+
+    float *pass_pixels = render_pass_pixels(b_rr, b_rlay, b_pass, tile);
+    if (pass_pixels) {
+      if (!tile.get_pass_pixels(b_pass.name(), channels, pass_pixels)) {
+        memset(pass_pixels, 0, num_pixel_values * sizeof(float));
+      }
+      continue;
+    }
+
+    pixels.resize(num_pixel_values);
+    if (!tile.get_pass_pixels(b_pass.name(), channels, pixels.data())) {
+      memset(pixels.data(), 0, pixels.size() * sizeof(float));
     }
 
-    b_pass.rect(&pixels[0]);
+    b_pass.rect(pixels.data());
   }
 
   b_engine_.end_result(b_rr, false, false, true);
@@ -323,6 +323,7 @@ void BlenderSync::sync_integrator(BL::ViewLayer &b_view_layer, bool background)
   float volume_step_rate = (preview) ? get_float(cscene, "volume_preview_step_rate") :
                                        get_float(cscene, "volume_step_rate");
   integrator->set_volume_step_rate(volume_step_rate);
+  integrator->set_use_volume_empty_skip(get_boolean(cscene, "use_volume_empty_skip"));
 
   integrator->set_caustics_reflective(get_boolean(cscene, "caustics_reflective"));
   integrator->set_caustics_refractive(get_boolean(cscene, "caustics_refractive"));
@@ -349,6 +350,7 @@ void BlenderSync::sync_integrator(BL::ViewLayer &b_view_layer, bool background)
   }
 
   integrator->set_light_sampling_threshold(get_float(cscene, "light_sampling_threshold"));
+  integrator->set_use_light_tree(get_boolean(cscene, "use_light_tree"));
 
   SamplingPattern sampling_pattern = (SamplingPattern)get_enum(
       cscene, "sampling_pattern", SAMPLING_NUM_PATTERNS, SAMPLING_PATTERN_SOBOL);
@@ -368,6 +370,10 @@ void BlenderSync::sync_integrator(BL::ViewLayer &b_view_layer, bool background)
     integrator->set_adaptive_min_samples(get_int(cscene, "adaptive_min_samples"));
   }
 
+  integrator->set_use_guiding(get_boolean(cscene, "use_guiding"));
+  integrator->set_guiding_training_samples(get_int(cscene, "guiding_training_samples"));
+  integrator->set_surface_guiding_probability(get_float(cscene, "surface_guiding_probability"));
+
   int samples = get_int(cscene, "samples");
   float scrambling_distance = get_float(cscene, "scrambling_distance");
   bool auto_scrambling_distance = get_boolean(cscene, "auto_scrambling_distance");
@@ -23,6 +23,7 @@
 
 #include "util/algorithm.h"
 #include "util/boundbox.h"
+#include "util/tbb.h"
 #include "util/types.h"
 
 CCL_NAMESPACE_BEGIN
@@ -69,6 +70,16 @@ __forceinline int get_best_dimension(const float4 &bestSAH)
 
 /* BVH Object Binning */
 
+/* Number of primitives from which they are mapped to bins in parallel. */
+#define PARALLEL_BINNING_MIN_SIZE (1 << 17)
+#define PARALLEL_BINNING_GRAIN_SIZE (1 << 14)
+
+/* Bins of all dimensions for a part of the primitives. */
+struct BVHObjectBins {
+  BoundBox bounds[BVHObjectBinning::MAX_BINS][4];
+  int4 count[BVHObjectBinning::MAX_BINS];
+};
+
 BVHObjectBinning::BVHObjectBinning(const BVHRange &job,
                                    BVHReference *prims,
                                    const BVHUnaligned *unaligned_heuristic,
@@ -105,63 +116,33 @@ BVHObjectBinning::BVHObjectBinning(const BVHRange &job,
     bin_bounds[i][0] = bin_bounds[i][1] = bin_bounds[i][2] = BoundBox::empty;
   }
 
-  /* map geometry to bins, unrolled once */
-  {
-    int64_t i;
-
-    for (i = 0; i < int64_t(size()) - 1; i += 2) {
-      prefetch_L2(&prims[start() + i + 8]);
-
-      /* map even and odd primitive to bin */
-      const BVHReference &prim0 = prims[start() + i + 0];
-      const BVHReference &prim1 = prims[start() + i + 1];
-
-      BoundBox bounds0 = get_prim_bounds(prim0);
-      BoundBox bounds1 = get_prim_bounds(prim1);
-
-      int4 bin0 = get_bin(bounds0);
-      int4 bin1 = get_bin(bounds1);
-
-      /* increase bounds for bins for even primitive */
-      int b00 = (int)extract<0>(bin0);
-      bin_count[b00][0]++;
-      bin_bounds[b00][0].grow(bounds0);
-      int b01 = (int)extract<1>(bin0);
-      bin_count[b01][1]++;
-      bin_bounds[b01][1].grow(bounds0);
-      int b02 = (int)extract<2>(bin0);
-      bin_count[b02][2]++;
-      bin_bounds[b02][2].grow(bounds0);
-
-      /* increase bounds of bins for odd primitive */
-      int b10 = (int)extract<0>(bin1);
-      bin_count[b10][0]++;
-      bin_bounds[b10][0].grow(bounds1);
-      int b11 = (int)extract<1>(bin1);
-      bin_count[b11][1]++;
-      bin_bounds[b11][1].grow(bounds1);
-      int b12 = (int)extract<2>(bin1);
-      bin_count[b12][2]++;
-      bin_bounds[b12][2].grow(bounds1);
+  if (size() < PARALLEL_BINNING_MIN_SIZE) {
+    bin_primitives(prims, start(), end(), bin_bounds, bin_count);
+  }
+  else {
+    /* The top levels of a large mesh are built before there are enough subtrees to build them
+     * in parallel, so map primitives to bins in parallel and merge the bins of all threads. */
+    BVHObjectBins empty_bins;
+    for (size_t i = 0; i < num_bins; i++) {
+      empty_bins.count[i] = make_int4(0);
+      empty_bins.bounds[i][0] = empty_bins.bounds[i][1] = empty_bins.bounds[i][2] =
+          BoundBox::empty;
     }
 
-    /* for uneven number of primitives */
-    if (i < int64_t(size())) {
-      /* map primitive to bin */
-      const BVHReference &prim0 = prims[start() + i];
-      BoundBox bounds0 = get_prim_bounds(prim0);
-      int4 bin0 = get_bin(bounds0);
-
-      /* increase bounds of bins */
-      int b00 = (int)extract<0>(bin0);
-      bin_count[b00][0]++;
-      bin_bounds[b00][0].grow(bounds0);
-      int b01 = (int)extract<1>(bin0);
-      bin_count[b01][1]++;
-      bin_bounds[b01][1].grow(bounds0);
-      int b02 = (int)extract<2>(bin0);
-      bin_count[b02][2]++;
-      bin_bounds[b02][2].grow(bounds0);
+    enumerable_thread_specific<BVHObjectBins> thread_bins(empty_bins);
+    parallel_for(blocked_range<int>(start(), end(), PARALLEL_BINNING_GRAIN_SIZE),
+                 [&](const blocked_range<int> &range) {
+                   BVHObjectBins &bins = thread_bins.local();
+                   bin_primitives(prims, range.begin(), range.end(), bins.bounds, bins.count);
+                 });
+
+    for (const BVHObjectBins &bins : thread_bins) {
+      for (size_t i = 0; i < num_bins; i++) {
+        bin_count[i] = bin_count[i] + bins.count[i];
+        for (int d = 0; d < 3; d++) {
+          bin_bounds[i][d].grow(bins.bounds[i][d]);
+        }
+      }
     }
   }
 
@@ -226,6 +207,73 @@ BVHObjectBinning::BVHObjectBinning(const BVHRange &job,
   leafSAH = bounds_.half_area() * blocks(size());
 }
 
+void BVHObjectBinning::bin_primitives(const BVHReference *prims,
+                                      int begin,
+                                      int end,
+                                      BoundBox (*bin_bounds)[4],
+                                      int4 *bin_count) const
+{
+  /* map geometry to bins, unrolled once */
+  {
+    int64_t i;
+
+    for (i = begin; i < int64_t(end) - 1; i += 2) {
+      prefetch_L2(&prims[i + 8]);
+
+      /* map even and odd primitive to bin */
+      const BVHReference &prim0 = prims[i + 0];
+      const BVHReference &prim1 = prims[i + 1];
+
+      BoundBox bounds0 = get_prim_bounds(prim0);
+      BoundBox bounds1 = get_prim_bounds(prim1);
+
+      int4 bin0 = get_bin(bounds0);
+      int4 bin1 = get_bin(bounds1);
+
+      /* increase bounds for bins for even primitive */
+      int b00 = (int)extract<0>(bin0);
+      bin_count[b00][0]++;
+      bin_bounds[b00][0].grow(bounds0);
+      int b01 = (int)extract<1>(bin0);
+      bin_count[b01][1]++;
+      bin_bounds[b01][1].grow(bounds0);
+      int b02 = (int)extract<2>(bin0);
+      bin_count[b02][2]++;
+      bin_bounds[b02][2].grow(bounds0);
+
+      /* increase bounds of bins for odd primitive */
+      int b10 = (int)extract<0>(bin1);
+      bin_count[b10][0]++;
+      bin_bounds[b10][0].grow(bounds1);
+      int b11 = (int)extract<1>(bin1);
+      bin_count[b11][1]++;
+      bin_bounds[b11][1].grow(bounds1);
+      int b12 = (int)extract<2>(bin1);
+      bin_count[b12][2]++;
+      bin_bounds[b12][2].grow(bounds1);
+    }
+
+    /* for uneven number of primitives */
+    if (i < int64_t(end)) {
+      /* map primitive to bin */
+      const BVHReference &prim0 = prims[i];
+      BoundBox bounds0 = get_prim_bounds(prim0);
+      int4 bin0 = get_bin(bounds0);
+
+      /* increase bounds of bins */
+      int b00 = (int)extract<0>(bin0);
+      bin_count[b00][0]++;
+      bin_bounds[b00][0].grow(bounds0);
+      int b01 = (int)extract<1>(bin0);
+      bin_count[b01][1]++;
+      bin_bounds[b01][1].grow(bounds0);
+      int b02 = (int)extract<2>(bin0);
+      bin_count[b02][2]++;
+      bin_bounds[b02][2].grow(bounds0);
+    }
+  }
+}
+
 void BVHObjectBinning::split(BVHReference *prims,
                              BVHObjectBinning &left_o,
                              BVHObjectBinning &right_o) const
@@ -55,6 +55,8 @@ class BVHObjectBinning : public BVHRange {
   float splitSAH; /* SAH cost of the best split */
   float leafSAH;  /* SAH cost of creating a leaf */
 
+  enum { MAX_BINS = 32 };
+
  protected:
   int dim;         /* best split dimension */
   int pos;         /* best split position */
@@ -68,9 +70,15 @@ class BVHObjectBinning : public BVHRange {
   const BVHUnaligned *unaligned_heuristic_;
   const Transform *aligned_space_;
 
-  enum { MAX_BINS = 32 };
   enum { LOG_BLOCK_SIZE = 2 };
 
+  /* Map primitives in the range to bins, growing the bin counts and bounds. */
+  void bin_primitives(const BVHReference *prims,
+                      int begin,
+                      int end,
+                      BoundBox (*bin_bounds)[4],
+                      int4 *bin_count) const;
+
   /* computes the bin numbers for each dimension for a box. */
   __forceinline int4 get_bin(const BoundBox &box) const
   {
@@ -537,6 +537,9 @@ BVHNode *BVHBuild::run()
   /* clean up temporary memory usage by threads */
   spatial_storage.clear();
 
+  /* The references are not needed after building, free them before the nodes get packed. */
+  references.free_memory();
+
   /* delete if we canceled */
   if (rootnode) {
     if (progress.get_cancel()) {
@@ -573,6 +576,12 @@ BVHNode *BVHBuild::run()
     }
   }
 
+  /* Spatial splits reserve room for duplicated references, release what was not used. */
+  prim_type.shrink_to_fit();
+  prim_index.shrink_to_fit();
+  prim_object.shrink_to_fit();
+  prim_time.shrink_to_fit();
+
   return rootnode;
 }
 
@@ -93,7 +93,9 @@ void BVH2::build(Progress &progress, Stats *)
 
   /* pack nodes */
   progress.set_substatus("Packing BVH nodes");
+  node_area = 0.0f;
   pack_nodes(root);
+  build_node_area = node_area;
 
   /* free build nodes */
   root->deleteSubtree();
@@ -101,6 +103,11 @@ void BVH2::build(Progress &progress, Stats *)
 
 void BVH2::refit(Progress &progress)
 {
+  if (params.top_level) {
+    refit_top_level(progress);
+    return;
+  }
+
   progress.set_substatus("Packing BVH primitives");
   pack_primitives();
 
@@ -174,6 +181,8 @@ void BVH2::pack_aligned_node(int idx,
   assert(c0 < 0 || c0 < pack.nodes.size());
   assert(c1 < 0 || c1 < pack.nodes.size());
 
+  node_area += b0.safe_area() + b1.safe_area();
+
   int4 data[BVH_NODE_SIZE] = {
       make_int4(
           visibility0 & ~PATH_RAY_NODE_UNALIGNED, visibility1 & ~PATH_RAY_NODE_UNALIGNED, c0, c1),
@@ -223,6 +232,8 @@ void BVH2::pack_unaligned_node(int idx,
   assert(c0 < 0 || c0 < pack.nodes.size());
   assert(c1 < 0 || c1 < pack.nodes.size());
 
+  node_area += bounds0.safe_area() + bounds1.safe_area();
+
   float4 data[BVH_UNALIGNED_NODE_SIZE];
   Transform space0 = BVHUnaligned::compute_node_transform(bounds0, aligned_space0);
   Transform space1 = BVHUnaligned::compute_node_transform(bounds1, aligned_space1);
@@ -241,6 +252,15 @@ void BVH2::pack_unaligned_node(int idx,
   memcpy(&pack.nodes[idx], data, sizeof(float4) * BVH_UNALIGNED_NODE_SIZE);
 }
 
+template<typename T> static void copy_array_begin(array<T> &dst, const array<T> &src, size_t size)
+{
+  assert(size <= src.size());
+  dst.resize(size);
+  if (size > 0) {
+    memcpy((void *)dst.data(), src.data(), sizeof(T) * size);
+  }
+}
+
 void BVH2::pack_nodes(const BVHNode *root)
 {
   const size_t num_nodes = root->getSubtreeSize(BVH_STAT_NODE_COUNT);
@@ -260,6 +280,7 @@ void BVH2::pack_nodes(const BVHNode *root)
   pack.nodes.clear();
   pack.leaf_nodes.clear();
   /* For top level BVH, first merge existing BVH's so we know the offsets. */
+  const size_t num_prims = pack.prim_index.size();
   if (params.top_level) {
     pack_instances(node_size, num_leaf_nodes * BVH_NODE_LEAF_SIZE);
   }
@@ -312,12 +333,69 @@ void BVH2::pack_nodes(const BVHNode *root)
   assert(node_size == nextNodeIdx);
   /* root index to start traversal at, to handle case of single leaf node */
   pack.root_index = (root->is_leaf()) ? -1 : 0;
+
+  /* Keep the top level part of the BVH, the merged geometry BVH's are stored after it. Motion
+   * BVH's are not refitted since their primitive time ranges depend on the build. */
+  has_top_level_pack = params.top_level && params.bvh_type == BVH_TYPE_DYNAMIC &&
+                       pack.prim_time.size() == 0;
+  if (has_top_level_pack) {
+    copy_array_begin(top_level_pack.nodes, pack.nodes, node_size);
+    copy_array_begin(
+        top_level_pack.leaf_nodes, pack.leaf_nodes, num_leaf_nodes * BVH_NODE_LEAF_SIZE);
+    copy_array_begin(top_level_pack.prim_type, pack.prim_type, num_prims);
+    copy_array_begin(top_level_pack.prim_index, pack.prim_index, num_prims);
+    copy_array_begin(top_level_pack.prim_object, pack.prim_object, num_prims);
+    top_level_pack.root_index = pack.root_index;
+  }
+  else {
+    top_level_pack = PackedBVH();
+  }
 }
 
-void BVH2::refit_nodes()
+bool BVH2::top_level_can_refit(const vector<Geometry *> &geometry_,
+                               const vector<Object *> &objects_) const
+{
+  return has_top_level_pack && geometry_ == geometry && objects_ == objects &&
+         node_area <= 2.0f * build_node_area;
+}
+
+void BVH2::refit_top_level(Progress &progress)
 {
-  assert(!params.top_level);
+  assert(has_top_level_pack);
+
+  progress.set_substatus("Refitting BVH nodes");
+
+  /* Start again from the top level data of the last build, the pack of the previous update has
+   * been moved to the device. */
+  pack.nodes = top_level_pack.nodes;
+  pack.leaf_nodes = top_level_pack.leaf_nodes;
+  pack.prim_type = top_level_pack.prim_type;
+  pack.prim_index = top_level_pack.prim_index;
+  pack.prim_object = top_level_pack.prim_object;
+  pack.prim_time.clear();
+  pack.root_index = top_level_pack.root_index;
 
+  pack_primitives();
+
+  node_area = 0.0f;
+  refit_nodes();
+
+  if (progress.get_cancel())
+    return;
+
+  /* Merge the geometry BVH's again, as they may have been refitted or rebuilt. This adds the
+   * primitive offsets of the geometry to the top level primitive indices again. */
+  progress.set_substatus("Packing BVH nodes");
+  for (size_t i = 0; i < pack.prim_index.size(); i++) {
+    if (pack.prim_index[i] != -1) {
+      pack.prim_index[i] -= objects[pack.prim_object[i]]->get_geometry()->prim_offset;
+    }
+  }
+  pack_instances(top_level_pack.nodes.size(), top_level_pack.leaf_nodes.size());
+}
+
+void BVH2::refit_nodes()
+{
   BoundBox bbox = BoundBox::empty;
   uint visibility = 0;
   refit_node(0, (pack.root_index == -1) ? true : false, bbox, visibility);
@@ -332,7 +410,16 @@ void BVH2::refit_node(int idx, bool leaf, BoundBox &bbox, uint &visibility)
     const int c0 = data[0].x;
     const int c1 = data[0].y;
 
-    refit_primitives(c0, c1, bbox, visibility);
+    if (c0 < 0) {
+      /* Object instance in the top level BVH. */
+      const int prim = ~c0;
+      const Object *ob = objects[pack.prim_object[prim]];
+      bbox.grow(ob->bounds);
+      visibility |= ob->visibility_for_tracing();
+    }
+    else {
+      refit_primitives(c0, c1, bbox, visibility);
+    }
 
     /* TODO(sergey): De-duplicate with pack_leaf(). */
     float4 leaf_data[BVH_NODE_LEAF_SIZE];
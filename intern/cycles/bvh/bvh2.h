@@ -48,6 +48,12 @@ class BVH2 : public BVH {
   void build(Progress &progress, Stats *stats);
   void refit(Progress &progress);
 
+  /* Test if the top level BVH can be refitted for the given objects, instead of being built
+   * again. This is only possible for dynamic BVHs, as long as refitting did not make the BVH
+   * too loose. */
+  bool top_level_can_refit(const vector<Geometry *> &geometry,
+                           const vector<Object *> &objects) const;
+
   PackedBVH pack;
 
  protected:
@@ -91,6 +97,7 @@ class BVH2 : public BVH {
                            uint visibility1);
 
   /* refit */
+  void refit_top_level(Progress &progress);
   void refit_nodes();
   void refit_node(int idx, bool leaf, BoundBox &bbox, uint &visibility);
 
@@ -103,6 +110,15 @@ class BVH2 : public BVH {
 
   /* merge instance BVH's */
   void pack_instances(size_t nodes_size, size_t leaf_nodes_size);
+
+  /* Top level nodes and primitives before the geometry BVH's are merged into them, only kept for
+   * dynamic BVHs to refit them. */
+  PackedBVH top_level_pack;
+  bool has_top_level_pack = false;
+
+  /* Sum of the surface areas of all packed nodes, to detect refitted BVHs that got too loose. */
+  float node_area = 0.0f;
+  float build_node_area = 0.0f;
 };
 
 CCL_NAMESPACE_END
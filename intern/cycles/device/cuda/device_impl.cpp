@@ -776,6 +776,22 @@ void CUDADevice::generic_copy_to(device_memory &mem)
   }
 }
 
+void CUDADevice::generic_copy_to(device_memory &mem, size_t size, size_t offset)
+{
+  if (!mem.host_pointer || !mem.device_pointer) {
+    return;
+  }
+
+  thread_scoped_lock lock(cuda_mem_map_mutex);
+  if (!cuda_mem_map[&mem].use_mapped_host || mem.host_pointer != mem.shared_pointer) {
+    const size_t elem_size = mem.memory_elements_size(1);
+    const CUDAContextScope scope(this);
+    cuda_assert(cuMemcpyHtoD((CUdeviceptr)(mem.device_pointer + offset * elem_size),
+                             (char *)mem.host_pointer + offset * elem_size,
+                             size * elem_size));
+  }
+}
+
 void CUDADevice::generic_free(device_memory &mem)
 {
   if (mem.device_pointer) {
@@ -845,6 +861,19 @@ void CUDADevice::mem_copy_to(device_memory &mem)
   }
 }
 
+void CUDADevice::mem_copy_to(device_memory &mem, size_t size, size_t offset)
+{
+  /* Global memory is reallocated on every copy, but can be updated in place when it has the
+   * same size. */
+  if ((mem.type == MEM_GLOBAL || mem.type == MEM_READ_ONLY || mem.type == MEM_READ_WRITE) &&
+      mem.device_pointer && mem.device_size == mem.memory_size() && mem.is_resident(this)) {
+    generic_copy_to(mem, size, offset);
+  }
+  else {
+    mem_copy_to(mem);
+  }
+}
+
 void CUDADevice::mem_copy_from(device_memory &mem, size_t y, size_t w, size_t h, size_t elem)
 {
   if (mem.type == MEM_TEXTURE || mem.type == MEM_GLOBAL) {
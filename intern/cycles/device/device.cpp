@@ -73,6 +73,11 @@ void Device::build_bvh(BVH *bvh, Progress &progress, bool refit)
   }
 }
 
+void Device::mem_copy_to(device_memory &mem, size_t /*size*/, size_t /*offset*/)
+{
+  mem_copy_to(mem);
+}
+
 Device *Device::create(const DeviceInfo &info, Stats &stats, Profiler &profiler)
 {
   if (!info.multi_devices.empty()) {
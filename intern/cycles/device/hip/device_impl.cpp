@@ -733,6 +733,22 @@ void HIPDevice::generic_copy_to(device_memory &mem)
   }
 }
 
+void HIPDevice::generic_copy_to(device_memory &mem, size_t size, size_t offset)
+{
+  if (!mem.host_pointer || !mem.device_pointer) {
+    return;
+  }
+
+  thread_scoped_lock lock(hip_mem_map_mutex);
+  if (!hip_mem_map[&mem].use_mapped_host || mem.host_pointer != mem.shared_pointer) {
+    const size_t elem_size = mem.memory_elements_size(1);
+    const HIPContextScope scope(this);
+    hip_assert(hipMemcpyHtoD((hipDeviceptr_t)(mem.device_pointer + offset * elem_size),
+                             (char *)mem.host_pointer + offset * elem_size,
+                             size * elem_size));
+  }
+}
+
 void HIPDevice::generic_free(device_memory &mem)
 {
   if (mem.device_pointer) {
@@ -802,6 +818,19 @@ void HIPDevice::mem_copy_to(device_memory &mem)
   }
 }
 
+void HIPDevice::mem_copy_to(device_memory &mem, size_t size, size_t offset)
+{
+  /* Global memory is reallocated on every copy, but can be updated in place when it has the
+   * same size. */
+  if ((mem.type == MEM_GLOBAL || mem.type == MEM_READ_ONLY || mem.type == MEM_READ_WRITE) &&
+      mem.device_pointer && mem.device_size == mem.memory_size() && mem.is_resident(this)) {
+    generic_copy_to(mem, size, offset);
+  }
+  else {
+    mem_copy_to(mem);
+  }
+}
+
 void HIPDevice::mem_copy_from(device_memory &mem, size_t y, size_t w, size_t h, size_t elem)
 {
   if (mem.type == MEM_TEXTURE || mem.type == MEM_GLOBAL) {
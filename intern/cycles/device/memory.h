@@ -288,6 +288,7 @@ class device_memory {
   void device_alloc();
   void device_free();
   void device_copy_to();
+  void device_copy_to(size_t size, size_t offset);
   void device_copy_from(size_t y, size_t w, size_t h, size_t elem);
   void device_zero();
 
@@ -540,6 +541,25 @@ template<typename T> class device_vector : public device_memory {
     copy_to_device();
   }
 
+  /* Copy only the given range of elements, when the device memory does not have to be
+   * reallocated. */
+  void copy_to_device_if_modified(size_t size, size_t offset)
+  {
+    if (!modified) {
+      return;
+    }
+
+    if (need_realloc_ || device_pointer == 0) {
+      copy_to_device();
+      return;
+    }
+
+    assert(offset + size <= data_size);
+    if (size != 0) {
+      device_copy_to(size, offset);
+    }
+  }
+
   void clear_modified()
   {
     modified = false;
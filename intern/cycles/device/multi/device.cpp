@@ -322,6 +322,42 @@ class MultiDevice : public Device {
     stats.mem_alloc(mem.device_size - existing_size);
   }
 
+  void mem_copy_to(device_memory &mem, size_t size, size_t offset) override
+  {
+    device_ptr key = mem.device_pointer;
+    if (key == 0 || mem.type == MEM_TEXTURE) {
+      mem_copy_to(mem);
+      return;
+    }
+
+    size_t existing_size = mem.device_size;
+
+    /* Only the owner of the memory in each island needs to be updated. */
+    foreach (const vector<SubDevice *> &island, peer_islands) {
+      SubDevice *owner_sub = find_suitable_mem_device(key, island);
+      const device_ptr existing_ptr = owner_sub->ptr_map[key];
+      mem.device = owner_sub->device;
+      mem.device_pointer = existing_ptr;
+      mem.device_size = existing_size;
+
+      owner_sub->device->mem_copy_to(mem, size, offset);
+      owner_sub->ptr_map[key] = mem.device_pointer;
+
+      if (mem.type == MEM_GLOBAL && mem.device_pointer != existing_ptr) {
+        /* The memory was reallocated, update the pointer in kernel globals on all devices. */
+        foreach (SubDevice *island_sub, island) {
+          if (island_sub != owner_sub) {
+            island_sub->device->mem_copy_to(mem);
+          }
+        }
+      }
+    }
+
+    mem.device = this;
+    mem.device_pointer = key;
+    stats.mem_alloc(mem.device_size - existing_size);
+  }
+
   void mem_copy_from(device_memory &mem, size_t y, size_t w, size_t h, size_t elem) override
   {
     device_ptr key = mem.device_pointer;
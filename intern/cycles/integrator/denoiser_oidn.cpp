@@ -42,6 +42,11 @@ OIDNDenoiser::OIDNDenoiser(Device *path_trace_device, const DenoiseParams &param
 }
 
 #ifdef WITH_OPENIMAGEDENOISE
+/* Approximate limit of the memory used by the filters. OIDN denoises images which need more
+ * memory in overlapping tiles, which avoids a large spike of memory usage for big frames at the
+ * cost of slightly slower denoising. */
+#  define OIDN_MAX_MEMORY_MB 1024
+
 static bool oidn_progress_monitor_function(void *user_ptr, double /*n*/)
 {
   OIDNDenoiser *oidn_denoiser = reinterpret_cast<OIDNDenoiser *>(user_ptr);
@@ -165,9 +170,7 @@ class OIDNDenoiseContext {
 
     OIDNPass oidn_color_access_pass = read_input_pass(oidn_color_pass, oidn_output_pass);
 
-    oidn::DeviceRef oidn_device = oidn::newDevice();
-    oidn_device.set("setAffinity", false);
-    oidn_device.commit();
+    oidn::DeviceRef &oidn_device = get_oidn_device();
 
     /* Create a filter for denoising a beauty (color) image using prefiltered auxiliary images too.
      */
@@ -178,6 +181,7 @@ class OIDNDenoiseContext {
     oidn_filter.setProgressMonitorFunction(oidn_progress_monitor_function, denoiser_);
     oidn_filter.set("hdr", true);
     oidn_filter.set("srgb", false);
+    oidn_filter.set("maxMemoryMB", OIDN_MAX_MEMORY_MB);
     if (denoise_params_.prefilter == DENOISER_PREFILTER_NONE ||
         denoise_params_.prefilter == DENOISER_PREFILTER_ACCURATE) {
       oidn_filter.set("cleanAux", true);
@@ -201,6 +205,19 @@ class OIDNDenoiseContext {
   }
 
  protected:
+  /* Device shared by the filters of all passes, so that its threads and the prefiltered guiding
+   * passes are set up once for the whole buffer. */
+  oidn::DeviceRef &get_oidn_device()
+  {
+    if (!oidn_device_) {
+      oidn_device_ = oidn::newDevice();
+      oidn_device_.set("setAffinity", false);
+      oidn_device_.commit();
+    }
+
+    return oidn_device_;
+  }
+
   void filter_guiding_pass_if_needed(oidn::DeviceRef &oidn_device, OIDNPass &oidn_pass)
   {
     if (denoise_params_.prefilter != DENOISER_PREFILTER_ACCURATE || !oidn_pass ||
@@ -211,6 +228,7 @@ class OIDNDenoiseContext {
     oidn::FilterRef oidn_filter = oidn_device.newFilter("RT");
     set_pass(oidn_filter, oidn_pass);
     set_output_pass(oidn_filter, oidn_pass);
+    oidn_filter.set("maxMemoryMB", OIDN_MAX_MEMORY_MB);
     oidn_filter.commit();
     oidn_filter.execute();
 
@@ -535,6 +553,8 @@ class OIDNDenoiseContext {
   bool allow_inplace_modification_ = false;
   int pass_sample_count_ = PASS_UNUSED;
 
+  oidn::DeviceRef oidn_device_;
+
   /* Optional albedo and normal passes, reused by denoising of different pass types. */
   OIDNPass oidn_albedo_pass_;
   OIDNPass oidn_normal_pass_;
@@ -0,0 +1,232 @@
+/*
+ * Copyright 2011-2021 Blender Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "integrator/guiding.h"
+
+// clang-format off
+#include "kernel/device/cpu/compat.h"
+#include "kernel/device/cpu/globals.h"
+#include "kernel/integrator/guiding.h"
+// clang-format on
+
+#include "util/algorithm.h"
+#include "util/hash.h"
+#include "util/log.h"
+#include "util/math.h"
+
+CCL_NAMESPACE_BEGIN
+
+/* Number of cells along the longest axis of the grid. */
+#define GUIDING_GRID_RES 16
+/* Number of training samples a cell needs before its distribution is used. */
+#define GUIDING_MIN_CELL_SAMPLES 32
+/* Fraction of the distribution which is uniform, so that noise in the training data does not
+ * exclude directions entirely. */
+#define GUIDING_UNIFORM_FRACTION 0.1f
+
+GuidingField::GuidingField()
+{
+  reset();
+}
+
+void GuidingField::reset()
+{
+  has_grid_ = false;
+  has_distribution_ = false;
+  bounds_ = BoundBox::empty;
+
+  kfield_.bounds_min = zero_float3();
+  kfield_.inv_cell_size = zero_float3();
+  kfield_.resolution[0] = kfield_.resolution[1] = kfield_.resolution[2] = 0;
+  kfield_.surface_probability = 0.0f;
+  kfield_.cdf = nullptr;
+
+  pending_samples_.clear();
+  histograms_.clear();
+  num_cell_samples_.clear();
+  cdf_.clear();
+}
+
+void GuidingField::add_samples(const GuidingSample *samples,
+                               const int num_samples,
+                               const float weight)
+{
+  for (int i = 0; i < num_samples; i++) {
+    GuidingSample sample = samples[i];
+    sample.value *= weight;
+
+    if (has_grid_) {
+      splat_sample(sample);
+    }
+    else {
+      pending_samples_.push_back(sample);
+    }
+  }
+}
+
+void GuidingField::init_grid()
+{
+  for (const GuidingSample &sample : pending_samples_) {
+    bounds_.grow(sample.P);
+  }
+
+  /* Pad the bounds so that cells have a size even when all samples are on a plane. */
+  const float3 size = bounds_.size();
+  const float padding = max(max3(size) * 1e-3f, 1e-4f);
+  bounds_.min -= make_float3(padding, padding, padding);
+  bounds_.max += make_float3(padding, padding, padding);
+
+  /* Cells of about the same size along every axis. */
+  const float3 extent = bounds_.size();
+  const float cell_size = max3(extent) / GUIDING_GRID_RES;
+  int num_cells = 1;
+  for (int axis = 0; axis < 3; axis++) {
+    const int resolution = clamp((int)ceilf(extent[axis] / cell_size), 1, GUIDING_GRID_RES);
+    kfield_.resolution[axis] = resolution;
+    kfield_.inv_cell_size[axis] = resolution / extent[axis];
+    num_cells *= resolution;
+  }
+  kfield_.bounds_min = bounds_.min;
+
+  histograms_.resize(num_cells * GUIDING_NUM_BINS, 0.0f);
+  num_cell_samples_.resize(num_cells, 0);
+  cdf_.resize(num_cells * GUIDING_NUM_BINS, 0.0f);
+  kfield_.cdf = cdf_.data();
+
+  has_grid_ = true;
+
+  VLOG(3) << "Path guiding grid resolution " << kfield_.resolution[0] << "x"
+          << kfield_.resolution[1] << "x" << kfield_.resolution[2];
+}
+
+void GuidingField::splat_sample(const GuidingSample &sample)
+{
+  const int cell = guiding_cell_index(&kfield_, sample.P);
+  histograms_[cell * GUIDING_NUM_BINS + guiding_direction_bin(sample.D)] += sample.value;
+  num_cell_samples_[cell]++;
+}
+
+void GuidingField::update(const GuidingParams &params)
+{
+  if (!has_grid_) {
+    if (pending_samples_.empty()) {
+      return;
+    }
+
+    init_grid();
+    for (const GuidingSample &sample : pending_samples_) {
+      splat_sample(sample);
+    }
+    pending_samples_.clear();
+    pending_samples_.shrink_to_fit();
+  }
+
+  const int num_cells = num_cell_samples_.size();
+  int num_distributions = 0;
+
+  for (int cell = 0; cell < num_cells; cell++) {
+    const float *histogram = &histograms_[cell * GUIDING_NUM_BINS];
+    float *cdf = &cdf_[cell * GUIDING_NUM_BINS];
+
+    float sum = 0.0f;
+    for (int bin = 0; bin < GUIDING_NUM_BINS; bin++) {
+      sum += histogram[bin];
+    }
+
+    if (num_cell_samples_[cell] < GUIDING_MIN_CELL_SAMPLES || !(sum > 0.0f)) {
+      std::fill(cdf, cdf + GUIDING_NUM_BINS, 0.0f);
+      continue;
+    }
+
+    const float scale = (1.0f - GUIDING_UNIFORM_FRACTION) / sum;
+    float accum = 0.0f;
+    for (int bin = 0; bin < GUIDING_NUM_BINS; bin++) {
+      accum += histogram[bin] * scale + GUIDING_UNIFORM_FRACTION / GUIDING_NUM_BINS;
+      cdf[bin] = accum;
+    }
+    cdf[GUIDING_NUM_BINS - 1] = 1.0f;
+
+    num_distributions++;
+  }
+
+  kfield_.surface_probability = clamp(params.surface_probability, 0.0f, 1.0f);
+  has_distribution_ = (num_distributions > 0);
+
+  VLOG(3) << "Path guiding distributions in " << num_distributions << " of " << num_cells
+          << " cells";
+}
+
+const KernelGuidingField *GuidingField::get_kernel_field() const
+{
+  return (has_distribution_) ? &kfield_ : nullptr;
+}
+
+GuidingThreadStorage::GuidingThreadStorage(const int max_samples) : samples_(max_samples)
+{
+  data.num_segments = 0;
+  data.num_segments_direct_light = 0;
+  data.samples = samples_.data();
+  data.num_samples = 0;
+  data.max_samples = max_samples;
+  data.num_recorded = 0;
+}
+
+void GuidingThreadStorage::push_to_field(GuidingField &field)
+{
+  if (data.num_samples) {
+    /* Every recorded sample was kept with the same probability. */
+    const float weight = (float)data.num_recorded / data.num_samples;
+    field.add_samples(data.samples, data.num_samples, weight);
+  }
+
+  data.num_samples = 0;
+  data.num_recorded = 0;
+}
+
+void guiding_finish_path(KernelGuidingThreadData *data)
+{
+  for (int i = 0; i < data->num_segments; i++) {
+    const GuidingSegment &segment = data->segments[i];
+    const float value = average(segment.radiance) / segment.pdf;
+    if (!(value > 0.0f) || !isfinite_safe(value)) {
+      continue;
+    }
+
+    GuidingSample sample;
+    sample.P = segment.P;
+    sample.D = segment.D;
+    sample.value = value;
+
+    data->num_recorded++;
+    if (data->num_samples < data->max_samples) {
+      data->samples[data->num_samples++] = sample;
+    }
+    else {
+      /* Reservoir sampling, to keep a uniform selection of all recorded samples. */
+      const uint64_t index = hash_uint2((uint)data->num_recorded,
+                                        (uint)(data->num_recorded >> 32)) %
+                             data->num_recorded;
+      if (index < (uint64_t)data->max_samples) {
+        data->samples[index] = sample;
+      }
+    }
+  }
+
+  data->num_segments = 0;
+  data->num_segments_direct_light = 0;
+}
+
+CCL_NAMESPACE_END
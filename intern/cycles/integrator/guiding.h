@@ -0,0 +1,108 @@
+/*
+ * Copyright 2011-2021 Blender Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "kernel/types.h"
+
+#include "util/boundbox.h"
+#include "util/vector.h"
+
+CCL_NAMESPACE_BEGIN
+
+class GuidingParams {
+ public:
+  /* Guide paths with a field learned while rendering. Only used by CPU devices. */
+  bool use = false;
+
+  /* Number of samples during which the field is trained. */
+  int training_samples = 128;
+
+  /* Probability of sampling directions from the field at guided surfaces. */
+  float surface_probability = 0.5f;
+
+  bool modified(const GuidingParams &other) const
+  {
+    return !(use == other.use && training_samples == other.training_samples &&
+             surface_probability == other.surface_probability);
+  }
+};
+
+/* Guiding Field
+ *
+ * Regular grid over the bounds of the training samples, with a histogram of the radiance
+ * arriving from each direction in every cell. Training data is accumulated over all training
+ * passes, and the distributions used by the kernel are rebuilt after each of them. */
+
+class GuidingField {
+ public:
+  GuidingField();
+
+  void reset();
+
+  /* Add training samples, with their values multiplied by weight. */
+  void add_samples(const GuidingSample *samples, const int num_samples, const float weight);
+
+  /* Rebuild the distributions from all training samples added so far. */
+  void update(const GuidingParams &params);
+
+  /* Field in the layout used by the kernel, or null when no cell has a distribution yet. */
+  const KernelGuidingField *get_kernel_field() const;
+
+ protected:
+  void init_grid();
+  void splat_sample(const GuidingSample &sample);
+
+  bool has_grid_ = false;
+  bool has_distribution_ = false;
+  BoundBox bounds_ = BoundBox::empty;
+  KernelGuidingField kfield_;
+
+  /* Samples added before the bounds of the grid are known. */
+  vector<GuidingSample> pending_samples_;
+
+  vector<float> histograms_;
+  vector<int> num_cell_samples_;
+  vector<float> cdf_;
+};
+
+/* Guiding Thread Storage
+ *
+ * Training data recorded by the kernels running on one CPU thread. */
+
+/* Maximum number of training samples kept by a thread between updates of the field. */
+#define GUIDING_MAX_THREAD_SAMPLES (1 << 14)
+
+class GuidingThreadStorage {
+ public:
+  explicit GuidingThreadStorage(const int max_samples);
+
+  GuidingThreadStorage(const GuidingThreadStorage &other) = delete;
+  GuidingThreadStorage &operator=(const GuidingThreadStorage &other) = delete;
+
+  /* Add the samples recorded since the last push to the field. */
+  void push_to_field(GuidingField &field);
+
+  KernelGuidingThreadData data;
+
+ protected:
+  vector<GuidingSample> samples_;
+};
+
+/* Turn the segments of the path which was just traced into training samples. */
+void guiding_finish_path(KernelGuidingThreadData *data);
+
+CCL_NAMESPACE_END
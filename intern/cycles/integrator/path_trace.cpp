@@ -24,6 +24,7 @@
 #include "integrator/render_scheduler.h"
 #include "scene/pass.h"
 #include "scene/scene.h"
+#include "scene/stats.h"
 #include "session/tile.h"
 #include "util/algorithm.h"
 #include "util/log.h"
@@ -59,8 +60,13 @@ PathTrace::PathTrace(Device *device,
         path_trace_device, film, device_scene, &render_cancel_.is_requested));
   });
 
+  for (auto &&path_trace_work : path_trace_works_) {
+    work_balance_key_ += path_trace_work->get_device()->info.id + ";";
+  }
+
   work_balance_infos_.resize(path_trace_works_.size());
-  work_balance_do_initial(work_balance_infos_);
+  work_render_statistics_.resize(path_trace_works_.size());
+  work_balance_do_initial(work_balance_infos_, work_balance_key_);
 
   render_scheduler.set_need_schedule_rebalance(path_trace_works_.size() > 1);
 }
@@ -136,6 +142,13 @@ void PathTrace::reset(const BufferParams &full_params,
   render_state_.has_denoised_result = false;
   render_state_.tile_written = false;
 
+  if (reset_rendering) {
+    guiding_field_.reset();
+    for (WorkRenderStatistics &work_statistics : work_render_statistics_) {
+      work_statistics = WorkRenderStatistics();
+    }
+  }
+
   did_draw_after_reset_ = false;
 }
 
@@ -194,7 +207,9 @@ void PathTrace::render_pipeline(RenderWork render_work)
 
   rebalance(render_work);
 
+  guiding_prepare_structures(render_work);
   path_trace(render_work);
+  guiding_update_structures();
   if (render_cancel_.is_requested) {
     return;
   }
@@ -391,6 +406,11 @@ void PathTrace::path_trace(RenderWork &render_work)
     work_balance_infos_[i].time_spent += work_time;
     work_balance_infos_[i].occupancy = statistics.occupancy;
 
+    const BufferParams &work_params = path_trace_work->get_effective_buffer_params();
+    work_render_statistics_[i].time += work_time;
+    work_render_statistics_[i].num_pixel_samples += uint64_t(work_params.width) *
+                                                    work_params.height * num_samples;
+
     VLOG(3) << "Rendered " << num_samples << " samples in " << work_time << " seconds ("
             << work_time / num_samples
             << " seconds per sample), occupancy: " << statistics.occupancy;
@@ -407,6 +427,33 @@ void PathTrace::path_trace(RenderWork &render_work)
       render_work, time_dt() - start_time, is_cancel_requested());
 }
 
+void PathTrace::guiding_prepare_structures(const RenderWork &render_work)
+{
+  const bool use_guiding = guiding_params_.use;
+  const int training_sample = render_work.path_trace.start_sample -
+                              render_scheduler_.get_start_sample();
+
+  render_state_.guiding_train = use_guiding && render_work.path_trace.num_samples &&
+                                training_sample < guiding_params_.training_samples;
+
+  for (auto &&path_trace_work : path_trace_works_) {
+    path_trace_work->guiding_init_kernel_globals((use_guiding) ? &guiding_field_ : nullptr,
+                                                 render_state_.guiding_train);
+  }
+}
+
+void PathTrace::guiding_update_structures()
+{
+  if (!render_state_.guiding_train) {
+    return;
+  }
+
+  for (auto &&path_trace_work : path_trace_works_) {
+    path_trace_work->guiding_push_sample_data_to_field(&guiding_field_);
+  }
+  guiding_field_.update(guiding_params_);
+}
+
 void PathTrace::adaptive_sample(RenderWork &render_work)
 {
   if (!render_work.adaptive_sampling.filter) {
@@ -496,6 +543,14 @@ void PathTrace::set_adaptive_sampling(const AdaptiveSampling &adaptive_sampling)
   render_scheduler_.set_adaptive_sampling(adaptive_sampling);
 }
 
+void PathTrace::set_guiding_params(const GuidingParams &params)
+{
+  if (guiding_params_.modified(params)) {
+    guiding_params_ = params;
+    guiding_field_.reset();
+  }
+}
+
 void PathTrace::cryptomatte_postprocess(const RenderWork &render_work)
 {
   if (!render_work.cryptomatte.postprocess) {
@@ -685,6 +740,7 @@ void PathTrace::rebalance(const RenderWork &render_work)
   }
 
   const bool did_rebalance = work_balance_do_rebalance(work_balance_infos_);
+  work_balance_store(work_balance_infos_, work_balance_key_);
 
   if (VLOG_IS_ON(kLogLevel)) {
     VLOG(kLogLevel) << "Calculated per-device weights for works:";
@@ -1214,4 +1270,17 @@ string PathTrace::full_report() const
   return result;
 }
 
+void PathTrace::collect_statistics(RenderStats *stats) const
+{
+  render_scheduler_.collect_times(stats->times);
+
+  const int num_works = path_trace_works_.size();
+  for (int i = 0; i < num_works; ++i) {
+    const WorkRenderStatistics &work_statistics = work_render_statistics_[i];
+    stats->devices.emplace_back(path_trace_works_[i]->get_device()->info.description,
+                                work_statistics.num_pixel_samples,
+                                work_statistics.time);
+  }
+}
+
 CCL_NAMESPACE_END
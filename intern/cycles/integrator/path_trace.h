@@ -17,6 +17,7 @@
 #pragma once
 
 #include "integrator/denoiser.h"
+#include "integrator/guiding.h"
 #include "integrator/pass_accessor.h"
 #include "integrator/path_trace_work.h"
 #include "integrator/work_balancer.h"
@@ -35,6 +36,7 @@ class DisplayDriver;
 class Film;
 class RenderBuffers;
 class RenderScheduler;
+class RenderStats;
 class RenderWork;
 class PathTraceDisplay;
 class OutputDriver;
@@ -102,6 +104,10 @@ class PathTrace {
    * Use this to configure the adaptive sampler before rendering any samples. */
   void set_adaptive_sampling(const AdaptiveSampling &adaptive_sampling);
 
+  /* Set parameters used for path guiding.
+   * Use this to configure path guiding before rendering any samples. */
+  void set_guiding_params(const GuidingParams &params);
+
   /* Sets output driver for render buffer output. */
   void set_output_driver(unique_ptr<OutputDriver> driver);
 
@@ -179,6 +185,9 @@ class PathTrace {
    * times, and so on. */
   string full_report() const;
 
+  /* Add the rendering times and the path tracing throughput of the devices to the statistics. */
+  void collect_statistics(RenderStats *stats) const;
+
   /* Callback which is called to report current rendering progress.
    *
    * It is supposed to be cheaper than buffer update/write, hence can be called more often.
@@ -209,7 +218,9 @@ class PathTrace {
    * Note that some steps might modify the work, forcing some steps to happen within this iteration
    * of rendering. */
   void init_render_buffers(const RenderWork &render_work);
+  void guiding_prepare_structures(const RenderWork &render_work);
   void path_trace(RenderWork &render_work);
+  void guiding_update_structures();
   void adaptive_sample(RenderWork &render_work);
   void denoise(const RenderWork &render_work);
   void cryptomatte_postprocess(const RenderWork &render_work);
@@ -264,6 +275,18 @@ class PathTrace {
   /* Per-path trace work information needed for multi-device balancing. */
   vector<WorkBalanceInfo> work_balance_infos_;
 
+  /* Time spent path tracing and number of pixel samples rendered by every path trace work since
+   * rendering was reset, for render statistics. */
+  struct WorkRenderStatistics {
+    double time = 0.0;
+    uint64_t num_pixel_samples = 0;
+  };
+  vector<WorkRenderStatistics> work_render_statistics_;
+
+  /* Identifier of the devices of the path trace works, under which the balance between them is
+   * stored for later renders. */
+  string work_balance_key_;
+
   /* Render buffer parameters of the full frame and current big tile. */
   BufferParams full_params_;
   BufferParams big_tile_params_;
@@ -271,6 +294,10 @@ class PathTrace {
   /* Denoiser which takes care of denoising the big tile. */
   unique_ptr<Denoiser> denoiser_;
 
+  /* Path guiding field, trained during the first samples and kept until the next reset. */
+  GuidingParams guiding_params_;
+  GuidingField guiding_field_;
+
   /* State which is common for all the steps of the render work.
    * Is brought up to date in the `render()` call and is accessed from all the steps involved into
    * rendering the work. */
@@ -295,6 +322,9 @@ class PathTrace {
     /* Current tile has been written (to either disk or callback.
      * Indicates that no more work will be done on this tile. */
     bool tile_written = false;
+
+    /* Path guiding training data is recorded by the current render work. */
+    bool guiding_train = false;
   } render_state_;
 
   /* Progress object which is used to communicate sample progress. */
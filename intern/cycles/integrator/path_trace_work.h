@@ -28,6 +28,7 @@ class BufferParams;
 class Device;
 class DeviceScene;
 class Film;
+class GuidingField;
 class PathTraceDisplay;
 class RenderBuffers;
 
@@ -138,6 +139,18 @@ class PathTraceWork {
   /* Run cryptomatte pass post-processing kernels. */
   virtual void cryptomatte_postproces() = 0;
 
+  /* Set the guiding field the kernels sample directions from, and whether they record training
+   * data for it. Path guiding is only implemented for CPU devices, other devices ignore it. */
+  virtual void guiding_init_kernel_globals(const GuidingField * /*guiding_field*/,
+                                           const bool /*train*/)
+  {
+  }
+
+  /* Add the training data recorded since the last call to the guiding field. */
+  virtual void guiding_push_sample_data_to_field(GuidingField * /*guiding_field*/)
+  {
+  }
+
   /* Cheap-ish request to see whether rendering is requested and is to be stopped as soon as
    * possible, without waiting for any samples to be finished. */
   inline bool is_cancel_requested() const
@@ -153,6 +166,12 @@ class PathTraceWork {
     return device_;
   }
 
+  /* Parameters of the part of the big tile which this work renders. */
+  const BufferParams &get_effective_buffer_params() const
+  {
+    return effective_buffer_params_;
+  }
+
  protected:
   PathTraceWork(Device *device,
                 Film *film,
@@ -33,6 +33,9 @@
 
 CCL_NAMESPACE_BEGIN
 
+/* Size in pixels of the square blocks in which pixels are scheduled for rendering. */
+#define RENDER_BLOCK_SIZE 4
+
 /* Create TBB arena for execution of path tracing and rendering tasks. */
 static inline tbb::task_arena local_tbb_arena_create(const Device *device)
 {
@@ -76,7 +79,6 @@ void PathTraceWorkCPU::render_samples(RenderStatistics &statistics,
 {
   const int64_t image_width = effective_buffer_params_.width;
   const int64_t image_height = effective_buffer_params_.height;
-  const int64_t total_pixels_num = image_width * image_height;
 
   if (device_->profiler.active()) {
     for (CPUKernelThreadGlobals &kernel_globals : kernel_thread_globals_) {
@@ -84,19 +86,28 @@ void PathTraceWorkCPU::render_samples(RenderStatistics &statistics,
     }
   }
 
+  /* Pixels are scheduled in small square blocks rather than individually in scanline order, so
+   * that the paths traced one after another by a thread are spatially coherent. Neighboring
+   * pixels mostly traverse the same BVH nodes and evaluate the same shaders and textures, which
+   * then stay in the caches of the core. */
+  const int64_t num_blocks_x = divide_up(image_width, RENDER_BLOCK_SIZE);
+  const int64_t num_blocks_y = divide_up(image_height, RENDER_BLOCK_SIZE);
+  const int64_t total_blocks_num = num_blocks_x * num_blocks_y;
+
   tbb::task_arena local_arena = local_tbb_arena_create(device_);
   local_arena.execute([&]() {
-    tbb::parallel_for(int64_t(0), total_pixels_num, [&](int64_t work_index) {
-      if (is_cancel_requested()) {
-        return;
-      }
+    tbb::parallel_for(int64_t(0), total_blocks_num, [&](int64_t block_index) {
+      const int64_t block_y = block_index / num_blocks_x;
+      const int64_t block_x = block_index - block_y * num_blocks_x;
 
-      const int y = work_index / image_width;
-      const int x = work_index - y * image_width;
+      const int x_start = block_x * RENDER_BLOCK_SIZE;
+      const int y_start = block_y * RENDER_BLOCK_SIZE;
+      const int x_end = std::min(x_start + RENDER_BLOCK_SIZE, int(image_width));
+      const int y_end = std::min(y_start + RENDER_BLOCK_SIZE, int(image_height));
+
+      CPUKernelThreadGlobals *kernel_globals = kernel_thread_globals_get(kernel_thread_globals_);
 
       KernelWorkTile work_tile;
-      work_tile.x = effective_buffer_params_.full_x + x;
-      work_tile.y = effective_buffer_params_.full_y + y;
       work_tile.w = 1;
       work_tile.h = 1;
       work_tile.start_sample = start_sample;
@@ -105,9 +116,18 @@ void PathTraceWorkCPU::render_samples(RenderStatistics &statistics,
       work_tile.offset = effective_buffer_params_.offset;
       work_tile.stride = effective_buffer_params_.stride;
 
-      CPUKernelThreadGlobals *kernel_globals = kernel_thread_globals_get(kernel_thread_globals_);
+      for (int y = y_start; y < y_end; y++) {
+        for (int x = x_start; x < x_end; x++) {
+          if (is_cancel_requested()) {
+            return;
+          }
 
-      render_samples_full_pipeline(kernel_globals, work_tile, samples_num);
+          work_tile.x = effective_buffer_params_.full_x + x;
+          work_tile.y = effective_buffer_params_.full_y + y;
+
+          render_samples_full_pipeline(kernel_globals, work_tile, samples_num);
+        }
+      }
     });
   });
   if (device_->profiler.active()) {
@@ -157,9 +177,15 @@ void PathTraceWorkCPU::render_samples_full_pipeline(KernelGlobalsCPU *kernel_glo
     }
 
     kernels_.integrator_megakernel(kernel_globals, state, render_buffer);
+    if (kernel_globals->guiding_thread_data) {
+      guiding_finish_path(kernel_globals->guiding_thread_data);
+    }
 
     if (shadow_catcher_state) {
       kernels_.integrator_megakernel(kernel_globals, shadow_catcher_state, render_buffer);
+      if (kernel_globals->guiding_thread_data) {
+        guiding_finish_path(kernel_globals->guiding_thread_data);
+      }
     }
 
     ++sample_work_tile.start_sample;
@@ -289,4 +315,36 @@ void PathTraceWorkCPU::cryptomatte_postproces()
   });
 }
 
+void PathTraceWorkCPU::guiding_init_kernel_globals(const GuidingField *guiding_field,
+                                                   const bool train)
+{
+  const KernelGuidingField *kguiding_field = (guiding_field) ?
+                                                 guiding_field->get_kernel_field() :
+                                                 nullptr;
+
+  if (!train) {
+    guiding_thread_storage_.clear();
+  }
+  else if (guiding_thread_storage_.size() != kernel_thread_globals_.size()) {
+    guiding_thread_storage_.clear();
+    for (size_t i = 0; i < kernel_thread_globals_.size(); i++) {
+      guiding_thread_storage_.push_back(
+          make_unique<GuidingThreadStorage>(GUIDING_MAX_THREAD_SAMPLES));
+    }
+  }
+
+  for (size_t i = 0; i < kernel_thread_globals_.size(); i++) {
+    CPUKernelThreadGlobals &kernel_globals = kernel_thread_globals_[i];
+    kernel_globals.guiding_field = kguiding_field;
+    kernel_globals.guiding_thread_data = (train) ? &guiding_thread_storage_[i]->data : nullptr;
+  }
+}
+
+void PathTraceWorkCPU::guiding_push_sample_data_to_field(GuidingField *guiding_field)
+{
+  for (unique_ptr<GuidingThreadStorage> &storage : guiding_thread_storage_) {
+    storage->push_to_field(*guiding_field);
+  }
+}
+
 CCL_NAMESPACE_END
@@ -21,8 +21,10 @@
 #include "device/cpu/kernel_thread_globals.h"
 #include "device/queue.h"
 
+#include "integrator/guiding.h"
 #include "integrator/path_trace_work.h"
 
+#include "util/unique_ptr.h"
 #include "util/vector.h"
 
 CCL_NAMESPACE_BEGIN
@@ -63,6 +65,10 @@ class PathTraceWorkCPU : public PathTraceWork {
   virtual int adaptive_sampling_converge_filter_count_active(float threshold, bool reset) override;
   virtual void cryptomatte_postproces() override;
 
+  virtual void guiding_init_kernel_globals(const GuidingField *guiding_field,
+                                           const bool train) override;
+  virtual void guiding_push_sample_data_to_field(GuidingField *guiding_field) override;
+
  protected:
   /* Core path tracing routine. Renders given work time on the given queue. */
   void render_samples_full_pipeline(KernelGlobalsCPU *kernel_globals,
@@ -78,6 +84,9 @@ class PathTraceWorkCPU : public PathTraceWork {
    * accessing it, but some "localization" is required to decouple from kernel globals stored
    * on the device level. */
   vector<CPUKernelThreadGlobals> kernel_thread_globals_;
+
+  /* Path guiding training data recorded by each thread. Only allocated while training. */
+  vector<unique_ptr<GuidingThreadStorage>> guiding_thread_storage_;
 };
 
 CCL_NAMESPACE_END
@@ -16,6 +16,8 @@
 
 #include "integrator/render_scheduler.h"
 
+#include "scene/stats.h"
+
 #include "session/session.h"
 #include "session/tile.h"
 #include "util/log.h"
@@ -584,6 +586,15 @@ void RenderScheduler::report_rebalance_time(const RenderWork &render_work,
   VLOG(4) << "Average rebalance time: " << rebalance_time_.get_average() << " seconds.";
 }
 
+void RenderScheduler::collect_times(NamedTimeStats &times) const
+{
+  times.add_entry({"path_tracing", path_trace_time_.get_wall()});
+  times.add_entry({"adaptive_filter", adaptive_filter_time_.get_wall()});
+  times.add_entry({"denoise", denoise_time_.get_wall()});
+  times.add_entry({"display_update", display_update_time_.get_wall()});
+  times.add_entry({"rebalance", rebalance_time_.get_wall()});
+}
+
 string RenderScheduler::full_report() const
 {
   const double render_wall_time = state_.end_render_time - state_.start_render_time;
@@ -23,6 +23,7 @@
 
 CCL_NAMESPACE_BEGIN
 
+class NamedTimeStats;
 class SessionParams;
 class TileManager;
 
@@ -200,6 +201,9 @@ class RenderScheduler {
    * times, and so on. */
   string full_report() const;
 
+  /* Add the wall times of the rendering steps to the statistics. */
+  void collect_times(NamedTimeStats &times) const;
+
  protected:
   /* Check whether all work has been scheduled and time limit was not exceeded.
    *
@@ -16,13 +16,20 @@
 
 #include "integrator/work_balancer.h"
 
+#include "util/map.h"
 #include "util/math.h"
+#include "util/thread.h"
 
 #include "util/log.h"
 
 CCL_NAMESPACE_BEGIN
 
-void work_balance_do_initial(vector<WorkBalanceInfo> &work_balance_infos)
+/* Weights of the last balance of every set of devices, shared by all renders in the process. */
+static thread_mutex stored_weights_mutex;
+static map<string, vector<double>> stored_weights;
+
+void work_balance_do_initial(vector<WorkBalanceInfo> &work_balance_infos,
+                             const string &devices_key)
 {
   const int num_infos = work_balance_infos.size();
 
@@ -31,6 +38,17 @@ void work_balance_do_initial(vector<WorkBalanceInfo> &work_balance_infos)
     return;
   }
 
+  if (!devices_key.empty()) {
+    thread_scoped_lock lock(stored_weights_mutex);
+    auto it = stored_weights.find(devices_key);
+    if (it != stored_weights.end() && it->second.size() == work_balance_infos.size()) {
+      for (int i = 0; i < num_infos; ++i) {
+        work_balance_infos[i].weight = it->second[i];
+      }
+      return;
+    }
+  }
+
   /* There is no statistics available, so start with an equal distribution. */
   const double weight = 1.0 / num_infos;
   for (WorkBalanceInfo &balance_info : work_balance_infos) {
@@ -96,4 +114,21 @@ bool work_balance_do_rebalance(vector<WorkBalanceInfo> &work_balance_infos)
   return true;
 }
 
+void work_balance_store(const vector<WorkBalanceInfo> &work_balance_infos,
+                        const string &devices_key)
+{
+  if (devices_key.empty() || work_balance_infos.size() < 2) {
+    return;
+  }
+
+  vector<double> weights;
+  weights.reserve(work_balance_infos.size());
+  for (const WorkBalanceInfo &info : work_balance_infos) {
+    weights.push_back(info.weight);
+  }
+
+  thread_scoped_lock lock(stored_weights_mutex);
+  stored_weights[devices_key] = weights;
+}
+
 CCL_NAMESPACE_END
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "util/string.h"
 #include "util/vector.h"
 
 CCL_NAMESPACE_BEGIN
@@ -32,11 +33,20 @@ struct WorkBalanceInfo {
   double weight = 1.0;
 };
 
-/* Balance work for an initial render integration, before any statistics is known. */
-void work_balance_do_initial(vector<WorkBalanceInfo> &work_balance_infos);
+/* Balance work for an initial render integration, before any statistics is known.
+ * Starts from the weights stored by an earlier render on the same devices, if any, and from an
+ * equal distribution otherwise. */
+void work_balance_do_initial(vector<WorkBalanceInfo> &work_balance_infos,
+                             const string &devices_key = "");
 
 /* Rebalance work after statistics has been accumulated.
  * Returns true if the balancing did change. */
 bool work_balance_do_rebalance(vector<WorkBalanceInfo> &work_balance_infos);
 
+/* Store the weights of the balance, to be used by the initial balance of later renders on the
+ * devices identified by the key. Devices keep about the same relative performance from one frame
+ * to the next, so this avoids starting every frame of an animation from an equal distribution. */
+void work_balance_store(const vector<WorkBalanceInfo> &work_balance_infos,
+                        const string &devices_key);
+
 CCL_NAMESPACE_END
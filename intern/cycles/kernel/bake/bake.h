@@ -101,6 +101,7 @@ ccl_device void kernel_curve_shadow_transparency_evaluate(
     ccl_global float *output,
     const int offset)
 {
+#ifdef __HAIR__
   /* Setup shader data. */
   const KernelShaderEvalInput in = input[offset];
 
@@ -114,6 +115,7 @@ ccl_device void kernel_curve_shadow_transparency_evaluate(
 
   /* Write output. */
   output[offset] = clamp(average(shader_bsdf_transparency(kg, &sd)), 0.0f, 1.0f);
+#endif
 }
 
 CCL_NAMESPACE_END
@@ -200,7 +200,7 @@ ccl_device_inline
                 break;
               }
 #endif
-#if BVH_FEATURE(BVH_POINTCLOUD)
+#if BVH_FEATURE(BVH_POINTCLOUD) && defined(__POINTCLOUD__)
               case PRIMITIVE_POINT:
               case PRIMITIVE_MOTION_POINT: {
                 if ((type & PRIMITIVE_MOTION) && kernel_data.bvh.use_bvh_steps) {
@@ -227,7 +227,7 @@ ccl_device_inline
                                       point_type);
                 break;
               }
-#endif /* BVH_FEATURE(BVH_POINTCLOUD) */
+#endif /* BVH_FEATURE(BVH_POINTCLOUD) && __POINTCLOUD__ */
               default: {
                 hit = false;
                 break;
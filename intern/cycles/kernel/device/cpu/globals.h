@@ -52,6 +52,13 @@ typedef struct KernelGlobalsCPU {
   /* **** Run-time data ****  */
 
   ProfilingState profiler;
+
+#ifdef __PATH_GUIDING__
+  /* Field to sample directions from, and storage for the training data of this thread. Null
+   * when guiding or training is not used. */
+  const KernelGuidingField *guiding_field = nullptr;
+  KernelGuidingThreadData *guiding_thread_data = nullptr;
+#endif
 } KernelGlobalsCPU;
 
 typedef const KernelGlobalsCPU *ccl_restrict KernelGlobals;
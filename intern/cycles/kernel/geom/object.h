@@ -85,12 +85,14 @@ ccl_device_inline Transform object_fetch_transform_motion(KernelGlobals kg, int
 
   return tfm;
 }
+#endif
 
 ccl_device_inline Transform object_fetch_transform_motion_test(KernelGlobals kg,
                                                                int object,
                                                                float time,
                                                                ccl_private Transform *itfm)
 {
+#ifdef __OBJECT_MOTION__
   int object_flag = kernel_tex_fetch(__object_flag, object);
   if (object_flag & SD_OBJECT_MOTION) {
     /* if we do motion blur */
@@ -101,7 +103,9 @@ ccl_device_inline Transform object_fetch_transform_motion_test(KernelGlobals kg,
 
     return tfm;
   }
-  else {
+  else
+#endif
+  {
     Transform tfm = object_fetch_transform(kg, object, OBJECT_TRANSFORM);
     if (itfm)
       *itfm = object_fetch_transform(kg, object, OBJECT_INVERSE_TRANSFORM);
@@ -109,7 +113,6 @@ ccl_device_inline Transform object_fetch_transform_motion_test(KernelGlobals kg,
     return tfm;
   }
 }
-#endif
 
 /* Get transform matrix for shading point. */
 
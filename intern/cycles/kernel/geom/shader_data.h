@@ -288,6 +288,7 @@ ccl_device void shader_setup_from_displace(KernelGlobals kg,
       LAMP_NONE);
 }
 
+#ifdef __HAIR__
 /* ShaderData setup for point on curve. */
 
 ccl_device void shader_setup_from_curve(KernelGlobals kg,
@@ -362,6 +363,7 @@ ccl_device void shader_setup_from_curve(KernelGlobals kg,
   sd->dv = differential_zero();
 #endif
 }
+#endif /* __HAIR__ */
 
 /* ShaderData setup from ray into background */
 
@@ -22,6 +22,8 @@
 
 #pragma once
 
+#include "util/color.h"
+
 CCL_NAMESPACE_BEGIN
 
 /* Normal on triangle. */
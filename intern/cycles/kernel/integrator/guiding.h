@@ -0,0 +1,209 @@
+/*
+ * Copyright 2011-2021 Blender Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+CCL_NAMESPACE_BEGIN
+
+#ifdef __PATH_GUIDING__
+
+/* Path Guiding
+ *
+ * At diffuse surfaces, directions are sampled from a mix of the BSDF and the distribution of
+ * radiance arriving at the cell of the guiding field which contains the shading point. This
+ * finds light which only reaches parts of the scene through small openings, which BSDF sampling
+ * rarely does.
+ *
+ * The field is learned from the paths of the first samples. Every scattering event at a guided
+ * surface is recorded as a segment of the path, and all later contributions of the path to the
+ * render buffer are divided by the throughput of the segment to get the radiance arriving from
+ * its direction. The host turns the segments of finished paths into training samples, see
+ * integrator/guiding.h. */
+
+/* Directional Distribution */
+
+ccl_device_inline int guiding_direction_bin(const float3 D)
+{
+  const float u = 0.5f * (D.z + 1.0f);
+  const float v = (atan2f(D.y, D.x) + M_PI_F) * M_1_2PI_F;
+  const int iu = clamp((int)(u * GUIDING_DIRECTION_RES), 0, GUIDING_DIRECTION_RES - 1);
+  const int iv = clamp((int)(v * GUIDING_DIRECTION_RES), 0, GUIDING_DIRECTION_RES - 1);
+  return iu * GUIDING_DIRECTION_RES + iv;
+}
+
+/* Index of the cell containing P, points outside of the grid are in the closest cell. */
+ccl_device_inline int guiding_cell_index(const KernelGuidingField *field, const float3 P)
+{
+  const float3 offset = (P - field->bounds_min) * field->inv_cell_size;
+  const int x = clamp((int)offset.x, 0, field->resolution[0] - 1);
+  const int y = clamp((int)offset.y, 0, field->resolution[1] - 1);
+  const int z = clamp((int)offset.z, 0, field->resolution[2] - 1);
+  return (z * field->resolution[1] + y) * field->resolution[0] + x;
+}
+
+/* Index of the cell containing P, or -1 if the cell has no distribution. */
+ccl_device_inline int guiding_cell(const KernelGuidingField *field, const float3 P)
+{
+  const int cell = guiding_cell_index(field, P);
+  return (field->cdf[cell * GUIDING_NUM_BINS + GUIDING_NUM_BINS - 1] > 0.0f) ? cell : -1;
+}
+
+ccl_device_inline float guiding_cell_pdf(const KernelGuidingField *field,
+                                         const int cell,
+                                         const float3 D)
+{
+  const float *cdf = field->cdf + cell * GUIDING_NUM_BINS;
+  const int bin = guiding_direction_bin(D);
+  const float prob = cdf[bin] - ((bin > 0) ? cdf[bin - 1] : 0.0f);
+
+  /* All bins cover the same solid angle. */
+  return prob * (GUIDING_NUM_BINS * 0.25f * M_1_PI_F);
+}
+
+ccl_device_inline float3 guiding_cell_sample(const KernelGuidingField *field,
+                                             const int cell,
+                                             float randu,
+                                             const float randv,
+                                             ccl_private float *pdf)
+{
+  const float *cdf = field->cdf + cell * GUIDING_NUM_BINS;
+
+  /* Find the first bin with a cumulative probability above randu. */
+  int first = 0;
+  int len = GUIDING_NUM_BINS;
+  while (len > 0) {
+    const int half_len = len >> 1;
+    const int middle = first + half_len;
+    if (cdf[middle] <= randu) {
+      first = middle + 1;
+      len -= half_len + 1;
+    }
+    else {
+      len = half_len;
+    }
+  }
+  const int bin = min(first, GUIDING_NUM_BINS - 1);
+
+  /* Rescale to sample a position within the bin. */
+  const float cdf_prev = (bin > 0) ? cdf[bin - 1] : 0.0f;
+  const float prob = cdf[bin] - cdf_prev;
+  randu = min((randu - cdf_prev) / prob, 1.0f - FLT_EPSILON);
+
+  const int iu = bin / GUIDING_DIRECTION_RES;
+  const int iv = bin - iu * GUIDING_DIRECTION_RES;
+  const float cos_theta = -1.0f + 2.0f * (iu + randu) / GUIDING_DIRECTION_RES;
+  const float phi = -M_PI_F + M_2PI_F * (iv + randv) / GUIDING_DIRECTION_RES;
+  const float sin_theta = safe_sqrtf(1.0f - sqr(cos_theta));
+
+  *pdf = prob * (GUIDING_NUM_BINS * 0.25f * M_1_PI_F);
+  return make_float3(sin_theta * cosf(phi), sin_theta * sinf(phi), cos_theta);
+}
+
+/* Probability of sampling the direction from the guiding field at a surface, and the cell to
+ * sample from. Only surfaces with just diffuse closures are guided, as the distribution does not
+ * take the BSDF into account, which matters much more for glossy closures. */
+ccl_device_inline float guiding_surface_probability(KernelGlobals kg,
+                                                    ccl_private const ShaderData *sd,
+                                                    ccl_private int *cell)
+{
+  *cell = -1;
+
+  const KernelGuidingField *field = kg->guiding_field;
+  if (field == nullptr || !(sd->flag & SD_BSDF) || (sd->flag & SD_BSSRDF)) {
+    return 0.0f;
+  }
+
+  for (int i = 0; i < sd->num_closure; i++) {
+    ccl_private const ShaderClosure *sc = &sd->closure[i];
+    if (CLOSURE_IS_BSDF(sc->type) && !CLOSURE_IS_BSDF_DIFFUSE(sc->type)) {
+      return 0.0f;
+    }
+  }
+
+  *cell = guiding_cell(field, sd->P);
+  return (*cell != -1) ? field->surface_probability : 0.0f;
+}
+
+/* Training */
+
+/* Record the direction sampled at a guided surface, with the path throughput after scattering. */
+ccl_device_forceinline void guiding_record_surface_segment(KernelGlobals kg,
+                                                           const float3 P,
+                                                           const float3 D,
+                                                           const float3 throughput,
+                                                           const float pdf)
+{
+  KernelGuidingThreadData *data = kg->guiding_thread_data;
+  if (data == nullptr || data->num_segments == GUIDING_MAX_SEGMENTS) {
+    return;
+  }
+
+  GuidingSegment *segment = &data->segments[data->num_segments++];
+  segment->P = P;
+  segment->D = D;
+  segment->throughput = throughput;
+  segment->radiance = zero_float3();
+  segment->pdf = pdf;
+}
+
+/* Remember which segments receive the light of the shadow ray being branched off. The light does
+ * not arrive from the direction of segments recorded at the same vertex or later. */
+ccl_device_forceinline void guiding_record_direct_light(KernelGlobals kg)
+{
+  KernelGuidingThreadData *data = kg->guiding_thread_data;
+  if (data == nullptr) {
+    return;
+  }
+
+  data->num_segments_direct_light = data->num_segments;
+}
+
+ccl_device_forceinline void guiding_record_contribution(KernelGlobals kg,
+                                                        const float3 contribution,
+                                                        int num_segments)
+{
+  KernelGuidingThreadData *data = kg->guiding_thread_data;
+  if (data == nullptr) {
+    return;
+  }
+
+  num_segments = min(num_segments, data->num_segments);
+  for (int i = 0; i < num_segments; i++) {
+    GuidingSegment *segment = &data->segments[i];
+    segment->radiance += safe_divide_float3_float3(contribution, segment->throughput);
+  }
+}
+
+/* Emission found by the path, arriving from the direction of all recorded segments. */
+ccl_device_forceinline void guiding_record_emission(KernelGlobals kg, const float3 contribution)
+{
+  guiding_record_contribution(kg, contribution, GUIDING_MAX_SEGMENTS);
+}
+
+/* Light of an unoccluded shadow ray. */
+ccl_device_forceinline void guiding_record_light(KernelGlobals kg, const float3 contribution)
+{
+  const KernelGuidingThreadData *data = kg->guiding_thread_data;
+  if (data == nullptr) {
+    return;
+  }
+
+  guiding_record_contribution(kg, contribution, data->num_segments_direct_light);
+}
+
+#endif /* __PATH_GUIDING__ */
+
+CCL_NAMESPACE_END
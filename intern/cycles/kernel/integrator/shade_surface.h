@@ -19,6 +19,7 @@
 #include "kernel/film/accumulate.h"
 #include "kernel/film/passes.h"
 
+#include "kernel/integrator/guiding.h"
 #include "kernel/integrator/path_state.h"
 #include "kernel/integrator/shader_eval.h"
 #include "kernel/integrator/subsurface.h"
@@ -148,9 +149,19 @@ ccl_device_forceinline void integrate_surface_direct_light(KernelGlobals kg,
   const bool is_transmission = shader_bsdf_is_transmission(sd, ls.D);
 
   BsdfEval bsdf_eval ccl_optional_struct_init;
-  const float bsdf_pdf = shader_bsdf_eval(kg, sd, ls.D, is_transmission, &bsdf_eval, ls.shader);
+  float bsdf_pdf = shader_bsdf_eval(kg, sd, ls.D, is_transmission, &bsdf_eval, ls.shader);
   bsdf_eval_mul3(&bsdf_eval, light_eval / ls.pdf);
 
+#ifdef __PATH_GUIDING__
+  /* Indirect light is sampled from the mix of the BSDF and guiding field. */
+  int guiding_cell;
+  const float guiding_probability = guiding_surface_probability(kg, sd, &guiding_cell);
+  if (guiding_probability > 0.0f) {
+    bsdf_pdf = guiding_probability * guiding_cell_pdf(kg->guiding_field, guiding_cell, ls.D) +
+               (1.0f - guiding_probability) * bsdf_pdf;
+  }
+#endif
+
   if (ls.shader & SHADER_USE_MIS) {
     const float mis_weight = light_sample_mis_weight_nee(kg, ls.pdf, bsdf_pdf);
     bsdf_eval_mul(&bsdf_eval, mis_weight);
@@ -183,6 +194,10 @@ ccl_device_forceinline void integrate_surface_direct_light(KernelGlobals kg,
   /* Write shadow ray and associated state to global memory. */
   integrator_state_write_shadow_ray(kg, shadow_state, &ray);
 
+#ifdef __PATH_GUIDING__
+  guiding_record_direct_light(kg);
+#endif
+
   /* Copy state from main path to shadow path. */
   const uint16_t bounce = INTEGRATOR_STATE(state, path, bounce);
   const uint16_t transparent_bounce = INTEGRATOR_STATE(state, path, transparent_bounce);
@@ -228,6 +243,57 @@ ccl_device_forceinline void integrate_surface_direct_light(KernelGlobals kg,
 }
 #endif
 
+#ifdef __PATH_GUIDING__
+/* Sample a direction from the mix of the BSDF and guiding field, returning the evaluation of all
+ * closures and the pdf of the mix. */
+ccl_device_forceinline int integrate_surface_guided_sample(KernelGlobals kg,
+                                                           ccl_private ShaderData *sd,
+                                                           const int guiding_cell,
+                                                           const float guiding_probability,
+                                                           float bsdf_u,
+                                                           const float bsdf_v,
+                                                           ccl_private BsdfEval *bsdf_eval,
+                                                           ccl_private float3 *omega_in,
+                                                           ccl_private differential3 *domega_in,
+                                                           ccl_private float *pdf)
+{
+  const KernelGuidingField *field = kg->guiding_field;
+  float guiding_pdf, bsdf_pdf;
+  int label;
+
+  if (bsdf_u < guiding_probability) {
+    bsdf_u /= guiding_probability;
+    *omega_in = guiding_cell_sample(field, guiding_cell, bsdf_u, bsdf_v, &guiding_pdf);
+
+    /* All closures are diffuse, see guiding_surface_probability(). */
+    const bool is_transmission = shader_bsdf_is_transmission(sd, *omega_in);
+    bsdf_pdf = shader_bsdf_eval(kg, sd, *omega_in, is_transmission, bsdf_eval, 0);
+    label = LABEL_DIFFUSE | ((is_transmission) ? LABEL_TRANSMIT : LABEL_REFLECT);
+
+#  ifdef __RAY_DIFFERENTIALS__
+    /* Same differentials as diffuse BSDF sampling. */
+    const float sign = (is_transmission) ? -1.0f : 1.0f;
+    domega_in->dx = sign * ((2.0f * dot(sd->N, sd->dI.dx)) * sd->N - sd->dI.dx);
+    domega_in->dy = sign * ((2.0f * dot(sd->N, sd->dI.dy)) * sd->N - sd->dI.dy);
+#  endif
+  }
+  else {
+    bsdf_u = (bsdf_u - guiding_probability) / (1.0f - guiding_probability);
+    ccl_private const ShaderClosure *sc = shader_bsdf_bssrdf_pick(sd, &bsdf_u);
+    label = shader_bsdf_sample_closure(
+        kg, sd, sc, bsdf_u, bsdf_v, bsdf_eval, omega_in, domega_in, &bsdf_pdf);
+    if (bsdf_pdf == 0.0f) {
+      *pdf = 0.0f;
+      return LABEL_NONE;
+    }
+    guiding_pdf = guiding_cell_pdf(field, guiding_cell, *omega_in);
+  }
+
+  *pdf = guiding_probability * guiding_pdf + (1.0f - guiding_probability) * bsdf_pdf;
+  return label;
+}
+#endif
+
 /* Path tracing: bounce off or through surface with new direction. */
 ccl_device_forceinline int integrate_surface_bsdf_bssrdf_bounce(
     KernelGlobals kg,
@@ -242,24 +308,44 @@ ccl_device_forceinline int integrate_surface_bsdf_bssrdf_bounce(
 
   float bsdf_u, bsdf_v;
   path_state_rng_2D(kg, rng_state, PRNG_BSDF_U, &bsdf_u, &bsdf_v);
-  ccl_private const ShaderClosure *sc = shader_bsdf_bssrdf_pick(sd, &bsdf_u);
-
-#ifdef __SUBSURFACE__
-  /* BSSRDF closure, we schedule subsurface intersection kernel. */
-  if (CLOSURE_IS_BSSRDF(sc->type)) {
-    return subsurface_bounce(kg, state, sd, sc);
-  }
-#endif
 
-  /* BSDF closure, sample direction. */
   float bsdf_pdf;
   BsdfEval bsdf_eval ccl_optional_struct_init;
   float3 bsdf_omega_in ccl_optional_struct_init;
   differential3 bsdf_domega_in ccl_optional_struct_init;
   int label;
 
-  label = shader_bsdf_sample_closure(
-      kg, sd, sc, bsdf_u, bsdf_v, &bsdf_eval, &bsdf_omega_in, &bsdf_domega_in, &bsdf_pdf);
+#ifdef __PATH_GUIDING__
+  int guiding_cell;
+  const float guiding_probability = guiding_surface_probability(kg, sd, &guiding_cell);
+  if (guiding_probability > 0.0f) {
+    label = integrate_surface_guided_sample(kg,
+                                            sd,
+                                            guiding_cell,
+                                            guiding_probability,
+                                            bsdf_u,
+                                            bsdf_v,
+                                            &bsdf_eval,
+                                            &bsdf_omega_in,
+                                            &bsdf_domega_in,
+                                            &bsdf_pdf);
+  }
+  else
+#endif
+  {
+    ccl_private const ShaderClosure *sc = shader_bsdf_bssrdf_pick(sd, &bsdf_u);
+
+#ifdef __SUBSURFACE__
+    /* BSSRDF closure, we schedule subsurface intersection kernel. */
+    if (CLOSURE_IS_BSSRDF(sc->type)) {
+      return subsurface_bounce(kg, state, sd, sc);
+    }
+#endif
+
+    /* BSDF closure, sample direction. */
+    label = shader_bsdf_sample_closure(
+        kg, sd, sc, bsdf_u, bsdf_v, &bsdf_eval, &bsdf_omega_in, &bsdf_domega_in, &bsdf_pdf);
+  }
 
   if (bsdf_pdf == 0.0f || bsdf_eval_is_zero(&bsdf_eval)) {
     return LABEL_NONE;
@@ -283,6 +369,13 @@ ccl_device_forceinline int integrate_surface_bsdf_bssrdf_bounce(
   throughput *= bsdf_eval_sum(&bsdf_eval) / bsdf_pdf;
   INTEGRATOR_STATE_WRITE(state, path, throughput) = throughput;
 
+#ifdef __PATH_GUIDING__
+  if (guiding_probability > 0.0f) {
+    guiding_record_surface_segment(
+        kg, sd->P, INTEGRATOR_STATE(state, ray, D), throughput, bsdf_pdf);
+  }
+#endif
+
   if (kernel_data.kernel_features & KERNEL_FEATURE_LIGHT_PASSES) {
     if (INTEGRATOR_STATE(state, path, bounce) == 0) {
       INTEGRATOR_STATE_WRITE(state, path, pass_diffuse_weight) = bsdf_eval_pass_diffuse_weight(
@@ -19,6 +19,7 @@
 #include "kernel/film/accumulate.h"
 #include "kernel/film/passes.h"
 
+#include "kernel/integrator/guiding.h"
 #include "kernel/integrator/intersect_closest.h"
 #include "kernel/integrator/path_state.h"
 #include "kernel/integrator/shader_eval.h"
@@ -59,6 +60,9 @@ typedef struct VolumeIntegrateResult {
  * work in volumes and subsurface scattering. */
 #  define VOLUME_THROUGHPUT_EPSILON 1e-6f
 
+/* Maximum growth of the step size in empty parts of heterogeneous volumes. */
+#  define VOLUME_EMPTY_STEP_MAX_SCALE 4.0f
+
 /* Volume shader properties
  *
  * extinction coefficient = absorption coefficient + scattering coefficient
@@ -162,6 +166,21 @@ ccl_device_forceinline void volume_step_init(KernelGlobals kg,
   }
 }
 
+/* Scale of the next step size for heterogeneous volumes. Volume bounds follow the active
+ * voxels of the grids only coarsely, so when enabled steps are doubled after every step without
+ * density, to cross empty space in fewer shader evaluations. Once density is found again the
+ * step size goes back to the original one. This is a heuristic: density following a step
+ * without any can be skipped, so it is disabled by default. */
+ccl_device_forceinline float volume_step_scale_update(KernelGlobals kg,
+                                                      const float step_scale,
+                                                      const bool is_empty)
+{
+  if (!kernel_data.integrator.use_volume_empty_skip) {
+    return 1.0f;
+  }
+  return (is_empty) ? min(step_scale * 2.0f, VOLUME_EMPTY_STEP_MAX_SCALE) : 1.0f;
+}
+
 /* Volume Shadows
  *
  * These functions are used to attenuate shadow rays to lights. Both absorption
@@ -212,16 +231,16 @@ ccl_device void volume_shadow_heterogeneous(KernelGlobals kg,
                    &step_shade_offset,
                    &unused,
                    &max_steps);
-  const float steps_offset = 1.0f;
 
   /* compute extinction at the start */
   float t = 0.0f;
+  float step_scale = 1.0f;
 
   float3 sum = zero_float3();
 
   for (int i = 0; i < max_steps; i++) {
     /* advance to new position */
-    float new_t = min(ray->t, (i + steps_offset) * step_size);
+    float new_t = min(ray->t, t + step_size * step_scale);
     float dt = new_t - t;
 
     float3 new_P = ray->P + ray->D * (t + dt * step_shade_offset);
@@ -229,7 +248,9 @@ ccl_device void volume_shadow_heterogeneous(KernelGlobals kg,
 
     /* compute attenuation over segment */
     sd->P = new_P;
-    if (shadow_volume_shader_sample(kg, state, sd, &sigma_t)) {
+    const bool has_extinction = shadow_volume_shader_sample(kg, state, sd, &sigma_t);
+    step_scale = volume_step_scale_update(kg, step_scale, !has_extinction);
+    if (has_extinction) {
       /* Compute `expf()` only for every Nth step, to save some calculations
        * because `exp(a)*exp(b) = exp(a+b)`, also do a quick #VOLUME_THROUGHPUT_EPSILON
        * check then. */
@@ -588,16 +609,21 @@ ccl_device_forceinline void volume_integrate_heterogeneous(
   float3 accum_albedo = zero_float3();
 #  endif
   float3 accum_emission = zero_float3();
+  float step_scale = 1.0f;
 
   for (int i = 0; i < max_steps; i++) {
     /* Advance to new position */
-    vstate.end_t = min(ray->t, (i + steps_offset) * step_size);
+    vstate.end_t = min(ray->t,
+                       (i == 0) ? steps_offset * step_size :
+                                  vstate.start_t + step_size * step_scale);
     const float shade_t = vstate.start_t + (vstate.end_t - vstate.start_t) * step_shade_offset;
     sd->P = ray->P + ray->D * shade_t;
 
     /* compute segment */
     VolumeShaderCoefficients coeff ccl_optional_struct_init;
-    if (volume_shader_sample(kg, state, sd, &coeff)) {
+    const bool has_coefficients = volume_shader_sample(kg, state, sd, &coeff);
+    step_scale = volume_step_scale_update(kg, step_scale, !has_coefficients);
+    if (has_coefficients) {
       const int closure_flag = sd->flag;
 
       /* Evaluate transmittance over segment. */
@@ -792,6 +818,10 @@ ccl_device_forceinline void integrate_volume_direct_light(
   /* Write shadow ray and associated state to global memory. */
   integrator_state_write_shadow_ray(kg, shadow_state, &ray);
 
+#  ifdef __PATH_GUIDING__
+  guiding_record_direct_light(kg);
+#  endif
+
   /* Copy state from main path to shadow path. */
   const uint16_t bounce = INTEGRATOR_STATE(state, path, bounce);
   const uint16_t transparent_bounce = INTEGRATOR_STATE(state, path, transparent_bounce);
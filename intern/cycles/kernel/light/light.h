@@ -18,6 +18,7 @@
 
 #include "kernel/geom/geom.h"
 #include "kernel/light/background.h"
+#include "kernel/light/tree.h"
 #include "kernel/sample/mapping.h"
 
 CCL_NAMESPACE_BEGIN
@@ -224,7 +225,7 @@ ccl_device_inline bool light_sample(KernelGlobals kg,
     }
   }
 
-  ls->pdf *= kernel_data.integrator.pdf_lights;
+  ls->pdf *= light_select_lamp_pdf(kg, lamp, P);
 
   return in_volume_segment || (ls->pdf > 0.0f);
 }
@@ -516,7 +517,7 @@ ccl_device bool light_sample_from_intersection(KernelGlobals kg,
     return false;
   }
 
-  ls->pdf *= kernel_data.integrator.pdf_lights;
+  ls->pdf *= light_select_lamp_pdf(kg, lamp, ray_P);
 
   return true;
 }
@@ -553,18 +554,17 @@ ccl_device_inline bool triangle_world_space_vertices(
   return has_motion;
 }
 
-ccl_device_inline float triangle_light_pdf_area(KernelGlobals kg,
+ccl_device_inline float triangle_light_pdf_area(const float pdf_triangles,
                                                 const float3 Ng,
                                                 const float3 I,
                                                 float t)
 {
-  float pdf = kernel_data.integrator.pdf_triangles;
   float cos_pi = fabsf(dot(Ng, I));
 
   if (cos_pi == 0.0f)
     return 0.0f;
 
-  return t * t * pdf / cos_pi;
+  return t * t * pdf_triangles / cos_pi;
 }
 
 ccl_device_forceinline float triangle_light_pdf(KernelGlobals kg,
@@ -585,10 +585,12 @@ ccl_device_forceinline float triangle_light_pdf(KernelGlobals kg,
   const float3 N = cross(e0, e1);
   const float distance_to_plane = fabsf(dot(N, sd->I * t)) / dot(N, N);
 
+  /* sd contains the point on the light source
+   * calculate Px, the point that we're shading */
+  const float3 Px = sd->P + sd->I * t;
+  const float pdf_triangles = light_select_triangle_pdf(kg, sd->object, Px);
+
   if (longest_edge_squared > distance_to_plane * distance_to_plane) {
-    /* sd contains the point on the light source
-     * calculate Px, the point that we're shading */
-    const float3 Px = sd->P + sd->I * t;
     const float3 v0_p = V[0] - Px;
     const float3 v1_p = V[1] - Px;
     const float3 v2_p = V[2] - Px;
@@ -616,12 +618,12 @@ ccl_device_forceinline float triangle_light_pdf(KernelGlobals kg,
       else {
         area = 0.5f * len(N);
       }
-      const float pdf = area * kernel_data.integrator.pdf_triangles;
+      const float pdf = area * pdf_triangles;
       return pdf / solid_angle;
     }
   }
   else {
-    float pdf = triangle_light_pdf_area(kg, sd->Ng, sd->I, t);
+    float pdf = triangle_light_pdf_area(pdf_triangles, sd->Ng, sd->I, t);
     if (has_motion) {
       const float area = 0.5f * len(N);
       if (UNLIKELY(area == 0.0f)) {
@@ -678,6 +680,7 @@ ccl_device_forceinline void triangle_light_sample(KernelGlobals kg,
   ls->type = LIGHT_TRIANGLE;
 
   float distance_to_plane = fabsf(dot(N0, V[0] - P) / dot(N0, N0));
+  const float pdf_triangles = light_select_triangle_pdf(kg, object, P);
 
   if (!in_volume_segment && (longest_edge_squared > distance_to_plane * distance_to_plane)) {
     /* see James Arvo, "Stratified Sampling of Spherical Triangles"
@@ -758,7 +761,7 @@ ccl_device_forceinline void triangle_light_sample(KernelGlobals kg,
         triangle_world_space_vertices(kg, object, prim, -1.0f, V);
         area = triangle_area(V[0], V[1], V[2]);
       }
-      const float pdf = area * kernel_data.integrator.pdf_triangles;
+      const float pdf = area * pdf_triangles;
       ls->pdf = pdf / solid_angle;
     }
   }
@@ -780,7 +783,7 @@ ccl_device_forceinline void triangle_light_sample(KernelGlobals kg,
     ls->P = u * V[0] + v * V[1] + t * V[2];
     /* compute incoming direction, distance and pdf */
     ls->D = normalize_len(ls->P - P, &ls->t);
-    ls->pdf = triangle_light_pdf_area(kg, ls->Ng, -ls->D, ls->t);
+    ls->pdf = triangle_light_pdf_area(pdf_triangles, ls->Ng, -ls->D, ls->t);
     if (has_motion && area != 0.0f) {
       /* scale the PDF.
        * area = the area the sample was taken from
@@ -796,15 +799,22 @@ ccl_device_forceinline void triangle_light_sample(KernelGlobals kg,
 
 /* Light Distribution */
 
-ccl_device int light_distribution_sample(KernelGlobals kg, ccl_private float *randu)
+/* Select an entry in the range of the light distribution, proportional to area. randu is rescaled
+ * so that it can be used again. */
+ccl_device int light_distribution_sample_range(KernelGlobals kg,
+                                               const int range_first,
+                                               const int range_num,
+                                               ccl_private float *randu)
 {
   /* This is basically std::upper_bound as used by PBRT, to find a point light or
    * triangle to emit from, proportional to area. a good improvement would be to
    * also sample proportional to power, though it's not so well defined with
    * arbitrary shaders. */
-  int first = 0;
-  int len = kernel_data.integrator.num_distribution + 1;
-  float r = *randu;
+  const float range_min = kernel_tex_fetch(__light_distribution, range_first).totarea;
+  const float range_max = kernel_tex_fetch(__light_distribution, range_first + range_num).totarea;
+  int first = range_first;
+  int len = range_num + 1;
+  float r = range_min + *randu * (range_max - range_min);
 
   do {
     int half_len = len >> 1;
@@ -821,7 +831,7 @@ ccl_device int light_distribution_sample(KernelGlobals kg, ccl_private float *ra
 
   /* Clamping should not be needed but float rounding errors seem to
    * make this fail on rare occasions. */
-  int index = clamp(first - 1, 0, kernel_data.integrator.num_distribution - 1);
+  int index = clamp(first - 1, range_first, range_first + range_num - 1);
 
   /* Rescale to reuse random number. this helps the 2D samples within
    * each area light be stratified as well. */
@@ -832,6 +842,41 @@ ccl_device int light_distribution_sample(KernelGlobals kg, ccl_private float *ra
   return index;
 }
 
+ccl_device int light_distribution_sample(KernelGlobals kg, ccl_private float *randu)
+{
+  return light_distribution_sample_range(kg, 0, kernel_data.integrator.num_distribution, randu);
+}
+
+/* Select an entry in the light distribution using the light tree, returns -1 if no light
+ * contributes to the shading point. */
+ccl_device int light_tree_distribution_sample(KernelGlobals kg,
+                                              const float3 P,
+                                              ccl_private float *randu)
+{
+  const float tree_pdf = kernel_data.integrator.light_tree_pdf;
+
+  if (*randu >= tree_pdf) {
+    /* Distant and background lights, only they have a non-zero area in the distribution. */
+    *randu = min((*randu - tree_pdf) / (1.0f - tree_pdf), 1.0f - FLT_EPSILON);
+    const int lamp_offset = kernel_data.integrator.light_tree_lamp_offset;
+    return light_distribution_sample_range(
+        kg, lamp_offset, kernel_data.integrator.num_distribution - lamp_offset, randu);
+  }
+
+  *randu = *randu / tree_pdf;
+  const int leaf = light_tree_sample_leaf(kg, P, randu);
+  if (leaf == -1) {
+    return -1;
+  }
+
+  ccl_global const KernelLightTreeNode *knode = &kernel_tex_fetch(__light_tree_nodes, leaf);
+  if (knode->distribution_num == 1) {
+    return knode->distribution_first;
+  }
+  return light_distribution_sample_range(
+      kg, knode->distribution_first, knode->distribution_num, randu);
+}
+
 /* Generic Light */
 
 ccl_device_inline bool light_select_reached_max_bounces(KernelGlobals kg, int index, int bounce)
@@ -850,7 +895,12 @@ ccl_device_noinline bool light_distribution_sample(KernelGlobals kg,
                                                    ccl_private LightSample *ls)
 {
   /* Sample light index from distribution. */
-  const int index = light_distribution_sample(kg, &randu);
+  const int index = (kernel_data.integrator.use_light_tree) ?
+                        light_tree_distribution_sample(kg, P, &randu) :
+                        light_distribution_sample(kg, &randu);
+  if (index == -1) {
+    return false;
+  }
   ccl_global const KernelLightDistribution *kdistribution = &kernel_tex_fetch(__light_distribution,
                                                                               index);
   const int prim = kdistribution->prim;
@@ -0,0 +1,173 @@
+/*
+ * Copyright 2011-2021 Blender Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+CCL_NAMESPACE_BEGIN
+
+/* Light Tree
+ *
+ * Lamps and emissive objects are stored in a BVH, where every node has the bounds, total energy
+ * and orientation cone of the emitters below it. A light is selected by traversing the tree from
+ * the root, choosing each child with a probability proportional to an estimate of its
+ * contribution to the shading point, as in "Importance Sampling of Many Lights With Adaptive
+ * Tree Splitting" by Conty and Kulla.
+ *
+ * Only the position of the shading point is taken into account, so that the probability of
+ * selecting a light can be evaluated again when it is hit, for multiple importance sampling.
+ * Distant and background lights are not in the tree, and are selected uniformly. */
+
+ccl_device float light_tree_node_importance(const float3 P,
+                                            ccl_global const KernelLightTreeNode *knode)
+{
+  if (knode->energy == 0.0f) {
+    return 0.0f;
+  }
+
+  const float3 bbox_min = make_float3(knode->bbox_min[0], knode->bbox_min[1], knode->bbox_min[2]);
+  const float3 bbox_max = make_float3(knode->bbox_max[0], knode->bbox_max[1], knode->bbox_max[2]);
+  const float3 centroid = 0.5f * (bbox_min + bbox_max);
+  const float radius_sq = 0.25f * len_squared(bbox_max - bbox_min);
+
+  const float3 D = P - centroid;
+  const float distance_sq = len_squared(D);
+
+  /* Inside the bounds, light may arrive from any direction. Clamping the distance avoids that
+   * nodes close to the shading point get all the samples. */
+  if (distance_sq <= radius_sq) {
+    return knode->energy / radius_sq;
+  }
+
+  /* Smallest angle between the direction to the shading point and the emitter normals, taking
+   * into account all points in the bounds. Nothing is emitted towards the shading point when it
+   * exceeds the emission angle. */
+  const float3 axis = make_float3(knode->axis[0], knode->axis[1], knode->axis[2]);
+  const float distance = sqrtf(distance_sq);
+  const float theta = safe_acosf(dot(axis, D) / distance);
+  const float theta_u = safe_asinf(sqrtf(radius_sq) / distance);
+  const float theta_prime = max(theta - knode->theta_o - theta_u, 0.0f);
+  if (theta_prime >= knode->theta_e) {
+    return 0.0f;
+  }
+
+  return knode->energy * cosf(theta_prime) / distance_sq;
+}
+
+/* Probability of selecting the first child of an inner node, negative if neither child
+ * contributes to the shading point. */
+ccl_device_inline float light_tree_left_child_probability(
+    KernelGlobals kg, const float3 P, const int index, ccl_global const KernelLightTreeNode *knode)
+{
+  const float importance_left = light_tree_node_importance(
+      P, &kernel_tex_fetch(__light_tree_nodes, index + 1));
+  const float importance_right = light_tree_node_importance(
+      P, &kernel_tex_fetch(__light_tree_nodes, knode->right_child));
+  const float importance = importance_left + importance_right;
+  return (importance > 0.0f) ? importance_left / importance : -1.0f;
+}
+
+/* Select a leaf of the tree, returns -1 if no light contributes to the shading point. randu is
+ * rescaled so that it can be used again. */
+ccl_device int light_tree_sample_leaf(KernelGlobals kg,
+                                      const float3 P,
+                                      ccl_private float *randu)
+{
+  float u = *randu;
+  int index = 0;
+  ccl_global const KernelLightTreeNode *knode = &kernel_tex_fetch(__light_tree_nodes, 0);
+
+  while (knode->right_child != -1) {
+    const float prob_left = light_tree_left_child_probability(kg, P, index, knode);
+    if (prob_left < 0.0f) {
+      return -1;
+    }
+
+    if (u < prob_left) {
+      index = index + 1;
+      u = u / prob_left;
+    }
+    else {
+      index = knode->right_child;
+      u = (u - prob_left) / (1.0f - prob_left);
+    }
+    u = min(u, 1.0f - FLT_EPSILON);
+    knode = &kernel_tex_fetch(__light_tree_nodes, index);
+  }
+
+  if (light_tree_node_importance(P, knode) == 0.0f) {
+    return -1;
+  }
+
+  *randu = u;
+  return index;
+}
+
+/* Probability of selecting a leaf of the tree with light_tree_sample_leaf(). */
+ccl_device float light_tree_leaf_pdf(KernelGlobals kg, const float3 P, int index)
+{
+  ccl_global const KernelLightTreeNode *knode = &kernel_tex_fetch(__light_tree_nodes, index);
+  if (light_tree_node_importance(P, knode) == 0.0f) {
+    return 0.0f;
+  }
+
+  float pdf = 1.0f;
+  while (knode->parent != -1) {
+    const int parent = knode->parent;
+    ccl_global const KernelLightTreeNode *kparent = &kernel_tex_fetch(__light_tree_nodes, parent);
+    const float prob_left = light_tree_left_child_probability(kg, P, parent, kparent);
+    if (prob_left < 0.0f) {
+      return 0.0f;
+    }
+
+    pdf *= (index == parent + 1) ? prob_left : 1.0f - prob_left;
+    index = parent;
+    knode = kparent;
+  }
+
+  return pdf;
+}
+
+/* Probability of selecting a lamp from the shading point. */
+ccl_device float light_select_lamp_pdf(KernelGlobals kg, const int lamp, const float3 P)
+{
+  if (kernel_data.integrator.use_light_tree) {
+    const int leaf = kernel_tex_fetch(__light_tree_lamp_leaves, lamp);
+    if (leaf != -1) {
+      return kernel_data.integrator.light_tree_pdf * light_tree_leaf_pdf(kg, P, leaf);
+    }
+  }
+
+  /* Distant and background lights are always selected with the same probability. */
+  return kernel_data.integrator.pdf_lights;
+}
+
+/* Probability of selecting a triangle of an object from the shading point, divided by the area
+ * of the triangle. */
+ccl_device float light_select_triangle_pdf(KernelGlobals kg, const int object, const float3 P)
+{
+  if (kernel_data.integrator.use_light_tree) {
+    const int leaf = kernel_tex_fetch(__light_tree_object_leaves, object);
+    if (leaf == -1) {
+      return 0.0f;
+    }
+    const float area = kernel_tex_fetch(__light_tree_nodes, leaf).area;
+    return kernel_data.integrator.light_tree_pdf * light_tree_leaf_pdf(kg, P, leaf) / area;
+  }
+
+  return kernel_data.integrator.pdf_triangles;
+}
+
+CCL_NAMESPACE_END
@@ -109,48 +109,113 @@ CCL_NAMESPACE_BEGIN
 #    define __OSL__
 #  endif
 #  define __VOLUME_RECORD_ALL__
+#  define __PATH_GUIDING__
 #endif /* __KERNEL_CPU__ */
 
 #ifdef __KERNEL_GPU_RAYTRACING__
 #  undef __BAKING__
 #endif /* __KERNEL_GPU_RAYTRACING__ */
 
+/* Kernel Features
+ *
+ * Defined as macros rather than an enum, so that they can be used by the preprocessor for the
+ * scene-based selective features compilation below. */
+
+/* Shader nodes. */
+#define KERNEL_FEATURE_NODE_BSDF (1U << 0U)
+#define KERNEL_FEATURE_NODE_EMISSION (1U << 1U)
+#define KERNEL_FEATURE_NODE_VOLUME (1U << 2U)
+#define KERNEL_FEATURE_NODE_HAIR (1U << 3U)
+#define KERNEL_FEATURE_NODE_BUMP (1U << 4U)
+#define KERNEL_FEATURE_NODE_BUMP_STATE (1U << 5U)
+#define KERNEL_FEATURE_NODE_VORONOI_EXTRA (1U << 6U)
+#define KERNEL_FEATURE_NODE_RAYTRACE (1U << 7U)
+#define KERNEL_FEATURE_NODE_AOV (1U << 8U)
+#define KERNEL_FEATURE_NODE_LIGHT_PATH (1U << 9U)
+
+/* Use denoising kernels and output denoising passes. */
+#define KERNEL_FEATURE_DENOISING (1U << 10U)
+
+/* Use path tracing kernels. */
+#define KERNEL_FEATURE_PATH_TRACING (1U << 11U)
+
+/* BVH/sampling kernel features. */
+#define KERNEL_FEATURE_HAIR (1U << 12U)
+#define KERNEL_FEATURE_HAIR_THICK (1U << 13U)
+#define KERNEL_FEATURE_OBJECT_MOTION (1U << 14U)
+#define KERNEL_FEATURE_CAMERA_MOTION (1U << 15U)
+
+/* Denotes whether baking functionality is needed. */
+#define KERNEL_FEATURE_BAKING (1U << 16U)
+
+/* Use subsurface scattering materials. */
+#define KERNEL_FEATURE_SUBSURFACE (1U << 17U)
+
+/* Use volume materials. */
+#define KERNEL_FEATURE_VOLUME (1U << 18U)
+
+/* Use OpenSubdiv patch evaluation */
+#define KERNEL_FEATURE_PATCH_EVALUATION (1U << 19U)
+
+/* Use Transparent shadows */
+#define KERNEL_FEATURE_TRANSPARENT (1U << 20U)
+
+/* Use shadow catcher. */
+#define KERNEL_FEATURE_SHADOW_CATCHER (1U << 21U)
+
+/* Per-uber shader usage flags. */
+#define KERNEL_FEATURE_PRINCIPLED (1U << 22U)
+
+/* Light render passes. */
+#define KERNEL_FEATURE_LIGHT_PASSES (1U << 23U)
+
+/* Shadow render pass. */
+#define KERNEL_FEATURE_SHADOW_PASS (1U << 24U)
+
+/* AO. */
+#define KERNEL_FEATURE_AO_PASS (1U << 25U)
+#define KERNEL_FEATURE_AO_ADDITIVE (1U << 26U)
+#define KERNEL_FEATURE_AO (KERNEL_FEATURE_AO_PASS | KERNEL_FEATURE_AO_ADDITIVE)
+
+/* Point clouds. */
+#define KERNEL_FEATURE_POINTCLOUD (1U << 27U)
+
 /* Scene-based selective features compilation. */
 #ifdef __KERNEL_FEATURES__
-#  if !(__KERNEL_FEATURES & KERNEL_FEATURE_CAMERA_MOTION)
+#  if !(__KERNEL_FEATURES__ & KERNEL_FEATURE_CAMERA_MOTION)
 #    undef __CAMERA_MOTION__
 #  endif
-#  if !(__KERNEL_FEATURES & KERNEL_FEATURE_OBJECT_MOTION)
+#  if !(__KERNEL_FEATURES__ & KERNEL_FEATURE_OBJECT_MOTION)
 #    undef __OBJECT_MOTION__
 #  endif
-#  if !(__KERNEL_FEATURES & KERNEL_FEATURE_HAIR)
+#  if !(__KERNEL_FEATURES__ & KERNEL_FEATURE_HAIR)
 #    undef __HAIR__
 #  endif
-#  if !(__KERNEL_FEATURES & KERNEL_FEATURE_POINTCLOUD)
+#  if !(__KERNEL_FEATURES__ & KERNEL_FEATURE_POINTCLOUD)
 #    undef __POINTCLOUD__
 #  endif
-#  if !(__KERNEL_FEATURES & KERNEL_FEATURE_VOLUME)
+#  if !(__KERNEL_FEATURES__ & KERNEL_FEATURE_VOLUME)
 #    undef __VOLUME__
 #  endif
-#  if !(__KERNEL_FEATURES & KERNEL_FEATURE_SUBSURFACE)
+#  if !(__KERNEL_FEATURES__ & KERNEL_FEATURE_SUBSURFACE)
 #    undef __SUBSURFACE__
 #  endif
-#  if !(__KERNEL_FEATURES & KERNEL_FEATURE_BAKING)
+#  if !(__KERNEL_FEATURES__ & KERNEL_FEATURE_BAKING)
 #    undef __BAKING__
 #  endif
-#  if !(__KERNEL_FEATURES & KERNEL_FEATURE_PATCH_EVALUATION)
+#  if !(__KERNEL_FEATURES__ & KERNEL_FEATURE_PATCH_EVALUATION)
 #    undef __PATCH_EVAL__
 #  endif
-#  if !(__KERNEL_FEATURES & KERNEL_FEATURE_TRANSPARENT)
+#  if !(__KERNEL_FEATURES__ & KERNEL_FEATURE_TRANSPARENT)
 #    undef __TRANSPARENT_SHADOWS__
 #  endif
-#  if !(__KERNEL_FEATURES & KERNEL_FEATURE_SHADOW_CATCHER)
+#  if !(__KERNEL_FEATURES__ & KERNEL_FEATURE_SHADOW_CATCHER)
 #    undef __SHADOW_CATCHER__
 #  endif
-#  if !(__KERNEL_FEATURES & KERNEL_FEATURE_PRINCIPLED)
+#  if !(__KERNEL_FEATURES__ & KERNEL_FEATURE_PRINCIPLED)
 #    undef __PRINCIPLED__
 #  endif
-#  if !(__KERNEL_FEATURES & KERNEL_FEATURE_DENOISING)
+#  if !(__KERNEL_FEATURES__ & KERNEL_FEATURE_DENOISING)
 #    undef __DENOISING_FEATURES__
 #  endif
 #endif
@@ -906,12 +971,10 @@ typedef struct ShaderVolumePhases {
 
 /* Volume Stack */
 
-#ifdef __VOLUME__
 typedef struct VolumeStack {
   int object;
   int shader;
 } VolumeStack;
-#endif
 
 /* Struct to gather multiple nearby intersections. */
 typedef struct LocalIntersection {
@@ -1212,6 +1275,7 @@ typedef struct KernelIntegrator {
   int use_volumes;
   int volume_max_steps;
   float volume_step_rate;
+  int use_volume_empty_skip;
 
   int has_shadow_catcher;
   float scrambling_distance;
@@ -1222,6 +1286,13 @@ typedef struct KernelIntegrator {
   /* MIS debugging. */
   int direct_light_sampling_type;
 
+  /* light tree */
+  int use_light_tree;
+  /* Probability of selecting a light from the tree instead of a distant or background light. */
+  float light_tree_pdf;
+  /* Offset of the lamps in the light distribution. */
+  int light_tree_lamp_offset;
+
   /* padding */
   int pad1, pad2;
 } KernelIntegrator;
@@ -1412,6 +1483,31 @@ typedef struct KernelLightDistribution {
 } KernelLightDistribution;
 static_assert_align(KernelLightDistribution, 16);
 
+typedef struct KernelLightTreeNode {
+  /* Bounds and total energy of the emitters below the node. */
+  float bbox_min[3];
+  float energy;
+  float bbox_max[3];
+  /* Orientation cone: the normals of the emitters are within theta_o of the axis, and light is
+   * emitted up to theta_e away from the normals. */
+  float theta_o;
+  float axis[3];
+  float theta_e;
+
+  /* Parent of the node, -1 for the root. */
+  int parent;
+  /* Second child of an inner node, the first child directly follows its parent. -1 for leaves. */
+  int right_child;
+  /* Leaves: range of the emitter in the light distribution, a single lamp or all emissive
+   * triangles of an object, and their total area for mesh lights. */
+  int distribution_first;
+  int distribution_num;
+  float area;
+
+  int pad1, pad2, pad3;
+} KernelLightTreeNode;
+static_assert_align(KernelLightTreeNode, 16);
+
 typedef struct KernelParticle {
   int index;
   float age;
@@ -1474,6 +1570,67 @@ typedef struct KernelShaderEvalInput {
 } KernelShaderEvalInput;
 static_assert_align(KernelShaderEvalInput, 16);
 
+/* Path Guiding
+ *
+ * Distributions of the radiance arriving from each direction, in the cells of a regular grid
+ * over the scene. They are learned from the paths of the first samples, and are only used by
+ * the CPU kernels. See kernel/integrator/guiding.h. */
+
+#ifdef __PATH_GUIDING__
+/* Resolution of the directional distribution of a cell, along the cosine of the polar angle and
+ * along the azimuth, so that all bins cover the same solid angle. */
+#  define GUIDING_DIRECTION_RES 8
+#  define GUIDING_NUM_BINS (GUIDING_DIRECTION_RES * GUIDING_DIRECTION_RES)
+/* Maximum number of scattering events of a path recorded for training. */
+#  define GUIDING_MAX_SEGMENTS 64
+
+typedef struct KernelGuidingField {
+  float3 bounds_min;
+  float3 inv_cell_size;
+  int resolution[3];
+
+  /* Probability of sampling a direction from the field at a guided surface. */
+  float surface_probability;
+
+  /* Cumulative distribution of the bins of every cell, all zero for cells without enough
+   * training data. */
+  const float *cdf;
+} KernelGuidingField;
+
+/* Scattering event of the path being traced. */
+typedef struct GuidingSegment {
+  float3 P;
+  float3 D;
+  /* Path throughput after scattering, contributions of the rest of the path are divided by it to
+   * get the radiance arriving from D. */
+  float3 throughput;
+  float3 radiance;
+  /* Probability density with which D was sampled. */
+  float pdf;
+} GuidingSegment;
+
+/* Training sample: radiance arriving at P from D, divided by the sampling density. */
+typedef struct GuidingSample {
+  float3 P;
+  float3 D;
+  float value;
+} GuidingSample;
+
+/* Training data recorded by one thread. Samples are kept with reservoir sampling once the
+ * storage is full. */
+typedef struct KernelGuidingThreadData {
+  GuidingSegment segments[GUIDING_MAX_SEGMENTS];
+  int num_segments;
+  /* Number of segments before the vertex which sent the light shadow ray being traced. */
+  int num_segments_direct_light;
+
+  GuidingSample *samples;
+  int num_samples;
+  int max_samples;
+  uint64_t num_recorded;
+} KernelGuidingThreadData;
+#endif /* __PATH_GUIDING__ */
+
 /* Pre-computed sample table sizes for PMJ02 sampler. */
 #define NUM_PMJ_DIVISIONS 32
 #define NUM_PMJ_SAMPLES ((NUM_PMJ_DIVISIONS) * (NUM_PMJ_DIVISIONS))
@@ -1558,69 +1715,6 @@ enum {
   DEVICE_KERNEL_INTEGRATOR_NUM = DEVICE_KERNEL_INTEGRATOR_MEGAKERNEL + 1,
 };
 
-/* Kernel Features */
-
-enum KernelFeatureFlag : uint32_t {
-  /* Shader nodes. */
-  KERNEL_FEATURE_NODE_BSDF = (1U << 0U),
-  KERNEL_FEATURE_NODE_EMISSION = (1U << 1U),
-  KERNEL_FEATURE_NODE_VOLUME = (1U << 2U),
-  KERNEL_FEATURE_NODE_HAIR = (1U << 3U),
-  KERNEL_FEATURE_NODE_BUMP = (1U << 4U),
-  KERNEL_FEATURE_NODE_BUMP_STATE = (1U << 5U),
-  KERNEL_FEATURE_NODE_VORONOI_EXTRA = (1U << 6U),
-  KERNEL_FEATURE_NODE_RAYTRACE = (1U << 7U),
-  KERNEL_FEATURE_NODE_AOV = (1U << 8U),
-  KERNEL_FEATURE_NODE_LIGHT_PATH = (1U << 9U),
-
-  /* Use denoising kernels and output denoising passes. */
-  KERNEL_FEATURE_DENOISING = (1U << 10U),
-
-  /* Use path tracing kernels. */
-  KERNEL_FEATURE_PATH_TRACING = (1U << 11U),
-
-  /* BVH/sampling kernel features. */
-  KERNEL_FEATURE_HAIR = (1U << 12U),
-  KERNEL_FEATURE_HAIR_THICK = (1U << 13U),
-  KERNEL_FEATURE_OBJECT_MOTION = (1U << 14U),
-  KERNEL_FEATURE_CAMERA_MOTION = (1U << 15U),
-
-  /* Denotes whether baking functionality is needed. */
-  KERNEL_FEATURE_BAKING = (1U << 16U),
-
-  /* Use subsurface scattering materials. */
-  KERNEL_FEATURE_SUBSURFACE = (1U << 17U),
-
-  /* Use volume materials. */
-  KERNEL_FEATURE_VOLUME = (1U << 18U),
-
-  /* Use OpenSubdiv patch evaluation */
-  KERNEL_FEATURE_PATCH_EVALUATION = (1U << 19U),
-
-  /* Use Transparent shadows */
-  KERNEL_FEATURE_TRANSPARENT = (1U << 20U),
-
-  /* Use shadow catcher. */
-  KERNEL_FEATURE_SHADOW_CATCHER = (1U << 21U),
-
-  /* Per-uber shader usage flags. */
-  KERNEL_FEATURE_PRINCIPLED = (1U << 22U),
-
-  /* Light render passes. */
-  KERNEL_FEATURE_LIGHT_PASSES = (1U << 23U),
-
-  /* Shadow render pass. */
-  KERNEL_FEATURE_SHADOW_PASS = (1U << 24U),
-
-  /* AO. */
-  KERNEL_FEATURE_AO_PASS = (1U << 25U),
-  KERNEL_FEATURE_AO_ADDITIVE = (1U << 26U),
-  KERNEL_FEATURE_AO = (KERNEL_FEATURE_AO_PASS | KERNEL_FEATURE_AO_ADDITIVE),
-
-  /* Point clouds. */
-  KERNEL_FEATURE_POINTCLOUD = (1U << 27U),
-};
-
 /* Shader node feature mask, to specialize shader evaluation for kernels. */
 
 #define KERNEL_FEATURE_NODE_MASK_SURFACE_LIGHT \
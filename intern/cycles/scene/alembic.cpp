@@ -28,6 +28,7 @@
 #include "util/foreach.h"
 #include "util/log.h"
 #include "util/progress.h"
+#include "util/task.h"
 #include "util/transform.h"
 #include "util/vector.h"
 
@@ -754,6 +755,7 @@ NODE_DEFINE(AlembicProcedural)
 
   SOCKET_BOOLEAN(use_prefetch, "Use Prefetch", true);
   SOCKET_INT(prefetch_cache_size, "Prefetch Cache Size", 4096);
+  SOCKET_INT(prefetch_frame_window, "Prefetch Frame Window", 0);
 
   return type;
 }
@@ -762,6 +764,8 @@ AlembicProcedural::AlembicProcedural() : Procedural(get_node_type())
 {
   objects_loaded = false;
   scene_ = nullptr;
+  cache_start_frame = 0.0f;
+  cache_end_frame = -1.0f;
 }
 
 AlembicProcedural::~AlembicProcedural()
@@ -842,6 +846,8 @@ void AlembicProcedural::generate(Scene *scene, Progress &progress)
   if (!archive.valid()) {
     Alembic::AbcCoreFactory::IFactory factory;
     factory.setPolicy(Alembic::Abc::ErrorHandler::kQuietNoopPolicy);
+    /* Allow objects to be read from multiple threads at once. */
+    factory.setOgawaNumStreams(TaskScheduler::num_threads());
     archive = factory.getArchive(filepath.c_str());
 
     if (!archive.valid()) {
@@ -872,12 +878,12 @@ void AlembicProcedural::generate(Scene *scene, Progress &progress)
     }
   }
 
-  if (use_prefetch_is_modified()) {
-    if (!use_prefetch) {
-      for (Node *node : objects) {
-        AlembicObject *object = static_cast<AlembicObject *>(node);
-        object->clear_cache();
-      }
+  /* Load the caches again if the current frame is not in them anymore. */
+  const bool need_cache_reload = update_cache_frame_range();
+  if (need_cache_reload) {
+    for (Node *node : objects) {
+      AlembicObject *object = static_cast<AlembicObject *>(node);
+      object->clear_cache();
     }
   }
 
@@ -907,7 +913,7 @@ void AlembicProcedural::generate(Scene *scene, Progress &progress)
 
     /* skip constant objects */
     if (object->is_constant() && !object->is_modified() && !object->need_shader_update &&
-        !scale_is_modified()) {
+        !scale_is_modified() && !need_cache_reload) {
       continue;
     }
 
@@ -1432,8 +1438,110 @@ void AlembicProcedural::walk_hierarchy(
   }
 }
 
+bool AlembicProcedural::update_cache_frame_range()
+{
+  float start;
+  float end;
+
+  if (!use_prefetch) {
+    start = frame;
+    end = frame;
+  }
+  else if (prefetch_frame_window <= 0) {
+    start = start_frame;
+    end = end_frame;
+  }
+  else {
+    /* Keep the current window as long as the frame is in it. */
+    if (frame >= cache_start_frame && frame <= cache_end_frame && !start_frame_is_modified() &&
+        !end_frame_is_modified() && !prefetch_frame_window_is_modified() &&
+        !use_prefetch_is_modified()) {
+      return false;
+    }
+
+    start = frame;
+    end = min(frame + static_cast<float>(prefetch_frame_window - 1), end_frame);
+  }
+
+  if (start == cache_start_frame && end == cache_end_frame) {
+    return false;
+  }
+
+  VLOG(1) << "AlembicProcedural loading frames " << start << " to " << end;
+
+  cache_start_frame = start;
+  cache_end_frame = end;
+  return true;
+}
+
+void AlembicProcedural::load_object_cache(AlembicObject *object, Progress &progress)
+{
+  if (progress.get_cancel()) {
+    return;
+  }
+
+  if (object->schema_type == AlembicObject::POLY_MESH) {
+    if (!object->has_data_loaded()) {
+      IPolyMesh polymesh(object->iobject, Alembic::Abc::kWrapExisting);
+      IPolyMeshSchema schema = polymesh.getSchema();
+      object->load_data_in_cache(object->get_cached_data(), this, schema, progress);
+    }
+    else if (object->need_shader_update) {
+      IPolyMesh polymesh(object->iobject, Alembic::Abc::kWrapExisting);
+      IPolyMeshSchema schema = polymesh.getSchema();
+      read_attributes(this,
+                      object->get_cached_data(),
+                      schema,
+                      schema.getUVsParam(),
+                      object->get_requested_attributes(),
+                      progress);
+    }
+  }
+  else if (object->schema_type == AlembicObject::CURVES) {
+    if (!object->has_data_loaded() || default_radius_is_modified() ||
+        object->radius_scale_is_modified()) {
+      ICurves curves(object->iobject, Alembic::Abc::kWrapExisting);
+      ICurvesSchema schema = curves.getSchema();
+      object->load_data_in_cache(object->get_cached_data(), this, schema, progress);
+    }
+  }
+  else if (object->schema_type == AlembicObject::POINTS) {
+    if (!object->has_data_loaded() || default_radius_is_modified() ||
+        object->radius_scale_is_modified()) {
+      IPoints points(object->iobject, Alembic::Abc::kWrapExisting);
+      IPointsSchema schema = points.getSchema();
+      object->load_data_in_cache(object->get_cached_data(), this, schema, progress);
+    }
+  }
+  else if (object->schema_type == AlembicObject::SUBD) {
+    if (!object->has_data_loaded()) {
+      ISubD subd_mesh(object->iobject, Alembic::Abc::kWrapExisting);
+      ISubDSchema schema = subd_mesh.getSchema();
+      object->load_data_in_cache(object->get_cached_data(), this, schema, progress);
+    }
+    else if (object->need_shader_update) {
+      ISubD subd_mesh(object->iobject, Alembic::Abc::kWrapExisting);
+      ISubDSchema schema = subd_mesh.getSchema();
+      read_attributes(this,
+                      object->get_cached_data(),
+                      schema,
+                      schema.getUVsParam(),
+                      object->get_requested_attributes(),
+                      progress);
+    }
+  }
+}
+
 void AlembicProcedural::build_caches(Progress &progress)
 {
+  /* Objects are read independently of each other, so load their data in parallel. */
+  TaskPool pool;
+  for (Node *node : objects) {
+    AlembicObject *object = static_cast<AlembicObject *>(node);
+    pool.push([this, object, &progress]() { load_object_cache(object, progress); });
+  }
+  pool.wait_work();
+
   size_t memory_used = 0;
 
   for (Node *node : objects) {
@@ -1443,57 +1551,6 @@ void AlembicProcedural::build_caches(Progress &progress)
       return;
     }
 
-    if (object->schema_type == AlembicObject::POLY_MESH) {
-      if (!object->has_data_loaded()) {
-        IPolyMesh polymesh(object->iobject, Alembic::Abc::kWrapExisting);
-        IPolyMeshSchema schema = polymesh.getSchema();
-        object->load_data_in_cache(object->get_cached_data(), this, schema, progress);
-      }
-      else if (object->need_shader_update) {
-        IPolyMesh polymesh(object->iobject, Alembic::Abc::kWrapExisting);
-        IPolyMeshSchema schema = polymesh.getSchema();
-        read_attributes(this,
-                        object->get_cached_data(),
-                        schema,
-                        schema.getUVsParam(),
-                        object->get_requested_attributes(),
-                        progress);
-      }
-    }
-    else if (object->schema_type == AlembicObject::CURVES) {
-      if (!object->has_data_loaded() || default_radius_is_modified() ||
-          object->radius_scale_is_modified()) {
-        ICurves curves(object->iobject, Alembic::Abc::kWrapExisting);
-        ICurvesSchema schema = curves.getSchema();
-        object->load_data_in_cache(object->get_cached_data(), this, schema, progress);
-      }
-    }
-    else if (object->schema_type == AlembicObject::POINTS) {
-      if (!object->has_data_loaded() || default_radius_is_modified() ||
-          object->radius_scale_is_modified()) {
-        IPoints points(object->iobject, Alembic::Abc::kWrapExisting);
-        IPointsSchema schema = points.getSchema();
-        object->load_data_in_cache(object->get_cached_data(), this, schema, progress);
-      }
-    }
-    else if (object->schema_type == AlembicObject::SUBD) {
-      if (!object->has_data_loaded()) {
-        ISubD subd_mesh(object->iobject, Alembic::Abc::kWrapExisting);
-        ISubDSchema schema = subd_mesh.getSchema();
-        object->load_data_in_cache(object->get_cached_data(), this, schema, progress);
-      }
-      else if (object->need_shader_update) {
-        ISubD subd_mesh(object->iobject, Alembic::Abc::kWrapExisting);
-        ISubDSchema schema = subd_mesh.getSchema();
-        read_attributes(this,
-                        object->get_cached_data(),
-                        schema,
-                        schema.getUVsParam(),
-                        object->get_requested_attributes(),
-                        progress);
-      }
-    }
-
     if (scale_is_modified() || object->get_cached_data().transforms.size() == 0) {
       object->setup_transform_cache(object->get_cached_data(), scale);
     }
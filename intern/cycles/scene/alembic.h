@@ -19,6 +19,7 @@
 #include "graph/node.h"
 #include "scene/attribute.h"
 #include "scene/procedural.h"
+#include "util/algorithm.h"
 #include "util/set.h"
 #include "util/transform.h"
 #include "util/vector.h"
@@ -288,11 +289,25 @@ template<typename T> class DataStore {
   }
 
  private:
+  /* The entries are sorted by time, but may only cover a part of the animation when the data is
+   * streamed, so look up the entry closest in time rather than using the sample index. */
   const TimeIndexPair &get_index_for_time(double time) const
   {
-    std::pair<size_t, Alembic::Abc::chrono_t> index_pair;
-    index_pair = time_sampling.getNearIndex(time, index_data_map.size());
-    return index_data_map[index_pair.first];
+    auto it = std::lower_bound(
+        index_data_map.begin(),
+        index_data_map.end(),
+        time,
+        [](const TimeIndexPair &pair, double value) { return pair.time < value; });
+
+    if (it == index_data_map.end()) {
+      return index_data_map.back();
+    }
+
+    if (it != index_data_map.begin() && (time - (it - 1)->time) <= (it->time - time)) {
+      --it;
+    }
+
+    return *it;
   }
 };
 
@@ -445,6 +460,7 @@ class AlembicObject : public Node {
 
   void clear_cache()
   {
+    data_loaded = false;
     cached_data_.clear();
   }
 
@@ -467,12 +483,19 @@ class AlembicObject : public Node {
  * This procedural will load the data set for the entire animation in memory on the first frame,
  * and directly set the data for the new frames on the created Nodes if needed. This allows for
  * faster updates between frames as it avoids reseeking the data on disk.
+ *
+ * To limit memory usage for long animations, the data can instead be streamed through a window of
+ * frames starting at the current frame, which is loaded again once the frame leaves it.
  */
 class AlembicProcedural : public Procedural {
   Alembic::AbcGeom::IArchive archive;
   bool objects_loaded;
   Scene *scene_;
 
+  /* Range of frames for which data is loaded in the caches. */
+  float cache_start_frame;
+  float cache_end_frame;
+
  public:
   NODE_DECLARE
 
@@ -512,6 +535,10 @@ class AlembicProcedural : public Procedural {
    */
   NODE_SOCKET_API(int, prefetch_cache_size)
 
+  /* Number of frames loaded at once when prefetching, starting at the current frame. If zero, the
+   * data for all frames between the start and end frame is loaded. */
+  NODE_SOCKET_API(int, prefetch_frame_window)
+
   AlembicProcedural();
   ~AlembicProcedural();
 
@@ -532,6 +559,17 @@ class AlembicProcedural : public Procedural {
    * Returns a pointer to an existing or a newly created AlembicObject for the given path. */
   AlembicObject *get_or_create_object(const ustring &path);
 
+  /* First and last frame to load data for in the caches. */
+  float get_cache_start_frame() const
+  {
+    return cache_start_frame;
+  }
+
+  float get_cache_end_frame() const
+  {
+    return cache_end_frame;
+  }
+
  private:
   /* Add an object to our list of objects, and tag the socket as modified. */
   void add_object(AlembicObject *object);
@@ -564,6 +602,14 @@ class AlembicProcedural : public Procedural {
    * Object Nodes in the Cycles scene if none exist yet. */
   void read_subd(AlembicObject *abc_object, Alembic::AbcGeom::Abc::chrono_t frame_time);
 
+  /* Compute the range of frames to load data for, returns true if it changed and the caches need
+   * to be loaded again. */
+  bool update_cache_frame_range();
+
+  /* Load the data of the object in its cache if needed, this may be called from multiple threads
+   * for different objects. */
+  void load_object_cache(AlembicObject *object, Progress &progress);
+
   void build_caches(Progress &progress);
 
   size_t get_prefetch_cache_size_in_bytes() const
@@ -44,19 +44,10 @@ static set<chrono_t> get_relevant_sample_times(AlembicProcedural *proc,
     return result;
   }
 
-  double start_frame;
-  double end_frame;
-
-  if (proc->get_use_prefetch()) {
-    // load the data for the entire animation
-    start_frame = static_cast<double>(proc->get_start_frame());
-    end_frame = static_cast<double>(proc->get_end_frame());
-  }
-  else {
-    // load the data for the current frame
-    start_frame = static_cast<double>(proc->get_frame());
-    end_frame = start_frame;
-  }
+  /* Load the data for the current frame, the entire animation, or the window of frames being
+   * streamed, see AlembicProcedural::update_cache_frame_range. */
+  const double start_frame = static_cast<double>(proc->get_cache_start_frame());
+  const double end_frame = static_cast<double>(proc->get_cache_end_frame());
 
   const double frame_rate = static_cast<double>(proc->get_frame_rate());
   const double start_time = start_frame / frame_rate;
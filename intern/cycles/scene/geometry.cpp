@@ -548,6 +548,27 @@ void GeometryManager::update_svm_attributes(Device *,
   dscene->attributes_map.copy_to_device();
 }
 
+/* Range of elements of a device array that were packed again, so that only those have to be
+ * copied to the device. */
+struct DeviceUpdateRange {
+  size_t begin = SIZE_MAX;
+  size_t end = 0;
+
+  void add(size_t offset, size_t size)
+  {
+    if (size == 0) {
+      return;
+    }
+    begin = std::min(begin, offset);
+    end = std::max(end, offset + size);
+  }
+
+  template<typename T> void copy_to_device(device_vector<T> &array) const
+  {
+    array.copy_to_device_if_modified((end > begin) ? end - begin : 0, (end > begin) ? begin : 0);
+  }
+};
+
 static void update_attribute_element_size(Geometry *geom,
                                           Attribute *mattr,
                                           AttributePrimitive prim,
@@ -880,6 +901,29 @@ void GeometryManager::device_update_attributes(Device *device,
   size_t attr_float4_offset = 0;
   size_t attr_uchar4_offset = 0;
 
+  /* Ranges of the arrays that attributes were copied to, in the order of AttrKernelDataType. */
+  DeviceUpdateRange attributes_range[AttrKernelDataType::NUM];
+  size_t *attributes_offset[AttrKernelDataType::NUM] = {&attr_float_offset,
+                                                       &attr_float2_offset,
+                                                       &attr_float3_offset,
+                                                       &attr_float4_offset,
+                                                       &attr_uchar4_offset};
+  size_t attributes_prev_offset[AttrKernelDataType::NUM];
+
+  auto begin_attribute_update = [&]() {
+    for (int i = 0; i < AttrKernelDataType::NUM; i++) {
+      attributes_prev_offset[i] = *attributes_offset[i];
+    }
+  };
+  auto end_attribute_update = [&](const Attribute *attr) {
+    if (attr && attr->modified) {
+      for (int i = 0; i < AttrKernelDataType::NUM; i++) {
+        attributes_range[i].add(attributes_prev_offset[i],
+                                *attributes_offset[i] - attributes_prev_offset[i]);
+      }
+    }
+  };
+
   /* Fill in attributes. */
   for (size_t i = 0; i < scene->geometry.size(); i++) {
     Geometry *geom = scene->geometry[i];
@@ -895,6 +939,7 @@ void GeometryManager::device_update_attributes(Device *device,
         attr->modified |= attributes_need_realloc[Attribute::kernel_type(*attr)];
       }
 
+      begin_attribute_update();
       update_attribute_element_offset(geom,
                                       dscene->attributes_float,
                                       attr_float_offset,
@@ -910,6 +955,7 @@ void GeometryManager::device_update_attributes(Device *device,
                                       ATTR_PRIM_GEOMETRY,
                                       req.type,
                                       req.desc);
+      end_attribute_update(attr);
 
       if (geom->is_mesh()) {
         Mesh *mesh = static_cast<Mesh *>(geom);
@@ -920,6 +966,7 @@ void GeometryManager::device_update_attributes(Device *device,
           subd_attr->modified |= attributes_need_realloc[Attribute::kernel_type(*subd_attr)];
         }
 
+        begin_attribute_update();
         update_attribute_element_offset(mesh,
                                         dscene->attributes_float,
                                         attr_float_offset,
@@ -935,6 +982,7 @@ void GeometryManager::device_update_attributes(Device *device,
                                         ATTR_PRIM_SUBD,
                                         req.subd_type,
                                         req.subd_desc);
+        end_attribute_update(subd_attr);
       }
 
       if (progress.get_cancel())
@@ -954,6 +1002,7 @@ void GeometryManager::device_update_attributes(Device *device,
         attr->modified |= attributes_need_realloc[Attribute::kernel_type(*attr)];
       }
 
+      begin_attribute_update();
       update_attribute_element_offset(object->geometry,
                                       dscene->attributes_float,
                                       attr_float_offset,
@@ -969,6 +1018,7 @@ void GeometryManager::device_update_attributes(Device *device,
                                       ATTR_PRIM_GEOMETRY,
                                       req.type,
                                       req.desc);
+      end_attribute_update(attr);
 
       /* object attributes don't care about subdivision */
       req.subd_type = req.type;
@@ -991,11 +1041,12 @@ void GeometryManager::device_update_attributes(Device *device,
   /* copy to device */
   progress.set_status("Updating Mesh", "Copying Attributes to device");
 
-  dscene->attributes_float.copy_to_device_if_modified();
-  dscene->attributes_float2.copy_to_device_if_modified();
-  dscene->attributes_float3.copy_to_device_if_modified();
-  dscene->attributes_float4.copy_to_device_if_modified();
-  dscene->attributes_uchar4.copy_to_device_if_modified();
+  /* Only the modified attributes are copied, unless the arrays were reallocated. */
+  attributes_range[AttrKernelDataType::FLOAT].copy_to_device(dscene->attributes_float);
+  attributes_range[AttrKernelDataType::FLOAT2].copy_to_device(dscene->attributes_float2);
+  attributes_range[AttrKernelDataType::FLOAT3].copy_to_device(dscene->attributes_float3);
+  attributes_range[AttrKernelDataType::FLOAT4].copy_to_device(dscene->attributes_float4);
+  attributes_range[AttrKernelDataType::UCHAR4].copy_to_device(dscene->attributes_uchar4);
 
   if (progress.get_cancel())
     return;
@@ -1144,23 +1195,30 @@ void GeometryManager::device_update_mesh(Device *,
     uint *tri_patch = dscene->tri_patch.alloc(tri_size);
     float2 *tri_patch_uv = dscene->tri_patch_uv.alloc(vert_size);
 
-    const bool copy_all_data = dscene->tri_shader.need_realloc() ||
+    const bool copy_all_data = dscene->tri_verts.need_realloc() ||
+                               dscene->tri_shader.need_realloc() ||
                                dscene->tri_vindex.need_realloc() ||
                                dscene->tri_vnormal.need_realloc() ||
                                dscene->tri_patch.need_realloc() ||
                                dscene->tri_patch_uv.need_realloc();
 
+    DeviceUpdateRange tri_verts_range, shader_range, normal_range, tri_range, vert_range;
+
     foreach (Geometry *geom, scene->geometry) {
       if (geom->geometry_type == Geometry::MESH || geom->geometry_type == Geometry::VOLUME) {
         Mesh *mesh = static_cast<Mesh *>(geom);
+        const size_t num_triangles = mesh->num_triangles();
+        const size_t num_verts = mesh->get_verts().size();
 
         if (mesh->shader_is_modified() || mesh->smooth_is_modified() ||
             mesh->triangles_is_modified() || copy_all_data) {
           mesh->pack_shaders(scene, &tri_shader[mesh->prim_offset]);
+          shader_range.add(mesh->prim_offset, num_triangles);
         }
 
         if (mesh->verts_is_modified() || copy_all_data) {
           mesh->pack_normals(&vnormal[mesh->vert_offset]);
+          normal_range.add(mesh->vert_offset, num_verts);
         }
 
         if (mesh->verts_is_modified() || mesh->triangles_is_modified() ||
@@ -1169,6 +1227,9 @@ void GeometryManager::device_update_mesh(Device *,
                            &tri_vindex[mesh->prim_offset],
                            &tri_patch[mesh->prim_offset],
                            &tri_patch_uv[mesh->vert_offset]);
+          tri_verts_range.add(mesh->prim_offset * 3, num_triangles * 3);
+          tri_range.add(mesh->prim_offset, num_triangles);
+          vert_range.add(mesh->vert_offset, num_verts);
         }
 
         if (progress.get_cancel())
@@ -1179,12 +1240,14 @@ void GeometryManager::device_update_mesh(Device *,
     /* vertex coordinates */
     progress.set_status("Updating Mesh", "Copying Mesh to device");
 
-    dscene->tri_verts.copy_to_device_if_modified();
-    dscene->tri_shader.copy_to_device_if_modified();
-    dscene->tri_vnormal.copy_to_device_if_modified();
-    dscene->tri_vindex.copy_to_device_if_modified();
-    dscene->tri_patch.copy_to_device_if_modified();
-    dscene->tri_patch_uv.copy_to_device_if_modified();
+    /* Only the data of the meshes that were packed again has to be copied, arrays that were
+     * reallocated are copied entirely. */
+    tri_verts_range.copy_to_device(dscene->tri_verts);
+    shader_range.copy_to_device(dscene->tri_shader);
+    normal_range.copy_to_device(dscene->tri_vnormal);
+    tri_range.copy_to_device(dscene->tri_vindex);
+    tri_range.copy_to_device(dscene->tri_patch);
+    vert_range.copy_to_device(dscene->tri_patch_uv);
   }
 
   if (curve_segment_size != 0) {
@@ -1198,6 +1261,8 @@ void GeometryManager::device_update_mesh(Device *,
                                dscene->curves.need_realloc() ||
                                dscene->curve_segments.need_realloc();
 
+    DeviceUpdateRange key_range, curve_range, segment_range;
+
     foreach (Geometry *geom, scene->geometry) {
       if (geom->is_hair()) {
         Hair *hair = static_cast<Hair *>(geom);
@@ -1215,14 +1280,17 @@ void GeometryManager::device_update_mesh(Device *,
                           &curve_keys[hair->curve_key_offset],
                           &curves[hair->prim_offset],
                           &curve_segments[hair->curve_segment_offset]);
+        key_range.add(hair->curve_key_offset, hair->get_curve_keys().size());
+        curve_range.add(hair->prim_offset, hair->num_curves());
+        segment_range.add(hair->curve_segment_offset, hair->num_segments());
         if (progress.get_cancel())
           return;
       }
     }
 
-    dscene->curve_keys.copy_to_device_if_modified();
-    dscene->curves.copy_to_device_if_modified();
-    dscene->curve_segments.copy_to_device_if_modified();
+    key_range.copy_to_device(dscene->curve_keys);
+    curve_range.copy_to_device(dscene->curves);
+    segment_range.copy_to_device(dscene->curve_segments);
   }
 
   if (point_size != 0) {
@@ -1294,7 +1362,10 @@ void GeometryManager::device_update_bvh(Device *device,
 
   const bool can_refit = scene->bvh != nullptr &&
                          (bparams.bvh_layout == BVHLayout::BVH_LAYOUT_OPTIX ||
-                          bparams.bvh_layout == BVHLayout::BVH_LAYOUT_METAL);
+                          bparams.bvh_layout == BVHLayout::BVH_LAYOUT_METAL ||
+                          (bparams.bvh_layout == BVHLayout::BVH_LAYOUT_BVH2 &&
+                           static_cast<BVH2 *>(scene->bvh)->top_level_can_refit(scene->geometry,
+                                                                                scene->objects)));
 
   BVH *bvh = scene->bvh;
   if (!scene->bvh) {
@@ -2018,6 +2089,27 @@ void GeometryManager::device_update(Device *device,
    * change. */
   bool need_update_scene_bvh = (scene->bvh == nullptr ||
                                 (update_flags & (TRANSFORM_MODIFIED | VISIBILITY_MODIFIED)) != 0);
+
+  /* The top level BVH2 contains the primitives of geometry that is not instanced, it can only be
+   * refitted when that geometry keeps its topology and offsets, and when the set of traceable
+   * objects did not change. */
+  if (bvh_layout == BVH_LAYOUT_BVH2 && scene->bvh) {
+    bool need_rebuild_scene_bvh = (update_flags & VISIBILITY_MODIFIED) != 0;
+    foreach (Geometry *geom, scene->geometry) {
+      if ((geom->is_modified() || geom->need_update_bvh_for_offset) &&
+          (geom->need_update_rebuild || geom->need_update_bvh_for_offset) &&
+          !geom->need_build_bvh(bvh_layout)) {
+        need_rebuild_scene_bvh = true;
+        break;
+      }
+    }
+    if (need_rebuild_scene_bvh) {
+      delete scene->bvh;
+      scene->bvh = nullptr;
+      need_update_scene_bvh = true;
+    }
+  }
+
   {
     scoped_callback_timer timer([scene](double time) {
       if (scene->update_stats) {
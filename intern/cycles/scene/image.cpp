@@ -219,7 +219,8 @@ ImageMetaData::ImageMetaData()
       colorspace(u_colorspace_raw),
       colorspace_file_format(""),
       use_transform_3d(false),
-      compress_as_srgb(false)
+      compress_as_srgb(false),
+      miplevel(0)
 {
 }
 
@@ -228,7 +229,8 @@ bool ImageMetaData::operator==(const ImageMetaData &other) const
   return channels == other.channels && width == other.width && height == other.height &&
          depth == other.depth && use_transform_3d == other.use_transform_3d &&
          (!use_transform_3d || transform_3d == other.transform_3d) && type == other.type &&
-         colorspace == other.colorspace && compress_as_srgb == other.compress_as_srgb;
+         colorspace == other.colorspace && compress_as_srgb == other.compress_as_srgb &&
+         miplevel == other.miplevel;
 }
 
 bool ImageMetaData::is_float() const
@@ -274,6 +276,11 @@ ImageLoader::ImageLoader()
 {
 }
 
+bool ImageLoader::load_metadata_mip_level(ImageMetaData & /*metadata*/, const size_t /*max_size*/)
+{
+  return false;
+}
+
 ustring ImageLoader::osl_filepath() const
 {
   return ustring();
@@ -498,11 +505,21 @@ bool ImageManager::file_load_image(Image *img, int texture_limit)
     return false;
   }
 
-  /* Get metadata. */
-  int width = img->metadata.width;
-  int height = img->metadata.height;
-  int depth = img->metadata.depth;
-  int components = img->metadata.channels;
+  /* Get metadata. When the image is too big, prefer reading a smaller mipmap level from the file
+   * over reading the full resolution and scaling it down. */
+  ImageMetaData metadata = img->metadata;
+  const size_t full_size = max(max(metadata.width, metadata.height), metadata.depth);
+  if (texture_limit > 0 && full_size > texture_limit) {
+    if (img->loader->load_metadata_mip_level(metadata, texture_limit)) {
+      VLOG(1) << "Loading mipmap level " << metadata.miplevel << " of image "
+              << img->loader->name() << ".";
+    }
+  }
+
+  int width = metadata.width;
+  int height = metadata.height;
+  int depth = metadata.depth;
+  int components = metadata.channels;
 
   /* Read pixels. */
   vector<StorageType> pixels_storage;
@@ -529,8 +546,7 @@ bool ImageManager::file_load_image(Image *img, int texture_limit)
   }
 
   const size_t num_pixels = ((size_t)width) * height * depth;
-  img->loader->load_pixels(
-      img->metadata, pixels, num_pixels * components, image_associate_alpha(img));
+  img->loader->load_pixels(metadata, pixels, num_pixels * components, image_associate_alpha(img));
 
   /* The kernel can handle 1 and 4 channel images. Anything that is not a single
    * channel image is converted to RGBA format. */
@@ -91,6 +91,10 @@ class ImageMetaData {
   /* Automatically set. */
   bool compress_as_srgb;
 
+  /* Level of detail of the file to load the pixels from, the size is the size of that level.
+   * Set by ImageLoader.load_metadata_mip_level(). */
+  int miplevel;
+
   ImageMetaData();
   bool operator==(const ImageMetaData &other) const;
   bool is_float() const;
@@ -119,6 +123,11 @@ class ImageLoader {
                            const size_t pixels_size,
                            const bool associate_alpha) = 0;
 
+  /* Optional: change the metadata to load a smaller mipmap level stored in the file, the
+   * largest one that is no bigger than max_size in any dimension. Returns false when there is no
+   * such level, in which case the metadata is unchanged. */
+  virtual bool load_metadata_mip_level(ImageMetaData &metadata, const size_t max_size);
+
   /* Name for logs and stats. */
   virtual string name() const = 0;
 
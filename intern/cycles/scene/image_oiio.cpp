@@ -193,6 +193,10 @@ bool OIIOImageLoader::load_pixels(const ImageMetaData &metadata,
     return false;
   }
 
+  if (metadata.miplevel > 0 && !in->seek_subimage(0, metadata.miplevel)) {
+    return false;
+  }
+
   switch (metadata.type) {
     case IMAGE_DATA_TYPE_BYTE:
     case IMAGE_DATA_TYPE_BYTE4:
@@ -220,6 +224,40 @@ bool OIIOImageLoader::load_pixels(const ImageMetaData &metadata,
   return true;
 }
 
+bool OIIOImageLoader::load_metadata_mip_level(ImageMetaData &metadata, const size_t max_size)
+{
+  unique_ptr<ImageInput> in(ImageInput::create(filepath.string()));
+  if (!in) {
+    return false;
+  }
+
+  ImageSpec spec;
+  if (!in->open(filepath.string(), spec)) {
+    return false;
+  }
+
+  /* Levels are ordered from the largest to the smallest, e.g. in tiled TIFF and OpenEXR files
+   * created by maketx. */
+  bool found = false;
+  for (int miplevel = 1; in->seek_subimage(0, miplevel); miplevel++) {
+    const ImageSpec &mip_spec = in->spec();
+    if (mip_spec.nchannels != metadata.channels) {
+      break;
+    }
+    if ((size_t)max(max(mip_spec.width, mip_spec.height), mip_spec.depth) <= max_size) {
+      metadata.width = mip_spec.width;
+      metadata.height = mip_spec.height;
+      metadata.depth = mip_spec.depth;
+      metadata.miplevel = miplevel;
+      found = true;
+      break;
+    }
+  }
+
+  in->close();
+  return found;
+}
+
 string OIIOImageLoader::name() const
 {
   return path_filename(filepath.string());
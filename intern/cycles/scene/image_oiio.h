@@ -33,6 +33,8 @@ class OIIOImageLoader : public ImageLoader {
                    const size_t pixels_size,
                    const bool associate_alpha) override;
 
+  bool load_metadata_mip_level(ImageMetaData &metadata, const size_t max_size) override;
+
   string name() const override;
 
   ustring osl_filepath() const override;
@@ -73,6 +73,7 @@ NODE_DEFINE(Integrator)
 
   SOCKET_INT(volume_max_steps, "Volume Max Steps", 1024);
   SOCKET_FLOAT(volume_step_rate, "Volume Step Rate", 1.0f);
+  SOCKET_BOOLEAN(use_volume_empty_skip, "Use Volume Empty Skip", false);
 
   SOCKET_BOOLEAN(caustics_reflective, "Reflective Caustics", true);
   SOCKET_BOOLEAN(caustics_refractive, "Refractive Caustics", true);
@@ -97,7 +98,12 @@ NODE_DEFINE(Integrator)
   SOCKET_FLOAT(adaptive_threshold, "Adaptive Threshold", 0.0f);
   SOCKET_INT(adaptive_min_samples, "Adaptive Min Samples", 0);
 
+  SOCKET_BOOLEAN(use_guiding, "Use Guiding", false);
+  SOCKET_INT(guiding_training_samples, "Guiding Training Samples", 128);
+  SOCKET_FLOAT(surface_guiding_probability, "Surface Guiding Probability", 0.5f);
+
   SOCKET_FLOAT(light_sampling_threshold, "Light Sampling Threshold", 0.05f);
+  SOCKET_BOOLEAN(use_light_tree, "Use Light Tree", false);
 
   static NodeEnum sampling_pattern_enum;
   sampling_pattern_enum.insert("sobol", SAMPLING_PATTERN_SOBOL);
@@ -207,6 +213,7 @@ void Integrator::device_update(Device *device, DeviceScene *dscene, Scene *scene
 
   kintegrator->volume_max_steps = volume_max_steps;
   kintegrator->volume_step_rate = volume_step_rate;
+  kintegrator->use_volume_empty_skip = use_volume_empty_skip;
 
   kintegrator->caustics_reflective = caustics_reflective;
   kintegrator->caustics_refractive = caustics_refractive;
@@ -324,6 +331,10 @@ void Integrator::tag_update(Scene *scene, uint32_t flag)
     scene->object_manager->tag_update(scene, ObjectManager::MOTION_BLUR_MODIFIED);
     scene->camera->tag_modified();
   }
+
+  if (use_light_tree_is_modified()) {
+    scene->light_manager->tag_update(scene, LightManager::INTEGRATOR_MODIFIED);
+  }
 }
 
 uint Integrator::get_kernel_features() const
@@ -398,4 +409,15 @@ DenoiseParams Integrator::get_denoise_params() const
   return denoise_params;
 }
 
+GuidingParams Integrator::get_guiding_params() const
+{
+  GuidingParams guiding_params;
+
+  guiding_params.use = use_guiding;
+  guiding_params.training_samples = guiding_training_samples;
+  guiding_params.surface_probability = surface_guiding_probability;
+
+  return guiding_params;
+}
+
 CCL_NAMESPACE_END
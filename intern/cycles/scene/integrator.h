@@ -22,6 +22,7 @@
 #include "device/denoise.h" /* For the parameters and type enum. */
 #include "graph/node.h"
 #include "integrator/adaptive_sampling.h"
+#include "integrator/guiding.h"
 
 CCL_NAMESPACE_BEGIN
 
@@ -55,6 +56,7 @@ class Integrator : public Node {
 
   NODE_SOCKET_API(int, volume_max_steps)
   NODE_SOCKET_API(float, volume_step_rate)
+  NODE_SOCKET_API(bool, use_volume_empty_skip)
 
   NODE_SOCKET_API(bool, caustics_reflective)
   NODE_SOCKET_API(bool, caustics_refractive)
@@ -81,11 +83,16 @@ class Integrator : public Node {
   NODE_SOCKET_API(int, start_sample)
 
   NODE_SOCKET_API(float, light_sampling_threshold)
+  NODE_SOCKET_API(bool, use_light_tree)
 
   NODE_SOCKET_API(bool, use_adaptive_sampling)
   NODE_SOCKET_API(int, adaptive_min_samples)
   NODE_SOCKET_API(float, adaptive_threshold)
 
+  NODE_SOCKET_API(bool, use_guiding)
+  NODE_SOCKET_API(int, guiding_training_samples)
+  NODE_SOCKET_API(float, surface_guiding_probability)
+
   NODE_SOCKET_API(SamplingPattern, sampling_pattern)
   NODE_SOCKET_API(float, scrambling_distance)
 
@@ -118,6 +125,7 @@ class Integrator : public Node {
 
   AdaptiveSampling get_adaptive_sampling() const;
   DenoiseParams get_denoise_params() const;
+  GuidingParams get_guiding_params() const;
 };
 
 CCL_NAMESPACE_END
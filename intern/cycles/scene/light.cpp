@@ -20,6 +20,7 @@
 #include "scene/film.h"
 #include "scene/integrator.h"
 #include "scene/light.h"
+#include "scene/light_tree.h"
 #include "scene/mesh.h"
 #include "scene/object.h"
 #include "scene/scene.h"
@@ -271,6 +272,53 @@ bool LightManager::object_usable_as_light(Object *object)
   return false;
 }
 
+/* Estimate of the energy emitted by a shader, only constant emission is taken into account. */
+static float light_tree_shader_energy(Shader *shader)
+{
+  float3 emission;
+  if (shader->is_constant_emission(&emission)) {
+    return average(fabs(emission));
+  }
+  return 1.0f;
+}
+
+static LightTreeEmitter light_tree_lamp_emitter(const Light *light)
+{
+  LightTreeEmitter emitter;
+  const float3 strength = fabs(light->get_strength());
+
+  if (light->get_light_type() == LIGHT_AREA) {
+    const float3 axisu = light->get_axisu() * (light->get_sizeu() * light->get_size());
+    const float3 axisv = light->get_axisv() * (light->get_sizev() * light->get_size());
+    const float3 corner = light->get_co() - 0.5f * (axisu + axisv);
+    emitter.bounds.grow(corner);
+    emitter.bounds.grow(corner + axisu);
+    emitter.bounds.grow(corner + axisv);
+    emitter.bounds.grow(corner + axisu + axisv);
+    /* One sided, the spread angle is not taken into account. */
+    emitter.cone = LightTreeCone(safe_normalize(light->get_dir()), 0.0f, M_PI_2_F);
+    emitter.energy = 0.25f * average(strength);
+  }
+  else {
+    emitter.bounds.grow(light->get_co(), light->get_size());
+    if (light->get_light_type() == LIGHT_SPOT) {
+      emitter.cone = LightTreeCone(
+          safe_normalize(light->get_dir()), 0.0f, min(0.5f * light->get_spot_angle(), M_PI_2_F));
+    }
+    else {
+      emitter.cone = LightTreeCone(make_float3(0.0f, 0.0f, 1.0f), M_PI_F, M_PI_2_F);
+    }
+    emitter.energy = 0.25f * M_1_PI_F * average(strength);
+  }
+
+  return emitter;
+}
+
+static bool light_is_in_tree(const Light *light)
+{
+  return light->get_light_type() != LIGHT_DISTANT && light->get_light_type() != LIGHT_BACKGROUND;
+}
+
 void LightManager::device_update_distribution(Device *,
                                               DeviceScene *dscene,
                                               Scene *scene,
@@ -321,6 +369,15 @@ void LightManager::device_update_distribution(Device *,
   size_t num_distribution = num_triangles + num_lights;
   VLOG(1) << "Total " << num_distribution << " of light distribution primitives.";
 
+  /* With the light tree, lamps and the emissive triangles of each object are selected from the
+   * tree. Only distant and background lights get an area in the distribution, to be selected
+   * from the remaining probability. */
+  const bool use_light_tree = scene->integrator->get_use_light_tree();
+  vector<LightTreeEmitter> tree_emitters;
+  vector<int> tree_emitter_objects;
+  vector<int> tree_emitter_lamps;
+  size_t num_infinite_lights = 0;
+
   /* emission area */
   KernelLightDistribution *distribution = dscene->light_distribution.alloc(num_distribution + 1);
   float totarea = 0.0f;
@@ -363,6 +420,13 @@ void LightManager::device_update_distribution(Device *,
       shader_flag |= SHADER_EXCLUDE_SHADOW_CATCHER;
     }
 
+    LightTreeEmitter emitter;
+    emitter.distribution_first = offset;
+    vector<float> shader_energy;
+    if (use_light_tree) {
+      shader_energy.resize(mesh->get_used_shaders().size() + 1, -1.0f);
+    }
+
     size_t mesh_num_triangles = mesh->num_triangles();
     for (size_t i = 0; i < mesh_num_triangles; i++) {
       int shader_index = mesh->get_shader()[i];
@@ -391,10 +455,31 @@ void LightManager::device_update_distribution(Device *,
           p3 = transform_point(&tfm, p3);
         }
 
-        totarea += triangle_area(p1, p2, p3);
+        const float area = triangle_area(p1, p2, p3);
+        totarea += area;
+
+        if (use_light_tree) {
+          const size_t energy_index = std::min(size_t(shader_index), shader_energy.size() - 1);
+          if (shader_energy[energy_index] < 0.0f) {
+            shader_energy[energy_index] = light_tree_shader_energy(shader);
+          }
+          emitter.bounds.grow(p1);
+          emitter.bounds.grow(p2);
+          emitter.bounds.grow(p3);
+          emitter.energy += area * shader_energy[energy_index];
+          emitter.area += area;
+        }
       }
     }
 
+    if (use_light_tree && emitter.area > 0.0f) {
+      /* Triangles emit on both sides, in any direction. */
+      emitter.cone = LightTreeCone(make_float3(0.0f, 0.0f, 1.0f), M_PI_F, M_PI_2_F);
+      emitter.distribution_num = offset - emitter.distribution_first;
+      tree_emitters.push_back(emitter);
+      tree_emitter_objects.push_back(object_id);
+    }
+
     j++;
   }
 
@@ -413,7 +498,18 @@ void LightManager::device_update_distribution(Device *,
       distribution[offset].prim = ~light_index;
       distribution[offset].lamp.pad = 1.0f;
       distribution[offset].lamp.size = light->size;
-      totarea += lightarea;
+
+      if (use_light_tree && light_is_in_tree(light)) {
+        LightTreeEmitter emitter = light_tree_lamp_emitter(light);
+        emitter.distribution_first = offset;
+        emitter.distribution_num = 1;
+        tree_emitters.push_back(emitter);
+        tree_emitter_lamps.push_back(light_index);
+      }
+      else {
+        totarea += lightarea;
+        num_infinite_lights++;
+      }
 
       if (light->light_type == LIGHT_DISTANT) {
         use_lamp_mis |= (light->angle > 0.0f && light->use_mis);
@@ -453,7 +549,10 @@ void LightManager::device_update_distribution(Device *,
   KernelIntegrator *kintegrator = &dscene->data.integrator;
   KernelBackground *kbackground = &dscene->data.background;
   KernelFilm *kfilm = &dscene->data.film;
-  kintegrator->use_direct_light = (totarea > 0.0f);
+  kintegrator->use_direct_light = (totarea > 0.0f) || !tree_emitters.empty();
+  kintegrator->use_light_tree = false;
+  kintegrator->light_tree_pdf = 0.0f;
+  kintegrator->light_tree_lamp_offset = 0;
 
   if (kintegrator->use_direct_light) {
     /* number of emissives */
@@ -490,6 +589,23 @@ void LightManager::device_update_distribution(Device *,
     if (num_background_lights < num_lights)
       kfilm->pass_shadow_scale /= (float)(num_lights - num_background_lights) / (float)num_lights;
 
+    if (use_light_tree) {
+      device_update_tree(dscene, scene, tree_emitters, tree_emitter_objects, tree_emitter_lamps);
+
+      kintegrator->use_light_tree = true;
+      kintegrator->light_tree_pdf = (tree_emitters.empty())    ? 0.0f :
+                                    (num_infinite_lights == 0) ? 1.0f :
+                                                                 0.5f;
+      kintegrator->light_tree_lamp_offset = num_triangles;
+      kintegrator->pdf_triangles = 0.0f;
+      kintegrator->pdf_lights = (num_infinite_lights == 0) ?
+                                    0.0f :
+                                    (1.0f - kintegrator->light_tree_pdf) / num_infinite_lights;
+
+      const float background_pdf = kintegrator->pdf_lights * num_background_lights;
+      kfilm->pass_shadow_scale = (background_pdf < 1.0f) ? 1.0f / (1.0f - background_pdf) : 1.0f;
+    }
+
     /* CDF */
     dscene->light_distribution.copy_to_device();
 
@@ -527,6 +643,38 @@ void LightManager::device_update_distribution(Device *,
   }
 }
 
+void LightManager::device_update_tree(DeviceScene *dscene,
+                                      Scene *scene,
+                                      const vector<LightTreeEmitter> &emitters,
+                                      const vector<int> &emitter_objects,
+                                      const vector<int> &emitter_lamps)
+{
+  LightTree tree(emitters);
+  const vector<KernelLightTreeNode> &nodes = tree.get_nodes();
+  const vector<int> &emitter_leaves = tree.get_emitter_leaves();
+  VLOG(1) << "Light tree with " << nodes.size() << " nodes.";
+
+  KernelLightTreeNode *knodes = dscene->light_tree_nodes.alloc(nodes.size());
+  std::copy(nodes.begin(), nodes.end(), knodes);
+
+  /* Leaves of the emitters, mesh lights come first. */
+  int *object_leaves = dscene->light_tree_object_leaves.alloc(scene->objects.size());
+  std::fill(object_leaves, object_leaves + scene->objects.size(), -1);
+  for (size_t i = 0; i < emitter_objects.size(); i++) {
+    object_leaves[emitter_objects[i]] = emitter_leaves[i];
+  }
+
+  int *lamp_leaves = dscene->light_tree_lamp_leaves.alloc(dscene->lights.size());
+  std::fill(lamp_leaves, lamp_leaves + dscene->lights.size(), -1);
+  for (size_t i = 0; i < emitter_lamps.size(); i++) {
+    lamp_leaves[emitter_lamps[i]] = emitter_leaves[emitter_objects.size() + i];
+  }
+
+  dscene->light_tree_nodes.copy_to_device();
+  dscene->light_tree_object_leaves.copy_to_device();
+  dscene->light_tree_lamp_leaves.copy_to_device();
+}
+
 static void background_cdf(
     int start, int end, int res_x, int res_y, const vector<float3> *pixels, float2 *cond_cdf)
 {
@@ -1009,6 +1157,9 @@ void LightManager::device_update(Device *device,
 void LightManager::device_free(Device *, DeviceScene *dscene, const bool free_background)
 {
   dscene->light_distribution.free();
+  dscene->light_tree_nodes.free();
+  dscene->light_tree_lamp_leaves.free();
+  dscene->light_tree_object_leaves.free();
   dscene->lights.free();
   if (free_background) {
     dscene->light_background_marginal_cdf.free();
@@ -0,0 +1,230 @@
+/*
+ * Copyright 2011-2021 Blender Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "scene/light_tree.h"
+
+#include "util/algorithm.h"
+#include "util/math.h"
+
+CCL_NAMESPACE_BEGIN
+
+/* Number of buckets to evaluate splits with, per axis. */
+#define LIGHT_TREE_NUM_BUCKETS 12
+
+LightTreeCone LightTreeCone::merge(const LightTreeCone &cone_a, const LightTreeCone &cone_b)
+{
+  const bool a_is_wider = (cone_a.theta_o >= cone_b.theta_o);
+  const LightTreeCone &a = (a_is_wider) ? cone_a : cone_b;
+  const LightTreeCone &b = (a_is_wider) ? cone_b : cone_a;
+  const float theta_e = max(a.theta_e, b.theta_e);
+
+  const float theta_d = safe_acosf(dot(a.axis, b.axis));
+  if (min(theta_d + b.theta_o, M_PI_F) <= a.theta_o) {
+    /* The wider cone already contains the other one. */
+    return LightTreeCone(a.axis, a.theta_o, theta_e);
+  }
+
+  const float theta_o = 0.5f * (a.theta_o + theta_d + b.theta_o);
+  if (theta_o >= M_PI_F) {
+    return LightTreeCone(a.axis, M_PI_F, theta_e);
+  }
+
+  /* Rotate the axis of the wider cone towards the other one, so that the merged cone touches the
+   * far sides of both. */
+  float3 ortho = b.axis - a.axis * dot(a.axis, b.axis);
+  if (len_squared(ortho) == 0.0f) {
+    float3 unused;
+    make_orthonormals(a.axis, &ortho, &unused);
+  }
+  const float theta_r = theta_o - a.theta_o;
+  const float3 axis = a.axis * cosf(theta_r) + normalize(ortho) * sinf(theta_r);
+  return LightTreeCone(normalize(axis), theta_o, theta_e);
+}
+
+/* Measure of the directions light can be emitted in, to compare the cost of splits. */
+static float light_tree_cone_measure(const LightTreeCone &cone)
+{
+  const float theta_w = min(cone.theta_o + cone.theta_e, M_PI_F);
+  const float cos_theta_o = cosf(cone.theta_o);
+  const float sin_theta_o = sinf(cone.theta_o);
+  return M_2PI_F * (1.0f - cos_theta_o) +
+         M_PI_2_F * (2.0f * theta_w * sin_theta_o - cosf(cone.theta_o - 2.0f * theta_w) -
+                     2.0f * cone.theta_o * sin_theta_o + cos_theta_o);
+}
+
+struct LightTreeBucket {
+  BoundBox bounds = BoundBox::empty;
+  LightTreeCone cone;
+  float energy = 0.0f;
+  int num = 0;
+
+  void add(const LightTreeEmitter &emitter)
+  {
+    bounds.grow(emitter.bounds);
+    cone = (num == 0) ? emitter.cone : LightTreeCone::merge(cone, emitter.cone);
+    energy += emitter.energy;
+    num++;
+  }
+
+  void add(const LightTreeBucket &other)
+  {
+    if (other.num == 0) {
+      return;
+    }
+    bounds.grow(other.bounds);
+    cone = (num == 0) ? other.cone : LightTreeCone::merge(cone, other.cone);
+    energy += other.energy;
+    num += other.num;
+  }
+
+  float cost() const
+  {
+    return (num == 0) ? 0.0f :
+                        energy * light_tree_cone_measure(cone) * bounds.safe_area();
+  }
+};
+
+LightTree::LightTree(const vector<LightTreeEmitter> &emitters) : emitters(emitters)
+{
+  if (emitters.empty()) {
+    return;
+  }
+
+  order.resize(emitters.size());
+  for (size_t i = 0; i < emitters.size(); i++) {
+    order[i] = i;
+  }
+  emitter_leaves.resize(emitters.size(), -1);
+  nodes.reserve(2 * emitters.size() - 1);
+
+  build_node(-1, 0, emitters.size());
+}
+
+int LightTree::build_node(int parent, int begin, int end)
+{
+  const int index = nodes.size();
+  nodes.push_back(KernelLightTreeNode());
+
+  LightTreeBucket total;
+  for (int i = begin; i < end; i++) {
+    total.add(emitters[order[i]]);
+  }
+
+  int right_child = -1;
+  if (end - begin > 1) {
+    const int middle = split(begin, end);
+    build_node(index, begin, middle);
+    right_child = build_node(index, middle, end);
+  }
+
+  KernelLightTreeNode &knode = nodes[index];
+  knode.bbox_min[0] = total.bounds.min.x;
+  knode.bbox_min[1] = total.bounds.min.y;
+  knode.bbox_min[2] = total.bounds.min.z;
+  knode.energy = total.energy;
+  knode.bbox_max[0] = total.bounds.max.x;
+  knode.bbox_max[1] = total.bounds.max.y;
+  knode.bbox_max[2] = total.bounds.max.z;
+  knode.theta_o = total.cone.theta_o;
+  knode.axis[0] = total.cone.axis.x;
+  knode.axis[1] = total.cone.axis.y;
+  knode.axis[2] = total.cone.axis.z;
+  knode.theta_e = total.cone.theta_e;
+  knode.parent = parent;
+  knode.right_child = right_child;
+  knode.distribution_first = 0;
+  knode.distribution_num = 0;
+  knode.area = 0.0f;
+
+  if (right_child == -1) {
+    const LightTreeEmitter &emitter = emitters[order[begin]];
+    knode.distribution_first = emitter.distribution_first;
+    knode.distribution_num = emitter.distribution_num;
+    knode.area = emitter.area;
+    emitter_leaves[order[begin]] = index;
+  }
+
+  return index;
+}
+
+/* Partition the emitters in two, evaluating splits of the centroid bounds in buckets along each
+ * axis, with a cost based on energy, orientation and surface area. Returns the first emitter of
+ * the second part. */
+int LightTree::split(int begin, int end)
+{
+  BoundBox centroid_bounds = BoundBox::empty;
+  for (int i = begin; i < end; i++) {
+    centroid_bounds.grow(emitters[order[i]].bounds.center());
+  }
+  const float3 extent = centroid_bounds.size();
+
+  float best_cost = FLT_MAX;
+  int best_dim = -1;
+  int best_bucket = 0;
+
+  for (int dim = 0; dim < 3; dim++) {
+    if (extent[dim] == 0.0f) {
+      continue;
+    }
+
+    LightTreeBucket buckets[LIGHT_TREE_NUM_BUCKETS];
+    const float inv_extent = LIGHT_TREE_NUM_BUCKETS / extent[dim];
+    for (int i = begin; i < end; i++) {
+      const LightTreeEmitter &emitter = emitters[order[i]];
+      const float offset = emitter.bounds.center()[dim] - centroid_bounds.min[dim];
+      const int bucket = min((int)(offset * inv_extent), LIGHT_TREE_NUM_BUCKETS - 1);
+      buckets[bucket].add(emitter);
+    }
+
+    /* Cost of splitting after each bucket. */
+    LightTreeBucket left[LIGHT_TREE_NUM_BUCKETS];
+    left[0] = buckets[0];
+    for (int i = 1; i < LIGHT_TREE_NUM_BUCKETS; i++) {
+      left[i] = left[i - 1];
+      left[i].add(buckets[i]);
+    }
+
+    LightTreeBucket right;
+    for (int i = LIGHT_TREE_NUM_BUCKETS - 1; i > 0; i--) {
+      right.add(buckets[i]);
+      if (left[i - 1].num == 0 || right.num == 0) {
+        continue;
+      }
+      const float cost = left[i - 1].cost() + right.cost();
+      if (cost < best_cost) {
+        best_cost = cost;
+        best_dim = dim;
+        best_bucket = i;
+      }
+    }
+  }
+
+  if (best_dim == -1) {
+    /* All centroids are at the same position. */
+    return (begin + end) / 2;
+  }
+
+  const float inv_extent = LIGHT_TREE_NUM_BUCKETS / extent[best_dim];
+  const auto middle = std::partition(
+      order.begin() + begin, order.begin() + end, [&](const int i) {
+        const float offset = emitters[i].bounds.center()[best_dim] -
+                             centroid_bounds.min[best_dim];
+        return min((int)(offset * inv_extent), LIGHT_TREE_NUM_BUCKETS - 1) < best_bucket;
+      });
+  return middle - order.begin();
+}
+
+CCL_NAMESPACE_END
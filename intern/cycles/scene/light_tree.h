@@ -0,0 +1,98 @@
+/*
+ * Copyright 2011-2021 Blender Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __LIGHT_TREE_H__
+#define __LIGHT_TREE_H__
+
+#include "kernel/types.h"
+
+#include "util/boundbox.h"
+#include "util/types.h"
+#include "util/vector.h"
+
+CCL_NAMESPACE_BEGIN
+
+/* Orientation Cone
+ *
+ * Normals of the emitters are within theta_o of the axis, and light is emitted up to theta_e
+ * away from the normals. */
+
+struct LightTreeCone {
+  float3 axis = make_float3(0.0f, 0.0f, 1.0f);
+  float theta_o = 0.0f;
+  float theta_e = 0.0f;
+
+  LightTreeCone() = default;
+  LightTreeCone(const float3 &axis, float theta_o, float theta_e)
+      : axis(axis), theta_o(theta_o), theta_e(theta_e)
+  {
+  }
+
+  /* Cone bounding both cones. */
+  static LightTreeCone merge(const LightTreeCone &a, const LightTreeCone &b);
+};
+
+/* Light Tree Emitter
+ *
+ * A lamp, or all emissive triangles of an object. */
+
+struct LightTreeEmitter {
+  BoundBox bounds = BoundBox::empty;
+  LightTreeCone cone;
+  float energy = 0.0f;
+  /* Total area of the triangles for mesh lights. */
+  float area = 0.0f;
+
+  /* Range of the emitter in the light distribution. */
+  int distribution_first = 0;
+  int distribution_num = 0;
+};
+
+/* Light Tree
+ *
+ * Binary BVH of the emitters, with one emitter per leaf. Nodes are stored depth first, so that
+ * the first child of a node directly follows it. */
+
+class LightTree {
+ public:
+  LightTree(const vector<LightTreeEmitter> &emitters);
+
+  /* Nodes in the layout used by the kernel. */
+  const vector<KernelLightTreeNode> &get_nodes() const
+  {
+    return nodes;
+  }
+
+  /* Index of the leaf node of each emitter. */
+  const vector<int> &get_emitter_leaves() const
+  {
+    return emitter_leaves;
+  }
+
+ protected:
+  int build_node(int parent, int begin, int end);
+  int split(int begin, int end);
+
+  const vector<LightTreeEmitter> &emitters;
+  /* Emitter indices, reordered while building. */
+  vector<int> order;
+  vector<KernelLightTreeNode> nodes;
+  vector<int> emitter_leaves;
+};
+
+CCL_NAMESPACE_END
+
+#endif /* __LIGHT_TREE_H__ */
@@ -34,6 +34,7 @@
 #include "scene/procedural.h"
 #include "scene/scene.h"
 #include "scene/shader.h"
+#include "scene/stats.h"
 #include "scene/svm.h"
 #include "scene/tables.h"
 #include "scene/volume.h"
@@ -84,6 +85,9 @@ DeviceScene::DeviceScene(Device *device)
       lights(device, "__lights", MEM_GLOBAL),
       light_background_marginal_cdf(device, "__light_background_marginal_cdf", MEM_GLOBAL),
       light_background_conditional_cdf(device, "__light_background_conditional_cdf", MEM_GLOBAL),
+      light_tree_nodes(device, "__light_tree_nodes", MEM_GLOBAL),
+      light_tree_lamp_leaves(device, "__light_tree_lamp_leaves", MEM_GLOBAL),
+      light_tree_object_leaves(device, "__light_tree_object_leaves", MEM_GLOBAL),
       particles(device, "__particles", MEM_GLOBAL),
       svm_nodes(device, "__svm_nodes", MEM_GLOBAL),
       shaders(device, "__shaders", MEM_GLOBAL),
@@ -475,6 +479,10 @@ void Scene::collect_statistics(RenderStats *stats)
 {
   geometry_manager->collect_statistics(this, stats);
   image_manager->collect_statistics(stats);
+
+  if (update_stats) {
+    update_stats->collect_times(stats->times);
+  }
 }
 
 void Scene::enable_update_stats()
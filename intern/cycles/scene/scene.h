@@ -123,6 +123,9 @@ class DeviceScene {
   device_vector<KernelLight> lights;
   device_vector<float2> light_background_marginal_cdf;
   device_vector<float2> light_background_conditional_cdf;
+  device_vector<KernelLightTreeNode> light_tree_nodes;
+  device_vector<int> light_tree_lamp_leaves;
+  device_vector<int> light_tree_object_leaves;
 
   /* particles */
   device_vector<KernelParticle> particles;
@@ -51,6 +51,25 @@ bool namedSampleCountPairComparator(const NamedSampleCountPair &a, const NamedSa
   return a.samples > b.samples;
 }
 
+/* Quote a string for JSON, escaping the characters which can not be written as-is. */
+string json_quote(const string &str)
+{
+  string result = "\"";
+  for (const char c : str) {
+    if (c == '"' || c == '\\') {
+      result += '\\';
+      result += c;
+    }
+    else if ((unsigned char)c < 0x20) {
+      result += string_printf("\\u%04x", c);
+    }
+    else {
+      result += c;
+    }
+  }
+  return result + "\"";
+}
+
 }  // namespace
 
 NamedSizeEntry::NamedSizeEntry() : name(""), size(0)
@@ -252,11 +271,24 @@ string ImageStats::full_report(int indent_level)
   return result;
 }
 
+/* Device render statistics. */
+
+DeviceRenderStats::DeviceRenderStats(const string &name, uint64_t num_pixel_samples, double time)
+    : name(name), num_pixel_samples(num_pixel_samples), time(time)
+{
+}
+
+double DeviceRenderStats::get_samples_per_second() const
+{
+  return (time > 0.0) ? num_pixel_samples / time : 0.0;
+}
+
 /* Overall statistics. */
 
 RenderStats::RenderStats()
 {
   has_profiling = false;
+  device_mem_peak = 0;
 }
 
 void RenderStats::collect_profiling(Scene *scene, Profiler &prof)
@@ -326,6 +358,42 @@ string RenderStats::full_report()
   return result;
 }
 
+string RenderStats::json_report()
+{
+  string result = "{\n";
+
+  result += "  \"times\": {";
+  for (size_t i = 0; i < times.entries.size(); i++) {
+    const NamedTimeEntry &entry = times.entries[i];
+    result += string_printf(
+        "%s\n    %s: %f", (i == 0) ? "" : ",", json_quote(entry.name).c_str(), entry.time);
+  }
+  result += "\n  },\n";
+
+  result += "  \"devices\": [";
+  for (size_t i = 0; i < devices.size(); i++) {
+    const DeviceRenderStats &device = devices[i];
+    result += string_printf(
+        "%s\n    {\"name\": %s, \"pixel_samples\": %llu, \"time\": %f, "
+        "\"samples_per_second\": %f}",
+        (i == 0) ? "" : ",",
+        json_quote(device.name).c_str(),
+        (unsigned long long)device.num_pixel_samples,
+        device.time,
+        device.get_samples_per_second());
+  }
+  result += "\n  ],\n";
+
+  result += "  \"memory\": {\n";
+  result += string_printf("    \"geometry\": %zu,\n", mesh.geometry.total_size);
+  result += string_printf("    \"textures\": %zu,\n", image.textures.total_size);
+  result += string_printf("    \"device_peak\": %zu\n", device_mem_peak);
+  result += "  }\n";
+
+  result += "}\n";
+  return result;
+}
+
 NamedTimeStats::NamedTimeStats() : total_time(0.0)
 {
 }
@@ -360,6 +428,28 @@ string SceneUpdateStats::full_report()
   return result;
 }
 
+void SceneUpdateStats::collect_times(NamedTimeStats &times)
+{
+  /* Building the BVH is part of the geometry update, report it separately as it is usually the
+   * most expensive step. */
+  double bvh_time = 0.0;
+  for (const NamedTimeEntry &entry : geometry.times.entries) {
+    if (string_endswith(entry.name, "BVHs)") || string_endswith(entry.name, "BVH)")) {
+      bvh_time += entry.time;
+    }
+  }
+
+  times.add_entry({"scene_update", scene.times.total_time});
+  times.add_entry({"geometry_update", geometry.times.total_time});
+  times.add_entry({"bvh_build", bvh_time});
+  times.add_entry({"image_update", image.times.total_time});
+  times.add_entry({"light_update", light.times.total_time});
+  times.add_entry({"object_update", object.times.total_time});
+  times.add_entry({"svm_compile", svm.times.total_time});
+  times.add_entry({"osl_compile", osl.times.total_time});
+  times.add_entry({"procedurals_update", procedurals.times.total_time});
+}
+
 void SceneUpdateStats::clear()
 {
   geometry.times.clear();
@@ -173,6 +173,19 @@ class ImageStats {
   NamedSizeStats textures;
 };
 
+/* Path tracing throughput of a single device. */
+class DeviceRenderStats {
+ public:
+  DeviceRenderStats(const string &name, uint64_t num_pixel_samples, double time);
+
+  /* Number of pixel samples rendered by the device per second. */
+  double get_samples_per_second() const;
+
+  string name;
+  uint64_t num_pixel_samples;
+  double time;
+};
+
 /* Render process statistics. */
 class RenderStats {
  public:
@@ -181,6 +194,10 @@ class RenderStats {
   /* Return full report as string. */
   string full_report();
 
+  /* Return the phase times, device throughput and memory usage as a JSON object, to be gathered
+   * by tools which keep track of many renders. */
+  string json_report();
+
   /* Collect kernel sampling information from Stats. */
   void collect_profiling(Scene *scene, Profiler &prof);
 
@@ -191,6 +208,15 @@ class RenderStats {
   NamedNestedSampleStats kernel;
   NamedSampleCountStats shaders;
   NamedSampleCountStats objects;
+
+  /* Wall time of the phases of the render, such as scene update steps, path tracing and
+   * denoising. */
+  NamedTimeStats times;
+
+  vector<DeviceRenderStats> devices;
+
+  /* Peak memory usage of the render devices. */
+  size_t device_mem_peak;
 };
 
 class UpdateTimeStats {
@@ -223,6 +249,9 @@ class SceneUpdateStats {
 
   string full_report();
 
+  /* Add the total time of the update steps which are of interest for render statistics. */
+  void collect_times(NamedTimeStats &times);
+
   void clear();
 };
 
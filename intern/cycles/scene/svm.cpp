@@ -27,7 +27,9 @@
 #include "scene/svm.h"
 
 #include "util/foreach.h"
+#include "util/hash.h"
 #include "util/log.h"
+#include "util/map.h"
 #include "util/progress.h"
 #include "util/task.h"
 
@@ -69,6 +71,21 @@ void SVMShaderManager::device_update_shader(Scene *scene,
           << summary.full_report();
 }
 
+static uint svm_nodes_hash(const array<int4> &svm_nodes)
+{
+  uint hash = svm_nodes.size();
+  for (size_t i = 0; i < svm_nodes.size(); i++) {
+    const int4 &node = svm_nodes[i];
+    hash = hash_uint2(hash, hash_uint4(node.x, node.y, node.z, node.w));
+  }
+  return hash;
+}
+
+static bool svm_nodes_equal(const array<int4> &a, const array<int4> &b)
+{
+  return a.size() == b.size() && memcmp(a.data(), b.data(), sizeof(int4) * a.size()) == 0;
+}
+
 void SVMShaderManager::device_update_specific(Device *device,
                                               DeviceScene *dscene,
                                               Scene *scene,
@@ -110,16 +127,42 @@ void SVMShaderManager::device_update_specific(Device *device,
   }
 
   /* The global node list contains a jump table (one node per shader)
-   * followed by the nodes of all shaders. */
+   * followed by the nodes of all shaders.
+   *
+   * Jumps within the nodes of a shader are relative, so shaders which compile to identical nodes
+   * share a single copy of them. This is common for generated variations of a material, and
+   * keeps the node list small enough to stay in the caches. */
+  vector<int> shader_node_offset(num_shaders);
+  vector<bool> shader_is_duplicate(num_shaders, false);
+  unordered_map<uint, vector<int>> unique_shaders_by_hash;
+  int num_duplicate_shaders = 0;
+
   int svm_nodes_size = num_shaders;
   for (int i = 0; i < num_shaders; i++) {
+    const array<int4> &nodes = shader_svm_nodes[i];
+    vector<int> &unique_shaders = unique_shaders_by_hash[svm_nodes_hash(nodes)];
+
+    for (const int j : unique_shaders) {
+      if (svm_nodes_equal(shader_svm_nodes[j], nodes)) {
+        shader_node_offset[i] = shader_node_offset[j];
+        shader_is_duplicate[i] = true;
+        break;
+      }
+    }
+
+    if (shader_is_duplicate[i]) {
+      num_duplicate_shaders++;
+      continue;
+    }
+
+    unique_shaders.push_back(i);
+    shader_node_offset[i] = svm_nodes_size;
     /* Since we're not copying the local jump node, the size ends up being one node lower. */
-    svm_nodes_size += shader_svm_nodes[i].size() - 1;
+    svm_nodes_size += nodes.size() - 1;
   }
 
   int4 *svm_nodes = dscene->svm_nodes.alloc(svm_nodes_size);
 
-  int node_offset = num_shaders;
   for (int i = 0; i < num_shaders; i++) {
     Shader *shader = scene->shaders[i];
 
@@ -133,18 +176,21 @@ void SVMShaderManager::device_update_specific(Device *device,
      * to the shader, so copy those and add the offset into the global node list. */
     int4 &global_jump_node = svm_nodes[shader->id];
     int4 &local_jump_node = shader_svm_nodes[i][0];
+    const int node_offset = shader_node_offset[i];
 
     global_jump_node.x = NODE_SHADER_JUMP;
     global_jump_node.y = local_jump_node.y - 1 + node_offset;
     global_jump_node.z = local_jump_node.z - 1 + node_offset;
     global_jump_node.w = local_jump_node.w - 1 + node_offset;
-
-    node_offset += shader_svm_nodes[i].size() - 1;
   }
 
   /* Copy the nodes of each shader into the correct location. */
   svm_nodes += num_shaders;
   for (int i = 0; i < num_shaders; i++) {
+    if (shader_is_duplicate[i]) {
+      continue;
+    }
+
     int shader_size = shader_svm_nodes[i].size() - 1;
 
     memcpy(svm_nodes, &shader_svm_nodes[i][1], sizeof(int4) * shader_size);
@@ -162,7 +208,8 @@ void SVMShaderManager::device_update_specific(Device *device,
   update_flags = UPDATE_NONE;
 
   VLOG(1) << "Shader manager updated " << num_shaders << " shaders in " << time_dt() - start_time
-          << " seconds.";
+          << " seconds, " << num_duplicate_shaders
+          << " of them share the nodes of another shader.";
 }
 
 void SVMShaderManager::device_free(Device *device, DeviceScene *dscene, Scene *scene)
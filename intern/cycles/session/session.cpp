@@ -30,6 +30,7 @@
 #include "scene/object.h"
 #include "scene/scene.h"
 #include "scene/shader_graph.h"
+#include "scene/stats.h"
 #include "session/buffers.h"
 #include "session/display_driver.h"
 #include "session/output_driver.h"
@@ -263,6 +264,12 @@ RenderWork Session::run_update_for_next_iteration()
     path_trace_->set_adaptive_sampling(adaptive_sampling);
   }
 
+  /* Update path guiding. */
+  {
+    const GuidingParams guiding_params = scene->integrator->get_guiding_params();
+    path_trace_->set_guiding_params(guiding_params);
+  }
+
   render_scheduler_.set_num_samples(params.samples);
   render_scheduler_.set_start_sample(params.sample_offset);
   render_scheduler_.set_time_limit(params.time_limit);
@@ -631,6 +638,9 @@ void Session::collect_statistics(RenderStats *render_stats)
   if (params.use_profiling && (params.device.type == DEVICE_CPU)) {
     render_stats->collect_profiling(scene, profiler);
   }
+
+  path_trace_->collect_statistics(render_stats);
+  render_stats->device_mem_peak = stats.mem_peak;
 }
 
 /* --------------------------------------------------------------------
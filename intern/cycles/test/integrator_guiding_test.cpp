@@ -0,0 +1,108 @@
+/*
+ * Copyright 2011-2021 Blender Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "testing/testing.h"
+
+#include "integrator/guiding.h"
+
+// clang-format off
+#include "kernel/device/cpu/compat.h"
+#include "kernel/device/cpu/globals.h"
+#include "kernel/integrator/guiding.h"
+// clang-format on
+
+#include "util/vector.h"
+
+CCL_NAMESPACE_BEGIN
+
+static vector<GuidingSample> guiding_test_samples(const float3 D, const int num_samples)
+{
+  vector<GuidingSample> samples(num_samples);
+  for (int i = 0; i < num_samples; i++) {
+    samples[i].P = make_float3(i % 4, (i / 4) % 4, 0.0f);
+    samples[i].D = D;
+    samples[i].value = 1.0f;
+  }
+  return samples;
+}
+
+TEST(GuidingField, no_distribution_without_samples)
+{
+  GuidingParams params;
+  GuidingField field;
+
+  field.update(params);
+  EXPECT_EQ(field.get_kernel_field(), nullptr);
+}
+
+TEST(GuidingField, distribution_follows_samples)
+{
+  GuidingParams params;
+  GuidingField field;
+
+  const float3 D = make_float3(0.0f, 0.0f, 1.0f);
+  const vector<GuidingSample> samples = guiding_test_samples(D, 4096);
+  field.add_samples(samples.data(), samples.size(), 1.0f);
+  field.update(params);
+
+  const KernelGuidingField *kfield = field.get_kernel_field();
+  ASSERT_NE(kfield, nullptr);
+  EXPECT_EQ(kfield->surface_probability, params.surface_probability);
+
+  const int cell = guiding_cell(kfield, make_float3(0.0f, 0.0f, 0.0f));
+  ASSERT_NE(cell, -1);
+  EXPECT_FLOAT_EQ(kfield->cdf[cell * GUIDING_NUM_BINS + GUIDING_NUM_BINS - 1], 1.0f);
+
+  /* Directions of the training samples are more likely than the opposite ones, which still have
+   * the uniform part of the distribution. */
+  const float pdf = guiding_cell_pdf(kfield, cell, D);
+  const float pdf_opposite = guiding_cell_pdf(kfield, cell, -D);
+  EXPECT_GT(pdf, pdf_opposite);
+  EXPECT_GT(pdf_opposite, 0.0f);
+
+  /* Sampling is consistent with the pdf. */
+  float sample_pdf;
+  const float3 sample_D = guiding_cell_sample(kfield, cell, 0.99f, 0.5f, &sample_pdf);
+  EXPECT_NEAR(len(sample_D), 1.0f, 1e-5f);
+  EXPECT_FLOAT_EQ(sample_pdf, guiding_cell_pdf(kfield, cell, sample_D));
+}
+
+TEST(GuidingThreadStorage, reservoir_keeps_max_samples)
+{
+  GuidingThreadStorage storage(16);
+  KernelGuidingThreadData *data = &storage.data;
+
+  for (int i = 0; i < 100; i++) {
+    data->num_segments = 1;
+    data->segments[0].P = zero_float3();
+    data->segments[0].D = make_float3(0.0f, 0.0f, 1.0f);
+    data->segments[0].throughput = one_float3();
+    data->segments[0].radiance = one_float3();
+    data->segments[0].pdf = 1.0f;
+    guiding_finish_path(data);
+  }
+
+  EXPECT_EQ(data->num_segments, 0);
+  EXPECT_EQ(data->num_samples, 16);
+  EXPECT_EQ(data->num_recorded, 100);
+
+  GuidingField field;
+  storage.push_to_field(field);
+  EXPECT_EQ(data->num_samples, 0);
+  EXPECT_EQ(data->num_recorded, 0);
+}
+
+CCL_NAMESPACE_END
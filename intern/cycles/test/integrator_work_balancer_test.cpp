@@ -0,0 +1,68 @@
+/*
+ * Copyright 2011-2021 Blender Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "testing/testing.h"
+
+#include "integrator/work_balancer.h"
+
+CCL_NAMESPACE_BEGIN
+
+TEST(WorkBalancer, initial_equal)
+{
+  vector<WorkBalanceInfo> infos(4);
+  work_balance_do_initial(infos);
+
+  for (const WorkBalanceInfo &info : infos) {
+    EXPECT_DOUBLE_EQ(info.weight, 0.25);
+  }
+}
+
+TEST(WorkBalancer, rebalance_towards_faster_device)
+{
+  vector<WorkBalanceInfo> infos(2);
+  work_balance_do_initial(infos);
+
+  infos[0].time_spent = 1.0;
+  infos[1].time_spent = 3.0;
+  EXPECT_TRUE(work_balance_do_rebalance(infos));
+
+  EXPECT_GT(infos[0].weight, infos[1].weight);
+  EXPECT_DOUBLE_EQ(infos[0].weight + infos[1].weight, 1.0);
+  EXPECT_EQ(infos[0].time_spent, 0.0);
+  EXPECT_EQ(infos[1].time_spent, 0.0);
+}
+
+TEST(WorkBalancer, initial_from_stored)
+{
+  vector<WorkBalanceInfo> infos(2);
+  infos[0].weight = 0.8;
+  infos[1].weight = 0.2;
+  work_balance_store(infos, "test_initial_from_stored");
+
+  vector<WorkBalanceInfo> new_infos(2);
+  work_balance_do_initial(new_infos, "test_initial_from_stored");
+  EXPECT_DOUBLE_EQ(new_infos[0].weight, 0.8);
+  EXPECT_DOUBLE_EQ(new_infos[1].weight, 0.2);
+
+  /* Weights stored for a different number of devices are not used. */
+  vector<WorkBalanceInfo> other_infos(3);
+  work_balance_do_initial(other_infos, "test_initial_from_stored");
+  for (const WorkBalanceInfo &info : other_infos) {
+    EXPECT_DOUBLE_EQ(info.weight, 1.0 / 3.0);
+  }
+}
+
+CCL_NAMESPACE_END
@@ -0,0 +1,96 @@
+/*
+ * Copyright 2011-2021 Blender Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "testing/testing.h"
+
+#include "scene/light_tree.h"
+
+#include "util/math.h"
+
+CCL_NAMESPACE_BEGIN
+
+static bool cone_contains(const LightTreeCone &cone, const LightTreeCone &other)
+{
+  const float theta_d = safe_acosf(dot(cone.axis, other.axis));
+  return theta_d + other.theta_o <= cone.theta_o + 1e-5f && other.theta_e <= cone.theta_e;
+}
+
+TEST(light_tree, cone_merge)
+{
+  const LightTreeCone a(make_float3(0.0f, 0.0f, 1.0f), 0.0f, M_PI_2_F);
+  const LightTreeCone b(make_float3(1.0f, 0.0f, 0.0f), 0.1f, 0.5f);
+  const LightTreeCone merged = LightTreeCone::merge(a, b);
+  EXPECT_TRUE(cone_contains(merged, a));
+  EXPECT_TRUE(cone_contains(merged, b));
+  EXPECT_NEAR(merged.theta_o, 0.5f * (M_PI_2_F + 0.1f), 1e-5f);
+
+  /* Opposite cones cover half of the sphere around any perpendicular axis. */
+  const LightTreeCone c(make_float3(0.0f, 0.0f, -1.0f), 0.0f, M_PI_2_F);
+  const LightTreeCone opposite = LightTreeCone::merge(a, c);
+  EXPECT_NEAR(opposite.theta_o, M_PI_2_F, 1e-5f);
+  EXPECT_NEAR(dot(opposite.axis, a.axis), 0.0f, 1e-5f);
+
+  const LightTreeCone sphere(make_float3(0.0f, 1.0f, 0.0f), M_PI_F, M_PI_2_F);
+  EXPECT_EQ(LightTreeCone::merge(a, sphere).theta_o, M_PI_F);
+}
+
+TEST(light_tree, build)
+{
+  vector<LightTreeEmitter> emitters;
+  for (int i = 0; i < 100; i++) {
+    LightTreeEmitter emitter;
+    emitter.bounds.grow(make_float3(float(i % 10), float(i / 10), 0.0f), 0.1f);
+    emitter.cone = LightTreeCone(make_float3(0.0f, 0.0f, 1.0f), 0.0f, M_PI_2_F);
+    emitter.energy = 1.0f + i;
+    emitter.distribution_first = i;
+    emitter.distribution_num = 1;
+    emitters.push_back(emitter);
+  }
+
+  LightTree tree(emitters);
+  const vector<KernelLightTreeNode> &nodes = tree.get_nodes();
+  const vector<int> &leaves = tree.get_emitter_leaves();
+  ASSERT_EQ(nodes.size(), 2 * emitters.size() - 1);
+  ASSERT_EQ(leaves.size(), emitters.size());
+
+  EXPECT_EQ(nodes[0].parent, -1);
+  EXPECT_FLOAT_EQ(nodes[0].energy, 5050.0f);
+
+  for (int i = 0; i < nodes.size(); i++) {
+    const KernelLightTreeNode &node = nodes[i];
+    if (node.right_child == -1) {
+      continue;
+    }
+    const KernelLightTreeNode &left = nodes[i + 1];
+    const KernelLightTreeNode &right = nodes[node.right_child];
+    EXPECT_EQ(left.parent, i);
+    EXPECT_EQ(right.parent, i);
+    EXPECT_FLOAT_EQ(node.energy, left.energy + right.energy);
+    for (int dim = 0; dim < 3; dim++) {
+      EXPECT_LE(node.bbox_min[dim], min(left.bbox_min[dim], right.bbox_min[dim]));
+      EXPECT_GE(node.bbox_max[dim], max(left.bbox_max[dim], right.bbox_max[dim]));
+    }
+  }
+
+  for (int i = 0; i < emitters.size(); i++) {
+    const KernelLightTreeNode &leaf = nodes[leaves[i]];
+    EXPECT_EQ(leaf.right_child, -1);
+    EXPECT_EQ(leaf.distribution_first, i);
+    EXPECT_EQ(leaf.distribution_num, 1);
+  }
+}
+
+CCL_NAMESPACE_END
@@ -0,0 +1,71 @@
+/*
+ * Copyright 2011-2021 Blender Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "testing/testing.h"
+
+#include "scene/stats.h"
+
+CCL_NAMESPACE_BEGIN
+
+TEST(SceneUpdateStats, collect_times)
+{
+  SceneUpdateStats update_stats;
+  update_stats.scene.times.add_entry({"device_update", 10.0});
+  update_stats.geometry.times.add_entry({"device_update (normals)", 1.0});
+  update_stats.geometry.times.add_entry({"device_update (build object BVHs)", 2.0});
+  update_stats.geometry.times.add_entry({"device_update (build scene BVH)", 3.0});
+  update_stats.svm.times.add_entry({"device_update", 0.5});
+
+  NamedTimeStats times;
+  update_stats.collect_times(times);
+
+  double bvh_time = -1.0;
+  double geometry_time = -1.0;
+  double svm_time = -1.0;
+  for (const NamedTimeEntry &entry : times.entries) {
+    if (entry.name == "bvh_build") {
+      bvh_time = entry.time;
+    }
+    else if (entry.name == "geometry_update") {
+      geometry_time = entry.time;
+    }
+    else if (entry.name == "svm_compile") {
+      svm_time = entry.time;
+    }
+  }
+
+  EXPECT_EQ(bvh_time, 5.0);
+  EXPECT_EQ(geometry_time, 6.0);
+  EXPECT_EQ(svm_time, 0.5);
+}
+
+TEST(RenderStats, json_report)
+{
+  RenderStats stats;
+  stats.times.add_entry({"path_tracing", 2.0});
+  stats.devices.emplace_back("CPU \"Test\"", 1000, 2.0);
+  stats.device_mem_peak = 1024;
+
+  EXPECT_EQ(stats.devices[0].get_samples_per_second(), 500.0);
+
+  const string report = stats.json_report();
+  EXPECT_NE(report.find("\"path_tracing\": 2.000000"), string::npos);
+  EXPECT_NE(report.find("\"name\": \"CPU \\\"Test\\\"\""), string::npos);
+  EXPECT_NE(report.find("\"samples_per_second\": 500.000000"), string::npos);
+  EXPECT_NE(report.find("\"device_peak\": 1024"), string::npos);
+}
+
+CCL_NAMESPACE_END
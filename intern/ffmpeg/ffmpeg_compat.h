@@ -92,6 +92,11 @@ void my_guess_pkt_duration(AVFormatContext *s, AVStream *st, AVPacket *pkt)
 }
 #endif
 
+/* Hardware decoding through a device context needs FFmpeg 4.0 or newer. */
+#if LIBAVCODEC_VERSION_MAJOR >= 58
+#  define FFMPEG_HAVE_HW_DECODING 1
+#endif
+
 FFMPEG_INLINE
 int64_t timestamp_from_pts_or_dts(int64_t pts, int64_t dts)
 {
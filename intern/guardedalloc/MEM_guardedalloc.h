@@ -188,6 +188,31 @@ extern void (*MEM_reset_peak_memory)(void);
 /** Get the peak memory usage in bytes, including mmap allocations. */
 extern size_t (*MEM_get_peak_memory)(void) ATTR_WARN_UNUSED_RESULT;
 
+/**
+ * Categories to account the memory of subsystems separately. Allocations are tagged with the
+ * category on top of the category stack of the calling thread, and keep their category until they
+ * are freed, from any thread.
+ */
+typedef enum eMEM_Category {
+  /** Allocations outside of any category, not counted separately. */
+  MEM_CATEGORY_NONE = 0,
+  MEM_CATEGORY_DRAW,
+  MEM_CATEGORY_UNDO,
+  MEM_CATEGORY_IMAGE,
+  MEM_CATEGORY_BVH,
+  MEM_CATEGORY_DEPSGRAPH,
+} eMEM_Category;
+#define MEM_CATEGORY_NUM (MEM_CATEGORY_DEPSGRAPH + 1)
+
+/** Tag the following allocations of the calling thread with `category`, until the matching pop. */
+void MEM_category_push(eMEM_Category category);
+void MEM_category_pop(void);
+/** Memory in use by a category, for #MEM_CATEGORY_NONE the memory of untagged allocations. */
+size_t MEM_get_category_memory_in_use(eMEM_Category category) ATTR_WARN_UNUSED_RESULT;
+/** Peak memory, since the last #MEM_reset_peak_memory, of a category other than none. */
+size_t MEM_get_category_peak_memory(eMEM_Category category) ATTR_WARN_UNUSED_RESULT;
+const char *MEM_category_name(eMEM_Category category) ATTR_WARN_UNUSED_RESULT;
+
 #ifdef __GNUC__
 #  define MEM_SAFE_FREE(v) \
     do { \
@@ -303,6 +328,23 @@ template<typename T> inline void MEM_delete(const T *ptr)
   MEM_freeN(const_cast<T *>(ptr));
 }
 
+/**
+ * Tag the allocations of the calling thread with a memory category while in scope.
+ */
+class MEM_CategoryScope {
+ public:
+  explicit MEM_CategoryScope(const eMEM_Category category)
+  {
+    MEM_category_push(category);
+  }
+  ~MEM_CategoryScope()
+  {
+    MEM_category_pop();
+  }
+  MEM_CategoryScope(const MEM_CategoryScope &other) = delete;
+  MEM_CategoryScope &operator=(const MEM_CategoryScope &other) = delete;
+};
+
 /* Allocation functions (for C++ only). */
 #  define MEM_CXX_CLASS_ALLOC_FUNCS(_id) \
    public: \
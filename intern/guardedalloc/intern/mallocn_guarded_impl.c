@@ -97,7 +97,8 @@ typedef struct MemHead {
   const char *name;
   const char *nextname;
   int tag2;
-  short pad1;
+  /* #eMEM_Category of the block. */
+  short category;
   /* if non-zero aligned allocation was used and alignment is stored here. */
   short alignment;
 #ifdef DEBUG_MEMCOUNTER
@@ -418,7 +419,7 @@ static void make_memhead_header(MemHead *memh, size_t len, const char *str)
   memh->name = str;
   memh->nextname = NULL;
   memh->len = len;
-  memh->pad1 = 0;
+  memh->category = (short)memory_usage_category_current();
   memh->alignment = 0;
   memh->tag2 = MEMTAG2;
 
@@ -435,6 +436,9 @@ static void make_memhead_header(MemHead *memh, size_t len, const char *str)
 
   atomic_add_and_fetch_u(&totblock, 1);
   atomic_add_and_fetch_z(&mem_in_use, len);
+  if (memh->category != MEM_CATEGORY_NONE) {
+    memory_usage_category_alloc((eMEM_Category)memh->category, len);
+  }
 
   mem_lock_thread();
   addtail(membase, &memh->next);
@@ -1006,6 +1010,9 @@ static void rem_memblock(MemHead *memh)
 
   atomic_sub_and_fetch_u(&totblock, 1);
   atomic_sub_and_fetch_z(&mem_in_use, memh->len);
+  if (memh->category != MEM_CATEGORY_NONE) {
+    memory_usage_category_free((eMEM_Category)memh->category, memh->len);
+  }
 
 #ifdef DEBUG_MEMDUPLINAME
   if (memh->need_free_name)
@@ -1180,6 +1187,8 @@ void MEM_guarded_reset_peak_memory(void)
   mem_lock_thread();
   peak_mem = mem_in_use;
   mem_unlock_thread();
+
+  memory_usage_category_peak_reset();
 }
 
 size_t MEM_guarded_get_memory_in_use(void)
@@ -0,0 +1,383 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/** \file
+ * \ingroup intern_mem
+ *
+ * Memory usage counters of the lock-free allocator.
+ *
+ * Every thread has its own counters, so that allocating from many threads at once doesn't make
+ * them fight over the cache line of shared counters. The totals are only computed when they are
+ * queried, which is rare compared to allocations.
+ *
+ * The counters of the memory categories work the same way, they are shared by both allocators.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <mutex>
+
+#include "MEM_guardedalloc.h"
+#include "mallocn_intern.h"
+
+namespace {
+
+/**
+ * The peak is updated when a thread allocated that much more memory since its last update. This
+ * keeps the cost of computing the total out of the common case, at the cost of a peak that can
+ * be off by up to this amount per thread.
+ */
+constexpr int64_t peak_update_threshold = 1024 * 1024;
+
+struct Local {
+  /** Only modified by the owning thread, read by others when computing the totals. */
+  std::atomic<int64_t> blocks_num{0};
+  std::atomic<int64_t> mem_in_use{0};
+  /**
+   * Value of #mem_in_use the last time the peak was updated, which can be done from any thread.
+   * Relaxed accesses are enough, a stale value only moves the next peak update.
+   */
+  std::atomic<int64_t> mem_in_use_during_peak_update{0};
+  /** Same as above, for every memory category. #MEM_CATEGORY_NONE is unused. */
+  std::atomic<int64_t> category_mem_in_use[MEM_CATEGORY_NUM]{};
+  std::atomic<int64_t> category_mem_in_use_during_peak_update[MEM_CATEGORY_NUM]{};
+  /** The main thread is destructed last, after that no thread local counters can be used. */
+  bool is_main = false;
+  /** Intrusive list, a container could allocate memory while the counters are constructed. */
+  Local *prev = nullptr;
+  Local *next = nullptr;
+
+  Local();
+  ~Local();
+};
+
+struct Global {
+  std::mutex locals_mutex;
+  Local *locals = nullptr;
+  /** Counters of threads which have exited, and of allocations while no counters exist. */
+  std::atomic<int64_t> blocks_num_outside_locals{0};
+  std::atomic<int64_t> mem_in_use_outside_locals{0};
+  std::atomic<size_t> peak{0};
+  std::atomic<int64_t> category_mem_in_use_outside_locals[MEM_CATEGORY_NUM]{};
+  std::atomic<size_t> category_peak[MEM_CATEGORY_NUM]{};
+};
+
+/** Deeper nesting than this keeps using the last category that fit. */
+constexpr int category_stack_max_depth = 16;
+
+/** Trivial, so that it's zero initialized without any cost on thread creation. */
+struct CategoryStack {
+  eMEM_Category categories[category_stack_max_depth];
+  int depth;
+};
+
+/**
+ * Cleared when the thread local counters of the main thread are destructed. Memory freed after
+ * that, by static destructors, is tracked in the global counters directly.
+ */
+std::atomic<bool> use_local_counters{true};
+
+thread_local CategoryStack category_stack;
+
+}  // namespace
+
+static Global &get_global()
+{
+  /* Construct on first use, allocations can happen during static initialization. */
+  static Global global;
+  return global;
+}
+
+static Local &get_local_data()
+{
+  static thread_local Local local;
+  assert(use_local_counters.load(std::memory_order_relaxed));
+  return local;
+}
+
+Local::Local()
+{
+  Global &global = get_global();
+  std::lock_guard lock{global.locals_mutex};
+
+  if (global.locals == nullptr) {
+    /* The first thread allocating memory is the main thread. */
+    this->is_main = true;
+  }
+  else {
+    global.locals->prev = this;
+  }
+  this->next = global.locals;
+  global.locals = this;
+}
+
+Local::~Local()
+{
+  Global &global = get_global();
+  std::lock_guard lock{global.locals_mutex};
+
+  if (this->prev) {
+    this->prev->next = this->next;
+  }
+  else {
+    global.locals = this->next;
+  }
+  if (this->next) {
+    this->next->prev = this->prev;
+  }
+  /* Memory allocated by this thread can still be freed by other threads. */
+  global.blocks_num_outside_locals.fetch_add(this->blocks_num, std::memory_order_relaxed);
+  global.mem_in_use_outside_locals.fetch_add(this->mem_in_use, std::memory_order_relaxed);
+  for (int i = 0; i < MEM_CATEGORY_NUM; i++) {
+    global.category_mem_in_use_outside_locals[i].fetch_add(this->category_mem_in_use[i],
+                                                           std::memory_order_relaxed);
+  }
+
+  if (this->is_main) {
+    use_local_counters.store(false, std::memory_order_relaxed);
+  }
+}
+
+static size_t get_mem_in_use_locked(const Global &global)
+{
+  int64_t mem_in_use = global.mem_in_use_outside_locals.load(std::memory_order_relaxed);
+  for (const Local *local = global.locals; local; local = local->next) {
+    mem_in_use += local->mem_in_use.load(std::memory_order_relaxed);
+  }
+  return size_t(std::max<int64_t>(mem_in_use, 0));
+}
+
+static void update_global_peak()
+{
+  Global &global = get_global();
+  std::lock_guard lock{global.locals_mutex};
+
+  for (Local *local = global.locals; local; local = local->next) {
+    local->mem_in_use_during_peak_update.store(local->mem_in_use.load(std::memory_order_relaxed),
+                                               std::memory_order_relaxed);
+  }
+  const size_t mem_in_use = get_mem_in_use_locked(global);
+  size_t peak = global.peak.load(std::memory_order_relaxed);
+  while (mem_in_use > peak && !global.peak.compare_exchange_weak(peak, mem_in_use)) {
+    /* Retry, `peak` has been updated with the current value. */
+  }
+}
+
+void memory_usage_block_alloc(size_t size)
+{
+  if (LIKELY(use_local_counters.load(std::memory_order_relaxed))) {
+    Local &local = get_local_data();
+    /* Only this thread writes the counters, a load and a store avoid a locked instruction. */
+    local.blocks_num.store(local.blocks_num.load(std::memory_order_relaxed) + 1,
+                           std::memory_order_relaxed);
+    const int64_t mem_in_use = local.mem_in_use.load(std::memory_order_relaxed) + int64_t(size);
+    local.mem_in_use.store(mem_in_use, std::memory_order_relaxed);
+
+    if (mem_in_use - local.mem_in_use_during_peak_update.load(std::memory_order_relaxed) >
+        peak_update_threshold) {
+      update_global_peak();
+    }
+  }
+  else {
+    Global &global = get_global();
+    global.blocks_num_outside_locals.fetch_add(1, std::memory_order_relaxed);
+    global.mem_in_use_outside_locals.fetch_add(int64_t(size), std::memory_order_relaxed);
+  }
+}
+
+void memory_usage_block_free(size_t size)
+{
+  if (LIKELY(use_local_counters.load(std::memory_order_relaxed))) {
+    /* The thread freeing a block can be a different one than the thread which allocated it, so
+     * the local counters can become negative. Only their sum is meaningful. */
+    Local &local = get_local_data();
+    local.blocks_num.store(local.blocks_num.load(std::memory_order_relaxed) - 1,
+                           std::memory_order_relaxed);
+    local.mem_in_use.store(local.mem_in_use.load(std::memory_order_relaxed) - int64_t(size),
+                           std::memory_order_relaxed);
+  }
+  else {
+    Global &global = get_global();
+    global.blocks_num_outside_locals.fetch_sub(1, std::memory_order_relaxed);
+    global.mem_in_use_outside_locals.fetch_sub(int64_t(size), std::memory_order_relaxed);
+  }
+}
+
+size_t memory_usage_block_num()
+{
+  Global &global = get_global();
+  std::lock_guard lock{global.locals_mutex};
+
+  int64_t blocks_num = global.blocks_num_outside_locals.load(std::memory_order_relaxed);
+  for (const Local *local = global.locals; local; local = local->next) {
+    blocks_num += local->blocks_num.load(std::memory_order_relaxed);
+  }
+  return size_t(std::max<int64_t>(blocks_num, 0));
+}
+
+size_t memory_usage_current()
+{
+  Global &global = get_global();
+  std::lock_guard lock{global.locals_mutex};
+  return get_mem_in_use_locked(global);
+}
+
+size_t memory_usage_peak()
+{
+  update_global_peak();
+  return get_global().peak.load(std::memory_order_relaxed);
+}
+
+void memory_usage_peak_reset()
+{
+  Global &global = get_global();
+  std::lock_guard lock{global.locals_mutex};
+  global.peak.store(get_mem_in_use_locked(global), std::memory_order_relaxed);
+}
+
+static size_t get_category_mem_in_use_locked(const Global &global, const int category)
+{
+  int64_t mem_in_use = global.category_mem_in_use_outside_locals[category].load(
+      std::memory_order_relaxed);
+  for (const Local *local = global.locals; local; local = local->next) {
+    mem_in_use += local->category_mem_in_use[category].load(std::memory_order_relaxed);
+  }
+  return size_t(std::max<int64_t>(mem_in_use, 0));
+}
+
+static void update_category_peak(const int category)
+{
+  Global &global = get_global();
+  std::lock_guard lock{global.locals_mutex};
+
+  for (Local *local = global.locals; local; local = local->next) {
+    local->category_mem_in_use_during_peak_update[category].store(
+        local->category_mem_in_use[category].load(std::memory_order_relaxed),
+        std::memory_order_relaxed);
+  }
+  const size_t mem_in_use = get_category_mem_in_use_locked(global, category);
+  std::atomic<size_t> &peak_counter = global.category_peak[category];
+  size_t peak = peak_counter.load(std::memory_order_relaxed);
+  while (mem_in_use > peak && !peak_counter.compare_exchange_weak(peak, mem_in_use)) {
+    /* Retry, `peak` has been updated with the current value. */
+  }
+}
+
+eMEM_Category memory_usage_category_current()
+{
+  const int depth = std::min(category_stack.depth, category_stack_max_depth);
+  return (depth > 0) ? category_stack.categories[depth - 1] : MEM_CATEGORY_NONE;
+}
+
+void memory_usage_category_alloc(eMEM_Category category, size_t size)
+{
+  if (LIKELY(use_local_counters.load(std::memory_order_relaxed))) {
+    Local &local = get_local_data();
+    std::atomic<int64_t> &counter = local.category_mem_in_use[category];
+    const int64_t mem_in_use = counter.load(std::memory_order_relaxed) + int64_t(size);
+    counter.store(mem_in_use, std::memory_order_relaxed);
+
+    const int64_t mem_in_use_during_peak_update =
+        local.category_mem_in_use_during_peak_update[category].load(std::memory_order_relaxed);
+    if (mem_in_use - mem_in_use_during_peak_update > peak_update_threshold) {
+      update_category_peak(category);
+    }
+  }
+  else {
+    get_global().category_mem_in_use_outside_locals[category].fetch_add(
+        int64_t(size), std::memory_order_relaxed);
+  }
+}
+
+void memory_usage_category_free(eMEM_Category category, size_t size)
+{
+  if (LIKELY(use_local_counters.load(std::memory_order_relaxed))) {
+    std::atomic<int64_t> &counter = get_local_data().category_mem_in_use[category];
+    counter.store(counter.load(std::memory_order_relaxed) - int64_t(size),
+                  std::memory_order_relaxed);
+  }
+  else {
+    get_global().category_mem_in_use_outside_locals[category].fetch_sub(
+        int64_t(size), std::memory_order_relaxed);
+  }
+}
+
+void memory_usage_category_peak_reset()
+{
+  Global &global = get_global();
+  std::lock_guard lock{global.locals_mutex};
+  for (int i = 0; i < MEM_CATEGORY_NUM; i++) {
+    global.category_peak[i].store(get_category_mem_in_use_locked(global, i),
+                                  std::memory_order_relaxed);
+  }
+}
+
+void MEM_category_push(eMEM_Category category)
+{
+  if (category_stack.depth < category_stack_max_depth) {
+    category_stack.categories[category_stack.depth] = category;
+  }
+  category_stack.depth++;
+}
+
+void MEM_category_pop()
+{
+  assert(category_stack.depth > 0);
+  category_stack.depth--;
+}
+
+size_t MEM_get_category_memory_in_use(eMEM_Category category)
+{
+  if (category == MEM_CATEGORY_NONE) {
+    size_t mem_in_use = MEM_get_memory_in_use();
+    for (int i = MEM_CATEGORY_NONE + 1; i < MEM_CATEGORY_NUM; i++) {
+      mem_in_use -= std::min(mem_in_use, MEM_get_category_memory_in_use(eMEM_Category(i)));
+    }
+    return mem_in_use;
+  }
+  Global &global = get_global();
+  std::lock_guard lock{global.locals_mutex};
+  return get_category_mem_in_use_locked(global, category);
+}
+
+size_t MEM_get_category_peak_memory(eMEM_Category category)
+{
+  if (category == MEM_CATEGORY_NONE) {
+    return 0;
+  }
+  update_category_peak(category);
+  return get_global().category_peak[category].load(std::memory_order_relaxed);
+}
+
+const char *MEM_category_name(eMEM_Category category)
+{
+  switch (category) {
+    case MEM_CATEGORY_NONE:
+      return "Other";
+    case MEM_CATEGORY_DRAW:
+      return "Draw";
+    case MEM_CATEGORY_UNDO:
+      return "Undo";
+    case MEM_CATEGORY_IMAGE:
+      return "Image";
+    case MEM_CATEGORY_BVH:
+      return "BVH";
+    case MEM_CATEGORY_DEPSGRAPH:
+      return "Depsgraph";
+  }
+  return "";
+}
@@ -0,0 +1,55 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include <thread>
+
+#include "MEM_guardedalloc.h"
+#include "guardedalloc_test_base.h"
+
+namespace {
+
+void DoBasicCategoryChecks()
+{
+  const size_t draw_mem = MEM_get_category_memory_in_use(MEM_CATEGORY_DRAW);
+  const size_t undo_mem = MEM_get_category_memory_in_use(MEM_CATEGORY_UNDO);
+
+  MEM_category_push(MEM_CATEGORY_DRAW);
+  void *draw = MEM_mallocN(1024, "test");
+  void *draw_aligned = MEM_mallocN_aligned(1024, 64, "test");
+  MEM_category_push(MEM_CATEGORY_UNDO);
+  void *undo = MEM_callocN(2048, "test");
+  MEM_category_pop();
+  MEM_category_pop();
+  void *none = MEM_mallocN(4096, "test");
+
+  EXPECT_EQ(MEM_get_category_memory_in_use(MEM_CATEGORY_DRAW), draw_mem + 2048);
+  EXPECT_EQ(MEM_get_category_memory_in_use(MEM_CATEGORY_UNDO), undo_mem + 2048);
+  EXPECT_EQ(MEM_allocN_len(draw), size_t(1024));
+  EXPECT_EQ(MEM_allocN_len(draw_aligned), size_t(1024));
+  EXPECT_GE(MEM_get_category_peak_memory(MEM_CATEGORY_DRAW), draw_mem + 2048);
+
+  /* Blocks keep their category when freed from another thread. */
+  std::thread thread([&]() {
+    MEM_freeN(draw);
+    MEM_freeN(draw_aligned);
+  });
+  thread.join();
+  MEM_freeN(undo);
+  MEM_freeN(none);
+
+  EXPECT_EQ(MEM_get_category_memory_in_use(MEM_CATEGORY_DRAW), draw_mem);
+  EXPECT_EQ(MEM_get_category_memory_in_use(MEM_CATEGORY_UNDO), undo_mem);
+}
+
+}  // namespace
+
+TEST_F(LockFreeAllocatorTest, MEM_category)
+{
+  DoBasicCategoryChecks();
+}
+
+TEST_F(GuardedAllocatorTest, MEM_category)
+{
+  DoBasicCategoryChecks();
+}
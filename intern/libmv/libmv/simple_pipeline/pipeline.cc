@@ -159,6 +159,23 @@ void InternalCompleteReconstruction(
   LG << "Max track: " << max_track;
   LG << "Max image: " << max_image;
   LG << "Number of markers: " << tracks.NumMarkers();
+
+  // Group the markers per track and per image once, looking them up in the
+  // tracks for every track and image on every iteration is quadratic in the
+  // number of markers, which dominates the solving time of long shots.
+  vector<vector<Marker>> markers_for_track(max_track + 1);
+  vector<vector<Marker>> markers_in_image(max_image + 1);
+  {
+    const vector<Marker> markers = tracks.AllMarkers();
+    for (int i = 0; i < markers.size(); ++i) {
+      if (markers[i].track < 0 || markers[i].image < 0) {
+        continue;
+      }
+      markers_for_track[markers[i].track].push_back(markers[i]);
+      markers_in_image[markers[i].image].push_back(markers[i]);
+    }
+  }
+
   while (num_resects != 0 || num_intersects != 0) {
     // Do all possible intersections.
     num_intersects = 0;
@@ -167,7 +184,7 @@ void InternalCompleteReconstruction(
         LG << "Skipping point: " << track;
         continue;
       }
-      vector<Marker> all_markers = tracks.MarkersForTrack(track);
+      const vector<Marker>& all_markers = markers_for_track[track];
       LG << "Got " << all_markers.size() << " markers for track " << track;
 
       vector<Marker> reconstructed_markers;
@@ -205,7 +222,7 @@ void InternalCompleteReconstruction(
         LG << "Skipping frame: " << image;
         continue;
       }
-      vector<Marker> all_markers = tracks.MarkersInImage(image);
+      const vector<Marker>& all_markers = markers_in_image[image];
       LG << "Got " << all_markers.size() << " markers for image " << image;
 
       vector<Marker> reconstructed_markers;
@@ -244,7 +261,7 @@ void InternalCompleteReconstruction(
       LG << "Skipping frame: " << image;
       continue;
     }
-    vector<Marker> all_markers = tracks.MarkersInImage(image);
+    const vector<Marker>& all_markers = markers_in_image[image];
 
     vector<Marker> reconstructed_markers;
     for (int i = 0; i < all_markers.size(); ++i) {
@@ -30,25 +30,37 @@ namespace libmv {
 
 Tracks::Tracks(const Tracks& other) {
   markers_ = other.markers_;
+  marker_index_ = other.marker_index_;
 }
 
 Tracks::Tracks(const vector<Marker>& markers) : markers_(markers) {
+  RebuildMarkerIndex();
 }
 
 void Tracks::Insert(int image, int track, double x, double y, double weight) {
-  // TODO(keir): Wow, this is quadratic for repeated insertions. Fix this by
-  // adding a smarter data structure like a set<>.
-  for (int i = 0; i < markers_.size(); ++i) {
-    if (markers_[i].image == image && markers_[i].track == track) {
-      markers_[i].x = x;
-      markers_[i].y = y;
-      return;
-    }
+  const int new_marker_index = markers_.size();
+  std::pair<map<std::pair<int, int>, int>::iterator, bool> it =
+      marker_index_.insert(
+          make_pair(make_pair(image, track), new_marker_index));
+  if (!it.second) {
+    Marker& marker = markers_[it.first->second];
+    marker.x = x;
+    marker.y = y;
+    return;
   }
   Marker marker = {image, track, x, y, weight};
   markers_.push_back(marker);
 }
 
+void Tracks::RebuildMarkerIndex() {
+  marker_index_.clear();
+  for (int i = 0; i < markers_.size(); ++i) {
+    // Keep the first marker of duplicated pairs, as the linear lookups do.
+    marker_index_.insert(
+        make_pair(make_pair(markers_[i].image, markers_[i].track), i));
+  }
+}
+
 vector<Marker> Tracks::AllMarkers() const {
   return markers_;
 }
@@ -119,10 +131,10 @@ vector<Marker> Tracks::MarkersForTracksInBothImages(int image1,
 }
 
 Marker Tracks::MarkerInImageForTrack(int image, int track) const {
-  for (int i = 0; i < markers_.size(); ++i) {
-    if (markers_[i].image == image && markers_[i].track == track) {
-      return markers_[i];
-    }
+  map<std::pair<int, int>, int>::const_iterator it =
+      marker_index_.find(make_pair(image, track));
+  if (it != marker_index_.end()) {
+    return markers_[it->second];
   }
   Marker null = {-1, -1, -1, -1, 0.0};
   return null;
@@ -136,6 +148,7 @@ void Tracks::RemoveMarkersForTrack(int track) {
     }
   }
   markers_.resize(size);
+  RebuildMarkerIndex();
 }
 
 void Tracks::RemoveMarker(int image, int track) {
@@ -146,6 +159,7 @@ void Tracks::RemoveMarker(int image, int track) {
     }
   }
   markers_.resize(size);
+  RebuildMarkerIndex();
 }
 
 int Tracks::MaxImage() const {
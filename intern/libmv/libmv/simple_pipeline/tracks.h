@@ -21,6 +21,9 @@
 #ifndef LIBMV_SIMPLE_PIPELINE_TRACKS_H_
 #define LIBMV_SIMPLE_PIPELINE_TRACKS_H_
 
+#include <utility>
+
+#include "libmv/base/map.h"
 #include "libmv/base/vector.h"
 #include "libmv/numeric/numeric.h"
 
@@ -128,7 +131,14 @@ class Tracks {
   int NumMarkers() const;
 
  private:
+  // Rebuild the lookup index of markers, needed after removing markers.
+  void RebuildMarkerIndex();
+
   vector<Marker> markers_;
+
+  // Index in markers_ of the marker for an (image, track) pair, makes
+  // inserting and looking up a single marker logarithmic instead of linear.
+  map<std::pair<int, int>, int> marker_index_;
 };
 
 void CoordinatesForMarkersInImage(const vector<Marker>& markers,
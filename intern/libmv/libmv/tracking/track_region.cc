@@ -1249,19 +1249,25 @@ bool BruteTranslationOnlyInitialize(const FloatImage& image1,
       // Compute the weighted sum of absolute differences, Eigen style. Note
       // that the block from the search image is never stored in a variable, to
       // avoid copying overhead and permit inlining.
-      double sad;
+      float inverse_search_mean = 1.0f;
       if (use_normalized_intensities) {
         // TODO(keir): It's really dumb to recompute the search mean for every
         // shift. A smarter implementation would use summed area tables
         // instead, reducing the mean calculation to an O(1) operation.
-        double inverse_search_mean =
+        inverse_search_mean =
             mask_sum / ((mask * search.block(r, c, h, w)).sum());
-        sad = (mask *
-               (pattern - (search.block(r, c, h, w) * inverse_search_mean)))
-                  .abs()
-                  .sum();
-      } else {
-        sad = (mask * (pattern - search.block(r, c, h, w))).abs().sum();
+      }
+      // The sum is accumulated one row at a time, rows are contiguous in
+      // memory so each of them is vectorized by Eigen. Most shifts are far
+      // from the best one, stop summing as soon as the partial sum shows this
+      // shift can not be better than the best one found so far.
+      double sad = 0.0;
+      for (int i = 0; i < h && sad < best_sad; ++i) {
+        sad += (mask.row(i) *
+                (pattern.row(i) -
+                 search.block(r + i, c, 1, w) * inverse_search_mean))
+                   .abs()
+                   .sum();
       }
       if (sad < best_sad) {
         best_r = r;
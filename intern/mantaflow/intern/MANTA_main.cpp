@@ -36,6 +36,7 @@
 
 #include "BLI_fileops.h"
 #include "BLI_path_util.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "DNA_fluid_types.h"
@@ -66,6 +67,8 @@ MANTA::MANTA(int *res, FluidModifierData *fmd)
   FluidDomainSettings *fds = fmd->domain;
   fds->fluid = this;
 
+  mPrefetchPool = nullptr;
+
   mUsingLiquid = (fds->type == FLUID_DOMAIN_TYPE_LIQUID);
   mUsingSmoke = (fds->type == FLUID_DOMAIN_TYPE_GAS);
   mUsingNoise = (fds->flags & FLUID_DOMAIN_USE_NOISE) && mUsingSmoke;
@@ -560,6 +563,11 @@ MANTA::~MANTA()
     cout << "~FLUID: " << mCurrentID << " with res(" << mResX << ", " << mResY << ", " << mResZ
          << ")" << endl;
 
+  if (mPrefetchPool) {
+    BLI_task_pool_cancel(mPrefetchPool);
+    BLI_task_pool_free(mPrefetchPool);
+  }
+
   /* Destruction string for Python. */
   string tmpString = "";
   vector<string> pythonCommands;
@@ -1275,6 +1283,10 @@ bool MANTA::readData(FluidModifierData *fmd, int framenr, bool resumable)
        << ", '" << volume_format << "', " << resumable_cache << ")";
     pythonCommands.push_back(ss.str());
     result &= runPythonString(pythonCommands);
+    if (result) {
+      prefetchFile(
+          getFile(fmd, FLUID_DOMAIN_DIR_DATA, FLUID_NAME_DATA, volume_format, framenr + 1));
+    }
     return (mSmokeFromFile = result);
   }
   if (mUsingLiquid) {
@@ -1283,6 +1295,10 @@ bool MANTA::readData(FluidModifierData *fmd, int framenr, bool resumable)
        << ", '" << volume_format << "', " << resumable_cache << ")";
     pythonCommands.push_back(ss.str());
     result &= runPythonString(pythonCommands);
+    if (result) {
+      prefetchFile(
+          getFile(fmd, FLUID_DOMAIN_DIR_DATA, FLUID_NAME_DATA, volume_format, framenr + 1));
+    }
     return (mFlipFromFile = result);
   }
   return result;
@@ -1317,7 +1333,12 @@ bool MANTA::readNoise(FluidModifierData *fmd, int framenr, bool resumable)
      << ", '" << volume_format << "', " << resumable_cache << ")";
   pythonCommands.push_back(ss.str());
 
-  return (mNoiseFromFile = runPythonString(pythonCommands));
+  mNoiseFromFile = runPythonString(pythonCommands);
+  if (mNoiseFromFile) {
+    prefetchFile(
+        getFile(fmd, FLUID_DOMAIN_DIR_NOISE, FLUID_NAME_NOISE, volume_format, framenr + 1));
+  }
+  return mNoiseFromFile;
 }
 
 bool MANTA::readMesh(FluidModifierData *fmd, int framenr)
@@ -1352,7 +1373,11 @@ bool MANTA::readMesh(FluidModifierData *fmd, int framenr)
     pythonCommands.push_back(ss.str());
   }
 
-  return (mMeshFromFile = runPythonString(pythonCommands));
+  mMeshFromFile = runPythonString(pythonCommands);
+  if (mMeshFromFile) {
+    prefetchFile(getFile(fmd, FLUID_DOMAIN_DIR_MESH, FLUID_NAME_MESH, mesh_format, framenr + 1));
+  }
+  return mMeshFromFile;
 }
 
 bool MANTA::readParticles(FluidModifierData *fmd, int framenr, bool resumable)
@@ -1386,7 +1411,12 @@ bool MANTA::readParticles(FluidModifierData *fmd, int framenr, bool resumable)
      << ", '" << volume_format << "', " << resumable_cache << ")";
   pythonCommands.push_back(ss.str());
 
-  return (mParticlesFromFile = runPythonString(pythonCommands));
+  mParticlesFromFile = runPythonString(pythonCommands);
+  if (mParticlesFromFile) {
+    prefetchFile(getFile(
+        fmd, FLUID_DOMAIN_DIR_PARTICLES, FLUID_NAME_PARTICLES, volume_format, framenr + 1));
+  }
+  return mParticlesFromFile;
 }
 
 bool MANTA::readGuiding(FluidModifierData *fmd, int framenr, bool sourceDomain)
@@ -2274,3 +2304,37 @@ string MANTA::getFile(
   BLI_path_frame(targetFile, framenr, 0);
   return targetFile;
 }
+
+static void prefetch_file_run(TaskPool *__restrict pool, void *taskdata)
+{
+  const string *file = static_cast<string *>(taskdata);
+  FILE *fp = BLI_fopen(file->c_str(), "rb");
+  if (!fp)
+    return;
+
+  /* Only bring the file into the file system cache, the data is read again by Mantaflow. */
+  const size_t chunk_size = 1 << 20;
+  char *buffer = (char *)MEM_mallocN(chunk_size, __func__);
+  while (!BLI_task_pool_current_canceled(pool) && fread(buffer, 1, chunk_size, fp) == chunk_size) {
+  }
+  MEM_freeN(buffer);
+  fclose(fp);
+}
+
+static void prefetch_file_free(TaskPool *__restrict /*pool*/, void *taskdata)
+{
+  delete static_cast<string *>(taskdata);
+}
+
+/**
+ * Read a cache file of an upcoming frame in the background, so that loading it when playing back
+ * the cache does not have to wait for the disk. Files that don't exist are skipped.
+ */
+void MANTA::prefetchFile(const string &file)
+{
+  if (mPrefetchPool == nullptr)
+    mPrefetchPool = BLI_task_pool_create_background_serial(nullptr, TASK_PRIORITY_LOW);
+
+  BLI_task_pool_push(
+      mPrefetchPool, prefetch_file_run, new string(file), false, prefetch_file_free);
+}
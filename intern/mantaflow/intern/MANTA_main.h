@@ -35,6 +35,8 @@ using std::string;
 using std::unordered_map;
 using std::vector;
 
+struct TaskPool;
+
 struct MANTA {
  public:
   MANTA(int *res, struct FluidModifierData *fmd);
@@ -868,6 +870,9 @@ struct MANTA {
   vector<pVel> *mParticleVelocity;
   vector<float> *mParticleLife;
 
+  /* Reads the cache files of the next frame in the background, see #prefetchFile(). */
+  struct TaskPool *mPrefetchPool;
+
   void initializeRNAMap(struct FluidModifierData *doRnaRefresh = nullptr);
   bool initDomain(struct FluidModifierData *doRnaRefresh = nullptr);
   bool initNoise(struct FluidModifierData *doRnaRefresh = nullptr);
@@ -886,6 +891,7 @@ struct MANTA {
                  string fname,
                  string extension,
                  int framenr);
+  void prefetchFile(const string &file);
 };
 
 #endif
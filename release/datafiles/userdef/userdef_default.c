@@ -112,6 +112,7 @@ const UserDef U_default = {
     .gp_euclideandist = 2,
     .gp_eraser = 25,
     .gp_settings = 0,
+    .geometry_nodes_cache_limit = 256,
 
     /** Initialized by: #BKE_studiolight_default. */
     .light_param = {{0}},
@@ -30,6 +30,7 @@ _modules = [
     "anim",
     "assets",
     "clip",
+    "composite_sequence",
     "console",
     "constraint",
     "file",
@@ -0,0 +1,117 @@
+# ##### BEGIN GPL LICENSE BLOCK #####
+#
+#  This program is free software; you can redistribute it and/or
+#  modify it under the terms of the GNU General Public License
+#  as published by the Free Software Foundation; either version 2
+#  of the License, or (at your option) any later version.
+#
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with this program; if not, write to the Free Software Foundation,
+#  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+#
+# ##### END GPL LICENSE BLOCK #####
+
+# <pep8-80 compliant>
+
+import bpy
+from bpy.types import Operator
+from bpy.props import IntProperty
+
+from bpy.app.translations import pgettext_tip as tip_
+
+
+class CompositeSequence(Operator):
+    """Composite the frames of the scene in several background Blender """ \
+        """processes at once, splitting threads between them"""
+    bl_idname = "render.composite_sequence"
+    bl_label = "Composite Sequence"
+
+    jobs: IntProperty(
+        name="Jobs",
+        description="Number of frames composited at the same time",
+        default=4,
+        min=1,
+        max=64,
+    )
+
+    def execute(self, context):
+        import subprocess
+        from shlex import quote
+
+        scene = context.scene
+        filepath = bpy.data.filepath
+        if not filepath or bpy.data.is_dirty:
+            self.report({'ERROR'}, "Save the file before compositing")
+            return {'CANCELLED'}
+
+        node_tree = scene.node_tree
+        if not scene.use_nodes or node_tree is None:
+            self.report({'ERROR'}, "Scene has no compositing nodes")
+            return {'CANCELLED'}
+
+        # Inputs must come from images, such as multilayer EXRs of a
+        # previous render, otherwise every job renders its frames.
+        for node in node_tree.nodes:
+            if node.type == 'R_LAYERS' and not node.mute:
+                self.report(
+                    {'ERROR'},
+                    tip_("Node %r renders the scene, use Image nodes instead")
+                    % node.name,
+                )
+                return {'CANCELLED'}
+
+        frame_start = scene.frame_start
+        frame_end = scene.frame_end
+        frame_step = scene.frame_step
+        num_frames = len(range(frame_start, frame_end + 1, frame_step))
+        jobs = min(self.jobs, num_frames)
+        if jobs == 0:
+            return {'CANCELLED'}
+
+        # Compositing a frame doesn't scale to all threads, running frames
+        # concurrently with fewer threads each uses them better.
+        threads = max(1, scene.render.threads // jobs)
+
+        processes = []
+        for job in range(jobs):
+            cmd = [
+                bpy.app.binary_path,
+                "--background", filepath,
+                "--scene", scene.name,
+                "--threads", str(threads),
+                "--frame-start", str(frame_start + job * frame_step),
+                "--frame-end", str(frame_end),
+                "--frame-jump", str(frame_step * jobs),
+                "--render-anim",
+            ]
+            print("Executing command:\n ", " ".join(quote(c) for c in cmd))
+            try:
+                processes.append(subprocess.Popen(cmd))
+            except Exception as ex:
+                self.report(
+                    {'ERROR'},
+                    tip_("Couldn't run Blender with command %r\n%s")
+                    % (cmd, ex),
+                )
+                break
+
+        failed = len(processes) != jobs
+        for process in processes:
+            if process.wait() != 0:
+                failed = True
+
+        if failed:
+            self.report({'ERROR'}, "Compositing of some frames failed")
+            return {'CANCELLED'}
+
+        return {'FINISHED'}
+
+
+classes = (
+    CompositeSequence,
+)
@@ -371,6 +371,9 @@ class RENDER_PT_encoding_video(RenderOutputButtonsPanel, Panel):
         if ffmpeg.codec == 'DNXHD':
             layout.prop(ffmpeg, "use_lossless_output")
 
+        if ffmpeg.codec == 'H264':
+            layout.prop(ffmpeg, "use_hardware_encoder")
+
         # Output quality
         use_crf = needs_codec and ffmpeg.codec in {'H264', 'MPEG4', 'WEBM'}
         if use_crf:
@@ -722,7 +722,7 @@ class NODE_PT_overlay(Panel):
         col.prop(overlay, "show_context_path", text="Context Path")
         col.prop(snode, "show_annotation", text="Annotations")
 
-        if snode.tree_type == 'GeometryNodeTree':
+        if snode.tree_type in {'GeometryNodeTree', 'CompositorNodeTree'}:
             col.separator()
             col.prop(overlay, "show_timing", text="Timings")
 
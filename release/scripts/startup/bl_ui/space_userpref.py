@@ -661,6 +661,15 @@ class USERPREF_PT_system_memory(SystemPanel, CenterAlignMixIn, Panel):
         col = layout.column()
         col.prop(system, "texture_time_out", text="Texture Time Out")
         col.prop(system, "texture_collection_rate", text="Garbage Collection Rate")
+        col.prop(system, "texture_memory_limit", text="Texture Memory Limit")
+
+        layout.separator()
+
+        col = layout.column()
+        col.prop(system, "use_geometry_nodes_cache")
+        sub = col.column()
+        sub.active = system.use_geometry_nodes_cache
+        sub.prop(system, "geometry_nodes_cache_limit", text="Limit")
 
         layout.separator()
 
@@ -678,6 +687,7 @@ class USERPREF_PT_system_video_sequencer(SystemPanel, CenterAlignMixIn, Panel):
         # edit = prefs.edit
 
         layout.prop(system, "memory_cache_limit")
+        layout.prop(system, "use_sequencer_cache_compression")
 
         layout.separator()
 
@@ -691,6 +701,7 @@ class USERPREF_PT_system_video_sequencer(SystemPanel, CenterAlignMixIn, Panel):
         layout.separator()
 
         layout.prop(system, "sequencer_proxy_setup")
+        layout.prop(system, "use_sequencer_hardware_decoding")
 
 
 # -----------------------------------------------------------------------------
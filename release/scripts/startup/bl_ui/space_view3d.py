@@ -5920,6 +5920,10 @@ class VIEW3D_PT_shading_options(Panel):
             row.active = not xray_active
             row.prop(shading, "use_dof", text="Depth of Field")
 
+            row = col.row()
+            row.active = not xray_active and not shading.show_shadows
+            row.prop(shading, "use_occlusion_culling")
+
         if shading.type in {'WIREFRAME', 'SOLID'}:
             row = layout.split()
             row.prop(shading, "show_object_outline")
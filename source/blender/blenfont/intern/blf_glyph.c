@@ -595,6 +595,12 @@ void blf_glyph_draw(FontBLF *font, GlyphCacheBLF *gc, GlyphBLF *g, float x, floa
       int w = font->tex_size_max;
       int h = bitmap_len / w + 1;
 
+      /* Grow geometrically: re-creating the texture uploads the whole bitmap again, growing it by
+       * a single row at a time did that for almost every new row of glyphs. */
+      if (gc->texture) {
+        h = max_ii(h, min_ii(GPU_texture_height(gc->texture) * 2, font->tex_size_max));
+      }
+
       gc->bitmap_len_alloc = w * h;
       gc->bitmap_result = MEM_reallocN(gc->bitmap_result, (size_t)gc->bitmap_len_alloc);
 
@@ -108,6 +108,12 @@ float BKE_brush_curve_strength_clamped(const struct Brush *br, float p, float le
  * Uses the brush curve control to find a strength value.
  */
 float BKE_brush_curve_strength(const struct Brush *br, float p, float len);
+/**
+ * Same as #BKE_brush_curve_strength for `count` distances at once,
+ * the curve preset is only dispatched once for all of them.
+ */
+void BKE_brush_curve_strength_array(
+    const struct Brush *br, const float *dists, int count, float len, float *r_strength);
 
 /* Sampling. */
 
@@ -319,6 +319,11 @@ void free_bvhtree_from_pointcloud(struct BVHTreeFromPointCloud *data);
 
 bool bvhcache_has_tree(const struct BVHCache *bvh_cache, const BVHTree *tree);
 struct BVHCache *bvhcache_init(void);
+/**
+ * Tag the cached trees as out of date after the mesh coordinates changed without changing its
+ * topology. Instead of being rebuilt, their bounds are refit the next time they are requested.
+ */
+void bvhcache_tag_coords_dirty(struct BVHCache *bvh_cache);
 /**
  * Frees a BVH-cache.
  */
@@ -75,6 +75,14 @@ typedef enum eCDAllocType {
   CD_REFERENCE = 3,
   /** Do a full copy of all layers, only allowed if source has same number of elements. */
   CD_DUPLICATE = 4,
+  /**
+   * Share the arrays of the source layers with reference counting instead of copying them,
+   * only allowed if source has same number of elements. Only generic attribute layers are
+   * shared, other layers are copied. Shared layers have to be made mutable with
+   * #CustomData_duplicate_referenced_layer or #CustomData_layer_ensure_unshared before writing,
+   * also in the source.
+   */
+  CD_SHARE = 5,
 } eCDAllocType;
 
 #define CD_TYPE_AS_MASK(_type) (CustomDataMask)((CustomDataMask)1 << (CustomDataMask)(_type))
@@ -264,6 +272,11 @@ bool CustomData_has_layer(const struct CustomData *data, int type);
 int CustomData_number_of_layers(const struct CustomData *data, int type);
 int CustomData_number_of_layers_typemask(const struct CustomData *data, CustomDataMask mask);
 
+/**
+ * Make the layer the only owner of its array, when it is shared with other layers, see
+ * #CD_SHARE.
+ */
+void CustomData_layer_ensure_unshared(struct CustomDataLayer *layer);
 /**
  * Duplicate data of a layer with flag NOFREE, and remove that flag.
  * \return the layer data.
@@ -109,6 +109,29 @@ void BKE_libblock_remap_locked(struct Main *bmain, void *old_idv, void *new_idv,
 void BKE_libblock_remap(struct Main *bmain, void *old_idv, void *new_idv, short remap_flags)
     ATTR_NONNULL(1, 2);
 
+/**
+ * Replace all references in given Main to each of the \a old_ids by the matching \a new_ids
+ * (if \a new_ids is NULL, it unlinks all \a old_ids).
+ *
+ * Unlike calling #BKE_libblock_remap_locked for each ID, the users of the old IDs are found from
+ * ID relations built once for the duration of the call, and updates affecting the whole Main
+ * database are only done once. This makes remapping or deleting many IDs linear instead of
+ * quadratic.
+ *
+ * \note New IDs must not be part of the old ones, since relations are not updated while
+ * remapping.
+ */
+void BKE_libblock_remap_multiple_locked(struct Main *bmain,
+                                        struct ID **old_ids,
+                                        struct ID **new_ids,
+                                        int ids_num,
+                                        short remap_flags) ATTR_NONNULL(1, 2);
+void BKE_libblock_remap_multiple(struct Main *bmain,
+                                 struct ID **old_ids,
+                                 struct ID **new_ids,
+                                 int ids_num,
+                                 short remap_flags) ATTR_NONNULL(1, 2);
+
 /**
  * Unlink given \a id from given \a bmain
  * (does not touch to indirect, i.e. library, usages of the ID).
@@ -112,6 +112,9 @@ typedef struct MainIDRelations {
 enum {
   /* Those bmain relations include pointers/usages from editors. */
   MAINIDRELATIONS_INCLUDE_UI = 1 << 0,
+  /* Those bmain relations include internal runtime pointers (like `ID.newid`), see
+   * #IDWALK_DO_INTERNAL_RUNTIME_POINTERS. */
+  MAINIDRELATIONS_INCLUDE_INTERNAL_RUNTIME_POINTERS = 1 << 1,
 };
 
 typedef struct Main {
@@ -214,6 +217,13 @@ void BKE_main_unlock(struct Main *bmain);
 /** Generate the mappings between used IDs and their users, and vice-versa. */
 void BKE_main_relations_create(struct Main *bmain, short flag);
 void BKE_main_relations_free(struct Main *bmain);
+/**
+ * Same as #BKE_main_relations_create, but the relations are not stored in `bmain->relations`,
+ * so that no other code relies on them while the caller modifies the Main database.
+ * They must be freed with #BKE_main_relations_free_detached.
+ */
+struct MainIDRelations *BKE_main_relations_create_detached(struct Main *bmain, short flag);
+void BKE_main_relations_free_detached(struct MainIDRelations *relations);
 /** Set or clear given `tag` in all relation entries of given `bmain`. */
 void BKE_main_relations_tag_set(struct Main *bmain, eMainIDRelationsEntryTags tag, bool value);
 
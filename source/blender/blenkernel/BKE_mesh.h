@@ -322,6 +322,11 @@ void BKE_mesh_vert_coords_apply_with_mat4(struct Mesh *mesh,
                                           const float (*vert_coords)[3],
                                           const float mat[4][4]);
 void BKE_mesh_vert_coords_apply(struct Mesh *mesh, const float (*vert_coords)[3]);
+/**
+ * Call after changing vertex positions in-place (without changing the topology), tags the
+ * derived data that depends on them, normals and cached BVH-trees, as out of date.
+ */
+void BKE_mesh_tag_coords_changed(struct Mesh *mesh);
 void BKE_mesh_vert_normals_apply(struct Mesh *mesh, const short (*vert_normals)[3]);
 
 /* *** mesh_tessellate.c *** */
@@ -371,6 +376,18 @@ void BKE_mesh_recalc_looptri_with_normals(const struct MLoop *mloop,
                                           int totpoly,
                                           struct MLoopTri *mlooptri,
                                           const float (*poly_normals)[3]);
+/**
+ * A version of #BKE_mesh_recalc_looptri which copies the triangles of n-gons from the
+ * tessellation of a mesh with the same topology instead of filling the polygons again
+ * (used to keep the tessellation of meshes which are only deformed).
+ */
+void BKE_mesh_recalc_looptri_with_reuse(const struct MLoop *mloop,
+                                        const struct MPoly *mpoly,
+                                        const struct MVert *mvert,
+                                        int totloop,
+                                        int totpoly,
+                                        struct MLoopTri *mlooptri,
+                                        const struct MLoopTri *looptri_reuse);
 
 /* *** mesh_normals.cc *** */
 
@@ -182,6 +182,10 @@ typedef struct Subdiv {
   struct OpenSubdiv_Evaluator *evaluator;
   /* Optional displacement evaluator. */
   struct SubdivDisplacement *displacement_evaluator;
+  /* Hash of the mesh the topology refiner was created from, see #BKE_subdiv_update_from_mesh.
+   * Allows to skip the comparison with the mesh when it did not change. */
+  uint64_t topology_hash;
+  bool has_topology_hash;
   /* Statistics for debugging. */
   SubdivStats stats;
 
@@ -36,9 +36,11 @@
 #include "DNA_scene_types.h"
 
 #include "BLI_array.h"
+#include "BLI_array.hh"
 #include "BLI_bitmap.h"
 #include "BLI_blenlib.h"
 #include "BLI_float2.hh"
+#include "BLI_hash_mm2a.h"
 #include "BLI_linklist.h"
 #include "BLI_math.h"
 #include "BLI_task.h"
@@ -75,6 +77,8 @@
 #include "DEG_depsgraph.h"
 #include "DEG_depsgraph_query.h"
 
+#include "RNA_access.h"
+
 #include "CLG_log.h"
 
 #ifdef WITH_OPENSUBDIV
@@ -909,6 +913,357 @@ static Mesh *modifier_modify_mesh_and_geometry_set(ModifierData *md,
   return mesh_output;
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Modifier Output Cache
+ *
+ * The leading constructive modifiers of a stack often only depend on the input mesh and their own
+ * settings, a subdivision surface on a mesh which is just transformed or animated through object
+ * properties is the common case. Their output is kept in the evaluated object and reused while
+ * the hash of the input and the settings is unchanged, so frame changes don't evaluate them again.
+ * \{ */
+
+struct ModifierCacheHash {
+  /* Two differently seeded hashes, to make false matches between evaluations unlikely. */
+  BLI_HashMurmur2A mm2[2];
+
+  ModifierCacheHash()
+  {
+    BLI_hash_mm2a_init(&mm2[0], 0);
+    BLI_hash_mm2a_init(&mm2[1], 0x9e3779b9);
+  }
+
+  void add(const void *data, const size_t len)
+  {
+    BLI_hash_mm2a_add(&mm2[0], (const unsigned char *)data, len);
+    BLI_hash_mm2a_add(&mm2[1], (const unsigned char *)data, len);
+  }
+
+  template<typename T> void add_value(const T &value)
+  {
+    this->add(&value, sizeof(T));
+  }
+
+  uint64_t end()
+  {
+    return ((uint64_t)BLI_hash_mm2a_end(&mm2[0]) << 32) | (uint64_t)BLI_hash_mm2a_end(&mm2[1]);
+  }
+};
+
+/**
+ * \return false if a layer stores data which can't be hashed, like multi-resolution displacements.
+ */
+static bool modifier_cache_hash_customdata(ModifierCacheHash &hash,
+                                           const CustomData *data,
+                                           const int totelem)
+{
+  hash.add_value(totelem);
+  hash.add_value(data->totlayer);
+  for (int i = 0; i < data->totlayer; i++) {
+    const CustomDataLayer *layer = &data->layers[i];
+    hash.add_value(layer->type);
+    hash.add_value(layer->active);
+    hash.add_value(layer->active_rnd);
+    hash.add_value(layer->active_clone);
+    hash.add_value(layer->active_mask);
+    hash.add(layer->name, strlen(layer->name));
+    if (layer->data == nullptr) {
+      continue;
+    }
+    if (layer->type == CD_MDEFORMVERT) {
+      const MDeformVert *dverts = (const MDeformVert *)layer->data;
+      for (int j = 0; j < totelem; j++) {
+        hash.add_value(dverts[j].totweight);
+        if (dverts[j].dw) {
+          hash.add(dverts[j].dw, sizeof(MDeformWeight) * (size_t)dverts[j].totweight);
+        }
+      }
+    }
+    else if (CustomData_layertype_is_dynamic(layer->type)) {
+      return false;
+    }
+    else {
+      hash.add(layer->data, (size_t)totelem * (size_t)CustomData_sizeof(layer->type));
+    }
+  }
+  return true;
+}
+
+static bool modifier_cache_hash_mesh(ModifierCacheHash &hash, const Mesh *mesh)
+{
+  hash.add_value(mesh->flag);
+  hash.add_value(mesh->cd_flag);
+  hash.add_value(mesh->smoothresh);
+  hash.add_value(mesh->totcol);
+  LISTBASE_FOREACH (const bDeformGroup *, dg, &mesh->vertex_group_names) {
+    hash.add(dg->name, strlen(dg->name));
+  }
+  return modifier_cache_hash_customdata(hash, &mesh->vdata, mesh->totvert) &&
+         modifier_cache_hash_customdata(hash, &mesh->edata, mesh->totedge) &&
+         modifier_cache_hash_customdata(hash, &mesh->ldata, mesh->totloop) &&
+         modifier_cache_hash_customdata(hash, &mesh->pdata, mesh->totpoly);
+}
+
+/**
+ * Hash the values of all RNA properties of \a ptr, nested structs included. Only the settings
+ * exposed to the user are hashed, run-time pointers and padding of the DNA struct are ignored.
+ *
+ * \return false if a setting can't be hashed, like a pointer to an ID.
+ */
+static bool modifier_cache_hash_rna(ModifierCacheHash &hash, PointerRNA *ptr, const int depth)
+{
+  /* Nested settings like curve profiles are shallow, deeper structs are likely cyclic. */
+  if (depth > 3) {
+    return false;
+  }
+  bool is_hashable = true;
+  RNA_STRUCT_BEGIN_SKIP_RNA_TYPE (ptr, prop) {
+    const PropertyType type = RNA_property_type(prop);
+    const int len = RNA_property_array_length(ptr, prop);
+    switch (type) {
+      case PROP_BOOLEAN: {
+        if (len > 0) {
+          blender::Array<bool> values(len);
+          RNA_property_boolean_get_array(ptr, prop, values.data());
+          hash.add(values.data(), sizeof(bool) * (size_t)len);
+        }
+        else {
+          hash.add_value(RNA_property_boolean_get(ptr, prop));
+        }
+        break;
+      }
+      case PROP_INT: {
+        if (len > 0) {
+          blender::Array<int> values(len);
+          RNA_property_int_get_array(ptr, prop, values.data());
+          hash.add(values.data(), sizeof(int) * (size_t)len);
+        }
+        else {
+          hash.add_value(RNA_property_int_get(ptr, prop));
+        }
+        break;
+      }
+      case PROP_FLOAT: {
+        if (len > 0) {
+          blender::Array<float> values(len);
+          RNA_property_float_get_array(ptr, prop, values.data());
+          hash.add(values.data(), sizeof(float) * (size_t)len);
+        }
+        else {
+          hash.add_value(RNA_property_float_get(ptr, prop));
+        }
+        break;
+      }
+      case PROP_ENUM:
+        hash.add_value(RNA_property_enum_get(ptr, prop));
+        break;
+      case PROP_STRING: {
+        char fixedbuf[256];
+        int str_len;
+        char *str = RNA_property_string_get_alloc(
+            ptr, prop, fixedbuf, sizeof(fixedbuf), &str_len);
+        hash.add_value(str_len);
+        hash.add(str, (size_t)str_len);
+        if (str != fixedbuf) {
+          MEM_freeN(str);
+        }
+        break;
+      }
+      case PROP_POINTER: {
+        PointerRNA nested_ptr = RNA_property_pointer_get(ptr, prop);
+        hash.add_value(nested_ptr.data != nullptr);
+        if (nested_ptr.data == nullptr) {
+          break;
+        }
+        if (RNA_struct_is_ID(nested_ptr.type) ||
+            !modifier_cache_hash_rna(hash, &nested_ptr, depth + 1)) {
+          is_hashable = false;
+        }
+        break;
+      }
+      case PROP_COLLECTION: {
+        hash.add_value(RNA_property_collection_length(ptr, prop));
+        RNA_PROP_BEGIN (ptr, item_ptr, prop) {
+          if (RNA_struct_is_ID(item_ptr.type) ||
+              !modifier_cache_hash_rna(hash, &item_ptr, depth + 1)) {
+            is_hashable = false;
+            break;
+          }
+        }
+        RNA_PROP_END;
+        break;
+      }
+    }
+    if (!is_hashable) {
+      break;
+    }
+  }
+  RNA_STRUCT_END;
+  return is_hashable;
+}
+
+static void modifier_cache_find_id_walk(void *user_data,
+                                        Object *UNUSED(ob),
+                                        ID **idpoin,
+                                        int UNUSED(cb_flag))
+{
+  if (*idpoin != nullptr) {
+    *(bool *)user_data = true;
+  }
+}
+
+/**
+ * Whether the modifier output only depends on its input mesh and its own settings.
+ */
+static bool modifier_output_is_cacheable(Scene *scene,
+                                         Object *ob,
+                                         ModifierData *md,
+                                         const ModifierTypeInfo *mti,
+                                         const int dag_eval_mode)
+{
+  if (mti->type == eModifierTypeType_OnlyDeform || mti->modifyMesh == nullptr ||
+      mti->modifyGeometrySet != nullptr) {
+    return false;
+  }
+  if (mti->flags & (eModifierTypeFlag_RequiresOriginalData | eModifierTypeFlag_UsesPointCache)) {
+    return false;
+  }
+  /* Modifiers which use run-time state outside of their settings. */
+  if (ELEM(md->type,
+           eModifierType_ParticleSystem,
+           eModifierType_Explode,
+           eModifierType_Multires,
+           eModifierType_DynamicPaint,
+           eModifierType_Fluid,
+           eModifierType_Ocean,
+           eModifierType_MeshSequenceCache)) {
+    return false;
+  }
+  if (BKE_modifier_depends_ontime(scene, md, dag_eval_mode)) {
+    return false;
+  }
+  if (mti->foreachIDLink) {
+    bool uses_id = false;
+    mti->foreachIDLink(md, ob, modifier_cache_find_id_walk, &uses_id);
+    if (uses_id) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Find the last of the leading modifiers starting at \a md whose output can be cached, and
+ * compute the key of their combined output in \a r_key.
+ *
+ * \return The last cached modifier, or null if there is nothing to cache.
+ */
+static ModifierData *modifier_cache_find_last(Scene *scene,
+                                              Object *ob,
+                                              const Mesh *mesh_input,
+                                              ModifierData *md,
+                                              CDMaskLink *md_datamask,
+                                              const CustomData_MeshMasks *final_datamask,
+                                              const bool use_deform,
+                                              const bool use_render,
+                                              const bool use_cache,
+                                              uint64_t *r_key)
+{
+  const int required_mode = use_render ? eModifierMode_Render : eModifierMode_Realtime;
+  const int dag_eval_mode = use_render ? DAG_EVAL_RENDER : DAG_EVAL_VIEWPORT;
+  ModifierCacheHash hash;
+  ModifierData *last_md = nullptr;
+
+  for (; md; md = md->next, md_datamask = md_datamask->next) {
+    const ModifierTypeInfo *mti = BKE_modifier_get_info((ModifierType)md->type);
+
+    if (!BKE_modifier_is_enabled(scene, md, required_mode)) {
+      continue;
+    }
+    if (mti->type == eModifierTypeType_OnlyDeform && !use_deform) {
+      continue;
+    }
+    if (!modifier_output_is_cacheable(scene, ob, md, mti, dag_eval_mode)) {
+      break;
+    }
+
+    /* Modifiers needing original coordinates are evaluated on an orco mesh in parallel. */
+    const CustomData_MeshMasks &nextmask = md_datamask->next ? md_datamask->next->mask :
+                                                               *final_datamask;
+    if ((md_datamask->mask.vmask | nextmask.vmask) & (CD_MASK_ORCO | CD_MASK_CLOTH_ORCO)) {
+      break;
+    }
+
+    /* Hashed separately, so that the key doesn't depend on a modifier which isn't cached. */
+    ModifierCacheHash md_hash;
+    PointerRNA md_ptr;
+    RNA_pointer_create(&ob->id, mti->srna, md, &md_ptr);
+    if (!modifier_cache_hash_rna(md_hash, &md_ptr, 0)) {
+      break;
+    }
+    hash.add_value(md->type);
+    hash.add_value(md_hash.end());
+    hash.add_value(md_datamask->mask);
+    hash.add_value(nextmask);
+    last_md = md;
+  }
+
+  if (last_md == nullptr) {
+    return nullptr;
+  }
+
+  hash.add_value(use_render);
+  hash.add_value(use_cache);
+  hash.add_value(ob->totcol);
+  hash.add_value(scene->r.mode & R_SIMPLIFY);
+  hash.add_value(scene->r.simplify_subsurf);
+  hash.add_value(scene->r.simplify_subsurf_render);
+  if (!modifier_cache_hash_mesh(hash, mesh_input)) {
+    return nullptr;
+  }
+
+  *r_key = hash.end();
+  return last_md;
+}
+
+static void modifier_cache_store(Object *ob,
+                                 ModifierData *first_md,
+                                 ModifierData *last_md,
+                                 const Mesh *mesh,
+                                 const uint64_t key)
+{
+  /* Errors are reported during evaluation, don't hide them by skipping it next time. */
+  for (ModifierData *md = first_md; md != last_md->next; md = md->next) {
+    if (md->error) {
+      return;
+    }
+  }
+  if (mesh->runtime.wrapper_type != ME_WRAPPER_TYPE_MDATA) {
+    return;
+  }
+  if (ob->runtime.mesh_modifier_cache) {
+    BKE_id_free(nullptr, ob->runtime.mesh_modifier_cache);
+  }
+  /* Self contained copy, the evaluated mesh keeps being modified by the following modifiers. */
+  ob->runtime.mesh_modifier_cache = BKE_mesh_copy_for_eval(mesh, false);
+  ob->runtime.mesh_modifier_cache_key = key;
+}
+
+/**
+ * Copy of the cached output. Generic attribute arrays are shared with the cache (see
+ * #CD_SHARE) and only copied by the modifiers which write to them, other layers are copied.
+ */
+static Mesh *modifier_cache_lookup(const Object *ob, const uint64_t key)
+{
+  const Mesh *mesh_cache = ob->runtime.mesh_modifier_cache;
+  if (mesh_cache == nullptr || ob->runtime.mesh_modifier_cache_key != key) {
+    return nullptr;
+  }
+  return (Mesh *)BKE_id_copy_ex(
+      nullptr, &mesh_cache->id, nullptr, LIB_ID_COPY_LOCALIZE | LIB_ID_COPY_CD_SHARE);
+}
+
+/** \} */
+
 static void mesh_calc_modifiers(struct Depsgraph *depsgraph,
                                 Scene *scene,
                                 Object *ob,
@@ -1050,6 +1405,37 @@ static void mesh_calc_modifiers(struct Depsgraph *depsgraph,
 
   /* Apply all remaining constructive and deforming modifiers. */
   bool have_non_onlydeform_modifiers_appled = false;
+
+  /* Reuse the output of the leading modifiers from the previous evaluation if possible. */
+  ModifierData *cache_first_md = md;
+  ModifierData *cache_last_md = nullptr;
+  uint64_t cache_key = 0;
+  if (md && deformed_verts == nullptr && index == -1 && !need_mapping && !sculpt_mode) {
+    cache_last_md = modifier_cache_find_last(scene,
+                                             ob,
+                                             mesh_input,
+                                             md,
+                                             md_datamask,
+                                             &final_datamask,
+                                             use_deform,
+                                             use_render,
+                                             use_cache,
+                                             &cache_key);
+  }
+  if (cache_last_md) {
+    mesh_final = modifier_cache_lookup(ob, cache_key);
+    if (mesh_final) {
+      mesh_final->runtime.deformed_only = false;
+      have_non_onlydeform_modifiers_appled = true;
+      /* Continue with the first modifier after the cached ones. */
+      while (md != cache_last_md->next) {
+        md = md->next;
+        md_datamask = md_datamask->next;
+      }
+      cache_last_md = nullptr;
+    }
+  }
+
   for (; md; md = md->next, md_datamask = md_datamask->next) {
     const ModifierTypeInfo *mti = BKE_modifier_get_info((ModifierType)md->type);
 
@@ -1304,11 +1690,19 @@ static void mesh_calc_modifiers(struct Depsgraph *depsgraph,
         append_mask.lmask |= CD_MASK_PREVIEW_MLOOPCOL;
       }
 
+      /* A subdivision delayed to the draw code leaves the mesh unchanged. */
+      mesh_final->runtime.subsurf_deformed_only = mesh_final->runtime.deformed_only &&
+                                                  md->type == eModifierType_Subsurf &&
+                                                  mesh_final->runtime.subsurf_resolution != 0;
       mesh_final->runtime.deformed_only = false;
     }
 
     isPrevDeform = (mti->type == eModifierTypeType_OnlyDeform);
 
+    if (md == cache_last_md) {
+      modifier_cache_store(ob, cache_first_md, cache_last_md, mesh_final, cache_key);
+    }
+
     /* grab modifiers until index i */
     if ((index != -1) && (BLI_findindex(&ob->modifiers, md) >= index)) {
       break;
@@ -1339,6 +1733,7 @@ static void mesh_calc_modifiers(struct Depsgraph *depsgraph,
     }
     else {
       mesh_final = BKE_mesh_copy_for_eval(mesh_input, true);
+      BKE_mesh_runtime_looptri_reuse_from(mesh_final, mesh_input);
     }
   }
   if (deformed_verts) {
@@ -1816,6 +2211,67 @@ static void mesh_runtime_check_normals_valid(const Mesh *mesh)
   BLI_assert(!(mesh->runtime.cd_dirty_poly & CD_MASK_NORMAL));
 }
 
+/**
+ * Whether the evaluated mesh is only deformed from the original mesh, as far as its GPU buffers
+ * are concerned. This is also the case when the subdivision is done by the draw code.
+ */
+static bool mesh_batch_cache_is_deformed_only(const Mesh *mesh_eval)
+{
+  return mesh_eval->runtime.deformed_only || mesh_eval->runtime.subsurf_deformed_only;
+}
+
+/**
+ * Take the previous evaluated mesh from the object when its GPU buffers might be reused for the
+ * next evaluation, see #mesh_batch_cache_reuse_for_deform.
+ */
+static Mesh *object_take_mesh_eval_for_batch_cache_reuse(Object *ob)
+{
+  ID *data_eval = ob->runtime.data_eval;
+  if (data_eval == nullptr || !ob->runtime.is_data_eval_owned || GS(data_eval->name) != ID_ME) {
+    return nullptr;
+  }
+  Mesh *mesh_eval = (Mesh *)data_eval;
+  if (mesh_eval->runtime.batch_cache == nullptr || !mesh_batch_cache_is_deformed_only(mesh_eval) ||
+      mesh_eval->runtime.subdiv_ccg != nullptr) {
+    return nullptr;
+  }
+  ob->runtime.data_eval = nullptr;
+  return mesh_eval;
+}
+
+/**
+ * When only deform modifiers changed the mesh since the last evaluation, its topology and all
+ * attributes except the positions are the same. Then most GPU buffers of the previous evaluated
+ * mesh are still valid, which avoids extracting and uploading them again during playback.
+ */
+static void mesh_batch_cache_reuse_for_deform(Mesh *mesh_eval_prev,
+                                              Mesh *mesh_eval,
+                                              const Mesh *mesh_input,
+                                              const bool data_mask_changed)
+{
+  if (data_mask_changed || !mesh_batch_cache_is_deformed_only(mesh_eval) ||
+      mesh_eval->runtime.batch_cache != nullptr) {
+    return;
+  }
+  /* GPU subdivision might have been enabled or disabled since the last evaluation. */
+  if (mesh_eval_prev->runtime.subsurf_deformed_only != mesh_eval->runtime.subsurf_deformed_only) {
+    return;
+  }
+  /* The evaluated mesh data-block is copied again when it has been changed. */
+  if (mesh_input->id.recalc & ID_RECALC_COPY_ON_WRITE) {
+    return;
+  }
+  if (mesh_eval_prev->totvert != mesh_eval->totvert ||
+      mesh_eval_prev->totedge != mesh_eval->totedge ||
+      mesh_eval_prev->totloop != mesh_eval->totloop ||
+      mesh_eval_prev->totpoly != mesh_eval->totpoly || mesh_eval_prev->totcol != mesh_eval->totcol) {
+    return;
+  }
+  mesh_eval->runtime.batch_cache = mesh_eval_prev->runtime.batch_cache;
+  mesh_eval_prev->runtime.batch_cache = nullptr;
+  BKE_mesh_batch_cache_dirty_tag(mesh_eval, BKE_MESH_BATCH_DIRTY_DEFORM);
+}
+
 static void mesh_build_data(struct Depsgraph *depsgraph,
                             Scene *scene,
                             Object *ob,
@@ -1828,6 +2284,12 @@ static void mesh_build_data(struct Depsgraph *depsgraph,
    * they aren't cleaned up properly on mode switch, causing crashes, e.g T58150. */
   BLI_assert(ob->id.tag & LIB_TAG_COPIED_ON_WRITE);
 
+  const bool data_mask_changed =
+      !CustomData_MeshMasks_are_matching(&ob->runtime.last_data_mask, dataMask) ||
+      !CustomData_MeshMasks_are_matching(dataMask, &ob->runtime.last_data_mask) ||
+      ob->runtime.last_need_mapping != need_mapping;
+  Mesh *mesh_eval_prev = object_take_mesh_eval_for_batch_cache_reuse(ob);
+
   BKE_object_free_derived_caches(ob);
   if (DEG_is_active(depsgraph)) {
     BKE_sculpt_update_object_before_eval(ob);
@@ -1865,6 +2327,12 @@ static void mesh_build_data(struct Depsgraph *depsgraph,
    * the final result might be freed prior to object). */
   Mesh *mesh = (Mesh *)ob->data;
   const bool is_mesh_eval_owned = (mesh_eval != mesh->runtime.mesh_eval);
+  if (mesh_eval_prev != nullptr) {
+    if (is_mesh_eval_owned) {
+      mesh_batch_cache_reuse_for_deform(mesh_eval_prev, mesh_eval, mesh, data_mask_changed);
+    }
+    BKE_mesh_eval_delete(mesh_eval_prev);
+  }
   BKE_object_eval_assign_data(ob, &mesh_eval->id, is_mesh_eval_owned);
 
   /* Add the final mesh as a non-owning component to the geometry set. */
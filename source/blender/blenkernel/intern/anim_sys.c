@@ -368,11 +368,11 @@ static bool is_fcurve_evaluatable(FCurve *fcu)
   return true;
 }
 
-bool BKE_animsys_rna_path_resolve(PointerRNA *ptr,
-                                  /* typically 'fcu->rna_path', 'fcu->array_index' */
-                                  const char *rna_path,
-                                  const int array_index,
-                                  PathResolvedRNA *r_result)
+/* Resolve the property of the path, without checking the array index. */
+static bool animsys_rna_path_resolve_property(PointerRNA *ptr,
+                                              const char *rna_path,
+                                              const int array_index,
+                                              PathResolvedRNA *r_result)
 {
   if (rna_path == NULL) {
     return false;
@@ -397,13 +397,22 @@ bool BKE_animsys_rna_path_resolve(PointerRNA *ptr,
     return false;
   }
 
+  return true;
+}
+
+/* Check the array index against the property resolved by #animsys_rna_path_resolve_property. */
+static bool animsys_rna_path_resolve_index(PointerRNA *ptr,
+                                           const char *rna_path,
+                                           const int array_index,
+                                           PathResolvedRNA *r_result)
+{
   int array_len = RNA_property_array_length(&r_result->ptr, r_result->prop);
   if (array_len && array_index >= array_len) {
     if (G.debug & G_DEBUG) {
       CLOG_WARN(&LOG,
                 "Animato: Invalid array index. ID = '%s',  '%s[%d]', array length is %d",
                 (ptr->owner_id) ? (ptr->owner_id->name + 2) : "<No ID>",
-                path,
+                rna_path,
                 array_index,
                 array_len - 1);
     }
@@ -414,6 +423,56 @@ bool BKE_animsys_rna_path_resolve(PointerRNA *ptr,
   return true;
 }
 
+bool BKE_animsys_rna_path_resolve(PointerRNA *ptr,
+                                  /* typically 'fcu->rna_path', 'fcu->array_index' */
+                                  const char *rna_path,
+                                  const int array_index,
+                                  PathResolvedRNA *r_result)
+{
+  if (!animsys_rna_path_resolve_property(ptr, rna_path, array_index, r_result)) {
+    return false;
+  }
+  return animsys_rna_path_resolve_index(ptr, rna_path, array_index, r_result);
+}
+
+/**
+ * The last path resolved for a list of F-Curves. The channels of one array property are stored
+ * next to each other, so their path only has to be parsed once.
+ */
+typedef struct AnimsysPathResolveCache {
+  const char *rna_path;
+  bool is_valid;
+  PathResolvedRNA resolved;
+} AnimsysPathResolveCache;
+
+static void animsys_path_resolve_cache_init(AnimsysPathResolveCache *cache)
+{
+  cache->rna_path = NULL;
+  cache->is_valid = false;
+}
+
+/* Version of #BKE_animsys_rna_path_resolve which reuses the previous result for the same path. */
+static bool animsys_rna_path_resolve_cached(PointerRNA *ptr,
+                                            const char *rna_path,
+                                            const int array_index,
+                                            AnimsysPathResolveCache *cache,
+                                            PathResolvedRNA *r_result)
+{
+  if (rna_path == NULL) {
+    return false;
+  }
+  if (cache->rna_path == NULL || !STREQ(cache->rna_path, rna_path)) {
+    cache->rna_path = rna_path;
+    cache->is_valid = animsys_rna_path_resolve_property(
+        ptr, rna_path, array_index, &cache->resolved);
+  }
+  if (!cache->is_valid) {
+    return false;
+  }
+  *r_result = cache->resolved;
+  return animsys_rna_path_resolve_index(ptr, rna_path, array_index, r_result);
+}
+
 /* less than 1.0 evaluates to false, use epsilon to avoid float error */
 #define ANIMSYS_FLOAT_AS_BOOL(value) ((value) > (1.0f - FLT_EPSILON))
 
@@ -571,7 +630,8 @@ static bool animsys_construct_orig_pointer_rna(const PointerRNA *ptr, PointerRNA
 static void animsys_write_orig_anim_rna(PointerRNA *ptr,
                                         const char *rna_path,
                                         int array_index,
-                                        float value)
+                                        float value,
+                                        AnimsysPathResolveCache *orig_cache)
 {
   PointerRNA ptr_orig;
   if (!animsys_construct_orig_pointer_rna(ptr, &ptr_orig)) {
@@ -579,7 +639,12 @@ static void animsys_write_orig_anim_rna(PointerRNA *ptr,
   }
   PathResolvedRNA orig_anim_rna;
   /* TODO(sergey): Should be possible to cache resolved path in dependency graph somehow. */
-  if (BKE_animsys_rna_path_resolve(&ptr_orig, rna_path, array_index, &orig_anim_rna)) {
+  const bool is_resolved = (orig_cache != NULL) ?
+                               animsys_rna_path_resolve_cached(
+                                   &ptr_orig, rna_path, array_index, orig_cache, &orig_anim_rna) :
+                               BKE_animsys_rna_path_resolve(
+                                   &ptr_orig, rna_path, array_index, &orig_anim_rna);
+  if (is_resolved) {
     BKE_animsys_write_to_rna_path(&orig_anim_rna, value);
   }
 }
@@ -594,6 +659,10 @@ static void animsys_evaluate_fcurves(PointerRNA *ptr,
                                      const AnimationEvalContext *anim_eval_context,
                                      bool flush_to_original)
 {
+  AnimsysPathResolveCache cache, orig_cache;
+  animsys_path_resolve_cache_init(&cache);
+  animsys_path_resolve_cache_init(&orig_cache);
+
   /* Calculate then execute each curve. */
   LISTBASE_FOREACH (FCurve *, fcu, list) {
 
@@ -602,11 +671,12 @@ static void animsys_evaluate_fcurves(PointerRNA *ptr,
     }
 
     PathResolvedRNA anim_rna;
-    if (BKE_animsys_rna_path_resolve(ptr, fcu->rna_path, fcu->array_index, &anim_rna)) {
+    if (animsys_rna_path_resolve_cached(
+            ptr, fcu->rna_path, fcu->array_index, &cache, &anim_rna)) {
       const float curval = calculate_fcurve(&anim_rna, fcu, anim_eval_context);
       BKE_animsys_write_to_rna_path(&anim_rna, curval);
       if (flush_to_original) {
-        animsys_write_orig_anim_rna(ptr, fcu->rna_path, fcu->array_index, curval);
+        animsys_write_orig_anim_rna(ptr, fcu->rna_path, fcu->array_index, curval, &orig_cache);
       }
     }
   }
@@ -838,12 +908,16 @@ void animsys_evaluate_action_group(PointerRNA *ptr,
     return;
   }
 
+  AnimsysPathResolveCache cache;
+  animsys_path_resolve_cache_init(&cache);
+
   /* calculate then execute each curve */
   for (fcu = agrp->channels.first; (fcu) && (fcu->grp == agrp); fcu = fcu->next) {
     /* check if this curve should be skipped */
     if ((fcu->flag & (FCURVE_MUTED | FCURVE_DISABLED)) == 0 && !BKE_fcurve_is_empty(fcu)) {
       PathResolvedRNA anim_rna;
-      if (BKE_animsys_rna_path_resolve(ptr, fcu->rna_path, fcu->array_index, &anim_rna)) {
+      if (animsys_rna_path_resolve_cached(
+              ptr, fcu->rna_path, fcu->array_index, &cache, &anim_rna)) {
         const float curval = calculate_fcurve(&anim_rna, fcu, anim_eval_context);
         BKE_animsys_write_to_rna_path(&anim_rna, curval);
       }
@@ -2440,6 +2514,9 @@ void nladata_flush_channels(PointerRNA *ptr,
     return;
   }
 
+  AnimsysPathResolveCache orig_cache;
+  animsys_path_resolve_cache_init(&orig_cache);
+
   /* for each channel with accumulated values, write its value on the property it affects */
   LISTBASE_FOREACH (NlaEvalChannel *, nec, &channels->channels) {
     /**
@@ -2463,7 +2540,7 @@ void nladata_flush_channels(PointerRNA *ptr,
         }
         BKE_animsys_write_to_rna_path(&rna, value);
         if (flush_to_original) {
-          animsys_write_orig_anim_rna(ptr, nec->rna_path, rna.prop_index, value);
+          animsys_write_orig_anim_rna(ptr, nec->rna_path, rna.prop_index, value, &orig_cache);
         }
       }
     }
@@ -3496,7 +3573,7 @@ void BKE_animsys_eval_driver(Depsgraph *depsgraph, ID *id, int driver_index, FCu
 
         /* Flush results & status codes to original data for UI (T59984) */
         if (ok && DEG_is_active(depsgraph)) {
-          animsys_write_orig_anim_rna(&id_ptr, fcu->rna_path, fcu->array_index, curval);
+          animsys_write_orig_anim_rna(&id_ptr, fcu->rna_path, fcu->array_index, curval, NULL);
 
           /* curval is displayed in the UI, and flag contains error-status codes */
           fcu_orig->curval = fcu->curval;
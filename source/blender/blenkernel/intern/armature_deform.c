@@ -258,6 +258,14 @@ typedef struct ArmatureUserdata {
   bPoseChannel **pchan_from_defbase;
   int defbase_len;
 
+  /**
+   * Bone influences of all vertices, resolved from the vertex groups once per evaluation.
+   * The influences of vertex `i` are in the range between `influence_offsets[i]` and
+   * `influence_offsets[i + 1]`. NULL when the vertex groups are read for every vertex instead.
+   */
+  int *influence_offsets;
+  struct ArmatureInfluence *influences;
+
   float premat[4][4];
   float postmat[4][4];
 
@@ -267,6 +275,174 @@ typedef struct ArmatureUserdata {
   } bmesh;
 } ArmatureUserdata;
 
+enum {
+  ARM_INFLUENCE_BBONE = (1 << 0),
+  ARM_INFLUENCE_MULT_ENVELOPE = (1 << 1),
+};
+
+/** A vertex group weight of a deforming bone, with the bone properties used by the deform. */
+typedef struct ArmatureInfluence {
+  bPoseChannel *pchan;
+  float weight;
+  int flag;
+} ArmatureInfluence;
+
+static const MDeformVert *armature_vert_dvert_get(const ArmatureUserdata *data, const int i)
+{
+  if (data->use_dverts || data->armature_def_nr != -1) {
+    if (data->me_target) {
+      BLI_assert(i < data->me_target->totvert);
+      if (data->me_target->dvert != NULL) {
+        return data->me_target->dvert + i;
+      }
+    }
+    else if (data->dverts && i < data->dverts_len) {
+      return data->dverts + i;
+    }
+  }
+  return NULL;
+}
+
+static int armature_vert_influences_count(const ArmatureUserdata *data, const MDeformVert *dvert)
+{
+  int count = 0;
+  if (dvert) {
+    for (int j = 0; j < dvert->totweight; j++) {
+      const uint index = dvert->dw[j].def_nr;
+      if (index < data->defbase_len && data->pchan_from_defbase[index]) {
+        count++;
+      }
+    }
+  }
+  return count;
+}
+
+static void armature_influences_count_task(void *__restrict userdata,
+                                           const int i,
+                                           const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  ArmatureUserdata *data = userdata;
+  data->influence_offsets[i + 1] = armature_vert_influences_count(
+      data, armature_vert_dvert_get(data, i));
+}
+
+static void armature_influences_fill_task(void *__restrict userdata,
+                                          const int i,
+                                          const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  ArmatureUserdata *data = userdata;
+  const MDeformVert *dvert = armature_vert_dvert_get(data, i);
+  ArmatureInfluence *influence = &data->influences[data->influence_offsets[i]];
+  if (dvert == NULL) {
+    return;
+  }
+  for (int j = 0; j < dvert->totweight; j++) {
+    const uint index = dvert->dw[j].def_nr;
+    bPoseChannel *pchan;
+    if (index < data->defbase_len && (pchan = data->pchan_from_defbase[index])) {
+      const Bone *bone = pchan->bone;
+      influence->pchan = pchan;
+      influence->weight = dvert->dw[j].weight;
+      influence->flag = 0;
+      if (bone->segments > 1 && pchan->runtime.bbone_segments == bone->segments) {
+        influence->flag |= ARM_INFLUENCE_BBONE;
+      }
+      if (bone->flag & BONE_MULT_VG_ENV) {
+        influence->flag |= ARM_INFLUENCE_MULT_ENVELOPE;
+      }
+      influence++;
+    }
+  }
+}
+
+/**
+ * Resolve the vertex group weights of all vertices to the deforming bones, so the per vertex
+ * deform only loops over a compact array without vertex group and bone lookups.
+ */
+static void armature_influences_build(ArmatureUserdata *data, const int vert_coords_len)
+{
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1024;
+
+  data->influence_offsets = MEM_malloc_arrayN(
+      (size_t)vert_coords_len + 1, sizeof(int), "armature influence offsets");
+  data->influence_offsets[0] = 0;
+  BLI_task_parallel_range(0, vert_coords_len, data, armature_influences_count_task, &settings);
+
+  for (int i = 0; i < vert_coords_len; i++) {
+    data->influence_offsets[i + 1] += data->influence_offsets[i];
+  }
+
+  const int influences_len = data->influence_offsets[vert_coords_len];
+  data->influences = MEM_malloc_arrayN(
+      (size_t)max_ii(influences_len, 1), sizeof(ArmatureInfluence), "armature influences");
+  BLI_task_parallel_range(0, vert_coords_len, data, armature_influences_fill_task, &settings);
+}
+
+/**
+ * Accumulate the influences of a vertex. For linear blending the matrices of bones without
+ * segments are blended first, so the coordinate is only transformed once.
+ */
+static void armature_vert_influences_deform(const ArmatureInfluence *influences,
+                                            const int influences_len,
+                                            const float co[3],
+                                            float vec[3],
+                                            DualQuat *dq,
+                                            float smat[3][3],
+                                            float *contrib)
+{
+  float summat[4][4];
+  float summat_weight = 0.0f;
+  if (dq == NULL) {
+    zero_m4(summat);
+  }
+
+  for (int j = 0; j < influences_len; j++) {
+    const ArmatureInfluence *influence = &influences[j];
+    bPoseChannel *pchan = influence->pchan;
+    float weight = influence->weight;
+
+    if (influence->flag & ARM_INFLUENCE_MULT_ENVELOPE) {
+      const Bone *bone = pchan->bone;
+      weight *= distfactor_to_bone(
+          co, bone->arm_head, bone->arm_tail, bone->rad_head, bone->rad_tail, bone->dist);
+    }
+    if (weight == 0.0f) {
+      continue;
+    }
+
+    if (influence->flag & ARM_INFLUENCE_BBONE) {
+      b_bone_deform(pchan, co, weight, vec, dq, smat);
+    }
+    else if (dq) {
+      add_weighted_dq_dq(dq, &pchan->runtime.deform_dual_quat, weight);
+    }
+    else {
+      const float(*mat)[4] = pchan->chan_mat;
+      for (int k = 0; k < 4; k++) {
+        madd_v3_v3fl(summat[k], mat[k], weight);
+      }
+      summat_weight += weight;
+    }
+
+    (*contrib) += weight;
+  }
+
+  if (summat_weight != 0.0f) {
+    float tmp[3];
+    mul_v3_m4v3(tmp, summat, co);
+    madd_v3_v3fl(tmp, co, -summat_weight);
+    add_v3_v3(vec, tmp);
+
+    if (smat) {
+      float tmpmat[3][3];
+      copy_m3_m4(tmpmat, summat);
+      add_m3_m3m3(smat, smat, tmpmat);
+    }
+  }
+}
+
 static void armature_vert_task_with_dvert(const ArmatureUserdata *data,
                                           const int i,
                                           const MDeformVert *dvert)
@@ -327,7 +503,23 @@ static void armature_vert_task_with_dvert(const ArmatureUserdata *data,
   /* Apply the object's matrix */
   mul_m4_v3(data->premat, co);
 
-  if (use_dverts && dvert && dvert->totweight) { /* use weight groups ? */
+  if (data->influence_offsets) {
+    const int start = data->influence_offsets[i];
+    const int influences_len = data->influence_offsets[i + 1] - start;
+    if (influences_len != 0) {
+      armature_vert_influences_deform(
+          &data->influences[start], influences_len, co, vec, dq, smat, &contrib);
+    }
+    /* If there are vertex-groups but not groups with bones (like for soft-body groups). */
+    else if (use_envelope) {
+      for (pchan = data->ob_arm->pose->chanbase.first; pchan; pchan = pchan->next) {
+        if (!(pchan->bone->flag & BONE_NO_DEFORM)) {
+          contrib += dist_bone_deform(pchan, vec, dq, smat, co);
+        }
+      }
+    }
+  }
+  else if (use_dverts && dvert && dvert->totweight) { /* use weight groups ? */
     const MDeformWeight *dw = dvert->dw;
     int deformed = 0;
     unsigned int j;
@@ -419,29 +611,7 @@ static void armature_vert_task(void *__restrict userdata,
                                const TaskParallelTLS *__restrict UNUSED(tls))
 {
   const ArmatureUserdata *data = userdata;
-  const MDeformVert *dvert;
-  if (data->use_dverts || data->armature_def_nr != -1) {
-    if (data->me_target) {
-      BLI_assert(i < data->me_target->totvert);
-      if (data->me_target->dvert != NULL) {
-        dvert = data->me_target->dvert + i;
-      }
-      else {
-        dvert = NULL;
-      }
-    }
-    else if (data->dverts && i < data->dverts_len) {
-      dvert = data->dverts + i;
-    }
-    else {
-      dvert = NULL;
-    }
-  }
-  else {
-    dvert = NULL;
-  }
-
-  armature_vert_task_with_dvert(data, i, dvert);
+  armature_vert_task_with_dvert(data, i, armature_vert_dvert_get(data, i));
 }
 
 static void armature_vert_task_editmesh(void *__restrict userdata,
@@ -609,10 +779,17 @@ static void armature_deform_coords_impl(const Object *ob_arm,
     }
   }
   else {
+    if (use_dverts) {
+      armature_influences_build(&data, vert_coords_len);
+    }
+
     TaskParallelSettings settings;
     BLI_parallel_range_settings_defaults(&settings);
     settings.min_iter_per_thread = 32;
     BLI_task_parallel_range(0, vert_coords_len, &data, armature_vert_task, &settings);
+
+    MEM_SAFE_FREE(data.influence_offsets);
+    MEM_SAFE_FREE(data.influences);
   }
 
   if (pchan_from_defbase) {
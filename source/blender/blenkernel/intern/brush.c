@@ -2464,6 +2464,82 @@ float BKE_brush_curve_strength(const Brush *br, float p, const float len)
   return strength;
 }
 
+void BKE_brush_curve_strength_array(
+    const Brush *br, const float *dists, const int count, const float len, float *r_strength)
+{
+  for (int i = 0; i < count; i++) {
+    r_strength[i] = 1.0f - dists[i] / len;
+  }
+
+  switch (br->curve_preset) {
+    case BRUSH_CURVE_CUSTOM:
+      for (int i = 0; i < count; i++) {
+        r_strength[i] = BKE_curvemapping_evaluateF(br->curve, 0, 1.0f - r_strength[i]);
+      }
+      break;
+    case BRUSH_CURVE_SHARP:
+      for (int i = 0; i < count; i++) {
+        const float p = r_strength[i];
+        r_strength[i] = p * p;
+      }
+      break;
+    case BRUSH_CURVE_SMOOTH:
+      for (int i = 0; i < count; i++) {
+        const float p = r_strength[i];
+        r_strength[i] = 3.0f * p * p - 2.0f * p * p * p;
+      }
+      break;
+    case BRUSH_CURVE_SMOOTHER:
+      for (int i = 0; i < count; i++) {
+        const float p = r_strength[i];
+        r_strength[i] = pow3f(p) * (p * (p * 6.0f - 15.0f) + 10.0f);
+      }
+      break;
+    case BRUSH_CURVE_ROOT:
+      for (int i = 0; i < count; i++) {
+        r_strength[i] = sqrtf(max_ff(r_strength[i], 0.0f));
+      }
+      break;
+    case BRUSH_CURVE_LIN:
+      break;
+    case BRUSH_CURVE_CONSTANT:
+      for (int i = 0; i < count; i++) {
+        r_strength[i] = 1.0f;
+      }
+      break;
+    case BRUSH_CURVE_SPHERE:
+      for (int i = 0; i < count; i++) {
+        const float p = r_strength[i];
+        r_strength[i] = sqrtf(max_ff(2 * p - p * p, 0.0f));
+      }
+      break;
+    case BRUSH_CURVE_POW4:
+      for (int i = 0; i < count; i++) {
+        const float p = r_strength[i];
+        r_strength[i] = p * p * p * p;
+      }
+      break;
+    case BRUSH_CURVE_INVSQUARE:
+      for (int i = 0; i < count; i++) {
+        const float p = r_strength[i];
+        r_strength[i] = p * (2.0f - p);
+      }
+      break;
+    default:
+      for (int i = 0; i < count; i++) {
+        r_strength[i] = 1.0f;
+      }
+      break;
+  }
+
+  /* Distances outside of the brush have no strength, whatever the curve is. */
+  for (int i = 0; i < count; i++) {
+    if (dists[i] >= len) {
+      r_strength[i] = 0.0f;
+    }
+  }
+}
+
 float BKE_brush_curve_strength_clamped(const Brush *br, float p, const float len)
 {
   float strength = BKE_brush_curve_strength(br, p, len);
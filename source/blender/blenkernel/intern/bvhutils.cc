@@ -21,6 +21,7 @@
  * \ingroup bke
  */
 
+#include <atomic>
 #include <cmath>
 #include <cstdio>
 #include <cstring>
@@ -47,8 +48,13 @@
  * \{ */
 
 struct BVHCacheItem {
-  bool is_filled;
-  BVHTree *tree;
+  bool is_filled = false;
+  /**
+   * Coordinates changed since the tree was built, its bounds have to be refit before use.
+   * Only cleared while the cache mutex is locked, after the refit.
+   */
+  std::atomic<bool> is_dirty = false;
+  BVHTree *tree = nullptr;
 };
 
 struct BVHCache {
@@ -127,7 +133,7 @@ bool bvhcache_has_tree(const BVHCache *bvh_cache, const BVHTree *tree)
 
 BVHCache *bvhcache_init()
 {
-  BVHCache *cache = MEM_cnew<BVHCache>(__func__);
+  BVHCache *cache = MEM_new<BVHCache>(__func__);
   BLI_mutex_init(&cache->mutex);
   return cache;
 }
@@ -147,6 +153,23 @@ static void bvhcache_insert(BVHCache *bvh_cache, BVHTree *tree, BVHCacheType typ
   item->is_filled = true;
 }
 
+void bvhcache_tag_coords_dirty(BVHCache *bvh_cache)
+{
+  if (bvh_cache == nullptr) {
+    return;
+  }
+  for (int index = 0; index < BVHTREE_MAX_ITEM; index++) {
+    /* Edit-mesh trees are built from the #BMesh, not from the mesh coordinates. */
+    if (ELEM(index, BVHTREE_FROM_EM_VERTS, BVHTREE_FROM_EM_EDGES, BVHTREE_FROM_EM_LOOPTRI)) {
+      continue;
+    }
+    BVHCacheItem *item = &bvh_cache->items[index];
+    if (item->is_filled && item->tree != nullptr) {
+      item->is_dirty.store(true, std::memory_order_release);
+    }
+  }
+}
+
 void bvhcache_free(BVHCache *bvh_cache)
 {
   for (int index = 0; index < BVHTREE_MAX_ITEM; index++) {
@@ -155,7 +178,7 @@ void bvhcache_free(BVHCache *bvh_cache)
     item->tree = nullptr;
   }
   BLI_mutex_end(&bvh_cache->mutex);
-  MEM_freeN(bvh_cache);
+  MEM_delete(bvh_cache);
 }
 
 /**
@@ -1421,15 +1444,159 @@ static BLI_bitmap *looptri_no_hidden_map_get(const MPoly *mpoly,
   return looptri_mask;
 }
 
+/**
+ * Recompute the bounds of a cached tree from the current mesh coordinates, keeping its topology.
+ * The leaves are visited in the same order they were inserted in by the `*_create_tree`
+ * functions, so this only works as long as the mesh topology did not change.
+ *
+ * \return false when the tree doesn't match the mesh anymore and has to be rebuilt.
+ */
+static bool bvhtree_refit_from_mesh(BVHTree *tree,
+                                    const Mesh *mesh,
+                                    const BVHCacheType bvh_cache_type)
+{
+  const MVert *vert = mesh->mvert;
+  BLI_bitmap *mask = nullptr;
+  int elem_len = 0;
+  int elem_active_len = -1;
+
+  switch (bvh_cache_type) {
+    case BVHTREE_FROM_VERTS:
+    case BVHTREE_FROM_LOOSEVERTS:
+      elem_len = mesh->totvert;
+      if (bvh_cache_type == BVHTREE_FROM_LOOSEVERTS) {
+        mask = loose_verts_map_get(
+            mesh->medge, mesh->totedge, mesh->mvert, elem_len, &elem_active_len);
+      }
+      break;
+    case BVHTREE_FROM_EDGES:
+    case BVHTREE_FROM_LOOSEEDGES:
+      elem_len = mesh->totedge;
+      if (bvh_cache_type == BVHTREE_FROM_LOOSEEDGES) {
+        mask = loose_edges_map_get(mesh->medge, elem_len, &elem_active_len);
+      }
+      break;
+    case BVHTREE_FROM_FACES:
+      elem_len = mesh->totface;
+      break;
+    case BVHTREE_FROM_LOOPTRI:
+    case BVHTREE_FROM_LOOPTRI_NO_HIDDEN:
+      elem_len = BKE_mesh_runtime_looptri_len(mesh);
+      if (bvh_cache_type == BVHTREE_FROM_LOOPTRI_NO_HIDDEN) {
+        mask = looptri_no_hidden_map_get(mesh->mpoly, elem_len, &elem_active_len);
+      }
+      break;
+    case BVHTREE_FROM_EM_VERTS:
+    case BVHTREE_FROM_EM_EDGES:
+    case BVHTREE_FROM_EM_LOOPTRI:
+    case BVHTREE_MAX_ITEM:
+      BLI_assert(false);
+      return false;
+  }
+
+  if (mask == nullptr) {
+    elem_active_len = elem_len;
+  }
+  if (BLI_bvhtree_get_len(tree) != elem_active_len) {
+    MEM_SAFE_FREE(mask);
+    return false;
+  }
+
+  const MLoopTri *looptri = ELEM(bvh_cache_type,
+                                 BVHTREE_FROM_LOOPTRI,
+                                 BVHTREE_FROM_LOOPTRI_NO_HIDDEN) ?
+                                BKE_mesh_runtime_looptri_ensure(mesh) :
+                                nullptr;
+  int leaf_index = 0;
+  for (int i = 0; i < elem_len; i++) {
+    if (mask && !BLI_BITMAP_TEST_BOOL(mask, i)) {
+      continue;
+    }
+    float co[4][3];
+    int co_len = 0;
+    switch (bvh_cache_type) {
+      case BVHTREE_FROM_VERTS:
+      case BVHTREE_FROM_LOOSEVERTS:
+        copy_v3_v3(co[0], vert[i].co);
+        co_len = 1;
+        break;
+      case BVHTREE_FROM_EDGES:
+      case BVHTREE_FROM_LOOSEEDGES:
+        copy_v3_v3(co[0], vert[mesh->medge[i].v1].co);
+        copy_v3_v3(co[1], vert[mesh->medge[i].v2].co);
+        co_len = 2;
+        break;
+      case BVHTREE_FROM_FACES: {
+        const MFace *face = &mesh->mface[i];
+        copy_v3_v3(co[0], vert[face->v1].co);
+        copy_v3_v3(co[1], vert[face->v2].co);
+        copy_v3_v3(co[2], vert[face->v3].co);
+        if (face->v4) {
+          copy_v3_v3(co[3], vert[face->v4].co);
+        }
+        co_len = face->v4 ? 4 : 3;
+        break;
+      }
+      default:
+        copy_v3_v3(co[0], vert[mesh->mloop[looptri[i].tri[0]].v].co);
+        copy_v3_v3(co[1], vert[mesh->mloop[looptri[i].tri[1]].v].co);
+        copy_v3_v3(co[2], vert[mesh->mloop[looptri[i].tri[2]].v].co);
+        co_len = 3;
+        break;
+    }
+    BLI_bvhtree_update_node(tree, leaf_index++, co[0], nullptr, co_len);
+  }
+  BLI_bvhtree_update_tree(tree);
+
+  MEM_SAFE_FREE(mask);
+  return true;
+}
+
+/**
+ * Refit the cached tree of the given type when the mesh coordinates changed since it was built,
+ * see #bvhcache_tag_coords_dirty. When refitting isn't possible the tree is removed from the
+ * cache, so the caller builds a new one.
+ *
+ * Trees are only tagged dirty while the mesh coordinates are modified, when no other thread can
+ * use the mesh. Afterwards every thread getting the tree from the cache waits here until the
+ * refit is done, so a tree is never traversed while it is refit.
+ */
+static void bvhcache_refit_if_dirty(BVHCache *bvh_cache,
+                                    const Mesh *mesh,
+                                    const BVHCacheType bvh_cache_type)
+{
+  if (bvh_cache == nullptr) {
+    return;
+  }
+  BVHCacheItem *item = &bvh_cache->items[bvh_cache_type];
+  /* Acquire ordering makes the refit tree visible when another thread cleared the tag. */
+  if (!item->is_dirty.load(std::memory_order_acquire)) {
+    return;
+  }
+  BLI_mutex_lock(&bvh_cache->mutex);
+  if (item->is_dirty.load(std::memory_order_relaxed)) {
+    if (!bvhtree_refit_from_mesh(item->tree, mesh, bvh_cache_type)) {
+      BLI_bvhtree_free(item->tree);
+      item->tree = nullptr;
+      item->is_filled = false;
+    }
+    item->is_dirty.store(false, std::memory_order_release);
+  }
+  BLI_mutex_unlock(&bvh_cache->mutex);
+}
+
 BVHTree *BKE_bvhtree_from_mesh_get(struct BVHTreeFromMesh *data,
                                    const struct Mesh *mesh,
                                    const BVHCacheType bvh_cache_type,
                                    const int tree_type)
 {
+  /* Account the cached trees and their data. */
+  MEM_CategoryScope mem_category(MEM_CATEGORY_BVH);
   BVHTree *tree = nullptr;
   BVHCache **bvh_cache_p = (BVHCache **)&mesh->runtime.bvh_cache;
   ThreadMutex *mesh_eval_mutex = (ThreadMutex *)mesh->runtime.eval_mutex;
 
+  bvhcache_refit_if_dirty(*bvh_cache_p, mesh, bvh_cache_type);
   const bool is_cached = bvhcache_find(bvh_cache_p, bvh_cache_type, &tree, nullptr, nullptr);
 
   if (is_cached && tree == nullptr) {
@@ -1611,6 +1778,7 @@ BVHTree *BKE_bvhtree_from_editmesh_get(BVHTreeFromEditMesh *data,
                                        BVHCache **bvh_cache_p,
                                        ThreadMutex *mesh_eval_mutex)
 {
+  MEM_CategoryScope mem_category(MEM_CATEGORY_BVH);
   BVHTree *tree = nullptr;
   bool is_cached = false;
 
@@ -87,21 +87,34 @@ void CurveEval::remove_splines(blender::IndexMask mask)
 
 void CurveEval::translate(const float3 &translation)
 {
-  for (SplinePtr &spline : this->splines()) {
-    spline->translate(translation);
-    spline->mark_cache_invalid();
-  }
+  blender::threading::parallel_for(splines_.index_range(), 128, [&](IndexRange range) {
+    for (const int i : range) {
+      splines_[i]->translate(translation);
+      splines_[i]->mark_cache_invalid();
+    }
+  });
 }
 
 void CurveEval::transform(const float4x4 &matrix)
 {
-  for (SplinePtr &spline : this->splines()) {
-    spline->transform(matrix);
-  }
+  blender::threading::parallel_for(splines_.index_range(), 128, [&](IndexRange range) {
+    for (const int i : range) {
+      splines_[i]->transform(matrix);
+    }
+  });
 }
 
 bool CurveEval::bounds_min_max(float3 &min, float3 &max, const bool use_evaluated) const
 {
+  if (use_evaluated) {
+    /* Evaluate all splines in parallel, the bounds are then combined from their caches. */
+    blender::threading::parallel_for(splines_.index_range(), 128, [&](IndexRange range) {
+      for (const int i : range) {
+        splines_[i]->evaluated_positions();
+      }
+    });
+  }
+
   bool have_minmax = false;
   for (const SplinePtr &spline : this->splines()) {
     if (spline->size()) {
@@ -115,11 +128,7 @@ bool CurveEval::bounds_min_max(float3 &min, float3 &max, const bool use_evaluate
 
 float CurveEval::total_length() const
 {
-  float length = 0.0f;
-  for (const SplinePtr &spline : this->splines()) {
-    length += spline->length();
-  }
-  return length;
+  return this->accumulated_spline_lengths().last();
 }
 
 int CurveEval::total_control_point_size() const
@@ -145,11 +154,19 @@ blender::Array<int> CurveEval::control_point_offsets() const
 
 blender::Array<int> CurveEval::evaluated_point_offsets() const
 {
+  /* Finding the evaluated size of a spline can require building its caches,
+   * so gather the sizes in parallel before accumulating them. */
   Array<int> offsets(splines_.size() + 1);
+  blender::threading::parallel_for(splines_.index_range(), 128, [&](IndexRange range) {
+    for (const int i : range) {
+      offsets[i] = splines_[i]->evaluated_points_size();
+    }
+  });
   int offset = 0;
   for (const int i : splines_.index_range()) {
+    const int size = offsets[i];
     offsets[i] = offset;
-    offset += splines_[i]->evaluated_points_size();
+    offset += size;
   }
   offsets.last() = offset;
   return offsets;
@@ -157,11 +174,18 @@ blender::Array<int> CurveEval::evaluated_point_offsets() const
 
 blender::Array<float> CurveEval::accumulated_spline_lengths() const
 {
+  /* Evaluating the spline lengths is the expensive part, do that in parallel. */
   Array<float> spline_lengths(splines_.size() + 1);
+  blender::threading::parallel_for(splines_.index_range(), 128, [&](IndexRange range) {
+    for (const int i : range) {
+      spline_lengths[i] = splines_[i]->length();
+    }
+  });
   float spline_length = 0.0f;
   for (const int i : splines_.index_range()) {
+    const float length = spline_lengths[i];
     spline_lengths[i] = spline_length;
-    spline_length += splines_[i]->length();
+    spline_length += length;
   }
   spline_lengths.last() = spline_length;
   return spline_lengths;
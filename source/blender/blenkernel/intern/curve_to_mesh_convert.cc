@@ -50,6 +50,7 @@ struct ResultInfo {
 };
 
 static void vert_extrude_to_mesh_data(const Spline &spline,
+                                      const VArray<float> &radii,
                                       const float3 profile_vert,
                                       MutableSpan<MVert> r_verts,
                                       MutableSpan<MEdge> r_edges,
@@ -74,7 +75,6 @@ static void vert_extrude_to_mesh_data(const Spline &spline,
   Span<float3> positions = spline.evaluated_positions();
   Span<float3> tangents = spline.evaluated_tangents();
   Span<float3> normals = spline.evaluated_normals();
-  VArray<float> radii = spline.interpolate_to_evaluated(spline.radii());
   for (const int i : IndexRange(eval_size)) {
     float4x4 point_matrix = float4x4::from_normalized_axis_data(
         positions[i], normals[i], tangents[i]);
@@ -93,6 +93,7 @@ static void mark_edges_sharp(MutableSpan<MEdge> edges)
 }
 
 static void spline_extrude_to_mesh_data(const ResultInfo &info,
+                                        const VArray<float> &radii,
                                         const bool fill_caps,
                                         MutableSpan<MVert> r_verts,
                                         MutableSpan<MEdge> r_edges,
@@ -103,6 +104,7 @@ static void spline_extrude_to_mesh_data(const ResultInfo &info,
   const Spline &profile = info.profile;
   if (info.profile_vert_len == 1) {
     vert_extrude_to_mesh_data(spline,
+                              radii,
                               profile.evaluated_positions()[0],
                               r_verts,
                               r_edges,
@@ -225,7 +227,6 @@ static void spline_extrude_to_mesh_data(const ResultInfo &info,
   Span<float3> normals = spline.evaluated_normals();
   Span<float3> profile_positions = profile.evaluated_positions();
 
-  VArray<float> radii = spline.interpolate_to_evaluated(spline.radii());
   for (const int i_ring : IndexRange(info.spline_vert_len)) {
     float4x4 point_matrix = float4x4::from_normalized_axis_data(
         positions[i_ring], normals[i_ring], tangents[i_ring]);
@@ -487,14 +488,11 @@ static void copy_curve_point_data_to_mesh_faces(const Span<T> src,
   }
 }
 
-static void copy_curve_point_attribute_to_mesh(const GSpan src,
+static void copy_curve_point_attribute_to_mesh(const GSpan interpolated,
                                                const ResultInfo &info,
                                                ResultAttributeData &dst)
 {
-  GVArray interpolated_gvarray = info.spline.interpolate_to_evaluated(src);
-  GSpan interpolated = interpolated_gvarray.get_internal_span();
-
-  attribute_math::convert_to_static_type(src.type(), [&](auto dummy) {
+  attribute_math::convert_to_static_type(interpolated.type(), [&](auto dummy) {
     using T = decltype(dummy);
     switch (dst.domain) {
       case ATTR_DOMAIN_POINT:
@@ -553,14 +551,11 @@ static void copy_profile_point_data_to_mesh_faces(const Span<T> src,
   }
 }
 
-static void copy_profile_point_attribute_to_mesh(const GSpan src,
+static void copy_profile_point_attribute_to_mesh(const GSpan interpolated,
                                                  const ResultInfo &info,
                                                  ResultAttributeData &dst)
 {
-  GVArray interpolated_gvarray = info.profile.interpolate_to_evaluated(src);
-  GSpan interpolated = interpolated_gvarray.get_internal_span();
-
-  attribute_math::convert_to_static_type(src.type(), [&](auto dummy) {
+  attribute_math::convert_to_static_type(interpolated.type(), [&](auto dummy) {
     using T = decltype(dummy);
     switch (dst.domain) {
       case ATTR_DOMAIN_POINT:
@@ -582,36 +577,52 @@ static void copy_profile_point_attribute_to_mesh(const GSpan src,
   });
 }
 
+/**
+ * Interpolate the point attributes of a spline that have a result attribute to its evaluated
+ * points, in the same order as the result attributes. This is done once for every spline rather
+ * than for every combination of curve and profile spline.
+ */
+static Vector<GVArray> interpolate_point_attributes_to_evaluated(
+    const Spline &spline, Span<std::optional<ResultAttributeData>> result_attributes)
+{
+  Vector<GVArray> interpolated;
+  if (result_attributes.is_empty()) {
+    return interpolated;
+  }
+  int i = 0;
+  spline.attributes.foreach_attribute(
+      [&](const AttributeIDRef &id, const AttributeMetaData &UNUSED(meta_data)) {
+        if (result_attributes[i]) {
+          interpolated.append(
+              spline.interpolate_to_evaluated(*spline.attributes.get_for_read(id)));
+        }
+        else {
+          interpolated.append({});
+        }
+        i++;
+        return true;
+      },
+      ATTR_DOMAIN_POINT);
+  return interpolated;
+}
+
 static void copy_point_domain_attributes_to_mesh(const ResultInfo &info,
+                                                 Span<GVArray> spline_point_data,
+                                                 Span<GVArray> profile_point_data,
                                                  ResultAttributes &attributes)
 {
-  if (!attributes.curve_point_attributes.is_empty()) {
-    int i = 0;
-    info.spline.attributes.foreach_attribute(
-        [&](const AttributeIDRef &id, const AttributeMetaData &UNUSED(meta_data)) {
-          if (attributes.curve_point_attributes[i]) {
-            copy_curve_point_attribute_to_mesh(*info.spline.attributes.get_for_read(id),
-                                               info,
-                                               *attributes.curve_point_attributes[i]);
-          }
-          i++;
-          return true;
-        },
-        ATTR_DOMAIN_POINT);
+  for (const int i : attributes.curve_point_attributes.index_range()) {
+    if (attributes.curve_point_attributes[i]) {
+      copy_curve_point_attribute_to_mesh(
+          spline_point_data[i].get_internal_span(), info, *attributes.curve_point_attributes[i]);
+    }
   }
-  if (!attributes.profile_point_attributes.is_empty()) {
-    int i = 0;
-    info.profile.attributes.foreach_attribute(
-        [&](const AttributeIDRef &id, const AttributeMetaData &UNUSED(meta_data)) {
-          if (attributes.profile_point_attributes[i]) {
-            copy_profile_point_attribute_to_mesh(*info.profile.attributes.get_for_read(id),
-                                                 info,
-                                                 *attributes.profile_point_attributes[i]);
-          }
-          i++;
-          return true;
-        },
-        ATTR_DOMAIN_POINT);
+  for (const int i : attributes.profile_point_attributes.index_range()) {
+    if (attributes.profile_point_attributes[i]) {
+      copy_profile_point_attribute_to_mesh(profile_point_data[i].get_internal_span(),
+                                           info,
+                                           *attributes.profile_point_attributes[i]);
+    }
   }
 }
 
@@ -712,12 +723,24 @@ Mesh *curve_to_mesh_sweep(const CurveEval &curve, const CurveEval &profile, cons
   mesh_component.replace(mesh, GeometryOwnershipType::Editable);
   ResultAttributes attributes = create_result_attributes(curve, profile, mesh_component);
 
+  /* The evaluated profile data is the same for every curve spline, so only interpolate it once. */
+  Array<Vector<GVArray>> profiles_point_data(profiles.size());
+  threading::parallel_for(profiles.index_range(), 128, [&](IndexRange profiles_range) {
+    for (const int i_profile : profiles_range) {
+      profiles_point_data[i_profile] = interpolate_point_attributes_to_evaluated(
+          *profiles[i_profile], attributes.profile_point_attributes);
+    }
+  });
+
   threading::parallel_for(curves.index_range(), 128, [&](IndexRange curves_range) {
     for (const int i_spline : curves_range) {
       const Spline &spline = *curves[i_spline];
       if (spline.evaluated_points_size() == 0) {
         continue;
       }
+      const VArray<float> radii = spline.interpolate_to_evaluated(spline.radii());
+      const Vector<GVArray> spline_point_data = interpolate_point_attributes_to_evaluated(
+          spline, attributes.curve_point_attributes);
       const int spline_start_index = i_spline * profiles.size();
       threading::parallel_for(profiles.index_range(), 128, [&](IndexRange profiles_range) {
         for (const int i_profile : profiles_range) {
@@ -737,13 +760,15 @@ Mesh *curve_to_mesh_sweep(const CurveEval &curve, const CurveEval &profile, cons
           };
 
           spline_extrude_to_mesh_data(info,
+                                      radii,
                                       fill_caps,
                                       {mesh->mvert, mesh->totvert},
                                       {mesh->medge, mesh->totedge},
                                       {mesh->mloop, mesh->totloop},
                                       {mesh->mpoly, mesh->totpoly});
 
-          copy_point_domain_attributes_to_mesh(info, attributes);
+          copy_point_domain_attributes_to_mesh(
+              info, spline_point_data, profiles_point_data[i_profile], attributes);
         }
       });
     }
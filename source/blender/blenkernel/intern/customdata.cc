@@ -24,6 +24,9 @@
  * \ingroup bke
  */
 
+#include <atomic>
+#include <mutex>
+
 #include "MEM_guardedalloc.h"
 
 /* Since we have versioning code here (CustomData_verify_versions()). */
@@ -2098,6 +2101,112 @@ void customData_mask_layers__print(const CustomData_MeshMasks *mask)
 /********************* CustomData functions *********************/
 static void customData_update_offsets(CustomData *data);
 
+/**
+ * Reference counted ownership of a layer array that is shared by multiple layers, see #CD_SHARE.
+ * Every layer pointing to it holds one user.
+ */
+struct CustomDataSharingInfo {
+  std::atomic<int> users;
+  int type;
+  /** Number of elements, needed to free the array when the last user releases it. */
+  int totelem;
+};
+
+/* Protects the sharing info of layers and its user count, which can be changed from multiple
+ * threads when multiple dependency graphs copy or free copies of the same original data. */
+static std::mutex customdata_sharing_mutex;
+
+/**
+ * Only generic attribute layers are shared. Those are only written through the attribute API and
+ * RNA, which make them mutable first. Other layers like vertices or masks are written in place
+ * by many code paths (normals, sculpting, ...), which would then write to the other copies.
+ */
+static bool customData_layer_type_is_shareable(const int type)
+{
+  return ELEM(type, CD_PROP_FLOAT, CD_PROP_FLOAT2, CD_PROP_FLOAT3, CD_PROP_INT32, CD_PROP_BOOL);
+}
+
+/* Add a user to the sharing info of the layer, creating it if the layer wasn't shared yet. */
+static CustomDataSharingInfo *customData_layer_sharing_add_user(CustomDataLayer *layer,
+                                                                const int totelem)
+{
+  std::lock_guard lock{customdata_sharing_mutex};
+  if (layer->sharing_info == nullptr) {
+    layer->sharing_info = MEM_new<CustomDataSharingInfo>(__func__);
+    layer->sharing_info->users = 1;
+    layer->sharing_info->type = layer->type;
+    layer->sharing_info->totelem = totelem;
+  }
+  layer->sharing_info->users.fetch_add(1);
+  return layer->sharing_info;
+}
+
+/* Remove the user of the shared array held by the layer, freeing the array when it was the last
+ * user. */
+static void customData_layer_sharing_release(CustomDataLayer *layer)
+{
+  CustomDataSharingInfo *sharing_info;
+  bool is_last_user;
+  {
+    std::lock_guard lock{customdata_sharing_mutex};
+    sharing_info = layer->sharing_info;
+    layer->sharing_info = nullptr;
+    is_last_user = sharing_info->users.fetch_sub(1) == 1;
+  }
+  if (!is_last_user) {
+    return;
+  }
+  if (layer->data) {
+    const LayerTypeInfo *typeInfo = layerType_getInfo(sharing_info->type);
+    if (typeInfo->free) {
+      typeInfo->free(layer->data, sharing_info->totelem, typeInfo->size);
+    }
+    MEM_freeN(layer->data);
+  }
+  MEM_delete(sharing_info);
+}
+
+/**
+ * Make the layer the sole owner of its array, copying the array when other layers still use it.
+ */
+static void customData_layer_sharing_ensure_unshared(CustomDataLayer *layer)
+{
+  {
+    std::lock_guard lock{customdata_sharing_mutex};
+    CustomDataSharingInfo *sharing_info = layer->sharing_info;
+    if (sharing_info->users.load() == 1) {
+      /* Other layers can only start sharing the array while holding the lock. */
+      layer->sharing_info = nullptr;
+      MEM_delete(sharing_info);
+      layer->flag &= ~CD_FLAG_NOFREE;
+      return;
+    }
+  }
+
+  /* The user held by this layer keeps the shared array alive while copying it. */
+  const LayerTypeInfo *typeInfo = layerType_getInfo(layer->type);
+  const int totelem = layer->sharing_info->totelem;
+  void *shared_data = layer->data;
+  void *data;
+  if (typeInfo->copy) {
+    data = MEM_malloc_arrayN((size_t)totelem, typeInfo->size, "CD unshare layer");
+    typeInfo->copy(shared_data, data, totelem);
+  }
+  else {
+    data = MEM_dupallocN(shared_data);
+  }
+  customData_layer_sharing_release(layer);
+  layer->data = data;
+  layer->flag &= ~CD_FLAG_NOFREE;
+}
+
+void CustomData_layer_ensure_unshared(CustomDataLayer *layer)
+{
+  if (layer->sharing_info) {
+    customData_layer_sharing_ensure_unshared(layer);
+  }
+}
+
 static CustomDataLayer *customData_add_layer__internal(CustomData *data,
                                                        int type,
                                                        eCDAllocType alloctype,
@@ -2182,6 +2291,7 @@ bool CustomData_merge(const struct CustomData *source,
       case CD_ASSIGN:
       case CD_REFERENCE:
       case CD_DUPLICATE:
+      case CD_SHARE:
         data = layer->data;
         break;
       default:
@@ -2193,6 +2303,17 @@ bool CustomData_merge(const struct CustomData *source,
       newlayer = customData_add_layer__internal(
           dest, type, CD_REFERENCE, data, totelem, layer->name);
     }
+    else if (alloctype == CD_SHARE) {
+      /* Plain references are not owned by the source, so their lifetime is unknown. */
+      const bool can_share = data && customData_layer_type_is_shareable(type) &&
+                             (!(flag & CD_FLAG_NOFREE) || layer->sharing_info);
+      newlayer = customData_add_layer__internal(
+          dest, type, can_share ? CD_REFERENCE : CD_DUPLICATE, data, totelem, layer->name);
+      if (newlayer && can_share) {
+        newlayer->sharing_info = customData_layer_sharing_add_user(
+            const_cast<CustomDataLayer *>(layer), totelem);
+      }
+    }
     else {
       newlayer = customData_add_layer__internal(dest, type, alloctype, data, totelem, layer->name);
     }
@@ -2223,6 +2344,9 @@ void CustomData_realloc(CustomData *data, int totelem)
   for (int i = 0; i < data->totlayer; i++) {
     CustomDataLayer *layer = &data->layers[i];
     const LayerTypeInfo *typeInfo;
+    if (layer->sharing_info) {
+      customData_layer_sharing_ensure_unshared(layer);
+    }
     if (layer->flag & CD_FLAG_NOFREE) {
       continue;
     }
@@ -2254,6 +2378,10 @@ static void customData_free_layer__internal(CustomDataLayer *layer, int totelem)
     BKE_anonymous_attribute_id_decrement_weak(layer->anonymous_id);
     layer->anonymous_id = nullptr;
   }
+  if (layer->sharing_info) {
+    customData_layer_sharing_release(layer);
+    return;
+  }
   if (!(layer->flag & CD_FLAG_NOFREE) && layer->data) {
     typeInfo = layerType_getInfo(layer->type);
 
@@ -2567,6 +2695,7 @@ static CustomDataLayer *customData_add_layer__internal(CustomData *data,
   /* Passing a layer-data to copy from with an alloctype that won't copy is
    * most likely a bug */
   BLI_assert(!layerdata || ELEM(alloctype, CD_ASSIGN, CD_DUPLICATE, CD_REFERENCE));
+  BLI_assert(alloctype != CD_SHARE);
 
   if (!typeInfo->defaultname && CustomData_has_layer(data, type)) {
     return &data->layers[CustomData_get_layer_index(data, type)];
@@ -2830,7 +2959,12 @@ static void *customData_duplicate_referenced_layer_index(CustomData *data,
 
   CustomDataLayer *layer = &data->layers[layer_index];
 
-  if (layer->flag & CD_FLAG_NOFREE) {
+  if (layer->sharing_info) {
+    /* Also when this layer is the original owner of the shared array, the caller is going to
+     * modify it, which must not be visible in the other layers. */
+    customData_layer_sharing_ensure_unshared(layer);
+  }
+  else if (layer->flag & CD_FLAG_NOFREE) {
     /* MEM_dupallocN won't work in case of complex layers, like e.g.
      * CD_MDEFORMVERT, which has pointers to allocated data...
      * So in case a custom copy function is defined, use it!
@@ -5186,6 +5320,7 @@ void CustomData_blend_read(BlendDataReader *reader, CustomData *data, int count)
     }
 
     layer->flag &= ~CD_FLAG_NOFREE;
+    layer->sharing_info = nullptr;
 
     if (CustomData_verify_versions(data, i)) {
       BLO_read_data_address(reader, &layer->data);
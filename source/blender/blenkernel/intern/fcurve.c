@@ -29,6 +29,8 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "atomic_ops.h"
+
 #include "DNA_anim_types.h"
 #include "DNA_object_types.h"
 #include "DNA_text_types.h"
@@ -1725,6 +1727,20 @@ static float fcurve_eval_keyframes_extrapolate(
   return endpoint_bezt->vec[1][1] - (fac * dx);
 }
 
+/* Check whether the eval-time is strictly inside the segment and not at either keyframe. */
+static bool fcurve_eval_segment_contains(const BezTriple *bezts,
+                                         const int totvert,
+                                         const int segment,
+                                         const float evaltime,
+                                         const float threshold)
+{
+  if (segment < 0 || segment + 1 >= totvert) {
+    return false;
+  }
+  return (evaltime - bezts[segment].vec[1][0] > threshold) &&
+         (bezts[segment + 1].vec[1][0] - evaltime > threshold);
+}
+
 static float fcurve_eval_keyframes_interpolate(FCurve *fcu, BezTriple *bezts, float evaltime)
 {
   const float eps = 1.e-8f;
@@ -1744,9 +1760,34 @@ static float fcurve_eval_keyframes_interpolate(FCurve *fcu, BezTriple *bezts, fl
    *   Weird errors, like selecting the wrong keyframe range (see T39207), occur.
    *   This lower bound was established in b888a32eee8147b028464336ad2404d8155c64dd.
    */
-  a = BKE_fcurve_bezt_binarysearch_index_ex(bezts, evaltime, fcu->totvert, 0.0001, &exact);
+  const float threshold = 0.0001f;
+
+  /* Playback evaluates the curve in the same or the next segment as last time, test those before
+   * searching. The binary search returns the end keyframe of the segment when the eval-time is not
+   * within the threshold of any keyframe.
+   *
+   * The same curve can be evaluated from multiple threads, e.g. for several depsgraphs. The hint
+   * is only used to choose where to search, so any value stored by another thread gives the right
+   * result, but it has to be accessed atomically. */
+  const int hint = atomic_load_int32(&fcu->eval_segment_hint);
+  if (fcurve_eval_segment_contains(bezts, fcu->totvert, hint, evaltime, threshold)) {
+    a = hint + 1;
+  }
+  else if (fcurve_eval_segment_contains(bezts, fcu->totvert, hint + 1, evaltime, threshold)) {
+    a = hint + 2;
+  }
+  else {
+    a = BKE_fcurve_bezt_binarysearch_index_ex(bezts, evaltime, fcu->totvert, threshold, &exact);
+  }
   bezt = bezts + a;
 
+  /* Store the start of the segment, the keyframe itself when the eval-time is on top of it. Only
+   * write when it changed, to avoid contention between threads evaluating the same curve. */
+  const int new_hint = (exact || a == 0) ? a : a - 1;
+  if (new_hint != hint) {
+    atomic_store_int32(&fcu->eval_segment_hint, new_hint);
+  }
+
   if (exact) {
     /* Index returned must be interpreted differently when it sits on top of an existing keyframe
      * - That keyframe is the start of the segment we need (see action_bug_2.blend in T39207).
@@ -2350,6 +2391,8 @@ void BKE_fcurve_blend_read_data(BlendDataReader *reader, ListBase *fcurves)
      */
     fcu->flag &= ~FCURVE_DISABLED;
 
+    fcu->eval_segment_hint = 0;
+
     /* driver */
     BLO_read_data_address(reader, &fcu->driver);
     if (fcu->driver) {
@@ -17,6 +17,8 @@
  */
 #include "testing/testing.h"
 
+#include <algorithm>
+
 #include "MEM_guardedalloc.h"
 
 #include "BKE_fcurve.h"
@@ -61,6 +63,30 @@ TEST(evaluate_fcurve, OnKeys)
   BKE_fcurve_free(fcu);
 }
 
+TEST(evaluate_fcurve, SegmentHint)
+{
+  FCurve *fcu = BKE_fcurve_create();
+
+  for (int i = 1; i <= 5; i++) {
+    insert_vert_fcurve(fcu, float(i), 2.0f * i, BEZT_KEYTYPE_KEYFRAME, INSERTKEY_NO_USERPREF);
+    fcu->bezt[i - 1].ipo = BEZT_IPO_LIN;
+  }
+
+  /* The hint left by a previous evaluation (possibly in another thread) must never change the
+   * result, whatever its value. */
+  const int hints[] = {-3, 0, 1, 2, 3, 4, 5, 100};
+  const float times[] = {0.5f, 1.0f, 1.5f, 2.0f, 2.5f, 3.0f, 4.75f, 5.0f, 6.0f};
+  for (const int hint : hints) {
+    for (const float time : times) {
+      fcu->eval_segment_hint = hint;
+      const float expected = 2.0f * std::clamp(time, 1.0f, 5.0f);
+      EXPECT_NEAR(evaluate_fcurve(fcu, time), expected, EPSILON) << "hint " << hint;
+    }
+  }
+
+  BKE_fcurve_free(fcu);
+}
+
 TEST(evaluate_fcurve, InterpolationConstant)
 {
   FCurve *fcu = BKE_fcurve_create();
@@ -21,6 +21,8 @@
  * \ingroup bke
  */
 
+#include <algorithm>
+
 #include "MEM_guardedalloc.h"
 
 #include "BLI_bitmap.h"
@@ -28,6 +30,7 @@
 #include "BLI_linklist.h"
 #include "BLI_listbase.h"
 #include "BLI_threads.h"
+#include "BLI_vector.hh"
 
 #include "DNA_image_types.h"
 #include "DNA_userdef_types.h"
@@ -609,11 +612,70 @@ void BKE_image_free_anim_gputextures(Main *bmain)
   }
 }
 
+static size_t image_gpu_memory_size(const Image *ima)
+{
+  size_t size = 0;
+  for (int eye = 0; eye < 2; eye++) {
+    for (int i = 0; i < TEXTARGET_COUNT; i++) {
+      for (int resolution = 0; resolution < IMA_TEXTURE_RESOLUTION_LEN; resolution++) {
+        if (ima->gputexture[i][eye][resolution] != nullptr) {
+          size += GPU_texture_memory_size_get(ima->gputexture[i][eye][resolution]);
+        }
+      }
+    }
+  }
+  return size;
+}
+
+/**
+ * Free the textures of the least recently used images until the textures of all images fit in
+ * the memory limit. Images used in the current second are kept, as they are likely needed for the
+ * next redraw.
+ */
+static void image_free_gputextures_over_limit(Main *bmain, const int ctime)
+{
+  const size_t limit = size_t(U.texmemlimit) * 1024 * 1024;
+
+  struct ImageMemory {
+    Image *ima;
+    size_t size;
+  };
+  blender::Vector<ImageMemory> candidates;
+  size_t total_size = 0;
+  LISTBASE_FOREACH (Image *, ima, &bmain->images) {
+    const size_t size = image_gpu_memory_size(ima);
+    total_size += size;
+    if (size > 0 && (ima->flag & IMA_NOCOLLECT) == 0 && ima->lastused < ctime) {
+      candidates.append({ima, size});
+    }
+  }
+  if (total_size <= limit) {
+    return;
+  }
+
+  std::sort(candidates.begin(), candidates.end(), [](const ImageMemory &a, const ImageMemory &b) {
+    return a.ima->lastused < b.ima->lastused;
+  });
+  for (const ImageMemory &candidate : candidates) {
+    if (total_size <= limit) {
+      break;
+    }
+    BKE_image_free_gputextures(candidate.ima);
+    total_size -= candidate.size;
+  }
+}
+
 void BKE_image_free_old_gputextures(Main *bmain)
 {
   static int lasttime = 0;
   int ctime = (int)PIL_check_seconds_timer();
 
+  /* The memory limit is checked on every redraw, so that textures of images that are not
+   * displayed anymore are freed before new ones are uploaded. */
+  if (U.texmemlimit != 0 && !G.is_rendering) {
+    image_free_gputextures_over_limit(bmain, ctime);
+  }
+
   /*
    * Run garbage collector once for every collecting period of time
    * if textimeout is 0, that's the option to NOT run the collector
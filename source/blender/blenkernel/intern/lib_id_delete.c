@@ -230,6 +230,11 @@ static size_t id_delete(Main *bmain, const bool do_tagged_deletion)
      * containing thousands of those.
      * This also means that we have to be very careful here, as we by-pass many 'common'
      * processing, hence risking to 'corrupt' at least user counts, if not IDs themselves. */
+    /* Each pass remaps all of its removed IDs at once, finding their users from ID relations
+     * instead of walking over the whole Main database for each deleted ID. */
+    ID **remapped_ids = NULL;
+    int remapped_ids_len = 0;
+
     bool keep_looping = true;
     while (keep_looping) {
       ID *id, *id_next;
@@ -260,24 +265,41 @@ static size_t id_delete(Main *bmain, const bool do_tagged_deletion)
         dummy_link.next = tagged_deleted_ids.first;
         last_remapped_id = (ID *)(&dummy_link);
       }
+      remapped_ids_len = 0;
+      for (id = last_remapped_id->next; id; id = id->next) {
+        remapped_ids_len++;
+      }
+      if (remapped_ids_len == 0) {
+        continue;
+      }
+      remapped_ids = MEM_reallocN_id(
+          remapped_ids, sizeof(*remapped_ids) * (size_t)remapped_ids_len, __func__);
+      remapped_ids_len = 0;
       for (id = last_remapped_id->next; id; id = id->next) {
-        /* Will tag 'never NULL' users of this ID too.
-         * Note that we cannot use BKE_libblock_unlink() here,
-         * since it would ignore indirect (and proxy!)
-         * links, this can lead to nasty crashing here in second, actual deleting loop.
-         * Also, this will also flag users of deleted data that cannot be unlinked
-         * (object using deleted obdata, etc.), so that they also get deleted. */
-        BKE_libblock_remap_locked(bmain,
-                                  id,
-                                  NULL,
-                                  (ID_REMAP_FLAG_NEVER_NULL_USAGE |
-                                   ID_REMAP_FORCE_NEVER_NULL_USAGE |
-                                   ID_REMAP_FORCE_INTERNAL_RUNTIME_POINTERS));
+        remapped_ids[remapped_ids_len++] = id;
+      }
+
+      /* Will tag 'never NULL' users of these IDs too.
+       * Note that we cannot use BKE_libblock_unlink() here,
+       * since it would ignore indirect (and proxy!)
+       * links, this can lead to nasty crashing here in second, actual deleting loop.
+       * Also, this will also flag users of deleted data that cannot be unlinked
+       * (object using deleted obdata, etc.), so that they also get deleted. */
+      BKE_libblock_remap_multiple_locked(bmain,
+                                         remapped_ids,
+                                         NULL,
+                                         remapped_ids_len,
+                                         (ID_REMAP_FLAG_NEVER_NULL_USAGE |
+                                          ID_REMAP_FORCE_NEVER_NULL_USAGE |
+                                          ID_REMAP_FORCE_INTERNAL_RUNTIME_POINTERS));
+      for (int i = 0; i < remapped_ids_len; i++) {
         /* Since we removed ID from Main,
          * we also need to unlink its own other IDs usages ourself. */
-        BKE_libblock_relink_ex(bmain, id, NULL, NULL, ID_REMAP_FORCE_INTERNAL_RUNTIME_POINTERS);
+        BKE_libblock_relink_ex(
+            bmain, remapped_ids[i], NULL, NULL, ID_REMAP_FORCE_INTERNAL_RUNTIME_POINTERS);
       }
     }
+    MEM_SAFE_FREE(remapped_ids);
 
     /* Now we can safely mark that ID as not being in Main database anymore. */
     /* NOTE: This needs to be done in a separate loop than above, otherwise some usercounts of
@@ -1867,6 +1867,29 @@ static int lib_override_libraries_index_define(Main *bmain)
   return library_indirect_level_max;
 }
 
+/** Find which levels of indirect usage of libraries contain at least one override hierarchy.
+ *
+ * Levels without any can skip the whole detection and resync process, which otherwise has to
+ * build the relations of the whole Main and walk all existing override hierarchies. */
+static bool *lib_override_libraries_index_used_get(Main *bmain,
+                                                   const int library_indirect_level_max)
+{
+  bool *library_indirect_levels_used = MEM_calloc_arrayN(
+      (size_t)library_indirect_level_max + 1, sizeof(*library_indirect_levels_used), __func__);
+  ID *id;
+  FOREACH_MAIN_ID_BEGIN (bmain, id) {
+    if (!ID_IS_OVERRIDE_LIBRARY_REAL(id) ||
+        (id->override_library->flag & IDOVERRIDE_LIBRARY_FLAG_NO_HIERARCHY) != 0) {
+      continue;
+    }
+    const int library_indirect_level = ID_IS_LINKED(id) ? id->lib->temp_index : 0;
+    BLI_assert(library_indirect_level <= library_indirect_level_max);
+    library_indirect_levels_used[library_indirect_level] = true;
+  }
+  FOREACH_MAIN_ID_END;
+  return library_indirect_levels_used;
+}
+
 void BKE_lib_override_library_main_resync(Main *bmain,
                                           Scene *scene,
                                           ViewLayer *view_layer,
@@ -1893,16 +1916,27 @@ void BKE_lib_override_library_main_resync(Main *bmain,
   BKE_layer_collection_resync_forbid();
 
   int library_indirect_level = lib_override_libraries_index_define(bmain);
+  bool *library_indirect_levels_used = lib_override_libraries_index_used_get(
+      bmain, library_indirect_level);
   while (library_indirect_level >= 0) {
     /* Update overrides from each indirect level separately. */
-    lib_override_library_main_resync_on_library_indirect_level(bmain,
-                                                               scene,
-                                                               view_layer,
-                                                               override_resync_residual_storage,
-                                                               library_indirect_level,
-                                                               reports);
+    if (library_indirect_levels_used[library_indirect_level]) {
+      lib_override_library_main_resync_on_library_indirect_level(bmain,
+                                                                 scene,
+                                                                 view_layer,
+                                                                 override_resync_residual_storage,
+                                                                 library_indirect_level,
+                                                                 reports);
+    }
+    else {
+      CLOG_INFO(&LOG,
+                3,
+                "Skipping resync of indirect level %d, it has no override hierarchy",
+                library_indirect_level);
+    }
     library_indirect_level--;
   }
+  MEM_freeN(library_indirect_levels_used);
 
   BKE_layer_collection_resync_allow();
 
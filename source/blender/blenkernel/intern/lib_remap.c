@@ -22,6 +22,7 @@
 
 #include "CLG_log.h"
 
+#include "BLI_ghash.h"
 #include "BLI_utildefines.h"
 
 #include "DNA_collection_types.h"
@@ -377,21 +378,19 @@ static void libblock_remap_data_postprocess_nodetree_update(Main *bmain, ID *new
  * \param r_id_remap_data: if non-NULL, the IDRemap struct to use
  * (uselful to retrieve info about remapping process).
  */
-ATTR_NONNULL(1)
-static void libblock_remap_data(
-    Main *bmain, ID *id, ID *old_id, ID *new_id, const short remap_flags, IDRemap *r_id_remap_data)
+static int libblock_remap_foreach_id_flags(const short remap_flags)
 {
-  IDRemap id_remap_data;
-  const int foreach_id_flags = ((remap_flags & ID_REMAP_NO_INDIRECT_PROXY_DATA_USAGE) != 0 ?
-                                    IDWALK_NO_INDIRECT_PROXY_DATA_USAGE :
-                                    IDWALK_NOP) |
-                               ((remap_flags & ID_REMAP_FORCE_INTERNAL_RUNTIME_POINTERS) != 0 ?
-                                    IDWALK_DO_INTERNAL_RUNTIME_POINTERS :
-                                    IDWALK_NOP);
+  return ((remap_flags & ID_REMAP_NO_INDIRECT_PROXY_DATA_USAGE) != 0 ?
+              IDWALK_NO_INDIRECT_PROXY_DATA_USAGE :
+              IDWALK_NOP) |
+         ((remap_flags & ID_REMAP_FORCE_INTERNAL_RUNTIME_POINTERS) != 0 ?
+              IDWALK_DO_INTERNAL_RUNTIME_POINTERS :
+              IDWALK_NOP);
+}
 
-  if (r_id_remap_data == NULL) {
-    r_id_remap_data = &id_remap_data;
-  }
+static void libblock_remap_data_init(
+    IDRemap *r_id_remap_data, Main *bmain, ID *old_id, ID *new_id, const short remap_flags)
+{
   r_id_remap_data->bmain = bmain;
   r_id_remap_data->old_id = old_id;
   r_id_remap_data->new_id = new_id;
@@ -401,40 +400,24 @@ static void libblock_remap_data(
   r_id_remap_data->skipped_direct = 0;
   r_id_remap_data->skipped_indirect = 0;
   r_id_remap_data->skipped_refcounted = 0;
+}
 
-  if (id) {
-#ifdef DEBUG_PRINT
-    printf("\tchecking id %s (%p, %p)\n", id->name, id, id->lib);
-#endif
-    r_id_remap_data->id_owner = id;
-    libblock_remap_data_preprocess(r_id_remap_data);
-    BKE_library_foreach_ID_link(
-        NULL, id, foreach_libblock_remap_callback, (void *)r_id_remap_data, foreach_id_flags);
-  }
-  else {
-    /* Note that this is a very 'brute force' approach,
-     * maybe we could use some depsgraph to only process objects actually using given old_id...
-     * sounds rather unlikely currently, though, so this will do for now. */
-    ID *id_curr;
+static void libblock_remap_data_owner(IDRemap *id_remap_data,
+                                      ID *id_owner,
+                                      const int foreach_id_flags)
+{
+  id_remap_data->id_owner = id_owner;
+  libblock_remap_data_preprocess(id_remap_data);
+  BKE_library_foreach_ID_link(
+      NULL, id_owner, foreach_libblock_remap_callback, (void *)id_remap_data, foreach_id_flags);
+}
 
-    FOREACH_MAIN_ID_BEGIN (bmain, id_curr) {
-      if (BKE_library_id_can_use_idtype(id_curr, GS(old_id->name))) {
-        /* Note that we cannot skip indirect usages of old_id here (if requested),
-         * we still need to check it for the user count handling...
-         * XXX No more true (except for debug usage of those skipping counters). */
-        r_id_remap_data->id_owner = id_curr;
-        libblock_remap_data_preprocess(r_id_remap_data);
-        BKE_library_foreach_ID_link(NULL,
-                                    id_curr,
-                                    foreach_libblock_remap_callback,
-                                    (void *)r_id_remap_data,
-                                    foreach_id_flags);
-      }
-    }
-    FOREACH_MAIN_ID_END;
-  }
+static void libblock_remap_data_finalize(IDRemap *id_remap_data)
+{
+  ID *old_id = id_remap_data->old_id;
+  ID *new_id = id_remap_data->new_id;
 
-  if ((remap_flags & ID_REMAP_SKIP_USER_CLEAR) == 0) {
+  if ((id_remap_data->flag & ID_REMAP_SKIP_USER_CLEAR) == 0) {
     /* XXX We may not want to always 'transfer' fake-user from old to new id...
      *     Think for now it's desired behavior though,
      *     we can always add an option (flag) to control this later if needed. */
@@ -447,7 +430,7 @@ static void libblock_remap_data(
   }
 
   if (new_id && (new_id->tag & LIB_TAG_INDIRECT) &&
-      (r_id_remap_data->status & ID_REMAP_IS_LINKED_DIRECT)) {
+      (id_remap_data->status & ID_REMAP_IS_LINKED_DIRECT)) {
     new_id->tag &= ~LIB_TAG_INDIRECT;
     new_id->flag &= ~LIB_INDIRECT_WEAK_LINK;
     new_id->tag |= LIB_TAG_EXTERN;
@@ -456,25 +439,153 @@ static void libblock_remap_data(
 #ifdef DEBUG_PRINT
   printf("%s: %d occurrences skipped (%d direct and %d indirect ones)\n",
          __func__,
-         r_id_remap_data->skipped_direct + r_id_remap_data->skipped_indirect,
-         r_id_remap_data->skipped_direct,
-         r_id_remap_data->skipped_indirect);
+         id_remap_data->skipped_direct + id_remap_data->skipped_indirect,
+         id_remap_data->skipped_direct,
+         id_remap_data->skipped_indirect);
 #endif
 }
 
-void BKE_libblock_remap_locked(Main *bmain, void *old_idv, void *new_idv, const short remap_flags)
+/**
+ * Execute the 'data' part of the remapping (that is, all ID pointers from other ID data-blocks).
+ *
+ * Behavior differs depending on whether given \a id is NULL or not:
+ * - \a id NULL: \a old_id must be non-NULL, \a new_id may be NULL (unlinking \a old_id) or not
+ *   (remapping \a old_id to \a new_id).
+ *   The whole \a bmain database is checked, and all pointers to \a old_id
+ *   are remapped to \a new_id.
+ * - \a id is non-NULL:
+ *   + If \a old_id is NULL, \a new_id must also be NULL,
+ *     and all ID pointers from \a id are cleared
+ *     (i.e. \a id does not references any other data-block anymore).
+ *   + If \a old_id is non-NULL, behavior is as with a NULL \a id, but only within given \a id.
+ *
+ * \param bmain: the Main data storage to operate on (must never be NULL).
+ * \param id: the data-block to operate on
+ * (can be NULL, in which case we operate over all IDs from given bmain).
+ * \param old_id: the data-block to dereference (may be NULL if \a id is non-NULL).
+ * \param new_id: the new data-block to replace \a old_id references with (may be NULL).
+ * \param r_id_remap_data: if non-NULL, the IDRemap struct to use
+ * (uselful to retrieve info about remapping process).
+ */
+ATTR_NONNULL(1)
+static void libblock_remap_data(
+    Main *bmain, ID *id, ID *old_id, ID *new_id, const short remap_flags, IDRemap *r_id_remap_data)
 {
   IDRemap id_remap_data;
-  ID *old_id = old_idv;
-  ID *new_id = new_idv;
-  int skipped_direct, skipped_refcounted;
+  const int foreach_id_flags = libblock_remap_foreach_id_flags(remap_flags);
 
-  BLI_assert(old_id != NULL);
-  BLI_assert((new_id == NULL) || GS(old_id->name) == GS(new_id->name));
-  BLI_assert(old_id != new_id);
+  if (r_id_remap_data == NULL) {
+    r_id_remap_data = &id_remap_data;
+  }
+  libblock_remap_data_init(r_id_remap_data, bmain, old_id, new_id, remap_flags);
 
-  libblock_remap_data(bmain, NULL, old_id, new_id, remap_flags, &id_remap_data);
+  if (id) {
+#ifdef DEBUG_PRINT
+    printf("\tchecking id %s (%p, %p)\n", id->name, id, id->lib);
+#endif
+    libblock_remap_data_owner(r_id_remap_data, id, foreach_id_flags);
+  }
+  else {
+    /* Note that this is a very 'brute force' approach, see #libblock_remap_data_from_relations for
+     * remapping many IDs at once. */
+    ID *id_curr;
+
+    FOREACH_MAIN_ID_BEGIN (bmain, id_curr) {
+      if (BKE_library_id_can_use_idtype(id_curr, GS(old_id->name))) {
+        /* Note that we cannot skip indirect usages of old_id here (if requested),
+         * we still need to check it for the user count handling...
+         * XXX No more true (except for debug usage of those skipping counters). */
+        libblock_remap_data_owner(r_id_remap_data, id_curr, foreach_id_flags);
+      }
+    }
+    FOREACH_MAIN_ID_END;
+  }
+
+  libblock_remap_data_finalize(r_id_remap_data);
+}
+
+/**
+ * Get the ID owning given \a id, as stored in \a relations, when it is an embedded one (like root
+ * node-trees or master collections).
+ */
+static ID *libblock_remap_relations_owner_get(MainIDRelations *relations, ID *id)
+{
+  while (id != NULL && (id->flag & LIB_EMBEDDED_DATA) != 0) {
+    MainIDRelationsEntry *entry = BLI_ghash_lookup(relations->relations_from_pointers, id);
+    ID *id_owner = NULL;
+    for (MainIDRelationsEntryItem *from_id_entry = entry != NULL ? entry->from_ids : NULL;
+         from_id_entry != NULL;
+         from_id_entry = from_id_entry->next) {
+      if (from_id_entry->usage_flag & IDWALK_CB_EMBEDDED) {
+        id_owner = from_id_entry->id_pointer.from;
+        break;
+      }
+    }
+    id = id_owner;
+  }
+  return id;
+}
+
+/**
+ * Same as #libblock_remap_data with a NULL \a id, but only processes the IDs using \a old_id
+ * according to \a relations, instead of the whole \a bmain database.
+ *
+ * Pointers cleared by previous remappings are still listed in \a relations, they are skipped
+ * by #foreach_libblock_remap_callback. Pointers to \a old_id added since the relations were
+ * built are not found.
+ */
+static void libblock_remap_data_from_relations(Main *bmain,
+                                               MainIDRelations *relations,
+                                               ID *old_id,
+                                               ID *new_id,
+                                               const short remap_flags,
+                                               IDRemap *r_id_remap_data)
+{
+  const int foreach_id_flags = libblock_remap_foreach_id_flags(remap_flags);
+
+  libblock_remap_data_init(r_id_remap_data, bmain, old_id, new_id, remap_flags);
+
+  MainIDRelationsEntry *entry = BLI_ghash_lookup(relations->relations_from_pointers, old_id);
+  if (entry != NULL) {
+    /* An ID may use `old_id` several times, or through several of its embedded IDs, use the
+     * processed tag to only walk over it once. */
+    for (int pass = 0; pass < 2; pass++) {
+      for (MainIDRelationsEntryItem *from_id_entry = entry->from_ids; from_id_entry != NULL;
+           from_id_entry = from_id_entry->next) {
+        ID *id_owner = libblock_remap_relations_owner_get(relations,
+                                                          from_id_entry->id_pointer.from);
+        if (id_owner == NULL) {
+          continue;
+        }
+        MainIDRelationsEntry *owner_entry = BLI_ghash_lookup(relations->relations_from_pointers,
+                                                             id_owner);
+        BLI_assert(owner_entry != NULL);
+        if (pass == 1) {
+          owner_entry->tags &= ~MAINIDRELATIONS_ENTRY_TAGS_PROCESSED;
+          continue;
+        }
+        if (owner_entry->tags & MAINIDRELATIONS_ENTRY_TAGS_PROCESSED) {
+          continue;
+        }
+        owner_entry->tags |= MAINIDRELATIONS_ENTRY_TAGS_PROCESSED;
+        libblock_remap_data_owner(r_id_remap_data, id_owner, foreach_id_flags);
+      }
+    }
+  }
 
+  libblock_remap_data_finalize(r_id_remap_data);
+}
+
+/**
+ * Post-processing of a remapping from \a old_id to \a new_id which only affects those two IDs
+ * (and the objects using \a new_id as obdata).
+ */
+static void libblock_remap_id_postprocess(Main *bmain,
+                                          ID *old_id,
+                                          ID *new_id,
+                                          const short remap_flags,
+                                          const IDRemap *id_remap_data)
+{
   if (free_notifier_reference_cb) {
     free_notifier_reference_cb(old_id);
   }
@@ -486,15 +597,15 @@ void BKE_libblock_remap_locked(Main *bmain, void *old_idv, void *new_idv, const
     remap_editor_id_reference_cb(old_id, new_id);
   }
 
-  skipped_direct = id_remap_data.skipped_direct;
-  skipped_refcounted = id_remap_data.skipped_refcounted;
+  const int skipped_direct = id_remap_data->skipped_direct;
+  const int skipped_refcounted = id_remap_data->skipped_refcounted;
 
   if ((remap_flags & ID_REMAP_SKIP_USER_CLEAR) == 0) {
     /* If old_id was used by some ugly 'user_one' stuff (like Image or Clip editors...), and user
      * count has actually been incremented for that, we have to decrease once more its user
      * count... unless we had to skip some 'user_one' cases. */
     if ((old_id->tag & LIB_TAG_EXTRAUSER_SET) &&
-        !(id_remap_data.status & ID_REMAP_IS_USER_ONE_SKIPPED)) {
+        !(id_remap_data->status & ID_REMAP_IS_USER_ONE_SKIPPED)) {
       id_us_clear_real(old_id);
     }
   }
@@ -519,17 +630,7 @@ void BKE_libblock_remap_locked(Main *bmain, void *old_idv, void *new_idv, const
     }
   }
 
-  /* Some after-process updates.
-   * This is a bit ugly, but cannot see a way to avoid it.
-   * Maybe we should do a per-ID callback for this instead? */
   switch (GS(old_id->name)) {
-    case ID_OB:
-      libblock_remap_data_postprocess_object_update(bmain, (Object *)old_id, (Object *)new_id);
-      break;
-    case ID_GR:
-      libblock_remap_data_postprocess_collection_update(
-          bmain, NULL, (Collection *)old_id, (Collection *)new_id);
-      break;
     case ID_ME:
     case ID_CU:
     case ID_MB:
@@ -545,6 +646,36 @@ void BKE_libblock_remap_locked(Main *bmain, void *old_idv, void *new_idv, const
     default:
       break;
   }
+}
+
+void BKE_libblock_remap_locked(Main *bmain, void *old_idv, void *new_idv, const short remap_flags)
+{
+  IDRemap id_remap_data;
+  ID *old_id = old_idv;
+  ID *new_id = new_idv;
+
+  BLI_assert(old_id != NULL);
+  BLI_assert((new_id == NULL) || GS(old_id->name) == GS(new_id->name));
+  BLI_assert(old_id != new_id);
+
+  libblock_remap_data(bmain, NULL, old_id, new_id, remap_flags, &id_remap_data);
+
+  libblock_remap_id_postprocess(bmain, old_id, new_id, remap_flags, &id_remap_data);
+
+  /* Some after-process updates.
+   * This is a bit ugly, but cannot see a way to avoid it.
+   * Maybe we should do a per-ID callback for this instead? */
+  switch (GS(old_id->name)) {
+    case ID_OB:
+      libblock_remap_data_postprocess_object_update(bmain, (Object *)old_id, (Object *)new_id);
+      break;
+    case ID_GR:
+      libblock_remap_data_postprocess_collection_update(
+          bmain, NULL, (Collection *)old_id, (Collection *)new_id);
+      break;
+    default:
+      break;
+  }
 
   /* Node trees may virtually use any kind of data-block... */
   /* XXX Yuck!!!! nodetree update can do pretty much any thing when talking about py nodes,
@@ -558,6 +689,101 @@ void BKE_libblock_remap_locked(Main *bmain, void *old_idv, void *new_idv, const
   DEG_relations_tag_update(bmain);
 }
 
+void BKE_libblock_remap_multiple_locked(
+    Main *bmain, ID **old_ids, ID **new_ids, const int ids_num, const short remap_flags)
+{
+  if (ids_num == 0) {
+    return;
+  }
+
+  /* The users of all old IDs are computed once, instead of walking over the whole Main database
+   * for each of them. The relations are not stored in `bmain`, since they do not match it anymore
+   * once remapping started, and #BKE_library_foreach_ID_link would use them. */
+  const short relations_flag = (remap_flags & ID_REMAP_FORCE_INTERNAL_RUNTIME_POINTERS) != 0 ?
+                                   MAINIDRELATIONS_INCLUDE_INTERNAL_RUNTIME_POINTERS :
+                                   0;
+  MainIDRelations *relations = BKE_main_relations_create_detached(bmain, relations_flag);
+
+  bool is_object_unlinked = false;
+  Object *object_relinked = NULL;
+  bool is_collection_unlinked = false;
+  Collection *collection_relinked = NULL;
+
+  for (int i = 0; i < ids_num; i++) {
+    IDRemap id_remap_data;
+    ID *old_id = old_ids[i];
+    ID *new_id = new_ids != NULL ? new_ids[i] : NULL;
+
+    BLI_assert(old_id != NULL);
+    BLI_assert((new_id == NULL) || GS(old_id->name) == GS(new_id->name));
+    BLI_assert(old_id != new_id);
+
+    libblock_remap_data_from_relations(
+        bmain, relations, old_id, new_id, remap_flags, &id_remap_data);
+
+    libblock_remap_id_postprocess(bmain, old_id, new_id, remap_flags, &id_remap_data);
+
+    switch (GS(old_id->name)) {
+      case ID_OB:
+        if (new_id == NULL) {
+          is_object_unlinked = true;
+        }
+        else {
+          object_relinked = (Object *)new_id;
+        }
+        break;
+      case ID_GR:
+        if (new_id == NULL) {
+          is_collection_unlinked = true;
+        }
+        else {
+          collection_relinked = (Collection *)new_id;
+        }
+        break;
+      default:
+        break;
+    }
+  }
+
+  BKE_main_relations_free_detached(relations);
+
+  /* Post-processing affecting the whole Main database is only done once for all remapped IDs.
+   * Passing a NULL old ID makes them check all potentially affected data. */
+  if (is_object_unlinked) {
+    libblock_remap_data_postprocess_object_update(bmain, NULL, NULL);
+  }
+  if (object_relinked != NULL) {
+    libblock_remap_data_postprocess_object_update(bmain, NULL, object_relinked);
+  }
+  if (is_collection_unlinked) {
+    libblock_remap_data_postprocess_collection_update(bmain, NULL, NULL, NULL);
+  }
+  if (collection_relinked != NULL) {
+    libblock_remap_data_postprocess_collection_update(bmain, NULL, NULL, collection_relinked);
+  }
+
+  if (new_ids != NULL) {
+    /* See #BKE_libblock_remap_locked for why Main needs to be unlocked here. */
+    BKE_main_unlock(bmain);
+    for (int i = 0; i < ids_num; i++) {
+      libblock_remap_data_postprocess_nodetree_update(bmain, new_ids[i]);
+    }
+    BKE_main_lock(bmain);
+  }
+
+  DEG_relations_tag_update(bmain);
+}
+
+void BKE_libblock_remap_multiple(
+    Main *bmain, ID **old_ids, ID **new_ids, const int ids_num, const short remap_flags)
+{
+  BKE_main_lock(bmain);
+
+  BKE_libblock_remap_multiple_locked(bmain, old_ids, new_ids, ids_num, remap_flags);
+
+  BKE_main_unlock(bmain);
+}
+
 void BKE_libblock_remap(Main *bmain, void *old_idv, void *new_idv, const short remap_flags)
 {
   BKE_main_lock(bmain);
@@ -0,0 +1,166 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2022 by Blender Foundation.
+ */
+#include "testing/testing.h"
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_listbase.h"
+
+#include "BKE_collection.h"
+#include "BKE_idtype.h"
+#include "BKE_lib_id.h"
+#include "BKE_lib_remap.h"
+#include "BKE_main.h"
+
+#include "DNA_ID.h"
+#include "DNA_collection_types.h"
+#include "DNA_mesh_types.h"
+#include "DNA_object_types.h"
+#include "DNA_scene_types.h"
+
+namespace blender::bke::tests {
+
+struct LibRemapTestContext {
+  Main *bmain;
+};
+
+static void test_lib_remap_init(LibRemapTestContext *ctx)
+{
+  BKE_idtype_init();
+  ctx->bmain = BKE_main_new();
+}
+
+static void test_lib_remap_free(LibRemapTestContext *ctx)
+{
+  BKE_main_free(ctx->bmain);
+}
+
+static Object *test_lib_remap_mesh_object_add(Main *bmain, const char *name, Mesh *mesh)
+{
+  Object *ob = static_cast<Object *>(BKE_id_new(bmain, ID_OB, name));
+  ob->type = OB_MESH;
+  ob->data = mesh;
+  id_us_plus(&mesh->id);
+  return ob;
+}
+
+TEST(lib_remap_multiple, remap)
+{
+  LibRemapTestContext ctx = {nullptr};
+  test_lib_remap_init(&ctx);
+
+  Mesh *me_a = static_cast<Mesh *>(BKE_id_new(ctx.bmain, ID_ME, "ME_A"));
+  Mesh *me_b = static_cast<Mesh *>(BKE_id_new(ctx.bmain, ID_ME, "ME_B"));
+  Mesh *me_c = static_cast<Mesh *>(BKE_id_new(ctx.bmain, ID_ME, "ME_C"));
+  Object *ob_a = test_lib_remap_mesh_object_add(ctx.bmain, "OB_A", me_a);
+  Object *ob_b = test_lib_remap_mesh_object_add(ctx.bmain, "OB_B", me_b);
+  Object *ob_c = test_lib_remap_mesh_object_add(ctx.bmain, "OB_C", me_a);
+  id_us_min(&me_a->id);
+  id_us_min(&me_b->id);
+  id_us_min(&me_c->id);
+
+  ID *old_ids[2] = {&me_a->id, &me_b->id};
+  ID *new_ids[2] = {&me_c->id, &me_c->id};
+  BKE_libblock_remap_multiple(ctx.bmain, old_ids, new_ids, 2, 0);
+
+  EXPECT_EQ(ob_a->data, me_c);
+  EXPECT_EQ(ob_b->data, me_c);
+  EXPECT_EQ(ob_c->data, me_c);
+  EXPECT_EQ(me_a->id.us, 0);
+  EXPECT_EQ(me_b->id.us, 0);
+  EXPECT_EQ(me_c->id.us, 3);
+  /* Relations are only used internally, they must not be left in Main. */
+  EXPECT_EQ(ctx.bmain->relations, nullptr);
+
+  test_lib_remap_free(&ctx);
+}
+
+TEST(lib_remap_multiple, unlink)
+{
+  LibRemapTestContext ctx = {nullptr};
+  test_lib_remap_init(&ctx);
+
+  Object *ob_parent_a = static_cast<Object *>(BKE_id_new(ctx.bmain, ID_OB, "OB_PARENT_A"));
+  Object *ob_parent_b = static_cast<Object *>(BKE_id_new(ctx.bmain, ID_OB, "OB_PARENT_B"));
+  Object *ob_child_a = static_cast<Object *>(BKE_id_new(ctx.bmain, ID_OB, "OB_CHILD_A"));
+  Object *ob_child_b = static_cast<Object *>(BKE_id_new(ctx.bmain, ID_OB, "OB_CHILD_B"));
+  Object *ob_child_c = static_cast<Object *>(BKE_id_new(ctx.bmain, ID_OB, "OB_CHILD_C"));
+  ob_child_a->parent = ob_parent_a;
+  ob_child_b->parent = ob_parent_b;
+  ob_child_c->parent = ob_child_a;
+
+  ID *old_ids[2] = {&ob_parent_a->id, &ob_parent_b->id};
+  BKE_libblock_remap_multiple(ctx.bmain, old_ids, nullptr, 2, 0);
+
+  EXPECT_EQ(ob_child_a->parent, nullptr);
+  EXPECT_EQ(ob_child_b->parent, nullptr);
+  EXPECT_EQ(ob_child_c->parent, ob_child_a);
+
+  test_lib_remap_free(&ctx);
+}
+
+TEST(lib_remap_multiple, unlink_from_embedded_id)
+{
+  LibRemapTestContext ctx = {nullptr};
+  test_lib_remap_init(&ctx);
+
+  Scene *scene = static_cast<Scene *>(BKE_id_new(ctx.bmain, ID_SCE, "SC_A"));
+  Object *ob_a = static_cast<Object *>(BKE_id_new(ctx.bmain, ID_OB, "OB_A"));
+  Object *ob_b = static_cast<Object *>(BKE_id_new(ctx.bmain, ID_OB, "OB_B"));
+  BKE_collection_object_add(ctx.bmain, scene->master_collection, ob_a);
+  BKE_collection_object_add(ctx.bmain, scene->master_collection, ob_b);
+  EXPECT_EQ(BLI_listbase_count(&scene->master_collection->gobject), 2);
+
+  /* The scene master collection is embedded, its users are found through the scene. */
+  ID *old_ids[1] = {&ob_a->id};
+  BKE_libblock_remap_multiple(ctx.bmain, old_ids, nullptr, 1, 0);
+
+  EXPECT_EQ(BLI_listbase_count(&scene->master_collection->gobject), 1);
+  EXPECT_TRUE(BKE_collection_has_object(scene->master_collection, ob_b));
+
+  test_lib_remap_free(&ctx);
+}
+
+TEST(lib_remap_multiple, tagged_delete)
+{
+  LibRemapTestContext ctx = {nullptr};
+  test_lib_remap_init(&ctx);
+
+  Mesh *me_a = static_cast<Mesh *>(BKE_id_new(ctx.bmain, ID_ME, "ME_A"));
+  Mesh *me_b = static_cast<Mesh *>(BKE_id_new(ctx.bmain, ID_ME, "ME_B"));
+  test_lib_remap_mesh_object_add(ctx.bmain, "OB_A", me_a);
+  Object *ob_b = test_lib_remap_mesh_object_add(ctx.bmain, "OB_B", me_b);
+  Object *ob_child = static_cast<Object *>(BKE_id_new(ctx.bmain, ID_OB, "OB_CHILD"));
+  ob_child->parent = ob_b;
+
+  /* The object using the deleted mesh can't be left without data, it is deleted too, in a
+   * second pass which must not process the IDs removed by the first one. */
+  BKE_main_id_tag_all(ctx.bmain, LIB_TAG_DOIT, false);
+  me_a->id.tag |= LIB_TAG_DOIT;
+  EXPECT_EQ(BKE_id_multi_tagged_delete(ctx.bmain), size_t(2));
+
+  EXPECT_EQ(BLI_listbase_count(&ctx.bmain->meshes), 1);
+  EXPECT_EQ(BLI_listbase_count(&ctx.bmain->objects), 2);
+  EXPECT_EQ(ob_b->data, me_b);
+  EXPECT_EQ(ob_child->parent, ob_b);
+  EXPECT_EQ(ctx.bmain->relations, nullptr);
+
+  test_lib_remap_free(&ctx);
+}
+
+}  // namespace blender::bke::tests
@@ -277,28 +277,27 @@ static int main_relations_create_idlink_cb(LibraryIDLinkCallbackData *cb_data)
   return IDWALK_RET_NOP;
 }
 
-void BKE_main_relations_create(Main *bmain, const short flag)
+MainIDRelations *BKE_main_relations_create_detached(Main *bmain, const short flag)
 {
-  if (bmain->relations != NULL) {
-    BKE_main_relations_free(bmain);
-  }
-
-  bmain->relations = MEM_mallocN(sizeof(*bmain->relations), __func__);
-  bmain->relations->relations_from_pointers = BLI_ghash_new(
+  MainIDRelations *relations = MEM_mallocN(sizeof(*relations), __func__);
+  relations->relations_from_pointers = BLI_ghash_new(
       BLI_ghashutil_ptrhash, BLI_ghashutil_ptrcmp, __func__);
-  bmain->relations->entry_items_pool = BLI_mempool_create(
+  relations->entry_items_pool = BLI_mempool_create(
       sizeof(MainIDRelationsEntryItem), 128, 128, BLI_MEMPOOL_NOP);
 
-  bmain->relations->flag = flag;
+  relations->flag = flag;
 
   ID *id;
   FOREACH_MAIN_ID_BEGIN (bmain, id) {
     const int idwalk_flag = IDWALK_READONLY |
-                            ((flag & MAINIDRELATIONS_INCLUDE_UI) != 0 ? IDWALK_INCLUDE_UI : 0);
+                            ((flag & MAINIDRELATIONS_INCLUDE_UI) != 0 ? IDWALK_INCLUDE_UI : 0) |
+                            ((flag & MAINIDRELATIONS_INCLUDE_INTERNAL_RUNTIME_POINTERS) != 0 ?
+                                 IDWALK_DO_INTERNAL_RUNTIME_POINTERS :
+                                 0);
 
     /* Ensure all IDs do have an entry, even if they are not connected to any other. */
     MainIDRelationsEntry **entry_p;
-    if (!BLI_ghash_ensure_p(bmain->relations->relations_from_pointers, id, (void ***)&entry_p)) {
+    if (!BLI_ghash_ensure_p(relations->relations_from_pointers, id, (void ***)&entry_p)) {
       *entry_p = MEM_callocN(sizeof(**entry_p), __func__);
       (*entry_p)->session_uuid = id->session_uuid;
     }
@@ -306,20 +305,35 @@ void BKE_main_relations_create(Main *bmain, const short flag)
       BLI_assert((*entry_p)->session_uuid == id->session_uuid);
     }
 
-    BKE_library_foreach_ID_link(
-        NULL, id, main_relations_create_idlink_cb, bmain->relations, idwalk_flag);
+    BKE_library_foreach_ID_link(NULL, id, main_relations_create_idlink_cb, relations, idwalk_flag);
   }
   FOREACH_MAIN_ID_END;
+
+  return relations;
+}
+
+void BKE_main_relations_create(Main *bmain, const short flag)
+{
+  if (bmain->relations != NULL) {
+    BKE_main_relations_free(bmain);
+  }
+
+  bmain->relations = BKE_main_relations_create_detached(bmain, flag);
+}
+
+void BKE_main_relations_free_detached(MainIDRelations *relations)
+{
+  if (relations->relations_from_pointers != NULL) {
+    BLI_ghash_free(relations->relations_from_pointers, NULL, MEM_freeN);
+  }
+  BLI_mempool_destroy(relations->entry_items_pool);
+  MEM_freeN(relations);
 }
 
 void BKE_main_relations_free(Main *bmain)
 {
   if (bmain->relations != NULL) {
-    if (bmain->relations->relations_from_pointers != NULL) {
-      BLI_ghash_free(bmain->relations->relations_from_pointers, NULL, MEM_freeN);
-    }
-    BLI_mempool_destroy(bmain->relations->entry_items_pool);
-    MEM_freeN(bmain->relations);
+    BKE_main_relations_free_detached(bmain->relations);
     bmain->relations = NULL;
   }
 }
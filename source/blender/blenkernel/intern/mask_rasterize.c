@@ -569,6 +569,24 @@ static void layer_bucket_init(MaskRasterLayer *layer, const float pixel_size)
   BLI_memarena_free(arena);
 }
 
+typedef struct MaskRasterizeBucketInitData {
+  MaskRasterLayer *layers;
+  float pixel_size;
+} MaskRasterizeBucketInitData;
+
+static void maskrasterize_layer_bucket_init_cb(void *__restrict userdata,
+                                               const int index,
+                                               const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  MaskRasterizeBucketInitData *data = userdata;
+  MaskRasterLayer *layer = &data->layers[index];
+
+  /* Layers outside the view use #layer_bucket_init_dummy. */
+  if (layer->face_array != NULL) {
+    layer_bucket_init(layer, data->pixel_size);
+  }
+}
+
 void BKE_maskrasterize_handle_init(MaskRasterHandle *mr_handle,
                                    struct Mask *mask,
                                    const int width,
@@ -1195,7 +1213,7 @@ void BKE_maskrasterize_handle_init(MaskRasterHandle *mr_handle,
           layer->face_array = face_array;
           layer->bounds = bounds;
 
-          layer_bucket_init(layer, pixel_size);
+          /* The buckets are initialized for all layers at once, see below. */
 
           BLI_rctf_union(&mr_handle->bounds, &bounds);
         }
@@ -1221,6 +1239,18 @@ void BKE_maskrasterize_handle_init(MaskRasterHandle *mr_handle,
   }
 
   BLI_memarena_free(sf_arena);
+
+  /* Filling shares the scan-fill arena, so only the bucket grids are built in parallel. */
+  MaskRasterizeBucketInitData data = {
+      .layers = mr_handle->layers,
+      .pixel_size = pixel_size,
+  };
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (mr_handle->layers_tot > 1);
+  settings.min_iter_per_thread = 1;
+  BLI_task_parallel_range(
+      0, (int)mr_handle->layers_tot, &data, maskrasterize_layer_bucket_init_cb, &settings);
 }
 
 /* --------------------------------------------------------------------- */
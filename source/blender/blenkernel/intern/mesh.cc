@@ -52,6 +52,7 @@
 
 #include "BKE_anim_data.h"
 #include "BKE_bpath.h"
+#include "BKE_bvhutils.h"
 #include "BKE_deform.h"
 #include "BKE_editmesh.h"
 #include "BKE_global.h"
@@ -132,7 +133,16 @@ static void mesh_copy_data(Main *bmain, ID *id_dst, const ID *id_src, const int
 
   BKE_defgroup_copy_list(&mesh_dst->vertex_group_names, &mesh_src->vertex_group_names);
 
-  const eCDAllocType alloc_type = (flag & LIB_ID_COPY_CD_REFERENCE) ? CD_REFERENCE : CD_DUPLICATE;
+  eCDAllocType alloc_type = CD_DUPLICATE;
+  if (flag & LIB_ID_COPY_CD_REFERENCE) {
+    alloc_type = CD_REFERENCE;
+  }
+  else if (flag & (LIB_ID_COPY_SET_COPIED_ON_WRITE | LIB_ID_COPY_CD_SHARE)) {
+    /* Copy-on-write copies are refreshed whenever the original changes, share the attribute
+     * arrays instead of copying them every time. Writing to them on either side goes through
+     * #CustomData_duplicate_referenced_layer or RNA, which copy shared arrays first. */
+    alloc_type = CD_SHARE;
+  }
   CustomData_copy(&mesh_src->vdata, &mesh_dst->vdata, mask.vmask, alloc_type, mesh_dst->totvert);
   CustomData_copy(&mesh_src->edata, &mesh_dst->edata, mask.emask, alloc_type, mesh_dst->totedge);
   CustomData_copy(&mesh_src->ldata, &mesh_dst->ldata, mask.lmask, alloc_type, mesh_dst->totloop);
@@ -1840,10 +1850,15 @@ void BKE_mesh_count_selected_items(const Mesh *mesh, int r_count[3])
 
 void BKE_mesh_vert_coords_get(const Mesh *mesh, float (*vert_coords)[3])
 {
-  const MVert *mv = mesh->mvert;
-  for (int i = 0; i < mesh->totvert; i++, mv++) {
-    copy_v3_v3(vert_coords[i], mv->co);
-  }
+  using namespace blender;
+  /* Deform modifiers work on contiguous coordinates, the copy from the vertices is only bound by
+   * memory bandwidth, so it is threaded for dense meshes. */
+  const MVert *mvert = mesh->mvert;
+  threading::parallel_for(IndexRange(mesh->totvert), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      copy_v3_v3(vert_coords[i], mvert[i].co);
+    }
+  });
 }
 
 float (*BKE_mesh_vert_coords_alloc(const Mesh *mesh, int *r_vert_len))[3]
@@ -1862,10 +1877,13 @@ void BKE_mesh_vert_coords_apply(Mesh *mesh, const float (*vert_coords)[3])
   MVert *mv = (MVert *)CustomData_duplicate_referenced_layer(
       &mesh->vdata, CD_MVERT, mesh->totvert);
   mesh->mvert = mv;
-  for (int i = 0; i < mesh->totvert; i++, mv++) {
-    copy_v3_v3(mv->co, vert_coords[i]);
-  }
-  BKE_mesh_normals_tag_dirty(mesh);
+  blender::threading::parallel_for(
+      blender::IndexRange(mesh->totvert), 4096, [&](const blender::IndexRange range) {
+        for (const int i : range) {
+          copy_v3_v3(mv[i].co, vert_coords[i]);
+        }
+      });
+  BKE_mesh_tag_coords_changed(mesh);
 }
 
 void BKE_mesh_vert_coords_apply_with_mat4(Mesh *mesh,
@@ -1876,10 +1894,19 @@ void BKE_mesh_vert_coords_apply_with_mat4(Mesh *mesh,
   MVert *mv = (MVert *)CustomData_duplicate_referenced_layer(
       &mesh->vdata, CD_MVERT, mesh->totvert);
   mesh->mvert = mv;
-  for (int i = 0; i < mesh->totvert; i++, mv++) {
-    mul_v3_m4v3(mv->co, mat, vert_coords[i]);
-  }
+  blender::threading::parallel_for(
+      blender::IndexRange(mesh->totvert), 4096, [&](const blender::IndexRange range) {
+        for (const int i : range) {
+          mul_v3_m4v3(mv[i].co, mat, vert_coords[i]);
+        }
+      });
+  BKE_mesh_tag_coords_changed(mesh);
+}
+
+void BKE_mesh_tag_coords_changed(Mesh *mesh)
+{
   BKE_mesh_normals_tag_dirty(mesh);
+  bvhcache_tag_coords_dirty(mesh->runtime.bvh_cache);
 }
 
 void BKE_mesh_vert_normals_apply(Mesh *mesh, const short (*vert_normals)[3])
@@ -42,6 +42,7 @@
 #include "BLI_stack.h"
 #include "BLI_task.h"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 
 #include "BKE_customdata.h"
 #include "BKE_editmesh_cache.h"
@@ -714,6 +715,7 @@ void BKE_lnor_space_custom_normal_to_data(MLoopNorSpace *lnor_space,
   }
 }
 
+/** Minimum number of loops or fans handled by one thread. */
 #define LOOP_SPLIT_TASK_BLOCK_SIZE 1024
 
 struct LoopSplitTaskData {
@@ -764,12 +766,31 @@ struct LoopSplitTaskDataCommon {
 /* See comment about edge_to_loops below. */
 #define IS_EDGE_SHARP(_e2l) (ELEM((_e2l)[1], INDEX_UNSET, INDEX_INVALID))
 
+static void mesh_edges_sharp_tag_prepare_fn(void *__restrict userdata,
+                                            const int mp_index,
+                                            const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const LoopSplitTaskDataCommon *data = (const LoopSplitTaskDataCommon *)userdata;
+  const MPoly *mp = &data->mpolys[mp_index];
+  float(*loopnors)[3] = data->loopnors;
+
+  for (int ml_index = mp->loopstart; ml_index < mp->loopstart + mp->totloop; ml_index++) {
+    data->loop_to_poly[ml_index] = mp_index;
+
+    /* Pre-populate all loop normals as if their verts were all-smooth,
+     * this way we don't have to compute those later!
+     */
+    if (loopnors) {
+      normal_short_to_float_v3(loopnors[ml_index], data->mverts[data->mloops[ml_index].v].no);
+    }
+  }
+}
+
 static void mesh_edges_sharp_tag(LoopSplitTaskDataCommon *data,
                                  const bool check_angle,
                                  const float split_angle,
                                  const bool do_sharp_edges_tag)
 {
-  const MVert *mverts = data->mverts;
   const MEdge *medges = data->medges;
   const MLoop *mloops = data->mloops;
 
@@ -778,7 +799,6 @@ static void mesh_edges_sharp_tag(LoopSplitTaskDataCommon *data,
   const int numEdges = data->numEdges;
   const int numPolys = data->numPolys;
 
-  float(*loopnors)[3] = data->loopnors; /* NOTE: loopnors may be nullptr here. */
   const float(*polynors)[3] = data->polynors;
 
   int(*edge_to_loops)[2] = data->edge_to_loops;
@@ -791,6 +811,13 @@ static void mesh_edges_sharp_tag(LoopSplitTaskDataCommon *data,
 
   const float split_angle_cos = check_angle ? cosf(split_angle) : -1.0f;
 
+  /* The loop to poly map and loop normals don't depend on other polys, only the edge to loops
+   * mapping below depends on the order of loops. */
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = LOOP_SPLIT_TASK_BLOCK_SIZE;
+  BLI_task_parallel_range(0, numPolys, data, mesh_edges_sharp_tag_prepare_fn, &settings);
+
   for (mp = mpolys, mp_index = 0; mp_index < numPolys; mp++, mp_index++) {
     const MLoop *ml_curr;
     int *e2l;
@@ -802,15 +829,6 @@ static void mesh_edges_sharp_tag(LoopSplitTaskDataCommon *data,
     for (; ml_curr_index <= ml_last_index; ml_curr++, ml_curr_index++) {
       e2l = edge_to_loops[ml_curr->e];
 
-      loop_to_poly[ml_curr_index] = mp_index;
-
-      /* Pre-populate all loop normals as if their verts were all-smooth,
-       * this way we don't have to compute those later!
-       */
-      if (loopnors) {
-        normal_short_to_float_v3(loopnors[ml_curr_index], mverts[ml_curr->v].no);
-      }
-
       /* Check whether current edge might be smooth or sharp */
       if ((e2l[0] | e2l[1]) == 0) {
         /* 'Empty' edge until now, set e2l[0] (and e2l[1] to INDEX_UNSET to tag it as unset). */
@@ -1231,54 +1249,6 @@ static void split_loop_nor_fan_do(LoopSplitTaskDataCommon *common_data, LoopSpli
   }
 }
 
-static void loop_split_worker_do(LoopSplitTaskDataCommon *common_data,
-                                 LoopSplitTaskData *data,
-                                 BLI_Stack *edge_vectors)
-{
-  BLI_assert(data->ml_curr);
-  if (data->e2l_prev) {
-    BLI_assert((edge_vectors == nullptr) || BLI_stack_is_empty(edge_vectors));
-    data->edge_vectors = edge_vectors;
-    split_loop_nor_fan_do(common_data, data);
-  }
-  else {
-    /* No need for edge_vectors for 'single' case! */
-    split_loop_nor_single_do(common_data, data);
-  }
-}
-
-static void loop_split_worker(TaskPool *__restrict pool, void *taskdata)
-{
-  LoopSplitTaskDataCommon *common_data = (LoopSplitTaskDataCommon *)BLI_task_pool_user_data(pool);
-  LoopSplitTaskData *data = (LoopSplitTaskData *)taskdata;
-
-  /* Temp edge vectors stack, only used when computing lnor spacearr. */
-  BLI_Stack *edge_vectors = common_data->lnors_spacearr ?
-                                BLI_stack_new(sizeof(float[3]), __func__) :
-                                nullptr;
-
-#ifdef DEBUG_TIME
-  TIMEIT_START_AVERAGED(loop_split_worker);
-#endif
-
-  for (int i = 0; i < LOOP_SPLIT_TASK_BLOCK_SIZE; i++, data++) {
-    /* A nullptr ml_curr is used to tag ended data! */
-    if (data->ml_curr == nullptr) {
-      break;
-    }
-
-    loop_split_worker_do(common_data, data, edge_vectors);
-  }
-
-  if (edge_vectors) {
-    BLI_stack_free(edge_vectors);
-  }
-
-#ifdef DEBUG_TIME
-  TIMEIT_END_AVERAGED(loop_split_worker);
-#endif
-}
-
 /**
  * Check whether given loop is part of an unknown-so-far cyclic smooth fan, or not.
  * Needed because cyclic smooth fans have no obvious 'entry point',
@@ -1355,11 +1325,15 @@ static bool loop_split_generator_check_cyclic_smooth_fan(const MLoop *mloops,
   }
 }
 
-static void loop_split_generator(TaskPool *pool, LoopSplitTaskDataCommon *common_data)
+/**
+ * Gather the loops which start a smooth fan, and the loops with two sharp edges which just use
+ * their poly normal. Walking the cyclic fans is required to find a single entry point for them,
+ * so this part is not threaded, the actual normals are computed in parallel afterwards.
+ */
+static void loop_split_generator(const LoopSplitTaskDataCommon *common_data,
+                                 blender::Vector<int> &r_single_loops,
+                                 blender::Vector<int> &r_fan_loops)
 {
-  MLoopNorSpaceArray *lnors_spacearr = common_data->lnors_spacearr;
-  float(*loopnors)[3] = common_data->loopnors;
-
   const MLoop *mloops = common_data->mloops;
   const MPoly *mpolys = common_data->mpolys;
   const int *loop_to_poly = common_data->loop_to_poly;
@@ -1377,49 +1351,25 @@ static void loop_split_generator(TaskPool *pool, LoopSplitTaskDataCommon *common
 
   BLI_bitmap *skip_loops = BLI_BITMAP_NEW(numLoops, __func__);
 
-  LoopSplitTaskData *data_buff = nullptr;
-  int data_idx = 0;
-
-  /* Temp edge vectors stack, only used when computing lnor spacearr
-   * (and we are not multi-threading). */
-  BLI_Stack *edge_vectors = nullptr;
-
 #ifdef DEBUG_TIME
   TIMEIT_START_AVERAGED(loop_split_generator);
 #endif
 
-  if (!pool) {
-    if (lnors_spacearr) {
-      edge_vectors = BLI_stack_new(sizeof(float[3]), __func__);
-    }
-  }
-
   /* We now know edges that can be smoothed (with their vector, and their two loops),
    * and edges that will be hard! Now, time to generate the normals.
    */
   for (mp = mpolys, mp_index = 0; mp_index < numPolys; mp++, mp_index++) {
-    float(*lnors)[3];
     const int ml_last_index = (mp->loopstart + mp->totloop) - 1;
     ml_curr_index = mp->loopstart;
     ml_prev_index = ml_last_index;
 
     ml_curr = &mloops[ml_curr_index];
     ml_prev = &mloops[ml_prev_index];
-    lnors = &loopnors[ml_curr_index];
 
-    for (; ml_curr_index <= ml_last_index; ml_curr++, ml_curr_index++, lnors++) {
+    for (; ml_curr_index <= ml_last_index; ml_curr++, ml_curr_index++) {
       const int *e2l_curr = edge_to_loops[ml_curr->e];
       const int *e2l_prev = edge_to_loops[ml_prev->e];
 
-#if 0
-      printf("Checking loop %d / edge %u / vert %u (sharp edge: %d, skiploop: %d)",
-             ml_curr_index,
-             ml_curr->e,
-             ml_curr->v,
-             IS_EDGE_SHARP(e2l_curr),
-             BLI_BITMAP_TEST_BOOL(skip_loops, ml_curr_index));
-#endif
-
       /* A smooth edge, we have to check for cyclic smooth fan case.
        * If we find a new, never-processed cyclic smooth fan, we can do it now using that loop/edge
        * as 'entry point', otherwise we can skip it. */
@@ -1442,94 +1392,154 @@ static void loop_split_generator(TaskPool *pool, LoopSplitTaskDataCommon *common
                                                                                      ml_curr_index,
                                                                                      ml_prev_index,
                                                                                      mp_index))) {
-        // printf("SKIPPING!\n");
+        /* Skipped. */
       }
+      else if (IS_EDGE_SHARP(e2l_curr) && IS_EDGE_SHARP(e2l_prev)) {
+        r_single_loops.append(ml_curr_index);
+      }
+      /* We *do not need* to check/tag loops as already computed!
+       * Due to the fact a loop only links to one of its two edges,
+       * a same fan *will never be walked more than once!*
+       * Since we consider edges having neighbor polys with inverted
+       * (flipped) normals as sharp, we are sure that no fan will be skipped,
+       * even only considering the case (sharp curr_edge, smooth prev_edge),
+       * and not the alternative (smooth curr_edge, sharp prev_edge).
+       * All this due/thanks to link between normals and loop ordering (i.e. winding).
+       */
       else {
-        LoopSplitTaskData *data, data_local;
+        r_fan_loops.append(ml_curr_index);
+      }
 
-        // printf("PROCESSING!\n");
+      ml_prev = ml_curr;
+      ml_prev_index = ml_curr_index;
+    }
+  }
 
-        if (pool) {
-          if (data_idx == 0) {
-            data_buff = (LoopSplitTaskData *)MEM_calloc_arrayN(
-                LOOP_SPLIT_TASK_BLOCK_SIZE, sizeof(*data_buff), __func__);
-          }
-          data = &data_buff[data_idx];
-        }
-        else {
-          data = &data_local;
-          memset(data, 0, sizeof(*data));
-        }
+  MEM_freeN(skip_loops);
 
-        if (IS_EDGE_SHARP(e2l_curr) && IS_EDGE_SHARP(e2l_prev)) {
-          data->lnor = lnors;
-          data->ml_curr = ml_curr;
-          data->ml_prev = ml_prev;
-          data->ml_curr_index = ml_curr_index;
-#if 0 /* Not needed for 'single' loop. */
-          data->ml_prev_index = ml_prev_index;
-          data->e2l_prev = nullptr; /* Tag as 'single' task. */
-#endif
-          data->mp_index = mp_index;
-          if (lnors_spacearr) {
-            data->lnor_space = BKE_lnor_space_create(lnors_spacearr);
-          }
-        }
-        /* We *do not need* to check/tag loops as already computed!
-         * Due to the fact a loop only links to one of its two edges,
-         * a same fan *will never be walked more than once!*
-         * Since we consider edges having neighbor polys with inverted
-         * (flipped) normals as sharp, we are sure that no fan will be skipped,
-         * even only considering the case (sharp curr_edge, smooth prev_edge),
-         * and not the alternative (smooth curr_edge, sharp prev_edge).
-         * All this due/thanks to link between normals and loop ordering (i.e. winding).
-         */
-        else {
-#if 0 /* Not needed for 'fan' loops. */
-          data->lnor = lnors;
+#ifdef DEBUG_TIME
+  TIMEIT_END_AVERAGED(loop_split_generator);
 #endif
-          data->ml_curr = ml_curr;
-          data->ml_prev = ml_prev;
-          data->ml_curr_index = ml_curr_index;
-          data->ml_prev_index = ml_prev_index;
-          data->e2l_prev = e2l_prev; /* Also tag as 'fan' task. */
-          data->mp_index = mp_index;
-          if (lnors_spacearr) {
-            data->lnor_space = BKE_lnor_space_create(lnors_spacearr);
-          }
-        }
+}
 
-        if (pool) {
-          data_idx++;
-          if (data_idx == LOOP_SPLIT_TASK_BLOCK_SIZE) {
-            BLI_task_pool_push(pool, loop_split_worker, data_buff, true, nullptr);
-            data_idx = 0;
-          }
-        }
-        else {
-          loop_split_worker_do(common_data, data, edge_vectors);
-        }
-      }
+struct LoopSplitParallelData {
+  LoopSplitTaskDataCommon *common_data;
+  /** Loops gathered by #loop_split_generator. */
+  const int *loops;
+  /** Normal space of each loop, or null when not generating the #MLoopNorSpaceArray. */
+  MLoopNorSpace **lnor_spaces;
+};
 
-      ml_prev = ml_curr;
-      ml_prev_index = ml_curr_index;
+struct LoopSplitParallelTLS {
+  /** Temp edge vectors stack, only used when computing lnor spacearr. */
+  BLI_Stack *edge_vectors;
+};
+
+static void loop_split_task_data_init(const LoopSplitParallelData *parallel_data,
+                                      const int i,
+                                      LoopSplitTaskData *data)
+{
+  const LoopSplitTaskDataCommon *common_data = parallel_data->common_data;
+  const int ml_curr_index = parallel_data->loops[i];
+  const int mp_index = common_data->loop_to_poly[ml_curr_index];
+  const MPoly *mp = &common_data->mpolys[mp_index];
+  const int ml_prev_index = (ml_curr_index == mp->loopstart) ?
+                                mp->loopstart + mp->totloop - 1 :
+                                ml_curr_index - 1;
+
+  memset(data, 0, sizeof(*data));
+  data->lnor_space = parallel_data->lnor_spaces ? parallel_data->lnor_spaces[i] : nullptr;
+  data->ml_curr = &common_data->mloops[ml_curr_index];
+  data->ml_prev = &common_data->mloops[ml_prev_index];
+  data->ml_curr_index = ml_curr_index;
+  data->ml_prev_index = ml_prev_index;
+  data->mp_index = mp_index;
+}
+
+static void loop_split_single_fn(void *__restrict userdata,
+                                 const int i,
+                                 const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const LoopSplitParallelData *parallel_data = (const LoopSplitParallelData *)userdata;
+  LoopSplitTaskData data;
+  loop_split_task_data_init(parallel_data, i, &data);
+  data.lnor = &parallel_data->common_data->loopnors[data.ml_curr_index];
+
+  split_loop_nor_single_do(parallel_data->common_data, &data);
+}
+
+static void loop_split_fan_fn(void *__restrict userdata,
+                              const int i,
+                              const TaskParallelTLS *__restrict tls)
+{
+  const LoopSplitParallelData *parallel_data = (const LoopSplitParallelData *)userdata;
+  LoopSplitParallelTLS *tls_data = (LoopSplitParallelTLS *)tls->userdata_chunk;
+  LoopSplitTaskData data;
+  loop_split_task_data_init(parallel_data, i, &data);
+  /* Also tag as 'fan' task. */
+  data.e2l_prev = parallel_data->common_data->edge_to_loops[data.ml_prev->e];
+
+  if (parallel_data->common_data->lnors_spacearr) {
+    if (tls_data->edge_vectors == nullptr) {
+      tls_data->edge_vectors = BLI_stack_new(sizeof(float[3]), __func__);
     }
+    BLI_assert(BLI_stack_is_empty(tls_data->edge_vectors));
+    data.edge_vectors = tls_data->edge_vectors;
   }
 
-  /* Last block of data. Since it is calloc'ed and we use first nullptr item as stopper,
-   * everything is fine. */
-  if (pool && data_idx) {
-    BLI_task_pool_push(pool, loop_split_worker, data_buff, true, nullptr);
+  split_loop_nor_fan_do(parallel_data->common_data, &data);
+}
+
+static void loop_split_fan_free_fn(const void *__restrict UNUSED(userdata),
+                                   void *__restrict chunk)
+{
+  LoopSplitParallelTLS *tls_data = (LoopSplitParallelTLS *)chunk;
+  if (tls_data->edge_vectors) {
+    BLI_stack_free(tls_data->edge_vectors);
   }
+}
 
-  if (edge_vectors) {
-    BLI_stack_free(edge_vectors);
+/**
+ * Compute the normals of the loops gathered by #loop_split_generator. Every fan and single loop
+ * writes to its own loops only, so they are all independent.
+ */
+static void loop_split_compute(LoopSplitTaskDataCommon *common_data,
+                               const blender::Span<int> loops,
+                               const bool is_fan)
+{
+  MLoopNorSpaceArray *lnors_spacearr = common_data->lnors_spacearr;
+
+  /* Spaces have to be created outside of tasks, since #MemArena is not thread-safe. */
+  MLoopNorSpace **lnor_spaces = nullptr;
+  if (lnors_spacearr) {
+    lnor_spaces = (MLoopNorSpace **)MEM_malloc_arrayN(
+        (size_t)loops.size(), sizeof(*lnor_spaces), __func__);
+    for (const int i : loops.index_range()) {
+      lnor_spaces[i] = BKE_lnor_space_create(lnors_spacearr);
+    }
   }
-  MEM_freeN(skip_loops);
 
-#ifdef DEBUG_TIME
-  TIMEIT_END_AVERAGED(loop_split_generator);
-#endif
+  LoopSplitParallelData parallel_data = {common_data, loops.data(), lnor_spaces};
+  LoopSplitParallelTLS tls_data = {nullptr};
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (common_data->numLoops >= LOOP_SPLIT_TASK_BLOCK_SIZE * 8);
+  settings.min_iter_per_thread = LOOP_SPLIT_TASK_BLOCK_SIZE;
+  if (is_fan) {
+    /* Fans differ a lot in size, use smaller chunks to balance them between threads. */
+    settings.min_iter_per_thread = LOOP_SPLIT_TASK_BLOCK_SIZE / 8;
+    settings.userdata_chunk = &tls_data;
+    settings.userdata_chunk_size = sizeof(tls_data);
+    settings.func_free = loop_split_fan_free_fn;
+  }
+  BLI_task_parallel_range(0,
+                          (int)loops.size(),
+                          &parallel_data,
+                          is_fan ? loop_split_fan_fn : loop_split_single_fn,
+                          &settings);
+
+  MEM_SAFE_FREE(lnor_spaces);
 }
 
 void BKE_mesh_normals_loop_split(const MVert *mverts,
@@ -1640,19 +1650,12 @@ void BKE_mesh_normals_loop_split(const MVert *mverts,
   /* This first loop check which edges are actually smooth, and compute edge vectors. */
   mesh_edges_sharp_tag(&common_data, check_angle, split_angle, false);
 
-  if (numLoops < LOOP_SPLIT_TASK_BLOCK_SIZE * 8) {
-    /* Not enough loops to be worth the whole threading overhead. */
-    loop_split_generator(nullptr, &common_data);
-  }
-  else {
-    TaskPool *task_pool = BLI_task_pool_create(&common_data, TASK_PRIORITY_HIGH);
+  blender::Vector<int> single_loops;
+  blender::Vector<int> fan_loops;
+  loop_split_generator(&common_data, single_loops, fan_loops);
 
-    loop_split_generator(task_pool, &common_data);
-
-    BLI_task_pool_work_and_wait(task_pool);
-
-    BLI_task_pool_free(task_pool);
-  }
+  loop_split_compute(&common_data, single_loops, false);
+  loop_split_compute(&common_data, fan_loops, true);
 
   MEM_freeN(edge_to_loops);
   if (!r_loop_to_poly) {
@@ -36,6 +36,7 @@
 #include "BKE_bvhutils.h"
 #include "BKE_lib_id.h"
 #include "BKE_mesh.h"
+#include "BKE_mesh_mapping.h"
 #include "BKE_mesh_runtime.h"
 #include "BKE_shrinkwrap.h"
 #include "BKE_subdiv_ccg.h"
@@ -55,6 +56,9 @@ static void mesh_runtime_init_mutexes(Mesh *mesh)
   BLI_mutex_init(mesh->runtime.eval_mutex);
   mesh->runtime.render_mutex = MEM_mallocN(sizeof(ThreadMutex), "mesh runtime render_mutex");
   BLI_mutex_init(mesh->runtime.render_mutex);
+  mesh->runtime.topology_maps_mutex = MEM_mallocN(sizeof(ThreadMutex),
+                                                  "mesh runtime topology_maps_mutex");
+  BLI_mutex_init(mesh->runtime.topology_maps_mutex);
 }
 
 /**
@@ -72,6 +76,11 @@ static void mesh_runtime_free_mutexes(Mesh *mesh)
     MEM_freeN(mesh->runtime.render_mutex);
     mesh->runtime.render_mutex = NULL;
   }
+  if (mesh->runtime.topology_maps_mutex != NULL) {
+    BLI_mutex_end(mesh->runtime.topology_maps_mutex);
+    MEM_freeN(mesh->runtime.topology_maps_mutex);
+    mesh->runtime.topology_maps_mutex = NULL;
+  }
 }
 
 void BKE_mesh_runtime_init_data(Mesh *mesh)
@@ -94,8 +103,10 @@ void BKE_mesh_runtime_reset_on_copy(Mesh *mesh, const int UNUSED(flag))
   runtime->batch_cache = NULL;
   runtime->subdiv_ccg = NULL;
   memset(&runtime->looptris, 0, sizeof(runtime->looptris));
+  runtime->looptris_reuse = NULL;
   runtime->bvh_cache = NULL;
   runtime->shrinkwrap_data = NULL;
+  runtime->topology_maps = NULL;
 
   mesh_runtime_init_mutexes(mesh);
 }
@@ -146,17 +157,91 @@ static void mesh_ensure_looptri_data(Mesh *mesh)
   }
 }
 
+typedef struct MeshLoopTriReuse {
+  /**
+   * Topology the triangulation was calculated for. A copy made with #LIB_ID_COPY_CD_REFERENCE
+   * shares these arrays with its source until they are made mutable, so comparing the pointers
+   * tells whether the topology may have changed since.
+   */
+  const MPoly *mpoly;
+  const MLoop *mloop;
+  int totpoly;
+  int totloop;
+  MLoopTri *looptris;
+} MeshLoopTriReuse;
+
+static void mesh_runtime_looptri_reuse_free(Mesh *mesh)
+{
+  MeshLoopTriReuse *reuse = mesh->runtime.looptris_reuse;
+  if (reuse == NULL) {
+    return;
+  }
+  MEM_freeN(reuse->looptris);
+  MEM_freeN(reuse);
+  mesh->runtime.looptris_reuse = NULL;
+}
+
+static bool mesh_has_ngons(const Mesh *mesh)
+{
+  for (int i = 0; i < mesh->totpoly; i++) {
+    if (mesh->mpoly[i].totloop > 4) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void BKE_mesh_runtime_looptri_reuse_from(Mesh *mesh, const Mesh *mesh_src)
+{
+  BLI_assert(mesh->runtime.looptris.array == NULL);
+  mesh_runtime_looptri_reuse_free(mesh);
+
+  if (mesh->mpoly != mesh_src->mpoly || mesh->mloop != mesh_src->mloop ||
+      !mesh_has_ngons(mesh_src)) {
+    return;
+  }
+
+  /* The triangulation of the source stays cached until its topology changes, so it only has to
+   * be calculated once for all following deformations. */
+  const MLoopTri *looptris_src = BKE_mesh_runtime_looptri_ensure(mesh_src);
+  const int looptris_len = BKE_mesh_runtime_looptri_len(mesh_src);
+
+  MeshLoopTriReuse *reuse = MEM_mallocN(sizeof(*reuse), __func__);
+  reuse->mpoly = mesh_src->mpoly;
+  reuse->mloop = mesh_src->mloop;
+  reuse->totpoly = mesh_src->totpoly;
+  reuse->totloop = mesh_src->totloop;
+  reuse->looptris = MEM_malloc_arrayN(looptris_len, sizeof(*reuse->looptris), __func__);
+  memcpy(reuse->looptris, looptris_src, sizeof(*reuse->looptris) * (size_t)looptris_len);
+  mesh->runtime.looptris_reuse = reuse;
+}
+
 void BKE_mesh_runtime_looptri_recalc(Mesh *mesh)
 {
   mesh_ensure_looptri_data(mesh);
   BLI_assert(mesh->totpoly == 0 || mesh->runtime.looptris.array_wip != NULL);
 
-  BKE_mesh_recalc_looptri(mesh->mloop,
-                          mesh->mpoly,
-                          mesh->mvert,
-                          mesh->totloop,
-                          mesh->totpoly,
-                          mesh->runtime.looptris.array_wip);
+  const MeshLoopTriReuse *reuse = mesh->runtime.looptris_reuse;
+  if (reuse && reuse->mpoly == mesh->mpoly && reuse->mloop == mesh->mloop &&
+      reuse->totpoly == mesh->totpoly && reuse->totloop == mesh->totloop) {
+    BKE_mesh_recalc_looptri_with_reuse(mesh->mloop,
+                                       mesh->mpoly,
+                                       mesh->mvert,
+                                       mesh->totloop,
+                                       mesh->totpoly,
+                                       mesh->runtime.looptris.array_wip,
+                                       reuse->looptris);
+  }
+  else {
+    BKE_mesh_recalc_looptri(mesh->mloop,
+                            mesh->mpoly,
+                            mesh->mvert,
+                            mesh->totloop,
+                            mesh->totpoly,
+                            mesh->runtime.looptris.array_wip);
+  }
+  /* Only needed once, the result is cached in #Mesh_Runtime.looptris from now on. */
+  mesh_runtime_looptri_reuse_free(mesh);
 
   BLI_assert(mesh->runtime.looptris.array == NULL);
   atomic_cas_ptr((void **)&mesh->runtime.looptris.array,
@@ -200,6 +285,115 @@ const MLoopTri *BKE_mesh_runtime_looptri_ensure(const Mesh *mesh)
   return looptri;
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Mesh Topology Maps
+ * \{ */
+
+typedef struct MeshTopologyMaps {
+  MeshElemMap *vert_to_poly;
+  int *vert_to_poly_mem;
+  MeshElemMap *vert_to_edge;
+  int *vert_to_edge_mem;
+  MeshElemMap *edge_to_poly;
+  int *edge_to_poly_mem;
+} MeshTopologyMaps;
+
+typedef enum eMeshTopologyMapType {
+  MESH_TOPOLOGY_MAP_VERT_POLY,
+  MESH_TOPOLOGY_MAP_VERT_EDGE,
+  MESH_TOPOLOGY_MAP_EDGE_POLY,
+} eMeshTopologyMapType;
+
+static void mesh_runtime_topology_maps_free(Mesh *mesh)
+{
+  MeshTopologyMaps *maps = mesh->runtime.topology_maps;
+  if (maps == NULL) {
+    return;
+  }
+  MEM_SAFE_FREE(maps->vert_to_poly);
+  MEM_SAFE_FREE(maps->vert_to_poly_mem);
+  MEM_SAFE_FREE(maps->vert_to_edge);
+  MEM_SAFE_FREE(maps->vert_to_edge_mem);
+  MEM_SAFE_FREE(maps->edge_to_poly);
+  MEM_SAFE_FREE(maps->edge_to_poly_mem);
+  MEM_freeN(maps);
+  mesh->runtime.topology_maps = NULL;
+}
+
+static const MeshElemMap *mesh_runtime_topology_map_ensure(const Mesh *mesh,
+                                                           const eMeshTopologyMapType type)
+{
+  ThreadMutex *mutex = (ThreadMutex *)mesh->runtime.topology_maps_mutex;
+  BLI_mutex_lock(mutex);
+
+  /* The pointer to the maps is part of the cache, the mesh is logically const. */
+  MeshTopologyMaps **maps_p = (MeshTopologyMaps **)&mesh->runtime.topology_maps;
+  if (*maps_p == NULL) {
+    *maps_p = MEM_callocN(sizeof(MeshTopologyMaps), __func__);
+  }
+  MeshTopologyMaps *maps = *maps_p;
+
+  const MeshElemMap *map = NULL;
+  switch (type) {
+    case MESH_TOPOLOGY_MAP_VERT_POLY:
+      if (maps->vert_to_poly == NULL) {
+        BKE_mesh_vert_poly_map_create(&maps->vert_to_poly,
+                                      &maps->vert_to_poly_mem,
+                                      mesh->mpoly,
+                                      mesh->mloop,
+                                      mesh->totvert,
+                                      mesh->totpoly,
+                                      mesh->totloop);
+      }
+      map = maps->vert_to_poly;
+      break;
+    case MESH_TOPOLOGY_MAP_VERT_EDGE:
+      if (maps->vert_to_edge == NULL) {
+        BKE_mesh_vert_edge_map_create(&maps->vert_to_edge,
+                                      &maps->vert_to_edge_mem,
+                                      mesh->medge,
+                                      mesh->totvert,
+                                      mesh->totedge);
+      }
+      map = maps->vert_to_edge;
+      break;
+    case MESH_TOPOLOGY_MAP_EDGE_POLY:
+      if (maps->edge_to_poly == NULL) {
+        BKE_mesh_edge_poly_map_create(&maps->edge_to_poly,
+                                      &maps->edge_to_poly_mem,
+                                      mesh->medge,
+                                      mesh->totedge,
+                                      mesh->mpoly,
+                                      mesh->totpoly,
+                                      mesh->mloop,
+                                      mesh->totloop);
+      }
+      map = maps->edge_to_poly;
+      break;
+  }
+
+  BLI_mutex_unlock(mutex);
+
+  return map;
+}
+
+const MeshElemMap *BKE_mesh_runtime_vert_poly_map_ensure(const Mesh *mesh)
+{
+  return mesh_runtime_topology_map_ensure(mesh, MESH_TOPOLOGY_MAP_VERT_POLY);
+}
+
+const MeshElemMap *BKE_mesh_runtime_vert_edge_map_ensure(const Mesh *mesh)
+{
+  return mesh_runtime_topology_map_ensure(mesh, MESH_TOPOLOGY_MAP_VERT_EDGE);
+}
+
+const MeshElemMap *BKE_mesh_runtime_edge_poly_map_ensure(const Mesh *mesh)
+{
+  return mesh_runtime_topology_map_ensure(mesh, MESH_TOPOLOGY_MAP_EDGE_POLY);
+}
+
+/** \} */
+
 void BKE_mesh_runtime_verttri_from_looptri(MVertTri *r_verttri,
                                            const MLoop *mloop,
                                            const MLoopTri *looptri,
@@ -257,6 +451,8 @@ void BKE_mesh_runtime_clear_geometry(Mesh *mesh)
     mesh->runtime.bvh_cache = NULL;
   }
   MEM_SAFE_FREE(mesh->runtime.looptris.array);
+  mesh_runtime_looptri_reuse_free(mesh);
+  mesh_runtime_topology_maps_free(mesh);
   /* TODO(sergey): Does this really belong here? */
   if (mesh->runtime.subdiv_ccg != NULL) {
     BKE_subdiv_ccg_destroy(mesh->runtime.subdiv_ccg);
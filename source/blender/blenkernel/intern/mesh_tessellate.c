@@ -568,13 +568,34 @@ static void mesh_calc_tessellation_for_face_with_normal(const MLoop *mloop,
       mloop, mpoly, mvert, poly_index, mlt, pf_arena_p, true, normal_precalc);
 }
 
+/**
+ * Copy the triangles of an n-gon from the tessellation of a mesh with the same topology,
+ * skipping the polygon fill. Triangles and quads are cheap to tessellate (and the split of a
+ * quad may need to change when it's deformed), so they are always recalculated.
+ *
+ * \return true when the triangles were copied.
+ */
+static bool mesh_calc_tessellation_for_face_reuse(const MPoly *mpoly,
+                                                  uint poly_index,
+                                                  MLoopTri *mlt,
+                                                  const MLoopTri *mlt_reuse)
+{
+  const uint mp_totloop = (uint)mpoly[poly_index].totloop;
+  if (mlt_reuse == NULL || mp_totloop <= 4) {
+    return false;
+  }
+  memcpy(mlt, mlt_reuse, sizeof(*mlt) * (size_t)(mp_totloop - 2));
+  return true;
+}
+
 static void mesh_recalc_looptri__single_threaded(const MLoop *mloop,
                                                  const MPoly *mpoly,
                                                  const MVert *mvert,
                                                  int totloop,
                                                  int totpoly,
                                                  MLoopTri *mlooptri,
-                                                 const float (*poly_normals)[3])
+                                                 const float (*poly_normals)[3],
+                                                 const MLoopTri *looptri_reuse)
 {
   MemArena *pf_arena = NULL;
   const MPoly *mp = mpoly;
@@ -582,6 +603,14 @@ static void mesh_recalc_looptri__single_threaded(const MLoop *mloop,
 
   if (poly_normals != NULL) {
     for (uint poly_index = 0; poly_index < (uint)totpoly; poly_index++, mp++) {
+      if (mesh_calc_tessellation_for_face_reuse(
+              mpoly,
+              poly_index,
+              &mlooptri[tri_index],
+              looptri_reuse ? &looptri_reuse[tri_index] : NULL)) {
+        tri_index += (uint)(mp->totloop - 2);
+        continue;
+      }
       mesh_calc_tessellation_for_face_with_normal(mloop,
                                                   mpoly,
                                                   mvert,
@@ -594,6 +623,14 @@ static void mesh_recalc_looptri__single_threaded(const MLoop *mloop,
   }
   else {
     for (uint poly_index = 0; poly_index < (uint)totpoly; poly_index++, mp++) {
+      if (mesh_calc_tessellation_for_face_reuse(
+              mpoly,
+              poly_index,
+              &mlooptri[tri_index],
+              looptri_reuse ? &looptri_reuse[tri_index] : NULL)) {
+        tri_index += (uint)(mp->totloop - 2);
+        continue;
+      }
       mesh_calc_tessellation_for_face(
           mloop, mpoly, mvert, poly_index, &mlooptri[tri_index], &pf_arena);
       tri_index += (uint)(mp->totloop - 2);
@@ -618,6 +655,9 @@ struct TessellationUserData {
 
   /** Optional pre-calculated polygon normals array. */
   const float (*poly_normals)[3];
+
+  /** Optional tessellation of a mesh with the same topology to copy n-gons from. */
+  const MLoopTri *looptri_reuse;
 };
 
 struct TessellationUserTLS {
@@ -631,6 +671,13 @@ static void mesh_calc_tessellation_for_face_fn(void *__restrict userdata,
   const struct TessellationUserData *data = userdata;
   struct TessellationUserTLS *tls_data = tls->userdata_chunk;
   const int tri_index = poly_to_tri_count(index, data->mpoly[index].loopstart);
+  if (mesh_calc_tessellation_for_face_reuse(
+          data->mpoly,
+          (uint)index,
+          &data->mlooptri[tri_index],
+          data->looptri_reuse ? &data->looptri_reuse[tri_index] : NULL)) {
+    return;
+  }
   mesh_calc_tessellation_for_face_impl(data->mloop,
                                        data->mpoly,
                                        data->mvert,
@@ -648,6 +695,13 @@ static void mesh_calc_tessellation_for_face_with_normal_fn(void *__restrict user
   const struct TessellationUserData *data = userdata;
   struct TessellationUserTLS *tls_data = tls->userdata_chunk;
   const int tri_index = poly_to_tri_count(index, data->mpoly[index].loopstart);
+  if (mesh_calc_tessellation_for_face_reuse(
+          data->mpoly,
+          (uint)index,
+          &data->mlooptri[tri_index],
+          data->looptri_reuse ? &data->looptri_reuse[tri_index] : NULL)) {
+    return;
+  }
   mesh_calc_tessellation_for_face_impl(data->mloop,
                                        data->mpoly,
                                        data->mvert,
@@ -673,7 +727,8 @@ static void mesh_recalc_looptri__multi_threaded(const MLoop *mloop,
                                                 int UNUSED(totloop),
                                                 int totpoly,
                                                 MLoopTri *mlooptri,
-                                                const float (*poly_normals)[3])
+                                                const float (*poly_normals)[3],
+                                                const MLoopTri *looptri_reuse)
 {
   struct TessellationUserTLS tls_data_dummy = {NULL};
 
@@ -683,6 +738,7 @@ static void mesh_recalc_looptri__multi_threaded(const MLoop *mloop,
       .mvert = mvert,
       .mlooptri = mlooptri,
       .poly_normals = poly_normals,
+      .looptri_reuse = looptri_reuse,
   };
 
   TaskParallelSettings settings;
@@ -709,10 +765,12 @@ void BKE_mesh_recalc_looptri(const MLoop *mloop,
                              MLoopTri *mlooptri)
 {
   if (totloop < MESH_FACE_TESSELLATE_THREADED_LIMIT) {
-    mesh_recalc_looptri__single_threaded(mloop, mpoly, mvert, totloop, totpoly, mlooptri, NULL);
+    mesh_recalc_looptri__single_threaded(
+        mloop, mpoly, mvert, totloop, totpoly, mlooptri, NULL, NULL);
   }
   else {
-    mesh_recalc_looptri__multi_threaded(mloop, mpoly, mvert, totloop, totpoly, mlooptri, NULL);
+    mesh_recalc_looptri__multi_threaded(
+        mloop, mpoly, mvert, totloop, totpoly, mlooptri, NULL, NULL);
   }
 }
 
@@ -727,11 +785,30 @@ void BKE_mesh_recalc_looptri_with_normals(const MLoop *mloop,
   BLI_assert(poly_normals != NULL);
   if (totloop < MESH_FACE_TESSELLATE_THREADED_LIMIT) {
     mesh_recalc_looptri__single_threaded(
-        mloop, mpoly, mvert, totloop, totpoly, mlooptri, poly_normals);
+        mloop, mpoly, mvert, totloop, totpoly, mlooptri, poly_normals, NULL);
+  }
+  else {
+    mesh_recalc_looptri__multi_threaded(
+        mloop, mpoly, mvert, totloop, totpoly, mlooptri, poly_normals, NULL);
+  }
+}
+
+void BKE_mesh_recalc_looptri_with_reuse(const MLoop *mloop,
+                                        const MPoly *mpoly,
+                                        const MVert *mvert,
+                                        int totloop,
+                                        int totpoly,
+                                        MLoopTri *mlooptri,
+                                        const MLoopTri *looptri_reuse)
+{
+  BLI_assert(looptri_reuse != NULL);
+  if (totloop < MESH_FACE_TESSELLATE_THREADED_LIMIT) {
+    mesh_recalc_looptri__single_threaded(
+        mloop, mpoly, mvert, totloop, totpoly, mlooptri, NULL, looptri_reuse);
   }
   else {
     mesh_recalc_looptri__multi_threaded(
-        mloop, mpoly, mvert, totloop, totpoly, mlooptri, poly_normals);
+        mloop, mpoly, mvert, totloop, totpoly, mlooptri, NULL, looptri_reuse);
   }
 }
 
@@ -51,6 +51,7 @@
 #include "BLI_linklist.h"
 #include "BLI_listbase.h"
 #include "BLI_path_util.h"
+#include "BLI_profile.h"
 #include "BLI_session_uuid.h"
 #include "BLI_string.h"
 #include "BLI_string_utils.h"
@@ -995,7 +996,10 @@ struct Mesh *BKE_modifier_modify_mesh(ModifierData *md,
   if (mti->dependsOnNormals && mti->dependsOnNormals(md)) {
     modwrap_dependsOnNormals(me);
   }
-  return mti->modifyMesh(md, ctx, me);
+  BLI_PROFILE_ZONE_BEGIN(zone, mti->name, md->name);
+  Mesh *result = mti->modifyMesh(md, ctx, me);
+  BLI_PROFILE_ZONE_END(zone);
+  return result;
 }
 
 void BKE_modifier_deform_verts(ModifierData *md,
@@ -1010,7 +1014,9 @@ void BKE_modifier_deform_verts(ModifierData *md,
   if (me && mti->dependsOnNormals && mti->dependsOnNormals(md)) {
     modwrap_dependsOnNormals(me);
   }
+  BLI_PROFILE_ZONE_BEGIN(zone, mti->name, md->name);
   mti->deformVerts(md, ctx, me, vertexCos, numVerts);
+  BLI_PROFILE_ZONE_END(zone);
 }
 
 void BKE_modifier_deform_vertsEM(ModifierData *md,
@@ -1026,7 +1032,9 @@ void BKE_modifier_deform_vertsEM(ModifierData *md,
   if (me && mti->dependsOnNormals && mti->dependsOnNormals(md)) {
     BKE_mesh_calc_normals(me);
   }
+  BLI_PROFILE_ZONE_BEGIN(zone, mti->name, md->name);
   mti->deformVertsEM(md, ctx, em, me, vertexCos, numVerts);
+  BLI_PROFILE_ZONE_END(zone);
 }
 
 /* end modifier callback wrappers */
@@ -609,8 +609,8 @@ static ImBuf *movieclip_load_sequence_file(MovieClip *clip,
 
   loadflag = IB_rect | IB_multilayer | IB_alphamode_detect | IB_metadata;
 
-  /* read ibuf */
-  ibuf = IMB_loadiffname(name, loadflag, colorspace);
+  /* Read ibuf, sharing it with other clips which use the same image sequence. */
+  ibuf = IMB_loadiffname_shared(name, loadflag, colorspace);
   BKE_movieclip_convert_multilayer_ibuf(ibuf);
 
   return ibuf;
@@ -1051,21 +1051,52 @@ typedef void(ReshapeSubdivCoarsePositionCb)(
     const Vertex *vertex,
     float r_P[3]);
 
+typedef struct ReshapeSubdivRefineTaskData {
+  const MultiresReshapeSmoothContext *reshape_smooth_context;
+  ReshapeSubdivCoarsePositionCb *coarse_position_cb;
+  float (*coarse_positions)[3];
+} ReshapeSubdivRefineTaskData;
+
+static void reshape_subdiv_refine_task(void *__restrict userdata_v,
+                                       const int vertex_index,
+                                       const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  ReshapeSubdivRefineTaskData *data = userdata_v;
+  const MultiresReshapeSmoothContext *reshape_smooth_context = data->reshape_smooth_context;
+  const Vertex *vertex = &reshape_smooth_context->geometry.vertices[vertex_index];
+  data->coarse_position_cb(reshape_smooth_context, vertex, data->coarse_positions[vertex_index]);
+}
+
 /* Refine subdivision surface topology at a reshape level for new coarse vertices positions. */
 static void reshape_subdiv_refine(const MultiresReshapeSmoothContext *reshape_smooth_context,
                                   ReshapeSubdivCoarsePositionCb coarse_position_cb)
 {
   Subdiv *reshape_subdiv = reshape_smooth_context->reshape_subdiv;
 
-  /* TODO(sergey): For non-trivial coarse_position_cb we should multi-thread this loop. */
-
   const int num_vertices = reshape_smooth_context->geometry.num_vertices;
-  for (int i = 0; i < num_vertices; ++i) {
-    const Vertex *vertex = &reshape_smooth_context->geometry.vertices[i];
-    float P[3];
-    coarse_position_cb(reshape_smooth_context, vertex, P);
-    reshape_subdiv->evaluator->setCoarsePositions(reshape_subdiv->evaluator, P, i, 1);
+  if (num_vertices == 0) {
+    reshape_subdiv->evaluator->refine(reshape_subdiv->evaluator);
+    return;
   }
+
+  /* The coarse positions are evaluated from the grids in parallel and passed to the evaluator in
+   * a single call. */
+  ReshapeSubdivRefineTaskData data;
+  data.reshape_smooth_context = reshape_smooth_context;
+  data.coarse_position_cb = coarse_position_cb;
+  data.coarse_positions = MEM_malloc_arrayN(num_vertices, sizeof(float[3]), __func__);
+
+  TaskParallelSettings parallel_range_settings;
+  BLI_parallel_range_settings_defaults(&parallel_range_settings);
+  parallel_range_settings.min_iter_per_thread = 1024;
+
+  BLI_task_parallel_range(
+      0, num_vertices, &data, reshape_subdiv_refine_task, &parallel_range_settings);
+
+  reshape_subdiv->evaluator->setCoarsePositions(
+      reshape_subdiv->evaluator, &data.coarse_positions[0][0], 0, num_vertices);
+  MEM_freeN(data.coarse_positions);
+
   reshape_subdiv->evaluator->refine(reshape_subdiv->evaluator);
 }
 
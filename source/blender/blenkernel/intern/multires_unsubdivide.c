@@ -33,6 +33,7 @@
 
 #include "BLI_gsqueue.h"
 #include "BLI_math_vector.h"
+#include "BLI_task.h"
 
 #include "BKE_customdata.h"
 #include "BKE_lib_id.h"
@@ -996,6 +997,77 @@ static bool multires_unsubdivide_flip_grid_x_axis(Mesh *mesh, int poly, int loop
   return false;
 }
 
+typedef struct MultiresUnsubdivideExtractGridsData {
+  MultiresUnsubdivideContext *context;
+  BMesh *bm_base_mesh;
+  const int *orig_to_base_vmap;
+  const int *base_to_orig_vmap;
+  int base_l_offset;
+} MultiresUnsubdivideExtractGridsData;
+
+static void multires_unsubdivide_extract_grids_task_cb(
+    void *__restrict userdata,
+    const int base_vertex_index,
+    const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  MultiresUnsubdivideExtractGridsData *data = userdata;
+  MultiresUnsubdivideContext *context = data->context;
+  Mesh *base_mesh = context->base_mesh;
+  BMesh *bm_original_mesh = context->bm_original_mesh;
+  BMesh *bm_base_mesh = data->bm_base_mesh;
+  const int *orig_to_base_vmap = data->orig_to_base_vmap;
+  const int base_l_offset = data->base_l_offset;
+
+  BMIter iter_a, iter_b;
+  BMLoop *l, *lb;
+  BMVert *v = BM_vert_at_index(bm_base_mesh, base_vertex_index);
+
+  /* For each base mesh vertex, get the corresponding #BMVert of the original mesh using the
+   * vertex map. */
+  const int orig_vertex_index = data->base_to_orig_vmap[base_vertex_index];
+  BMVert *vert_original = BM_vert_at_index(bm_original_mesh, orig_vertex_index);
+
+  /* Iterate over the loops of that vertex in the original mesh. */
+  BM_ITER_ELEM (l, &iter_a, vert_original, BM_LOOPS_OF_VERT) {
+    /* For each loop, get the two vertices that should map to the l+1 and l-1 vertices in the
+     * base mesh of the poly of grid that is going to be extracted. */
+    BMVert *corner_x, *corner_y;
+    multires_unsubdivide_get_grid_corners_on_base_mesh(l->f, l->e, &corner_x, &corner_y);
+
+    /* Map the two obtained vertices to the base mesh. */
+    const int corner_x_index = orig_to_base_vmap[BM_elem_index_get(corner_x)];
+    const int corner_y_index = orig_to_base_vmap[BM_elem_index_get(corner_y)];
+
+    /* Iterate over the loops of the same vertex in the base mesh. With the previously obtained
+     * vertices and the current vertex it is possible to get the index of the loop in the base
+     * mesh the grid that is going to be extracted belongs to. */
+    BM_ITER_ELEM (lb, &iter_b, v, BM_LOOPS_OF_VERT) {
+      BMFace *base_face = lb->f;
+      BMVert *base_corner_x = BM_vert_at_index(bm_base_mesh, corner_x_index);
+      BMVert *base_corner_y = BM_vert_at_index(bm_base_mesh, corner_y_index);
+      /* If this is the correct loop in the base mesh, the original vertex and the two corners
+       * should be in the loop's face. */
+      if (BM_vert_in_face(base_corner_x, base_face) && BM_vert_in_face(base_corner_y, base_face)) {
+        /* Get the index of the loop. */
+        const int base_mesh_loop_index = BM_ELEM_CD_GET_INT(lb, base_l_offset);
+        const int base_mesh_face_index = BM_elem_index_get(base_face);
+
+        /* Check the orientation of the loops in case that is needed to flip the x and y axis
+         * when extracting the grid. */
+        const bool flip_grid = multires_unsubdivide_flip_grid_x_axis(
+            base_mesh, base_mesh_face_index, base_mesh_loop_index, corner_x_index);
+
+        /* Extract the grid for that loop. */
+        context->base_mesh_grids[base_mesh_loop_index].grid_index = base_mesh_loop_index;
+        multires_unsubdivide_extract_single_grid_from_face_edge(
+            context, l->f, l->e, !flip_grid, &context->base_mesh_grids[base_mesh_loop_index]);
+
+        break;
+      }
+    }
+  }
+}
+
 static void multires_unsubdivide_extract_grids(MultiresUnsubdivideContext *context)
 {
   Mesh *original_mesh = context->original_mesh;
@@ -1036,9 +1108,6 @@ static void multires_unsubdivide_extract_grids(MultiresUnsubdivideContext *conte
   const int base_l_layer_index = CustomData_get_named_layer_index(
       &base_mesh->ldata, CD_PROP_INT32, lname);
   BMesh *bm_base_mesh = get_bmesh_from_mesh(base_mesh);
-  BMIter iter, iter_a, iter_b;
-  BMVert *v;
-  BMLoop *l, *lb;
 
   BM_mesh_elem_table_ensure(bm_base_mesh, BM_VERT);
   BM_mesh_elem_table_ensure(bm_base_mesh, BM_FACE);
@@ -1047,55 +1116,22 @@ static void multires_unsubdivide_extract_grids(MultiresUnsubdivideContext *conte
   const int base_l_offset = CustomData_get_n_offset(
       &bm_base_mesh->ldata, CD_PROP_INT32, base_l_layer_index);
 
-  /* Main loop for extracting the grids. Iterates over the base mesh vertices. */
-  BM_ITER_MESH (v, &iter, bm_base_mesh, BM_VERTS_OF_MESH) {
-
-    /* For each base mesh vertex, get the corresponding #BMVert of the original mesh using the
-     * vertex map. */
-    const int orig_vertex_index = base_to_orig_vmap[BM_elem_index_get(v)];
-    BMVert *vert_original = BM_vert_at_index(bm_original_mesh, orig_vertex_index);
-
-    /* Iterate over the loops of that vertex in the original mesh. */
-    BM_ITER_ELEM (l, &iter_a, vert_original, BM_LOOPS_OF_VERT) {
-      /* For each loop, get the two vertices that should map to the l+1 and l-1 vertices in the
-       * base mesh of the poly of grid that is going to be extracted. */
-      BMVert *corner_x, *corner_y;
-      multires_unsubdivide_get_grid_corners_on_base_mesh(l->f, l->e, &corner_x, &corner_y);
-
-      /* Map the two obtained vertices to the base mesh. */
-      const int corner_x_index = orig_to_base_vmap[BM_elem_index_get(corner_x)];
-      const int corner_y_index = orig_to_base_vmap[BM_elem_index_get(corner_y)];
-
-      /* Iterate over the loops of the same vertex in the base mesh. With the previously obtained
-       * vertices and the current vertex it is possible to get the index of the loop in the base
-       * mesh the grid that is going to be extracted belongs to. */
-      BM_ITER_ELEM (lb, &iter_b, v, BM_LOOPS_OF_VERT) {
-        BMFace *base_face = lb->f;
-        BMVert *base_corner_x = BM_vert_at_index(bm_base_mesh, corner_x_index);
-        BMVert *base_corner_y = BM_vert_at_index(bm_base_mesh, corner_y_index);
-        /* If this is the correct loop in the base mesh, the original vertex and the two corners
-         * should be in the loop's face. */
-        if (BM_vert_in_face(base_corner_x, base_face) &&
-            BM_vert_in_face(base_corner_y, base_face)) {
-          /* Get the index of the loop. */
-          const int base_mesh_loop_index = BM_ELEM_CD_GET_INT(lb, base_l_offset);
-          const int base_mesh_face_index = BM_elem_index_get(base_face);
-
-          /* Check the orientation of the loops in case that is needed to flip the x and y axis
-           * when extracting the grid. */
-          const bool flip_grid = multires_unsubdivide_flip_grid_x_axis(
-              base_mesh, base_mesh_face_index, base_mesh_loop_index, corner_x_index);
-
-          /* Extract the grid for that loop. */
-          context->base_mesh_grids[base_mesh_loop_index].grid_index = base_mesh_loop_index;
-          multires_unsubdivide_extract_single_grid_from_face_edge(
-              context, l->f, l->e, !flip_grid, &context->base_mesh_grids[base_mesh_loop_index]);
-
-          break;
-        }
-      }
-    }
-  }
+  /* Main loop for extracting the grids. Iterates over the base mesh vertices. Each loop of the
+   * base mesh gets its grid extracted from exactly one vertex, so the vertices can be handled in
+   * parallel. */
+  MultiresUnsubdivideExtractGridsData data = {
+      .context = context,
+      .bm_base_mesh = bm_base_mesh,
+      .orig_to_base_vmap = orig_to_base_vmap,
+      .base_to_orig_vmap = base_to_orig_vmap,
+      .base_l_offset = base_l_offset,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 64;
+  BLI_task_parallel_range(
+      0, bm_base_mesh->totvert, &data, multires_unsubdivide_extract_grids_task_cb, &settings);
 
   MEM_freeN(orig_to_base_vmap);
   MEM_freeN(base_to_orig_vmap);
@@ -1177,6 +1213,36 @@ void multires_unsubdivide_context_free(MultiresUnsubdivideContext *context)
   MEM_SAFE_FREE(context->base_mesh_grids);
 }
 
+typedef struct MultiresUnsubdivideCreateGridsData {
+  const MultiresUnsubdivideContext *context;
+  MDisps *mdisps;
+  int totdisp;
+} MultiresUnsubdivideCreateGridsData;
+
+static void multires_create_grids_task_cb(void *__restrict userdata,
+                                          const int i,
+                                          const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  MultiresUnsubdivideCreateGridsData *data = userdata;
+  const MultiresUnsubdivideContext *context = data->context;
+  MDisps *mdisps = data->mdisps;
+  const int totdisp = data->totdisp;
+
+  float(*disps)[3] = MEM_calloc_arrayN(totdisp, sizeof(float[3]), "multires disps");
+
+  if (mdisps[i].disps) {
+    MEM_freeN(mdisps[i].disps);
+  }
+
+  if (context->base_mesh_grids[i].grid_co) {
+    memcpy(disps, context->base_mesh_grids[i].grid_co, sizeof(float[3]) * totdisp);
+  }
+
+  mdisps[i].disps = disps;
+  mdisps[i].totdisp = totdisp;
+  mdisps[i].level = context->num_total_levels;
+}
+
 /**
  * This function allocates new mdisps with the right size to fit the new extracted grids from the
  * base mesh and copies the data to them.
@@ -1197,23 +1263,16 @@ static void multires_create_grids_in_unsubdivided_base_mesh(MultiresUnsubdivideC
   BLI_assert(base_mesh->totloop == context->num_grids);
 
   /* Allocate the MDISPS grids and copy the extracted data from context. */
-  for (int i = 0; i < totloop; i++) {
-    float(*disps)[3] = MEM_calloc_arrayN(totdisp, sizeof(float[3]), "multires disps");
-
-    if (mdisps[i].disps) {
-      MEM_freeN(mdisps[i].disps);
-    }
-
-    for (int j = 0; j < totdisp; j++) {
-      if (context->base_mesh_grids[i].grid_co) {
-        copy_v3_v3(disps[j], context->base_mesh_grids[i].grid_co[j]);
-      }
-    }
+  MultiresUnsubdivideCreateGridsData data = {
+      .context = context,
+      .mdisps = mdisps,
+      .totdisp = totdisp,
+  };
 
-    mdisps[i].disps = disps;
-    mdisps[i].totdisp = totdisp;
-    mdisps[i].level = context->num_total_levels;
-  }
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 64;
+  BLI_task_parallel_range(0, totloop, &data, multires_create_grids_task_cb, &settings);
 }
 
 int multiresModifier_rebuild_subdiv(struct Depsgraph *depsgraph,
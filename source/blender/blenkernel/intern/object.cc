@@ -274,6 +274,14 @@ static void object_copy_data(Main *bmain, ID *id_dst, const ID *id_src, const in
   }
 }
 
+static void object_free_mesh_modifier_cache(Object *ob)
+{
+  if (ob->runtime.mesh_modifier_cache != nullptr) {
+    BKE_id_free(nullptr, ob->runtime.mesh_modifier_cache);
+    ob->runtime.mesh_modifier_cache = nullptr;
+  }
+}
+
 static void object_free_data(ID *id)
 {
   Object *ob = (Object *)id;
@@ -321,6 +329,8 @@ static void object_free_data(ID *id)
     ob->runtime.curve_cache = nullptr;
   }
 
+  object_free_mesh_modifier_cache(ob);
+
   BKE_previewimg_free(&ob->preview);
 }
 
@@ -5204,12 +5214,13 @@ void BKE_object_runtime_reset_on_copy(Object *object, const int UNUSED(flag))
   runtime->object_as_temp_mesh = nullptr;
   runtime->object_as_temp_curve = nullptr;
   runtime->geometry_set_eval = nullptr;
+  runtime->mesh_modifier_cache = nullptr;
 }
 
 void BKE_object_runtime_free_data(Object *object)
 {
-  /* Currently this is all that's needed. */
   BKE_object_free_derived_caches(object);
+  object_free_mesh_modifier_cache(object);
 
   BKE_object_runtime_reset(object);
 }
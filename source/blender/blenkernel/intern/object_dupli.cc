@@ -89,6 +89,8 @@ struct DupliContext {
 
   Scene *scene;
   Object *object;
+  /** Hash of the name of #object, used for the random id of duplis. */
+  unsigned int object_name_hash;
   float space_mat[4][4];
 
   /**
@@ -129,6 +131,7 @@ static void init_context(DupliContext *r_ctx,
   r_ctx->collection = nullptr;
 
   r_ctx->object = ob;
+  r_ctx->object_name_hash = BLI_hash_string(ob->id.name + 2);
   r_ctx->obedit = OBEDIT_FROM_OBACT(ob);
   r_ctx->instance_stack = &instance_stack;
   if (space_mat) {
@@ -158,7 +161,10 @@ static bool copy_dupli_context(
     r_ctx->collection = ctx->object->instance_collection;
   }
 
-  r_ctx->object = ob;
+  if (r_ctx->object != ob) {
+    r_ctx->object = ob;
+    r_ctx->object_name_hash = BLI_hash_string(ob->id.name + 2);
+  }
   r_ctx->instance_stack = ctx->instance_stack;
   if (mat) {
     mul_m4_m4m4(r_ctx->space_mat, (float(*)[4])ctx->space_mat, mat);
@@ -224,7 +230,8 @@ static DupliObject *make_dupli(const DupliContext *ctx,
 
   /* Random number.
    * The logic here is designed to match Cycles. */
-  dob->random_id = BLI_hash_string(dob->ob->id.name + 2);
+  dob->random_id = (ob == ctx->object) ? ctx->object_name_hash :
+                                         BLI_hash_string(dob->ob->id.name + 2);
 
   if (dob->persistent_id[0] != INT_MAX) {
     for (i = 0; i < MAX_DUPLI_RECUR; i++) {
@@ -236,7 +243,7 @@ static DupliObject *make_dupli(const DupliContext *ctx,
   }
 
   if (ctx->object != ob) {
-    dob->random_id ^= BLI_hash_int(BLI_hash_string(ctx->object->id.name + 2));
+    dob->random_id ^= BLI_hash_int(ctx->object_name_hash);
   }
 
   return dob;
@@ -908,6 +915,12 @@ static void make_duplis_geometry_set_impl(const DupliContext *ctx,
   Span<int> almost_unique_ids = component->almost_unique_ids();
   Span<InstanceReference> references = component->references();
 
+  /* The context for geometry set instances only differs in the persistent id, so it is only
+   * created once. This matters when there are many instances. */
+  DupliContext geometry_set_ctx;
+  bool geometry_set_ctx_initialized = false;
+  bool geometry_set_ctx_is_valid = false;
+
   for (int64_t i : instance_offset_matrices.index_range()) {
     const InstanceReference &reference = references[instance_reference_handles[i]];
     const int id = almost_unique_ids[i];
@@ -958,9 +971,17 @@ static void make_duplis_geometry_set_impl(const DupliContext *ctx,
         float new_transform[4][4];
         mul_m4_m4m4(new_transform, parent_transform, instance_offset_matrices[i].values);
 
-        DupliContext sub_ctx;
-        if (copy_dupli_context(&sub_ctx, instances_ctx, instances_ctx->object, nullptr, id)) {
-          make_duplis_geometry_set_impl(&sub_ctx, reference.geometry_set(), new_transform, true);
+        if (!geometry_set_ctx_initialized) {
+          geometry_set_ctx_is_valid = copy_dupli_context(
+              &geometry_set_ctx, instances_ctx, instances_ctx->object, nullptr, id);
+          geometry_set_ctx_initialized = true;
+        }
+        else {
+          geometry_set_ctx.persistent_id[instances_ctx->level] = id;
+        }
+        if (geometry_set_ctx_is_valid) {
+          make_duplis_geometry_set_impl(
+              &geometry_set_ctx, reference.geometry_set(), new_transform, true);
         }
         break;
       }
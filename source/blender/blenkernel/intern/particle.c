@@ -2687,10 +2687,34 @@ void psys_find_parents(ParticleSimulationData *sim, const bool use_render_params
 
   BLI_kdtree_3d_balance(tree);
 
-  for (; p < totchild; p++, cpa++) {
-    psys_particle_on_emitter(
-        sim->psmd, from, cpa->num, DMCACHE_ISCHILD, cpa->fuv, cpa->foffset, co, 0, 0, 0, orco);
-    cpa->parent = BLI_kdtree_3d_find_nearest(tree, orco, NULL);
+  /* Gather the remaining children first, so their parents are found in a single batch. */
+  const int children_len = totchild - p;
+  if (children_len > 0) {
+    ChildParticle *children = cpa;
+    float(*orcos)[3] = MEM_malloc_arrayN(children_len, sizeof(*orcos), __func__);
+    int *parents = MEM_malloc_arrayN(children_len, sizeof(*parents), __func__);
+
+    for (int i = 0; i < children_len; i++, cpa++) {
+      psys_particle_on_emitter(sim->psmd,
+                               from,
+                               cpa->num,
+                               DMCACHE_ISCHILD,
+                               cpa->fuv,
+                               cpa->foffset,
+                               co,
+                               0,
+                               0,
+                               0,
+                               orcos[i]);
+    }
+    BLI_kdtree_3d_find_nearest_batch(
+        tree, (const float(*)[3])orcos, (uint)children_len, parents, NULL);
+    for (int i = 0; i < children_len; i++) {
+      children[i].parent = parents[i];
+    }
+
+    MEM_freeN(orcos);
+    MEM_freeN(parents);
   }
 
   BLI_kdtree_3d_free(tree);
@@ -2802,14 +2826,6 @@ static bool psys_thread_context_init_path(ParticleThreadContext *ctx,
   return true;
 }
 
-static void psys_task_init_path(ParticleTask *task, ParticleSimulationData *sim)
-{
-  /* init random number generator */
-  int seed = 31415926 + sim->psys->seed;
-
-  task->rng_path = BLI_rng_new(seed);
-}
-
 /* NOTE: this function must be thread safe, except for branching! */
 static void psys_thread_create_path(ParticleTask *task,
                                     struct ChildParticle *cpa,
@@ -3143,20 +3159,18 @@ static void psys_thread_create_path(ParticleTask *task,
   }
 }
 
-static void exec_child_path_cache(TaskPool *__restrict UNUSED(pool), void *taskdata)
+static void exec_child_path_cache(void *__restrict userdata,
+                                  const int iter,
+                                  const TaskParallelTLS *__restrict UNUSED(tls))
 {
-  ParticleTask *task = taskdata;
-  ParticleThreadContext *ctx = task->ctx;
+  ParticleThreadContext *ctx = userdata;
   ParticleSystem *psys = ctx->sim.psys;
-  ParticleCacheKey **cache = psys->childcache;
-  ChildParticle *cpa;
-  int i;
+  /* Paths only use the context of the task, random values are hashed from the particle index. */
+  ParticleTask task = {.ctx = ctx};
+  const int i = (ctx->parent_pass ? 0 : ctx->totparent) + iter;
 
-  cpa = psys->child + task->begin;
-  for (i = task->begin; i < task->end; i++, cpa++) {
-    BLI_assert(i < psys->totchildcache);
-    psys_thread_create_path(task, cpa, cache[i], i);
-  }
+  BLI_assert(i < psys->totchildcache);
+  psys_thread_create_path(&task, &psys->child[i], psys->childcache[i], i);
 }
 
 void psys_cache_child_paths(ParticleSimulationData *sim,
@@ -3164,22 +3178,17 @@ void psys_cache_child_paths(ParticleSimulationData *sim,
                             const bool editupdate,
                             const bool use_render_params)
 {
-  TaskPool *task_pool;
   ParticleThreadContext ctx;
-  ParticleTask *tasks_parent, *tasks_child;
-  int numtasks_parent, numtasks_child;
-  int i, totchild, totparent;
+  int totchild, totparent;
 
   if (sim->psys->flag & PSYS_GLOBAL_HAIR) {
     return;
   }
 
-  /* create a task pool for child path tasks */
   if (!psys_thread_context_init_path(&ctx, sim, sim->scene, cfra, editupdate, use_render_params)) {
     return;
   }
 
-  task_pool = BLI_task_pool_create(&ctx, TASK_PRIORITY_LOW);
   totchild = ctx.totchild;
   totparent = ctx.totparent;
 
@@ -3195,32 +3204,19 @@ void psys_cache_child_paths(ParticleSimulationData *sim,
     sim->psys->totchildcache = totchild;
   }
 
+  /* The cost of a path varies a lot with the child modifiers, let the scheduler balance small
+   * chunks of paths between threads. */
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 64;
+
   /* cache parent paths */
   ctx.parent_pass = 1;
-  psys_tasks_create(&ctx, 0, totparent, &tasks_parent, &numtasks_parent);
-  for (i = 0; i < numtasks_parent; i++) {
-    ParticleTask *task = &tasks_parent[i];
-
-    psys_task_init_path(task, sim);
-    BLI_task_pool_push(task_pool, exec_child_path_cache, task, false, NULL);
-  }
-  BLI_task_pool_work_and_wait(task_pool);
+  BLI_task_parallel_range(0, totparent, &ctx, exec_child_path_cache, &settings);
 
-  /* cache child paths */
+  /* cache child paths, they are interpolated from the parents */
   ctx.parent_pass = 0;
-  psys_tasks_create(&ctx, totparent, totchild, &tasks_child, &numtasks_child);
-  for (i = 0; i < numtasks_child; i++) {
-    ParticleTask *task = &tasks_child[i];
-
-    psys_task_init_path(task, sim);
-    BLI_task_pool_push(task_pool, exec_child_path_cache, task, false, NULL);
-  }
-  BLI_task_pool_work_and_wait(task_pool);
-
-  BLI_task_pool_free(task_pool);
-
-  psys_tasks_free(tasks_parent, numtasks_parent);
-  psys_tasks_free(tasks_child, numtasks_child);
+  BLI_task_parallel_range(0, totchild - totparent, &ctx, exec_child_path_cache, &settings);
 
   psys_thread_context_free(&ctx);
 }
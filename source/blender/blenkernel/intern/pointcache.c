@@ -2128,6 +2128,16 @@ static int ptcache_mem_frame_to_disk(PTCacheID *pid, PTCacheMem *pm)
   return error == 0;
 }
 
+/* Forget about a disk cache frame that couldn't be read (e.g. removed outside of Blender), so it
+ * is simulated again instead. */
+static void ptcache_disk_frame_read_failed(PTCacheID *pid, int cfra)
+{
+  PointCache *cache = pid->cache;
+  if (cache->cached_frames && cfra >= cache->startframe && cfra <= cache->endframe) {
+    cache->cached_frames[cfra - cache->startframe] = 0;
+  }
+}
+
 static int ptcache_read_stream(PTCacheID *pid, int cfra)
 {
   PTCacheFile *pf = ptcache_file_open(pid, PTCACHE_FILE_READ, cfra);
@@ -2141,6 +2151,7 @@ static int ptcache_read_stream(PTCacheID *pid, int cfra)
     if (G.debug & G_DEBUG) {
       printf("Error opening disk cache file for reading\n");
     }
+    ptcache_disk_frame_read_failed(pid, cfra);
     return 0;
   }
 
@@ -2185,6 +2196,10 @@ static int ptcache_read(PTCacheID *pid, int cfra)
   /* get a memory cache to read from */
   if (pid->cache->flag & PTCACHE_DISK_CACHE) {
     pm = ptcache_disk_frame_to_mem(pid, cfra);
+    if (pm == NULL) {
+      ptcache_disk_frame_read_failed(pid, cfra);
+      return 0;
+    }
   }
   else {
     pm = pid->cache->mem_cache.first;
@@ -2242,6 +2257,10 @@ static int ptcache_interpolate(PTCacheID *pid, float cfra, int cfra1, int cfra2)
   /* get a memory cache to read from */
   if (pid->cache->flag & PTCACHE_DISK_CACHE) {
     pm = ptcache_disk_frame_to_mem(pid, cfra2);
+    if (pm == NULL) {
+      ptcache_disk_frame_read_failed(pid, cfra2);
+      return 0;
+    }
   }
   else {
     pm = pid->cache->mem_cache.first;
@@ -2342,7 +2361,9 @@ int BKE_ptcache_read(PTCacheID *pid, float cfra, bool no_extrapolate_old)
       }
     }
     else if (pid->read_point) {
-      ptcache_read(pid, cfra1);
+      if (!ptcache_read(pid, cfra1)) {
+        return 0;
+      }
     }
   }
 
@@ -2354,10 +2375,14 @@ int BKE_ptcache_read(PTCacheID *pid, float cfra, bool no_extrapolate_old)
     }
     else if (pid->read_point) {
       if (cfra1 && cfra2 && pid->interpolate_point) {
-        ptcache_interpolate(pid, cfra, cfra1, cfra2);
+        if (!ptcache_interpolate(pid, cfra, cfra1, cfra2)) {
+          return 0;
+        }
       }
       else {
-        ptcache_read(pid, cfra2);
+        if (!ptcache_read(pid, cfra2)) {
+          return 0;
+        }
       }
     }
   }
@@ -2769,6 +2794,14 @@ bool BKE_ptcache_id_exist(PTCacheID *pid, int cfra)
   if (pid->cache->flag & PTCACHE_DISK_CACHE) {
     char filename[MAX_PTCACHE_FILE];
 
+    if (pid->cache->cached_frames) {
+      /* The array is filled from the cache directory and kept up to date when frames are written
+       * or cleared, so there is no need to check for the file, which can be slow on network file
+       * systems. Frames that fail to read are removed from it, see
+       * #ptcache_disk_frame_read_failed. */
+      return true;
+    }
+
     ptcache_filename(pid, filename, cfra, 1, 1);
 
     return BLI_exists(filename);
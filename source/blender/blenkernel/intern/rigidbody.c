@@ -35,6 +35,7 @@
 
 #include "BLI_listbase.h"
 #include "BLI_math.h"
+#include "BLI_task.h"
 
 #ifdef WITH_BULLET
 #  include "RBI_api.h"
@@ -1677,12 +1678,15 @@ static void rigidbody_update_sim_world(Scene *scene, RigidBodyWorld *rbw)
   rigidbody_update_ob_array(rbw);
 }
 
-static void rigidbody_update_sim_ob(
-    Depsgraph *depsgraph, Scene *scene, RigidBodyWorld *rbw, Object *ob, RigidBodyOb *rbo)
+/**
+ * \return true when the effectors have to be applied to the object,
+ * this is done for all objects at once by #rigidbody_update_sim_effectors.
+ */
+static bool rigidbody_update_sim_ob(Depsgraph *depsgraph, Object *ob, RigidBodyOb *rbo)
 {
   /* only update if rigid body exists */
   if (rbo->shared->physics_object == NULL) {
-    return;
+    return false;
   }
 
   ViewLayer *view_layer = DEG_get_input_view_layer(depsgraph);
@@ -1727,59 +1731,131 @@ static void rigidbody_update_sim_ob(
   if (is_selected && (G.moving & G_TRANSFORM_OBJ)) {
     RB_body_set_kinematic_state(rbo->shared->physics_object, true);
     RB_body_set_mass(rbo->shared->physics_object, 0.0f);
+    return false;
   }
 
+  /* NOTE: passive objects don't need to be updated since they don't move */
+
+  /* NOTE: no other settings need to be explicitly updated here,
+   * since RNA setters take care of the rest :)
+   */
+
   /* update influence of effectors - but don't do it on an effector */
   /* only dynamic bodies need effector update */
-  else if (rbo->type == RBO_TYPE_ACTIVE &&
-           ((ob->pd == NULL) || (ob->pd->forcefield == PFIELD_NULL))) {
-    EffectorWeights *effector_weights = rbw->effector_weights;
-    EffectedPoint epoint;
-    ListBase *effectors;
+  return rbo->type == RBO_TYPE_ACTIVE && ((ob->pd == NULL) || (ob->pd->forcefield == PFIELD_NULL));
+}
+
+typedef struct RigidbodyEffectorsData {
+  Scene *scene;
+  Depsgraph *depsgraph;
+  EffectorWeights *effector_weights;
+  Object **objects;
+  /** Effectors used for all objects, NULL when they are created for each object. */
+  ListBase *effectors;
+} RigidbodyEffectorsData;
 
+static void rigidbody_update_sim_effectors_cb(void *__restrict userdata,
+                                              const int index,
+                                              const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  RigidbodyEffectorsData *data = userdata;
+  Object *ob = data->objects[index];
+  RigidBodyOb *rbo = ob->rigidbody_object;
+  EffectorWeights *effector_weights = data->effector_weights;
+  EffectedPoint epoint;
+  ListBase *effectors = data->effectors;
+
+  if (effectors == NULL) {
     /* get effectors present in the group specified by effector_weights */
-    effectors = BKE_effectors_create(depsgraph, ob, NULL, effector_weights, false);
-    if (effectors) {
-      float eff_force[3] = {0.0f, 0.0f, 0.0f};
-      float eff_loc[3], eff_vel[3];
-
-      /* create dummy 'point' which represents last known position of object as result of sim */
-      /* XXX: this can create some inaccuracies with sim position,
-       * but is probably better than using un-simulated values? */
-      RB_body_get_position(rbo->shared->physics_object, eff_loc);
-      RB_body_get_linear_velocity(rbo->shared->physics_object, eff_vel);
-
-      pd_point_from_loc(scene, eff_loc, eff_vel, 0, &epoint);
-
-      /* Calculate net force of effectors, and apply to sim object:
-       * - we use 'central force' since apply force requires a "relative position"
-       *   which we don't have... */
-      BKE_effectors_apply(effectors, NULL, effector_weights, &epoint, eff_force, NULL, NULL);
-      if (G.f & G_DEBUG) {
-        printf("\tapplying force (%f,%f,%f) to '%s'\n",
-               eff_force[0],
-               eff_force[1],
-               eff_force[2],
-               ob->id.name + 2);
-      }
-      /* activate object in case it is deactivated */
-      if (!is_zero_v3(eff_force)) {
-        RB_body_activate(rbo->shared->physics_object);
-      }
-      RB_body_apply_central_force(rbo->shared->physics_object, eff_force);
+    effectors = BKE_effectors_create(data->depsgraph, ob, NULL, effector_weights, false);
+  }
+
+  if (effectors) {
+    float eff_force[3] = {0.0f, 0.0f, 0.0f};
+    float eff_loc[3], eff_vel[3];
+
+    /* create dummy 'point' which represents last known position of object as result of sim */
+    /* XXX: this can create some inaccuracies with sim position,
+     * but is probably better than using un-simulated values? */
+    RB_body_get_position(rbo->shared->physics_object, eff_loc);
+    RB_body_get_linear_velocity(rbo->shared->physics_object, eff_vel);
+
+    pd_point_from_loc(data->scene, eff_loc, eff_vel, 0, &epoint);
+
+    /* Calculate net force of effectors, and apply to sim object:
+     * - we use 'central force' since apply force requires a "relative position"
+     *   which we don't have... */
+    BKE_effectors_apply(effectors, NULL, effector_weights, &epoint, eff_force, NULL, NULL);
+    if (G.f & G_DEBUG) {
+      printf("\tapplying force (%f,%f,%f) to '%s'\n",
+             eff_force[0],
+             eff_force[1],
+             eff_force[2],
+             ob->id.name + 2);
     }
-    else if (G.f & G_DEBUG) {
-      printf("\tno forces to apply to '%s'\n", ob->id.name + 2);
+    /* activate object in case it is deactivated */
+    if (!is_zero_v3(eff_force)) {
+      RB_body_activate(rbo->shared->physics_object);
     }
+    RB_body_apply_central_force(rbo->shared->physics_object, eff_force);
+  }
+  else if (G.f & G_DEBUG) {
+    printf("\tno forces to apply to '%s'\n", ob->id.name + 2);
+  }
 
-    /* cleanup */
+  /* cleanup */
+  if (data->effectors == NULL) {
     BKE_effectors_free(effectors);
   }
-  /* NOTE: passive objects don't need to be updated since they don't move */
+}
 
-  /* NOTE: no other settings need to be explicitly updated here,
-   * since RNA setters take care of the rest :)
-   */
+/**
+ * Apply the effectors to all `objects`. The objects are not effectors themselves, so the
+ * effectors are the same for all of them and only have to be created once, forces are then
+ * evaluated and applied to the bodies in parallel.
+ */
+static void rigidbody_update_sim_effectors(Depsgraph *depsgraph,
+                                           Scene *scene,
+                                           RigidBodyWorld *rbw,
+                                           Object **objects,
+                                           const int objects_len)
+{
+  if (objects_len == 0) {
+    return;
+  }
+
+  RigidbodyEffectorsData data = {
+      .scene = scene,
+      .depsgraph = depsgraph,
+      .effector_weights = rbw->effector_weights,
+      .objects = objects,
+      .effectors = BKE_effectors_create(
+          depsgraph, objects[0], NULL, rbw->effector_weights, false),
+  };
+
+  if (data.effectors == NULL && !(G.f & G_DEBUG)) {
+    return;
+  }
+
+  if (data.effectors) {
+    LISTBASE_FOREACH (EffectorCache *, eff, data.effectors) {
+      /* The noise random generator is reseeded when creating the effectors,
+       * so every object has to create its own effectors to keep the same forces. */
+      if (eff->pd->f_noise > 0.0f) {
+        BKE_effectors_free(data.effectors);
+        data.effectors = NULL;
+        break;
+      }
+    }
+  }
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = data.effectors != NULL;
+  settings.min_iter_per_thread = 256;
+  BLI_task_parallel_range(0, objects_len, &data, rigidbody_update_sim_effectors_cb, &settings);
+
+  BKE_effectors_free(data.effectors);
 }
 
 /**
@@ -1821,6 +1897,16 @@ static void rigidbody_update_simulation(Depsgraph *depsgraph,
     FOREACH_COLLECTION_OBJECT_RECURSIVE_END;
   }
 
+  /* Objects the effectors are applied to, once all objects are updated. */
+  int effector_obs_len = 0;
+  int effector_obs_max = 0;
+  FOREACH_COLLECTION_OBJECT_RECURSIVE_BEGIN (rbw->group, ob) {
+    (void)ob;
+    effector_obs_max++;
+  }
+  FOREACH_COLLECTION_OBJECT_RECURSIVE_END;
+  Object **effector_obs = MEM_malloc_arrayN(effector_obs_max, sizeof(Object *), __func__);
+
   /* update objects */
   FOREACH_COLLECTION_OBJECT_RECURSIVE_BEGIN (rbw->group, ob) {
     if (ob->type == OB_MESH) {
@@ -1871,11 +1957,16 @@ static void rigidbody_update_simulation(Depsgraph *depsgraph,
       rbo->flag &= ~(RBO_FLAG_NEEDS_VALIDATE | RBO_FLAG_NEEDS_RESHAPE);
 
       /* update simulation object... */
-      rigidbody_update_sim_ob(depsgraph, scene, rbw, ob, rbo);
+      if (rigidbody_update_sim_ob(depsgraph, ob, rbo)) {
+        effector_obs[effector_obs_len++] = ob;
+      }
     }
   }
   FOREACH_COLLECTION_OBJECT_RECURSIVE_END;
 
+  rigidbody_update_sim_effectors(depsgraph, scene, rbw, effector_obs, effector_obs_len);
+  MEM_freeN(effector_obs);
+
   /* update constraints */
   if (rbw->constraints == NULL) { /* no constraints, move on */
     return;
@@ -27,8 +27,10 @@
 #include "DNA_meshdata_types.h"
 #include "DNA_modifier_types.h"
 
+#include "BLI_hash_mm2a.h"
 #include "BLI_utildefines.h"
 
+#include "BKE_customdata.h"
 #include "BKE_modifier.h"
 #include "BKE_subdiv_modifier.h"
 
@@ -176,14 +178,73 @@ Subdiv *BKE_subdiv_update_from_converter(Subdiv *subdiv,
   return BKE_subdiv_new_from_converter(settings, converter);
 }
 
+/* Hash of all the mesh data which is passed to OpenSubdiv by the mesh converter. Element flags
+ * like selection are skipped, so the hash only changes when the topology refiner does.
+ * Two hashes with different seeds are combined to make accidental matches unlikely enough. */
+static uint64_t subdiv_mesh_topology_hash(const Mesh *mesh)
+{
+  BLI_HashMurmur2A mm2[2];
+  BLI_hash_mm2a_init(&mm2[0], 0);
+  BLI_hash_mm2a_init(&mm2[1], 0x5bd1e995);
+  const int num_uv_layers = CustomData_number_of_layers(&mesh->ldata, CD_MLOOPUV);
+  for (int i = 0; i < 2; i++) {
+    BLI_hash_mm2a_add_int(&mm2[i], mesh->totvert);
+    BLI_hash_mm2a_add_int(&mm2[i], mesh->totedge);
+    BLI_hash_mm2a_add_int(&mm2[i], mesh->totpoly);
+    BLI_hash_mm2a_add_int(&mm2[i], mesh->totloop);
+    BLI_hash_mm2a_add_int(&mm2[i], num_uv_layers);
+    /* Loops only contain vertex and edge indices. */
+    BLI_hash_mm2a_add(&mm2[i], (const uchar *)mesh->mloop, sizeof(MLoop) * mesh->totloop);
+  }
+  for (int poly_index = 0; poly_index < mesh->totpoly; poly_index++) {
+    const MPoly *mpoly = &mesh->mpoly[poly_index];
+    for (int i = 0; i < 2; i++) {
+      BLI_hash_mm2a_add_int(&mm2[i], mpoly->loopstart);
+      BLI_hash_mm2a_add_int(&mm2[i], mpoly->totloop);
+    }
+  }
+  for (int edge_index = 0; edge_index < mesh->totedge; edge_index++) {
+    const MEdge *medge = &mesh->medge[edge_index];
+    for (int i = 0; i < 2; i++) {
+      BLI_hash_mm2a_add_int(&mm2[i], (int)medge->v1);
+      BLI_hash_mm2a_add_int(&mm2[i], (int)medge->v2);
+      BLI_hash_mm2a_add_int(&mm2[i], medge->crease);
+    }
+  }
+  /* The face-varying topology depends on which UV coordinates are equal. */
+  for (int layer_index = 0; layer_index < num_uv_layers; layer_index++) {
+    const MLoopUV *mloopuv = CustomData_get_layer_n(&mesh->ldata, CD_MLOOPUV, layer_index);
+    for (int loop_index = 0; loop_index < mesh->totloop; loop_index++) {
+      for (int i = 0; i < 2; i++) {
+        BLI_hash_mm2a_add(&mm2[i], (const uchar *)mloopuv[loop_index].uv, sizeof(float[2]));
+      }
+    }
+  }
+  return ((uint64_t)BLI_hash_mm2a_end(&mm2[0]) << 32) | BLI_hash_mm2a_end(&mm2[1]);
+}
+
 Subdiv *BKE_subdiv_update_from_mesh(Subdiv *subdiv,
                                     const SubdivSettings *settings,
                                     const Mesh *mesh)
 {
+  /* Comparing the topology refiner with the converter is expensive, so first check whether the
+   * mesh passed to OpenSubdiv is the same as the one the descriptor was created from. This is
+   * the common case when playing back deforming meshes. */
+  const uint64_t topology_hash = subdiv_mesh_topology_hash(mesh);
+  if (subdiv != NULL && subdiv->topology_refiner != NULL && subdiv->has_topology_hash &&
+      subdiv->topology_hash == topology_hash &&
+      BKE_subdiv_settings_equal(&subdiv->settings, settings)) {
+    return subdiv;
+  }
+
   OpenSubdiv_Converter converter;
   BKE_subdiv_converter_init_for_mesh(&converter, settings, mesh);
   subdiv = BKE_subdiv_update_from_converter(subdiv, settings, &converter);
   BKE_subdiv_converter_free(&converter);
+  if (subdiv != NULL) {
+    subdiv->topology_hash = topology_hash;
+    subdiv->has_topology_hash = true;
+  }
   return subdiv;
 }
 
@@ -40,6 +40,9 @@
 #include "BKE_movieclip.h"
 #include "BKE_tracking.h"
 
+#include "IMB_imbuf.h"
+#include "IMB_imbuf_types.h"
+
 #include "libmv-capi.h"
 #include "tracking_private.h"
 
@@ -139,6 +142,10 @@ typedef struct AutoTrackContext {
   int synchronized_scene_frame;
 
   SpinLock spin_lock;
+
+  /* Background pool which loads the frames following the ones being tracked into the movie clip
+   * cache, so that decoding them does not stall the tracking threads on the next step. */
+  TaskPool *prefetch_pool;
 } AutoTrackContext;
 
 /* -------------------------------------------------------------------- */
@@ -564,6 +571,8 @@ AutoTrackContext *BKE_autotrack_context_new(MovieClip *clip,
 
   BLI_spin_init(&context->spin_lock);
 
+  context->prefetch_pool = BLI_task_pool_create_background(context, TASK_PRIORITY_LOW);
+
   return context;
 }
 
@@ -657,12 +666,64 @@ static void autotrack_context_reduce(const void *__restrict UNUSED(userdata),
   BLI_movelisttolist(&autotrack_tls_join->results, &autotrack_tls->results);
 }
 
+typedef struct AutoTrackPrefetchTask {
+  int clip_index;
+  int clip_frame;
+} AutoTrackPrefetchTask;
+
+static void autotrack_context_prefetch_cb(TaskPool *__restrict pool, void *taskdata)
+{
+  const AutoTrackContext *context = BLI_task_pool_user_data(pool);
+  const AutoTrackPrefetchTask *prefetch_task = taskdata;
+  MovieClip *clip = context->autotrack_clips[prefetch_task->clip_index].clip;
+
+  MovieClipUser user = {0};
+  BKE_movieclip_user_set_frame(
+      &user, BKE_movieclip_remap_clip_to_scene_frame(clip, prefetch_task->clip_frame));
+  user.render_size = MCLIP_PROXY_RENDER_SIZE_FULL;
+  user.render_flag = 0;
+
+  /* Only make sure the frame is in the movie clip cache, same as the image accessor uses. */
+  ImBuf *ibuf = BKE_movieclip_get_ibuf(clip, &user);
+  if (ibuf != NULL) {
+    IMB_freeImBuf(ibuf);
+  }
+}
+
+/* Start loading the frames which the next step will track markers to.
+ * Must be called after the frames of the current step have been loaded. */
+static void autotrack_context_prefetch_next_frames(AutoTrackContext *context)
+{
+  const int frame_delta = context->is_backwards ? -1 : 1;
+  bool is_clip_prefetched[MAX_ACCESSOR_CLIP] = {false};
+
+  for (int i = 0; i < context->num_autotrack_markers; i++) {
+    const libmv_Marker *libmv_marker = &context->autotrack_markers[i].libmv_marker;
+    if (is_clip_prefetched[libmv_marker->clip]) {
+      continue;
+    }
+    is_clip_prefetched[libmv_marker->clip] = true;
+
+    AutoTrackPrefetchTask *prefetch_task = MEM_mallocN(sizeof(AutoTrackPrefetchTask),
+                                                       "autotrack prefetch task");
+    prefetch_task->clip_index = libmv_marker->clip;
+    prefetch_task->clip_frame = libmv_marker->frame + 2 * frame_delta;
+    BLI_task_pool_push(
+        context->prefetch_pool, autotrack_context_prefetch_cb, prefetch_task, true, NULL);
+  }
+}
+
 bool BKE_autotrack_context_step(AutoTrackContext *context)
 {
   if (context->num_autotrack_markers == 0) {
     return false;
   }
 
+  /* Wait for the frames this step tracks to, then start loading the ones of the next step while
+   * tracking. All markers of a clip are on the same frame. */
+  BLI_task_pool_work_and_wait(context->prefetch_pool);
+  autotrack_context_prefetch_next_frames(context);
+
   AutoTrackTLS tls;
   BLI_listbase_clear(&tls.results);
 
@@ -817,6 +878,11 @@ void BKE_autotrack_context_finish(AutoTrackContext *context)
 
 void BKE_autotrack_context_free(AutoTrackContext *context)
 {
+  if (context->prefetch_pool != NULL) {
+    BLI_task_pool_cancel(context->prefetch_pool);
+    BLI_task_pool_free(context->prefetch_pool);
+  }
+
   if (context->autotrack != NULL) {
     libmv_autoTrackDestroy(context->autotrack);
   }
@@ -387,7 +387,10 @@ struct VolumeGrid {
     /* Make a deep copy of the grid and remove any reference to a grid in the
      * file cache. Load file grid into memory first if needed. */
     load(volume_name, filepath);
-    /* TODO: avoid deep copy if we are the only user. */
+    if (is_unique_local_grid()) {
+      /* Nothing else references the grid or its tree, so it can be modified without a copy. */
+      return;
+    }
     local_grid = grid()->deepCopyGrid();
     if (entry) {
       GLOBAL_CACHE.remove_user(*entry, is_loaded);
@@ -434,6 +437,16 @@ struct VolumeGrid {
   }
 
  private:
+  bool is_unique_local_grid() const
+  {
+    if (entry != nullptr || !local_grid || local_grid.use_count() != 1) {
+      return false;
+    }
+    /* Copies of the grid that share its tree hold a reference to it,
+     * the returned pointer itself holds another one. */
+    return local_grid->constBaseTreePtr().use_count() == 2;
+  }
+
   const openvdb::GridBase::Ptr &main_grid() const
   {
     return (entry) ? entry->grid : local_grid;
@@ -38,6 +38,7 @@
 
 #  include "BLI_endian_defines.h"
 #  include "BLI_math_base.h"
+#  include "BLI_task.h"
 #  include "BLI_threads.h"
 #  include "BLI_utildefines.h"
 
@@ -58,6 +59,7 @@
 #  include <libavformat/avformat.h>
 #  include <libavutil/imgutils.h>
 #  include <libavutil/opt.h>
+#  include <libavutil/pixdesc.h>
 #  include <libavutil/rational.h>
 #  include <libavutil/samplefmt.h>
 #  include <libswscale/swscale.h>
@@ -91,7 +93,10 @@ typedef struct FFMpegContext {
 
   /* Image frame in Blender's own pixel format, may need conversion to the output pixel format. */
   AVFrame *img_convert_frame;
-  struct SwsContext *img_convert_ctx;
+  /* Conversion contexts of horizontal slices of the frame, converted in parallel. */
+  struct SwsContext **img_convert_ctx;
+  int img_convert_num_slices;
+  int img_convert_slice_height;
 
   uint8_t *audio_input_buffer;
   uint8_t *audio_deinterleave_buffer;
@@ -106,10 +111,43 @@ typedef struct FFMpegContext {
 #  ifdef WITH_AUDASPACE
   AUD_Device *audio_mixdown_device;
 #  endif
+
+  /* Frames are encoded and written in a separate thread, so rendering the next frame doesn't
+   * wait for it. See #ffmpeg_encode_thread(). */
+  ListBase encode_threads;
+  ThreadQueue *encode_queue;
+  /* Protects the members below. */
+  ThreadMutex encode_mutex;
+  ThreadCondition encode_cond;
+  /* Number of frames in the queue or being encoded. */
+  int encode_frames_pending;
+  bool encode_failed;
 } FFMpegContext;
 
+/* A rendered frame waiting to be encoded. */
+typedef struct FFMpegEncodeFrame {
+  uint8_t *pixels;
+  RenderData *rd;
+  int frame;
+  int rectx;
+  int recty;
+#  ifdef WITH_AUDASPACE
+  /* Audio is encoded up to this time after the frame. */
+  double audio_pts;
+#  endif
+  char suffix[FILE_MAX];
+} FFMpegEncodeFrame;
+
 #  define FFMPEG_AUTOSPLIT_SIZE 2000000000
 
+/* Maximum number of rendered frames waiting to be encoded. Rendering waits when the encoder is
+ * this far behind, which bounds the memory used by the queued frames. */
+#  define FFMPEG_ENCODE_MAX_PENDING_FRAMES 4
+
+/* Minimum number of rows converted by one thread. Also a multiple of the chroma subsampling of
+ * all pixel formats, so slices start at a chroma row. */
+#  define FFMPEG_SWSCALE_MIN_SLICE_HEIGHT 64
+
 #  define PRINT \
     if (G.debug & G_DEBUG_FFMPEG) \
     printf
@@ -371,6 +409,111 @@ static int write_video_frame(FFMpegContext *context, AVFrame *frame, ReportList
   return success;
 }
 
+static void ffmpeg_swscale_free(FFMpegContext *context)
+{
+  for (int i = 0; i < context->img_convert_num_slices; i++) {
+    sws_freeContext(context->img_convert_ctx[i]);
+  }
+  MEM_SAFE_FREE(context->img_convert_ctx);
+  context->img_convert_num_slices = 0;
+}
+
+/* Create the contexts converting RGBA frames to the output pixel format. The frame is split into
+ * horizontal slices converted in parallel, each with its own context since they keep state of
+ * the rows they converted. */
+static bool ffmpeg_swscale_init(FFMpegContext *context, enum AVPixelFormat pix_fmt)
+{
+  const int width = context->video_codec->width;
+  const int height = context->video_codec->height;
+
+  const AVPixFmtDescriptor *pix_fmt_descriptor = av_pix_fmt_desc_get(pix_fmt);
+  int num_slices = 1;
+  /* Palette formats store the palette in the second plane, which can't be offset. */
+  if (pix_fmt_descriptor != NULL && (pix_fmt_descriptor->flags & AV_PIX_FMT_FLAG_PAL) == 0) {
+    const int max_slices = height / FFMPEG_SWSCALE_MIN_SLICE_HEIGHT;
+    num_slices = max_ii(1, min_ii(BLI_system_thread_count(), max_slices));
+  }
+
+  int slice_height = divide_ceil_u(height, num_slices);
+  slice_height = divide_ceil_u(slice_height, FFMPEG_SWSCALE_MIN_SLICE_HEIGHT) *
+                 FFMPEG_SWSCALE_MIN_SLICE_HEIGHT;
+  num_slices = divide_ceil_u(height, slice_height);
+
+  context->img_convert_ctx = MEM_callocN(sizeof(*context->img_convert_ctx) * num_slices,
+                                         "ffmpeg swscale contexts");
+  context->img_convert_num_slices = num_slices;
+  context->img_convert_slice_height = slice_height;
+
+  for (int i = 0; i < num_slices; i++) {
+    const int slice_rows = min_ii(slice_height, height - i * slice_height);
+    context->img_convert_ctx[i] = sws_getContext(width,
+                                                 slice_rows,
+                                                 AV_PIX_FMT_RGBA,
+                                                 width,
+                                                 slice_rows,
+                                                 pix_fmt,
+                                                 SWS_BICUBIC,
+                                                 NULL,
+                                                 NULL,
+                                                 NULL);
+    if (context->img_convert_ctx[i] == NULL) {
+      ffmpeg_swscale_free(context);
+      return false;
+    }
+  }
+
+  return true;
+}
+
+typedef struct FFMpegSwscaleData {
+  FFMpegContext *context;
+  int num_planes;
+  int chroma_shift;
+} FFMpegSwscaleData;
+
+static void ffmpeg_swscale_slice(void *__restrict userdata,
+                                 const int slice,
+                                 const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const FFMpegSwscaleData *data = userdata;
+  const FFMpegContext *context = data->context;
+  const AVFrame *input = context->img_convert_frame;
+  AVFrame *output = context->current_frame;
+  const int y = slice * context->img_convert_slice_height;
+  const int height = min_ii(context->img_convert_slice_height, output->height - y);
+
+  const uint8_t *src[4] = {input->data[0] + (ptrdiff_t)y * input->linesize[0], 0, 0, 0};
+
+  uint8_t *dst[4];
+  for (int plane = 0; plane < 4; plane++) {
+    dst[plane] = output->data[plane];
+    if (plane < data->num_planes) {
+      const int shift = (plane == 1 || plane == 2) ? data->chroma_shift : 0;
+      dst[plane] += (ptrdiff_t)(y >> shift) * output->linesize[plane];
+    }
+  }
+
+  sws_scale(
+      context->img_convert_ctx[slice], src, input->linesize, 0, height, dst, output->linesize);
+}
+
+/* Convert the RGBA frame to the output pixel format. */
+static void ffmpeg_swscale(FFMpegContext *context)
+{
+  const enum AVPixelFormat pix_fmt = context->current_frame->format;
+  FFMpegSwscaleData data = {
+      .context = context,
+      .num_planes = av_pix_fmt_count_planes(pix_fmt),
+      .chroma_shift = av_pix_fmt_desc_get(pix_fmt)->log2_chroma_h,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1;
+  BLI_task_parallel_range(
+      0, context->img_convert_num_slices, &data, ffmpeg_swscale_slice, &settings);
+}
+
 /* read and encode a frame of video from the buffer */
 static AVFrame *generate_video_frame(FFMpegContext *context, const uint8_t *pixels)
 {
@@ -416,13 +559,7 @@ static AVFrame *generate_video_frame(FFMpegContext *context, const uint8_t *pixe
   /* Convert to the output pixel format, if it's different that Blender's internal one. */
   if (context->img_convert_frame != NULL) {
     BLI_assert(context->img_convert_ctx != NULL);
-    sws_scale(context->img_convert_ctx,
-              (const uint8_t *const *)rgb_frame->data,
-              rgb_frame->linesize,
-              0,
-              codec->height,
-              context->current_frame->data,
-              context->current_frame->linesize);
+    ffmpeg_swscale(context);
   }
 
   return context->current_frame;
@@ -565,6 +702,75 @@ static AVRational calc_time_base(uint den, double num, int codec_id)
 
 /* prepare a video stream for the output file */
 
+/* Hardware encoders for `codec_id`, in order of preference, terminated by NULL. */
+static const char *const *get_hardware_encoder_names(int codec_id)
+{
+  if (codec_id == AV_CODEC_ID_H264) {
+#  ifdef __APPLE__
+    static const char *const names[] = {"h264_videotoolbox", NULL};
+#  else
+    static const char *const names[] = {"h264_nvenc", "h264_qsv", "h264_amf", NULL};
+#  endif
+    return names;
+  }
+  return NULL;
+}
+
+/* First pixel format of `codec` that is stored in memory, hardware encoders also accept frames
+ * in GPU memory. */
+static enum AVPixelFormat get_software_pixel_format(const AVCodec *codec)
+{
+  if (codec->pix_fmts == NULL) {
+    return AV_PIX_FMT_NONE;
+  }
+  for (const enum AVPixelFormat *pix_fmt = codec->pix_fmts; *pix_fmt != AV_PIX_FMT_NONE;
+       pix_fmt++) {
+    const AVPixFmtDescriptor *descriptor = av_pix_fmt_desc_get(*pix_fmt);
+    if (descriptor && (descriptor->flags & AV_PIX_FMT_FLAG_HWACCEL) == 0) {
+      return *pix_fmt;
+    }
+  }
+  return AV_PIX_FMT_NONE;
+}
+
+/* Find a hardware encoder for `codec_id` that can be used on this system. Encoders are compiled
+ * into FFmpeg regardless of the available hardware and drivers, so they are tested by opening
+ * them. Returns NULL to use the software encoder. */
+static AVCodec *find_hardware_encoder(int codec_id, int width, int height)
+{
+  const char *const *names = get_hardware_encoder_names(codec_id);
+  if (names == NULL) {
+    return NULL;
+  }
+
+  for (; *names; names++) {
+    AVCodec *codec = avcodec_find_encoder_by_name(*names);
+    if (codec == NULL) {
+      continue;
+    }
+    const enum AVPixelFormat pix_fmt = get_software_pixel_format(codec);
+    if (pix_fmt == AV_PIX_FMT_NONE) {
+      continue;
+    }
+
+    AVCodecContext *c = avcodec_alloc_context3(codec);
+    c->width = width;
+    c->height = height;
+    c->pix_fmt = pix_fmt;
+    c->time_base = (AVRational){1, 25};
+    const int ret = avcodec_open2(c, codec, NULL);
+    avcodec_free_context(&c);
+
+    if (ret >= 0) {
+      PRINT("Using hardware encoder %s\n", codec->name);
+      return codec;
+    }
+    PRINT("Hardware encoder %s is not available: %s\n", codec->name, av_err2str(ret));
+  }
+
+  return NULL;
+}
+
 static AVStream *alloc_video_stream(FFMpegContext *context,
                                     RenderData *rd,
                                     int codec_id,
@@ -593,7 +799,14 @@ static AVStream *alloc_video_stream(FFMpegContext *context,
   c->codec_id = codec_id;
   c->codec_type = AVMEDIA_TYPE_VIDEO;
 
-  codec = avcodec_find_encoder(c->codec_id);
+  codec = NULL;
+  if (rd->ffcodecdata.flags & FFMPEG_USE_HARDWARE_ENCODER) {
+    codec = find_hardware_encoder(codec_id, rectx, recty);
+  }
+  const bool is_hardware_encoder = codec != NULL;
+  if (!is_hardware_encoder) {
+    codec = avcodec_find_encoder(c->codec_id);
+  }
   if (!codec) {
     fprintf(stderr, "Couldn't find valid video codec\n");
     avcodec_free_context(&c);
@@ -651,7 +864,15 @@ static AVStream *alloc_video_stream(FFMpegContext *context,
      * Set this to always be zero for other codecs as well.
      * We don't care about bit rate in crf mode. */
     c->bit_rate = 0;
-    ffmpeg_dict_set_int(&opts, "crf", context->ffmpeg_crf);
+    if (is_hardware_encoder) {
+      /* Hardware encoders have no CRF, use their constant quality modes: "cq" is used by NVENC,
+       * the global quality by QSV. */
+      ffmpeg_dict_set_int(&opts, "cq", context->ffmpeg_crf);
+      c->global_quality = context->ffmpeg_crf;
+    }
+    else {
+      ffmpeg_dict_set_int(&opts, "crf", context->ffmpeg_crf);
+    }
   }
   else {
     c->bit_rate = context->ffmpeg_video_bitrate * 1000;
@@ -660,7 +881,8 @@ static AVStream *alloc_video_stream(FFMpegContext *context,
     c->rc_buffer_size = rd->ffcodecdata.rc_buffer_size * 1024;
   }
 
-  if (context->ffmpeg_preset) {
+  /* The presets of hardware encoders have other names, keep their defaults. */
+  if (context->ffmpeg_preset && !is_hardware_encoder) {
     /* 'preset' is used by h.264, 'deadline' is used by webm/vp9. I'm not
      * setting those properties conditionally based on the video codec,
      * as the FFmpeg encoder simply ignores unknown settings anyway. */
@@ -737,6 +959,11 @@ static AVStream *alloc_video_stream(FFMpegContext *context,
     c->pix_fmt = AV_PIX_FMT_YUV444P;
   }
 
+  /* Hardware encoders often don't support 4:4:4, and list formats in GPU memory first. */
+  if (is_hardware_encoder) {
+    c->pix_fmt = get_software_pixel_format(codec);
+  }
+
   if (codec_id == AV_CODEC_ID_PNG) {
     if (rd->im_format.planes == R_IMF_PLANES_RGBA) {
       c->pix_fmt = AV_PIX_FMT_RGBA;
@@ -793,16 +1020,7 @@ static AVStream *alloc_video_stream(FFMpegContext *context,
   else {
     /* Output pixel format is different, allocate frame for conversion. */
     context->img_convert_frame = alloc_picture(AV_PIX_FMT_RGBA, c->width, c->height);
-    context->img_convert_ctx = sws_getContext(c->width,
-                                              c->height,
-                                              AV_PIX_FMT_RGBA,
-                                              c->width,
-                                              c->height,
-                                              c->pix_fmt,
-                                              SWS_BICUBIC,
-                                              NULL,
-                                              NULL,
-                                              NULL);
+    ffmpeg_swscale_init(context, c->pix_fmt);
   }
 
   avcodec_parameters_from_context(st->codecpar, c);
@@ -1391,6 +1609,10 @@ int BKE_ffmpeg_start(void *context_v,
         scene, specs, preview ? rd->psfra : rd->sfra, rd->ffcodecdata.audio_volume);
   }
 #  endif
+
+  if (success) {
+    ffmpeg_encode_start(context);
+  }
   return success;
 }
 
@@ -1411,29 +1633,22 @@ static void write_audio_frames(FFMpegContext *context, double to_pts)
 }
 #  endif
 
-int BKE_ffmpeg_append(void *context_v,
-                      RenderData *rd,
-                      int start_frame,
-                      int frame,
-                      int *pixels,
-                      int rectx,
-                      int recty,
-                      const char *suffix,
-                      ReportList *reports)
+/* Encode a frame and the audio up to the next frame. Runs in the encode thread. */
+static int encode_frame(FFMpegContext *context, FFMpegEncodeFrame *frame_data)
 {
-  FFMpegContext *context = context_v;
   AVFrame *avframe;
   int success = 1;
 
-  PRINT("Writing frame %i, render width=%d, render height=%d\n", frame, rectx, recty);
+  PRINT("Writing frame %i, render width=%d, render height=%d\n",
+        frame_data->frame,
+        frame_data->rectx,
+        frame_data->recty);
 
   if (context->video_stream) {
-    avframe = generate_video_frame(context, (unsigned char *)pixels);
-    success = (avframe && write_video_frame(context, avframe, reports));
+    avframe = generate_video_frame(context, frame_data->pixels);
+    success = (avframe && write_video_frame(context, avframe, NULL));
 #  ifdef WITH_AUDASPACE
-    /* Add +1 frame because we want to encode audio up until the next video frame. */
-    write_audio_frames(
-        context, (frame - start_frame + 1) / (((double)rd->frs_sec) / (double)rd->frs_sec_base));
+    write_audio_frames(context, frame_data->audio_pts);
 #  endif
 
     if (context->ffmpeg_autosplit) {
@@ -1441,7 +1656,12 @@ int BKE_ffmpeg_append(void *context_v,
         end_ffmpeg_impl(context, true);
         context->ffmpeg_autosplit_count++;
 
-        success &= start_ffmpeg_impl(context, rd, rectx, recty, suffix, reports);
+        success &= start_ffmpeg_impl(context,
+                                     frame_data->rd,
+                                     frame_data->rectx,
+                                     frame_data->recty,
+                                     frame_data->suffix,
+                                     NULL);
       }
     }
   }
@@ -1449,6 +1669,121 @@ int BKE_ffmpeg_append(void *context_v,
   return success;
 }
 
+static void *ffmpeg_encode_thread(void *context_v)
+{
+  FFMpegContext *context = context_v;
+  FFMpegEncodeFrame *encode_frame_data;
+
+  while ((encode_frame_data = BLI_thread_queue_pop(context->encode_queue))) {
+    /* After an error the remaining frames are dropped, the output can't be recovered. */
+    bool failed;
+    BLI_mutex_lock(&context->encode_mutex);
+    failed = context->encode_failed;
+    BLI_mutex_unlock(&context->encode_mutex);
+
+    if (!failed) {
+      failed = !encode_frame(context, encode_frame_data);
+    }
+
+    MEM_freeN(encode_frame_data->pixels);
+    MEM_freeN(encode_frame_data);
+
+    BLI_mutex_lock(&context->encode_mutex);
+    context->encode_failed |= failed;
+    context->encode_frames_pending--;
+    BLI_condition_notify_all(&context->encode_cond);
+    BLI_mutex_unlock(&context->encode_mutex);
+  }
+
+  return NULL;
+}
+
+static void ffmpeg_encode_start(FFMpegContext *context)
+{
+  context->encode_queue = BLI_thread_queue_init();
+  BLI_mutex_init(&context->encode_mutex);
+  BLI_condition_init(&context->encode_cond);
+  context->encode_frames_pending = 0;
+  context->encode_failed = false;
+
+  BLI_threadpool_init(&context->encode_threads, ffmpeg_encode_thread, 1);
+  BLI_threadpool_insert(&context->encode_threads, context);
+}
+
+/* Wait for all queued frames to be encoded and stop the encode thread. */
+static void ffmpeg_encode_finish(FFMpegContext *context)
+{
+  if (context->encode_queue == NULL) {
+    return;
+  }
+
+  BLI_thread_queue_nowait(context->encode_queue);
+  BLI_threadpool_end(&context->encode_threads);
+
+  BLI_thread_queue_free(context->encode_queue);
+  context->encode_queue = NULL;
+  BLI_mutex_end(&context->encode_mutex);
+  BLI_condition_end(&context->encode_cond);
+}
+
+int BKE_ffmpeg_append(void *context_v,
+                      RenderData *rd,
+                      int start_frame,
+                      int frame,
+                      int *pixels,
+                      int rectx,
+                      int recty,
+                      const char *suffix,
+                      ReportList *reports)
+{
+  FFMpegContext *context = context_v;
+
+  if (context->video_stream == NULL || context->encode_queue == NULL) {
+    return 1;
+  }
+
+  /* Wait until the encode thread has room for the frame. */
+  BLI_mutex_lock(&context->encode_mutex);
+  while (context->encode_frames_pending >= FFMPEG_ENCODE_MAX_PENDING_FRAMES &&
+         !context->encode_failed) {
+    BLI_condition_wait(&context->encode_cond, &context->encode_mutex);
+  }
+  const bool failed = context->encode_failed;
+  if (!failed) {
+    context->encode_frames_pending++;
+  }
+  BLI_mutex_unlock(&context->encode_mutex);
+
+  if (failed) {
+    /* Errors of earlier frames are only known now. */
+    BKE_report(reports, RPT_ERROR, "Error writing frame");
+    return 0;
+  }
+
+  /* The render result may be freed or changed before the frame is encoded. */
+  const size_t pixels_size = sizeof(uint8_t[4]) * (size_t)rectx * (size_t)recty;
+  FFMpegEncodeFrame *encode_frame_data = MEM_mallocN(sizeof(FFMpegEncodeFrame),
+                                                     "ffmpeg encode frame");
+  encode_frame_data->pixels = MEM_mallocN(pixels_size, "ffmpeg encode frame pixels");
+  memcpy(encode_frame_data->pixels, pixels, pixels_size);
+  encode_frame_data->rd = rd;
+  encode_frame_data->frame = frame;
+  encode_frame_data->rectx = rectx;
+  encode_frame_data->recty = recty;
+#  ifdef WITH_AUDASPACE
+  /* Add +1 frame because we want to encode audio up until the next video frame. */
+  encode_frame_data->audio_pts = (frame - start_frame + 1) /
+                                 (((double)rd->frs_sec) / (double)rd->frs_sec_base);
+#  else
+  UNUSED_VARS(start_frame);
+#  endif
+  BLI_strncpy(encode_frame_data->suffix, suffix ? suffix : "", sizeof(encode_frame_data->suffix));
+
+  BLI_thread_queue_push(context->encode_queue, encode_frame_data);
+
+  return 1;
+}
+
 static void end_ffmpeg_impl(FFMpegContext *context, int is_autosplit)
 {
   PRINT("Closing ffmpeg...\n");
@@ -1528,15 +1863,13 @@ static void end_ffmpeg_impl(FFMpegContext *context, int is_autosplit)
     context->audio_deinterleave_buffer = NULL;
   }
 
-  if (context->img_convert_ctx != NULL) {
-    sws_freeContext(context->img_convert_ctx);
-    context->img_convert_ctx = NULL;
-  }
+  ffmpeg_swscale_free(context);
 }
 
 void BKE_ffmpeg_end(void *context_v)
 {
   FFMpegContext *context = context_v;
+  ffmpeg_encode_finish(context);
   end_ffmpeg_impl(context, false);
 }
 
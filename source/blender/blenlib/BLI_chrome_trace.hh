@@ -0,0 +1,79 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+
+#pragma once
+
+/** \file
+ * \ingroup bli
+ *
+ * Writer of the Chrome trace event JSON format, which can be loaded in Perfetto or
+ * `chrome://tracing`. Events are written to the file as soon as they are complete, so that large
+ * recordings don't have to be copied into another representation first.
+ *
+ * \code{.cc}
+ * chrome_trace::Writer writer(fp);
+ * writer.event_begin('X', thread_index, start_us);
+ * writer.field("name", "Operation");
+ * writer.field("dur", duration_us);
+ * writer.arg("frame", 1.0);
+ * writer.event_end();
+ * \endcode
+ */
+
+#include <cstdio>
+
+#include "BLI_string_ref.hh"
+#include "BLI_utility_mixins.hh"
+
+namespace blender::chrome_trace {
+
+class Writer : NonCopyable, NonMovable {
+ private:
+  FILE *fp_;
+  bool is_first_event_ = true;
+  bool is_in_event_ = false;
+  bool is_in_args_ = false;
+  /** The next member of the current event or its arguments has to be separated by a comma. */
+  bool needs_comma_ = false;
+
+ public:
+  /** Write the start of the trace, the end is written when the writer is destructed. */
+  explicit Writer(FILE *fp);
+  ~Writer();
+
+  /**
+   * Begin an event of the given phase, e.g. `B` and `E` for the begin and end of a zone or `X`
+   * for a complete event. Timestamps are in microseconds.
+   */
+  void event_begin(char phase, int thread_index, double time_us);
+  void event_end();
+
+  /** Add a field to the current event, all fields have to be added before the arguments. */
+  void field(StringRefNull key, StringRefNull value);
+  void field(StringRefNull key, double value);
+  /** Add an argument to the current event, arguments are shown in the details of the event. */
+  void arg(StringRefNull key, StringRefNull value);
+  void arg(StringRefNull key, double value);
+
+ private:
+  void args_begin();
+  void key(StringRefNull key);
+  void string(StringRefNull str);
+  void number(double value);
+};
+
+}  // namespace blender::chrome_trace
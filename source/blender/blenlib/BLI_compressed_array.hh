@@ -0,0 +1,167 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#pragma once
+
+/** \file
+ * \ingroup bli
+ *
+ * A compressed array stores a large read-only array of trivially copyable elements in pages of a
+ * fixed size, each of which is compressed on its own. Only the pages that are accessed are
+ * decompressed, so arrays that don't fit into memory uncompressed can still be used, e.g. for
+ * attributes of very large point clouds.
+ *
+ * Access goes through a virtual array, see #VArrayImpl_For_CompressedArray. Reading elements in
+ * order is fast, because every thread keeps the page it accessed last decompressed. Random access
+ * in a large array decompresses a page for most accesses, materializing the array in bigger
+ * chunks should be preferred then.
+ */
+
+#include <cstring>
+#include <memory>
+
+#include "BLI_enumerable_thread_specific.hh"
+#include "BLI_index_range.hh"
+#include "BLI_utility_mixins.hh"
+#include "BLI_vector.hh"
+#include "BLI_virtual_array.hh"
+
+namespace blender {
+
+/**
+ * Type independent storage of the compressed pages.
+ */
+class CompressedArrayStorage : NonCopyable, NonMovable {
+ public:
+  /** Size of the uncompressed pages. Large enough to compress well, small enough to be cheap. */
+  static constexpr int64_t default_page_size_in_bytes = 64 * 1024;
+
+ private:
+  struct Page {
+    /** Compressed data, or the plain elements when they don't compress. */
+    void *data = nullptr;
+    int64_t data_size = 0;
+    bool is_compressed = false;
+  };
+
+  struct PageCache {
+    int64_t page_index = -1;
+    Vector<char> buffer;
+  };
+
+  int64_t size_;
+  int64_t element_size_;
+  /** Number of elements per page. */
+  int64_t page_size_;
+  Vector<Page> pages_;
+  mutable threading::EnumerableThreadSpecific<PageCache> page_cache_;
+
+ public:
+  /**
+   * Compress a copy of the given data, which contains \a size elements of \a element_size bytes.
+   */
+  CompressedArrayStorage(const void *data,
+                         int64_t element_size,
+                         int64_t size,
+                         int64_t page_size_in_bytes = default_page_size_in_bytes);
+  ~CompressedArrayStorage();
+
+  int64_t size() const
+  {
+    return size_;
+  }
+
+  int64_t element_size() const
+  {
+    return element_size_;
+  }
+
+  /**
+   * Memory used by the pages, without the decompressed pages cached by threads.
+   */
+  int64_t compressed_size_in_bytes() const;
+
+  /**
+   * Get a pointer to the element at the given index. It stays valid until the next access from
+   * the same thread.
+   */
+  const void *get_element(int64_t index) const;
+
+  /**
+   * Copy the elements in the range to \a dst. Whole pages are decompressed directly into it.
+   */
+  void copy_range(IndexRange range, void *dst) const;
+
+ private:
+  void decompress_page(int64_t page_index, void *dst) const;
+  int64_t page_size_of(int64_t page_index) const;
+};
+
+/**
+ * A read-only virtual array that decompresses the pages of a #CompressedArrayStorage on access.
+ */
+template<typename T> class VArrayImpl_For_CompressedArray final : public VArrayImpl<T> {
+  static_assert(std::is_trivially_copyable_v<T>);
+
+ private:
+  std::shared_ptr<const CompressedArrayStorage> storage_;
+
+ public:
+  VArrayImpl_For_CompressedArray(std::shared_ptr<const CompressedArrayStorage> storage)
+      : VArrayImpl<T>(storage->size()), storage_(std::move(storage))
+  {
+    BLI_assert(storage_->element_size() == sizeof(T));
+  }
+
+ private:
+  T get(const int64_t index) const override
+  {
+    T value;
+    memcpy(&value, storage_->get_element(index), sizeof(T));
+    return value;
+  }
+
+  void materialize(IndexMask mask, MutableSpan<T> r_span) const override
+  {
+    if (mask.is_range()) {
+      const IndexRange range = mask.as_range();
+      storage_->copy_range(range, r_span.slice(range).data());
+    }
+    else {
+      T *dst = r_span.data();
+      mask.foreach_index([&](const int64_t i) { dst[i] = this->get(i); });
+    }
+  }
+
+  void materialize_to_uninitialized(IndexMask mask, MutableSpan<T> r_span) const override
+  {
+    /* Trivially copyable types don't have to be constructed. */
+    this->materialize(mask, r_span);
+  }
+};
+
+/**
+ * Compress a copy of the values and create a virtual array for it.
+ */
+template<typename T> VArray<T> compressed_varray_from_span(const Span<T> values)
+{
+  static_assert(std::is_trivially_copyable_v<T>);
+  auto storage = std::make_shared<const CompressedArrayStorage>(
+      values.data(), sizeof(T), values.size());
+  return VArray<T>::template For<VArrayImpl_For_CompressedArray<T>>(std::move(storage));
+}
+
+}  // namespace blender
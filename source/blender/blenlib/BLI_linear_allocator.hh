@@ -252,4 +252,89 @@ template<typename Allocator = GuardedAllocator> class LinearAllocator : NonCopya
   }
 };
 
+/**
+ * Makes a #LinearAllocator the source of memory for all containers using #ArenaAllocator, that
+ * are constructed on the current thread while this is in scope. All their memory is freed at
+ * once when the scope ends, so they must not outlive it.
+ *
+ * Scopes can be nested, the innermost one is used. Note that parallel code started in the scope
+ * runs tasks on other threads, which don't use the arena, but the current thread might run
+ * tasks that were not started in the scope while waiting. Use #threading::isolate_task if those
+ * may construct containers using #ArenaAllocator that outlive the scope.
+ */
+class ScopedArena : NonCopyable, NonMovable {
+ private:
+  LinearAllocator<> allocator_;
+  ScopedArena *previous_;
+
+ public:
+  ScopedArena() : previous_(active_arena_ref())
+  {
+    active_arena_ref() = this;
+  }
+
+  ~ScopedArena()
+  {
+    BLI_assert(active_arena_ref() == this);
+    active_arena_ref() = previous_;
+  }
+
+  /**
+   * The innermost arena of the current thread, or null when there is none.
+   */
+  static ScopedArena *active()
+  {
+    return active_arena_ref();
+  }
+
+  void *allocate(const int64_t size, const int64_t alignment)
+  {
+    return allocator_.allocate(size, alignment);
+  }
+
+ private:
+  static ScopedArena *&active_arena_ref()
+  {
+    static thread_local ScopedArena *arena = nullptr;
+    return arena;
+  }
+};
+
+/**
+ * An allocator for containers like #Vector, #Map, #Set and #VectorSet, which allocates from the
+ * #ScopedArena that is active on the current thread when the container is constructed.
+ * Deallocation is a no-op then, the memory is released when the arena goes out of scope.
+ * Without an active arena, it behaves like #GuardedAllocator.
+ *
+ * This is useful to avoid the cost of many small allocations and deallocations of temporary
+ * containers, e.g. during the evaluation of a node:
+ *
+ *   ScopedArena arena;
+ *   Vector<int, 4, ArenaAllocator> indices;
+ */
+class ArenaAllocator {
+ private:
+  ScopedArena *arena_;
+
+ public:
+  ArenaAllocator() : arena_(ScopedArena::active())
+  {
+  }
+
+  void *allocate(size_t size, size_t alignment, const char *name)
+  {
+    if (arena_ != nullptr) {
+      return arena_->allocate(static_cast<int64_t>(size), static_cast<int64_t>(alignment));
+    }
+    return MEM_mallocN_aligned(size, alignment, name);
+  }
+
+  void deallocate(void *ptr)
+  {
+    if (arena_ == nullptr) {
+      MEM_freeN(ptr);
+    }
+  }
+};
+
 }  // namespace blender
@@ -35,6 +35,7 @@
  */
 
 #include "BLI_memory_utils.hh"
+#include "BLI_set_slots.hh"
 
 namespace blender {
 
@@ -235,6 +236,135 @@ template<typename Key, typename Value> class SimpleMapSlot {
   }
 };
 
+/**
+ * This map slot implementation stores 7 bits of the hash in the byte that stores the state, like
+ * #FingerprintSetSlot. Most probes that find a different key don't have to compare it.
+ */
+template<typename Key, typename Value> class FingerprintMapSlot {
+ private:
+  /** Occupied slots have the most significant bit set, the other bits are the fingerprint. */
+  enum State : uint8_t {
+    Empty = 0,
+    Removed = 1,
+  };
+
+  uint8_t state_;
+  TypedBuffer<Key> key_buffer_;
+  TypedBuffer<Value> value_buffer_;
+
+ public:
+  FingerprintMapSlot()
+  {
+    state_ = Empty;
+  }
+
+  ~FingerprintMapSlot()
+  {
+    if (this->is_occupied()) {
+      key_buffer_.ref().~Key();
+      value_buffer_.ref().~Value();
+    }
+  }
+
+  FingerprintMapSlot(const FingerprintMapSlot &other)
+  {
+    state_ = other.state_;
+    if (other.is_occupied()) {
+      initialize_pointer_pair(other.key_buffer_.ref(),
+                              other.value_buffer_.ref(),
+                              key_buffer_.ptr(),
+                              value_buffer_.ptr());
+    }
+  }
+
+  FingerprintMapSlot(FingerprintMapSlot &&other) noexcept(
+      std::is_nothrow_move_constructible_v<Key> &&std::is_nothrow_move_constructible_v<Value>)
+  {
+    state_ = other.state_;
+    if (other.is_occupied()) {
+      initialize_pointer_pair(std::move(other.key_buffer_.ref()),
+                              std::move(other.value_buffer_.ref()),
+                              key_buffer_.ptr(),
+                              value_buffer_.ptr());
+    }
+  }
+
+  Key *key()
+  {
+    return key_buffer_;
+  }
+
+  const Key *key() const
+  {
+    return key_buffer_;
+  }
+
+  Value *value()
+  {
+    return value_buffer_;
+  }
+
+  const Value *value() const
+  {
+    return value_buffer_;
+  }
+
+  bool is_occupied() const
+  {
+    return state_ & 0x80;
+  }
+
+  bool is_empty() const
+  {
+    return state_ == Empty;
+  }
+
+  template<typename Hash> uint64_t get_hash(const Hash &hash)
+  {
+    BLI_assert(this->is_occupied());
+    return hash(*key_buffer_);
+  }
+
+  template<typename ForwardKey, typename IsEqual>
+  bool contains(const ForwardKey &key, const IsEqual &is_equal, const uint64_t hash) const
+  {
+    /* Empty and removed slots never match the fingerprint. */
+    if (state_ == slot_hash_fingerprint(hash)) {
+      return is_equal(key, *key_buffer_);
+    }
+    return false;
+  }
+
+  template<typename ForwardKey, typename... ForwardValue>
+  void occupy(ForwardKey &&key, const uint64_t hash, ForwardValue &&...value)
+  {
+    BLI_assert(!this->is_occupied());
+    new (&value_buffer_) Value(std::forward<ForwardValue>(value)...);
+    this->occupy_no_value(std::forward<ForwardKey>(key), hash);
+  }
+
+  template<typename ForwardKey> void occupy_no_value(ForwardKey &&key, const uint64_t hash)
+  {
+    BLI_assert(!this->is_occupied());
+    try {
+      new (&key_buffer_) Key(std::forward<ForwardKey>(key));
+    }
+    catch (...) {
+      value_buffer_.ref().~Value();
+      throw;
+    }
+    state_ = slot_hash_fingerprint(hash);
+  }
+
+  void remove()
+  {
+    BLI_assert(this->is_occupied());
+    key_buffer_.ref().~Key();
+    value_buffer_.ref().~Value();
+    state_ = Removed;
+  }
+};
+
 /**
  * An IntrusiveMapSlot uses two special values of the key to indicate whether the slot is empty
  * or removed. This saves some memory in all cases and is more efficient in many cases. The
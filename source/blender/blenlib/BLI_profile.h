@@ -0,0 +1,68 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#pragma once
+
+/** \file
+ * \ingroup bli
+ *
+ * Profiling markers: zones recorded as a timeline of all threads. The recording is written in the
+ * Chrome trace event JSON format, which can be loaded in Perfetto or `chrome://tracing`.
+ *
+ * The macros compile to nothing unless Blender is built with `WITH_PROFILE_MARKERS`, so markers
+ * can stay in hot code paths.
+ */
+
+#include <stdio.h>
+
+#include "BLI_sys_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct BLI_ProfileZone {
+  /** False when the recording was not active when the zone began. */
+  bool is_recorded;
+} BLI_ProfileZone;
+
+/**
+ * Begin a zone, `name` and `detail` are copied and don't need to outlive the zone.
+ * `detail` can be NULL.
+ */
+BLI_ProfileZone BLI_profile_zone_begin(const char *name, const char *detail);
+void BLI_profile_zone_end(const BLI_ProfileZone *zone);
+
+void BLI_profile_recording_begin(void);
+bool BLI_profile_is_recording(void);
+/**
+ * Stop the recording and write it to `fp` (when not NULL), events are discarded afterwards.
+ * Returns false when there was no recording.
+ */
+bool BLI_profile_recording_end(FILE *fp);
+
+#ifdef WITH_PROFILE_MARKERS
+#  define BLI_PROFILE_ZONE_BEGIN(zone, name, detail) \
+    const BLI_ProfileZone zone = BLI_profile_zone_begin(name, detail)
+#  define BLI_PROFILE_ZONE_END(zone) BLI_profile_zone_end(&zone)
+#else
+#  define BLI_PROFILE_ZONE_BEGIN(zone, name, detail) ((void)0)
+#  define BLI_PROFILE_ZONE_END(zone) ((void)0)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
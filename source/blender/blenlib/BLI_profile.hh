@@ -0,0 +1,55 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#pragma once
+
+/** \file
+ * \ingroup bli
+ *
+ * C++ scoped zones for the profiling markers of `BLI_profile.h`.
+ */
+
+#include "BLI_profile.h"
+#include "BLI_utility_mixins.hh"
+
+namespace blender::profile {
+
+class ScopedZone : NonCopyable, NonMovable {
+ private:
+  BLI_ProfileZone zone_;
+
+ public:
+  ScopedZone(const char *name, const char *detail = nullptr)
+      : zone_(BLI_profile_zone_begin(name, detail))
+  {
+  }
+
+  ~ScopedZone()
+  {
+    BLI_profile_zone_end(&zone_);
+  }
+};
+
+}  // namespace blender::profile
+
+#ifdef WITH_PROFILE_MARKERS
+#  define BLI_PROFILE_SCOPE(name) blender::profile::ScopedZone profile_scoped_zone(name)
+#  define BLI_PROFILE_SCOPE_DETAIL(name, detail) \
+    blender::profile::ScopedZone profile_scoped_zone(name, detail)
+#else
+#  define BLI_PROFILE_SCOPE(name) ((void)0)
+#  define BLI_PROFILE_SCOPE_DETAIL(name, detail) ((void)0)
+#endif
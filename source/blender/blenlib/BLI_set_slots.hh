@@ -274,6 +274,114 @@ template<typename Key> class HashedSetSlot {
   }
 };
 
+/**
+ * Compute the 7 bit fingerprint of a hash that is stored in the state byte of fingerprint slots.
+ * The hash is remixed first, because the low bits are used for the slot index already and the
+ * high bits of many hash functions (e.g. for integers) are always zero.
+ */
+inline uint8_t slot_hash_fingerprint(const uint64_t hash)
+{
+  return static_cast<uint8_t>(((hash * 0x9E3779B97F4A7C15ull) >> 57) | 0x80);
+}
+
+/**
+ * This set slot implementation stores 7 bits of the hash in the byte that stores the state. It is
+ * as small as #SimpleSetSlot, but most probes that find a different key are rejected without
+ * accessing it, which can avoid cache misses and expensive comparisons, e.g. for large keys or
+ * keys that point to other memory.
+ */
+template<typename Key> class FingerprintSetSlot {
+ private:
+  /** Occupied slots have the most significant bit set, the other bits are the fingerprint. */
+  enum State : uint8_t {
+    Empty = 0,
+    Removed = 1,
+  };
+
+  uint8_t state_;
+  TypedBuffer<Key> key_buffer_;
+
+ public:
+  FingerprintSetSlot()
+  {
+    state_ = Empty;
+  }
+
+  ~FingerprintSetSlot()
+  {
+    if (this->is_occupied()) {
+      key_buffer_.ref().~Key();
+    }
+  }
+
+  FingerprintSetSlot(const FingerprintSetSlot &other)
+  {
+    state_ = other.state_;
+    if (other.is_occupied()) {
+      new (&key_buffer_) Key(*other.key_buffer_);
+    }
+  }
+
+  FingerprintSetSlot(FingerprintSetSlot &&other) noexcept(
+      std::is_nothrow_move_constructible_v<Key>)
+  {
+    state_ = other.state_;
+    if (other.is_occupied()) {
+      new (&key_buffer_) Key(std::move(*other.key_buffer_));
+    }
+  }
+
+  Key *key()
+  {
+    return key_buffer_;
+  }
+
+  const Key *key() const
+  {
+    return key_buffer_;
+  }
+
+  bool is_occupied() const
+  {
+    return state_ & 0x80;
+  }
+
+  bool is_empty() const
+  {
+    return state_ == Empty;
+  }
+
+  template<typename Hash> uint64_t get_hash(const Hash &hash) const
+  {
+    BLI_assert(this->is_occupied());
+    return hash(*key_buffer_);
+  }
+
+  template<typename ForwardKey, typename IsEqual>
+  bool contains(const ForwardKey &key, const IsEqual &is_equal, const uint64_t hash) const
+  {
+    /* Empty and removed slots never match the fingerprint. */
+    if (state_ == slot_hash_fingerprint(hash)) {
+      return is_equal(key, *key_buffer_);
+    }
+    return false;
+  }
+
+  template<typename ForwardKey> void occupy(ForwardKey &&key, const uint64_t hash)
+  {
+    BLI_assert(!this->is_occupied());
+    new (&key_buffer_) Key(std::forward<ForwardKey>(key));
+    state_ = slot_hash_fingerprint(hash);
+  }
+
+  void remove()
+  {
+    BLI_assert(this->is_occupied());
+    key_buffer_.ref().~Key();
+    state_ = Removed;
+  }
+};
+
 /**
  * An IntrusiveSetSlot uses two special values of the key to indicate whether the slot is empty or
  * removed. This saves some memory in all cases and is more efficient in many cases. The KeyInfo
@@ -48,6 +48,14 @@ struct BLI_mempool;
 void BLI_task_scheduler_init(void);
 void BLI_task_scheduler_exit(void);
 int BLI_task_scheduler_num_threads(void);
+/**
+ * Opt-in NUMA mode for systems with multiple NUMA nodes, must be set before
+ * #BLI_task_scheduler_init. A task arena with threads pinned to the node is created for every
+ * node, and large `blender::threading::parallel_for` loops are split into a contiguous part per
+ * node. Since the same index ranges are processed on the same nodes, memory that is first
+ * touched in such a loop stays local to the threads that use it in following loops.
+ */
+void BLI_task_scheduler_numa_set(bool use_numa);
 
 /** \} */
 
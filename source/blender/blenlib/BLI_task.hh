@@ -43,11 +43,22 @@
 #  endif
 #endif
 
+#include "BLI_function_ref.hh"
 #include "BLI_index_range.hh"
 #include "BLI_utildefines.h"
 
 namespace blender::threading {
 
+namespace detail {
+/**
+ * Run the loop split over the NUMA nodes, see #BLI_task_scheduler_numa_set.
+ * \return False when the NUMA mode isn't used, then nothing has been done.
+ */
+bool parallel_for_numa(IndexRange range,
+                       int64_t grain_size,
+                       FunctionRef<void(IndexRange)> function);
+}  // namespace detail
+
 template<typename Range, typename Function>
 void parallel_for_each(Range &range, const Function &function)
 {
@@ -69,6 +80,9 @@ void parallel_for(IndexRange range, int64_t grain_size, const Function &function
 #ifdef WITH_TBB
   /* Invoking tbb for small workloads has a large overhead. */
   if (range.size() >= grain_size) {
+    if (detail::parallel_for_numa(range, grain_size, function)) {
+      return;
+    }
     tbb::parallel_for(
         tbb::blocked_range<int64_t>(range.first(), range.one_after_last(), grain_size),
         [&](const tbb::blocked_range<int64_t> &subrange) {
@@ -426,6 +426,14 @@ class VArrayImpl_For_DerivedSpan final : public VMutableArrayImpl<ElemT> {
     SetFunc(data_[index], std::move(value));
   }
 
+  void set_all(Span<ElemT> src) override
+  {
+    /* Avoid the virtual #set call for every element. */
+    for (const int64_t i : src.index_range()) {
+      SetFunc(data_[i], src[i]);
+    }
+  }
+
   void materialize(IndexMask mask, MutableSpan<ElemT> r_span) const override
   {
     ElemT *dst = r_span.data();
@@ -1172,4 +1180,54 @@ inline void devirtualize_varray2(const VArray<T1> &varray1,
   func(varray1, varray2);
 }
 
+namespace detail {
+
+/**
+ * Call the function with the span or the single value of a virtual array that is known to be one
+ * of the two.
+ */
+template<typename T, typename Func>
+inline void devirtualize_span_or_single(const VArray<T> &varray, const Func &func)
+{
+  if (varray.is_span()) {
+    func(varray.get_internal_span());
+  }
+  else {
+    BLI_assert(varray.is_single());
+    func(SingleAsSpan<T>(varray));
+  }
+}
+
+}  // namespace detail
+
+/**
+ * Same as `devirtualize_varray2`, but for three virtual arrays. The function is instantiated for
+ * every combination of spans and single values, and once more for the fallback case.
+ */
+template<typename T1, typename T2, typename T3, typename Func>
+inline void devirtualize_varray3(const VArray<T1> &varray1,
+                                 const VArray<T2> &varray2,
+                                 const VArray<T3> &varray3,
+                                 const Func &func,
+                                 bool enable = true)
+{
+  /* Support disabling the devirtualization to simplify benchmarking. */
+  if (enable) {
+    const bool is_devirtualizable1 = varray1.is_span() || varray1.is_single();
+    const bool is_devirtualizable2 = varray2.is_span() || varray2.is_single();
+    const bool is_devirtualizable3 = varray3.is_span() || varray3.is_single();
+    if (is_devirtualizable1 && is_devirtualizable2 && is_devirtualizable3) {
+      detail::devirtualize_span_or_single(varray1, [&](const auto &varray1) {
+        detail::devirtualize_span_or_single(varray2, [&](const auto &varray2) {
+          detail::devirtualize_span_or_single(
+              varray3, [&](const auto &varray3) { func(varray1, varray2, varray3); });
+        });
+      });
+      return;
+    }
+  }
+  /* Like in #devirtualize_varray2, only optimizing some of the inputs is not worth it. */
+  func(varray1, varray2, varray3);
+}
+
 }  // namespace blender
@@ -51,6 +51,7 @@
 #include "BLI_listbase.h"
 #include "BLI_path_util.h"
 #include "BLI_string.h"
+#include "BLI_task.h"
 
 #include "../imbuf/IMB_imbuf.h"
 
@@ -115,6 +116,29 @@ struct BuildDirCtx {
   int nrfiles;
 };
 
+typedef struct BuildDirStatData {
+  struct direntry *files;
+  const char *dirname;
+} BuildDirStatData;
+
+static void bli_builddir_stat_cb(void *__restrict userdata,
+                                 const int i,
+                                 const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const BuildDirStatData *data = userdata;
+  struct direntry *file = &data->files[i];
+  char fullname[PATH_MAX];
+  BLI_join_dirfile(fullname, sizeof(fullname), data->dirname, file->relname);
+  if (BLI_stat(fullname, &file->s) != -1) {
+    file->type = file->s.st_mode;
+  }
+  else if (FILENAME_IS_CURRPAR(file->relname)) {
+    /* Hack around for UNC paths on windows:
+     * does not support stat on '\\SERVER\foo\..', sigh... */
+    file->type |= S_IFDIR;
+  }
+}
+
 /**
  * Scans the directory named *dirname and appends entries for its contents to files.
  */
@@ -187,23 +211,24 @@ static void bli_builddir(struct BuildDirCtx *dir_ctx, const char *dirname)
         struct dirlink *dlink = (struct dirlink *)dirbase.first;
         struct direntry *file = &dir_ctx->files[dir_ctx->nrfiles];
         while (dlink) {
-          char fullname[PATH_MAX];
           memset(file, 0, sizeof(struct direntry));
           file->relname = dlink->name;
           file->path = BLI_strdupcat(dirname, dlink->name);
-          BLI_join_dirfile(fullname, sizeof(fullname), dirname, dlink->name);
-          if (BLI_stat(fullname, &file->s) != -1) {
-            file->type = file->s.st_mode;
-          }
-          else if (FILENAME_IS_CURRPAR(file->relname)) {
-            /* Hack around for UNC paths on windows:
-             * does not support stat on '\\SERVER\foo\..', sigh... */
-            file->type |= S_IFDIR;
-          }
-          dir_ctx->nrfiles++;
           file++;
           dlink = dlink->next;
         }
+
+        /* Stat the files in parallel, on network file systems the latency of each call is what
+         * makes listing large directories slow. */
+        BuildDirStatData stat_data = {
+            .files = &dir_ctx->files[dir_ctx->nrfiles],
+            .dirname = dirname,
+        };
+        TaskParallelSettings settings;
+        BLI_parallel_range_settings_defaults(&settings);
+        settings.min_iter_per_thread = 16;
+        BLI_task_parallel_range(0, newnum, &stat_data, bli_builddir_stat_cb, &settings);
+        dir_ctx->nrfiles += newnum;
       }
       else {
         printf("Couldn't get memory for dir\n");
@@ -44,6 +44,7 @@
 #include "BLI_heap_simple.h"
 #include "BLI_kdopbvh.h"
 #include "BLI_math.h"
+#include "BLI_simd.h"
 #include "BLI_stack.h"
 #include "BLI_task.h"
 #include "BLI_utildefines.h"
@@ -1096,6 +1097,27 @@ static bool tree_overlap_test(const BVHNode *node1,
   const float *bv2 = node2->bv + (start_axis << 1);
   const float *bv1_end = node1->bv + (stop_axis << 1);
 
+#ifdef BLI_HAVE_SSE2
+  if (stop_axis - start_axis == 3) {
+    /* Test all 3 axes of bounding boxes at once, fetching the (min, max) pairs of the X & Y axes
+     * and of the Y & Z axes. Avoiding branches makes this much faster than the loop below,
+     * since the result is hard to predict. */
+    const __m128 a_xy = _mm_loadu_ps(bv1);
+    const __m128 a_yz = _mm_loadu_ps(bv1 + 2);
+    __m128 b_xy = _mm_loadu_ps(bv2);
+    __m128 b_yz = _mm_loadu_ps(bv2 + 2);
+    /* Swap min & max of the second box, to compare min of one box to max of the other. */
+    b_xy = _mm_shuffle_ps(b_xy, b_xy, _MM_SHUFFLE(2, 3, 0, 1));
+    b_yz = _mm_shuffle_ps(b_yz, b_yz, _MM_SHUFFLE(2, 3, 0, 1));
+    /* Lanes 0 & 2 store `min1 > max2`, lanes 1 & 3 store `max1 < min2`. */
+    const int min_gt_max = _mm_movemask_ps(
+        _mm_or_ps(_mm_cmpgt_ps(a_xy, b_xy), _mm_cmpgt_ps(a_yz, b_yz)));
+    const int max_lt_min = _mm_movemask_ps(
+        _mm_or_ps(_mm_cmplt_ps(a_xy, b_xy), _mm_cmplt_ps(a_yz, b_yz)));
+    return ((min_gt_max & 0x5) | (max_lt_min & 0xA)) == 0;
+  }
+#endif
+
   /* test all axis if min + max overlap */
   for (; bv1 != bv1_end; bv1 += 2, bv2 += 2) {
     if ((bv1[0] > bv2[1]) || (bv2[0] > bv1[1])) {
@@ -0,0 +1,136 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+
+/** \file
+ * \ingroup bli
+ */
+
+#include "BLI_assert.h"
+#include "BLI_chrome_trace.hh"
+
+namespace blender::chrome_trace {
+
+Writer::Writer(FILE *fp) : fp_(fp)
+{
+  fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", fp_);
+}
+
+Writer::~Writer()
+{
+  BLI_assert(!is_in_event_);
+  fputs("\n]}\n", fp_);
+}
+
+void Writer::event_begin(const char phase, const int thread_index, const double time_us)
+{
+  BLI_assert(!is_in_event_);
+  fputs(is_first_event_ ? "\n" : ",\n", fp_);
+  fprintf(fp_, "{\"ph\":\"%c\",\"pid\":1,\"tid\":%d,\"ts\":", phase, thread_index);
+  this->number(time_us);
+  is_first_event_ = false;
+  is_in_event_ = true;
+  needs_comma_ = true;
+}
+
+void Writer::event_end()
+{
+  BLI_assert(is_in_event_);
+  fputs(is_in_args_ ? "}}" : "}", fp_);
+  is_in_event_ = false;
+  is_in_args_ = false;
+}
+
+void Writer::field(const StringRefNull key, const StringRefNull value)
+{
+  BLI_assert(is_in_event_ && !is_in_args_);
+  this->key(key);
+  this->string(value);
+}
+
+void Writer::field(const StringRefNull key, const double value)
+{
+  BLI_assert(is_in_event_ && !is_in_args_);
+  this->key(key);
+  this->number(value);
+}
+
+void Writer::arg(const StringRefNull key, const StringRefNull value)
+{
+  this->args_begin();
+  this->key(key);
+  this->string(value);
+}
+
+void Writer::arg(const StringRefNull key, const double value)
+{
+  this->args_begin();
+  this->key(key);
+  this->number(value);
+}
+
+void Writer::args_begin()
+{
+  BLI_assert(is_in_event_);
+  if (!is_in_args_) {
+    fputs(",\"args\":{", fp_);
+    is_in_args_ = true;
+    needs_comma_ = false;
+  }
+}
+
+void Writer::key(const StringRefNull key)
+{
+  if (needs_comma_) {
+    fputc(',', fp_);
+  }
+  this->string(key);
+  fputc(':', fp_);
+  needs_comma_ = true;
+}
+
+void Writer::string(const StringRefNull str)
+{
+  fputc('"', fp_);
+  for (const char c : str) {
+    switch (c) {
+      case '"':
+        fputs("\\\"", fp_);
+        break;
+      case '\\':
+        fputs("\\\\", fp_);
+        break;
+      default:
+        /* Other characters are written as is, multi-byte UTF-8 sequences are valid JSON. */
+        if ((unsigned char)c < 0x20) {
+          fprintf(fp_, "\\u%04x", (unsigned int)c);
+        }
+        else {
+          fputc(c, fp_);
+        }
+        break;
+    }
+  }
+  fputc('"', fp_);
+}
+
+void Writer::number(const double value)
+{
+  /* Enough precision for microsecond timestamps of long recordings. */
+  fprintf(fp_, "%.15g", value);
+}
+
+}  // namespace blender::chrome_trace
@@ -0,0 +1,149 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/** \file
+ * \ingroup bli
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <zstd.h>
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_compressed_array.hh"
+#include "BLI_task.hh"
+
+namespace blender {
+
+/* Favor speed, pages are decompressed whenever they are accessed. */
+static constexpr int compression_level = 1;
+
+CompressedArrayStorage::CompressedArrayStorage(const void *data,
+                                               const int64_t element_size,
+                                               const int64_t size,
+                                               const int64_t page_size_in_bytes)
+    : size_(size), element_size_(element_size)
+{
+  BLI_assert(element_size > 0);
+  BLI_assert(size >= 0);
+  page_size_ = std::max<int64_t>(page_size_in_bytes / element_size, 1);
+  pages_.resize((size + page_size_ - 1) / page_size_);
+
+  threading::parallel_for(pages_.index_range(), 8, [&](const IndexRange range) {
+    Vector<char> buffer;
+    for (const int64_t page_index : range) {
+      Page &page = pages_[page_index];
+      const void *src = POINTER_OFFSET(data, page_index * page_size_ * element_size);
+      const size_t src_size = size_t(this->page_size_of(page_index) * element_size);
+
+      buffer.resize(int64_t(ZSTD_compressBound(src_size)));
+      const size_t compressed_size = ZSTD_compress(
+          buffer.data(), size_t(buffer.size()), src, src_size, compression_level);
+
+      if (ZSTD_isError(compressed_size) || compressed_size >= src_size) {
+        /* Keep incompressible pages as they are, that also makes accessing them cheaper. */
+        page.data = MEM_mallocN(src_size, __func__);
+        memcpy(page.data, src, src_size);
+        page.data_size = int64_t(src_size);
+        page.is_compressed = false;
+      }
+      else {
+        page.data = MEM_mallocN(compressed_size, __func__);
+        memcpy(page.data, buffer.data(), compressed_size);
+        page.data_size = int64_t(compressed_size);
+        page.is_compressed = true;
+      }
+    }
+  });
+}
+
+CompressedArrayStorage::~CompressedArrayStorage()
+{
+  for (Page &page : pages_) {
+    MEM_freeN(page.data);
+  }
+}
+
+int64_t CompressedArrayStorage::page_size_of(const int64_t page_index) const
+{
+  return std::min(page_size_, size_ - page_index * page_size_);
+}
+
+int64_t CompressedArrayStorage::compressed_size_in_bytes() const
+{
+  int64_t total = 0;
+  for (const Page &page : pages_) {
+    total += page.data_size;
+  }
+  return total;
+}
+
+void CompressedArrayStorage::decompress_page(const int64_t page_index, void *dst) const
+{
+  const Page &page = pages_[page_index];
+  const size_t dst_size = size_t(this->page_size_of(page_index) * element_size_);
+  if (!page.is_compressed) {
+    memcpy(dst, page.data, dst_size);
+    return;
+  }
+  const size_t decompressed_size = ZSTD_decompress(
+      dst, dst_size, page.data, size_t(page.data_size));
+  BLI_assert(decompressed_size == dst_size);
+  UNUSED_VARS_NDEBUG(decompressed_size);
+}
+
+const void *CompressedArrayStorage::get_element(const int64_t index) const
+{
+  BLI_assert(index >= 0 && index < size_);
+  const int64_t page_index = index / page_size_;
+  const int64_t index_in_page = index - page_index * page_size_;
+  const Page &page = pages_[page_index];
+  if (!page.is_compressed) {
+    return POINTER_OFFSET(page.data, index_in_page * element_size_);
+  }
+
+  PageCache &cache = page_cache_.local();
+  if (cache.page_index != page_index) {
+    cache.buffer.resize(page_size_ * element_size_);
+    this->decompress_page(page_index, cache.buffer.data());
+    cache.page_index = page_index;
+  }
+  return POINTER_OFFSET(cache.buffer.data(), index_in_page * element_size_);
+}
+
+void CompressedArrayStorage::copy_range(const IndexRange range, void *dst) const
+{
+  BLI_assert(range.one_after_last() <= size_);
+  int64_t index = range.start();
+  while (index < range.one_after_last()) {
+    const int64_t page_index = index / page_size_;
+    const int64_t page_start = page_index * page_size_;
+    const int64_t page_size = this->page_size_of(page_index);
+    const int64_t copy_end = std::min(page_start + page_size, range.one_after_last());
+    void *copy_dst = POINTER_OFFSET(dst, (index - range.start()) * element_size_);
+
+    if (index == page_start && copy_end == page_start + page_size) {
+      this->decompress_page(page_index, copy_dst);
+    }
+    else {
+      memcpy(copy_dst, this->get_element(index), size_t((copy_end - index) * element_size_));
+    }
+    index = copy_end;
+  }
+}
+
+}  // namespace blender
@@ -28,9 +28,16 @@
 #include "BLI_endian_switch.h"
 #include "BLI_filereader.h"
 #include "BLI_math_base.h"
+#include "BLI_task.h"
 
 #include "MEM_guardedalloc.h"
 
+/**
+ * When reading sequentially, decompress this many frames at once,
+ * distributing the frames over multiple threads.
+ */
+#define ZSTD_READ_AHEAD_FRAMES 8
+
 typedef struct {
   FileReader reader;
 
@@ -45,8 +52,11 @@ typedef struct {
     size_t *compressed_ofs;
     size_t *uncompressed_ofs;
 
+    /* Decompressed content of the frames in range
+     * `[cached_frame, cached_frame + cached_num_frames)`, stored contiguously. */
     char *cached_content;
     int cached_frame;
+    int cached_num_frames;
   } seek;
 } ZstdReader;
 
@@ -170,39 +180,109 @@ static int zstd_frame_from_pos(ZstdReader *zstd, size_t pos)
   return low;
 }
 
-/* Ensure that the currently loaded frame is the correct one. */
+typedef struct ZstdDecompressData {
+  const ZstdReader *zstd;
+  int first_frame;
+  const char *compressed_data;
+  char *uncompressed_data;
+  /* Result of #ZSTD_decompress for every frame. */
+  size_t results[ZSTD_READ_AHEAD_FRAMES];
+} ZstdDecompressData;
+
+static void zstd_decompress_frame_task(void *__restrict userdata,
+                                       const int i,
+                                       const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  ZstdDecompressData *data = userdata;
+  const ZstdReader *zstd = data->zstd;
+  const int frame = data->first_frame + i;
+
+  const size_t *compressed_ofs = zstd->seek.compressed_ofs;
+  const size_t *uncompressed_ofs = zstd->seek.uncompressed_ofs;
+
+  /* Frames get their own context, the reader's context is only used from the calling thread. */
+  data->results[i] = ZSTD_decompress(
+      data->uncompressed_data + (uncompressed_ofs[frame] - uncompressed_ofs[data->first_frame]),
+      uncompressed_ofs[frame + 1] - uncompressed_ofs[frame],
+      data->compressed_data + (compressed_ofs[frame] - compressed_ofs[data->first_frame]),
+      compressed_ofs[frame + 1] - compressed_ofs[frame]);
+}
+
+/* Ensure that the given frame is loaded, returns the start of its uncompressed content. */
 static const char *zstd_ensure_cache(ZstdReader *zstd, int frame)
 {
-  if (zstd->seek.cached_frame == frame) {
-    /* Cached frame matches, so just return it. */
-    return zstd->seek.cached_content;
+  const size_t *compressed_ofs = zstd->seek.compressed_ofs;
+  const size_t *uncompressed_ofs = zstd->seek.uncompressed_ofs;
+
+  if (zstd->seek.cached_frame != -1 && frame >= zstd->seek.cached_frame &&
+      frame < zstd->seek.cached_frame + zstd->seek.cached_num_frames) {
+    /* Cached frames contain the wanted one, so just return it. */
+    return zstd->seek.cached_content +
+           (uncompressed_ofs[frame] - uncompressed_ofs[zstd->seek.cached_frame]);
+  }
+
+  /* When the reader continues right after the cached frames (or starts reading), it's most
+   * likely reading sequentially, so decompress multiple frames ahead in parallel.
+   * Otherwise only decompress the wanted frame, random access shouldn't pay for read-ahead. */
+  int num_frames = 1;
+  if (zstd->seek.cached_frame == -1 ||
+      frame == zstd->seek.cached_frame + zstd->seek.cached_num_frames) {
+    num_frames = min_ii(ZSTD_READ_AHEAD_FRAMES, zstd->seek.num_frames - frame);
   }
 
-  /* Cached frame doesn't match, so discard it and cache the wanted one instead. */
+  /* Cached frames don't match, so discard them and cache the wanted ones instead. */
   MEM_SAFE_FREE(zstd->seek.cached_content);
+  zstd->seek.cached_frame = -1;
+  zstd->seek.cached_num_frames = 0;
 
-  size_t compressed_size = zstd->seek.compressed_ofs[frame + 1] - zstd->seek.compressed_ofs[frame];
-  size_t uncompressed_size = zstd->seek.uncompressed_ofs[frame + 1] -
-                             zstd->seek.uncompressed_ofs[frame];
+  const int end_frame = frame + num_frames;
+  size_t compressed_size = compressed_ofs[end_frame] - compressed_ofs[frame];
+  size_t uncompressed_size = uncompressed_ofs[end_frame] - uncompressed_ofs[frame];
 
   char *uncompressed_data = MEM_mallocN(uncompressed_size, __func__);
   char *compressed_data = MEM_mallocN(compressed_size, __func__);
-  if (zstd->base->seek(zstd->base, zstd->seek.compressed_ofs[frame], SEEK_SET) < 0 ||
+  if (zstd->base->seek(zstd->base, compressed_ofs[frame], SEEK_SET) < 0 ||
       zstd->base->read(zstd->base, compressed_data, compressed_size) < compressed_size) {
     MEM_freeN(compressed_data);
     MEM_freeN(uncompressed_data);
     return NULL;
   }
 
-  size_t res = ZSTD_decompressDCtx(
-      zstd->ctx, uncompressed_data, uncompressed_size, compressed_data, compressed_size);
+  bool success = true;
+  if (num_frames == 1) {
+    size_t res = ZSTD_decompressDCtx(
+        zstd->ctx, uncompressed_data, uncompressed_size, compressed_data, compressed_size);
+    success = !ZSTD_isError(res) && res >= uncompressed_size;
+  }
+  else {
+    ZstdDecompressData data = {
+        .zstd = zstd,
+        .first_frame = frame,
+        .compressed_data = compressed_data,
+        .uncompressed_data = uncompressed_data,
+    };
+
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.min_iter_per_thread = 1;
+    BLI_task_parallel_range(0, num_frames, &data, zstd_decompress_frame_task, &settings);
+
+    for (int i = 0; i < num_frames; i++) {
+      const size_t frame_size = uncompressed_ofs[frame + i + 1] - uncompressed_ofs[frame + i];
+      if (ZSTD_isError(data.results[i]) || data.results[i] < frame_size) {
+        success = false;
+        break;
+      }
+    }
+  }
   MEM_freeN(compressed_data);
-  if (ZSTD_isError(res) || res < uncompressed_size) {
+  if (!success) {
     MEM_freeN(uncompressed_data);
     return NULL;
   }
 
   zstd->seek.cached_frame = frame;
+  zstd->seek.cached_num_frames = num_frames;
   zstd->seek.cached_content = uncompressed_data;
   return uncompressed_data;
 }
@@ -23,6 +23,7 @@
 #include "BLI_kdtree_impl.h"
 #include "BLI_math.h"
 #include "BLI_strict_flags.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #define _CONCAT_AUX(MACRO_ARG1, MACRO_ARG2) MACRO_ARG1##MACRO_ARG2
@@ -58,6 +59,17 @@ struct KDTree {
 
 #define KD_NODE_UNSET ((uint)-1)
 
+/**
+ * Sub-trees with at least this many nodes are balanced in a separate task.
+ * Smaller ones are not worth the threading overhead.
+ */
+#define KD_BALANCE_TASK_NODES_MIN 8192
+
+/**
+ * Number of queries handled by a single thread in batched searches.
+ */
+#define KD_BATCH_QUERIES_PER_THREAD 256
+
 /**
  * When set we know all values are unbalanced,
  * otherwise clear them when re-balancing: see T62210.
@@ -145,7 +157,30 @@ void BLI_kdtree_nd_(insert)(KDTree *tree, int index, const float co[KD_DIMS])
 #endif
 }
 
-static uint kdtree_balance(KDTreeNode *nodes, uint nodes_len, uint axis, const uint ofs)
+typedef struct KDTreeBalanceTaskData {
+  KDTreeNode *nodes;
+  uint nodes_len;
+  uint axis;
+  uint ofs;
+  /** Location of the index of the sub-tree root in its parent node. */
+  uint *r_root;
+} KDTreeBalanceTaskData;
+
+static uint kdtree_balance(
+    TaskPool *pool, KDTreeNode *nodes, uint nodes_len, uint axis, const uint ofs);
+
+static void kdtree_balance_task(TaskPool *__restrict pool, void *taskdata)
+{
+  KDTreeBalanceTaskData *data = taskdata;
+  *data->r_root = kdtree_balance(pool, data->nodes, data->nodes_len, data->axis, data->ofs);
+}
+
+/**
+ * \param pool: When not null, large sub-trees are balanced in tasks pushed to it.
+ * The nodes of both sub-trees are disjoint, so they can be balanced in parallel.
+ */
+static uint kdtree_balance(
+    TaskPool *pool, KDTreeNode *nodes, uint nodes_len, uint axis, const uint ofs)
 {
   KDTreeNode *node;
   float co;
@@ -194,9 +229,20 @@ static uint kdtree_balance(KDTreeNode *nodes, uint nodes_len, uint axis, const u
   node = &nodes[median];
   node->d = axis;
   axis = (axis + 1) % KD_DIMS;
-  node->left = kdtree_balance(nodes, median, axis, ofs);
+  if (pool != NULL && median >= KD_BALANCE_TASK_NODES_MIN) {
+    KDTreeBalanceTaskData *task_data = MEM_mallocN(sizeof(*task_data), __func__);
+    task_data->nodes = nodes;
+    task_data->nodes_len = median;
+    task_data->axis = axis;
+    task_data->ofs = ofs;
+    task_data->r_root = &node->left;
+    BLI_task_pool_push(pool, kdtree_balance_task, task_data, true, NULL);
+  }
+  else {
+    node->left = kdtree_balance(pool, nodes, median, axis, ofs);
+  }
   node->right = kdtree_balance(
-      nodes + median + 1, (nodes_len - (median + 1)), axis, (median + 1) + ofs);
+      pool, nodes + median + 1, (nodes_len - (median + 1)), axis, (median + 1) + ofs);
 
   return median + ofs;
 }
@@ -210,7 +256,16 @@ void BLI_kdtree_nd_(balance)(KDTree *tree)
     }
   }
 
-  tree->root = kdtree_balance(tree->nodes, tree->nodes_len, 0, 0);
+  if (tree->nodes_len >= KD_BALANCE_TASK_NODES_MIN * 2) {
+    /* The result is the same as when balancing on a single thread. */
+    TaskPool *pool = BLI_task_pool_create(NULL, TASK_PRIORITY_HIGH);
+    tree->root = kdtree_balance(pool, tree->nodes, tree->nodes_len, 0, 0);
+    BLI_task_pool_work_and_wait(pool);
+    BLI_task_pool_free(pool);
+  }
+  else {
+    tree->root = kdtree_balance(NULL, tree->nodes, tree->nodes_len, 0, 0);
+  }
 
 #ifdef DEBUG
   tree->is_balanced = true;
@@ -332,6 +387,53 @@ int BLI_kdtree_nd_(find_nearest)(const KDTree *tree,
   return min_node->index;
 }
 
+typedef struct KDTreeFindNearestBatchData {
+  const KDTree *tree;
+  const float (*co)[KD_DIMS];
+  int *r_index;
+  KDTreeNearest *r_nearest;
+} KDTreeFindNearestBatchData;
+
+static void kdtree_find_nearest_batch_fn(void *__restrict userdata,
+                                         const int iter,
+                                         const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const KDTreeFindNearestBatchData *data = userdata;
+  data->r_index[iter] = BLI_kdtree_nd_(find_nearest)(
+      data->tree, data->co[iter], data->r_nearest ? &data->r_nearest[iter] : NULL);
+}
+
+/**
+ * Find the nearest node of many points at once, which is done in parallel.
+ * Queries are handled in chunks of consecutive points, so passing them in a spatially coherent
+ * order makes better use of the cache.
+ *
+ * \param r_index: The result of #BLI_kdtree_3d_find_nearest for every point.
+ * \param r_nearest: Optional, filled for every point that found a node.
+ *
+ * \note There is no batched version of #BLI_kdtree_3d_range_search, its callers either already
+ * search from parallel loops or depend on the results of the previous points.
+ */
+void BLI_kdtree_nd_(find_nearest_batch)(const KDTree *tree,
+                                        const float (*co)[KD_DIMS],
+                                        const uint co_len,
+                                        int *r_index,
+                                        KDTreeNearest *r_nearest)
+{
+  KDTreeFindNearestBatchData data = {
+      .tree = tree,
+      .co = co,
+      .r_index = r_index,
+      .r_nearest = r_nearest,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (co_len > KD_BATCH_QUERIES_PER_THREAD);
+  settings.min_iter_per_thread = KD_BATCH_QUERIES_PER_THREAD;
+  BLI_task_parallel_range(0, (int)co_len, &data, kdtree_find_nearest_batch_fn, &settings);
+}
+
 /**
  * A version of #BLI_kdtree_3d_find_nearest which runs a callback
  * to filter out values.
@@ -866,6 +968,68 @@ static void deduplicate_recursive(const struct DeDuplicateParams *p, uint i)
   }
 }
 
+/* Whether there is any other node in range, the same test as #deduplicate_recursive does. */
+static bool deduplicate_has_duplicate_recursive(const struct DeDuplicateParams *p,
+                                                const float search_co[KD_DIMS],
+                                                const int search,
+                                                uint i)
+{
+  const KDTreeNode *node = &p->nodes[i];
+  if (search_co[node->d] + p->range <= node->co[node->d]) {
+    return (node->left != KD_NODE_UNSET) &&
+           deduplicate_has_duplicate_recursive(p, search_co, search, node->left);
+  }
+  if (search_co[node->d] - p->range >= node->co[node->d]) {
+    return (node->right != KD_NODE_UNSET) &&
+           deduplicate_has_duplicate_recursive(p, search_co, search, node->right);
+  }
+  if ((search != node->index) && (len_squared_vnvn(node->co, search_co) <= p->range_sq)) {
+    return true;
+  }
+  return ((node->left != KD_NODE_UNSET) &&
+          deduplicate_has_duplicate_recursive(p, search_co, search, node->left)) ||
+         ((node->right != KD_NODE_UNSET) &&
+          deduplicate_has_duplicate_recursive(p, search_co, search, node->right));
+}
+
+typedef struct KDTreeDeDuplicateCandidatesData {
+  const struct DeDuplicateParams *p;
+  uint root;
+  bool *r_is_candidate;
+} KDTreeDeDuplicateCandidatesData;
+
+static void deduplicate_candidates_fn(void *__restrict userdata,
+                                      const int iter,
+                                      const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const KDTreeDeDuplicateCandidatesData *data = userdata;
+  const KDTreeNode *node = &data->p->nodes[iter];
+  data->r_is_candidate[iter] = deduplicate_has_duplicate_recursive(
+      data->p, node->co, node->index, data->root);
+}
+
+/**
+ * Find the nodes which have any other node in range, in parallel. Searching from the other
+ * nodes can't find or merge anything, as they are not in range of any node either, so they are
+ * skipped by the serial search which depends on the order of the merges.
+ */
+static bool *deduplicate_candidates(const KDTree *tree, const struct DeDuplicateParams *p)
+{
+  bool *is_candidate = MEM_mallocN(sizeof(*is_candidate) * tree->nodes_len, __func__);
+  KDTreeDeDuplicateCandidatesData data = {
+      .p = p,
+      .root = tree->root,
+      .r_is_candidate = is_candidate,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (tree->nodes_len > KD_BATCH_QUERIES_PER_THREAD);
+  settings.min_iter_per_thread = KD_BATCH_QUERIES_PER_THREAD;
+  BLI_task_parallel_range(0, (int)tree->nodes_len, &data, deduplicate_candidates_fn, &settings);
+  return is_candidate;
+}
+
 /**
  * Find duplicate points in \a range.
  * Favors speed over quality since it doesn't find the best target vertex for merging.
@@ -898,12 +1062,17 @@ int BLI_kdtree_nd_(calc_duplicates_fast)(const KDTree *tree,
       .duplicates_found = &found,
   };
 
+  if (tree->nodes_len == 0) {
+    return found;
+  }
+  bool *is_candidate = deduplicate_candidates(tree, &p);
+
   if (use_index_order) {
     uint *order = kdtree_order(tree);
     for (uint i = 0; i < tree->nodes_len; i++) {
       const uint node_index = order[i];
       const int index = (int)i;
-      if (ELEM(duplicates[index], -1, index)) {
+      if (is_candidate[node_index] && ELEM(duplicates[index], -1, index)) {
         p.search = index;
         copy_vn_vn(p.search_co, tree->nodes[node_index].co);
         int found_prev = found;
@@ -920,7 +1089,7 @@ int BLI_kdtree_nd_(calc_duplicates_fast)(const KDTree *tree,
     for (uint i = 0; i < tree->nodes_len; i++) {
       const uint node_index = i;
       const int index = p.nodes[node_index].index;
-      if (ELEM(duplicates[index], -1, index)) {
+      if (is_candidate[node_index] && ELEM(duplicates[index], -1, index)) {
         p.search = index;
         copy_vn_vn(p.search_co, tree->nodes[node_index].co);
         int found_prev = found;
@@ -932,6 +1101,7 @@ int BLI_kdtree_nd_(calc_duplicates_fast)(const KDTree *tree,
       }
     }
   }
+  MEM_freeN(is_candidate);
   return found;
 }
 
@@ -887,6 +887,60 @@ static const Vert *find_flap_vert(const Face &tri, const Edge e, bool *r_rev)
   return flapv;
 }
 
+/**
+ * Return the sign of the exact #orient3d of the exact coordinates of \a a, \a b, \a c, \a d.
+ * The determinant is first evaluated in double arithmetic on the rounded coordinates, and
+ * only when its magnitude is below a conservative bound of the error (from both the rounding
+ * of the exact coordinates to doubles and the double arithmetic itself) is the
+ * multi-precision determinant computed. Most triangles around an edge are far from
+ * co-planar with each other, so this avoids most of the rational arithmetic.
+ */
+static int orient3d_filtered(const Vert *a, const Vert *b, const Vert *c, const Vert *d)
+{
+  /* Relative error of #Vert::co with respect to #Vert::co_exact (from `get_d()`). */
+  constexpr double eps_co = 0x1p-52;
+  /* Unit round-off of double arithmetic. */
+  constexpr double eps = 0x1p-53;
+  const double3 &dd = d->co;
+  const double3 ad = a->co - dd;
+  const double3 bd = b->co - dd;
+  const double3 cd = c->co - dd;
+  double max_co = 0.0;
+  double max_diff = 0.0;
+  for (int i = 0; i < 3; i++) {
+    max_co = std::max({max_co,
+                       fabs(a->co[i]),
+                       fabs(b->co[i]),
+                       fabs(c->co[i]),
+                       fabs(dd[i])});
+    max_diff = std::max({max_diff, fabs(ad[i]), fabs(bd[i]), fabs(cd[i])});
+  }
+  /* Keep away from overflow and from the denormal range, where the bounds below do not hold. */
+  if (!(max_co > 1e-50 && max_co < 1e50)) {
+    return orient3d(a->co_exact, b->co_exact, c->co_exact, d->co_exact);
+  }
+  const double det = ad[0] * (bd[1] * cd[2] - bd[2] * cd[1]) +
+                     ad[1] * (bd[2] * cd[0] - bd[0] * cd[2]) +
+                     ad[2] * (bd[0] * cd[1] - bd[1] * cd[0]);
+  /* Bound on the difference between each computed coordinate difference and the exact one. */
+  const double delta = 2.0 * eps_co * max_co * (1.0 + eps) + eps * max_diff;
+  /* Each of the six products of three coordinate differences changes by at most this much
+   * when each of its factors is off by `delta`. */
+  const double reach = max_diff + 2.0 * delta;
+  const double err_input = 6.0 * (reach * reach * reach - max_diff * max_diff * max_diff);
+  /* Round-off of the double evaluation of the determinant itself. */
+  const double err_arith = 48.0 * eps * max_diff * max_diff * max_diff;
+  /* Extra margin for the round-off in computing the bound. */
+  const double err_bound = (err_input + err_arith) * 1.001;
+  if (det > err_bound) {
+    return 1;
+  }
+  if (det < -err_bound) {
+    return -1;
+  }
+  return orient3d(a->co_exact, b->co_exact, c->co_exact, d->co_exact);
+}
+
 /**
  * Triangle \a tri and tri0 share edge e.
  * Classify \a tri with respect to tri0 as described in
@@ -907,9 +961,6 @@ static int sort_tris_class(const Face &tri, const Face &tri0, const Edge e)
   if (dbg_level > 0) {
     std::cout << "classify  e = " << e << "\n";
   }
-  mpq3 a0 = tri0[0]->co_exact;
-  mpq3 a1 = tri0[1]->co_exact;
-  mpq3 a2 = tri0[2]->co_exact;
   bool rev;
   bool rev0;
   const Vert *flapv0 = find_flap_vert(tri0, e, &rev0);
@@ -921,9 +972,8 @@ static int sort_tris_class(const Face &tri, const Face &tri0, const Edge e)
     std::cout << " rev = " << rev << " flapv = " << flapv << "\n";
   }
   BLI_assert(flapv != nullptr && flapv0 != nullptr);
-  const mpq3 flap = flapv->co_exact;
-  /* orient will be positive if flap is below oriented plane of a0,a1,a2. */
-  int orient = orient3d(a0, a1, a2, flap);
+  /* orient will be positive if flap is below oriented plane of tri0. */
+  int orient = orient3d_filtered(tri0[0], tri0[1], tri0[2], flapv);
   int ans;
   if (orient > 0) {
     ans = rev0 ? 4 : 3;
@@ -656,57 +656,74 @@ BLI_INLINE float4 random_float4_offset(float seed)
                 100.0f + hash_float_to_float(float2(seed, 3.0f)) * 100.0f);
 }
 
-/* Perlin noises to be added to the position to distort other noises. */
+/* Perlin noises to be added to the position to distort other noises. The offsets only depend on
+ * constant seeds, so they are computed once instead of hashing them for every evaluated point. */
 
 BLI_INLINE float perlin_distortion(float position, float strength)
 {
-  return perlin_signed(position + random_float_offset(0.0)) * strength;
+  static const float offset = random_float_offset(0.0f);
+  return perlin_signed(position + offset) * strength;
 }
 
 BLI_INLINE float2 perlin_distortion(float2 position, float strength)
 {
-  return float2(perlin_signed(position + random_float2_offset(0.0f)) * strength,
-                perlin_signed(position + random_float2_offset(1.0f)) * strength);
+  static const float2 offsets[2] = {random_float2_offset(0.0f), random_float2_offset(1.0f)};
+  return float2(perlin_signed(position + offsets[0]) * strength,
+                perlin_signed(position + offsets[1]) * strength);
 }
 
 BLI_INLINE float3 perlin_distortion(float3 position, float strength)
 {
-  return float3(perlin_signed(position + random_float3_offset(0.0f)) * strength,
-                perlin_signed(position + random_float3_offset(1.0f)) * strength,
-                perlin_signed(position + random_float3_offset(2.0f)) * strength);
+  static const float3 offsets[3] = {
+      random_float3_offset(0.0f), random_float3_offset(1.0f), random_float3_offset(2.0f)};
+  return float3(perlin_signed(position + offsets[0]) * strength,
+                perlin_signed(position + offsets[1]) * strength,
+                perlin_signed(position + offsets[2]) * strength);
 }
 
 BLI_INLINE float4 perlin_distortion(float4 position, float strength)
 {
-  return float4(perlin_signed(position + random_float4_offset(0.0f)) * strength,
-                perlin_signed(position + random_float4_offset(1.0f)) * strength,
-                perlin_signed(position + random_float4_offset(2.0f)) * strength,
-                perlin_signed(position + random_float4_offset(3.0f)) * strength);
+  static const float4 offsets[4] = {random_float4_offset(0.0f),
+                                    random_float4_offset(1.0f),
+                                    random_float4_offset(2.0f),
+                                    random_float4_offset(3.0f)};
+  return float4(perlin_signed(position + offsets[0]) * strength,
+                perlin_signed(position + offsets[1]) * strength,
+                perlin_signed(position + offsets[2]) * strength,
+                perlin_signed(position + offsets[3]) * strength);
 }
 
 /* Positive distorted fractal perlin noise. */
 
 float perlin_fractal_distorted(float position, float octaves, float roughness, float distortion)
 {
-  position += perlin_distortion(position, distortion);
+  if (distortion != 0.0f) {
+    position += perlin_distortion(position, distortion);
+  }
   return perlin_fractal(position, octaves, roughness);
 }
 
 float perlin_fractal_distorted(float2 position, float octaves, float roughness, float distortion)
 {
-  position += perlin_distortion(position, distortion);
+  if (distortion != 0.0f) {
+    position += perlin_distortion(position, distortion);
+  }
   return perlin_fractal(position, octaves, roughness);
 }
 
 float perlin_fractal_distorted(float3 position, float octaves, float roughness, float distortion)
 {
-  position += perlin_distortion(position, distortion);
+  if (distortion != 0.0f) {
+    position += perlin_distortion(position, distortion);
+  }
   return perlin_fractal(position, octaves, roughness);
 }
 
 float perlin_fractal_distorted(float4 position, float octaves, float roughness, float distortion)
 {
-  position += perlin_distortion(position, distortion);
+  if (distortion != 0.0f) {
+    position += perlin_distortion(position, distortion);
+  }
   return perlin_fractal(position, octaves, roughness);
 }
 
@@ -718,10 +735,13 @@ float3 perlin_float3_fractal_distorted(float position,
                                        float roughness,
                                        float distortion)
 {
-  position += perlin_distortion(position, distortion);
+  if (distortion != 0.0f) {
+    position += perlin_distortion(position, distortion);
+  }
+  static const float offsets[2] = {random_float_offset(1.0f), random_float_offset(2.0f)};
   return float3(perlin_fractal(position, octaves, roughness),
-                perlin_fractal(position + random_float_offset(1.0f), octaves, roughness),
-                perlin_fractal(position + random_float_offset(2.0f), octaves, roughness));
+                perlin_fractal(position + offsets[0], octaves, roughness),
+                perlin_fractal(position + offsets[1], octaves, roughness));
 }
 
 float3 perlin_float3_fractal_distorted(float2 position,
@@ -729,10 +749,13 @@ float3 perlin_float3_fractal_distorted(float2 position,
                                        float roughness,
                                        float distortion)
 {
-  position += perlin_distortion(position, distortion);
+  if (distortion != 0.0f) {
+    position += perlin_distortion(position, distortion);
+  }
+  static const float2 offsets[2] = {random_float2_offset(2.0f), random_float2_offset(3.0f)};
   return float3(perlin_fractal(position, octaves, roughness),
-                perlin_fractal(position + random_float2_offset(2.0f), octaves, roughness),
-                perlin_fractal(position + random_float2_offset(3.0f), octaves, roughness));
+                perlin_fractal(position + offsets[0], octaves, roughness),
+                perlin_fractal(position + offsets[1], octaves, roughness));
 }
 
 float3 perlin_float3_fractal_distorted(float3 position,
@@ -740,10 +763,13 @@ float3 perlin_float3_fractal_distorted(float3 position,
                                        float roughness,
                                        float distortion)
 {
-  position += perlin_distortion(position, distortion);
+  if (distortion != 0.0f) {
+    position += perlin_distortion(position, distortion);
+  }
+  static const float3 offsets[2] = {random_float3_offset(3.0f), random_float3_offset(4.0f)};
   return float3(perlin_fractal(position, octaves, roughness),
-                perlin_fractal(position + random_float3_offset(3.0f), octaves, roughness),
-                perlin_fractal(position + random_float3_offset(4.0f), octaves, roughness));
+                perlin_fractal(position + offsets[0], octaves, roughness),
+                perlin_fractal(position + offsets[1], octaves, roughness));
 }
 
 float3 perlin_float3_fractal_distorted(float4 position,
@@ -751,10 +777,13 @@ float3 perlin_float3_fractal_distorted(float4 position,
                                        float roughness,
                                        float distortion)
 {
-  position += perlin_distortion(position, distortion);
+  if (distortion != 0.0f) {
+    position += perlin_distortion(position, distortion);
+  }
+  static const float4 offsets[2] = {random_float4_offset(4.0f), random_float4_offset(5.0f)};
   return float3(perlin_fractal(position, octaves, roughness),
-                perlin_fractal(position + random_float4_offset(4.0f), octaves, roughness),
-                perlin_fractal(position + random_float4_offset(5.0f), octaves, roughness));
+                perlin_fractal(position + offsets[0], octaves, roughness),
+                perlin_fractal(position + offsets[1], octaves, roughness));
 }
 
 /** \} */
@@ -0,0 +1,164 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/** \file
+ * \ingroup bli
+ */
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "BLI_chrome_trace.hh"
+#include "BLI_profile.h"
+#include "BLI_string.h"
+#include "BLI_utildefines.h"
+
+#include "PIL_time.h"
+
+namespace blender::profile {
+
+/* Events are dropped once a thread recorded this many, to bound the memory usage. */
+#define MAX_EVENTS_PER_THREAD (1 << 20)
+
+enum class EventType : char {
+  ZoneBegin,
+  ZoneEnd,
+};
+
+struct Event {
+  EventType type;
+  char name[48];
+  char detail[48];
+  double time;
+};
+
+/* The events are only written from their thread, and read once the recording stopped.
+ * Standard containers are used so that nothing is reported as leaked by the guarded allocator
+ * when Blender exits without writing the recording. */
+struct ThreadEvents {
+  int index;
+  std::vector<Event> events;
+};
+
+static std::atomic<bool> is_recording = false;
+static double time_origin = 0.0;
+static std::mutex threads_mutex;
+static std::vector<std::unique_ptr<ThreadEvents>> threads;
+static thread_local ThreadEvents *thread_events = nullptr;
+
+static ThreadEvents &thread_events_ensure()
+{
+  if (thread_events == nullptr) {
+    std::lock_guard<std::mutex> lock(threads_mutex);
+    threads.push_back(std::make_unique<ThreadEvents>());
+    thread_events = threads.back().get();
+    thread_events->index = (int)threads.size() - 1;
+  }
+  return *thread_events;
+}
+
+static bool add_event(EventType type, const char *name, const char *detail)
+{
+  if (!is_recording.load(std::memory_order_relaxed)) {
+    return false;
+  }
+  ThreadEvents &thread = thread_events_ensure();
+  if (thread.events.size() >= MAX_EVENTS_PER_THREAD) {
+    return false;
+  }
+  Event event;
+  event.type = type;
+  BLI_strncpy(event.name, name ? name : "", sizeof(event.name));
+  BLI_strncpy(event.detail, detail ? detail : "", sizeof(event.detail));
+  event.time = PIL_check_seconds_timer();
+  thread.events.push_back(event);
+  return true;
+}
+
+static void write_chrome_trace(FILE *fp)
+{
+  chrome_trace::Writer writer(fp);
+  for (const std::unique_ptr<ThreadEvents> &thread : threads) {
+    for (const Event &event : thread->events) {
+      const double time_us = (event.time - time_origin) * 1e6;
+      switch (event.type) {
+        case EventType::ZoneBegin:
+          writer.event_begin('B', thread->index, time_us);
+          writer.field("name", event.name);
+          if (event.detail[0]) {
+            writer.arg("detail", event.detail);
+          }
+          break;
+        case EventType::ZoneEnd:
+          writer.event_begin('E', thread->index, time_us);
+          break;
+      }
+      writer.event_end();
+    }
+  }
+}
+
+}  // namespace blender::profile
+
+using namespace blender::profile;
+
+BLI_ProfileZone BLI_profile_zone_begin(const char *name, const char *detail)
+{
+  BLI_ProfileZone zone;
+  zone.is_recorded = add_event(EventType::ZoneBegin, name, detail);
+  return zone;
+}
+
+void BLI_profile_zone_end(const BLI_ProfileZone *zone)
+{
+  /* Zones which began before the recording are left out entirely. */
+  if (zone->is_recorded) {
+    add_event(EventType::ZoneEnd, nullptr, nullptr);
+  }
+}
+
+void BLI_profile_recording_begin()
+{
+  std::lock_guard<std::mutex> lock(threads_mutex);
+  for (std::unique_ptr<ThreadEvents> &thread : threads) {
+    thread->events.clear();
+  }
+  time_origin = PIL_check_seconds_timer();
+  is_recording = true;
+}
+
+bool BLI_profile_is_recording()
+{
+  return is_recording;
+}
+
+bool BLI_profile_recording_end(FILE *fp)
+{
+  if (!is_recording.exchange(false)) {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(threads_mutex);
+  if (fp) {
+    write_chrome_trace(fp);
+  }
+  for (std::unique_ptr<ThreadEvents> &thread : threads) {
+    thread->events.clear();
+    thread->events.shrink_to_fit();
+  }
+  return true;
+}
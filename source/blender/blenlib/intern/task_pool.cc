@@ -30,6 +30,7 @@
 
 #include "BLI_math.h"
 #include "BLI_mempool.h"
+#include "BLI_profile.hh"
 #include "BLI_task.h"
 #include "BLI_threads.h"
 
@@ -124,9 +125,8 @@ class TBBTaskGroup : public tbb::task_group {
   TBBTaskGroup(eTaskPriority priority)
   {
 #  if TBB_INTERFACE_VERSION_MAJOR >= 12
-    /* TODO: support priorities in TBB 2021, where they are only available as
-     * part of task arenas, no longer for task groups. Or remove support for
-     * task priorities if they are no longer useful. */
+    /* In TBB 2021 priorities are only available as part of task arenas, no longer for task
+     * groups. These are handled by running the group in #tbb_task_arena_for_priority. */
     UNUSED_VARS(priority);
 #  else
     switch (priority) {
@@ -142,6 +142,24 @@ class TBBTaskGroup : public tbb::task_group {
 };
 #endif
 
+#if defined(WITH_TBB) && TBB_INTERFACE_VERSION_MAJOR >= 12
+/* Task arena to run the task group of a pool with the given priority in, or null when tasks can
+ * run in the arena of the calling thread.
+ *
+ * Worker threads prefer tasks from arenas with higher priority, so interactive work (e.g.
+ * depsgraph evaluation) isn't slowed down as much by low priority work such as background jobs.
+ * The arena is shared by all low priority pools, to avoid creating threads for every pool. */
+static tbb::task_arena *tbb_task_arena_for_priority(eTaskPriority priority)
+{
+  if (priority != TASK_PRIORITY_LOW) {
+    return nullptr;
+  }
+  static tbb::task_arena low_priority_arena(
+      tbb::task_arena::automatic, 1, tbb::task_arena::priority::low);
+  return &low_priority_arena;
+}
+#endif
+
 /* Task Pool */
 
 enum TaskPoolType {
@@ -162,6 +180,10 @@ struct TaskPool {
 #ifdef WITH_TBB
   /* TBB task pool. */
   TBBTaskGroup tbb_group;
+#  if TBB_INTERFACE_VERSION_MAJOR >= 12
+  /* Arena the task group runs in, null to use the arena of the calling thread. */
+  tbb::task_arena *tbb_arena;
+#  endif
 #endif
   volatile bool is_suspended;
   BLI_mempool *suspended_mempool;
@@ -175,6 +197,7 @@ struct TaskPool {
 /* Execute task. */
 void Task::operator()() const
 {
+  BLI_PROFILE_SCOPE("Task");
   run(pool, taskdata);
 }
 
@@ -196,6 +219,9 @@ static void tbb_task_pool_create(TaskPool *pool, eTaskPriority priority)
 #ifdef WITH_TBB
   if (pool->use_threads) {
     new (&pool->tbb_group) TBBTaskGroup(priority);
+#  if TBB_INTERFACE_VERSION_MAJOR >= 12
+    pool->tbb_arena = tbb_task_arena_for_priority(priority);
+#  endif
   }
 #else
   UNUSED_VARS(priority);
@@ -219,6 +245,12 @@ static void tbb_task_pool_run(TaskPool *pool, Task &&task)
 #ifdef WITH_TBB
   else if (pool->use_threads) {
     /* Execute in TBB task group. */
+#  if TBB_INTERFACE_VERSION_MAJOR >= 12
+    if (pool->tbb_arena) {
+      pool->tbb_arena->execute([&]() { pool->tbb_group.run(std::move(task)); });
+      return;
+    }
+#  endif
     pool->tbb_group.run(std::move(task));
   }
 #endif
@@ -248,6 +280,12 @@ static void tbb_task_pool_work_and_wait(TaskPool *pool)
     /* This is called wait(), but internally it can actually do work. This
      * matters because we don't want recursive usage of task pools to run
      * out of threads and get stuck. */
+#  if TBB_INTERFACE_VERSION_MAJOR >= 12
+    if (pool->tbb_arena) {
+      pool->tbb_arena->execute([&]() { pool->tbb_group.wait(); });
+      return;
+    }
+#  endif
     pool->tbb_group.wait();
   }
 #endif
@@ -258,6 +296,12 @@ static void tbb_task_pool_cancel(TaskPool *pool)
 #ifdef WITH_TBB
   if (pool->use_threads) {
     pool->tbb_group.cancel();
+#  if TBB_INTERFACE_VERSION_MAJOR >= 12
+    if (pool->tbb_arena) {
+      pool->tbb_arena->execute([&]() { pool->tbb_group.wait(); });
+      return;
+    }
+#  endif
     pool->tbb_group.wait();
   }
 #else
@@ -23,6 +23,7 @@
 #include "MEM_guardedalloc.h"
 
 #include "BLI_task.h"
+#include "BLI_task.hh"
 #include "BLI_threads.h"
 
 #ifdef WITH_TBB
@@ -33,8 +34,17 @@
 #    include <tbb/global_control.h>
 #    define WITH_TBB_GLOBAL_CONTROL
 #  endif
+#  if TBB_INTERFACE_VERSION_MAJOR >= 12
+#    include <tbb/info.h>
+#    include <tbb/parallel_for.h>
+#    include <tbb/task_group.h>
+#    define WITH_TBB_NUMA
+#  endif
 #endif
 
+#include <algorithm>
+#include <vector>
+
 /* Task Scheduler */
 
 static int task_scheduler_num_threads = 1;
@@ -42,6 +52,35 @@ static int task_scheduler_num_threads = 1;
 static tbb::global_control *task_scheduler_global_control = nullptr;
 #endif
 
+static bool task_scheduler_use_numa = false;
+#ifdef WITH_TBB_NUMA
+/* One arena per NUMA node, only used when there are multiple nodes. */
+static std::vector<tbb::task_arena *> task_scheduler_numa_arenas;
+/* Set while running a part of a loop in a NUMA arena, nested loops are not split further. */
+static thread_local bool task_scheduler_numa_is_nested = false;
+
+static void task_scheduler_numa_init()
+{
+  /* Only returns multiple nodes when TBB finds the `tbbbind` library. */
+  const std::vector<tbb::numa_node_id> numa_nodes = tbb::info::numa_nodes();
+  if (numa_nodes.size() < 2) {
+    return;
+  }
+  for (const tbb::numa_node_id numa_node : numa_nodes) {
+    task_scheduler_numa_arenas.push_back(
+        MEM_new<tbb::task_arena>(__func__, tbb::task_arena::constraints(numa_node)));
+  }
+}
+
+static void task_scheduler_numa_exit()
+{
+  for (tbb::task_arena *arena : task_scheduler_numa_arenas) {
+    MEM_delete(arena);
+  }
+  task_scheduler_numa_arenas.clear();
+}
+#endif
+
 void BLI_task_scheduler_init()
 {
 #ifdef WITH_TBB_GLOBAL_CONTROL
@@ -64,20 +103,82 @@ void BLI_task_scheduler_init()
 #else
   task_scheduler_num_threads = BLI_system_thread_count();
 #endif
+
+#ifdef WITH_TBB_NUMA
+  if (task_scheduler_use_numa) {
+    task_scheduler_numa_init();
+  }
+#endif
 }
 
 void BLI_task_scheduler_exit()
 {
+#ifdef WITH_TBB_NUMA
+  task_scheduler_numa_exit();
+#endif
 #ifdef WITH_TBB_GLOBAL_CONTROL
   MEM_delete(task_scheduler_global_control);
 #endif
 }
 
+void BLI_task_scheduler_numa_set(bool use_numa)
+{
+  task_scheduler_use_numa = use_numa;
+}
+
 int BLI_task_scheduler_num_threads()
 {
   return task_scheduler_num_threads;
 }
 
+namespace blender::threading::detail {
+
+bool parallel_for_numa(IndexRange range,
+                       int64_t grain_size,
+                       FunctionRef<void(IndexRange)> function)
+{
+#ifdef WITH_TBB_NUMA
+  const int64_t arenas_num = (int64_t)task_scheduler_numa_arenas.size();
+  if (arenas_num < 2 || task_scheduler_numa_is_nested || range.size() < grain_size * arenas_num) {
+    return false;
+  }
+
+  const int64_t part_size = (range.size() + arenas_num - 1) / arenas_num;
+  std::vector<tbb::task_group> groups(arenas_num);
+
+  for (int64_t i = 0; i < arenas_num; i++) {
+    const int64_t part_start = i * part_size;
+    if (part_start >= range.size()) {
+      break;
+    }
+    const IndexRange part = range.slice(part_start,
+                                        std::min(part_size, range.size() - part_start));
+    task_scheduler_numa_arenas[i]->execute([&, i, part]() {
+      groups[i].run([&, part]() {
+        tbb::parallel_for(
+            tbb::blocked_range<int64_t>(part.first(), part.one_after_last(), grain_size),
+            [&](const tbb::blocked_range<int64_t> &subrange) {
+              const bool was_nested = task_scheduler_numa_is_nested;
+              task_scheduler_numa_is_nested = true;
+              function(IndexRange(subrange.begin(), subrange.size()));
+              task_scheduler_numa_is_nested = was_nested;
+            });
+      });
+    });
+  }
+
+  for (int64_t i = 0; i < arenas_num; i++) {
+    task_scheduler_numa_arenas[i]->execute([&, i]() { groups[i].wait(); });
+  }
+  return true;
+#else
+  UNUSED_VARS(range, grain_size, function);
+  return false;
+#endif
+}
+
+}  // namespace blender::threading::detail
+
 void BLI_task_isolate(void (*func)(void *userdata), void *userdata)
 {
 #ifdef WITH_TBB
@@ -0,0 +1,83 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include <cstdio>
+#include <sstream>
+#include <string>
+
+#include "BLI_chrome_trace.hh"
+#include "BLI_serialize.hh"
+
+namespace blender::chrome_trace::tests {
+
+/** Run the writes of `fn` and return the written trace. */
+template<typename Fn> static std::string write_trace(const Fn &fn)
+{
+  FILE *fp = tmpfile();
+  EXPECT_NE(fp, nullptr);
+  {
+    Writer writer(fp);
+    fn(writer);
+  }
+  std::string result(ftell(fp), '\0');
+  rewind(fp);
+  EXPECT_EQ(fread(result.data(), 1, result.size(), fp), result.size());
+  fclose(fp);
+  return result;
+}
+
+TEST(chrome_trace, empty)
+{
+  const std::string trace = write_trace([](Writer &UNUSED(writer)) {});
+  EXPECT_EQ(trace, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n]}\n");
+}
+
+TEST(chrome_trace, events)
+{
+  const std::string trace = write_trace([](Writer &writer) {
+    writer.event_begin('B', 2, 1.5);
+    writer.field("name", "Zone");
+    writer.event_end();
+    writer.event_begin('E', 2, 3.0);
+    writer.event_end();
+    writer.event_begin('X', 0, 1234567.125);
+    writer.field("name", "Operation");
+    writer.field("dur", 0.25);
+    writer.arg("id", "OBCube");
+    writer.arg("frame", 12.0);
+    writer.event_end();
+  });
+  EXPECT_EQ(trace,
+            "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n"
+            "{\"ph\":\"B\",\"pid\":1,\"tid\":2,\"ts\":1.5,\"name\":\"Zone\"},\n"
+            "{\"ph\":\"E\",\"pid\":1,\"tid\":2,\"ts\":3},\n"
+            "{\"ph\":\"X\",\"pid\":1,\"tid\":0,\"ts\":1234567.125,\"name\":\"Operation\","
+            "\"dur\":0.25,\"args\":{\"id\":\"OBCube\",\"frame\":12}}\n"
+            "]}\n");
+}
+
+TEST(chrome_trace, escape_strings)
+{
+  const char *name = "Quote \" backslash \\ newline \n tab \t UTF-8 \xc3\xa9";
+  const std::string trace = write_trace([&](Writer &writer) {
+    writer.event_begin('i', 0, 0.0);
+    writer.field("name", name);
+    writer.event_end();
+  });
+
+  /* The output has to be valid JSON, giving back the original string. */
+  std::stringstream is(trace);
+  io::serialize::JsonFormatter json;
+  std::unique_ptr<io::serialize::Value> value = json.deserialize(is);
+  ASSERT_EQ(value->type(), io::serialize::eValueType::Dictionary);
+  const io::serialize::DictionaryValue::Lookup lookup =
+      value->as_dictionary_value()->create_lookup();
+  const io::serialize::ArrayValue *events = lookup.lookup("traceEvents")->as_array_value();
+  ASSERT_EQ(events->elements().size(), 1);
+  const io::serialize::DictionaryValue::Lookup event =
+      events->elements()[0]->as_dictionary_value()->create_lookup();
+  EXPECT_EQ(event.lookup("name")->as_string_value()->value(), name);
+}
+
+}  // namespace blender::chrome_trace::tests
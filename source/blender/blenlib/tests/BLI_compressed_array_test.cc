@@ -0,0 +1,79 @@
+/* Apache License, Version 2.0 */
+
+#include "BLI_compressed_array.hh"
+#include "BLI_rand.hh"
+#include "testing/testing.h"
+
+namespace blender::tests {
+
+TEST(compressed_array, Empty)
+{
+  VArray<int> varray = compressed_varray_from_span(Span<int>());
+  EXPECT_EQ(varray.size(), 0);
+}
+
+TEST(compressed_array, Get)
+{
+  Array<int> values(100000);
+  for (const int64_t i : values.index_range()) {
+    values[i] = int(i / 10);
+  }
+  VArray<int> varray = compressed_varray_from_span(values.as_span());
+  EXPECT_EQ(varray.size(), 100000);
+  EXPECT_EQ(varray[0], 0);
+  EXPECT_EQ(varray[99999], 9999);
+  EXPECT_EQ(varray[50000], 5000);
+  EXPECT_EQ(varray[12345], 1234);
+  EXPECT_FALSE(varray.is_span());
+}
+
+TEST(compressed_array, CompressesRepetitiveData)
+{
+  Array<float> values(1000000, 1.0f);
+  CompressedArrayStorage storage(values.data(), sizeof(float), values.size());
+  EXPECT_LT(storage.compressed_size_in_bytes(), values.size() * int64_t(sizeof(float)) / 10);
+}
+
+TEST(compressed_array, IncompressibleData)
+{
+  RandomNumberGenerator rng;
+  Array<uint32_t> values(50000);
+  for (uint32_t &value : values) {
+    value = rng.get_uint32();
+  }
+  VArray<uint32_t> varray = compressed_varray_from_span(values.as_span());
+  for (const int64_t i : values.index_range()) {
+    EXPECT_EQ(varray[i], values[i]);
+  }
+}
+
+TEST(compressed_array, Materialize)
+{
+  Array<int> values(70000);
+  for (const int64_t i : values.index_range()) {
+    values[i] = int(i % 1000);
+  }
+  VArray<int> varray = compressed_varray_from_span(values.as_span());
+
+  Array<int> all(values.size());
+  varray.materialize(all);
+  EXPECT_EQ_ARRAY(all.data(), values.data(), values.size());
+
+  /* A range that starts and ends in the middle of pages. */
+  Array<int> part(values.size(), -1);
+  varray.materialize(IndexRange(1000, 50000), part);
+  EXPECT_EQ(part[999], -1);
+  EXPECT_EQ(part[1000], values[1000]);
+  EXPECT_EQ(part[30000], values[30000]);
+  EXPECT_EQ(part[50999], values[50999]);
+  EXPECT_EQ(part[51000], -1);
+
+  Array<int> masked(values.size(), -1);
+  varray.materialize({3, 17000, 69999}, masked);
+  EXPECT_EQ(masked[3], values[3]);
+  EXPECT_EQ(masked[17000], values[17000]);
+  EXPECT_EQ(masked[69999], values[69999]);
+  EXPECT_EQ(masked[4], -1);
+}
+
+}  // namespace blender::tests
@@ -143,6 +143,8 @@ TEST_CONST(TenE, "1.e+1", 10.0)
 TEST_CONST(Half, ".5", 0.5)
 
 TEST_CONST(Pi, "pi", M_PI)
+TEST_CONST(E, "e", M_E)
+TEST_CONST(Tau, "tau", 2.0 * M_PI)
 TEST_CONST(True, "True", TRUE_VAL)
 TEST_CONST(False, "False", FALSE_VAL)
 
@@ -156,6 +158,25 @@ TEST_CONST(Pow, "pow(4, 0.5)", 2.0)
 TEST_EVAL(Pow, "pow(4, x)", 0.5, 2.0)
 
 TEST_CONST(Log2_1, "log(4, 2)", 2.0)
+TEST_CONST(Log2_2, "log2(8)", 3.0)
+TEST_CONST(Log10, "log10(100)", 2.0)
+TEST_CONST(Log1p, "log1p(0)", 0.0)
+TEST_CONST(Expm1, "expm1(0)", 0.0)
+
+TEST_CONST(Sinh, "sinh(0)", 0.0)
+TEST_CONST(Cosh, "cosh(0)", 1.0)
+TEST_CONST(Tanh, "tanh(0)", 0.0)
+TEST_CONST(Asinh, "asinh(0)", 0.0)
+TEST_CONST(Acosh, "acosh(1)", 0.0)
+TEST_CONST(Atanh, "atanh(0)", 0.0)
+
+TEST_CONST(Hypot, "hypot(3, 4)", 5.0)
+TEST_EVAL(Hypot, "hypot(x, 4)", 3.0, 5.0)
+TEST_CONST(Copysign, "copysign(2, -1)", -2.0)
+
+TEST_CONST(Float, "float(1.5)", 1.5)
+TEST_CONST(Bool1, "bool(0)", FALSE_VAL)
+TEST_CONST(Bool2, "bool(-2)", TRUE_VAL)
 
 TEST_CONST(Round1, "round(-0.5)", -1.0)
 TEST_CONST(Round2, "round(-0.4)", 0.0)
@@ -132,3 +132,64 @@ TEST(kdopbvh, OptimalFindNearest_500)
 {
   find_nearest_points_test(500, 1.0, 1000, 12, true);
 }
+
+/**
+ * Boxes start on a grid of 0.25 and have a size of 0.375, so the bounds of two boxes are never
+ * exactly touching, which makes the result independent from the epsilon added to the bounds.
+ */
+static void overlap_boxes_test(int boxes_len, int random_seed)
+{
+  struct RNG *rng = BLI_rng_new(random_seed);
+  BVHTree *tree = BLI_bvhtree_new(boxes_len, 0.0, 8, 6);
+
+  void *mem = MEM_mallocN(sizeof(float[2][3]) * boxes_len, __func__);
+  float(*boxes)[2][3] = (float(*)[2][3])mem;
+
+  for (int i = 0; i < boxes_len; i++) {
+    for (int axis = 0; axis < 3; axis++) {
+      boxes[i][0][axis] = (float)(BLI_rng_get_int(rng) % 16) * 0.25f;
+      boxes[i][1][axis] = boxes[i][0][axis] + 0.375f;
+    }
+    BLI_bvhtree_insert(tree, i, &boxes[i][0][0], 2);
+  }
+  BLI_bvhtree_balance(tree);
+
+  uint overlap_expected = 0;
+  for (int i = 0; i < boxes_len; i++) {
+    for (int j = 0; j < boxes_len; j++) {
+      if (i == j) {
+        continue;
+      }
+      bool overlap = true;
+      for (int axis = 0; axis < 3; axis++) {
+        if (boxes[i][0][axis] > boxes[j][1][axis] || boxes[j][0][axis] > boxes[i][1][axis]) {
+          overlap = false;
+        }
+      }
+      overlap_expected += overlap;
+    }
+  }
+
+  uint overlap_len = 0;
+  BVHTreeOverlap *overlap = BLI_bvhtree_overlap(tree, tree, &overlap_len, nullptr, nullptr);
+  EXPECT_EQ(overlap_len, overlap_expected);
+  for (uint i = 0; i < overlap_len; i++) {
+    EXPECT_NE(overlap[i].indexA, overlap[i].indexB);
+  }
+
+  if (overlap) {
+    MEM_freeN(overlap);
+  }
+  BLI_bvhtree_free(tree);
+  BLI_rng_free(rng);
+  MEM_freeN(boxes);
+}
+
+TEST(kdopbvh, Overlap_1)
+{
+  overlap_boxes_test(1, 1234);
+}
+TEST(kdopbvh, Overlap_500)
+{
+  overlap_boxes_test(500, 4321);
+}
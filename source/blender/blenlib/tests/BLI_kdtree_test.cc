@@ -0,0 +1,210 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_kdtree.h"
+#include "BLI_math_base.h"
+#include "BLI_math_vector.h"
+#include "BLI_rand.h"
+#include "BLI_utildefines.h"
+
+/* -------------------------------------------------------------------- */
+/* Helper Functions */
+
+static void rng_v3_fill(float (*coords)[3], int coords_len, struct RNG *rng)
+{
+  for (int i = 0; i < coords_len; i++) {
+    BLI_rng_get_float_unit_v3(rng, coords[i]);
+    mul_v3_fl(coords[i], BLI_rng_get_float(rng));
+  }
+}
+
+static int find_nearest_brute_force(const float (*coords)[3],
+                                    int coords_len,
+                                    const float co[3])
+{
+  int index = -1;
+  float dist_sq_min = FLT_MAX;
+  for (int i = 0; i < coords_len; i++) {
+    const float dist_sq = len_squared_v3v3(coords[i], co);
+    if (dist_sq < dist_sq_min) {
+      dist_sq_min = dist_sq;
+      index = i;
+    }
+  }
+  return index;
+}
+
+/**
+ * \param tree_len: Large enough values balance the tree in parallel.
+ */
+static void find_nearest_test(int tree_len, int queries_len, bool use_batch)
+{
+  struct RNG *rng = BLI_rng_new(tree_len);
+  float(*coords)[3] = (float(*)[3])MEM_mallocN(sizeof(*coords) * tree_len, __func__);
+  float(*queries)[3] = (float(*)[3])MEM_mallocN(sizeof(*queries) * queries_len, __func__);
+  rng_v3_fill(coords, tree_len, rng);
+  rng_v3_fill(queries, queries_len, rng);
+
+  KDTree_3d *tree = BLI_kdtree_3d_new(tree_len);
+  for (int i = 0; i < tree_len; i++) {
+    BLI_kdtree_3d_insert(tree, i, coords[i]);
+  }
+  BLI_kdtree_3d_balance(tree);
+
+  int *indices = (int *)MEM_mallocN(sizeof(*indices) * queries_len, __func__);
+  if (use_batch) {
+    BLI_kdtree_3d_find_nearest_batch(tree, queries, queries_len, indices, nullptr);
+  }
+  else {
+    for (int i = 0; i < queries_len; i++) {
+      indices[i] = BLI_kdtree_3d_find_nearest(tree, queries[i], nullptr);
+    }
+  }
+
+  for (int i = 0; i < queries_len; i++) {
+    const int expected = find_nearest_brute_force(coords, tree_len, queries[i]);
+    ASSERT_EQ(len_squared_v3v3(coords[indices[i]], queries[i]),
+              len_squared_v3v3(coords[expected], queries[i]));
+  }
+
+  BLI_kdtree_3d_free(tree);
+  MEM_freeN(indices);
+  MEM_freeN(queries);
+  MEM_freeN(coords);
+  BLI_rng_free(rng);
+}
+
+/* Same as #BLI_kdtree_3d_calc_duplicates_fast with `use_index_order` enabled. */
+static int calc_duplicates_brute_force(const float (*coords)[3],
+                                       int coords_len,
+                                       float range,
+                                       int *duplicates)
+{
+  int found = 0;
+  for (int i = 0; i < coords_len; i++) {
+    if (!ELEM(duplicates[i], -1, i)) {
+      continue;
+    }
+    const int found_prev = found;
+    for (int j = 0; j < coords_len; j++) {
+      if (j != i && duplicates[j] == -1 &&
+          len_squared_v3v3(coords[i], coords[j]) <= square_f(range)) {
+        duplicates[j] = i;
+        found++;
+      }
+    }
+    if (found != found_prev) {
+      duplicates[i] = i;
+    }
+  }
+  return found;
+}
+
+static void calc_duplicates_test(int tree_len)
+{
+  struct RNG *rng = BLI_rng_new(tree_len);
+  float(*coords)[3] = (float(*)[3])MEM_mallocN(sizeof(*coords) * tree_len, __func__);
+  rng_v3_fill(coords, tree_len, rng);
+  /* Make some of the points duplicates of others. */
+  for (int i = 0; i < tree_len; i += 7) {
+    const int other = BLI_rng_get_int(rng) % tree_len;
+    copy_v3_v3(coords[i], coords[other]);
+    coords[i][0] += 1e-4f;
+  }
+  const float range = 1e-3f;
+
+  KDTree_3d *tree = BLI_kdtree_3d_new(tree_len);
+  for (int i = 0; i < tree_len; i++) {
+    BLI_kdtree_3d_insert(tree, i, coords[i]);
+  }
+  BLI_kdtree_3d_balance(tree);
+
+  int *duplicates = (int *)MEM_mallocN(sizeof(*duplicates) * tree_len, __func__);
+  int *expected = (int *)MEM_mallocN(sizeof(*expected) * tree_len, __func__);
+  for (int i = 0; i < tree_len; i++) {
+    duplicates[i] = -1;
+    expected[i] = -1;
+  }
+  const int found = BLI_kdtree_3d_calc_duplicates_fast(tree, range, true, duplicates);
+  const int expected_found = calc_duplicates_brute_force(coords, tree_len, range, expected);
+  EXPECT_GT(expected_found, 0);
+  EXPECT_EQ(found, expected_found);
+  for (int i = 0; i < tree_len; i++) {
+    ASSERT_EQ(duplicates[i], expected[i]);
+  }
+
+  BLI_kdtree_3d_free(tree);
+  MEM_freeN(expected);
+  MEM_freeN(duplicates);
+  MEM_freeN(coords);
+  BLI_rng_free(rng);
+}
+
+/* -------------------------------------------------------------------- */
+/* Tests */
+
+TEST(kdtree, Empty)
+{
+  KDTree_3d *tree = BLI_kdtree_3d_new(0);
+  BLI_kdtree_3d_balance(tree);
+  const float co[3] = {0.0f, 0.0f, 0.0f};
+  EXPECT_EQ(BLI_kdtree_3d_find_nearest(tree, co, nullptr), -1);
+  int index = 0;
+  BLI_kdtree_3d_find_nearest_batch(tree, &co, 1, &index, nullptr);
+  EXPECT_EQ(index, -1);
+  BLI_kdtree_3d_free(tree);
+}
+
+TEST(kdtree, FindNearestSmall)
+{
+  find_nearest_test(100, 100, false);
+}
+
+TEST(kdtree, FindNearestLarge)
+{
+  find_nearest_test(100000, 1000, false);
+}
+
+TEST(kdtree, FindNearestBatchSmall)
+{
+  find_nearest_test(100, 100, true);
+}
+
+TEST(kdtree, FindNearestBatchLarge)
+{
+  find_nearest_test(100000, 2000, true);
+}
+
+TEST(kdtree, FindNearestBatchNearest)
+{
+  const float coords[3][3] = {{0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {0.0f, 2.0f, 0.0f}};
+  const float queries[2][3] = {{0.9f, 0.0f, 0.0f}, {0.0f, 3.0f, 0.0f}};
+  KDTree_3d *tree = BLI_kdtree_3d_new(3);
+  for (int i = 0; i < 3; i++) {
+    BLI_kdtree_3d_insert(tree, i, coords[i]);
+  }
+  BLI_kdtree_3d_balance(tree);
+
+  int indices[2];
+  KDTreeNearest_3d nearest[2];
+  BLI_kdtree_3d_find_nearest_batch(tree, queries, 2, indices, nearest);
+  EXPECT_EQ(indices[0], 1);
+  EXPECT_EQ(indices[1], 2);
+  EXPECT_EQ(nearest[0].index, 1);
+  EXPECT_NEAR(nearest[0].dist, 0.1f, 1e-6f);
+  EXPECT_NEAR(nearest[1].dist, 1.0f, 1e-6f);
+  BLI_kdtree_3d_free(tree);
+}
+
+TEST(kdtree, CalcDuplicatesSmall)
+{
+  calc_duplicates_test(100);
+}
+
+TEST(kdtree, CalcDuplicatesLarge)
+{
+  calc_duplicates_test(5000);
+}
@@ -1,7 +1,10 @@
 /* Apache License, Version 2.0 */
 
 #include "BLI_linear_allocator.hh"
+#include "BLI_map.hh"
 #include "BLI_rand.hh"
+#include "BLI_set.hh"
+#include "BLI_vector_set.hh"
 #include "BLI_strict_flags.h"
 #include "testing/testing.h"
 
@@ -149,4 +152,72 @@ TEST(linear_allocator, ConstructArray)
   }
 }
 
+TEST(arena_allocator, NoActiveArena)
+{
+  EXPECT_EQ(ScopedArena::active(), nullptr);
+  Vector<int, 0, ArenaAllocator> vec;
+  for (int i = 0; i < 100; i++) {
+    vec.append(i);
+  }
+  EXPECT_EQ(vec.size(), 100);
+  EXPECT_EQ(vec[42], 42);
+}
+
+TEST(arena_allocator, NestedScopes)
+{
+  ScopedArena outer;
+  EXPECT_EQ(ScopedArena::active(), &outer);
+  {
+    ScopedArena inner;
+    EXPECT_EQ(ScopedArena::active(), &inner);
+  }
+  EXPECT_EQ(ScopedArena::active(), &outer);
+}
+
+TEST(arena_allocator, Containers)
+{
+  using ArenaSet = Set<int,
+                       4,
+                       DefaultProbingStrategy,
+                       DefaultHash<int>,
+                       DefaultEquality,
+                       DefaultSetSlot<int>::type,
+                       ArenaAllocator>;
+  using ArenaMap = Map<int,
+                       std::string,
+                       4,
+                       DefaultProbingStrategy,
+                       DefaultHash<int>,
+                       DefaultEquality,
+                       DefaultMapSlot<int, std::string>::type,
+                       ArenaAllocator>;
+  using ArenaVectorSet = VectorSet<int,
+                                   DefaultProbingStrategy,
+                                   DefaultHash<int>,
+                                   DefaultEquality,
+                                   DefaultVectorSetSlot<int>::type,
+                                   ArenaAllocator>;
+
+  ScopedArena arena;
+  Vector<int, 4, ArenaAllocator> vec;
+  ArenaSet set;
+  ArenaMap map;
+  ArenaVectorSet vector_set;
+  for (int i = 0; i < 1000; i++) {
+    vec.append(i);
+    set.add(i);
+    map.add(i, std::to_string(i));
+    vector_set.add(i * 2);
+  }
+  EXPECT_EQ(vec.size(), 1000);
+  EXPECT_EQ(vec[500], 500);
+  EXPECT_TRUE(set.contains(999));
+  EXPECT_EQ(map.lookup(123), "123");
+  EXPECT_EQ(vector_set.index_of(20), 10);
+
+  Vector<int, 4, ArenaAllocator> vec_copy = vec;
+  EXPECT_EQ(vec_copy.size(), 1000);
+  EXPECT_EQ(vec_copy.last(), 999);
+}
+
 }  // namespace blender::tests
@@ -653,6 +653,33 @@ TEST(map, LookupKey)
   EXPECT_EQ(map.lookup_key_ptr("a"), map.lookup_key_ptr_as("a"));
 }
 
+TEST(map, FingerprintSlot)
+{
+  Map<int,
+      std::string,
+      4,
+      DefaultProbingStrategy,
+      DefaultHash<int>,
+      DefaultEquality,
+      FingerprintMapSlot<int, std::string>>
+      map;
+  for (int i = 0; i < 1000; i++) {
+    map.add_new(i, std::to_string(i));
+  }
+  EXPECT_EQ(map.size(), 1000);
+  EXPECT_EQ(map.lookup(0), "0");
+  EXPECT_EQ(map.lookup(999), "999");
+  EXPECT_FALSE(map.contains(1000));
+  for (int i = 0; i < 1000; i += 2) {
+    EXPECT_TRUE(map.remove(i));
+  }
+  EXPECT_EQ(map.size(), 500);
+  EXPECT_FALSE(map.contains(10));
+  EXPECT_EQ(map.lookup_default(11, ""), "11");
+  map.add(10, "ten");
+  EXPECT_EQ(map.lookup(10), "ten");
+}
+
 /**
  * Set this to 1 to activate the benchmark. It is disabled by default, because it prints a lot.
  */
@@ -570,6 +570,32 @@ TEST(set, RemoveDuringIteration)
   EXPECT_TRUE(set.contains(3));
 }
 
+TEST(set, FingerprintSlot)
+{
+  Set<std::string,
+      4,
+      DefaultProbingStrategy,
+      DefaultHash<std::string>,
+      DefaultEquality,
+      FingerprintSetSlot<std::string>>
+      set;
+  for (int i = 0; i < 1000; i++) {
+    set.add(std::to_string(i));
+  }
+  EXPECT_EQ(set.size(), 1000);
+  EXPECT_TRUE(set.contains("0"));
+  EXPECT_TRUE(set.contains("999"));
+  EXPECT_FALSE(set.contains("1000"));
+  for (int i = 0; i < 1000; i += 2) {
+    EXPECT_TRUE(set.remove(std::to_string(i)));
+  }
+  EXPECT_EQ(set.size(), 500);
+  EXPECT_FALSE(set.contains("10"));
+  EXPECT_TRUE(set.contains("11"));
+  set.add("10");
+  EXPECT_TRUE(set.contains("10"));
+}
+
 /**
  * Set this to 1 to activate the benchmark. It is disabled by default, because it prints a lot.
  */
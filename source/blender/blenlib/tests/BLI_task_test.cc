@@ -280,3 +280,36 @@ TEST(task, ListBaseIter)
   MEM_freeN(items_buffer);
   BLI_threadapi_exit();
 }
+
+/* *** Task pools with different priorities. *** */
+
+static void task_pool_count_func(TaskPool *__restrict pool, void *UNUSED(taskdata))
+{
+  int *count = (int *)BLI_task_pool_user_data(pool);
+  atomic_add_and_fetch_uint32((uint32_t *)count, 1);
+}
+
+TEST(task, PoolPriority)
+{
+  BLI_threadapi_init();
+
+  int count_low = 0;
+  int count_high = 0;
+  TaskPool *pool_low = BLI_task_pool_create(&count_low, TASK_PRIORITY_LOW);
+  TaskPool *pool_high = BLI_task_pool_create(&count_high, TASK_PRIORITY_HIGH);
+
+  for (int i = 0; i < NUM_ITEMS; i++) {
+    BLI_task_pool_push(pool_low, task_pool_count_func, nullptr, false, nullptr);
+    BLI_task_pool_push(pool_high, task_pool_count_func, nullptr, false, nullptr);
+  }
+
+  BLI_task_pool_work_and_wait(pool_high);
+  BLI_task_pool_work_and_wait(pool_low);
+
+  EXPECT_EQ(count_low, NUM_ITEMS);
+  EXPECT_EQ(count_high, NUM_ITEMS);
+
+  BLI_task_pool_free(pool_low);
+  BLI_task_pool_free(pool_high);
+  BLI_threadapi_exit();
+}
@@ -149,6 +149,10 @@ TEST(virtual_array, DerivedSpan)
     varray.set(1, 20);
     EXPECT_EQ(vector[0][0], 10);
     EXPECT_EQ(vector[1][0], 20);
+    varray.set_all({30, 40});
+    EXPECT_EQ(vector[0][0], 30);
+    EXPECT_EQ(vector[1][0], 40);
+    EXPECT_EQ(vector[1][1], 1);
   }
 }
 
@@ -180,4 +184,36 @@ TEST(virtual_array, MutableToImmutable)
   }
 }
 
+TEST(virtual_array, Devirtualize3)
+{
+  std::array<int, 3> data = {1, 2, 3};
+  const VArray<int> span_varray = VArray<int>::ForSpan(data);
+  const VArray<int> single_varray = VArray<int>::ForSingle(10, 3);
+  const VArray<int> func_varray = VArray<int>::ForFunc(3, [](const int64_t i) { return int(i); });
+
+  int devirtualized_calls = 0;
+  auto sum = [&](const VArray<int> &a, const VArray<int> &b, const VArray<int> &c) {
+    std::array<int, 3> result;
+    devirtualize_varray3(a, b, c, [&](const auto &a, const auto &b, const auto &c) {
+      using A = std::decay_t<decltype(a)>;
+      using B = std::decay_t<decltype(b)>;
+      using C = std::decay_t<decltype(c)>;
+      if (!std::is_same_v<A, VArray<int>> && !std::is_same_v<B, VArray<int>> &&
+          !std::is_same_v<C, VArray<int>>) {
+        devirtualized_calls++;
+      }
+      for (const int i : IndexRange(3)) {
+        result[i] = a[i] + b[i] + c[i];
+      }
+    });
+    return result;
+  };
+
+  EXPECT_EQ(sum(span_varray, single_varray, span_varray), (std::array<int, 3>{12, 14, 16}));
+  EXPECT_EQ(sum(single_varray, single_varray, single_varray), (std::array<int, 3>{30, 30, 30}));
+  EXPECT_EQ(devirtualized_calls, 2);
+  EXPECT_EQ(sum(span_varray, func_varray, single_varray), (std::array<int, 3>{11, 13, 15}));
+  EXPECT_EQ(devirtualized_calls, 2);
+}
+
 }  // namespace blender::tests
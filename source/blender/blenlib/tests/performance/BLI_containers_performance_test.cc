@@ -0,0 +1,307 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_array.hh"
+#include "BLI_index_mask.hh"
+#include "BLI_map.hh"
+#include "BLI_mempool.h"
+#include "BLI_rand.hh"
+#include "BLI_serialize.hh"
+#include "BLI_set.hh"
+#include "BLI_task.hh"
+#include "BLI_timeit.hh"
+#include "BLI_vector.hh"
+#include "BLI_vector_set.hh"
+
+/**
+ * Micro-benchmarks of the containers, the allocators and the threading primitives.
+ *
+ * Every benchmark reports the fastest of a fixed number of runs, after a warm-up run, on the same
+ * pseudo-random input. The results can be written to a JSON file, and a previous file can be used
+ * as baseline to print relative timings:
+ *
+ *   BLI_containers_performance_test --perf_output=before.json
+ *   BLI_containers_performance_test --perf_baseline=before.json
+ */
+
+DEFINE_string(perf_output, "", "JSON file to write the timings to.");
+DEFINE_string(perf_baseline, "", "JSON file written by a previous run to compare the timings to.");
+
+namespace blender::tests {
+
+namespace serialize = io::serialize;
+
+#define NUM_RUNS 10
+
+/* Use standard containers, results outlive the guarded allocator leak detection. */
+static std::vector<std::pair<std::string, double>> results;
+static std::map<std::string, double> baseline;
+
+class PerformanceEnvironment : public ::testing::Environment {
+ public:
+  void SetUp() override
+  {
+    if (FLAGS_perf_baseline.empty()) {
+      return;
+    }
+    std::ifstream is(FLAGS_perf_baseline);
+    serialize::JsonFormatter json;
+    std::unique_ptr<serialize::Value> value = json.deserialize(is);
+    const serialize::DictionaryValue *dict = value ? value->as_dictionary_value() : nullptr;
+    if (dict == nullptr) {
+      ADD_FAILURE() << "Could not read baseline file " << FLAGS_perf_baseline;
+      return;
+    }
+    for (const serialize::DictionaryValue::Item &item : dict->elements()) {
+      if (const serialize::DoubleValue *time = item.second->as_double_value()) {
+        baseline[item.first] = time->value();
+      }
+    }
+  }
+
+  void TearDown() override
+  {
+    if (FLAGS_perf_output.empty()) {
+      return;
+    }
+    serialize::DictionaryValue dict;
+    for (const std::pair<std::string, double> &result : results) {
+      dict.elements().append_as(
+          std::pair(result.first, new serialize::DoubleValue(result.second)));
+    }
+    std::ofstream os(FLAGS_perf_output);
+    serialize::JsonFormatter json;
+    json.indentation_len = 2;
+    json.serialize(os, dict);
+  }
+};
+
+static ::testing::Environment *const performance_environment =
+    ::testing::AddGlobalTestEnvironment(new PerformanceEnvironment);
+
+/**
+ * Time `fn`, `setup` is called before every run and is not timed.
+ */
+template<typename SetupFn, typename Fn>
+static void benchmark(const std::string &name, const SetupFn &setup, const Fn &fn)
+{
+  double best_time = std::numeric_limits<double>::max();
+  for (int run = 0; run < NUM_RUNS + 1; run++) {
+    setup();
+    const timeit::TimePoint start = timeit::Clock::now();
+    fn();
+    const timeit::Nanoseconds duration = timeit::Clock::now() - start;
+    /* The first run is only used to warm up caches and the task scheduler. */
+    if (run > 0) {
+      best_time = std::min(best_time, std::chrono::duration<double>(duration).count());
+    }
+  }
+
+  results.emplace_back(name, best_time);
+
+  printf("\t%-50s %10.3f ms", name.c_str(), best_time * 1e3);
+  const std::map<std::string, double>::const_iterator it = baseline.find(name);
+  if (it != baseline.end()) {
+    printf("  (baseline %10.3f ms, %.2fx)", it->second * 1e3, best_time / it->second);
+  }
+  printf("\n");
+}
+
+template<typename Fn> static void benchmark(const std::string &name, const Fn &fn)
+{
+  benchmark(
+      name, []() {}, fn);
+}
+
+static Vector<int> random_ints(const int amount)
+{
+  RandomNumberGenerator rng(0);
+  Vector<int> values(amount);
+  for (int &value : values) {
+    value = rng.get_int32();
+  }
+  return values;
+}
+
+TEST(containers_performance, Map)
+{
+  const Vector<int> values = random_ints(1000000);
+  Map<int, int> map;
+  int64_t count = 0;
+
+  benchmark(
+      "Map<int, int> add", [&]() { map.clear(); },
+      [&]() {
+        for (const int value : values) {
+          map.add(value, value);
+        }
+      });
+  benchmark("Map<int, int> lookup", [&]() {
+    for (const int value : values) {
+      count += map.lookup_default(value, 0);
+    }
+  });
+  benchmark(
+      "Map<int, int> remove",
+      [&]() {
+        for (const int value : values) {
+          map.add(value, value);
+        }
+      },
+      [&]() {
+        for (const int value : values) {
+          map.remove(value);
+        }
+      });
+  EXPECT_NE(count, 0);
+}
+
+TEST(containers_performance, Set)
+{
+  const Vector<int> values = random_ints(1000000);
+  Set<int> set;
+  int64_t count = 0;
+
+  benchmark(
+      "Set<int> add", [&]() { set.clear(); },
+      [&]() {
+        for (const int value : values) {
+          set.add(value);
+        }
+      });
+  benchmark("Set<int> contains", [&]() {
+    for (const int value : values) {
+      count += set.contains(value);
+    }
+  });
+  EXPECT_EQ(count, values.size() * (NUM_RUNS + 1));
+}
+
+TEST(containers_performance, VectorSet)
+{
+  const Vector<int> values = random_ints(1000000);
+  VectorSet<int> vector_set;
+  int64_t count = 0;
+
+  benchmark(
+      "VectorSet<int> add", [&]() { vector_set.clear(); },
+      [&]() {
+        for (const int value : values) {
+          vector_set.add(value);
+        }
+      });
+  benchmark("VectorSet<int> index_of", [&]() {
+    for (const int value : values) {
+      count += vector_set.index_of(value);
+    }
+  });
+  EXPECT_GT(count, 0);
+}
+
+TEST(containers_performance, Vector)
+{
+  const int amount = 10000000;
+  Vector<int> vector;
+
+  benchmark(
+      "Vector<int> append", [&]() { vector.clear_and_make_inline(); },
+      [&]() {
+        for (int i = 0; i < amount; i++) {
+          vector.append(i);
+        }
+      });
+  benchmark(
+      "Vector<int> append reserved",
+      [&]() {
+        vector.clear_and_make_inline();
+        vector.reserve(amount);
+      },
+      [&]() {
+        for (int i = 0; i < amount; i++) {
+          vector.append_unchecked(i);
+        }
+      });
+  EXPECT_EQ(vector.size(), amount);
+}
+
+TEST(containers_performance, IndexMask)
+{
+  const int amount = 10000000;
+  Array<float> values(amount, 1.0f);
+  Vector<int64_t> indices;
+  for (int i = 0; i < amount; i += 2) {
+    indices.append(i);
+  }
+  float sum = 0.0f;
+
+  auto sum_masked = [&](const IndexMask mask) {
+    mask.foreach_index([&](const int64_t i) { sum += values[i]; });
+  };
+  benchmark("IndexMask foreach_index range", [&]() { sum_masked(IndexRange(amount)); });
+  benchmark("IndexMask foreach_index indices", [&]() { sum_masked(indices.as_span()); });
+  EXPECT_GT(sum, 0.0f);
+}
+
+TEST(containers_performance, ParallelForGrainSize)
+{
+  const int amount = 10000000;
+  Array<float> values(amount, 1.0f);
+
+  for (const int64_t grain_size : {1, 64, 512, 4096, 32768, 262144}) {
+    benchmark("parallel_for grain size " + std::to_string(grain_size), [&]() {
+      threading::parallel_for(IndexRange(amount), grain_size, [&](const IndexRange range) {
+        for (const int64_t i : range) {
+          values[i] = values[i] * 0.5f + 0.5f;
+        }
+      });
+    });
+  }
+  EXPECT_EQ(values[0], 1.0f);
+}
+
+TEST(containers_performance, Mempool)
+{
+  const int amount = 1000000;
+  const uint element_size = 32;
+  Vector<void *> elements(amount);
+
+  BLI_mempool *pool = BLI_mempool_create(element_size, 0, 512, BLI_MEMPOOL_NOP);
+  benchmark("BLI_mempool alloc and free", [&]() {
+    for (void *&element : elements) {
+      element = BLI_mempool_alloc(pool);
+    }
+    for (void *element : elements) {
+      BLI_mempool_free(pool, element);
+    }
+  });
+  BLI_mempool_destroy(pool);
+
+  benchmark("BLI_mempool create, alloc and destroy", [&]() {
+    BLI_mempool *pool = BLI_mempool_create(element_size, 0, 512, BLI_MEMPOOL_NOP);
+    for (void *&element : elements) {
+      element = BLI_mempool_alloc(pool);
+    }
+    BLI_mempool_destroy(pool);
+  });
+
+  benchmark("MEM_mallocN alloc and free", [&]() {
+    for (void *&element : elements) {
+      element = MEM_mallocN(element_size, __func__);
+    }
+    for (void *element : elements) {
+      MEM_freeN(element);
+    }
+  });
+}
+
+}  // namespace blender::tests
@@ -40,9 +40,15 @@ typedef struct {
    * detect unchanged IDs).
    * Defined when writing the next step (i.e. last undo step has those always false). */
   bool is_identical_future;
+  /** When true, this chunk doesn't own the memory either, it's shared with a chunk of the
+   * previous step that has the same content but isn't the matching chunk for this one
+   * (so unlike #is_identical, it doesn't mean that the data is unchanged). */
+  bool is_shared;
   /** Session UUID of the ID being currently written (MAIN_ID_SESSION_UUID_UNSET when not writing
    * ID-related data). Used to find matching chunks in previous memundo step. */
   uint id_session_uuid;
+  /** Hash of the content, used to find chunks with identical content in the next step. */
+  uint hash;
 } MemFileChunk;
 
 typedef struct MemFile {
@@ -59,6 +65,10 @@ typedef struct MemFileWriteData {
 
   /** Maps an ID session uuid to its first reference MemFileChunk, if existing. */
   struct GHash *id_session_uuid_mapping;
+  /** Maps a content hash to a reference MemFileChunk, to share memory of chunks that are not
+   * matching their reference chunk (e.g. data moved to another ID), but still have identical
+   * content. */
+  struct GHash *content_hash_mapping;
 } MemFileWriteData;
 
 typedef struct MemFileUndoData {
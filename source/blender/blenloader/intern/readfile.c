@@ -69,6 +69,7 @@
 #include "BLI_math.h"
 #include "BLI_memarena.h"
 #include "BLI_mempool.h"
+#include "BLI_task.h"
 #include "BLI_threads.h"
 
 #include "PIL_time.h"
@@ -181,6 +182,25 @@
  */
 #define USE_BHEAD_READ_ON_DEMAND
 
+#ifdef USE_BHEAD_READ_ON_DEMAND
+/**
+ * Delay reading (and DNA reconstruction) of large data blocks until their old address is
+ * looked up while reading the owning ID. Blocks that are never referenced (e.g. layers which
+ * versioning code discards) are never read at all, which lowers peak memory usage.
+ *
+ * \note This relies on #USE_BHEAD_READ_ON_DEMAND, so it's only used for seekable files.
+ */
+#  define USE_DATAMAP_READ_ON_DEMAND
+/** Smaller blocks are read immediately, the seek overhead isn't worth it. */
+#  define DATAMAP_READ_ON_DEMAND_MIN_LEN (1 << 16)
+#endif
+
+/**
+ * Arrays of structs with at least this many elements that need DNA reconstruction (e.g. mesh
+ * data from files saved with a different struct layout) are converted by multiple threads.
+ */
+#define RECONSTRUCT_PARALLEL_MIN_BLOCKS 8192
+
 /* use GHash for BHead name-based lookups (speeds up linking) */
 #define USE_GHASH_BHEAD
 
@@ -248,6 +268,11 @@ typedef struct OldNew {
   void *newp;
   /* `nr` is "user count" for data, and ID code for libdata. */
   int nr;
+#ifdef USE_DATAMAP_READ_ON_DEMAND
+  /** When set (and `newp` is NULL), the data still needs to be read from this block. */
+  struct BHead *bhead;
+  const char *allocname;
+#endif
 } OldNew;
 
 typedef struct OldNewMap {
@@ -363,9 +388,35 @@ static void oldnewmap_insert(OldNewMap *onm, const void *oldaddr, void *newaddr,
   entry.oldp = oldaddr;
   entry.newp = newaddr;
   entry.nr = nr;
+#ifdef USE_DATAMAP_READ_ON_DEMAND
+  entry.bhead = NULL;
+  entry.allocname = NULL;
+#endif
   oldnewmap_insert_or_replace(onm, entry);
 }
 
+#ifdef USE_DATAMAP_READ_ON_DEMAND
+/* Insert an entry which is read from `bhead` on first lookup, see #datamap_lookup_and_inc. */
+static void oldnewmap_insert_on_demand(OldNewMap *onm, BHead *bhead, const char *allocname)
+{
+  if (bhead->old == NULL) {
+    return;
+  }
+
+  if (UNLIKELY(onm->nentries == ENTRIES_CAPACITY(onm))) {
+    oldnewmap_increase_size(onm);
+  }
+
+  OldNew entry;
+  entry.oldp = bhead->old;
+  entry.newp = NULL;
+  entry.nr = 0;
+  entry.bhead = bhead;
+  entry.allocname = allocname;
+  oldnewmap_insert_or_replace(onm, entry);
+}
+#endif
+
 void blo_do_versions_oldnewmap_insert(OldNewMap *onm, const void *oldaddr, void *newaddr, int nr)
 {
   oldnewmap_insert(onm, oldaddr, newaddr, nr);
@@ -406,6 +457,12 @@ static void oldnewmap_clear(OldNewMap *onm)
   for (int i = 0; i < onm->nentries; i++) {
     OldNew *entry = &onm->entries[i];
     if (entry->nr == 0) {
+#ifdef USE_DATAMAP_READ_ON_DEMAND
+      /* Data that was never looked up was never read either. */
+      if (entry->newp == NULL) {
+        continue;
+      }
+#endif
       MEM_freeN(entry->newp);
       entry->newp = NULL;
     }
@@ -1506,16 +1563,38 @@ BlendThumbnail *BLO_thumbnail_from_file(const char *filepath)
 /** \name Old/New Pointer Map
  * \{ */
 
+static void *datamap_lookup_and_inc(FileData *fd, const void *adr, bool increase_users)
+{
+#ifdef USE_DATAMAP_READ_ON_DEMAND
+  OldNew *entry = oldnewmap_lookup_entry(fd->datamap, adr);
+  if (entry == NULL) {
+    return NULL;
+  }
+  if (entry->bhead != NULL) {
+    /* First access, read the data now. Clear the block so a failed read isn't retried. */
+    BHead *bhead = entry->bhead;
+    entry->bhead = NULL;
+    entry->newp = read_struct(fd, bhead, entry->allocname);
+  }
+  if (increase_users && entry->newp != NULL) {
+    entry->nr++;
+  }
+  return entry->newp;
+#else
+  return oldnewmap_lookup_and_inc(fd->datamap, adr, increase_users);
+#endif
+}
+
 /* Only direct data-blocks. */
 static void *newdataadr(FileData *fd, const void *adr)
 {
-  return oldnewmap_lookup_and_inc(fd->datamap, adr, true);
+  return datamap_lookup_and_inc(fd, adr, true);
 }
 
 /* Only direct data-blocks. */
 static void *newdataadr_no_us(FileData *fd, const void *adr)
 {
-  return oldnewmap_lookup_and_inc(fd->datamap, adr, false);
+  return datamap_lookup_and_inc(fd, adr, false);
 }
 
 void *blo_read_get_new_globaldata_address(FileData *fd, const void *adr)
@@ -1530,7 +1609,7 @@ static void *newpackedadr(FileData *fd, const void *adr)
     return oldnewmap_lookup_and_inc(fd->packedmap, adr, true);
   }
 
-  return oldnewmap_lookup_and_inc(fd->datamap, adr, true);
+  return datamap_lookup_and_inc(fd, adr, true);
 }
 
 /* only lib data */
@@ -1861,6 +1940,66 @@ static void switch_endian_structs(const struct SDNA *filesdna, BHead *bhead)
   }
 }
 
+typedef struct ReconstructParallelData {
+  const FileData *fd;
+  const BHead *bh;
+  int new_struct_nr;
+  int blocks_per_chunk;
+  void *new_blocks;
+} ReconstructParallelData;
+
+static void read_struct_reconstruct_chunk(void *__restrict userdata,
+                                          const int chunk,
+                                          const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const ReconstructParallelData *data = userdata;
+  const BHead *bh = data->bh;
+  const int block_start = chunk * data->blocks_per_chunk;
+  const int blocks = min_ii(data->blocks_per_chunk, bh->nr - block_start);
+  DNA_struct_reconstruct_range(data->fd->reconstruct_info,
+                               bh->SDNAnr,
+                               data->new_struct_nr,
+                               block_start,
+                               blocks,
+                               bh + 1,
+                               data->new_blocks);
+}
+
+/* Same as #DNA_struct_reconstruct, converting large arrays on multiple threads. */
+static void *read_struct_reconstruct(FileData *fd, BHead *bh)
+{
+  if (bh->nr < RECONSTRUCT_PARALLEL_MIN_BLOCKS) {
+    return DNA_struct_reconstruct(fd->reconstruct_info, bh->SDNAnr, bh->nr, (bh + 1));
+  }
+
+  const SDNA_Struct *old_struct = fd->filesdna->structs[bh->SDNAnr];
+  const int new_struct_nr = DNA_struct_find_nr(fd->memsdna,
+                                               fd->filesdna->types[old_struct->type]);
+  if (new_struct_nr == -1) {
+    return NULL;
+  }
+  const SDNA_Struct *new_struct = fd->memsdna->structs[new_struct_nr];
+  const size_t new_block_size = (size_t)fd->memsdna->types_size[new_struct->type];
+
+  ReconstructParallelData data;
+  data.fd = fd;
+  data.bh = bh;
+  data.new_struct_nr = new_struct_nr;
+  data.blocks_per_chunk = RECONSTRUCT_PARALLEL_MIN_BLOCKS / 4;
+  data.new_blocks = MEM_callocN((size_t)bh->nr * new_block_size, "reconstruct");
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1;
+  BLI_task_parallel_range(0,
+                          divide_ceil_u(bh->nr, data.blocks_per_chunk),
+                          &data,
+                          read_struct_reconstruct_chunk,
+                          &settings);
+
+  return data.new_blocks;
+}
+
 static void *read_struct(FileData *fd, BHead *bh, const char *blockname)
 {
   void *temp = NULL;
@@ -1895,7 +2034,7 @@ static void *read_struct(FileData *fd, BHead *bh, const char *blockname)
           }
         }
 #endif
-        temp = DNA_struct_reconstruct(fd->reconstruct_info, bh->SDNAnr, bh->nr, (bh + 1));
+        temp = read_struct_reconstruct(fd, bh);
       }
       else {
         /* SDNA_CMP_EQUAL */
@@ -3053,6 +3192,20 @@ static bool direct_link_id(FileData *fd, Main *main, const int tag, ID *id, ID *
   return success;
 }
 
+#ifdef USE_DATAMAP_READ_ON_DEMAND
+static bool datamap_use_read_on_demand(const FileData *fd, const BHead *bhead)
+{
+  /* Undo relies on the reading order to detect identical memory chunks. */
+  if (fd->flags & FD_FLAGS_IS_MEMFILE) {
+    return false;
+  }
+  if (fd->file->seek == NULL || bhead->len < DATAMAP_READ_ON_DEMAND_MIN_LEN) {
+    return false;
+  }
+  return BHEADN_FROM_BHEAD(bhead)->has_data == false;
+}
+#endif
+
 /* Read all data associated with a datablock into datamap. */
 static BHead *read_data_into_datamap(FileData *fd, BHead *bhead, const char *allocname)
 {
@@ -3075,6 +3228,14 @@ static BHead *read_data_into_datamap(FileData *fd, BHead *bhead, const char *all
     }
 #endif
 
+#ifdef USE_DATAMAP_READ_ON_DEMAND
+    if (datamap_use_read_on_demand(fd, bhead)) {
+      oldnewmap_insert_on_demand(fd->datamap, bhead, allocname);
+      bhead = blo_bhead_next(fd, bhead);
+      continue;
+    }
+#endif
+
     void *data = read_struct(fd, bhead, allocname);
     if (data) {
       oldnewmap_insert(fd->datamap, bhead->old, data, 0);
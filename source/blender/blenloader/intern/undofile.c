@@ -42,6 +42,7 @@
 
 #include "BLI_blenlib.h"
 #include "BLI_ghash.h"
+#include "BLI_hash_mm3.h"
 
 #include "BLO_readfile.h"
 #include "BLO_undofile.h"
@@ -55,12 +56,23 @@
 
 /* **************** support for memory-write, for undo buffers *************** */
 
+/**
+ * Only chunks of at least this size are looked up by content,
+ * for smaller ones hashing costs more than sharing saves.
+ */
+#define MEMFILE_SHARE_CHUNK_MIN_SIZE 256
+
+BLI_INLINE bool memfile_chunk_owns_buffer(const MemFileChunk *chunk)
+{
+  return !(chunk->is_identical || chunk->is_shared);
+}
+
 void BLO_memfile_free(MemFile *memfile)
 {
   MemFileChunk *chunk;
 
   while ((chunk = BLI_pophead(&memfile->chunks))) {
-    if (chunk->is_identical == false) {
+    if (memfile_chunk_owns_buffer(chunk)) {
       MEM_freeN((void *)chunk->buf);
     }
     MEM_freeN(chunk);
@@ -77,7 +89,7 @@ void BLO_memfile_merge(MemFile *first, MemFile *second)
 
   /* First, detect all memchunks in second memfile that are not owned by it. */
   for (MemFileChunk *sc = second->chunks.first; sc != NULL; sc = sc->next) {
-    if (sc->is_identical) {
+    if (!memfile_chunk_owns_buffer(sc)) {
       BLI_ghash_insert(buffer_to_second_memchunk, (void *)sc->buf, sc);
     }
   }
@@ -85,11 +97,12 @@ void BLO_memfile_merge(MemFile *first, MemFile *second)
   /* Now, check all chunks from first memfile (the one we are removing), and if a memchunk owned by
    * it is also used by the second memfile, transfer the ownership. */
   for (MemFileChunk *fc = first->chunks.first; fc != NULL; fc = fc->next) {
-    if (!fc->is_identical) {
+    if (memfile_chunk_owns_buffer(fc)) {
       MemFileChunk *sc = BLI_ghash_lookup(buffer_to_second_memchunk, fc->buf);
       if (sc != NULL) {
-        BLI_assert(sc->is_identical);
+        BLI_assert(!memfile_chunk_owns_buffer(sc));
         sc->is_identical = false;
+        sc->is_shared = false;
         fc->is_identical = true;
       }
       /* Note that if the second memfile does not use that chunk, we assume that the first one
@@ -141,6 +154,20 @@ void BLO_memfile_write_init(MemFileWriteData *mem_data,
         }
       }
     }
+
+    /* Index the content of the reference chunks, so identical data that doesn't match
+     * chunk-by-chunk (because other data was inserted or removed before it) is still shared. */
+    mem_data->content_hash_mapping = BLI_ghash_new(
+        BLI_ghashutil_inthash_p_simple, BLI_ghashutil_intcmp, __func__);
+    LISTBASE_FOREACH (MemFileChunk *, mem_chunk, &reference_memfile->chunks) {
+      if (mem_chunk->size >= MEMFILE_SHARE_CHUNK_MIN_SIZE) {
+        void **entry;
+        if (!BLI_ghash_ensure_p(
+                mem_data->content_hash_mapping, POINTER_FROM_UINT(mem_chunk->hash), &entry)) {
+          *entry = mem_chunk;
+        }
+      }
+    }
   }
 }
 
@@ -149,6 +176,9 @@ void BLO_memfile_write_finalize(MemFileWriteData *mem_data)
   if (mem_data->id_session_uuid_mapping != NULL) {
     BLI_ghash_free(mem_data->id_session_uuid_mapping, NULL, NULL);
   }
+  if (mem_data->content_hash_mapping != NULL) {
+    BLI_ghash_free(mem_data->content_hash_mapping, NULL, NULL);
+  }
 }
 
 void BLO_memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, size_t size)
@@ -160,6 +190,8 @@ void BLO_memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, size_t s
   curchunk->size = size;
   curchunk->buf = NULL;
   curchunk->is_identical = false;
+  curchunk->is_shared = false;
+  curchunk->hash = 0;
   /* This is unsafe in the sense that an app handler or other code that does not
    * perform an undo push may make changes after the last undo push that
    * will then not be undo. Though it's not entirely clear that is wrong behavior. */
@@ -173,6 +205,7 @@ void BLO_memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, size_t s
     if (compchunk->size == curchunk->size) {
       if (memcmp(compchunk->buf, buf, size) == 0) {
         curchunk->buf = compchunk->buf;
+        curchunk->hash = compchunk->hash;
         curchunk->is_identical = true;
         compchunk->is_identical_future = true;
       }
@@ -180,6 +213,19 @@ void BLO_memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, size_t s
     *compchunk_step = compchunk->next;
   }
 
+  /* Not equal, try to find a reference chunk with the same content. */
+  if (curchunk->buf == NULL && size >= MEMFILE_SHARE_CHUNK_MIN_SIZE) {
+    curchunk->hash = BLI_hash_mm3((const unsigned char *)buf, size, 0);
+    if (mem_data->content_hash_mapping != NULL) {
+      MemFileChunk *refchunk = BLI_ghash_lookup(mem_data->content_hash_mapping,
+                                                POINTER_FROM_UINT(curchunk->hash));
+      if (refchunk != NULL && refchunk->size == size && memcmp(refchunk->buf, buf, size) == 0) {
+        curchunk->buf = refchunk->buf;
+        curchunk->is_shared = true;
+      }
+    }
+  }
+
   /* not equal... */
   if (curchunk->buf == NULL) {
     char *buf_new = MEM_mallocN(size, "Chunk buffer");
@@ -212,6 +258,21 @@ struct Main *BLO_memfile_main_get(struct MemFile *memfile,
   return bmain_undo;
 }
 
+/** Size of the buffer used to gather chunks when writing a #MemFile to disk. */
+#define MEMFILE_WRITE_BUFFER_SIZE (1 << 20)
+
+static bool memfile_write_data(int file, const char *data, size_t size)
+{
+  if (size == 0) {
+    return true;
+  }
+#ifdef _WIN32
+  return (size_t)write(file, data, (uint)size) == size;
+#else
+  return (size_t)write(file, data, size) == size;
+#endif
+}
+
 bool BLO_memfile_write_file(struct MemFile *memfile, const char *filename)
 {
   MemFileChunk *chunk;
@@ -243,16 +304,36 @@ bool BLO_memfile_write_file(struct MemFile *memfile, const char *filename)
     return false;
   }
 
+  /* Most chunks are small, so gather them in a buffer instead of doing a system call for each
+   * chunk, this makes writing large files (e.g. autosave) much faster. */
+  const size_t buffer_size = MEMFILE_WRITE_BUFFER_SIZE;
+  char *buffer = MEM_mallocN(buffer_size, __func__);
+  size_t buffer_used = 0;
+
   for (chunk = memfile->chunks.first; chunk; chunk = chunk->next) {
-#ifdef _WIN32
-    if ((size_t)write(file, chunk->buf, (uint)chunk->size) != chunk->size)
-#else
-    if ((size_t)write(file, chunk->buf, chunk->size) != chunk->size)
-#endif
-    {
-      break;
+    if (buffer_used + chunk->size > buffer_size) {
+      if (!memfile_write_data(file, buffer, buffer_used)) {
+        break;
+      }
+      buffer_used = 0;
+    }
+    if (chunk->size >= buffer_size) {
+      /* Write large chunks directly. */
+      if (!memfile_write_data(file, chunk->buf, chunk->size)) {
+        break;
+      }
+    }
+    else {
+      memcpy(buffer + buffer_used, chunk->buf, chunk->size);
+      buffer_used += chunk->size;
     }
   }
+  if (chunk == NULL && !memfile_write_data(file, buffer, buffer_used)) {
+    /* Use the last chunk to report the error below. */
+    chunk = memfile->chunks.last;
+  }
+
+  MEM_freeN(buffer);
 
   close(file);
 
@@ -348,6 +348,10 @@ static void do_versions_theme(const UserDef *userdef, bTheme *btheme)
    */
   {
     /* Keep this block, even when empty. */
+    /* The limit can't be set to zero, it is still unset in older preferences. */
+    if (userdef->geometry_nodes_cache_limit == 0) {
+      userdef->geometry_nodes_cache_limit = 256;
+    }
   }
 
 #undef FROM_DEFAULT_V4_UCHAR
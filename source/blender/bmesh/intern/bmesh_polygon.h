@@ -232,6 +232,35 @@ void BM_face_triangulate(BMesh *bm,
                          struct MemArena *pf_arena,
                          struct Heap *pf_heap) ATTR_NONNULL(1, 2);
 
+/**
+ * Calculate the triangles #BM_face_triangulate would split `f` into, without changing the mesh,
+ * so the triangulation of many faces can be calculated in parallel.
+ *
+ * \param r_loops: An array of `f->len` loops, triangle indices refer to this array.
+ * \param r_tris: An array of `f->len` triangles, the first `f->len - 2` are filled in.
+ */
+void BM_face_triangulate_calc(const BMFace *f,
+                              int quad_method,
+                              int ngon_method,
+                              BMLoop **r_loops,
+                              uint (*r_tris)[3],
+                              struct MemArena *pf_arena,
+                              struct Heap *pf_heap) ATTR_NONNULL(1, 4, 5);
+/**
+ * Split `f` into the triangles calculated by #BM_face_triangulate_calc,
+ * arguments match #BM_face_triangulate.
+ */
+void BM_face_triangulate_from_tris(BMesh *bm,
+                                   BMFace *f,
+                                   BMLoop **loops,
+                                   const uint (*tris)[3],
+                                   BMFace **r_faces_new,
+                                   int *r_faces_new_tot,
+                                   BMEdge **r_edges_new,
+                                   int *r_edges_new_tot,
+                                   struct LinkNode **r_faces_double,
+                                   bool use_tag) ATTR_NONNULL(1, 2, 3, 4);
+
 /**
  * each pair of loops defines a new edge, a split.  this function goes
  * through and sets pairs that are geometrically invalid to null.  a
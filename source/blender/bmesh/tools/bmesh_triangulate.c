@@ -28,6 +28,7 @@
 #include "BLI_heap.h"
 #include "BLI_linklist.h"
 #include "BLI_memarena.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 /* only for defines */
@@ -38,39 +39,86 @@
 
 #include "bmesh_triangulate.h" /* own include */
 
+/* -------------------------------------------------------------------- */
+/** \name Triangulation Calculation
+ *
+ * The triangles of all faces are calculated in parallel before any face is split,
+ * splitting a face doesn't change the loops of the other faces.
+ * \{ */
+
+typedef struct TriangulateCalcData {
+  BMFace **faces;
+  /* Offset of the loops and triangles of each face. */
+  const int *face_offsets;
+  BMLoop **loops;
+  uint (*tris)[3];
+  int quad_method;
+  int ngon_method;
+} TriangulateCalcData;
+
+typedef struct TriangulateCalcTLS {
+  MemArena *pf_arena;
+  Heap *pf_heap;
+} TriangulateCalcTLS;
+
+static void bm_mesh_triangulate_calc_cb(void *__restrict userdata,
+                                        const int i,
+                                        const TaskParallelTLS *__restrict tls)
+{
+  TriangulateCalcData *data = userdata;
+  TriangulateCalcTLS *tls_data = tls->userdata_chunk;
+  BMFace *face = data->faces[i];
+  const int offset = data->face_offsets[i];
+
+  if (face->len > 4 && tls_data->pf_arena == NULL) {
+    tls_data->pf_arena = BLI_memarena_new(BLI_POLYFILL_ARENA_SIZE, __func__);
+    if (data->ngon_method == MOD_TRIANGULATE_NGON_BEAUTY) {
+      tls_data->pf_heap = BLI_heap_new_ex(BLI_POLYFILL_ALLOC_NGON_RESERVE);
+    }
+  }
+
+  BM_face_triangulate_calc(face,
+                           data->quad_method,
+                           data->ngon_method,
+                           &data->loops[offset],
+                           &data->tris[offset],
+                           tls_data->pf_arena,
+                           tls_data->pf_heap);
+}
+
+static void bm_mesh_triangulate_calc_free(const void *__restrict UNUSED(userdata),
+                                          void *__restrict chunk)
+{
+  TriangulateCalcTLS *tls_data = chunk;
+  if (tls_data->pf_arena) {
+    BLI_memarena_free(tls_data->pf_arena);
+  }
+  if (tls_data->pf_heap) {
+    BLI_heap_free(tls_data->pf_heap, NULL);
+  }
+}
+
+/** \} */
+
 /**
  * a version of #BM_face_triangulate that maps to #BMOpSlot
  */
 static void bm_face_triangulate_mapping(BMesh *bm,
                                         BMFace *face,
-                                        const int quad_method,
-                                        const int ngon_method,
+                                        BMLoop **loops,
+                                        const uint (*tris)[3],
                                         const bool use_tag,
                                         BMOperator *op,
                                         BMOpSlot *slot_facemap_out,
-                                        BMOpSlot *slot_facemap_double_out,
-
-                                        MemArena *pf_arena,
-                                        /* use for MOD_TRIANGULATE_NGON_BEAUTY only! */
-                                        struct Heap *pf_heap)
+                                        BMOpSlot *slot_facemap_double_out)
 {
   int faces_array_tot = face->len - 3;
   BMFace **faces_array = BLI_array_alloca(faces_array, faces_array_tot);
   LinkNode *faces_double = NULL;
   BLI_assert(face->len > 3);
 
-  BM_face_triangulate(bm,
-                      face,
-                      faces_array,
-                      &faces_array_tot,
-                      NULL,
-                      NULL,
-                      &faces_double,
-                      quad_method,
-                      ngon_method,
-                      use_tag,
-                      pf_arena,
-                      pf_heap);
+  BM_face_triangulate_from_tris(
+      bm, face, loops, tris, faces_array, &faces_array_tot, NULL, NULL, &faces_double, use_tag);
 
   if (faces_array_tot) {
     int i;
@@ -99,57 +147,88 @@ void BM_mesh_triangulate(BMesh *bm,
 {
   BMIter iter;
   BMFace *face;
-  MemArena *pf_arena;
-  Heap *pf_heap;
-
-  pf_arena = BLI_memarena_new(BLI_POLYFILL_ARENA_SIZE, __func__);
-
-  if (ngon_method == MOD_TRIANGULATE_NGON_BEAUTY) {
-    pf_heap = BLI_heap_new_ex(BLI_POLYFILL_ALLOC_NGON_RESERVE);
+  int faces_len = 0;
+  int loops_len = 0;
+
+  BM_ITER_MESH (face, &iter, bm, BM_FACES_OF_MESH) {
+    if (face->len >= min_vertices) {
+      if (tag_only == false || BM_elem_flag_test(face, BM_ELEM_TAG)) {
+        faces_len++;
+        loops_len += face->len;
+      }
+    }
   }
-  else {
-    pf_heap = NULL;
+
+  if (faces_len == 0) {
+    return;
   }
 
-  if (slot_facemap_out) {
-    /* same as below but call: bm_face_triangulate_mapping() */
+  BMFace **faces = MEM_malloc_arrayN(faces_len, sizeof(*faces), __func__);
+  int *face_offsets = MEM_malloc_arrayN(faces_len, sizeof(*face_offsets), __func__);
+  BMLoop **loops = MEM_malloc_arrayN(loops_len, sizeof(*loops), __func__);
+  uint(*tris)[3] = MEM_malloc_arrayN(loops_len, sizeof(*tris), __func__);
+
+  {
+    int i = 0;
+    int offset = 0;
     BM_ITER_MESH (face, &iter, bm, BM_FACES_OF_MESH) {
       if (face->len >= min_vertices) {
         if (tag_only == false || BM_elem_flag_test(face, BM_ELEM_TAG)) {
-          bm_face_triangulate_mapping(bm,
-                                      face,
-                                      quad_method,
-                                      ngon_method,
-                                      tag_only,
-                                      op,
-                                      slot_facemap_out,
-                                      slot_facemap_double_out,
-                                      pf_arena,
-                                      pf_heap);
+          faces[i] = face;
+          face_offsets[i] = offset;
+          offset += face->len;
+          i++;
         }
       }
     }
   }
+
+  TriangulateCalcData data = {
+      .faces = faces,
+      .face_offsets = face_offsets,
+      .loops = loops,
+      .tris = tris,
+      .quad_method = quad_method,
+      .ngon_method = ngon_method,
+  };
+  TriangulateCalcTLS tls_data = {NULL};
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = faces_len > 256;
+  settings.min_iter_per_thread = 256;
+  settings.userdata_chunk = &tls_data;
+  settings.userdata_chunk_size = sizeof(tls_data);
+  settings.func_free = bm_mesh_triangulate_calc_free;
+  BLI_task_parallel_range(0, faces_len, &data, bm_mesh_triangulate_calc_cb, &settings);
+
+  if (slot_facemap_out) {
+    /* same as below but call: bm_face_triangulate_mapping() */
+    for (int i = 0; i < faces_len; i++) {
+      bm_face_triangulate_mapping(bm,
+                                  faces[i],
+                                  &loops[face_offsets[i]],
+                                  (const uint(*)[3])&tris[face_offsets[i]],
+                                  tag_only,
+                                  op,
+                                  slot_facemap_out,
+                                  slot_facemap_double_out);
+    }
+  }
   else {
     LinkNode *faces_double = NULL;
 
-    BM_ITER_MESH (face, &iter, bm, BM_FACES_OF_MESH) {
-      if (face->len >= min_vertices) {
-        if (tag_only == false || BM_elem_flag_test(face, BM_ELEM_TAG)) {
-          BM_face_triangulate(bm,
-                              face,
-                              NULL,
-                              NULL,
-                              NULL,
-                              NULL,
-                              &faces_double,
-                              quad_method,
-                              ngon_method,
-                              tag_only,
-                              pf_arena,
-                              pf_heap);
-        }
-      }
+    for (int i = 0; i < faces_len; i++) {
+      BM_face_triangulate_from_tris(bm,
+                                    faces[i],
+                                    &loops[face_offsets[i]],
+                                    (const uint(*)[3])&tris[face_offsets[i]],
+                                    NULL,
+                                    NULL,
+                                    NULL,
+                                    NULL,
+                                    &faces_double,
+                                    tag_only);
     }
 
     while (faces_double) {
@@ -160,9 +239,8 @@ void BM_mesh_triangulate(BMesh *bm,
     }
   }
 
-  BLI_memarena_free(pf_arena);
-
-  if (ngon_method == MOD_TRIANGULATE_NGON_BEAUTY) {
-    BLI_heap_free(pf_heap, NULL);
-  }
+  MEM_freeN(faces);
+  MEM_freeN(face_offsets);
+  MEM_freeN(loops);
+  MEM_freeN(tris);
 }
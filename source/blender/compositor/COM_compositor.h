@@ -339,6 +339,10 @@ extern "C" {
  * \param display_settings:
  *   reference to display settings used for color management
  *
+ * \param viewer_visible_area:
+ *   normalized area of the viewer image that is displayed, viewers only compute pixels within
+ *   it. Null when all of the image may be displayed. Only used by the full frame execution model.
+ *
  * OCIO_TODO: this options only used in rare cases, namely in output file node,
  *            so probably this settings could be passed in a nicer way.
  *            should be checked further, probably it'll be also needed for preview
@@ -352,7 +356,8 @@ void COM_execute(RenderData *render_data,
                  int rendering,
                  const ColorManagedViewSettings *view_settings,
                  const ColorManagedDisplaySettings *display_settings,
-                 const char *view_name);
+                 const char *view_name,
+                 const rctf *viewer_visible_area);
 
 /**
  * \brief Deinitialize the compositor caches and allocated memory.
@@ -363,8 +368,23 @@ void COM_deinitialize(void);
 /**
  * \brief Clear all compositor caches. (Compositor system will still remain available).
  * To deinitialize the compositor use the COM_deinitialize method.
+ *
+ * Must be called when the compositor inputs change, for example with a new render result.
+ * It may be called from any thread, caches are freed before the next execution.
+ */
+void COM_clear_caches(void);
+
+/**
+ * \brief Get the profile of a node in the latest execution of the compositor.
+ * Only nodes executed with the full frame execution model have a profile.
+ *
+ * \param r_execution_time: time spent rendering the node operations, in seconds.
+ * \param r_allocated_bytes: size of the buffers allocated for the node operations results.
+ * \return false when no operation of the node was rendered.
  */
-// void COM_clear_caches(void); // NOT YET WRITTEN
+bool COM_get_node_profile(bNodeInstanceKey node_key,
+                          double *r_execution_time,
+                          size_t *r_allocated_bytes);
 
 #ifdef __cplusplus
 }
@@ -124,6 +124,31 @@ constexpr float COM_PREVIEW_SIZE = 140.f;
 constexpr float COM_RULE_OF_THIRDS_DIVIDER = 100.0f;
 constexpr float COM_BLUR_BOKEH_PIXELS = 512;
 
+/**
+ * Number of parts per CPU thread the work of full frame operations is split into. Having more
+ * parts than threads keeps all threads busy until the end of an operation when some rows are more
+ * expensive to compute or threads are shared with other tasks, like viewport rendering.
+ */
+constexpr int COM_NUM_SUB_WORKS_PER_THREAD = 4;
+
+/**
+ * Maximum memory in bytes used by operations buffers kept between executions when editing the
+ * node tree, see #BufferCache.
+ */
+constexpr size_t COM_BUFFER_CACHE_MAX_MEMORY = 1024 * 1024 * 1024;
+/**
+ * Minimum time in seconds an operation must take to render for its buffer to be kept between
+ * executions. Faster operations are rendered again, leaving the cache memory for slow ones.
+ */
+constexpr double COM_BUFFER_CACHE_MIN_RENDER_TIME = 0.01;
+
+/**
+ * Number of pixels of the bands in which chains of per pixel operations are rendered in full
+ * frame. Each band goes through all operations of the chain on the same thread, small enough for
+ * intermediate results to stay in CPU caches.
+ */
+constexpr int COM_STREAM_BAND_NUM_PIXELS = 1 << 14;
+
 constexpr rcti COM_AREA_NONE = {0, 0, 0, 0};
 constexpr rcti COM_CONSTANT_INPUT_AREA_OF_INTEREST = COM_AREA_NONE;
 
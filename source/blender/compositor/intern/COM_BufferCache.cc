@@ -0,0 +1,138 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Copyright 2021, Blender Foundation.
+ */
+
+#include <optional>
+
+#include "COM_BufferCache.h"
+#include "COM_MemoryBuffer.h"
+#include "COM_PackedBuffer.h"
+#include "COM_defines.h"
+
+namespace blender::compositor {
+
+BufferCache::BufferCache() : memory_size_(0), execution_(0)
+{
+}
+
+BufferCache::~BufferCache() = default;
+
+void BufferCache::execution_started()
+{
+  execution_++;
+}
+
+MemoryBuffer *BufferCache::lookup(const size_t key)
+{
+  CachedBuffer *cached = buffers_.lookup_ptr(key);
+  if (cached == nullptr) {
+    return nullptr;
+  }
+
+  cached->last_used_execution = execution_;
+  if (cached->buffer == nullptr) {
+    const size_t packed_size = cached->packed->get_memory_size();
+    const size_t unpacked_size = cached->packed->get_unpacked_memory_size();
+    if (!free_memory(unpacked_size - packed_size)) {
+      return nullptr;
+    }
+
+    /* Buffer in use is not discarded when freeing memory. */
+    cached = buffers_.lookup_ptr(key);
+    cached->buffer = cached->packed->unpack();
+    cached->packed.reset();
+    cached->memory_size = unpacked_size;
+    memory_size_ += unpacked_size - packed_size;
+  }
+  return cached->buffer.get();
+}
+
+bool BufferCache::add(const size_t key, std::unique_ptr<MemoryBuffer> &buffer)
+{
+  if (buffers_.contains(key)) {
+    return false;
+  }
+
+  const size_t memory_size = buffer->get_memory_size();
+  if (!free_memory(memory_size)) {
+    return false;
+  }
+
+  CachedBuffer cached;
+  cached.buffer = std::move(buffer);
+  cached.can_pack = true;
+  cached.memory_size = memory_size;
+  cached.last_used_execution = execution_;
+  buffers_.add_new(key, std::move(cached));
+  memory_size_ += memory_size;
+  return true;
+}
+
+std::optional<size_t> BufferCache::find_lru_buffer(const bool packable)
+{
+  std::optional<size_t> lru_key;
+  int lru_execution = execution_;
+  for (Map<size_t, CachedBuffer>::Item item : buffers_.items()) {
+    if (packable && !(item.value.buffer && item.value.can_pack)) {
+      continue;
+    }
+    if (item.value.last_used_execution < lru_execution) {
+      lru_key = item.key;
+      lru_execution = item.value.last_used_execution;
+    }
+  }
+  return lru_key;
+}
+
+bool BufferCache::free_memory(const size_t required_size)
+{
+  if (required_size > COM_BUFFER_CACHE_MAX_MEMORY) {
+    return false;
+  }
+
+  while (memory_size_ + required_size > COM_BUFFER_CACHE_MAX_MEMORY) {
+    /* Pack buffers before discarding any, least recently used first. */
+    std::optional<size_t> key = find_lru_buffer(true);
+    if (key) {
+      CachedBuffer &cached = buffers_.lookup(*key);
+      cached.packed = PackedBuffer::pack(*cached.buffer);
+      cached.can_pack = cached.packed != nullptr;
+      if (cached.packed) {
+        cached.buffer.reset();
+        memory_size_ -= cached.memory_size - cached.packed->get_memory_size();
+        cached.memory_size = cached.packed->get_memory_size();
+      }
+      continue;
+    }
+
+    key = find_lru_buffer(false);
+    if (!key) {
+      return false;
+    }
+    memory_size_ -= buffers_.lookup(*key).memory_size;
+    buffers_.remove(*key);
+  }
+  return true;
+}
+
+void BufferCache::clear()
+{
+  buffers_.clear();
+  memory_size_ = 0;
+}
+
+}  // namespace blender::compositor
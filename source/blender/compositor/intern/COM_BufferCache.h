@@ -0,0 +1,108 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Copyright 2021, Blender Foundation.
+ */
+
+#pragma once
+
+#include <memory>
+#include <optional>
+
+#include "BLI_map.hh"
+
+#ifdef WITH_CXX_GUARDEDALLOC
+#  include "MEM_guardedalloc.h"
+#endif
+
+namespace blender::compositor {
+
+class MemoryBuffer;
+class PackedBuffer;
+
+/**
+ * Keeps operations rendered buffers between executions, so that when editing the node tree only
+ * the operations affected by the changes are rendered again. Buffers are identified by a key
+ * that must take into account the operation parameters and the keys of all its inputs, see
+ * #FullFrameExecutionModel. Once the cache memory exceeds #COM_BUFFER_CACHE_MAX_MEMORY, least
+ * recently used buffers are packed when their elements fit in a smaller type, see #PackedBuffer,
+ * or discarded otherwise. Packed buffers are unpacked when looked up.
+ *
+ * It's not thread safe, executions are serialized by the compositor lock.
+ */
+class BufferCache {
+ private:
+  typedef struct CachedBuffer {
+   public:
+    /** Buffer with float elements, nullptr when packed. */
+    std::unique_ptr<MemoryBuffer> buffer;
+    std::unique_ptr<PackedBuffer> packed;
+    /** False when packing was tried and the elements don't fit in a smaller type. */
+    bool can_pack;
+    size_t memory_size;
+    /** Last execution that used the buffer. Buffers in use are never discarded. */
+    int last_used_execution;
+  } CachedBuffer;
+  blender::Map<size_t, CachedBuffer> buffers_;
+  size_t memory_size_;
+  int execution_;
+
+ public:
+  BufferCache();
+  ~BufferCache();
+
+  /**
+   * Reports a new execution is starting. Buffers used by previous executions may be discarded
+   * from this point on.
+   */
+  void execution_started();
+
+  /**
+   * Get buffer stored with given key or nullptr if there is none or it can't be unpacked in the
+   * available memory. The buffer is kept until the next execution at least.
+   */
+  MemoryBuffer *lookup(size_t key);
+
+  /**
+   * Stores given buffer taking its ownership, discarding least recently used buffers when
+   * needed. Returns false when it's not stored, either because there is a buffer with the same
+   * key already or because it doesn't fit in memory, then buffer ownership remains unchanged.
+   */
+  bool add(size_t key, std::unique_ptr<MemoryBuffer> &buffer);
+
+  /**
+   * Discards all buffers. Must not be called during an execution.
+   */
+  void clear();
+
+ private:
+  /**
+   * Packs or discards least recently used buffers not in use until given memory size is
+   * available.
+   */
+  bool free_memory(size_t required_size);
+
+  /**
+   * Find key of the least recently used buffer not in use by current execution. When packable is
+   * true, only float buffers which may be packed are considered.
+   */
+  std::optional<size_t> find_lru_buffer(bool packable);
+
+#ifdef WITH_CXX_GUARDEDALLOC
+  MEM_CXX_CLASS_ALLOC_FUNCS("COM:BufferCache")
+#endif
+};
+
+}  // namespace blender::compositor
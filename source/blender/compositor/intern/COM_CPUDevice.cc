@@ -21,6 +21,8 @@
 #include "COM_ExecutionGroup.h"
 #include "COM_NodeOperation.h"
 
+#include "BLI_profile.hh"
+
 namespace blender::compositor {
 
 CPUDevice::CPUDevice(int thread_id) : thread_id_(thread_id)
@@ -29,6 +31,7 @@ CPUDevice::CPUDevice(int thread_id) : thread_id_(thread_id)
 
 void CPUDevice::execute(WorkPackage *work_package)
 {
+  BLI_PROFILE_SCOPE("COM work package");
   switch (work_package->type) {
     case eWorkPackageType::Tile: {
       const unsigned int chunk_number = work_package->chunk_number;
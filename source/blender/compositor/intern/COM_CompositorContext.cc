@@ -30,6 +30,9 @@ CompositorContext::CompositorContext()
   view_settings_ = nullptr;
   display_settings_ = nullptr;
   bnodetree_ = nullptr;
+  buffer_cache_ = nullptr;
+  viewer_visible_area_ = nullptr;
+  profiler_ = nullptr;
 }
 
 int CompositorContext::get_framenumber() const
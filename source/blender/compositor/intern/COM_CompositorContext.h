@@ -28,6 +28,9 @@ struct bNodeInstanceHash;
 
 namespace blender::compositor {
 
+class BufferCache;
+class Profiler;
+
 /**
  * \brief Overall context of the compositor
  */
@@ -69,6 +72,24 @@ class CompositorContext {
    */
   bNodeInstanceHash *previews_;
 
+  /**
+   * \brief Operations buffers kept between executions, nullptr when buffers must not be cached.
+   * This field is initialized in ExecutionSystem and must only be read from that point on.
+   */
+  BufferCache *buffer_cache_;
+
+  /**
+   * \brief Normalized area of the viewer image that is displayed, nullptr when all of it is.
+   * This field is initialized in ExecutionSystem and must only be read from that point on.
+   */
+  const rctf *viewer_visible_area_;
+
+  /**
+   * \brief Records execution time and memory of the nodes.
+   * This field is initialized in ExecutionSystem and must only be read from that point on.
+   */
+  Profiler *profiler_;
+
   /**
    * \brief does this system have active opencl devices?
    */
@@ -167,6 +188,48 @@ class CompositorContext {
     return previews_;
   }
 
+  /**
+   * \brief set the cache of operations buffers kept between executions
+   */
+  void set_buffer_cache(BufferCache *buffer_cache)
+  {
+    buffer_cache_ = buffer_cache;
+  }
+
+  /**
+   * \brief get the cache of operations buffers kept between executions
+   */
+  BufferCache *get_buffer_cache() const
+  {
+    return buffer_cache_;
+  }
+
+  void set_profiler(Profiler *profiler)
+  {
+    profiler_ = profiler;
+  }
+
+  Profiler *get_profiler() const
+  {
+    return profiler_;
+  }
+
+  /**
+   * \brief set the normalized area of the viewer image that is displayed
+   */
+  void set_viewer_visible_area(const rctf *viewer_visible_area)
+  {
+    viewer_visible_area_ = viewer_visible_area;
+  }
+
+  /**
+   * \brief get the normalized area of the viewer image that is displayed
+   */
+  const rctf *get_viewer_visible_area() const
+  {
+    return viewer_visible_area_;
+  }
+
   /**
    * \brief set view settings of color management
    */
@@ -27,6 +27,8 @@
 #include "COM_WorkPackage.h"
 #include "COM_WorkScheduler.h"
 
+#include "BLI_profile.hh"
+
 #ifdef WITH_CXX_GUARDEDALLOC
 #  include "MEM_guardedalloc.h"
 #endif
@@ -40,7 +42,10 @@ ExecutionSystem::ExecutionSystem(RenderData *rd,
                                  bool fastcalculation,
                                  const ColorManagedViewSettings *view_settings,
                                  const ColorManagedDisplaySettings *display_settings,
-                                 const char *view_name)
+                                 const char *view_name,
+                                 BufferCache *buffer_cache,
+                                 const rctf *viewer_visible_area,
+                                 Profiler *profiler)
 {
   num_work_threads_ = WorkScheduler::get_num_cpu_threads();
   context_.set_view_name(view_name);
@@ -62,6 +67,9 @@ ExecutionSystem::ExecutionSystem(RenderData *rd,
   context_.set_render_data(rd);
   context_.set_view_settings(view_settings);
   context_.set_display_settings(display_settings);
+  context_.set_buffer_cache(buffer_cache);
+  context_.set_viewer_visible_area(viewer_visible_area);
+  context_.set_profiler(profiler);
 
   BLI_mutex_init(&work_mutex_);
   BLI_condition_init(&work_finished_cond_);
@@ -111,6 +119,7 @@ void ExecutionSystem::set_operations(const Vector<NodeOperation *> &operations,
 
 void ExecutionSystem::execute()
 {
+  BLI_PROFILE_SCOPE("COM execute");
   DebugInfo::execute_started(this);
   for (NodeOperation *op : operations_) {
     op->init_data();
@@ -127,7 +136,7 @@ void ExecutionSystem::execute_work(const rcti &work_rect,
 
   /* Split work vertically to maximize continuous memory. */
   const int work_height = BLI_rcti_size_y(&work_rect);
-  const int num_sub_works = MIN2(num_work_threads_, work_height);
+  const int num_sub_works = MIN2(num_work_threads_ * COM_NUM_SUB_WORKS_PER_THREAD, work_height);
   const int split_height = num_sub_works == 0 ? 0 : work_height / num_sub_works;
   int remaining_height = work_height - split_height * num_sub_works;
 
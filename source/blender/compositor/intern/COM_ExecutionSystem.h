@@ -119,9 +119,11 @@ namespace blender::compositor {
  */
 
 /* Forward declarations. */
+class BufferCache;
 class ExecutionGroup;
 class ExecutionModel;
 class NodeOperation;
+class Profiler;
 
 /**
  * \brief the ExecutionSystem contains the whole compositor tree.
@@ -177,7 +179,10 @@ class ExecutionSystem {
                   bool fastcalculation,
                   const ColorManagedViewSettings *view_settings,
                   const ColorManagedDisplaySettings *display_settings,
-                  const char *view_name);
+                  const char *view_name,
+                  BufferCache *buffer_cache = nullptr,
+                  const rctf *viewer_visible_area = nullptr,
+                  Profiler *profiler = nullptr);
 
   /**
    * Destructor
@@ -215,7 +220,7 @@ class ExecutionSystem {
 
   /**
    * Multi-threaded execution of given work function passing work_rect splits as argument.
-   * Once finished, caller thread will call reduce_func for each thread result.
+   * Once finished, caller thread will call reduce_func for each split result.
    */
   template<typename TResult>
   void execute_work(const rcti &work_rect,
@@ -223,7 +228,7 @@ class ExecutionSystem {
                     TResult &join,
                     std::function<void(TResult &join, const TResult &chunk)> reduce_func)
   {
-    Array<TResult> chunks(num_work_threads_);
+    Array<TResult> chunks(num_work_threads_ * COM_NUM_SUB_WORKS_PER_THREAD);
     int num_started = 0;
     execute_work(work_rect, [&](const rcti &split_rect) {
       const int current = atomic_fetch_and_add_int32(&num_started, 1);
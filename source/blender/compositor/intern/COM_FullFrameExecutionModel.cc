@@ -20,10 +20,19 @@
 
 #include "BLT_translation.h"
 
+#include "COM_BufferCache.h"
+#include "COM_ConstantOperation.h"
 #include "COM_Debug.h"
+#include "COM_MultiThreadedOperation.h"
+#include "COM_Profiler.h"
 #include "COM_ViewerOperation.h"
 #include "COM_WorkScheduler.h"
 
+#include "BLI_profile.hh"
+#include "BLI_task.hh"
+
+#include "PIL_time.h"
+
 #ifdef WITH_CXX_GUARDEDALLOC
 #  include "MEM_guardedalloc.h"
 #endif
@@ -67,10 +76,42 @@ void FullFrameExecutionModel::determine_areas_to_render_and_reads()
       if (op->is_output_operation(is_rendering) && op->get_render_priority() == priority) {
         get_output_render_area(op, area);
         determine_areas_to_render(op, area);
+      }
+    }
+  }
+
+  /* Cached buffers keys depend on the areas to render, and reads on cached buffers. */
+  BufferCache *cache = context_.get_buffer_cache();
+  if (cache) {
+    cache->execution_started();
+    determine_cached_buffers(*cache);
+  }
+
+  for (eCompositorPriority priority : priorities_) {
+    for (NodeOperation *op : operations_) {
+      if (op->is_output_operation(is_rendering) && op->get_render_priority() == priority) {
         determine_reads(op);
       }
     }
   }
+
+  determine_streamed_operations();
+}
+
+MemoryBuffer *FullFrameExecutionModel::get_input_buffer(NodeOperation *op,
+                                                        const int input_idx,
+                                                        const int output_x,
+                                                        const int output_y)
+{
+  NodeOperation *input = op->get_input_operation(input_idx);
+  const int offset_x = (input->get_canvas().xmin - op->get_canvas().xmin) + output_x;
+  const int offset_y = (input->get_canvas().ymin - op->get_canvas().ymin) + output_y;
+  MemoryBuffer *buf = active_buffers_.get_rendered_buffer(input);
+
+  rcti rect = buf->get_rect();
+  BLI_rcti_translate(&rect, offset_x, offset_y);
+  return new MemoryBuffer(
+      buf->get_buffer(), buf->get_num_channels(), rect, buf->is_a_single_elem());
 }
 
 Vector<MemoryBuffer *> FullFrameExecutionModel::get_input_buffers(NodeOperation *op,
@@ -80,15 +121,7 @@ Vector<MemoryBuffer *> FullFrameExecutionModel::get_input_buffers(NodeOperation
   const int num_inputs = op->get_number_of_input_sockets();
   Vector<MemoryBuffer *> inputs_buffers(num_inputs);
   for (int i = 0; i < num_inputs; i++) {
-    NodeOperation *input = op->get_input_operation(i);
-    const int offset_x = (input->get_canvas().xmin - op->get_canvas().xmin) + output_x;
-    const int offset_y = (input->get_canvas().ymin - op->get_canvas().ymin) + output_y;
-    MemoryBuffer *buf = active_buffers_.get_rendered_buffer(input);
-
-    rcti rect = buf->get_rect();
-    BLI_rcti_translate(&rect, offset_x, offset_y);
-    inputs_buffers[i] = new MemoryBuffer(
-        buf->get_buffer(), buf->get_num_channels(), rect, buf->is_a_single_elem());
+    inputs_buffers[i] = get_input_buffer(op, i, output_x, output_y);
   }
   return inputs_buffers;
 }
@@ -106,29 +139,174 @@ MemoryBuffer *FullFrameExecutionModel::create_operation_buffer(NodeOperation *op
   return new MemoryBuffer(data_type, rect, is_a_single_elem);
 }
 
+/**
+ * Returns a buffer that uses given buffer memory without owning it.
+ */
+static std::unique_ptr<MemoryBuffer> create_buffer_view(MemoryBuffer &buf)
+{
+  return std::make_unique<MemoryBuffer>(
+      buf.get_buffer(), buf.get_num_channels(), buf.get_rect(), buf.is_a_single_elem());
+}
+
+/**
+ * Returns the inputs of given operation that are streamed, from inputs to outputs.
+ */
+static void get_streamed_inputs(NodeOperation *op,
+                                const Set<NodeOperation *> &streamed_operations,
+                                Vector<NodeOperation *> &r_streamed_inputs)
+{
+  for (int i = 0; i < op->get_number_of_input_sockets(); i++) {
+    NodeOperation *input_op = op->get_input_operation(i);
+    if (streamed_operations.contains(input_op)) {
+      get_streamed_inputs(input_op, streamed_operations, r_streamed_inputs);
+      r_streamed_inputs.append(input_op);
+    }
+  }
+}
+
+void FullFrameExecutionModel::render_streamed_operation(NodeOperation *op,
+                                                        MemoryBuffer *op_buf,
+                                                        Span<NodeOperation *> streamed_inputs)
+{
+  Vector<NodeOperation *> chain(streamed_inputs);
+  chain.append(op);
+
+  /* Inputs that are not streamed are rendered buffers shared by all bands. For streamed inputs,
+   * index of the input operation in the chain. */
+  Vector<Vector<MemoryBuffer *>> chain_input_bufs(chain.size());
+  Vector<Vector<int>> chain_input_indices(chain.size());
+  for (const int op_idx : chain.index_range()) {
+    NodeOperation *chain_op = chain[op_idx];
+    for (int i = 0; i < chain_op->get_number_of_input_sockets(); i++) {
+      const int input_idx = chain.first_index_of_try(chain_op->get_input_operation(i));
+      chain_input_indices[op_idx].append(input_idx);
+      chain_input_bufs[op_idx].append(input_idx == -1 ? get_input_buffer(chain_op, i, 0, 0) :
+                                                        nullptr);
+    }
+    chain_op->init_execution();
+  }
+
+  /* Streamed operations have the same canvas as their reader, all bands have the same
+   * coordinates. */
+  const int op_offset_x = -op->get_canvas().xmin;
+  const int op_offset_y = -op->get_canvas().ymin;
+  const Vector<rcti> areas = active_buffers_.get_areas_to_render(op, op_offset_x, op_offset_y);
+  for (const rcti &area : areas) {
+    const int band_height = MAX2(COM_STREAM_BAND_NUM_PIXELS / MAX2(BLI_rcti_size_x(&area), 1), 1);
+    const int num_bands = divide_ceil_u(BLI_rcti_size_y(&area), band_height);
+    threading::parallel_for(IndexRange(num_bands), 1, [&](const IndexRange bands) {
+      /* Results of streamed operations, their memory is reused for all bands of the task. */
+      rcti band_rect;
+      BLI_rcti_init(&band_rect, area.xmin, area.xmax, 0, band_height);
+      Vector<std::unique_ptr<MemoryBuffer>> band_bufs;
+      for (NodeOperation *input_op : streamed_inputs) {
+        band_bufs.append(std::make_unique<MemoryBuffer>(
+            input_op->get_output_socket(0)->get_data_type(), band_rect));
+      }
+      Vector<Vector<MemoryBuffer *>> input_bufs(chain_input_bufs);
+
+      for (const int band_idx : bands) {
+        rcti band;
+        const int band_y = area.ymin + band_idx * band_height;
+        BLI_rcti_init(&band, area.xmin, area.xmax, band_y, MIN2(band_y + band_height, area.ymax));
+
+        /* Each band goes through the whole chain while results are still in CPU caches. */
+        Vector<std::unique_ptr<MemoryBuffer>> band_views;
+        for (const int op_idx : chain.index_range()) {
+          for (const int i : chain_input_indices[op_idx].index_range()) {
+            const int input_idx = chain_input_indices[op_idx][i];
+            if (input_idx != -1) {
+              input_bufs[op_idx][i] = band_views[input_idx].get();
+            }
+          }
+
+          MemoryBuffer *output = op_buf;
+          if (op_idx < band_bufs.size()) {
+            MemoryBuffer &band_buf = *band_bufs[op_idx];
+            band_views.append(std::make_unique<MemoryBuffer>(
+                band_buf.get_buffer(), band_buf.get_num_channels(), band));
+            output = band_views.last().get();
+          }
+          static_cast<MultiThreadedOperation *>(chain[op_idx])
+              ->render_partial(output, band, input_bufs[op_idx]);
+        }
+      }
+    });
+  }
+
+  for (const int op_idx : chain.index_range()) {
+    chain[op_idx]->deinit_execution();
+    for (MemoryBuffer *buf : chain_input_bufs[op_idx]) {
+      delete buf;
+    }
+  }
+
+  /* Streamed operations have no buffer, report them as rendered for their inputs buffers to be
+   * freed. */
+  for (NodeOperation *input_op : streamed_inputs) {
+    active_buffers_.set_rendered_buffer(input_op, nullptr);
+  }
+  for (NodeOperation *input_op : streamed_inputs) {
+    operation_finished(input_op);
+  }
+}
+
 void FullFrameExecutionModel::render_operation(NodeOperation *op)
 {
+  if (streamed_operations_.contains(op)) {
+    /* Rendered in bands by its reader. */
+    return;
+  }
+
+  MemoryBuffer *cached_buf = cached_buffers_.lookup_default(op, nullptr);
+  if (cached_buf) {
+    /* Cache keeps the buffer during the execution. Inputs are not read, skip reporting them. */
+    active_buffers_.set_rendered_buffer(op, create_buffer_view(*cached_buf));
+    num_operations_finished_++;
+    update_progress_bar();
+    return;
+  }
+
   /* Output has no offset for easier image algorithms implementation on operations. */
   constexpr int output_x = 0;
   constexpr int output_y = 0;
 
   const bool has_outputs = op->get_number_of_output_sockets() > 0;
-  MemoryBuffer *op_buf = has_outputs ? create_operation_buffer(op, output_x, output_y) : nullptr;
+  std::unique_ptr<MemoryBuffer> op_buf(
+      has_outputs ? create_operation_buffer(op, output_x, output_y) : nullptr);
   if (op->get_width() > 0 && op->get_height() > 0) {
-    Vector<MemoryBuffer *> input_bufs = get_input_buffers(op, output_x, output_y);
-    const int op_offset_x = output_x - op->get_canvas().xmin;
-    const int op_offset_y = output_y - op->get_canvas().ymin;
-    Vector<rcti> areas = active_buffers_.get_areas_to_render(op, op_offset_x, op_offset_y);
-    op->render(op_buf, areas, input_bufs);
-    DebugInfo::operation_rendered(op, op_buf);
-
-    for (MemoryBuffer *buf : input_bufs) {
-      delete buf;
+    BLI_PROFILE_SCOPE_DETAIL("COM render operation", op->get_name().c_str());
+    const double start_time = PIL_check_seconds_timer();
+    Vector<NodeOperation *> streamed_inputs;
+    get_streamed_inputs(op, streamed_operations_, streamed_inputs);
+    if (streamed_inputs.is_empty()) {
+      Vector<MemoryBuffer *> input_bufs = get_input_buffers(op, output_x, output_y);
+      const int op_offset_x = output_x - op->get_canvas().xmin;
+      const int op_offset_y = output_y - op->get_canvas().ymin;
+      Vector<rcti> areas = active_buffers_.get_areas_to_render(op, op_offset_x, op_offset_y);
+      op->render(op_buf.get(), areas, input_bufs);
+
+      for (MemoryBuffer *buf : input_bufs) {
+        delete buf;
+      }
+    }
+    else {
+      render_streamed_operation(op, op_buf.get(), streamed_inputs);
+    }
+    DebugInfo::operation_rendered(op, op_buf.get());
+
+    const double execution_time = PIL_check_seconds_timer() - start_time;
+    Profiler *profiler = context_.get_profiler();
+    if (profiler) {
+      profiler->add_operation(*op, execution_time, op_buf ? op_buf->get_memory_size() : 0);
+    }
+    if (op_buf) {
+      cache_operation_buffer(op, op_buf, execution_time);
     }
   }
   /* Even if operation has no resolution set the empty buffer. It will be clipped with a
    * TranslateOperation from convert resolutions if linked to an operation with resolution. */
-  active_buffers_.set_rendered_buffer(op, std::unique_ptr<MemoryBuffer>(op_buf));
+  active_buffers_.set_rendered_buffer(op, std::move(op_buf));
 
   operation_finished(op);
 }
@@ -159,7 +337,8 @@ void FullFrameExecutionModel::render_operations()
  * Returns all dependencies from inputs to outputs. A dependency may be repeated when
  * several operations depend on it.
  */
-static Vector<NodeOperation *> get_operation_dependencies(NodeOperation *operation)
+static Vector<NodeOperation *> get_operation_dependencies(
+    NodeOperation *operation, const Map<NodeOperation *, MemoryBuffer *> &cached_buffers)
 {
   /* Get dependencies from outputs to inputs. */
   Vector<NodeOperation *> dependencies;
@@ -169,6 +348,10 @@ static Vector<NodeOperation *> get_operation_dependencies(NodeOperation *operati
     Vector<NodeOperation *> outputs(next_outputs);
     next_outputs.clear();
     for (NodeOperation *output : outputs) {
+      /* Cached operations don't need their inputs. */
+      if (cached_buffers.contains(output)) {
+        continue;
+      }
       for (int i = 0; i < output->get_number_of_input_sockets(); i++) {
         next_outputs.append(output->get_input_operation(i));
       }
@@ -185,7 +368,7 @@ static Vector<NodeOperation *> get_operation_dependencies(NodeOperation *operati
 void FullFrameExecutionModel::render_output_dependencies(NodeOperation *output_op)
 {
   BLI_assert(output_op->is_output_operation(context_.is_rendering()));
-  Vector<NodeOperation *> dependencies = get_operation_dependencies(output_op);
+  Vector<NodeOperation *> dependencies = get_operation_dependencies(output_op, cached_buffers_);
   for (NodeOperation *op : dependencies) {
     if (!active_buffers_.is_operation_rendered(op)) {
       render_operation(op);
@@ -233,6 +416,9 @@ void FullFrameExecutionModel::determine_reads(NodeOperation *output_op)
   stack.append(output_op);
   while (stack.size() > 0) {
     NodeOperation *operation = stack.pop_last();
+    if (cached_buffers_.contains(operation)) {
+      continue;
+    }
     const int num_inputs = operation->get_number_of_input_sockets();
     for (int i = 0; i < num_inputs; i++) {
       NodeOperation *input_op = operation->get_input_operation(i);
@@ -244,6 +430,55 @@ void FullFrameExecutionModel::determine_reads(NodeOperation *output_op)
   }
 }
 
+/**
+ * Whether operation pixels only depend on the input pixels at the same coordinates, so that it
+ * can be rendered in bands from bands of its inputs.
+ */
+static bool is_streamable_operation(NodeOperation *op)
+{
+  const NodeOperationFlags flags = op->get_flags();
+  if (!flags.is_fullframe_operation || !flags.can_be_constant || flags.is_constant_operation ||
+      op->get_number_of_output_sockets() != 1 || op->get_width() == 0 ||
+      op->get_height() == 0 || dynamic_cast<MultiThreadedOperation *>(op) == nullptr) {
+    return false;
+  }
+
+  /* Some operations that can be constant still read whole inputs. */
+  const rcti &canvas = op->get_canvas();
+  rcti band = canvas;
+  band.ymax = canvas.ymin + MAX2(op->get_height() / 2, 1);
+  for (int i = 0; i < op->get_number_of_input_sockets(); i++) {
+    rcti input_area;
+    op->get_area_of_interest(i, band, input_area);
+    if (!BLI_rcti_compare(&input_area, &band)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void FullFrameExecutionModel::determine_streamed_operations()
+{
+  streamed_operations_.clear();
+  for (NodeOperation *op : operations_) {
+    /* Only operations that are rendered read their inputs. */
+    if (!active_buffers_.has_registered_reads(op) || cached_buffers_.contains(op) ||
+        !is_streamable_operation(op)) {
+      continue;
+    }
+
+    for (int i = 0; i < op->get_number_of_input_sockets(); i++) {
+      NodeOperation *input_op = op->get_input_operation(i);
+      if (active_buffers_.get_num_registered_reads(input_op) == 1 &&
+          !cached_buffers_.contains(input_op) &&
+          BLI_rcti_compare(&input_op->get_canvas(), &op->get_canvas()) &&
+          is_streamable_operation(input_op)) {
+        streamed_operations_.add(input_op);
+      }
+    }
+  }
+}
+
 void FullFrameExecutionModel::get_output_render_area(NodeOperation *output_op, rcti &r_area)
 {
   BLI_assert(output_op->is_output_operation(context_.is_rendering()));
@@ -268,6 +503,19 @@ void FullFrameExecutionModel::get_output_render_area(NodeOperation *output_op, r
     r_area.ymin = canvas.ymin + norm_border->ymin * h;
     r_area.ymax = canvas.ymin + norm_border->ymax * h;
   }
+
+  /* Viewer pixels that are not displayed are computed once they are. */
+  const rctf *visible_area = context_.get_viewer_visible_area();
+  if (visible_area && output_op->get_flags().is_viewer_operation) {
+    const int w = output_op->get_width();
+    const int h = output_op->get_height();
+    rcti visible_rect;
+    visible_rect.xmin = canvas.xmin + floorf(visible_area->xmin * w);
+    visible_rect.xmax = canvas.xmin + ceilf(visible_area->xmax * w);
+    visible_rect.ymin = canvas.ymin + floorf(visible_area->ymin * h);
+    visible_rect.ymax = canvas.ymin + ceilf(visible_area->ymax * h);
+    BLI_rcti_isect(&r_area, &visible_rect, &r_area);
+  }
 }
 
 void FullFrameExecutionModel::operation_finished(NodeOperation *operation)
@@ -282,6 +530,107 @@ void FullFrameExecutionModel::operation_finished(NodeOperation *operation)
   update_progress_bar();
 }
 
+/**
+ * Returns a key that identifies a constant operation result by its value.
+ */
+static size_t get_constant_cache_key(ConstantOperation &op)
+{
+  const DataType data_type = op.get_output_socket()->get_data_type();
+  const rcti &canvas = op.get_canvas();
+  size_t key = get_default_hash_3(data_type, canvas.xmin, canvas.xmax);
+  key = BLI_ghashutil_combine_hash(key, get_default_hash_2(canvas.ymin, canvas.ymax));
+
+  const float *elem = op.get_constant_elem();
+  for (const int i : IndexRange(COM_data_type_num_channels(data_type))) {
+    key = BLI_ghashutil_combine_hash(key, get_default_hash(elem[i]));
+  }
+  return key;
+}
+
+std::optional<size_t> FullFrameExecutionModel::get_cache_key(NodeOperation *op)
+{
+  const std::optional<size_t> *existing_key = cache_keys_.lookup_ptr(op);
+  if (existing_key) {
+    return *existing_key;
+  }
+
+  std::optional<size_t> key;
+  if (op->get_number_of_output_sockets() == 0) {
+    /* Output operations have no buffer to cache. */
+  }
+  else if (op->get_flags().is_constant_operation) {
+    key = get_constant_cache_key(*static_cast<ConstantOperation *>(op));
+  }
+  else if (std::optional<NodeOperationHash> hash = op->generate_hash()) {
+    key = hash->get_params_hash();
+    for (int i = 0; key && i < op->get_number_of_input_sockets(); i++) {
+      const std::optional<size_t> input_key = get_cache_key(op->get_input_operation(i));
+      if (input_key) {
+        key = BLI_ghashutil_combine_hash(*key, *input_key);
+      }
+      else {
+        key = std::nullopt;
+      }
+    }
+  }
+
+  if (key) {
+    /* Some operations results depend on the execution settings. */
+    key = BLI_ghashutil_combine_hash(
+        *key, get_default_hash_2(context_.get_quality(), context_.is_fast_calculation()));
+  }
+
+  cache_keys_.add_new(op, key);
+  return key;
+}
+
+std::optional<size_t> FullFrameExecutionModel::get_buffer_cache_key(NodeOperation *op)
+{
+  std::optional<size_t> key = get_cache_key(op);
+  if (!key) {
+    return std::nullopt;
+  }
+
+  for (const rcti &area : active_buffers_.get_areas_to_render(op, 0, 0)) {
+    *key = BLI_ghashutil_combine_hash(*key, get_default_hash_2(area.xmin, area.xmax));
+    *key = BLI_ghashutil_combine_hash(*key, get_default_hash_2(area.ymin, area.ymax));
+  }
+  return key;
+}
+
+void FullFrameExecutionModel::determine_cached_buffers(BufferCache &cache)
+{
+  for (NodeOperation *op : operations_) {
+    const std::optional<size_t> key = get_buffer_cache_key(op);
+    MemoryBuffer *cached_buf = key ? cache.lookup(*key) : nullptr;
+    if (cached_buf) {
+      cached_buffers_.add_new(op, cached_buf);
+    }
+  }
+}
+
+void FullFrameExecutionModel::cache_operation_buffer(NodeOperation *op,
+                                                     std::unique_ptr<MemoryBuffer> &op_buf,
+                                                     const double render_time)
+{
+  BufferCache *cache = context_.get_buffer_cache();
+  if (cache == nullptr || render_time < COM_BUFFER_CACHE_MIN_RENDER_TIME) {
+    return;
+  }
+
+  /* A cancelled operation may have stopped rendering before finishing. */
+  const bNodeTree *node_tree = context_.get_bnodetree();
+  if (node_tree->test_break(node_tree->tbh)) {
+    return;
+  }
+
+  const std::optional<size_t> key = get_buffer_cache_key(op);
+  MemoryBuffer *buf = op_buf.get();
+  if (key && cache->add(*key, op_buf)) {
+    op_buf = create_buffer_view(*buf);
+  }
+}
+
 void FullFrameExecutionModel::update_progress_bar()
 {
   const bNodeTree *tree = context_.get_bnodetree();
@@ -18,6 +18,10 @@
 
 #pragma once
 
+#include <optional>
+
+#include "BLI_map.hh"
+#include "BLI_set.hh"
 #include "BLI_vector.hh"
 
 #include "COM_Enums.h"
@@ -30,6 +34,7 @@
 namespace blender::compositor {
 
 /* Forward declarations. */
+class BufferCache;
 class CompositorContext;
 class ExecutionSystem;
 class MemoryBuffer;
@@ -57,6 +62,23 @@ class FullFrameExecutionModel : public ExecutionModel {
    */
   Vector<eCompositorPriority> priorities_;
 
+  /**
+   * Keys identifying operations results between executions, see #get_cache_key.
+   */
+  Map<NodeOperation *, std::optional<size_t>> cache_keys_;
+
+  /**
+   * Buffers from previous executions of operations that don't need to be rendered. Their inputs
+   * are not rendered either unless other operations need them.
+   */
+  Map<NodeOperation *, MemoryBuffer *> cached_buffers_;
+
+  /**
+   * Per pixel operations which only output is read by another per pixel operation. They are
+   * rendered in bands together with their reader, without allocating their whole buffer.
+   */
+  Set<NodeOperation *> streamed_operations_;
+
  public:
   FullFrameExecutionModel(CompositorContext &context,
                           SharedOperationBuffers &shared_buffers,
@@ -76,14 +98,44 @@ class FullFrameExecutionModel : public ExecutionModel {
    * Returned memory buffers must be deleted.
    */
   Vector<MemoryBuffer *> get_input_buffers(NodeOperation *op, int output_x, int output_y);
+  MemoryBuffer *get_input_buffer(NodeOperation *op, int input_idx, int output_x, int output_y);
   MemoryBuffer *create_operation_buffer(NodeOperation *op, int output_x, int output_y);
   void render_operation(NodeOperation *op);
+  /**
+   * Renders given operation in bands, rendering bands of its streamed inputs first.
+   */
+  void render_streamed_operation(NodeOperation *op,
+                                 MemoryBuffer *op_buf,
+                                 Span<NodeOperation *> streamed_inputs);
 
   void operation_finished(NodeOperation *operation);
 
+  /**
+   * Returns a key that identifies given operation result between executions, it takes into
+   * account the operation parameters and all its inputs keys. Returns `std::nullopt` when the
+   * result can't be identified: the operation or any of its inputs don't implement
+   * `hash_output_params`.
+   */
+  std::optional<size_t> get_cache_key(NodeOperation *op);
+  /**
+   * Returns a key that identifies given operation buffer between executions, taking into account
+   * the areas it renders.
+   */
+  std::optional<size_t> get_buffer_cache_key(NodeOperation *op);
+  /**
+   * Looks up buffers of operations rendered by previous executions.
+   */
+  void determine_cached_buffers(BufferCache &cache);
+  /**
+   * Keeps given operation rendered buffer for next executions when it was slow to render.
+   */
+  void cache_operation_buffer(NodeOperation *op,
+                              std::unique_ptr<MemoryBuffer> &op_buf,
+                              double render_time);
+
   /**
    * Calculates given output operation area to be rendered taking into account viewer and render
-   * borders.
+   * borders, and the displayed area of viewers.
    */
   void get_output_render_area(NodeOperation *output_op, rcti &r_area);
   /**
@@ -95,6 +147,10 @@ class FullFrameExecutionModel : public ExecutionModel {
    * operations each operation has).
    */
   void determine_reads(NodeOperation *output_op);
+  /**
+   * Determines operations rendered in bands together with their reader.
+   */
+  void determine_streamed_operations();
 
   void update_progress_bar();
 
@@ -335,6 +335,14 @@ class MemoryBuffer {
     return is_a_single_elem() ? 1 : get_height();
   }
 
+  /**
+   * Get the size in bytes of the elements in memory.
+   */
+  size_t get_memory_size() const
+  {
+    return sizeof(float) * num_channels_ * get_memory_width() * get_memory_height();
+  }
+
   uint8_t get_num_channels() const
   {
     return num_channels_;
@@ -61,6 +61,17 @@ class MultiThreadedOperation : public NodeOperation {
   {
   }
 
+ public:
+  /**
+   * Renders given area on the calling thread. Used to render chains of per pixel operations band
+   * by band, which requires operations to not implement `update_memory_buffer_started` nor
+   * `update_memory_buffer_finished`.
+   */
+  void render_partial(MemoryBuffer *output, const rcti &area, Span<MemoryBuffer *> inputs)
+  {
+    update_memory_buffer_partial(output, area, inputs);
+  }
+
  private:
   void update_memory_buffer(MemoryBuffer *output,
                             const rcti &area,
@@ -289,6 +289,15 @@ struct NodeOperationHash {
     return operation_;
   }
 
+  /**
+   * Hash of the operation type and parameters, leaving out its inputs. Unlike the inputs hash,
+   * it doesn't depend on operations ids so it's comparable between executions.
+   */
+  size_t get_params_hash() const
+  {
+    return BLI_ghashutil_combine_hash(type_hash_, params_hash_);
+  }
+
   bool operator==(const NodeOperationHash &other) const
   {
     return type_hash_ == other.type_hash_ && parents_hash_ == other.parents_hash_ &&
@@ -319,6 +328,8 @@ class NodeOperation {
  private:
   int id_;
   std::string name_;
+  /** Instance key of the node the operation was created for, see #Profiler. */
+  bNodeInstanceKey node_instance_key_;
   Vector<NodeOperationInput> inputs_;
   Vector<NodeOperationOutput> outputs_;
 
@@ -378,6 +389,16 @@ class NodeOperation {
     return name_;
   }
 
+  void set_node_instance_key(const bNodeInstanceKey node_instance_key)
+  {
+    node_instance_key_ = node_instance_key;
+  }
+
+  bNodeInstanceKey get_node_instance_key() const
+  {
+    return node_instance_key_;
+  }
+
   void set_id(const int id)
   {
     id_ = id;
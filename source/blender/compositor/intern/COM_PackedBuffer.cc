@@ -0,0 +1,136 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Copyright 2021, Blender Foundation.
+ */
+
+#include <cmath>
+#include <cstring>
+
+#include "COM_MemoryBuffer.h"
+#include "COM_PackedBuffer.h"
+
+namespace blender::compositor {
+
+static float unpack_byte(const uint8_t byte)
+{
+  return byte * (1.0f / 255.0f);
+}
+
+static bool pack_byte(const float value, uint8_t &r_byte)
+{
+  /* Negative zero would be unpacked as positive. */
+  if (!(value >= 0.0f && value <= 1.0f) || std::signbit(value)) {
+    return false;
+  }
+  r_byte = (uint8_t)(value * 255.0f + 0.5f);
+  return unpack_byte(r_byte) == value;
+}
+
+/**
+ * Only zero and normal half floats are packed, which is enough for the values of masks and IDs.
+ */
+static bool pack_half(const float value, uint16_t &r_half)
+{
+  uint32_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  const uint16_t sign = (bits >> 16) & 0x8000;
+  if ((bits & 0x7fffffff) == 0) {
+    r_half = sign;
+    return true;
+  }
+
+  const int exponent = (int)((bits >> 23) & 0xff) - 127 + 15;
+  const uint32_t mantissa = bits & 0x7fffff;
+  if (exponent <= 0 || exponent >= 31 || (mantissa & 0x1fff) != 0) {
+    return false;
+  }
+  r_half = sign | (uint16_t)(exponent << 10) | (uint16_t)(mantissa >> 13);
+  return true;
+}
+
+static float unpack_half(const uint16_t half)
+{
+  const uint32_t sign = (uint32_t)(half & 0x8000) << 16;
+  const uint32_t exponent = (half >> 10) & 0x1f;
+  const uint32_t bits = exponent == 0 ?
+                            sign :
+                            sign | ((exponent - 15 + 127) << 23) | ((uint32_t)(half & 0x3ff) << 13);
+  float value;
+  memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+PackedBuffer::PackedBuffer(const Type type, const int num_channels, const rcti &rect)
+    : type_(type), num_channels_(num_channels), rect_(rect)
+{
+}
+
+std::unique_ptr<PackedBuffer> PackedBuffer::pack(MemoryBuffer &buffer)
+{
+  if (buffer.is_a_single_elem()) {
+    return nullptr;
+  }
+
+  const float *values = buffer.get_buffer();
+  const int64_t num_values = (int64_t)buffer.get_num_channels() * buffer.get_memory_width() *
+                             buffer.get_memory_height();
+
+  std::unique_ptr<PackedBuffer> packed(
+      new PackedBuffer(Type::Byte, buffer.get_num_channels(), buffer.get_rect()));
+  Array<uint8_t> bytes(num_values, NoInitialization());
+  int64_t i = 0;
+  while (i < num_values && pack_byte(values[i], bytes[i])) {
+    i++;
+  }
+  if (i == num_values) {
+    packed->bytes_ = std::move(bytes);
+    return packed;
+  }
+
+  packed->type_ = Type::Half;
+  Array<uint16_t> halfs(num_values, NoInitialization());
+  i = 0;
+  while (i < num_values && pack_half(values[i], halfs[i])) {
+    i++;
+  }
+  if (i == num_values) {
+    packed->halfs_ = std::move(halfs);
+    return packed;
+  }
+  return nullptr;
+}
+
+std::unique_ptr<MemoryBuffer> PackedBuffer::unpack() const
+{
+  std::unique_ptr<MemoryBuffer> buffer = std::make_unique<MemoryBuffer>(
+      COM_num_channels_data_type(num_channels_), rect_);
+  float *values = buffer->get_buffer();
+  switch (type_) {
+    case Type::Byte:
+      for (const int64_t i : bytes_.index_range()) {
+        values[i] = unpack_byte(bytes_[i]);
+      }
+      break;
+    case Type::Half:
+      for (const int64_t i : halfs_.index_range()) {
+        values[i] = unpack_half(halfs_[i]);
+      }
+      break;
+  }
+  return buffer;
+}
+
+}  // namespace blender::compositor
@@ -0,0 +1,92 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Copyright 2021, Blender Foundation.
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "BLI_array.hh"
+#include "BLI_rect.h"
+
+#ifdef WITH_CXX_GUARDEDALLOC
+#  include "MEM_guardedalloc.h"
+#endif
+
+namespace blender::compositor {
+
+class MemoryBuffer;
+
+/**
+ * Stores the elements of a #MemoryBuffer in a smaller type than float, when all of them can be
+ * restored exactly. Masks, mattes and IDs are usually made of values which take 8 bits or half
+ * floats, using a quarter or half of the memory. Operations only work with floats, elements are
+ * converted back when unpacking.
+ */
+class PackedBuffer {
+ public:
+  enum class Type {
+    /** Values in [0, 1] range with 8-bit precision. */
+    Byte,
+    /** Half floats. */
+    Half,
+  };
+
+ private:
+  Type type_;
+  int num_channels_;
+  rcti rect_;
+  /** Elements of Byte buffers. */
+  Array<uint8_t> bytes_;
+  /** Elements of Half buffers. */
+  Array<uint16_t> halfs_;
+
+  PackedBuffer(Type type, int num_channels, const rcti &rect);
+
+ public:
+  /**
+   * Packs the elements of given buffer in the smallest type they can be restored from exactly,
+   * nullptr when none of them can.
+   */
+  static std::unique_ptr<PackedBuffer> pack(MemoryBuffer &buffer);
+
+  /**
+   * Creates a float buffer with the same elements as the packed one.
+   */
+  std::unique_ptr<MemoryBuffer> unpack() const;
+
+  Type get_type() const
+  {
+    return type_;
+  }
+
+  size_t get_memory_size() const
+  {
+    return sizeof(uint8_t) * bytes_.size() + sizeof(uint16_t) * halfs_.size();
+  }
+
+  size_t get_unpacked_memory_size() const
+  {
+    return sizeof(float) * (bytes_.size() + halfs_.size());
+  }
+
+#ifdef WITH_CXX_GUARDEDALLOC
+  MEM_CXX_CLASS_ALLOC_FUNCS("COM:PackedBuffer")
+#endif
+};
+
+}  // namespace blender::compositor
@@ -0,0 +1,51 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Copyright 2021, Blender Foundation.
+ */
+
+#include "BKE_node.h"
+
+#include "COM_NodeOperation.h"
+#include "COM_Profiler.h"
+
+namespace blender::compositor {
+
+void Profiler::add_operation(const NodeOperation &operation,
+                             const double execution_time,
+                             const size_t allocated_bytes)
+{
+  const bNodeInstanceKey node_key = operation.get_node_instance_key();
+  if (node_key.value == NODE_INSTANCE_KEY_NONE.value) {
+    /* Operation added by the compositor itself, like conversions. */
+    return;
+  }
+
+  NodeProfile &profile = node_profiles_.lookup_or_add_default(node_key.value);
+  profile.execution_time += execution_time;
+  profile.allocated_bytes += allocated_bytes;
+}
+
+const NodeProfile *Profiler::lookup(const bNodeInstanceKey node_key) const
+{
+  return node_profiles_.lookup_ptr(node_key.value);
+}
+
+void Profiler::clear()
+{
+  node_profiles_.clear();
+}
+
+}  // namespace blender::compositor
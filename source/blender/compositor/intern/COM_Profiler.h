@@ -0,0 +1,77 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Copyright 2021, Blender Foundation.
+ */
+
+#pragma once
+
+#include "BLI_map.hh"
+
+#include "DNA_node_types.h"
+
+#ifdef WITH_CXX_GUARDEDALLOC
+#  include "MEM_guardedalloc.h"
+#endif
+
+namespace blender::compositor {
+
+class NodeOperation;
+
+/**
+ * Execution time and memory of all operations created for a node.
+ */
+struct NodeProfile {
+  /** Time spent rendering the operations, in seconds. */
+  double execution_time = 0.0;
+  /** Size of the buffers allocated for the operations results. */
+  size_t allocated_bytes = 0;
+};
+
+/**
+ * Records the execution time and memory of operations rendered by #FullFrameExecutionModel,
+ * gathered by the node the operations were created for so that they can be displayed in the node
+ * editor. Operations rendered by their readers, as part of a chain of per pixel operations, are
+ * accounted in the execution time of the reader.
+ *
+ * It's not thread safe, operations must be recorded from the thread which renders them.
+ *
+ * There is no file output of its own: a timeline of the rendered operations is recorded by the
+ * profiling markers of `BLI_profile.h`, which are written with the shared Chrome trace writer.
+ */
+class Profiler {
+ private:
+  /** Profiles of nodes indexed by their instance key value. */
+  Map<unsigned int, NodeProfile> node_profiles_;
+
+ public:
+  void add_operation(const NodeOperation &operation,
+                     double execution_time,
+                     size_t allocated_bytes);
+
+  /**
+   * Get the profile of the node with given instance key, nullptr when none of its operations
+   * were rendered.
+   */
+  const NodeProfile *lookup(bNodeInstanceKey node_key) const;
+
+  void clear();
+
+#ifdef WITH_CXX_GUARDEDALLOC
+  MEM_CXX_CLASS_ALLOC_FUNCS("COM:Profiler")
+#endif
+};
+
+}  // namespace blender::compositor
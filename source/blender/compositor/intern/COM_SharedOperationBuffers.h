@@ -64,6 +64,11 @@ class SharedOperationBuffers {
    * given operation).
    */
   bool has_registered_reads(NodeOperation *op);
+
+  /**
+   * Number of registered reads of given operation, one per input linked to it.
+   */
+  int get_num_registered_reads(NodeOperation *op);
   /**
    * Registers an operation read (other operation depends on given operation).
    */
@@ -16,20 +16,31 @@
  * Copyright 2011, Blender Foundation.
  */
 
+#include <atomic>
+
 #include "BLI_threads.h"
 
 #include "BLT_translation.h"
 
+#include "BKE_global.h"
 #include "BKE_node.h"
 #include "BKE_scene.h"
 
+#include "COM_BufferCache.h"
 #include "COM_ExecutionSystem.h"
+#include "COM_Profiler.h"
 #include "COM_WorkScheduler.h"
 #include "COM_compositor.h"
 
 static struct {
   bool is_initialized = false;
   ThreadMutex mutex;
+  /* Operations buffers kept between executions when editing the node tree. */
+  blender::compositor::BufferCache *buffer_cache = nullptr;
+  std::atomic<bool> is_buffer_cache_outdated = false;
+  /* Profile of the latest execution, read by the node editor while compositing. */
+  blender::compositor::Profiler profiler;
+  ThreadMutex profiler_mutex = BLI_MUTEX_INITIALIZER;
 } g_compositor;
 
 /* Make sure node tree has previews.
@@ -66,7 +77,8 @@ void COM_execute(RenderData *render_data,
                  int rendering,
                  const ColorManagedViewSettings *view_settings,
                  const ColorManagedDisplaySettings *display_settings,
-                 const char *view_name)
+                 const char *view_name,
+                 const rctf *viewer_visible_area)
 {
   /* Initialize mutex, TODO: this mutex init is actually not thread safe and
    * should be done somewhere as part of blender startup, all the other
@@ -88,6 +100,18 @@ void COM_execute(RenderData *render_data,
   compositor_init_node_previews(render_data, node_tree);
   compositor_reset_node_tree_status(node_tree);
 
+  /* Buffers are only kept while editing. Render results are written while rendering, making
+   * cached buffers out of date. */
+  if (g_compositor.buffer_cache == nullptr) {
+    g_compositor.buffer_cache = new blender::compositor::BufferCache();
+  }
+  const bool use_buffer_cache = !rendering && !G.is_rendering;
+  if (!use_buffer_cache || g_compositor.is_buffer_cache_outdated.exchange(false)) {
+    g_compositor.buffer_cache->clear();
+  }
+  blender::compositor::BufferCache *buffer_cache = use_buffer_cache ? g_compositor.buffer_cache :
+                                                                      nullptr;
+
   /* Initialize workscheduler. */
   const bool use_opencl = (node_tree->flag & NTREE_COM_OPENCL) != 0;
   blender::compositor::WorkScheduler::initialize(use_opencl, BKE_render_num_threads(render_data));
@@ -102,7 +126,9 @@ void COM_execute(RenderData *render_data,
                                                    true,
                                                    view_settings,
                                                    display_settings,
-                                                   view_name);
+                                                   view_name,
+                                                   buffer_cache,
+                                                   viewer_visible_area);
     fast_pass.execute();
 
     if (node_tree->test_break(node_tree->tbh)) {
@@ -111,20 +137,62 @@ void COM_execute(RenderData *render_data,
     }
   }
 
-  blender::compositor::ExecutionSystem system(
-      render_data, scene, node_tree, rendering, false, view_settings, display_settings, view_name);
+  /* Profile only the full quality pass, kept when the execution is not cancelled. */
+  blender::compositor::Profiler profiler;
+  blender::compositor::ExecutionSystem system(render_data,
+                                              scene,
+                                              node_tree,
+                                              rendering,
+                                              false,
+                                              view_settings,
+                                              display_settings,
+                                              view_name,
+                                              buffer_cache,
+                                              viewer_visible_area,
+                                              &profiler);
   system.execute();
 
+  if (!node_tree->test_break(node_tree->tbh)) {
+    BLI_mutex_lock(&g_compositor.profiler_mutex);
+    g_compositor.profiler = std::move(profiler);
+    BLI_mutex_unlock(&g_compositor.profiler_mutex);
+  }
+
   BLI_mutex_unlock(&g_compositor.mutex);
 }
 
+void COM_clear_caches()
+{
+  /* Caches may be in use by an execution, they are cleared by the next one. */
+  g_compositor.is_buffer_cache_outdated = true;
+}
+
 void COM_deinitialize()
 {
   if (g_compositor.is_initialized) {
     BLI_mutex_lock(&g_compositor.mutex);
     blender::compositor::WorkScheduler::deinitialize();
+    delete g_compositor.buffer_cache;
+    g_compositor.buffer_cache = nullptr;
+    BLI_mutex_lock(&g_compositor.profiler_mutex);
+    g_compositor.profiler.clear();
+    BLI_mutex_unlock(&g_compositor.profiler_mutex);
     g_compositor.is_initialized = false;
     BLI_mutex_unlock(&g_compositor.mutex);
     BLI_mutex_end(&g_compositor.mutex);
   }
 }
+
+bool COM_get_node_profile(const bNodeInstanceKey node_key,
+                          double *r_execution_time,
+                          size_t *r_allocated_bytes)
+{
+  BLI_mutex_lock(&g_compositor.profiler_mutex);
+  const blender::compositor::NodeProfile *profile = g_compositor.profiler.lookup(node_key);
+  if (profile) {
+    *r_execution_time = profile->execution_time;
+    *r_allocated_bytes = profile->allocated_bytes;
+  }
+  BLI_mutex_unlock(&g_compositor.profiler_mutex);
+  return profile != nullptr;
+}
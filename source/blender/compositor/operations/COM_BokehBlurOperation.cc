@@ -18,6 +18,7 @@
 
 #include "COM_BokehBlurOperation.h"
 #include "COM_ConstantOperation.h"
+#include "COM_FFTConvolution.h"
 
 #include "COM_OpenCLDevice.h"
 
@@ -27,6 +28,8 @@ constexpr int IMAGE_INPUT_INDEX = 0;
 constexpr int BOKEH_INPUT_INDEX = 1;
 constexpr int BOUNDING_BOX_INPUT_INDEX = 2;
 constexpr int SIZE_INPUT_INDEX = 3;
+/** Blur radius from which convolving using FFT is faster than summing neighbor pixels. */
+constexpr int FFT_MIN_PIXEL_SIZE = 16;
 
 BokehBlurOperation::BokehBlurOperation()
 {
@@ -321,12 +324,77 @@ void BokehBlurOperation::get_area_of_interest(const int input_idx,
   }
 }
 
+int BokehBlurOperation::get_pixel_size() const
+{
+  const float max_dim = MAX2(this->get_width(), this->get_height());
+  return size_ * max_dim / 100.0f;
+}
+
+bool BokehBlurOperation::use_fft_convolution(const int pixel_size) const
+{
+  /* Lower quality settings skip pixels, which a convolution does not. */
+  return FFTConvolution::is_supported() && get_step() == 1 && pixel_size >= FFT_MIN_PIXEL_SIZE;
+}
+
+std::unique_ptr<MemoryBuffer> BokehBlurOperation::create_fft_kernel(const MemoryBuffer &bokeh,
+                                                                    const int pixel_size) const
+{
+  /* Weights of neighbor pixels at `-pixel_size <= offset < pixel_size`, flipped as
+   * convolutions do. First row and column are zero as the offset of `pixel_size` is excluded. */
+  const int kernel_size = 2 * pixel_size + 1;
+  const float m = bokehDimension_ / pixel_size;
+  rcti kernel_rect;
+  BLI_rcti_init(&kernel_rect, 0, kernel_size, 0, kernel_size);
+  std::unique_ptr<MemoryBuffer> kernel = std::make_unique<MemoryBuffer>(DataType::Color,
+                                                                        kernel_rect);
+  for (BuffersIterator<float> it = kernel->iterate_with({}); !it.is_end(); ++it) {
+    if (it.x == 0 || it.y == 0) {
+      zero_v4(it.out);
+      continue;
+    }
+    const float u = bokeh_mid_x_ - (pixel_size - it.x) * m;
+    const float v = bokeh_mid_y_ - (pixel_size - it.y) * m;
+    bokeh.read_elem_checked(u, v, it.out);
+  }
+  return kernel;
+}
+
+void BokehBlurOperation::update_memory_buffer_started(MemoryBuffer *output,
+                                                      const rcti &area,
+                                                      Span<MemoryBuffer *> inputs)
+{
+  const int pixel_size = get_pixel_size();
+  if (!use_fft_convolution(pixel_size)) {
+    return;
+  }
+
+  /* Convolve the image into the output and the weights of image pixels into a separate buffer,
+   * so that partial updates only have to normalize the colors. */
+  const MemoryBuffer *image_input = inputs[IMAGE_INPUT_INDEX];
+  std::unique_ptr<MemoryBuffer> kernel = create_fft_kernel(*inputs[BOKEH_INPUT_INDEX],
+                                                           pixel_size);
+  const FFTConvolution convolution(
+      *kernel, COM_DATA_TYPE_COLOR_CHANNELS, BLI_rcti_size_x(&area), BLI_rcti_size_y(&area));
+  convolution.convolve(*image_input, area, *output);
+
+  float one[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+  const MemoryBuffer image_mask(one, COM_DATA_TYPE_COLOR_CHANNELS, image_input->get_rect(), true);
+  fft_weights_ = std::make_unique<MemoryBuffer>(DataType::Color, area);
+  convolution.convolve(image_mask, area, *fft_weights_);
+}
+
+void BokehBlurOperation::update_memory_buffer_finished(MemoryBuffer *UNUSED(output),
+                                                       const rcti &UNUSED(area),
+                                                       Span<MemoryBuffer *> UNUSED(inputs))
+{
+  fft_weights_.reset();
+}
+
 void BokehBlurOperation::update_memory_buffer_partial(MemoryBuffer *output,
                                                       const rcti &area,
                                                       Span<MemoryBuffer *> inputs)
 {
-  const float max_dim = MAX2(this->get_width(), this->get_height());
-  const int pixel_size = size_ * max_dim / 100.0f;
+  const int pixel_size = get_pixel_size();
   const float m = bokehDimension_ / pixel_size;
 
   const MemoryBuffer *image_input = inputs[IMAGE_INPUT_INDEX];
@@ -343,6 +411,16 @@ void BokehBlurOperation::update_memory_buffer_partial(MemoryBuffer *output,
       continue;
     }
 
+    if (fft_weights_) {
+      /* Output already has the convolved colors. */
+      const float *weights = fft_weights_->get_elem(x, y);
+      it.out[0] = it.out[0] * (1.0f / weights[0]);
+      it.out[1] = it.out[1] * (1.0f / weights[1]);
+      it.out[2] = it.out[2] * (1.0f / weights[2]);
+      it.out[3] = it.out[3] * (1.0f / weights[3]);
+      continue;
+    }
+
     float color_accum[4] = {0};
     float multiplier_accum[4] = {0};
     if (pixel_size < 2) {
@@ -21,6 +21,8 @@
 #include "COM_MultiThreadedOperation.h"
 #include "COM_QualityStepHelper.h"
 
+#include <memory>
+
 namespace blender::compositor {
 
 class BokehBlurOperation : public MultiThreadedOperation, public QualityStepHelper {
@@ -37,6 +39,14 @@ class BokehBlurOperation : public MultiThreadedOperation, public QualityStepHelp
   float bokehDimension_;
   bool extend_bounds_;
 
+  /** Sum of the bokeh weights of image pixels around each pixel, when convolving using FFT. */
+  std::unique_ptr<MemoryBuffer> fft_weights_;
+
+  int get_pixel_size() const;
+  bool use_fft_convolution(int pixel_size) const;
+  std::unique_ptr<MemoryBuffer> create_fft_kernel(const MemoryBuffer &bokeh,
+                                                  int pixel_size) const;
+
  public:
   BokehBlurOperation();
 
@@ -83,9 +93,15 @@ class BokehBlurOperation : public MultiThreadedOperation, public QualityStepHelp
   void determine_canvas(const rcti &preferred_area, rcti &r_area) override;
 
   void get_area_of_interest(int input_idx, const rcti &output_area, rcti &r_input_area) override;
+  void update_memory_buffer_started(MemoryBuffer *output,
+                                    const rcti &area,
+                                    Span<MemoryBuffer *> inputs) override;
   void update_memory_buffer_partial(MemoryBuffer *output,
                                     const rcti &area,
                                     Span<MemoryBuffer *> inputs) override;
+  void update_memory_buffer_finished(MemoryBuffer *output,
+                                     const rcti &area,
+                                     Span<MemoryBuffer *> inputs) override;
 };
 
 }  // namespace blender::compositor
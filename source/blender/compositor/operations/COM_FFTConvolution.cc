@@ -0,0 +1,236 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Copyright 2021, Blender Foundation.
+ */
+
+#include "COM_FFTConvolution.h"
+#include "COM_MemoryBuffer.h"
+
+#include "BLI_math_base.h"
+#include "BLI_rect.h"
+#include "BLI_task.hh"
+#include "BLI_threads.h"
+
+#ifdef WITH_FFTW3
+#  include <fftw3.h>
+#endif
+
+namespace blender::compositor {
+
+bool FFTConvolution::is_supported()
+{
+#ifdef WITH_FFTW3
+  return true;
+#else
+  return false;
+#endif
+}
+
+#ifdef WITH_FFTW3
+
+static int next_pow2(const int x)
+{
+  int pw = 1;
+  while (pw < x) {
+    pw <<= 1;
+  }
+  return pw;
+}
+
+/**
+ * Returns transforms size along an axis. Blocks are at least as large as the kernel so that
+ * most of each transform is used, but not much larger than the area.
+ */
+static int get_fft_size(const int kernel_size, const int area_size)
+{
+  return next_pow2(MIN2(2 * kernel_size, area_size + kernel_size - 1));
+}
+
+FFTConvolution::FFTConvolution(const MemoryBuffer &kernel,
+                               const int num_channels,
+                               const int area_width,
+                               const int area_height)
+{
+  num_channels_ = MIN2(num_channels, kernel.get_num_channels());
+  kernel_width_ = kernel.get_width();
+  kernel_height_ = kernel.get_height();
+  fft_width_ = get_fft_size(kernel_width_, area_width);
+  fft_height_ = get_fft_size(kernel_height_, area_height);
+  block_width_ = fft_width_ - kernel_width_ + 1;
+  block_height_ = fft_height_ - kernel_height_ + 1;
+
+  const int fft_len = fft_width_ * fft_height_;
+  const int spectrum_len = fft_height_ * (fft_width_ / 2 + 1);
+  double *kernel_data = fftw_alloc_real(fft_len);
+  for (int c = 0; c < 4; c++) {
+    kernel_spectrums_[c] = c < num_channels_ ? (double *)fftw_alloc_complex(spectrum_len) :
+                                               nullptr;
+  }
+
+  /* Planning is not thread safe. Arrays are not overwritten when estimating. */
+  BLI_thread_lock(LOCK_FFTW);
+  forward_plan_ = fftw_plan_dft_r2c_2d(fft_height_,
+                                       fft_width_,
+                                       kernel_data,
+                                       (fftw_complex *)kernel_spectrums_[0],
+                                       FFTW_ESTIMATE);
+  inverse_plan_ = fftw_plan_dft_c2r_2d(fft_height_,
+                                       fft_width_,
+                                       (fftw_complex *)kernel_spectrums_[0],
+                                       kernel_data,
+                                       FFTW_ESTIMATE);
+  BLI_thread_unlock(LOCK_FFTW);
+
+  /* Transforms are not normalized, scale the kernel for the inverse transform. */
+  const double scale = 1.0 / fft_len;
+  const rcti &kernel_rect = kernel.get_rect();
+  for (int c = 0; c < num_channels_; c++) {
+    kernel_sums_[c] = 0.0f;
+    for (int i = 0; i < fft_len; i++) {
+      kernel_data[i] = 0.0;
+    }
+    for (int y = 0; y < kernel_height_; y++) {
+      for (int x = 0; x < kernel_width_; x++) {
+        const float value = kernel.get_elem(kernel_rect.xmin + x, kernel_rect.ymin + y)[c];
+        kernel_data[y * fft_width_ + x] = value * scale;
+        kernel_sums_[c] += value;
+      }
+    }
+    fftw_execute_dft_r2c(forward_plan_, kernel_data, (fftw_complex *)kernel_spectrums_[c]);
+  }
+
+  fftw_free(kernel_data);
+}
+
+FFTConvolution::~FFTConvolution()
+{
+  BLI_thread_lock(LOCK_FFTW);
+  fftw_destroy_plan(forward_plan_);
+  fftw_destroy_plan(inverse_plan_);
+  BLI_thread_unlock(LOCK_FFTW);
+
+  for (int c = 0; c < num_channels_; c++) {
+    fftw_free(kernel_spectrums_[c]);
+  }
+}
+
+void FFTConvolution::convolve(const MemoryBuffer &image,
+                              const rcti &area,
+                              MemoryBuffer &r_output) const
+{
+  const int num_blocks_x = divide_ceil_u(BLI_rcti_size_x(&area), block_width_);
+  const int num_blocks_y = divide_ceil_u(BLI_rcti_size_y(&area), block_height_);
+  const int fft_len = fft_width_ * fft_height_;
+  const int spectrum_len = fft_height_ * (fft_width_ / 2 + 1);
+  const rcti &image_rect = image.get_rect();
+
+  threading::parallel_for(
+      IndexRange(num_blocks_x * num_blocks_y), 1, [&](const IndexRange blocks) {
+        double *tile = fftw_alloc_real(fft_len);
+        fftw_complex *spectrum = fftw_alloc_complex(spectrum_len);
+
+        for (const int block : blocks) {
+          rcti block_rect;
+          block_rect.xmin = area.xmin + (block % num_blocks_x) * block_width_;
+          block_rect.ymin = area.ymin + (block / num_blocks_x) * block_height_;
+          block_rect.xmax = MIN2(block_rect.xmin + block_width_, area.xmax);
+          block_rect.ymax = MIN2(block_rect.ymin + block_height_, area.ymax);
+
+          /* Image pixels contributing to the block, in the circular convolution of the tile
+           * only the last block size values are not wrapped. */
+          rcti tile_rect;
+          tile_rect.xmin = block_rect.xmin + kernel_width_ / 2 - (kernel_width_ - 1);
+          tile_rect.ymin = block_rect.ymin + kernel_height_ / 2 - (kernel_height_ - 1);
+          tile_rect.xmax = tile_rect.xmin + BLI_rcti_size_x(&block_rect) + kernel_width_ - 1;
+          tile_rect.ymax = tile_rect.ymin + BLI_rcti_size_y(&block_rect) + kernel_height_ - 1;
+          const bool is_tile_in_image = BLI_rcti_inside_rcti(&image_rect, &tile_rect);
+          rcti tile_image_rect;
+          BLI_rcti_isect(&tile_rect, &image_rect, &tile_image_rect);
+
+          for (int c = 0; c < num_channels_; c++) {
+            if (image.is_a_single_elem() && is_tile_in_image) {
+              /* Constant image, result is the kernel sum. */
+              const float value = image.get_elem(image_rect.xmin, image_rect.ymin)[c] *
+                                  kernel_sums_[c];
+              for (int y = block_rect.ymin; y < block_rect.ymax; y++) {
+                for (int x = block_rect.xmin; x < block_rect.xmax; x++) {
+                  r_output.get_elem(x, y)[c] = value;
+                }
+              }
+              continue;
+            }
+
+            for (int i = 0; i < fft_len; i++) {
+              tile[i] = 0.0;
+            }
+            for (int y = tile_image_rect.ymin; y < tile_image_rect.ymax; y++) {
+              double *tile_row = tile + (y - tile_rect.ymin) * fft_width_ - tile_rect.xmin;
+              for (int x = tile_image_rect.xmin; x < tile_image_rect.xmax; x++) {
+                tile_row[x] = image.get_elem(x, y)[c];
+              }
+            }
+
+            fftw_execute_dft_r2c(forward_plan_, tile, spectrum);
+            const fftw_complex *kernel_spectrum = (const fftw_complex *)kernel_spectrums_[c];
+            for (int i = 0; i < spectrum_len; i++) {
+              const double re = spectrum[i][0] * kernel_spectrum[i][0] -
+                                spectrum[i][1] * kernel_spectrum[i][1];
+              const double im = spectrum[i][0] * kernel_spectrum[i][1] +
+                                spectrum[i][1] * kernel_spectrum[i][0];
+              spectrum[i][0] = re;
+              spectrum[i][1] = im;
+            }
+            fftw_execute_dft_c2r(inverse_plan_, spectrum, tile);
+
+            for (int y = block_rect.ymin; y < block_rect.ymax; y++) {
+              const double *tile_row = tile +
+                                       (y - block_rect.ymin + kernel_height_ - 1) * fft_width_ +
+                                       kernel_width_ - 1 - block_rect.xmin;
+              for (int x = block_rect.xmin; x < block_rect.xmax; x++) {
+                r_output.get_elem(x, y)[c] = tile_row[x];
+              }
+            }
+          }
+        }
+
+        fftw_free(spectrum);
+        fftw_free(tile);
+      });
+}
+
+#else
+
+FFTConvolution::FFTConvolution(const MemoryBuffer &UNUSED(kernel),
+                               const int UNUSED(num_channels),
+                               const int UNUSED(area_width),
+                               const int UNUSED(area_height))
+    : num_channels_(0), forward_plan_(nullptr), inverse_plan_(nullptr)
+{
+  BLI_assert_msg(0, "FFT convolution requires FFTW");
+}
+
+FFTConvolution::~FFTConvolution() = default;
+
+void FFTConvolution::convolve(const MemoryBuffer &UNUSED(image),
+                              const rcti &UNUSED(area),
+                              MemoryBuffer &UNUSED(r_output)) const
+{
+  BLI_assert_msg(0, "FFT convolution requires FFTW");
+}
+
+#endif
+
+}  // namespace blender::compositor
@@ -0,0 +1,90 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Copyright 2021, Blender Foundation.
+ */
+
+#pragma once
+
+#include "DNA_vec_types.h"
+
+#ifdef WITH_CXX_GUARDEDALLOC
+#  include "MEM_guardedalloc.h"
+#endif
+
+struct fftw_plan_s;
+
+namespace blender::compositor {
+
+class MemoryBuffer;
+
+/**
+ * Convolves images with a kernel using fast Fourier transforms, so that the cost per pixel grows
+ * with the logarithm of the kernel size instead of with its area. Used for large kernels, like
+ * fog glow or bokeh blurs.
+ *
+ * The area to convolve is split in blocks that are transformed in parallel using the
+ * overlap-save method, so memory usage depends on the kernel size and not on the image size.
+ * Pixels outside of the image are zero.
+ */
+class FFTConvolution {
+ private:
+  int num_channels_;
+  int kernel_width_;
+  int kernel_height_;
+  /** Size of the transforms. */
+  int fft_width_;
+  int fft_height_;
+  /** Size of the output blocks computed by each transform. */
+  int block_width_;
+  int block_height_;
+
+  /** Transformed kernel channels, already normalized for the inverse transforms. */
+  double *kernel_spectrums_[4];
+  /** Sum of kernel channels, to convolve constant images without transforms. */
+  float kernel_sums_[4];
+
+  fftw_plan_s *forward_plan_;
+  fftw_plan_s *inverse_plan_;
+
+ public:
+  /**
+   * Prepares the convolution of the first \a num_channels channels of images with the same
+   * channels of \a kernel, for areas up to the given size. The kernel center is at
+   * `(width / 2, height / 2)`.
+   */
+  FFTConvolution(const MemoryBuffer &kernel, int num_channels, int area_width, int area_height);
+  ~FFTConvolution();
+
+  FFTConvolution(const FFTConvolution &other) = delete;
+  FFTConvolution &operator=(const FFTConvolution &other) = delete;
+
+  /**
+   * Whether convolutions are supported by this build, it requires FFTW.
+   */
+  static bool is_supported();
+
+  /**
+   * Writes the convolution of \a image in given area of \a r_output. Only image pixels within
+   * the kernel extents around the area are read. Other channels of \a r_output are unchanged.
+   */
+  void convolve(const MemoryBuffer &image, const rcti &area, MemoryBuffer &r_output) const;
+
+#ifdef WITH_CXX_GUARDEDALLOC
+  MEM_CXX_CLASS_ALLOC_FUNCS("COM:FFTConvolution")
+#endif
+};
+
+}  // namespace blender::compositor
@@ -16,7 +16,8 @@
  * Copyright 2011, Blender Foundation.
  */
 
-#include <climits>
+#include "BLI_array.hh"
+#include "BLI_task.hh"
 
 #include "COM_FastGaussianBlurOperation.h"
 
@@ -117,18 +118,91 @@ void *FastGaussianBlurOperation::initialize_tile_data(rcti *rect)
   return iirgaus_;
 }
 
+/** Young/VanVliet recursive filter coefficients with Triggs/Sdika border corrections. */
+struct IIRGaussCoefficients {
+  double cf[4];
+  double tsM[9];
+};
+
+/**
+ * Filters a line of #L values from \a X forward into \a W and backward into \a Y.
+ * Expects lines of at least 3 values.
+ */
+static void IIR_gauss_line(const IIRGaussCoefficients &coefs,
+                           const double *X,
+                           double *W,
+                           double *Y,
+                           const int L)
+{
+  const double *cf = coefs.cf;
+  const double *tsM = coefs.tsM;
+  double tsu[3], tsv[3];
+
+  W[0] = cf[0] * X[0] + cf[1] * X[0] + cf[2] * X[0] + cf[3] * X[0];
+  W[1] = cf[0] * X[1] + cf[1] * W[0] + cf[2] * X[0] + cf[3] * X[0];
+  W[2] = cf[0] * X[2] + cf[1] * W[1] + cf[2] * W[0] + cf[3] * X[0];
+  for (int i = 3; i < L; i++) {
+    W[i] = cf[0] * X[i] + cf[1] * W[i - 1] + cf[2] * W[i - 2] + cf[3] * W[i - 3];
+  }
+  tsu[0] = W[L - 1] - X[L - 1];
+  tsu[1] = W[L - 2] - X[L - 1];
+  tsu[2] = W[L - 3] - X[L - 1];
+  tsv[0] = tsM[0] * tsu[0] + tsM[1] * tsu[1] + tsM[2] * tsu[2] + X[L - 1];
+  tsv[1] = tsM[3] * tsu[0] + tsM[4] * tsu[1] + tsM[5] * tsu[2] + X[L - 1];
+  tsv[2] = tsM[6] * tsu[0] + tsM[7] * tsu[1] + tsM[8] * tsu[2] + X[L - 1];
+  Y[L - 1] = cf[0] * W[L - 1] + cf[1] * tsv[0] + cf[2] * tsv[1] + cf[3] * tsv[2];
+  Y[L - 2] = cf[0] * W[L - 2] + cf[1] * Y[L - 1] + cf[2] * tsv[0] + cf[3] * tsv[1];
+  Y[L - 3] = cf[0] * W[L - 3] + cf[1] * Y[L - 2] + cf[2] * Y[L - 1] + cf[3] * tsv[0];
+  for (int i = L - 4; i >= 0; i--) {
+    Y[i] = cf[0] * W[i] + cf[1] * Y[i + 1] + cf[2] * Y[i + 2] + cf[3] * Y[i + 3];
+  }
+}
+
+/**
+ * Filters \a num_lines lines of \a line_len values, where values are \a elem_stride apart and
+ * lines \a line_stride apart. Lines are independent of each other so they are filtered in
+ * parallel, each task with its own intermediate buffers.
+ */
+static void IIR_gauss_lines(const IIRGaussCoefficients &coefs,
+                            float *buffer,
+                            const int num_lines,
+                            const int line_len,
+                            const int elem_stride,
+                            const int line_stride)
+{
+  /* Lines are short compared to the filter cost per line, group them to reduce overhead. */
+  constexpr int64_t lines_grain_size = 8;
+  threading::parallel_for(IndexRange(num_lines), lines_grain_size, [&](const IndexRange lines) {
+    Array<double> X(line_len);
+    Array<double> W(line_len);
+    Array<double> Y(line_len);
+    for (const int line : lines) {
+      float *line_start = buffer + line * line_stride;
+      float *elem = line_start;
+      for (int i = 0; i < line_len; i++, elem += elem_stride) {
+        X[i] = *elem;
+      }
+      IIR_gauss_line(coefs, X.data(), W.data(), Y.data(), line_len);
+      elem = line_start;
+      for (int i = 0; i < line_len; i++, elem += elem_stride) {
+        *elem = Y[i];
+      }
+    }
+  });
+}
+
 void FastGaussianBlurOperation::IIR_gauss(MemoryBuffer *src,
                                           float sigma,
                                           unsigned int chan,
                                           unsigned int xy)
 {
   BLI_assert(!src->is_a_single_elem());
-  double q, q2, sc, cf[4], tsM[9], tsu[3], tsv[3];
-  double *X, *Y, *W;
-  const unsigned int src_width = src->get_width();
-  const unsigned int src_height = src->get_height();
-  unsigned int x, y, sz;
-  unsigned int i;
+  double q, q2, sc;
+  IIRGaussCoefficients coefs;
+  double *cf = coefs.cf;
+  double *tsM = coefs.tsM;
+  const int src_width = src->get_width();
+  const int src_height = src->get_height();
   float *buffer = src->get_buffer();
   const uint8_t num_channels = src->get_num_channels();
 
@@ -141,7 +215,7 @@ void FastGaussianBlurOperation::IIR_gauss(MemoryBuffer *src,
     xy = 3;
   }
 
-  /* XXX The YVV macro defined below explicitly expects sources of at least 3x3 pixels,
+  /* XXX #IIR_gauss_line explicitly expects sources of at least 3x3 pixels,
    *     so just skipping blur along faulty direction if src's def is below that limit! */
   if (src_width < 3) {
     xy &= ~1;
@@ -192,75 +266,13 @@ void FastGaussianBlurOperation::IIR_gauss(MemoryBuffer *src,
                  cf[3] * cf[3] * cf[3] - cf[3] * cf[2] + cf[3]);
   tsM[8] = sc * (cf[3] * (cf[1] + cf[3] * cf[2]));
 
-#define YVV(L) \
-  { \
-    W[0] = cf[0] * X[0] + cf[1] * X[0] + cf[2] * X[0] + cf[3] * X[0]; \
-    W[1] = cf[0] * X[1] + cf[1] * W[0] + cf[2] * X[0] + cf[3] * X[0]; \
-    W[2] = cf[0] * X[2] + cf[1] * W[1] + cf[2] * W[0] + cf[3] * X[0]; \
-    for (i = 3; i < L; i++) { \
-      W[i] = cf[0] * X[i] + cf[1] * W[i - 1] + cf[2] * W[i - 2] + cf[3] * W[i - 3]; \
-    } \
-    tsu[0] = W[L - 1] - X[L - 1]; \
-    tsu[1] = W[L - 2] - X[L - 1]; \
-    tsu[2] = W[L - 3] - X[L - 1]; \
-    tsv[0] = tsM[0] * tsu[0] + tsM[1] * tsu[1] + tsM[2] * tsu[2] + X[L - 1]; \
-    tsv[1] = tsM[3] * tsu[0] + tsM[4] * tsu[1] + tsM[5] * tsu[2] + X[L - 1]; \
-    tsv[2] = tsM[6] * tsu[0] + tsM[7] * tsu[1] + tsM[8] * tsu[2] + X[L - 1]; \
-    Y[L - 1] = cf[0] * W[L - 1] + cf[1] * tsv[0] + cf[2] * tsv[1] + cf[3] * tsv[2]; \
-    Y[L - 2] = cf[0] * W[L - 2] + cf[1] * Y[L - 1] + cf[2] * tsv[0] + cf[3] * tsv[1]; \
-    Y[L - 3] = cf[0] * W[L - 3] + cf[1] * Y[L - 2] + cf[2] * Y[L - 1] + cf[3] * tsv[0]; \
-    /* 'i != UINT_MAX' is really 'i >= 0', but necessary for unsigned int wrapping */ \
-    for (i = L - 4; i != UINT_MAX; i--) { \
-      Y[i] = cf[0] * W[i] + cf[1] * Y[i + 1] + cf[2] * Y[i + 2] + cf[3] * Y[i + 3]; \
-    } \
-  } \
-  (void)0
-
-  /* Intermediate buffers. */
-  sz = MAX2(src_width, src_height);
-  X = (double *)MEM_callocN(sz * sizeof(double), "IIR_gauss X buf");
-  Y = (double *)MEM_callocN(sz * sizeof(double), "IIR_gauss Y buf");
-  W = (double *)MEM_callocN(sz * sizeof(double), "IIR_gauss W buf");
+  const int row_stride = src_width * num_channels;
   if (xy & 1) { /* H. */
-    int offset;
-    for (y = 0; y < src_height; y++) {
-      const int yx = y * src_width;
-      offset = yx * num_channels + chan;
-      for (x = 0; x < src_width; x++) {
-        X[x] = buffer[offset];
-        offset += num_channels;
-      }
-      YVV(src_width);
-      offset = yx * num_channels + chan;
-      for (x = 0; x < src_width; x++) {
-        buffer[offset] = Y[x];
-        offset += num_channels;
-      }
-    }
+    IIR_gauss_lines(coefs, buffer + chan, src_height, src_width, num_channels, row_stride);
   }
   if (xy & 2) { /* V. */
-    int offset;
-    const int add = src_width * num_channels;
-
-    for (x = 0; x < src_width; x++) {
-      offset = x * num_channels + chan;
-      for (y = 0; y < src_height; y++) {
-        X[y] = buffer[offset];
-        offset += add;
-      }
-      YVV(src_height);
-      offset = x * num_channels + chan;
-      for (y = 0; y < src_height; y++) {
-        buffer[offset] = Y[y];
-        offset += add;
-      }
-    }
+    IIR_gauss_lines(coefs, buffer + chan, src_width, src_height, row_stride, num_channels);
   }
-
-  MEM_freeN(X);
-  MEM_freeN(W);
-  MEM_freeN(Y);
-#undef YVV
 }
 
 void FastGaussianBlurOperation::get_area_of_interest(const int input_idx,
@@ -281,8 +293,7 @@ void FastGaussianBlurOperation::update_memory_buffer_started(MemoryBuffer *outpu
                                                              const rcti &area,
                                                              Span<MemoryBuffer *> inputs)
 {
-  /* TODO(manzanilla): Add a render test and make #IIR_gauss multi-threaded with support for
-   * an output buffer. */
+  /* TODO(manzanilla): Add a render test and make #IIR_gauss support an output buffer. */
   const MemoryBuffer *input = inputs[IMAGE_INPUT_INDEX];
   MemoryBuffer *image = nullptr;
   const bool is_full_output = BLI_rcti_compare(&output->get_rect(), &area);
@@ -17,6 +17,7 @@
  */
 
 #include "COM_GlareFogGlowOperation.h"
+#include "COM_FFTConvolution.h"
 
 namespace blender::compositor {
 
@@ -269,22 +270,6 @@ static void convolve(float *dst, MemoryBuffer *in1, MemoryBuffer *in2)
   float *kernel_buffer = in2->get_buffer();
   float *image_buffer = in1->get_buffer();
 
-  MemoryBuffer *rdst = new MemoryBuffer(DataType::Color, in1->get_rect());
-  memset(rdst->get_buffer(),
-         0,
-         rdst->get_width() * rdst->get_height() * COM_DATA_TYPE_COLOR_CHANNELS * sizeof(float));
-
-  /* Convolution result width & height. */
-  w2 = 2 * kernel_width - 1;
-  h2 = 2 * kernel_height - 1;
-  /* FFT pow2 required size & log2. */
-  w2 = next_pow2(w2, &log2_w);
-  h2 = next_pow2(h2, &log2_h);
-
-  /* Allocate space. */
-  data1 = (fREAL *)MEM_callocN(3 * w2 * h2 * sizeof(fREAL), "convolve_fast FHT data1");
-  data2 = (fREAL *)MEM_callocN(w2 * h2 * sizeof(fREAL), "convolve_fast FHT data2");
-
   /* Normalize convolutor. */
   wt[0] = wt[1] = wt[2] = 0.0f;
   for (y = 0; y < kernel_height; y++) {
@@ -309,6 +294,33 @@ static void convolve(float *dst, MemoryBuffer *in1, MemoryBuffer *in2)
     }
   }
 
+  if (FFTConvolution::is_supported()) {
+    /* Alpha is not convolved and is zero, like in the result of the fallback below. */
+    MemoryBuffer result(dst, COM_DATA_TYPE_COLOR_CHANNELS, in1->get_rect());
+    FFTConvolution convolution(*in2, 3, image_width, image_height);
+    convolution.convolve(*in1, in1->get_rect(), result);
+    for (BuffersIterator<float> it = result.iterate_with({}); !it.is_end(); ++it) {
+      it.out[3] = 0.0f;
+    }
+    return;
+  }
+
+  MemoryBuffer *rdst = new MemoryBuffer(DataType::Color, in1->get_rect());
+  memset(rdst->get_buffer(),
+         0,
+         rdst->get_width() * rdst->get_height() * COM_DATA_TYPE_COLOR_CHANNELS * sizeof(float));
+
+  /* Convolution result width & height. */
+  w2 = 2 * kernel_width - 1;
+  h2 = 2 * kernel_height - 1;
+  /* FFT pow2 required size & log2. */
+  w2 = next_pow2(w2, &log2_w);
+  h2 = next_pow2(h2, &log2_h);
+
+  /* Allocate space. */
+  data1 = (fREAL *)MEM_callocN(3 * w2 * h2 * sizeof(fREAL), "convolve_fast FHT data1");
+  data2 = (fREAL *)MEM_callocN(w2 * h2 * sizeof(fREAL), "convolve_fast FHT data2");
+
   /* Copy image data, unpacking interleaved RGBA into separate channels
    * only need to calc data1 once. */
 
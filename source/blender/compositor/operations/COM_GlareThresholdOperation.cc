@@ -70,6 +70,11 @@ void GlareThresholdOperation::deinit_execution()
   input_program_ = nullptr;
 }
 
+void GlareThresholdOperation::hash_output_params()
+{
+  hash_params((int)settings_->quality, settings_->threshold);
+}
+
 void GlareThresholdOperation::update_memory_buffer_partial(MemoryBuffer *output,
                                                            const rcti &area,
                                                            Span<MemoryBuffer *> inputs)
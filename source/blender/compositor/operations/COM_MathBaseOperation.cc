@@ -49,6 +49,11 @@ void MathBaseOperation::deinit_execution()
   input_value3_operation_ = nullptr;
 }
 
+void MathBaseOperation::hash_output_params()
+{
+  hash_param(use_clamp_);
+}
+
 void MathBaseOperation::determine_canvas(const rcti &preferred_area, rcti &r_area)
 {
   NodeOperationInput *socket;
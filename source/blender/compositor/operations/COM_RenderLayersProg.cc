@@ -184,6 +184,14 @@ void RenderLayersProg::deinit_execution()
   }
 }
 
+void RenderLayersProg::hash_output_params()
+{
+  /* Render results are identified by where they come from, the compositor is told when they
+   * change, see #COM_clear_caches. */
+  hash_params(scene_, layer_id_, elementsize_);
+  hash_params(pass_name_, StringRef(view_name_ ? view_name_ : ""));
+}
+
 void RenderLayersProg::determine_canvas(const rcti &UNUSED(preferred_area), rcti &r_area)
 {
   Scene *sce = this->get_scene();
@@ -0,0 +1,75 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Copyright 2021, Blender Foundation.
+ */
+
+#include "testing/testing.h"
+
+#include "COM_BufferCache.h"
+#include "COM_MemoryBuffer.h"
+
+namespace blender::compositor::tests {
+
+static std::unique_ptr<MemoryBuffer> create_buffer()
+{
+  rcti rect;
+  BLI_rcti_init(&rect, 0, 4, 0, 4);
+  return std::make_unique<MemoryBuffer>(DataType::Color, rect);
+}
+
+TEST(BufferCache, AddAndLookup)
+{
+  BufferCache cache;
+  cache.execution_started();
+  EXPECT_EQ(cache.lookup(1), nullptr);
+
+  std::unique_ptr<MemoryBuffer> buffer = create_buffer();
+  MemoryBuffer *buffer_ptr = buffer.get();
+  EXPECT_TRUE(cache.add(1, buffer));
+  EXPECT_EQ(buffer, nullptr);
+
+  cache.execution_started();
+  EXPECT_EQ(cache.lookup(1), buffer_ptr);
+  EXPECT_EQ(cache.lookup(2), nullptr);
+}
+
+TEST(BufferCache, AddExistingKey)
+{
+  BufferCache cache;
+  cache.execution_started();
+  std::unique_ptr<MemoryBuffer> buffer1 = create_buffer();
+  MemoryBuffer *buffer1_ptr = buffer1.get();
+  EXPECT_TRUE(cache.add(1, buffer1));
+
+  /* Ownership is kept when not added. */
+  std::unique_ptr<MemoryBuffer> buffer2 = create_buffer();
+  EXPECT_FALSE(cache.add(1, buffer2));
+  EXPECT_NE(buffer2, nullptr);
+  EXPECT_EQ(cache.lookup(1), buffer1_ptr);
+}
+
+TEST(BufferCache, Clear)
+{
+  BufferCache cache;
+  cache.execution_started();
+  std::unique_ptr<MemoryBuffer> buffer = create_buffer();
+  EXPECT_TRUE(cache.add(1, buffer));
+
+  cache.clear();
+  EXPECT_EQ(cache.lookup(1), nullptr);
+}
+
+}  // namespace blender::compositor::tests
@@ -0,0 +1,84 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Copyright 2021, Blender Foundation.
+ */
+
+#include "testing/testing.h"
+
+#include "COM_MemoryBuffer.h"
+#include "COM_PackedBuffer.h"
+
+namespace blender::compositor::tests {
+
+static std::unique_ptr<MemoryBuffer> create_buffer(const DataType data_type,
+                                                   const Span<float> values)
+{
+  rcti rect;
+  BLI_rcti_init(&rect, 2, 2 + values.size() / COM_data_type_num_channels(data_type), 3, 4);
+  std::unique_ptr<MemoryBuffer> buffer = std::make_unique<MemoryBuffer>(data_type, rect);
+  memcpy(buffer->get_buffer(), values.data(), values.size() * sizeof(float));
+  return buffer;
+}
+
+static void test_pack_unpack(const DataType data_type,
+                             const Span<float> values,
+                             const PackedBuffer::Type expected_type)
+{
+  std::unique_ptr<MemoryBuffer> buffer = create_buffer(data_type, values);
+  std::unique_ptr<PackedBuffer> packed = PackedBuffer::pack(*buffer);
+  ASSERT_NE(packed, nullptr);
+  EXPECT_EQ(packed->get_type(), expected_type);
+  EXPECT_LT(packed->get_memory_size(), buffer->get_memory_size());
+  EXPECT_EQ(packed->get_unpacked_memory_size(), buffer->get_memory_size());
+
+  std::unique_ptr<MemoryBuffer> unpacked = packed->unpack();
+  EXPECT_EQ(unpacked->get_num_channels(), buffer->get_num_channels());
+  EXPECT_TRUE(BLI_rcti_compare(&unpacked->get_rect(), &buffer->get_rect()));
+  for (const int i : values.index_range()) {
+    EXPECT_EQ(unpacked->get_buffer()[i], values[i]);
+  }
+}
+
+TEST(PackedBuffer, PackBytes)
+{
+  test_pack_unpack(DataType::Value, {0.0f, 1.0f, 0.0f, 1.0f}, PackedBuffer::Type::Byte);
+  test_pack_unpack(DataType::Color,
+                   {0.0f, 1.0f, 128 * (1.0f / 255.0f), 1.0f, 1.0f, 0.0f, 3 * (1.0f / 255.0f), 1.0f},
+                   PackedBuffer::Type::Byte);
+}
+
+TEST(PackedBuffer, PackHalfs)
+{
+  test_pack_unpack(DataType::Value, {0.0f, 2.0f, -0.5f, 1024.0f}, PackedBuffer::Type::Half);
+  test_pack_unpack(
+      DataType::Vector, {0.0f, -0.0f, 0.125f, 3.0f, 65504.0f, -1.0f}, PackedBuffer::Type::Half);
+}
+
+TEST(PackedBuffer, PackNone)
+{
+  /* Values which lose precision as half floats. */
+  std::unique_ptr<MemoryBuffer> buffer = create_buffer(DataType::Value,
+                                                       {0.0f, 1.0f, 0.1f, 1.0f});
+  EXPECT_EQ(PackedBuffer::pack(*buffer), nullptr);
+
+  buffer = create_buffer(DataType::Value, {0.0f, 1.0f, 1e-6f, 1.0f});
+  EXPECT_EQ(PackedBuffer::pack(*buffer), nullptr);
+
+  buffer = create_buffer(DataType::Value, {0.0f, 1.0f, 1e6f, 1.0f});
+  EXPECT_EQ(PackedBuffer::pack(*buffer), nullptr);
+}
+
+}  // namespace blender::compositor::tests
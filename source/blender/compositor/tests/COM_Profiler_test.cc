@@ -0,0 +1,78 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Copyright 2021, Blender Foundation.
+ */
+
+#include "testing/testing.h"
+
+#include "BKE_node.h"
+
+#include "COM_NodeOperation.h"
+#include "COM_Profiler.h"
+
+namespace blender::compositor::tests {
+
+static bNodeInstanceKey node_key(const unsigned int value)
+{
+  bNodeInstanceKey key;
+  key.value = value;
+  return key;
+}
+
+class NodeKeyOperation : public NodeOperation {
+ public:
+  NodeKeyOperation(bNodeInstanceKey key)
+  {
+    set_node_instance_key(key);
+  }
+};
+
+TEST(Profiler, accumulates_node_operations)
+{
+  NodeKeyOperation op_a(node_key(1));
+  NodeKeyOperation op_b(node_key(1));
+  NodeKeyOperation op_c(node_key(2));
+
+  Profiler profiler;
+  profiler.add_operation(op_a, 1.0, 100);
+  profiler.add_operation(op_b, 0.5, 20);
+  profiler.add_operation(op_c, 2.0, 0);
+
+  const NodeProfile *profile = profiler.lookup(node_key(1));
+  ASSERT_NE(profile, nullptr);
+  EXPECT_EQ(profile->execution_time, 1.5);
+  EXPECT_EQ(profile->allocated_bytes, 120);
+
+  profile = profiler.lookup(node_key(2));
+  ASSERT_NE(profile, nullptr);
+  EXPECT_EQ(profile->execution_time, 2.0);
+  EXPECT_EQ(profile->allocated_bytes, 0);
+
+  EXPECT_EQ(profiler.lookup(node_key(3)), nullptr);
+
+  profiler.clear();
+  EXPECT_EQ(profiler.lookup(node_key(1)), nullptr);
+}
+
+TEST(Profiler, ignores_operations_without_node)
+{
+  NodeKeyOperation op(NODE_INSTANCE_KEY_NONE);
+  Profiler profiler;
+  profiler.add_operation(op, 1.0, 100);
+  EXPECT_EQ(profiler.lookup(NODE_INSTANCE_KEY_NONE), nullptr);
+}
+
+}  // namespace blender::compositor::tests
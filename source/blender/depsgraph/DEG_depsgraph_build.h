@@ -83,6 +83,16 @@ void DEG_graph_relations_update(struct Depsgraph *graph);
 /** Tag all relations in the database for update. */
 void DEG_relations_tag_update(struct Main *bmain);
 
+/**
+ * Tag relations for update only in the graphs which contain the given ID.
+ *
+ * Use instead of #DEG_relations_tag_update when the change only affects relations coming from
+ * the data of this ID (its modifiers, constraints and such), graphs which do not contain the ID
+ * do not depend on it and are not rebuilt. When the change can add the ID to a graph (linking it
+ * to a collection or scene), #DEG_relations_tag_update is to be used.
+ */
+void DEG_relations_tag_update_for_id(struct Main *bmain, struct ID *id);
+
 /* Add Dependencies  ----------------------------- */
 
 /**
@@ -68,6 +68,23 @@ void DEG_debug_stats_gnuplot(const struct Depsgraph *graph,
                              const char *label,
                              const char *output_filename);
 
+/* ************************************************ */
+/* Evaluation Timeline */
+
+/**
+ * Start recording when every operation of the graph is evaluated, on which thread and how long
+ * it waited to be started once its dependencies were evaluated. Only evaluations of frames within
+ * the given (inclusive) range are recorded. Restarting discards the previous recording.
+ */
+void DEG_debug_trace_begin(struct Depsgraph *depsgraph, float frame_start, float frame_end);
+/** Stop recording and free recorded events. */
+void DEG_debug_trace_end(struct Depsgraph *depsgraph);
+/**
+ * Write the recorded events in the Chrome trace event JSON format (`chrome://tracing`, Perfetto).
+ * \return false when the graph is not being traced.
+ */
+bool DEG_debug_trace_write(const struct Depsgraph *depsgraph, FILE *fp);
+
 /* ************************************************ */
 
 /** Compare two dependency graphs. */
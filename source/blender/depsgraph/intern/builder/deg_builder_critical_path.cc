@@ -0,0 +1,109 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2021 Blender Foundation.
+ * All rights reserved.
+ */
+
+/** \file
+ * \ingroup depsgraph
+ */
+
+#include "intern/builder/deg_builder_critical_path.h"
+
+#include <algorithm>
+
+#include "BLI_vector.hh"
+
+#include "intern/node/deg_node.h"
+#include "intern/node/deg_node_operation.h"
+
+#include "intern/depsgraph.h"
+#include "intern/depsgraph_relation.h"
+
+namespace blender::deg {
+
+static bool is_critical_path_relation(const Relation *rel)
+{
+  return rel->from->type == NodeType::OPERATION && rel->to->type == NodeType::OPERATION &&
+         (rel->flag & RELATION_FLAG_CYCLIC) == 0;
+}
+
+static uint32_t critical_path_length_of(const Node *node)
+{
+  if (node->type != NodeType::OPERATION) {
+    return 0;
+  }
+  return ((const OperationNode *)node)->critical_path_length;
+}
+
+void deg_graph_calculate_critical_path(Depsgraph *graph)
+{
+  /* Visit operations in reverse topological order: an operation is handled once all operations
+   * which depend on it are, starting from the ones nothing depends on. Cyclic relations are
+   * ignored, so the traversal is guaranteed to terminate. The number of not yet handled
+   * dependent operations is stored in the custom flags. */
+  Vector<OperationNode *> queue;
+  for (OperationNode *node : graph->operations) {
+    node->critical_path_length = 0;
+    node->custom_flags = 0;
+    for (Relation *rel : node->outlinks) {
+      if (is_critical_path_relation(rel)) {
+        node->custom_flags++;
+      }
+    }
+    if (node->custom_flags == 0) {
+      queue.append(node);
+    }
+  }
+
+  while (!queue.is_empty()) {
+    OperationNode *node = queue.pop_last();
+    /* No-op operations are only there for the graph structure, they don't add to the length. */
+    if (!node->is_noop()) {
+      node->critical_path_length++;
+    }
+    for (Relation *rel : node->inlinks) {
+      if (!is_critical_path_relation(rel)) {
+        continue;
+      }
+      OperationNode *from = (OperationNode *)rel->from;
+      from->critical_path_length = std::max(from->critical_path_length, node->critical_path_length);
+      if (--from->custom_flags == 0) {
+        queue.append(from);
+      }
+    }
+  }
+
+  /* The evaluation schedules operations in the order of the graph's operations, and the children
+   * of an evaluated operation in the order of its relations. Sort the operations so the longest
+   * chains are started first, and the relations so the most critical child is pushed last to
+   * the thread's task queue, which makes the thread continue with it right away. */
+  std::stable_sort(graph->operations.begin(),
+                   graph->operations.end(),
+                   [](const OperationNode *a, const OperationNode *b) {
+                     return a->critical_path_length > b->critical_path_length;
+                   });
+  for (OperationNode *node : graph->operations) {
+    node->custom_flags = 0;
+    std::stable_sort(node->outlinks.begin(),
+                     node->outlinks.end(),
+                     [](const Relation *a, const Relation *b) {
+                       return critical_path_length_of(a->to) < critical_path_length_of(b->to);
+                     });
+  }
+}
+
+}  // namespace blender::deg
@@ -25,6 +25,7 @@
 
 #include "DNA_scene_types.h"
 
+#include "deg_builder_critical_path.h"
 #include "deg_builder_cycle.h"
 #include "deg_builder_nodes.h"
 #include "deg_builder_relations.h"
@@ -94,6 +95,8 @@ void AbstractBuilderPipeline::build_step_finalize()
   if (G.debug_value == 799) {
     deg_graph_transitive_reduction(deg_graph_);
   }
+  /* Prioritize long chains of operations during evaluation. */
+  deg_graph_calculate_critical_path(deg_graph_);
   /* Store pointers to commonly used evaluated datablocks. */
   deg_graph_->scene_cow = (Scene *)deg_graph_->get_cow_id(&deg_graph_->scene->id);
   /* Flush visibility layer and re-schedule nodes for update. */
@@ -23,6 +23,8 @@
 
 #pragma once
 
+#include <memory>
+
 #include "intern/debug/deg_time_average.h"
 #include "intern/depsgraph_type.h"
 
@@ -33,9 +35,12 @@
 namespace blender {
 namespace deg {
 
+class DepsgraphTrace;
+
 class DepsgraphDebug {
  public:
   DepsgraphDebug();
+  ~DepsgraphDebug();
 
   bool do_time_debug() const;
 
@@ -53,6 +58,9 @@ class DepsgraphDebug {
    * This is NOT an indication that depsgraph is at its evaluated state. */
   bool is_ever_evaluated;
 
+  /* Timeline of operation evaluation, see #DEG_debug_trace_begin. */
+  std::unique_ptr<DepsgraphTrace> trace;
+
  protected:
   /* Maximum number of counters used to calculate frame rate of depsgraph update. */
   static const constexpr int MAX_FPS_COUNTERS = 64;
@@ -0,0 +1,132 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2021 Blender Foundation.
+ * All rights reserved.
+ */
+
+/** \file
+ * \ingroup depsgraph
+ */
+
+#include "intern/debug/deg_debug_trace.h"
+
+#include <algorithm>
+
+#include "BLI_chrome_trace.hh"
+#include "BLI_utildefines.h"
+
+#include "PIL_time.h"
+
+#include "DEG_depsgraph_debug.h"
+
+#include "intern/depsgraph.h"
+#include "intern/node/deg_node_component.h"
+#include "intern/node/deg_node_id.h"
+#include "intern/node/deg_node_operation.h"
+
+namespace blender::deg {
+
+DepsgraphTrace::DepsgraphTrace(float frame_start, float frame_end)
+    : frame_start_(frame_start),
+      frame_end_(frame_end),
+      current_frame_(0.0f),
+      time_origin_(PIL_check_seconds_timer())
+{
+}
+
+bool DepsgraphTrace::begin_graph_evaluation(float frame)
+{
+  if (frame < frame_start_ || frame > frame_end_) {
+    return false;
+  }
+  current_frame_ = frame;
+  return true;
+}
+
+void DepsgraphTrace::record_operation(const OperationNode *operation_node,
+                                      double start_time,
+                                      double end_time)
+{
+  PendingEvent event;
+  event.operation_node = operation_node;
+  event.ready_time = operation_node->stats.ready_time;
+  event.start_time = start_time;
+  event.end_time = end_time;
+  event.thread_index = threading::enumerable_thread_specific_utils::thread_id;
+  pending_events_.local().append(event);
+}
+
+void DepsgraphTrace::end_graph_evaluation()
+{
+  for (Vector<PendingEvent> &pending_events : pending_events_) {
+    for (const PendingEvent &pending_event : pending_events) {
+      const OperationNode *operation_node = pending_event.operation_node;
+      const ComponentNode *comp_node = operation_node->owner;
+      Event event;
+      event.name = operation_node->identifier();
+      event.component_name = comp_node->identifier();
+      event.id_name = comp_node->owner->name;
+      event.frame = current_frame_;
+      event.wait_time = std::max(pending_event.start_time - pending_event.ready_time, 0.0);
+      event.start_time = pending_event.start_time;
+      event.end_time = pending_event.end_time;
+      event.thread_index = pending_event.thread_index;
+      events_.append(std::move(event));
+    }
+    pending_events.clear();
+  }
+}
+
+void DepsgraphTrace::write_chrome_trace(FILE *fp) const
+{
+  chrome_trace::Writer writer(fp);
+  for (const Event &event : events_) {
+    writer.event_begin('X', event.thread_index, (event.start_time - time_origin_) * 1e6);
+    writer.field("name", event.name);
+    writer.field("cat", event.component_name);
+    writer.field("dur", (event.end_time - event.start_time) * 1e6);
+    writer.arg("id", event.id_name);
+    writer.arg("frame", event.frame);
+    writer.arg("wait_us", event.wait_time * 1e6);
+    writer.event_end();
+  }
+}
+
+}  // namespace blender::deg
+
+namespace deg = blender::deg;
+
+void DEG_debug_trace_begin(Depsgraph *depsgraph, float frame_start, float frame_end)
+{
+  deg::Depsgraph *deg_graph = (deg::Depsgraph *)depsgraph;
+  deg_graph->debug.trace = std::make_unique<deg::DepsgraphTrace>(frame_start, frame_end);
+}
+
+void DEG_debug_trace_end(Depsgraph *depsgraph)
+{
+  deg::Depsgraph *deg_graph = (deg::Depsgraph *)depsgraph;
+  deg_graph->debug.trace.reset();
+}
+
+bool DEG_debug_trace_write(const Depsgraph *depsgraph, FILE *fp)
+{
+  const deg::Depsgraph *deg_graph = (const deg::Depsgraph *)depsgraph;
+  if (!deg_graph->debug.trace) {
+    return false;
+  }
+  deg_graph->debug.trace->write_chrome_trace(fp);
+  return true;
+}
@@ -0,0 +1,85 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2021 Blender Foundation.
+ * All rights reserved.
+ */
+
+/** \file
+ * \ingroup depsgraph
+ *
+ * Timeline of operation evaluation, for finding what limits the evaluation of a frame.
+ */
+
+#pragma once
+
+#include <cstdio>
+
+#include "BLI_enumerable_thread_specific.hh"
+#include "BLI_vector.hh"
+
+#include "intern/depsgraph_type.h"
+
+namespace blender::deg {
+
+struct OperationNode;
+
+class DepsgraphTrace {
+ public:
+  /* Only evaluations of frames within the given (inclusive) range are recorded. */
+  DepsgraphTrace(float frame_start, float frame_end);
+
+  /* Returns false when the given frame is not to be recorded. */
+  bool begin_graph_evaluation(float frame);
+  /* Thread-safe, called from the evaluation threads for every evaluated operation. */
+  void record_operation(const OperationNode *operation_node, double start_time, double end_time);
+  /* Resolve the recorded operations to names, while the nodes are still known to be alive. */
+  void end_graph_evaluation();
+
+  /* Write all recorded events in the Chrome trace event JSON format, which can be loaded in
+   * `chrome://tracing` or Perfetto. */
+  void write_chrome_trace(FILE *fp) const;
+
+ protected:
+  struct PendingEvent {
+    const OperationNode *operation_node;
+    double ready_time;
+    double start_time;
+    double end_time;
+    int thread_index;
+  };
+
+  struct Event {
+    string name;
+    string component_name;
+    string id_name;
+    float frame;
+    double wait_time;
+    double start_time;
+    double end_time;
+    int thread_index;
+  };
+
+  float frame_start_;
+  float frame_end_;
+  float current_frame_;
+  /* All timestamps are exported relative to this. */
+  double time_origin_;
+
+  threading::EnumerableThreadSpecific<Vector<PendingEvent>> pending_events_;
+  Vector<Event> events_;
+};
+
+}  // namespace blender::deg
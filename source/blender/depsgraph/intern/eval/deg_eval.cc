@@ -29,6 +29,7 @@
 
 #include "BLI_compiler_attrs.h"
 #include "BLI_gsqueue.h"
+#include "BLI_profile.hh"
 #include "BLI_task.h"
 #include "BLI_utildefines.h"
 
@@ -47,6 +48,7 @@
 
 #include "atomic_ops.h"
 
+#include "intern/debug/deg_debug_trace.h"
 #include "intern/depsgraph.h"
 #include "intern/depsgraph_relation.h"
 #include "intern/depsgraph_tag.h"
@@ -98,6 +100,8 @@ enum class EvaluationStage {
 struct DepsgraphEvalState {
   Depsgraph *graph;
   bool do_stats;
+  /* Non-null when the evaluation of the current frame is to be recorded. */
+  DepsgraphTrace *trace;
   EvaluationStage stage;
   bool need_single_thread_pass;
 };
@@ -108,11 +112,19 @@ void evaluate_node(const DepsgraphEvalState *state, OperationNode *operation_nod
 
   /* Sanity checks. */
   BLI_assert_msg(!operation_node->is_noop(), "NOOP nodes should not actually be scheduled");
+  BLI_PROFILE_SCOPE_DETAIL(operationCodeAsString(operation_node->opcode),
+                           operation_node->owner->owner->name.c_str());
   /* Perform operation. */
-  if (state->do_stats) {
+  if (state->do_stats || state->trace) {
     const double start_time = PIL_check_seconds_timer();
     operation_node->evaluate(depsgraph);
-    operation_node->stats.current_time += PIL_check_seconds_timer() - start_time;
+    const double end_time = PIL_check_seconds_timer();
+    if (state->do_stats) {
+      operation_node->stats.current_time += end_time - start_time;
+    }
+    if (state->trace) {
+      state->trace->record_operation(operation_node, start_time, end_time);
+    }
   }
   else {
     operation_node->evaluate(depsgraph);
@@ -274,6 +286,9 @@ void schedule_node(DepsgraphEvalState *state,
       schedule_children(state, node, schedule_function, schedule_function_args...);
     }
     else {
+      if (state->trace) {
+        node->stats.ready_time = PIL_check_seconds_timer();
+      }
       /* children are scheduled once this task is completed */
       schedule_function(node, 0, schedule_function_args...);
     }
@@ -381,6 +396,10 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
   DepsgraphEvalState state;
   state.graph = graph;
   state.do_stats = graph->debug.do_time_debug();
+  state.trace = nullptr;
+  if (graph->debug.trace && graph->debug.trace->begin_graph_evaluation(graph->frame)) {
+    state.trace = graph->debug.trace.get();
+  }
   state.need_single_thread_pass = false;
   /* Prepare all nodes for evaluation. */
   initialize_execution(&state, graph);
@@ -411,6 +430,9 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
   if (state.do_stats) {
     deg_eval_stats_aggregate(graph);
   }
+  if (state.trace) {
+    state.trace->end_graph_evaluation();
+  }
   /* Clear any uncleared tags - just in case. */
   deg_graph_clear_tags(graph);
   graph->is_evaluating = false;
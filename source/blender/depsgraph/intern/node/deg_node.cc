@@ -288,6 +288,7 @@ Node::Stats::Stats()
 void Node::Stats::reset()
 {
   current_time = 0.0;
+  ready_time = 0.0;
 }
 
 void Node::Stats::reset_current()
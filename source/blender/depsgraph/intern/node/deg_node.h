@@ -180,6 +180,9 @@ struct Node {
     void reset_current();
     /* Time spend on this node during current graph evaluation. */
     double current_time;
+    /* Point in time when all dependencies of the node were evaluated and it got scheduled.
+     * Only set when the evaluation is traced. */
+    double ready_time;
   };
   /* Relationships between nodes
    * The reason why all depsgraph nodes are descended from this type (apart
@@ -272,6 +272,10 @@ struct OperationNode : public Node {
   uint32_t num_links_pending;
   bool scheduled;
 
+  /* Number of operations in the longest chain of operations depending on this one, including this
+   * operation itself. Used to give priority to operations which are holding back most others. */
+  uint32_t critical_path_length;
+
   /* Identifier for the operation being performed. */
   OperationCode opcode;
   int name_tag;
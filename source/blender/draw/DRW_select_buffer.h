@@ -77,6 +77,8 @@ typedef struct SELECTID_Context {
 
   /* To check for updates. */
   float persmat[4][4];
+  /** Viewport settings that change how elements are drawn, see #select_id_draw_settings_get. */
+  int draw_settings;
   bool is_dirty;
 } SELECTID_Context;
 
@@ -75,6 +75,10 @@
   (IRRADIANCE_MAX_POOL_SIZE / IRRADIANCE_SAMPLE_SIZE_X) * \
       (IRRADIANCE_MAX_POOL_SIZE / IRRADIANCE_SAMPLE_SIZE_Y)
 
+/* Time in seconds spent rendering irradiance samples before releasing the draw context,
+ * so the viewport can still be redrawn while baking. */
+#define IRRADIANCE_SAMPLES_BATCH_TIME 0.05
+
 /* TODO: should be replace by a more elegant alternative. */
 extern void DRW_opengl_context_enable(void);
 extern void DRW_opengl_context_disable(void);
@@ -918,7 +922,11 @@ static void eevee_lightbake_cache_create(EEVEE_Data *vedata, EEVEE_LightBake *lb
   scene_eval->eevee.taa_samples = 1;
   scene_eval->eevee.gi_irradiance_smoothing = 0.0f;
 
-  stl->g_data = MEM_callocN(sizeof(*stl->g_data), __func__);
+  /* Reuse the data when rendering multiple samples in the same draw manager session. */
+  if (stl->g_data == NULL) {
+    stl->g_data = MEM_mallocN(sizeof(*stl->g_data), __func__);
+  }
+  memset(stl->g_data, 0, sizeof(*stl->g_data));
   stl->g_data->background_alpha = 1.0f;
   stl->g_data->render_timesteps = 1;
 
@@ -999,6 +1007,13 @@ static void eevee_lightbake_copy_irradiance(EEVEE_LightBake *lbake, LightCache *
   MEM_freeN(tex);
 }
 
+static void eevee_lightbake_sample_done(EEVEE_LightBake *lbake)
+{
+  lbake->done += 1;
+  *lbake->progress = lbake->done / (float)lbake->total;
+  *lbake->do_update = 1;
+}
+
 static void eevee_lightbake_render_world_sample(void *ved, void *user_data)
 {
   EEVEE_Data *vedata = (EEVEE_Data *)ved;
@@ -1051,6 +1066,8 @@ static void eevee_lightbake_render_world_sample(void *ved, void *user_data)
 
   lcache->flag |= LIGHTCACHE_CUBE_READY | LIGHTCACHE_GRID_READY;
   lcache->flag &= ~LIGHTCACHE_UPDATE_WORLD;
+
+  eevee_lightbake_sample_done(lbake);
 }
 
 static void cell_id_to_grid_loc(EEVEE_LightGrid *egrid, int cell_idx, int r_local_cell[3])
@@ -1194,6 +1211,31 @@ static void eevee_lightbake_render_grid_sample(void *ved, void *user_data)
       (lbake->grid_sample == lbake->grid_sample_len - 1)) {
     lcache->flag &= ~LIGHTCACHE_UPDATE_GRID;
   }
+
+  eevee_lightbake_sample_done(lbake);
+}
+
+/**
+ * Render consecutive samples of the current grid, starting at `lbake->grid_sample`, until the
+ * time budget is used. Acquiring the draw context and synchronizing with the GPU for every
+ * sample is expensive compared to rendering one, so only the scene cache is rebuilt in between.
+ * `lbake->grid_sample` is left at the last rendered sample.
+ */
+static void eevee_lightbake_render_grid_samples(void *ved, void *user_data)
+{
+  EEVEE_LightBake *lbake = (EEVEE_LightBake *)user_data;
+  const double start_time = PIL_check_seconds_timer();
+
+  while (true) {
+    eevee_lightbake_render_grid_sample(ved, user_data);
+
+    if ((lbake->grid_sample == lbake->grid_sample_len - 1) || G.is_break || *lbake->stop ||
+        (PIL_check_seconds_timer() - start_time) > IRRADIANCE_SAMPLES_BATCH_TIME) {
+      break;
+    }
+    lbake->grid_sample++;
+    DRW_cache_restart();
+  }
 }
 
 static void eevee_lightbake_render_probe_sample(void *ved, void *user_data)
@@ -1239,6 +1281,8 @@ static void eevee_lightbake_render_probe_sample(void *ved, void *user_data)
   if (lbake->cube_offset == lbake->cube_len - 1) {
     lcache->flag &= ~LIGHTCACHE_UPDATE_CUBE;
   }
+
+  eevee_lightbake_sample_done(lbake);
 }
 
 static float eevee_lightbake_grid_influence_volume(EEVEE_LightGrid *grid)
@@ -1363,9 +1407,6 @@ static bool lightbake_do_sample(EEVEE_LightBake *lbake,
   /* TODO: make DRW manager instantiable (and only lock on drawing) */
   eevee_lightbake_context_enable(lbake);
   DRW_custom_pipeline(&draw_engine_eevee_type, depsgraph, render_callback, lbake);
-  lbake->done += 1;
-  *lbake->progress = lbake->done / (float)lbake->total;
-  *lbake->do_update = 1;
   eevee_lightbake_context_disable(lbake);
 
   return true;
@@ -1443,7 +1484,7 @@ void EEVEE_lightbake_job(void *custom_data, short *stop, short *do_update, float
                                  prb->grid_resolution_z;
         for (lbake->grid_sample = 0; lbake->grid_sample < lbake->grid_sample_len;
              ++lbake->grid_sample) {
-          lightbake_do_sample(lbake, eevee_lightbake_render_grid_sample);
+          lightbake_do_sample(lbake, eevee_lightbake_render_grid_samples);
         }
       }
     }
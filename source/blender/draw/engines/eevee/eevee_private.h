@@ -540,8 +540,11 @@ BLI_STATIC_ASSERT(sizeof(EEVEE_Shadow) * MAX_SHADOW +
 typedef struct EEVEE_ShadowCasterBuffer {
   struct EEVEE_BoundBox *bbox;
   BLI_bitmap *update;
+  /* Casters rendered on top of the static shadow cache instead of inside it. */
+  BLI_bitmap *dynamic;
   uint alloc_count;
   uint count;
+  uint dynamic_count;
 } EEVEE_ShadowCasterBuffer;
 
 /* ************ LIGHT DATA ************* */
@@ -564,6 +567,9 @@ typedef struct EEVEE_LightsInfo {
   uchar shadow_cascade_light_indices[MAX_SHADOW_CASCADE];
   /* Update bitmap. */
   BLI_bitmap sh_cube_update[BLI_BITMAP_SIZE(MAX_SHADOW_CUBE)];
+  /* Static shadow cache: layers and matrices they were rendered with. */
+  BLI_bitmap sh_cube_static_update[BLI_BITMAP_SIZE(MAX_SHADOW_CUBE)];
+  float shadow_cube_static_mat[MAX_SHADOW_CUBE][4][4];
   /* Lights tracking */
   struct BoundSphere shadow_bounds[MAX_LIGHT]; /* Tightly packed light bounds. */
   /* List of bbox and update bitmap. Double buffered. */
@@ -912,8 +918,11 @@ typedef struct EEVEE_ViewLayerData {
   struct GPUUniformBuf *shadow_samples_ubo;
 
   struct GPUFrameBuffer *shadow_fb;
+  struct GPUFrameBuffer *shadow_static_fb;
 
   struct GPUTexture *shadow_cube_pool;
+  /* Cube shadows of the static casters only, see #EEVEE_shadows_draw_cubemap. */
+  struct GPUTexture *shadow_cube_static_pool;
   struct GPUTexture *shadow_cascade_pool;
 
   struct EEVEE_ShadowCasterBuffer shcasters_buffers[2];
@@ -972,6 +981,8 @@ typedef struct EEVEE_ObjectEngineData {
 
   bool need_update;
   bool geom_update;
+  /* Casts shadows on top of the static shadow cache, set when the object was updated. */
+  bool shadow_dynamic;
   uint shadow_caster_id;
 } EEVEE_ObjectEngineData;
 
@@ -1061,6 +1072,9 @@ typedef struct EEVEE_PrivateData {
   struct GPUUniformBuf *renderpass_ubo;
   /** For rendering shadows. */
   struct DRWView *cube_views[6];
+  /** Same as cube_views but only render the static or the dynamic shadow casters. */
+  struct DRWView *cube_static_views[6];
+  struct DRWView *cube_dynamic_views[6];
   /** For rendering probes. */
   struct DRWView *bake_views[6];
   /** Same as bake_views but does not generate culling infos. */
@@ -56,8 +56,10 @@ void EEVEE_shadows_init(EEVEE_ViewLayerData *sldata)
       sldata->shcasters_buffers[i].bbox = MEM_mallocN(
           sizeof(EEVEE_BoundBox) * SH_CASTER_ALLOC_CHUNK, __func__);
       sldata->shcasters_buffers[i].update = BLI_BITMAP_NEW(SH_CASTER_ALLOC_CHUNK, __func__);
+      sldata->shcasters_buffers[i].dynamic = BLI_BITMAP_NEW(SH_CASTER_ALLOC_CHUNK, __func__);
       sldata->shcasters_buffers[i].alloc_count = SH_CASTER_ALLOC_CHUNK;
       sldata->shcasters_buffers[i].count = 0;
+      sldata->shcasters_buffers[i].dynamic_count = 0;
     }
     sldata->lights->shcaster_frontbuffer = &sldata->shcasters_buffers[0];
     sldata->lights->shcaster_backbuffer = &sldata->shcasters_buffers[1];
@@ -78,6 +80,7 @@ void EEVEE_shadows_init(EEVEE_ViewLayerData *sldata)
       (linfo->shadow_high_bitdepth != sh_high_bitdepth)) {
     BLI_assert((sh_cube_size > 0) && (sh_cube_size <= 4096));
     DRW_TEXTURE_FREE_SAFE(sldata->shadow_cube_pool);
+    DRW_TEXTURE_FREE_SAFE(sldata->shadow_cube_static_pool);
     CLAMP(sh_cube_size, 1, 4096);
   }
 
@@ -103,6 +106,7 @@ void EEVEE_shadows_cache_init(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
   EEVEE_ShadowCasterBuffer *frontbuffer = linfo->shcaster_frontbuffer;
 
   frontbuffer->count = 0;
+  frontbuffer->dynamic_count = 0;
   linfo->num_cube_layer = 0;
   linfo->num_cascade_layer = 0;
   linfo->cube_len = linfo->cascade_len = linfo->shadow_len = 0;
@@ -138,8 +142,12 @@ void EEVEE_shadows_caster_register(EEVEE_ViewLayerData *sldata, Object *ob)
     frontbuffer->bbox = MEM_reallocN(frontbuffer->bbox,
                                      sizeof(EEVEE_BoundBox) * frontbuffer->alloc_count);
     BLI_BITMAP_RESIZE(frontbuffer->update, frontbuffer->alloc_count);
+    BLI_BITMAP_RESIZE(frontbuffer->dynamic, frontbuffer->alloc_count);
   }
 
+  /* Duplis have no engine data and are always drawn as dynamic casters. */
+  bool dynamic = true;
+
   if (ob->base_flag & BASE_FROM_DUPLI) {
     /* Duplis will always refresh the shadow-maps as if they were deleted each frame. */
     /* TODO(fclem): fix this. */
@@ -149,17 +157,23 @@ void EEVEE_shadows_caster_register(EEVEE_ViewLayerData *sldata, Object *ob)
     EEVEE_ObjectEngineData *oedata = EEVEE_object_data_ensure(ob);
     int past_id = oedata->shadow_caster_id;
     oedata->shadow_caster_id = id;
+    /* Updated casters are drawn on top of the static shadow cache so that animated objects do
+     * not invalidate it. Moving between the two sets is an update of both. */
+    dynamic = oedata->need_update;
+    update = oedata->need_update || (oedata->shadow_dynamic != dynamic);
+    oedata->shadow_dynamic = dynamic;
     /* Update flags in backbuffer. */
     if (past_id > -1 && past_id < backbuffer->count) {
-      BLI_BITMAP_SET(backbuffer->update, past_id, oedata->need_update);
+      BLI_BITMAP_SET(backbuffer->update, past_id, update);
     }
-    update = oedata->need_update;
     oedata->need_update = false;
   }
 
   if (update) {
     BLI_BITMAP_ENABLE(frontbuffer->update, id);
   }
+  BLI_BITMAP_SET(frontbuffer->dynamic, id, dynamic);
+  frontbuffer->dynamic_count += dynamic;
 
   /* Update World AABB in frontbuffer. */
   BoundBox *bb = BKE_object_boundbox_get(ob);
@@ -200,6 +214,25 @@ static bool sphere_bbox_intersect(const BoundSphere *bs, const EEVEE_BoundBox *b
   return x && y && z;
 }
 
+/* Tag the cube shadows inside which a shadow caster was updated. */
+static void shadow_caster_tag_cubes(EEVEE_LightsInfo *linfo,
+                                    const EEVEE_BoundBox *bbox,
+                                    const bool dynamic)
+{
+  const BoundSphere *bsphere = linfo->shadow_bounds;
+  for (int j = 0; j < linfo->cube_len; j++) {
+    /* Static casters are also part of the static shadow cache. */
+    const bool tagged = dynamic ? BLI_BITMAP_TEST(linfo->sh_cube_update, j) :
+                                  BLI_BITMAP_TEST(linfo->sh_cube_static_update, j);
+    if (!tagged && sphere_bbox_intersect(&bsphere[j], bbox)) {
+      BLI_BITMAP_ENABLE(linfo->sh_cube_update, j);
+      if (!dynamic) {
+        BLI_BITMAP_ENABLE(linfo->sh_cube_static_update, j);
+      }
+    }
+  }
+}
+
 void EEVEE_shadows_update(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
 {
   EEVEE_StorageList *stl = vedata->stl;
@@ -214,6 +247,7 @@ void EEVEE_shadows_update(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
   /* Free textures if number mismatch. */
   if (linfo->num_cube_layer != linfo->cache_num_cube_layer) {
     DRW_TEXTURE_FREE_SAFE(sldata->shadow_cube_pool);
+    DRW_TEXTURE_FREE_SAFE(sldata->shadow_cube_static_pool);
     linfo->cache_num_cube_layer = linfo->num_cube_layer;
     /* Update all lights. */
     BLI_bitmap_set_all(&linfo->sh_cube_update[0], true, MAX_LIGHT);
@@ -233,6 +267,18 @@ void EEVEE_shadows_update(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
                                                            NULL);
   }
 
+  /* The static shadow cache is only needed once some shadow casters get updated. */
+  if (!sldata->shadow_cube_static_pool && frontbuffer->dynamic_count > 0 &&
+      linfo->num_cube_layer > 0) {
+    sldata->shadow_cube_static_pool = DRW_texture_create_2d_array(linfo->shadow_cube_size,
+                                                                  linfo->shadow_cube_size,
+                                                                  linfo->num_cube_layer * 6,
+                                                                  shadow_pool_format,
+                                                                  0,
+                                                                  NULL);
+    BLI_bitmap_set_all(&linfo->sh_cube_static_update[0], true, MAX_SHADOW_CUBE);
+  }
+
   if (!sldata->shadow_cascade_pool) {
     sldata->shadow_cascade_pool = DRW_texture_create_2d_array(linfo->shadow_cascade_size,
                                                               linfo->shadow_cascade_size,
@@ -245,6 +291,9 @@ void EEVEE_shadows_update(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
   if (sldata->shadow_fb == NULL) {
     sldata->shadow_fb = GPU_framebuffer_create("shadow_fb");
   }
+  if (sldata->shadow_static_fb == NULL) {
+    sldata->shadow_static_fb = GPU_framebuffer_create("shadow_static_fb");
+  }
 
   /* Gather all light own update bits. to avoid costly intersection check. */
   for (int j = 0; j < linfo->cube_len; j++) {
@@ -256,33 +305,20 @@ void EEVEE_shadows_update(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
   }
 
   /* TODO(fclem): This part can be slow, optimize it. */
-  EEVEE_BoundBox *bbox = backbuffer->bbox;
-  BoundSphere *bsphere = linfo->shadow_bounds;
   /* Search for deleted shadow casters or if shcaster WAS in shadow radius. */
   for (int i = 0; i < backbuffer->count; i++) {
     /* If the shadow-caster has been deleted or updated. */
     if (BLI_BITMAP_TEST(backbuffer->update, i)) {
-      for (int j = 0; j < linfo->cube_len; j++) {
-        if (!BLI_BITMAP_TEST(&linfo->sh_cube_update[0], j)) {
-          if (sphere_bbox_intersect(&bsphere[j], &bbox[i])) {
-            BLI_BITMAP_ENABLE(&linfo->sh_cube_update[0], j);
-          }
-        }
-      }
+      shadow_caster_tag_cubes(
+          linfo, &backbuffer->bbox[i], BLI_BITMAP_TEST(backbuffer->dynamic, i));
     }
   }
   /* Search for updates in current shadow casters. */
-  bbox = frontbuffer->bbox;
   for (int i = 0; i < frontbuffer->count; i++) {
     /* If the shadow-caster has been updated. */
     if (BLI_BITMAP_TEST(frontbuffer->update, i)) {
-      for (int j = 0; j < linfo->cube_len; j++) {
-        if (!BLI_BITMAP_TEST(&linfo->sh_cube_update[0], j)) {
-          if (sphere_bbox_intersect(&bsphere[j], &bbox[i])) {
-            BLI_BITMAP_ENABLE(&linfo->sh_cube_update[0], j);
-          }
-        }
-      }
+      shadow_caster_tag_cubes(
+          linfo, &frontbuffer->bbox[i], BLI_BITMAP_TEST(frontbuffer->dynamic, i));
     }
   }
 
@@ -296,6 +332,7 @@ void EEVEE_shadows_update(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
     frontbuffer->bbox = MEM_reallocN(frontbuffer->bbox,
                                      sizeof(EEVEE_BoundBox) * frontbuffer->alloc_count);
     BLI_BITMAP_RESIZE(frontbuffer->update, frontbuffer->alloc_count);
+    BLI_BITMAP_RESIZE(frontbuffer->dynamic, frontbuffer->alloc_count);
   }
 }
 
@@ -83,6 +83,15 @@ short select_id_get_object_select_mode(Scene *scene, Object *ob)
   return r_select_mode;
 }
 
+int select_id_draw_settings_get(const View3D *v3d, const RegionView3D *rv3d)
+{
+  int settings = 0;
+  SET_FLAG_FROM_TEST(settings, XRAY_FLAG_ENABLED(v3d), 1 << 0);
+  SET_FLAG_FROM_TEST(settings, v3d->overlay.edit_flag & V3D_OVERLAY_EDIT_FACE_DOT, 1 << 1);
+  SET_FLAG_FROM_TEST(settings, RV3D_CLIPPING_ENABLED(v3d, rv3d), 1 << 2);
+  return settings;
+}
+
 static bool check_ob_drawface_dot(short select_mode, const View3D *v3d, eDrawType dt)
 {
   if (select_mode & SCE_SELECT_FACE) {
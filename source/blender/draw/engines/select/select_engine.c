@@ -199,15 +199,18 @@ static void select_cache_init(void *vedata)
 
   /* Check if the viewport has changed. */
   float(*persmat)[4] = draw_ctx->rv3d->persmat;
-  e_data.context.is_dirty = !compare_m4m4(e_data.context.persmat, persmat, FLT_EPSILON);
+  const int draw_settings = select_id_draw_settings_get(draw_ctx->v3d, draw_ctx->rv3d);
+  e_data.context.is_dirty = !compare_m4m4(e_data.context.persmat, persmat, FLT_EPSILON) ||
+                            (e_data.context.draw_settings != draw_settings);
 
   if (!e_data.context.is_dirty) {
-    /* Check if any of the drawn objects have been transformed. */
+    /* Check if any of the drawn objects have been transformed or edited, edits can change the
+     * indices of the elements. */
     Object **ob = &e_data.context.objects_drawn[0];
     for (uint i = e_data.context.objects_drawn_len; i--; ob++) {
       DrawData *data = DRW_drawdata_get(&(*ob)->id, &draw_engine_select_type);
-      if (data && (data->recalc & ID_RECALC_TRANSFORM) != 0) {
-        data->recalc &= ~ID_RECALC_TRANSFORM;
+      if (data && (data->recalc & (ID_RECALC_TRANSFORM | ID_RECALC_GEOMETRY)) != 0) {
+        data->recalc &= ~(ID_RECALC_TRANSFORM | ID_RECALC_GEOMETRY);
         e_data.context.is_dirty = true;
       }
     }
@@ -216,6 +219,7 @@ static void select_cache_init(void *vedata)
   if (e_data.context.is_dirty) {
     /* Remove all tags from drawn or culled objects. */
     copy_m4_m4(e_data.context.persmat, persmat);
+    e_data.context.draw_settings = draw_settings;
     e_data.context.objects_drawn_len = 0;
     e_data.context.index_drawn_len = 1;
     select_engine_framebuffer_setup();
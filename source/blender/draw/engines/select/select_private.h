@@ -69,6 +69,7 @@ typedef struct SELECTID_PrivateData {
 /* select_draw_utils.c */
 void select_id_object_min_max(struct Object *obj, float r_min[3], float r_max[3]);
 short select_id_get_object_select_mode(Scene *scene, Object *ob);
+int select_id_draw_settings_get(const View3D *v3d, const RegionView3D *rv3d);
 void select_id_draw_object(void *vedata,
                            View3D *v3d,
                            Object *ob,
@@ -56,6 +56,7 @@ void workbench_engine_init(void *ved)
   workbench_private_data_alloc(stl);
   WORKBENCH_PrivateData *wpd = stl->wpd;
   workbench_private_data_init(wpd);
+  workbench_occlusion_engine_init(vedata);
   workbench_update_world_ubo(wpd);
 
   if (txl->dummy_image_tx == NULL) {
@@ -384,6 +385,10 @@ void workbench_cache_populate(void *ved, Object *ob)
     eV3DShadingColorType color_type = workbench_color_type_get(
         wpd, ob, &use_sculpt_pbvh, &use_texpaint_mode, &draw_shadow);
 
+    if (workbench_occlusion_cache_populate(wpd, ob)) {
+      return;
+    }
+
     if (use_sculpt_pbvh) {
       workbench_cache_sculpt_populate(wpd, ob, color_type);
     }
@@ -530,6 +535,8 @@ void workbench_draw_sample(void *ved)
       }
     }
 
+    workbench_occlusion_draw_pass(vedata);
+
     workbench_volume_draw_pass(vedata);
 
     if (xray_is_visible) {
@@ -627,7 +634,7 @@ DrawEngineType draw_engine_workbench = {
     &workbench_data_size,
     &workbench_engine_init,
     &workbench_engine_free,
-    NULL, /* instance_free */
+    &workbench_occlusion_instance_free,
     &workbench_cache_init,
     &workbench_cache_populate,
     &workbench_cache_finish,
@@ -0,0 +1,284 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Copyright 2021, Blender Foundation.
+ */
+
+/** \file
+ * \ingroup draw_engine
+ *
+ * Occlusion Culling:
+ *
+ * After the opaque pass, the bounding box of every object is drawn without writing to any buffer,
+ * inside an occlusion query. Objects whose query reported no visible samples are not drawn in the
+ * next redraw. The results are read one redraw later so the CPU never waits for the GPU, the
+ * drawback is that objects that become visible appear one redraw late.
+ *
+ * Objects that are not culled still have their bounding box tested each redraw, so that they get
+ * culled as soon as they are hidden.
+ */
+
+#include "workbench_private.h"
+
+#include "BLI_math.h"
+
+#include "BKE_object.h"
+
+#include "ED_view3d.h"
+
+#include "GPU_matrix.h"
+#include "GPU_query.h"
+
+#include "draw_cache.h"
+
+typedef struct WORKBENCH_OcclusionQuery {
+  /** Maps the unit cube to the bounding box of the object. */
+  float bbox_mat[4][4];
+  /** The bounding box was inside the view frustum, otherwise the result can't be used. */
+  bool in_frustum;
+  /** The object was not drawn. */
+  bool culled;
+} WORKBENCH_OcclusionQuery;
+
+typedef struct WORKBENCH_OcclusionQueryBuffer {
+  WORKBENCH_OcclusionQuery *queries;
+  int count, alloc_count;
+} WORKBENCH_OcclusionQueryBuffer;
+
+typedef struct WORKBENCH_OcclusionData {
+  /** Queries issued in the previous redraw. */
+  struct GPUQueryPool *query_pool;
+  /** Result of each query in the backbuffer, zero when the bounding box was hidden. */
+  uint32_t *results;
+  int results_len;
+  /** Queries of the current redraw. */
+  WORKBENCH_OcclusionQueryBuffer *frontbuffer;
+  /** Queries of the previous redraw. */
+  WORKBENCH_OcclusionQueryBuffer *backbuffer;
+  WORKBENCH_OcclusionQueryBuffer buffers[2];
+  /** Incremented each redraw, to know which redraw the query index of an object refers to. */
+  int redraw_id;
+} WORKBENCH_OcclusionData;
+
+#define OCCLUSION_QUERY_CHUNK_LEN 256
+
+static void workbench_occlusion_results_free(WORKBENCH_OcclusionData *odata)
+{
+  if (odata->query_pool) {
+    GPU_query_pool_discard(odata->query_pool);
+    odata->query_pool = NULL;
+  }
+  MEM_SAFE_FREE(odata->results);
+  odata->results_len = 0;
+}
+
+void workbench_occlusion_instance_free(void *instance_data)
+{
+  WORKBENCH_OcclusionData *odata = instance_data;
+  workbench_occlusion_results_free(odata);
+  MEM_SAFE_FREE(odata->buffers[0].queries);
+  MEM_SAFE_FREE(odata->buffers[1].queries);
+  MEM_freeN(odata);
+}
+
+static bool workbench_occlusion_enabled(WORKBENCH_PrivateData *wpd)
+{
+  if (!(wpd->shading.flag & V3D_SHADING_OCCLUSION_CULLING) || wpd->shading.type != OB_SOLID) {
+    return false;
+  }
+  /* Hidden objects still cast shadows and are visible in transparency mode. */
+  if (SHADOW_ENABLED(wpd) || XRAY_ENABLED(wpd)) {
+    return false;
+  }
+  /* Renders have to be exact and only draw once. */
+  if (DRW_state_is_image_render() || DRW_state_is_opengl_render() || DRW_state_is_select() ||
+      DRW_state_is_depth()) {
+    return false;
+  }
+  return true;
+}
+
+void workbench_occlusion_engine_init(WORKBENCH_Data *vedata)
+{
+  WORKBENCH_PrivateData *wpd = vedata->stl->wpd;
+  WORKBENCH_OcclusionData *odata = vedata->instance_data;
+
+  if (!workbench_occlusion_enabled(wpd)) {
+    if (odata) {
+      workbench_occlusion_instance_free(odata);
+      vedata->instance_data = NULL;
+    }
+    wpd->occlusion = NULL;
+    return;
+  }
+
+  if (odata == NULL) {
+    odata = vedata->instance_data = MEM_callocN(sizeof(*odata), __func__);
+    odata->frontbuffer = &odata->buffers[0];
+    odata->backbuffer = &odata->buffers[1];
+  }
+  wpd->occlusion = odata;
+
+  MEM_SAFE_FREE(odata->results);
+  odata->results_len = 0;
+  if (odata->query_pool) {
+    const int query_len = odata->frontbuffer->count;
+    /* Only use the results when they can be read without waiting for the GPU. */
+    if (query_len > 0 && GPU_query_pool_results_available(odata->query_pool)) {
+      odata->results = MEM_mallocN(sizeof(*odata->results) * query_len, __func__);
+      odata->results_len = query_len;
+      GPU_occlusion_query_results_get(odata->query_pool, odata->results, query_len);
+    }
+    GPU_query_pool_discard(odata->query_pool);
+    odata->query_pool = NULL;
+  }
+
+  SWAP(WORKBENCH_OcclusionQueryBuffer *, odata->frontbuffer, odata->backbuffer);
+  odata->frontbuffer->count = 0;
+  odata->redraw_id++;
+
+  /* Objects that were culled and are visible again would not get their samples accumulated. */
+  for (int i = 0; i < odata->results_len; i++) {
+    if (odata->backbuffer->queries[i].culled && odata->results[i] != 0) {
+      wpd->view_updated = true;
+      break;
+    }
+  }
+}
+
+static bool workbench_occlusion_bbox_clipped(const float persmat[4][4], const BoundBox *bbox)
+{
+  for (int i = 0; i < 8; i++) {
+    float co[4];
+    mul_v4_m4v3(co, persmat, bbox->vec[i]);
+    /* The query can't be trusted when the box intersects the near clip plane. */
+    if (co[2] < -co[3]) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool workbench_occlusion_cache_populate(WORKBENCH_PrivateData *wpd, Object *ob)
+{
+  WORKBENCH_OcclusionData *odata = wpd->occlusion;
+  if (odata == NULL) {
+    return false;
+  }
+  /* Duplis don't have persistent engine data. In front objects don't write to the main depth. */
+  if ((ob->base_flag & BASE_FROM_DUPLI) || (ob->dtx & OB_DRAW_IN_FRONT)) {
+    return false;
+  }
+  const BoundBox *bbox_local = BKE_object_boundbox_get(ob);
+  if (bbox_local == NULL) {
+    return false;
+  }
+
+  BoundBox bbox;
+  for (int i = 0; i < 8; i++) {
+    mul_v3_m4v3(bbox.vec[i], ob->obmat, bbox_local->vec[i]);
+  }
+
+  float persmat[4][4];
+  DRW_view_persmat_get(NULL, persmat, false);
+  if (workbench_occlusion_bbox_clipped(persmat, &bbox)) {
+    return false;
+  }
+
+  WORKBENCH_ObjectData *oed = (WORKBENCH_ObjectData *)DRW_drawdata_ensure(
+      &ob->id,
+      &draw_engine_workbench,
+      sizeof(WORKBENCH_ObjectData),
+      &workbench_init_object_data,
+      NULL);
+
+  bool culled = false;
+  if (oed->occlusion_owner == odata && oed->occlusion_redraw_id == odata->redraw_id - 1 &&
+      oed->occlusion_query < odata->results_len) {
+    const int query = oed->occlusion_query;
+    culled = odata->backbuffer->queries[query].in_frustum && odata->results[query] == 0;
+  }
+
+  WORKBENCH_OcclusionQueryBuffer *buffer = odata->frontbuffer;
+  if (buffer->count >= buffer->alloc_count) {
+    buffer->alloc_count += OCCLUSION_QUERY_CHUNK_LEN;
+    buffer->queries = MEM_reallocN(buffer->queries,
+                                   sizeof(*buffer->queries) * buffer->alloc_count);
+  }
+  WORKBENCH_OcclusionQuery *query = &buffer->queries[buffer->count];
+
+  float loc[3], size[3];
+  mid_v3_v3v3(loc, bbox_local->vec[0], bbox_local->vec[6]);
+  sub_v3_v3v3(size, bbox_local->vec[6], bbox_local->vec[0]);
+  mul_v3_fl(size, 0.5f);
+  /* Grow the box a bit so that it is not hidden by the surface of the object itself, which is
+   * important for flat objects. */
+  add_v3_fl(size, max_fff(size[0], size[1], size[2]) * 0.01f);
+  float bbox_mat[4][4];
+  size_to_mat4(bbox_mat, size);
+  copy_v3_v3(bbox_mat[3], loc);
+  mul_m4_m4m4(query->bbox_mat, ob->obmat, bbox_mat);
+  query->in_frustum = DRW_culling_box_test(NULL, &bbox);
+  query->culled = culled;
+
+  oed->occlusion_owner = odata;
+  oed->occlusion_redraw_id = odata->redraw_id;
+  oed->occlusion_query = buffer->count++;
+
+  return culled;
+}
+
+void workbench_occlusion_draw_pass(WORKBENCH_Data *vedata)
+{
+  WORKBENCH_PrivateData *wpd = vedata->stl->wpd;
+  WORKBENCH_OcclusionData *odata = wpd->occlusion;
+  if (odata == NULL || odata->frontbuffer->count == 0) {
+    return;
+  }
+  DefaultFramebufferList *dfbl = DRW_viewport_framebuffer_list_get();
+
+  /* Test against the depth of the opaque objects without writing anything. */
+  GPU_framebuffer_bind(dfbl->depth_only_fb);
+  DRW_state_reset_ex(DRW_STATE_DEPTH_LESS_EQUAL);
+
+  float winmat[4][4], viewmat[4][4];
+  DRW_view_winmat_get(NULL, winmat, false);
+  DRW_view_viewmat_get(NULL, viewmat, false);
+
+  struct GPUBatch *batch = DRW_cache_cube_get();
+  GPU_batch_program_set_builtin(batch, GPU_SHADER_3D_UNIFORM_COLOR);
+  GPU_batch_uniform_4f(batch, "color", 1.0f, 1.0f, 1.0f, 1.0f);
+
+  GPU_matrix_push_projection();
+  GPU_matrix_push();
+  GPU_matrix_projection_set(winmat);
+
+  odata->query_pool = GPU_occlusion_query_pool_create();
+  WORKBENCH_OcclusionQueryBuffer *buffer = odata->frontbuffer;
+  for (int i = 0; i < buffer->count; i++) {
+    float modelview[4][4];
+    mul_m4_m4m4(modelview, viewmat, buffer->queries[i].bbox_mat);
+    GPU_matrix_set(modelview);
+
+    GPU_query_begin(odata->query_pool);
+    GPU_batch_draw(batch);
+    GPU_query_end(odata->query_pool);
+  }
+
+  GPU_matrix_pop();
+  GPU_matrix_pop_projection();
+
+  DRW_state_reset();
+}
@@ -176,6 +176,8 @@ typedef struct WORKBENCH_Data {
   WORKBENCH_TextureList *txl;
   WORKBENCH_PassList *psl;
   WORKBENCH_StorageList *stl;
+  /** Owned #WORKBENCH_OcclusionData, persistent across redraws. */
+  void *instance_data;
 } WORKBENCH_Data;
 
 typedef struct WORKBENCH_UBO_Light {
@@ -360,6 +362,9 @@ typedef struct WORKBENCH_PrivateData {
   /* Camera override for rendering. */
   struct Object *cam_original_ob;
 
+  /** Occlusion culling state, NULL when disabled. */
+  struct WORKBENCH_OcclusionData *occlusion;
+
   /** True if any volume needs to be rendered. */
   bool volumes_do;
   /** Convenience boolean. */
@@ -378,6 +383,11 @@ typedef struct WORKBENCH_ObjectData {
   float shadow_min[3], shadow_max[3];
   BoundBox shadow_bbox;
   bool shadow_bbox_dirty;
+
+  /* Occlusion query of the object in the redraw it was last drawn in. */
+  const void *occlusion_owner;
+  int occlusion_redraw_id;
+  int occlusion_query;
 } WORKBENCH_ObjectData;
 
 typedef struct WORKBENCH_ViewLayerData {
@@ -424,6 +434,7 @@ void workbench_transparent_draw_depth_pass(WORKBENCH_Data *data);
 void workbench_shadow_data_update(WORKBENCH_PrivateData *wpd, WORKBENCH_UBO_World *wd);
 void workbench_shadow_cache_init(WORKBENCH_Data *data);
 void workbench_shadow_cache_populate(WORKBENCH_Data *data, Object *ob, bool has_transp_mat);
+void workbench_init_object_data(DrawData *dd);
 
 /* workbench_shader.c */
 GPUShader *workbench_shader_opaque_get(WORKBENCH_PrivateData *wpd, eWORKBENCH_DataType data);
@@ -529,6 +540,12 @@ void workbench_update_world_ubo(WORKBENCH_PrivateData *wpd);
 void workbench_update_material_ubos(WORKBENCH_PrivateData *wpd);
 struct GPUUniformBuf *workbench_material_ubo_alloc(WORKBENCH_PrivateData *wpd);
 
+/* workbench_occlusion.c */
+void workbench_occlusion_engine_init(WORKBENCH_Data *vedata);
+bool workbench_occlusion_cache_populate(WORKBENCH_PrivateData *wpd, Object *ob);
+void workbench_occlusion_draw_pass(WORKBENCH_Data *vedata);
+void workbench_occlusion_instance_free(void *instance_data);
+
 /* workbench_volume.c */
 void workbench_volume_engine_init(WORKBENCH_Data *vedata);
 void workbench_volume_cache_init(WORKBENCH_Data *vedata);
@@ -298,7 +298,7 @@ static bool workbench_shadow_camera_in_object_shadow(WORKBENCH_PrivateData *wpd,
   return true;
 }
 
-static void workbench_init_object_data(DrawData *dd)
+void workbench_init_object_data(DrawData *dd)
 {
   WORKBENCH_ObjectData *data = (WORKBENCH_ObjectData *)dd;
   data->shadow_bbox_dirty = true;
@@ -3431,6 +3431,7 @@ void drw_batch_cache_generate_requested(Object *ob)
                            DRW_object_use_hide_faces(ob)) ||
                           ((mode == CTX_MODE_EDIT_MESH) && DRW_object_is_in_edit_mode(ob))));
 
+  MEM_category_push(MEM_CATEGORY_DRAW);
   struct Mesh *mesh_eval = BKE_object_get_evaluated_mesh_no_subsurf(ob);
   switch (ob->type) {
     case OB_MESH:
@@ -3452,6 +3453,7 @@ void drw_batch_cache_generate_requested(Object *ob)
     default:
       break;
   }
+  MEM_category_pop();
 }
 
 void drw_batch_cache_generate_requested_evaluated_mesh(Object *ob)
@@ -3471,7 +3473,9 @@ void drw_batch_cache_generate_requested_evaluated_mesh(Object *ob)
                           ((mode == CTX_MODE_EDIT_MESH) && DRW_object_is_in_edit_mode(ob))));
 
   Mesh *mesh = BKE_object_get_evaluated_mesh_no_subsurf(ob);
+  MEM_category_push(MEM_CATEGORY_DRAW);
   DRW_mesh_batch_cache_create_requested(DST.task_graph, ob, mesh, scene, is_paint_mode, use_hide);
+  MEM_category_pop();
 }
 
 void drw_batch_cache_generate_requested_delayed(Object *ob)
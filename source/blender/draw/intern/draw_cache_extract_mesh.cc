@@ -439,6 +439,8 @@ static void extract_task_range_run(void *__restrict taskdata)
 {
   ExtractTaskData *data = (ExtractTaskData *)taskdata;
   const eMRIterType iter_type = data->iter_type;
+  /* Buffers are allocated in the task, on another thread than the one requesting them. */
+  MEM_CategoryScope mem_category(MEM_CATEGORY_DRAW);
   const bool is_mesh = data->mr->extract_type != MR_EXTRACT_BMESH;
 
   size_t userdata_chunk_size = data->extractors->data_size_total();
@@ -537,6 +539,7 @@ static void mesh_extract_render_data_node_exec(void *__restrict task_data)
   MeshRenderData *mr = update_task_data->mr;
   const eMRIterType iter_type = update_task_data->iter_type;
   const eMRDataType data_flag = update_task_data->data_flag;
+  MEM_CategoryScope mem_category(MEM_CATEGORY_DRAW);
 
   mesh_render_data_update_normals(mr, data_flag);
   mesh_render_data_update_looptris(mr, iter_type, data_flag);
@@ -40,6 +40,7 @@
 
 #include "BLI_hash.h"
 #include "BLI_polyfill_2d.h"
+#include "BLI_task.h"
 
 #include "draw_cache.h"
 #include "draw_cache_impl.h"
@@ -273,6 +274,9 @@ typedef struct gpIterData {
   int vert_len;
   int tri_len;
   int curve_len;
+  /** Visible strokes in drawing order, their vertices are filled in parallel. */
+  bGPDstroke **strokes;
+  int stroke_len;
 } gpIterData;
 
 static GPUVertBuf *gpencil_dummy_buffer_get(void)
@@ -393,12 +397,21 @@ static void gpencil_stroke_iter_cb(bGPDlayer *UNUSED(gpl),
                                    void *thunk)
 {
   gpIterData *iter = (gpIterData *)thunk;
-  gpencil_buffer_add_stroke(iter->verts, iter->cols, gps);
+  iter->strokes[iter->stroke_len++] = gps;
   if (gps->tot_triangles > 0) {
     gpencil_buffer_add_fill(&iter->ibo, gps);
   }
 }
 
+static void gpencil_buffer_add_stroke_fn(void *__restrict userdata,
+                                         const int i,
+                                         const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  gpIterData *iter = (gpIterData *)userdata;
+  /* Every stroke writes its own range of vertices, see #gpencil_object_verts_count_cb. */
+  gpencil_buffer_add_stroke(iter->verts, iter->cols, iter->strokes[i]);
+}
+
 static void gpencil_object_verts_count_cb(bGPDlayer *UNUSED(gpl),
                                           bGPDframe *UNUSED(gpf),
                                           bGPDstroke *gps,
@@ -411,6 +424,7 @@ static void gpencil_object_verts_count_cb(bGPDlayer *UNUSED(gpl),
   gps->runtime.fill_start = iter->tri_len;
   iter->vert_len += gps->totpoints + 2 + gpencil_stroke_is_cyclic(gps);
   iter->tri_len += gps->tot_triangles;
+  iter->stroke_len++;
 }
 
 static void gpencil_batches_ensure(Object *ob, GpencilBatchCache *cache, int cfra)
@@ -453,10 +467,19 @@ static void gpencil_batches_ensure(Object *ob, GpencilBatchCache *cache, int cfr
     /* Create IBO. */
     GPU_indexbuf_init(&iter.ibo, GPU_PRIM_TRIS, iter.tri_len, iter.vert_len);
 
-    /* Fill buffers with data. */
+    /* Fill buffers with data: the fill indices while gathering the strokes, as the index buffer
+     * is built in order, then the vertices of all strokes in parallel. */
+    iter.strokes = MEM_malloc_arrayN(max_ii(iter.stroke_len, 1), sizeof(*iter.strokes), __func__);
+    iter.stroke_len = 0;
     BKE_gpencil_visible_stroke_advanced_iter(
         NULL, ob, NULL, gpencil_stroke_iter_cb, &iter, do_onion, cfra);
 
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.min_iter_per_thread = 64;
+    BLI_task_parallel_range(0, iter.stroke_len, &iter, gpencil_buffer_add_stroke_fn, &settings);
+    MEM_freeN(iter.strokes);
+
     /* Mark last 2 verts as invalid. */
     for (int i = 0; i < 2; i++) {
       iter.verts[iter.vert_len + i].mat = -1;
@@ -25,6 +25,7 @@
 #include "BLI_alloca.h"
 #include "BLI_listbase.h"
 #include "BLI_memblock.h"
+#include "BLI_profile.h"
 #include "BLI_rect.h"
 #include "BLI_string.h"
 #include "BLI_task.h"
@@ -1113,6 +1114,7 @@ static void drw_engines_draw_scene(void)
   DRW_ENABLED_ENGINE_ITER (DST.view_data_active, engine, data) {
     PROFILE_START(stime);
     if (engine->draw_scene) {
+      BLI_PROFILE_ZONE_BEGIN(zone, "DRW draw scene", engine->idname);
       DRW_stats_group_start(engine->idname);
       engine->draw_scene(data);
       /* Restore for next engine */
@@ -1120,6 +1122,7 @@ static void drw_engines_draw_scene(void)
         GPU_framebuffer_bind(DST.default_framebuffer);
       }
       DRW_stats_group_end();
+      BLI_PROFILE_ZONE_END(zone);
     }
     PROFILE_END_UPDATE(data->render_time, stime);
   }
@@ -3032,6 +3035,8 @@ void DRW_engines_free(void)
   if (DST.draw_list) {
     GPU_draw_list_discard(DST.draw_list);
   }
+  MEM_SAFE_FREE(DST.sorted_draws);
+  DST.sorted_draws_size = 0;
 
   DRW_opengl_context_disable();
 }
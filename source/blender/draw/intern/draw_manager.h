@@ -638,6 +638,10 @@ typedef struct DRWManager {
   TicketMutex *gl_context_mutex;
 
   GPUDrawList *draw_list;
+  /** Draw calls of a shading group that are reordered to merge calls of the same batch. */
+  DRWCommandDraw *sorted_draws;
+  int sorted_draws_len;
+  int sorted_draws_size;
 
   struct {
     /* TODO(fclem): optimize: use chunks. */
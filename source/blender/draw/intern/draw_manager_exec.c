@@ -475,47 +475,86 @@ void DRW_culling_frustum_planes_get(const DRWView *view, float planes[6][4])
   memcpy(planes, view->frustum_planes, sizeof(float[6][4]));
 }
 
+/* Number of resources below which culling is not worth multi-threading. */
+#define DRW_CULLING_PARALLEL_MIN (4 * DRW_RESOURCE_CHUNK_LEN)
+
+typedef struct DRWCullingTaskData {
+  DRWView *view;
+  int resource_len;
+} DRWCullingTaskData;
+
+static void draw_compute_culling_state(DRWView *view, DRWCullingState *cull)
+{
+  if (cull->bsphere.radius < 0.0) {
+    cull->mask = 0;
+  }
+  else {
+    bool culled = !draw_culling_sphere_test(
+        &view->frustum_bsphere, view->frustum_planes, &cull->bsphere);
+
+#ifdef DRW_DEBUG_CULLING
+    if (G.debug_value != 0) {
+      if (culled) {
+        DRW_debug_sphere(
+            cull->bsphere.center, cull->bsphere.radius, (const float[4]){1, 0, 0, 1});
+      }
+      else {
+        DRW_debug_sphere(
+            cull->bsphere.center, cull->bsphere.radius, (const float[4]){0, 1, 0, 1});
+      }
+    }
+#endif
+
+    if (view->visibility_fn) {
+      culled = !view->visibility_fn(!culled, cull->user_data);
+    }
+
+    SET_FLAG_FROM_TEST(cull->mask, culled, view->culling_mask);
+  }
+}
+
+static void draw_compute_culling_chunk(void *__restrict userdata,
+                                       const int chunk,
+                                       const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const DRWCullingTaskData *data = userdata;
+  const int elem_len = min_ii(DRW_RESOURCE_CHUNK_LEN,
+                              data->resource_len - chunk * DRW_RESOURCE_CHUNK_LEN);
+  DRWCullingState *cull = BLI_memblock_elem_get(DST.vmempool->cullstates, chunk, 0);
+  /* Chunks of the memory block contain exactly one resource chunk. */
+  for (int elem = 0; elem < elem_len; elem++, cull++) {
+    draw_compute_culling_state(data->view, cull);
+  }
+}
+
 static void draw_compute_culling(DRWView *view)
 {
   view = view->parent ? view->parent : view;
 
-  /* TODO(fclem): multi-thread this. */
   /* TODO(fclem): compute all dirty views at once. */
   if (!view->is_dirty) {
     return;
   }
 
-  BLI_memblock_iter iter;
-  BLI_memblock_iternew(DST.vmempool->cullstates, &iter);
-  DRWCullingState *cull;
-  while ((cull = BLI_memblock_iterstep(&iter))) {
-    if (cull->bsphere.radius < 0.0) {
-      cull->mask = 0;
-    }
-    else {
-      bool culled = !draw_culling_sphere_test(
-          &view->frustum_bsphere, view->frustum_planes, &cull->bsphere);
+  /* Every resource handle has a culling state, the handle of the next resource is the count. */
+  DRWResourceHandle next_handle = DST.resource_handle;
+  const int resource_len = (int)(DRW_handle_chunk_get(&next_handle) * DRW_RESOURCE_CHUNK_LEN +
+                                 DRW_handle_id_get(&next_handle));
+  const int chunk_len = divide_ceil_u(resource_len, DRW_RESOURCE_CHUNK_LEN);
 
+  DRWCullingTaskData data = {
+      .view = view,
+      .resource_len = resource_len,
+  };
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  /* The visibility callback and culling debug drawing are not thread safe. */
+  settings.use_threading = (resource_len >= DRW_CULLING_PARALLEL_MIN) &&
+                           (view->visibility_fn == NULL);
 #ifdef DRW_DEBUG_CULLING
-      if (G.debug_value != 0) {
-        if (culled) {
-          DRW_debug_sphere(
-              cull->bsphere.center, cull->bsphere.radius, (const float[4]){1, 0, 0, 1});
-        }
-        else {
-          DRW_debug_sphere(
-              cull->bsphere.center, cull->bsphere.radius, (const float[4]){0, 1, 0, 1});
-        }
-      }
+  settings.use_threading = settings.use_threading && (G.debug_value == 0);
 #endif
-
-      if (view->visibility_fn) {
-        culled = !view->visibility_fn(!culled, cull->user_data);
-      }
-
-      SET_FLAG_FROM_TEST(cull->mask, culled, view->culling_mask);
-    }
-  }
+  BLI_task_parallel_range(0, chunk_len, &data, draw_compute_culling_chunk, &settings);
 
   view->is_dirty = false;
 }
@@ -898,6 +937,79 @@ static void draw_call_batching_finish(DRWShadingGroup *shgroup, DRWCommandsState
   }
 }
 
+/**
+ * Without blending and stencil, the depth test decides which fragments are visible and not the
+ * order of the draw calls (except for fragments with exactly the same depth).
+ */
+static bool draw_call_sorting_allowed(bool use_tfeedback)
+{
+  const DRWState state = DST.state;
+  const DRWState depth_test = state & DRW_STATE_DEPTH_TEST_ENABLED;
+  return !use_tfeedback && !(G.f & G_FLAG_PICKSEL) &&
+         (state & (DRW_STATE_BLEND_ENABLED | DRW_STATE_WRITE_STENCIL_ENABLED |
+                   DRW_STATE_STENCIL_TEST_ENABLED)) == 0 &&
+         !ELEM(depth_test, 0, DRW_STATE_DEPTH_ALWAYS);
+}
+
+static void draw_call_sorting_add(const DRWCommandDraw *call)
+{
+  if (DST.sorted_draws_len == DST.sorted_draws_size) {
+    DST.sorted_draws_size = max_ii(DST.sorted_draws_size * 2, 1024);
+    DST.sorted_draws = MEM_reallocN(DST.sorted_draws,
+                                    sizeof(*DST.sorted_draws) * DST.sorted_draws_size);
+  }
+  DST.sorted_draws[DST.sorted_draws_len++] = *call;
+}
+
+static int draw_call_sorting_cmp(const void *a_, const void *b_)
+{
+  const DRWCommandDraw *a = a_;
+  const DRWCommandDraw *b = b_;
+  /* Group by resource chunk and negative scale first, as changing them interrupts batching. Then
+   * by batch, so that consecutive resource ids of the same batch become a single instanced call. */
+  const uint32_t a_chunk = DRW_handle_chunk_get(&a->handle);
+  const uint32_t b_chunk = DRW_handle_chunk_get(&b->handle);
+  if (a_chunk != b_chunk) {
+    return (a_chunk < b_chunk) ? -1 : 1;
+  }
+  const uint32_t a_neg_scale = DRW_handle_negative_scale_get(&a->handle);
+  const uint32_t b_neg_scale = DRW_handle_negative_scale_get(&b->handle);
+  if (a_neg_scale != b_neg_scale) {
+    return (a_neg_scale < b_neg_scale) ? -1 : 1;
+  }
+  if (a->batch != b->batch) {
+    return ((uintptr_t)a->batch < (uintptr_t)b->batch) ? -1 : 1;
+  }
+  const uint32_t a_id = DRW_handle_id_get(&a->handle);
+  const uint32_t b_id = DRW_handle_id_get(&b->handle);
+  if (a_id != b_id) {
+    return (a_id < b_id) ? -1 : 1;
+  }
+  return 0;
+}
+
+/**
+ * Submit the draw calls gathered with #draw_call_sorting_add, ordered to make the most of the
+ * batching: calls of the same batch are merged into instanced and multi-draw-indirect calls even
+ * when they are interleaved with calls of other batches in the shading group.
+ */
+static void draw_call_sorting_flush(DRWShadingGroup *shgroup, DRWCommandsState *state)
+{
+  if (DST.sorted_draws_len == 0) {
+    return;
+  }
+  if (DST.sorted_draws_len > 2) {
+    qsort(DST.sorted_draws,
+          DST.sorted_draws_len,
+          sizeof(*DST.sorted_draws),
+          draw_call_sorting_cmp);
+  }
+  for (int i = 0; i < DST.sorted_draws_len; i++) {
+    draw_call_batching_do(shgroup, state, &DST.sorted_draws[i]);
+  }
+  DST.sorted_draws_len = 0;
+}
+
 static void draw_shgroup(DRWShadingGroup *shgroup, DRWState pass_state)
 {
   BLI_assert(shgroup->shader);
@@ -948,6 +1060,8 @@ static void draw_shgroup(DRWShadingGroup *shgroup, DRWState pass_state)
 
     draw_call_batching_start(&state);
 
+    bool use_sorting = draw_call_sorting_allowed(use_tfeedback);
+
     while ((cmd = draw_command_iter_step(&iter, &cmd_type))) {
 
       switch (cmd_type) {
@@ -966,6 +1080,11 @@ static void draw_shgroup(DRWShadingGroup *shgroup, DRWState pass_state)
           break;
       }
 
+      if (cmd_type != DRW_CMD_DRAW) {
+        /* Other commands can change the state or depend on the order of the draw calls. */
+        draw_call_sorting_flush(shgroup, &state);
+      }
+
       switch (cmd_type) {
         case DRW_CMD_CLEAR:
           GPU_framebuffer_clear(GPU_framebuffer_active_get(),
@@ -981,6 +1100,7 @@ static void draw_shgroup(DRWShadingGroup *shgroup, DRWState pass_state)
           state.drw_state_enabled |= cmd->state.enable;
           state.drw_state_disabled |= cmd->state.disable;
           drw_state_set((pass_state & ~state.drw_state_disabled) | state.drw_state_enabled);
+          use_sorting = draw_call_sorting_allowed(use_tfeedback);
           break;
         case DRW_CMD_STENCIL:
           drw_stencil_state_set(cmd->stencil.write_mask, cmd->stencil.ref, cmd->stencil.comp_mask);
@@ -995,6 +1115,9 @@ static void draw_shgroup(DRWShadingGroup *shgroup, DRWState pass_state)
             draw_call_single_do(
                 shgroup, &state, cmd->draw.batch, cmd->draw.handle, 0, 0, 0, 0, true);
           }
+          else if (use_sorting) {
+            draw_call_sorting_add(&cmd->draw);
+          }
           else {
             draw_call_batching_do(shgroup, &state, &cmd->draw);
           }
@@ -1052,6 +1175,7 @@ static void draw_shgroup(DRWShadingGroup *shgroup, DRWState pass_state)
       }
     }
 
+    draw_call_sorting_flush(shgroup, &state);
     draw_call_batching_finish(shgroup, &state);
   }
 
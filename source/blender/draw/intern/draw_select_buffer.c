@@ -476,6 +476,15 @@ void DRW_select_buffer_context_create(Base **bases, const uint bases_len, short
 {
   struct SELECTID_Context *select_ctx = DRW_select_engine_context_get();
 
+  /* Keep the ID buffer of the previous context when it was drawn for the same objects, so that
+   * repeated selections don't have to draw everything again. Changes to the view, the geometry or
+   * the transform of the objects are still detected when drawing. */
+  bool is_same_context = (select_ctx->objects_len == bases_len) &&
+                         (select_ctx->select_mode == select_mode);
+  for (uint base_index = 0; is_same_context && base_index < bases_len; base_index++) {
+    is_same_context = select_ctx->objects[base_index] == bases[base_index]->object;
+  }
+
   select_ctx->objects = MEM_reallocN(select_ctx->objects,
                                      sizeof(*select_ctx->objects) * bases_len);
 
@@ -495,7 +504,9 @@ void DRW_select_buffer_context_create(Base **bases, const uint bases_len, short
 
   select_ctx->objects_len = bases_len;
   select_ctx->select_mode = select_mode;
-  memset(select_ctx->persmat, 0, sizeof(select_ctx->persmat));
+  if (!is_same_context) {
+    memset(select_ctx->persmat, 0, sizeof(select_ctx->persmat));
+  }
 }
 
 /** \} */
@@ -23,6 +23,8 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_task.hh"
+
 #include "extract_mesh.h"
 
 #include "draw_subdivision.h"
@@ -64,20 +66,23 @@ static void extract_pos_nor_init(const MeshRenderData *mr,
   data->vbo_data = static_cast<PosNorLoop *>(GPU_vertbuf_get_data(vbo));
   data->normals = (GPUNormal *)MEM_mallocN(sizeof(GPUNormal) * mr->vert_len, __func__);
 
-  /* Quicker than doing it for each loop. */
+  /* Quicker than doing it for each loop. This runs before the loops are extracted in parallel,
+   * so it is threaded as well to not become the bottleneck for dense meshes. */
   if (mr->extract_type == MR_EXTRACT_BMESH) {
-    BMIter iter;
-    BMVert *eve;
-    int v;
-    BM_ITER_MESH_INDEX (eve, &iter, mr->bm, BM_VERTS_OF_MESH, v) {
-      data->normals[v].low = GPU_normal_convert_i10_v3(bm_vert_no_get(mr, eve));
-    }
+    threading::parallel_for(IndexRange(mr->vert_len), 4096, [&](const IndexRange range) {
+      for (const int v : range) {
+        const BMVert *eve = BM_vert_at_index(mr->bm, v);
+        data->normals[v].low = GPU_normal_convert_i10_v3(bm_vert_no_get(mr, eve));
+      }
+    });
   }
   else {
-    const MVert *mv = mr->mvert;
-    for (int v = 0; v < mr->vert_len; v++, mv++) {
-      data->normals[v].low = GPU_normal_convert_i10_s3(mv->no);
-    }
+    const MVert *mvert = mr->mvert;
+    threading::parallel_for(IndexRange(mr->vert_len), 4096, [&](const IndexRange range) {
+      for (const int v : range) {
+        data->normals[v].low = GPU_normal_convert_i10_s3(mvert[v].no);
+      }
+    });
   }
 }
 
@@ -370,20 +375,22 @@ static void extract_pos_nor_hq_init(const MeshRenderData *mr,
   data->vbo_data = static_cast<PosNorHQLoop *>(GPU_vertbuf_get_data(vbo));
   data->normals = (GPUNormal *)MEM_mallocN(sizeof(GPUNormal) * mr->vert_len, __func__);
 
-  /* Quicker than doing it for each loop. */
+  /* Quicker than doing it for each loop, see #extract_pos_nor_init. */
   if (mr->extract_type == MR_EXTRACT_BMESH) {
-    BMIter iter;
-    BMVert *eve;
-    int v;
-    BM_ITER_MESH_INDEX (eve, &iter, mr->bm, BM_VERTS_OF_MESH, v) {
-      normal_float_to_short_v3(data->normals[v].high, bm_vert_no_get(mr, eve));
-    }
+    threading::parallel_for(IndexRange(mr->vert_len), 4096, [&](const IndexRange range) {
+      for (const int v : range) {
+        const BMVert *eve = BM_vert_at_index(mr->bm, v);
+        normal_float_to_short_v3(data->normals[v].high, bm_vert_no_get(mr, eve));
+      }
+    });
   }
   else {
-    const MVert *mv = mr->mvert;
-    for (int v = 0; v < mr->vert_len; v++, mv++) {
-      copy_v3_v3_short(data->normals[v].high, mv->no);
-    }
+    const MVert *mvert = mr->mvert;
+    threading::parallel_for(IndexRange(mr->vert_len), 4096, [&](const IndexRange range) {
+      for (const int v : range) {
+        copy_v3_v3_short(data->normals[v].high, mvert[v].no);
+      }
+    });
   }
 }
 
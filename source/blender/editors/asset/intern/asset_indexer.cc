@@ -20,6 +20,7 @@
 
 #include <fstream>
 #include <iomanip>
+#include <mutex>
 #include <optional>
 
 #include "ED_asset_indexer.h"
@@ -407,6 +408,12 @@ struct AssetLibraryIndex {
    */
   Set<std::string> unused_file_indices;
 
+  /**
+   * Protects #unused_file_indices and the creation of the index folder, as indices of multiple
+   * asset files can be read and written at the same time.
+   */
+  std::mutex mutex;
+
   /**
    * \brief Absolute path where the indices of `library` are stored.
    *
@@ -489,9 +496,18 @@ struct AssetLibraryIndex {
 
   void mark_as_used(const std::string &filename)
   {
+    std::lock_guard<std::mutex> lock(mutex);
     unused_file_indices.remove(filename);
   }
 
+  bool ensure_parent_path_exists(const std::string &index_file_path)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    /* `BLI_make_existing_file` only ensures parent path, otherwise than expected from the name of
+     * the function. */
+    return BLI_make_existing_file(index_file_path.c_str());
+  }
+
   int remove_unused_index_files() const
   {
     int num_files_deleted = 0;
@@ -649,9 +665,7 @@ class AssetIndexFile : public AbstractFile {
 
   bool ensure_parent_path_exists() const
   {
-    /* `BLI_make_existing_file` only ensures parent path, otherwise than expected from the name of
-     * the function. */
-    return BLI_make_existing_file(get_file_path());
+    return library_index.ensure_parent_path_exists(filename);
   }
 
   void write_contents(AssetIndex &content)
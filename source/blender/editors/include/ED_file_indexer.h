@@ -120,6 +120,9 @@ typedef struct FileIndexerType {
    * entries field, `r_read_entries_len` must be set to `0` and the function must return
    * `eFileIndexerResult::FILE_INDEXER_NEEDS_UPDATE`. In this case the blend file will read from
    * the blend file and the `update_index` function will be called.
+   *
+   * Can be called from multiple threads at the same time (for different files), with the same
+   * `user_data`.
    */
   FileIndexerReadIndexFunc read_index;
 
@@ -129,6 +132,9 @@ typedef struct FileIndexerType {
    * Is called after reading entries from the file when the result of `read_index` was
    * `eFileIndexerResult::FILE_INDEXER_NEED_UPDATE`. The callback should update the index so the
    * next time that read_index is called it will read the entries from the index.
+   *
+   * Can be called from multiple threads at the same time (for different files), with the same
+   * `user_data`.
    */
   FileIndexerUpdateIndexFunc update_index;
 } FileIndexerType;
@@ -136,6 +136,11 @@ struct MemFile *ED_undosys_stack_memfile_get_active(struct UndoStack *ustack);
  * (currently we only do that in #MemFileWriteData when writing a new step).
  */
 void ED_undosys_stack_memfile_id_changed_tag(struct UndoStack *ustack, struct ID *id);
+/**
+ * Wait until the memory of freed memfile undo steps has been released (freeing happens in a
+ * background task). Must be called before exiting, after the undo stacks have been freed.
+ */
+void ED_undosys_memfile_free_wait(void);
 
 #ifdef __cplusplus
 }
@@ -239,7 +239,8 @@ void WM_OT_usd_export(struct wmOperatorType *ot)
                   "use_instancing",
                   false,
                   "Instancing",
-                  "When checked, instanced objects are exported as references in USD. "
+                  "When checked, instanced objects are exported as references in USD, and "
+                  "geometry node instances of objects as point instancers. "
                   "When unchecked, instanced objects are exported as real objects");
 
   RNA_def_enum(ot->srna,
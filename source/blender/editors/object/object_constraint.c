@@ -1374,7 +1374,7 @@ void ED_object_constraint_dependency_update(Main *bmain, Object *ob)
   if (ob->pose) {
     object_pose_tag_update(bmain, ob);
   }
-  DEG_relations_tag_update(bmain);
+  DEG_relations_tag_update_for_id(bmain, &ob->id);
 }
 
 void ED_object_constraint_tag_update(Main *bmain, Object *ob, bConstraint *con)
@@ -1407,7 +1407,7 @@ void ED_object_constraint_dependency_tag_update(Main *bmain, Object *ob, bConstr
   if (ob->pose) {
     object_pose_tag_update(bmain, ob);
   }
-  DEG_relations_tag_update(bmain);
+  DEG_relations_tag_update_for_id(bmain, &ob->id);
 }
 
 bool ED_object_constraint_move_to_index(Object *ob, bConstraint *con, const int index)
@@ -1480,7 +1480,7 @@ static int constraint_delete_exec(bContext *C, wmOperator *op)
     ED_object_constraint_update(bmain, ob);
 
     /* relations */
-    DEG_relations_tag_update(bmain);
+    DEG_relations_tag_update_for_id(bmain, &ob->id);
 
     /* notifiers */
     WM_event_add_notifier(C, NC_OBJECT | ND_CONSTRAINT | NA_REMOVED, ob);
@@ -1564,7 +1564,7 @@ static int constraint_apply_exec(bContext *C, wmOperator *op)
   /* Needed to set the flags on posebones correctly. */
   ED_object_constraint_update(bmain, ob);
 
-  DEG_relations_tag_update(bmain);
+  DEG_relations_tag_update_for_id(bmain, &ob->id);
   WM_event_add_notifier(C, NC_OBJECT | ND_CONSTRAINT | NA_REMOVED, ob);
   if (pchan) {
     WM_event_add_notifier(C, NC_OBJECT | ND_POSE, ob);
@@ -1659,7 +1659,7 @@ static int constraint_copy_exec(bContext *C, wmOperator *op)
   /* Needed to set the flags on posebones correctly. */
   ED_object_constraint_update(bmain, ob);
 
-  DEG_relations_tag_update(bmain);
+  DEG_relations_tag_update_for_id(bmain, &ob->id);
   WM_event_add_notifier(C, NC_OBJECT | ND_CONSTRAINT | NA_ADDED, ob);
 
   if (RNA_boolean_get(op->ptr, "report")) {
@@ -156,6 +156,14 @@ struct OGLRender {
   ThreadMutex task_mutex;
   ThreadCondition task_condition;
 
+  /**
+   * Frames of mono movies are written from the viewport buffer directly, instead of copying it
+   * into a duplicate of the render result first. The render result is still updated for display.
+   */
+  bool use_direct_movie_write;
+  /** Viewport buffer of the current frame, owned by the write task once scheduled. */
+  ImBuf *movie_ibuf;
+
 #ifdef DEBUG_TIME
   double time_start;
 #endif
@@ -428,7 +436,15 @@ static void screen_opengl_render_doit(const bContext *C, OGLRender *oglrender, R
       BKE_image_stamp_buf(scene, camera, nullptr, rect, rectf, rr->rectx, rr->recty, 4);
     }
     RE_render_result_rect_from_ibuf(rr, &scene->r, ibuf_result, oglrender->view_id);
-    IMB_freeImBuf(ibuf_result);
+    if (oglrender->use_direct_movie_write) {
+      BLI_assert(oglrender->movie_ibuf == nullptr);
+      /* Float factor for random dither, the movie writer takes care of it. */
+      ibuf_result->dither = scene->r.dither_intensity;
+      oglrender->movie_ibuf = ibuf_result;
+    }
+    else {
+      IMB_freeImBuf(ibuf_result);
+    }
   }
 }
 
@@ -878,6 +894,15 @@ static bool screen_opengl_render_init(bContext *C, wmOperator *op)
   BLI_mutex_init(&oglrender->task_mutex);
   BLI_condition_init(&oglrender->task_condition);
 
+  /* Frames which are not rendered re-use the render result of the previous frame, and the
+   * sequencer, stereo and gray-scale output need the render result for their conversions. */
+  oglrender->use_direct_movie_write = is_animation &&
+                                      BKE_imtype_is_movie(scene->r.im_format.imtype) &&
+                                      !is_sequencer && !is_render_keyed_only &&
+                                      oglrender->views_len == 1 &&
+                                      scene->r.im_format.planes != R_IMF_PLANES_BW;
+  oglrender->movie_ibuf = nullptr;
+
 #ifdef DEBUG_TIME
   oglrender->time_start = PIL_check_seconds_timer();
 #endif
@@ -920,6 +945,10 @@ static void screen_opengl_render_end(bContext *C, OGLRender *oglrender)
 
   MEM_SAFE_FREE(oglrender->render_frames);
 
+  if (oglrender->movie_ibuf) {
+    IMB_freeImBuf(oglrender->movie_ibuf);
+  }
+
   if (oglrender->mh) {
     if (BKE_imtype_is_movie(scene->r.im_format.imtype)) {
       for (i = 0; i < oglrender->totvideos; i++) {
@@ -1025,22 +1054,55 @@ static bool screen_opengl_render_anim_init(bContext *C, wmOperator *op)
 }
 
 struct WriteTaskData {
+  /** Either the render result or the viewport buffer of the frame is written. */
   RenderResult *rr;
+  ImBuf *ibuf;
   Scene tmp_scene;
 };
 
+static void free_write_task_result(WriteTaskData *task_data)
+{
+  if (task_data->rr) {
+    RE_FreeRenderResult(task_data->rr);
+  }
+  if (task_data->ibuf) {
+    IMB_freeImBuf(task_data->ibuf);
+  }
+}
+
+/* Write the viewport buffer to the movie without going through the render result. */
+static bool write_movie_ibuf(OGLRender *oglrender, ReportList *reports, Scene *scene, ImBuf *ibuf)
+{
+  /* The buffer is owned by the task, convert it in place. */
+  IMB_colormanagement_imbuf_for_write(
+      ibuf, true, false, &scene->view_settings, &scene->display_settings, &scene->r.im_format);
+
+  const bool ok = oglrender->mh->append_movie(oglrender->movie_ctx_arr[0],
+                                              &scene->r,
+                                              PRVRANGEON ? scene->r.psfra : scene->r.sfra,
+                                              scene->r.cfra,
+                                              (int *)ibuf->rect,
+                                              ibuf->x,
+                                              ibuf->y,
+                                              "",
+                                              reports);
+  printf("Append frame %d\n", scene->r.cfra);
+  return ok;
+}
+
 static void write_result_func(TaskPool *__restrict pool, void *task_data_v)
 {
   OGLRender *oglrender = (OGLRender *)BLI_task_pool_user_data(pool);
   WriteTaskData *task_data = (WriteTaskData *)task_data_v;
   Scene *scene = &task_data->tmp_scene;
   RenderResult *rr = task_data->rr;
+  ImBuf *ibuf = task_data->ibuf;
   const bool is_movie = BKE_imtype_is_movie(scene->r.im_format.imtype);
   const int cfra = scene->r.cfra;
   bool ok;
   /* Don't attempt to write if we've got an error. */
   if (!oglrender->pool_ok) {
-    RE_FreeRenderResult(rr);
+    free_write_task_result(task_data);
     BLI_mutex_lock(&oglrender->task_mutex);
     oglrender->num_scheduled_frames--;
     BLI_condition_notify_all(&oglrender->task_condition);
@@ -1058,7 +1120,10 @@ static void write_result_func(TaskPool *__restrict pool, void *task_data_v)
    * This is because underlying calls do not use r.cfra but use scene
    * for that.
    */
-  if (is_movie) {
+  if (ibuf) {
+    ok = write_movie_ibuf(oglrender, &reports, scene, ibuf);
+  }
+  else if (is_movie) {
     ok = RE_WriteRenderViewsMovie(&reports,
                                   rr,
                                   scene,
@@ -1099,22 +1164,28 @@ static void write_result_func(TaskPool *__restrict pool, void *task_data_v)
   if (!ok) {
     oglrender->pool_ok = false;
   }
-  RE_FreeRenderResult(rr);
+  free_write_task_result(task_data);
   BLI_mutex_lock(&oglrender->task_mutex);
   oglrender->num_scheduled_frames--;
   BLI_condition_notify_all(&oglrender->task_condition);
   BLI_mutex_unlock(&oglrender->task_mutex);
 }
 
-static bool schedule_write_result(OGLRender *oglrender, RenderResult *rr)
+static bool schedule_write_result(OGLRender *oglrender, RenderResult *rr, ImBuf *ibuf)
 {
   if (!oglrender->pool_ok) {
-    RE_FreeRenderResult(rr);
+    if (rr) {
+      RE_FreeRenderResult(rr);
+    }
+    if (ibuf) {
+      IMB_freeImBuf(ibuf);
+    }
     return false;
   }
   Scene *scene = oglrender->scene;
   WriteTaskData *task_data = MEM_new<WriteTaskData>("write task data");
   task_data->rr = rr;
+  task_data->ibuf = ibuf;
   task_data->tmp_scene = *scene;
   BLI_mutex_lock(&oglrender->task_mutex);
   oglrender->num_scheduled_frames++;
@@ -1192,12 +1263,16 @@ static bool screen_opengl_render_anim_step(bContext *C, wmOperator *op)
   }
 
   /* save to disk */
-  rr = RE_AcquireResultRead(oglrender->re);
-  {
+  if (oglrender->movie_ibuf) {
+    ok = schedule_write_result(oglrender, nullptr, oglrender->movie_ibuf);
+    oglrender->movie_ibuf = nullptr;
+  }
+  else {
+    rr = RE_AcquireResultRead(oglrender->re);
     RenderResult *new_rr = RE_DuplicateRenderResult(rr);
     RE_ReleaseResult(oglrender->re);
 
-    ok = schedule_write_result(oglrender, new_rr);
+    ok = schedule_write_result(oglrender, new_rr, nullptr);
   }
 
 finally: /* Step the frame and bail early if needed */
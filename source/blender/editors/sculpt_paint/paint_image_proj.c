@@ -404,8 +404,6 @@ typedef struct ProjPaintState {
   ListBase *vertSeams;
 #endif
 
-  SpinLock *tile_lock;
-
   Mesh *me_eval;
   int totlooptri_eval;
   int totloop_eval;
@@ -486,7 +484,6 @@ typedef struct ProjPixelClone {
 
 /* undo tile pushing */
 typedef struct {
-  SpinLock *lock;
   bool masked;
   ushort tile_width;
   ImBuf **tmpibuf;
@@ -1805,18 +1802,12 @@ static int project_paint_undo_subtiles(const TileInfo *tinf, int tx, int ty)
   int tile_index = tx + ty * tinf->tile_width;
   bool generate_tile = false;
 
-  /* double check lock to avoid locking */
+  /* The thread that swaps the empty tile for #TILE_PENDING generates it,
+   * other threads wait for it to be published. */
   if (UNLIKELY(!pjIma->undoRect[tile_index])) {
-    if (tinf->lock) {
-      BLI_spin_lock(tinf->lock);
-    }
-    if (LIKELY(!pjIma->undoRect[tile_index])) {
-      pjIma->undoRect[tile_index] = TILE_PENDING;
+    if (atomic_cas_ptr((void **)&pjIma->undoRect[tile_index], NULL, TILE_PENDING) == NULL) {
       generate_tile = true;
     }
-    if (tinf->lock) {
-      BLI_spin_unlock(tinf->lock);
-    }
   }
 
   if (generate_tile) {
@@ -1851,13 +1842,7 @@ static int project_paint_undo_subtiles(const TileInfo *tinf, int tx, int ty)
 
     BKE_image_mark_dirty(pjIma->ima, pjIma->ibuf);
     /* tile ready, publish */
-    if (tinf->lock) {
-      BLI_spin_lock(tinf->lock);
-    }
-    pjIma->undoRect[tile_index] = undorect;
-    if (tinf->lock) {
-      BLI_spin_unlock(tinf->lock);
-    }
+    atomic_cas_ptr((void **)&pjIma->undoRect[tile_index], TILE_PENDING, (void *)undorect);
   }
 
   return tile_index;
@@ -2980,7 +2965,6 @@ static void project_paint_face_init(const ProjPaintState *ps,
   bool threaded = (ps->thread_tot > 1);
 
   TileInfo tinf = {
-      ps->tile_lock,
       ps->do_masking,
       ED_IMAGE_UNDO_TILE_NUMBER(ibuf->x),
       tmpibuf,
@@ -3940,11 +3924,6 @@ static void proj_paint_state_thread_init(ProjPaintState *ps, const bool reset_th
   }
 
   if (ps->is_shared_user == false) {
-    if (ps->thread_tot > 1) {
-      ps->tile_lock = MEM_mallocN(sizeof(SpinLock), "projpaint_tile_lock");
-      BLI_spin_init(ps->tile_lock);
-    }
-
     ED_image_paint_tile_lock_init();
   }
 
@@ -4608,11 +4587,6 @@ static void project_paint_end(ProjPaintState *ps)
     if (ps->do_layer_clone) {
       MEM_freeN((void *)ps->poly_to_loop_uv_clone);
     }
-    if (ps->thread_tot > 1) {
-      BLI_spin_end(ps->tile_lock);
-      MEM_freeN((void *)ps->tile_lock);
-    }
-
     ED_image_paint_tile_lock_end();
 
 #ifndef PROJ_DEBUG_NOSEAMBLEED
@@ -2346,15 +2346,11 @@ static float brush_strength(const Sculpt *sd,
   }
 }
 
-float SCULPT_brush_strength_factor(SculptSession *ss,
-                                   const Brush *br,
-                                   const float brush_point[3],
-                                   const float len,
-                                   const short vno[3],
-                                   const float fno[3],
-                                   const float mask,
-                                   const int vertex_index,
-                                   const int thread_id)
+/* Strength of the brush texture at `brush_point`. */
+static float sculpt_brush_texture_strength(SculptSession *ss,
+                                           const Brush *br,
+                                           const float brush_point[3],
+                                           const int thread_id)
 {
   StrokeCache *cache = ss->cache;
   const Scene *scene = cache->vc->scene;
@@ -2415,20 +2411,39 @@ float SCULPT_brush_strength_factor(SculptSession *ss,
     }
   }
 
-  /* Hardness. */
-  float final_len = len;
+  return avg;
+}
+
+/* Distance to evaluate the falloff curve at, taking the brush hardness into account. */
+BLI_INLINE float sculpt_brush_hardness_len(const StrokeCache *cache, const float len)
+{
   const float hardness = cache->paint_brush.hardness;
   float p = len / cache->radius;
   if (p < hardness) {
-    final_len = 0.0f;
+    return 0.0f;
   }
-  else if (hardness == 1.0f) {
-    final_len = cache->radius;
-  }
-  else {
-    p = (p - hardness) / (1.0f - hardness);
-    final_len = p * cache->radius;
+  if (hardness == 1.0f) {
+    return cache->radius;
   }
+  p = (p - hardness) / (1.0f - hardness);
+  return p * cache->radius;
+}
+
+float SCULPT_brush_strength_factor(SculptSession *ss,
+                                   const Brush *br,
+                                   const float brush_point[3],
+                                   const float len,
+                                   const short vno[3],
+                                   const float fno[3],
+                                   const float mask,
+                                   const int vertex_index,
+                                   const int thread_id)
+{
+  StrokeCache *cache = ss->cache;
+  float avg = sculpt_brush_texture_strength(ss, br, brush_point, thread_id);
+
+  /* Hardness. */
+  const float final_len = sculpt_brush_hardness_len(cache, len);
 
   /* Falloff curve. */
   avg *= BKE_brush_curve_strength(br, final_len, cache->radius);
@@ -2443,6 +2458,63 @@ float SCULPT_brush_strength_factor(SculptSession *ss,
   return avg;
 }
 
+void SCULPT_brush_strength_factors_calc(SculptSession *ss,
+                                        const Brush *br,
+                                        SculptBrushVertBlock *block,
+                                        const int thread_id)
+{
+  StrokeCache *cache = ss->cache;
+  AutomaskingCache *automasking = cache->automasking;
+  const int len = block->len;
+  float *factor = block->factor;
+  float curve_len[SCULPT_BRUSH_VERT_BLOCK_SIZE];
+  float curve[SCULPT_BRUSH_VERT_BLOCK_SIZE];
+
+  /* Texture. */
+  if (br->mtex.tex) {
+    for (int i = 0; i < len; i++) {
+      factor[i] = sculpt_brush_texture_strength(ss, br, block->co[i], thread_id);
+    }
+  }
+  else {
+    for (int i = 0; i < len; i++) {
+      factor[i] = 1.0f;
+    }
+  }
+
+  /* Hardness and falloff curve. */
+  for (int i = 0; i < len; i++) {
+    curve_len[i] = sculpt_brush_hardness_len(cache, block->dist[i]);
+  }
+  BKE_brush_curve_strength_array(br, curve_len, len, cache->radius, curve);
+  for (int i = 0; i < len; i++) {
+    factor[i] *= curve[i];
+  }
+
+  if (br->flag & BRUSH_FRONTFACE) {
+    for (int i = 0; i < len; i++) {
+      factor[i] *= frontface(br, cache->view_normal, block->no[i], block->fno[i]);
+    }
+  }
+
+  /* Paint mask. */
+  for (int i = 0; i < len; i++) {
+    factor[i] *= 1.0f - block->mask[i];
+  }
+
+  /* Auto-masking. */
+  if (automasking && automasking->factor) {
+    for (int i = 0; i < len; i++) {
+      factor[i] *= automasking->factor[block->vertex_index[i]];
+    }
+  }
+  else if (automasking) {
+    for (int i = 0; i < len; i++) {
+      factor[i] *= SCULPT_automasking_factor_get(automasking, ss, block->vertex_index[i]);
+    }
+  }
+}
+
 bool SCULPT_search_sphere_cb(PBVHNode *node, void *data_v)
 {
   SculptSearchSphereData *data = data_v;
@@ -297,6 +297,26 @@ static void sculpt_project_v3_normal_align(SculptSession *ss,
 /** \name Sculpt Draw Brush
  * \{ */
 
+/* Offset the vertices of the block, the block is emptied. */
+static void do_draw_brush_block_apply(SculptSession *ss,
+                                      const Brush *brush,
+                                      SculptBrushVertBlock *block,
+                                      const float offset[3],
+                                      float (*proxy)[3],
+                                      const int thread_id)
+{
+  SCULPT_brush_strength_factors_calc(ss, brush, block, thread_id);
+
+  for (int i = 0; i < block->len; i++) {
+    mul_v3_v3fl(proxy[block->node_index[i]], offset, block->factor[i]);
+
+    if (block->mvert[i]) {
+      block->mvert[i]->flag |= ME_VERT_PBVH_UPDATE;
+    }
+  }
+  block->len = 0;
+}
+
 static void do_draw_brush_task_cb_ex(void *__restrict userdata,
                                      const int n,
                                      const TaskParallelTLS *__restrict tls)
@@ -316,28 +336,23 @@ static void do_draw_brush_task_cb_ex(void *__restrict userdata,
       ss, &test, data->brush->falloff_shape);
   const int thread_id = BLI_task_parallel_thread_id(tls);
 
+  /* Gather the vertices inside of the brush, their strength is computed a block at a time. */
+  SculptBrushVertBlock block;
+  block.len = 0;
+
   BKE_pbvh_vertex_iter_begin (ss->pbvh, data->nodes[n], vd, PBVH_ITER_UNIQUE) {
     if (!sculpt_brush_test_sq_fn(&test, vd.co)) {
       continue;
     }
-    /* Offset vertex. */
-    const float fade = SCULPT_brush_strength_factor(ss,
-                                                    brush,
-                                                    vd.co,
-                                                    sqrtf(test.dist),
-                                                    vd.no,
-                                                    vd.fno,
-                                                    vd.mask ? *vd.mask : 0.0f,
-                                                    vd.index,
-                                                    thread_id);
-
-    mul_v3_v3fl(proxy[vd.i], offset, fade);
-
-    if (vd.mvert) {
-      vd.mvert->flag |= ME_VERT_PBVH_UPDATE;
+    if (SCULPT_brush_vert_block_add(&block, &vd, sqrtf(test.dist))) {
+      do_draw_brush_block_apply(ss, brush, &block, offset, proxy, thread_id);
     }
   }
   BKE_pbvh_vertex_iter_end;
+
+  if (block.len) {
+    do_draw_brush_block_apply(ss, brush, &block, offset, proxy, thread_id);
+  }
 }
 
 void SCULPT_do_draw_brush(Sculpt *sd, Object *ob, PBVHNode **nodes, int totnode)
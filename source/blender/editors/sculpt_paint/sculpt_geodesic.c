@@ -72,15 +72,21 @@
 
 #include "bmesh.h"
 
+#include "atomic_ops.h"
+
 #include <math.h>
 #include <stdlib.h>
 #define SCULPT_GEODESIC_VERTEX_NONE -1
 
 /* Propagate distance from v1 and v2 to v0. */
-static bool sculpt_geodesic_mesh_test_dist_add(
-    MVert *mvert, const int v0, const int v1, const int v2, float *dists, GSet *initial_vertices)
+static bool sculpt_geodesic_mesh_test_dist_add(MVert *mvert,
+                                               const int v0,
+                                               const int v1,
+                                               const int v2,
+                                               float *dists,
+                                               const BLI_bitmap *initial_vertex)
 {
-  if (BLI_gset_haskey(initial_vertices, POINTER_FROM_INT(v0))) {
+  if (BLI_BITMAP_TEST(initial_vertex, v0)) {
     return false;
   }
 
@@ -112,6 +118,29 @@ static bool sculpt_geodesic_mesh_test_dist_add(
   return false;
 }
 
+typedef struct GeodesicAffectedVertexData {
+  const MVert *verts;
+  const int *initial_vertices;
+  int initial_vertices_len;
+  float limit_radius_sq;
+  BLI_bitmap *affected_vertex;
+} GeodesicAffectedVertexData;
+
+static void sculpt_geodesic_affected_vertex_task_cb(void *__restrict userdata,
+                                                    const int i,
+                                                    const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  GeodesicAffectedVertexData *data = userdata;
+  for (int j = 0; j < data->initial_vertices_len; j++) {
+    const float *v_co = data->verts[data->initial_vertices[j]].co;
+    if (len_squared_v3v3(v_co, data->verts[i].co) <= data->limit_radius_sq) {
+      /* Neighbor vertices share bitmap blocks with other threads. */
+      (void)BLI_BITMAP_TEST_AND_SET_ATOMIC(data->affected_vertex, i);
+      break;
+    }
+  }
+}
+
 static float *SCULPT_geodesic_mesh_create(Object *ob,
                                           GSet *initial_vertices,
                                           const float limit_radius)
@@ -152,19 +181,25 @@ static float *SCULPT_geodesic_mesh_create(Object *ob,
   BLI_LINKSTACK_INIT(queue);
   BLI_LINKSTACK_INIT(queue_next);
 
-  for (int i = 0; i < totvert; i++) {
-    if (BLI_gset_haskey(initial_vertices, POINTER_FROM_INT(i))) {
-      dists[i] = 0.0f;
-    }
-    else {
-      dists[i] = FLT_MAX;
-    }
+  /* Tag the initial vertices once, instead of looking them up in the set for every test. */
+  BLI_bitmap *initial_vertex = BLI_BITMAP_NEW(totvert, "initial vertex");
+  int *initial_vertices_array = MEM_malloc_arrayN(
+      BLI_gset_len(initial_vertices), sizeof(int), "initial vertices");
+  int initial_vertices_len = 0;
+
+  copy_vn_fl(dists, totvert, FLT_MAX);
+
+  GSetIterator gs_iter;
+  GSET_ITER (gs_iter, initial_vertices) {
+    const int v = POINTER_AS_INT(BLI_gsetIterator_getKey(&gs_iter));
+    dists[v] = 0.0f;
+    BLI_BITMAP_ENABLE(initial_vertex, v);
+    initial_vertices_array[initial_vertices_len++] = v;
   }
 
   /* Masks vertices that are further than limit radius from an initial vertex. As there is no need
    * to define a distance to them the algorithm can stop earlier by skipping them. */
   BLI_bitmap *affected_vertex = BLI_BITMAP_NEW(totvert, "affected vertex");
-  GSetIterator gs_iter;
 
   if (limit_radius == FLT_MAX) {
     /* In this case, no need to loop through all initial vertices to check distances as they are
@@ -175,15 +210,17 @@ static float *SCULPT_geodesic_mesh_create(Object *ob,
     /* This is an O(n^2) loop used to limit the geodesic distance calculation to a radius. When
      * this optimization is needed, it is expected for the tool to request the distance to a low
      * number of vertices (usually just 1 or 2). */
-    GSET_ITER (gs_iter, initial_vertices) {
-      const int v = POINTER_AS_INT(BLI_gsetIterator_getKey(&gs_iter));
-      float *v_co = verts[v].co;
-      for (int i = 0; i < totvert; i++) {
-        if (len_squared_v3v3(v_co, verts[i].co) <= limit_radius_sq) {
-          BLI_BITMAP_ENABLE(affected_vertex, i);
-        }
-      }
-    }
+    GeodesicAffectedVertexData data = {
+        .verts = verts,
+        .initial_vertices = initial_vertices_array,
+        .initial_vertices_len = initial_vertices_len,
+        .limit_radius_sq = limit_radius_sq,
+        .affected_vertex = affected_vertex,
+    };
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.min_iter_per_thread = 4096;
+    BLI_task_parallel_range(0, totvert, &data, sculpt_geodesic_affected_vertex_task_cb, &settings);
   }
 
   /* Add edges adjacent to an initial vertex to the queue. */
@@ -209,7 +246,7 @@ static float *SCULPT_geodesic_mesh_create(Object *ob,
           SWAP(int, v1, v2);
         }
         sculpt_geodesic_mesh_test_dist_add(
-            verts, v2, v1, SCULPT_GEODESIC_VERTEX_NONE, dists, initial_vertices);
+            verts, v2, v1, SCULPT_GEODESIC_VERTEX_NONE, dists, initial_vertex);
       }
 
       if (ss->epmap[e].count != 0) {
@@ -227,7 +264,7 @@ static float *SCULPT_geodesic_mesh_create(Object *ob,
               continue;
             }
             if (sculpt_geodesic_mesh_test_dist_add(
-                    verts, v_other, v1, v2, dists, initial_vertices)) {
+                    verts, v_other, v1, v2, dists, initial_vertex)) {
               for (int edge_map_index = 0; edge_map_index < ss->vemap[v_other].count;
                    edge_map_index++) {
                 const int e_other = ss->vemap[v_other].indices[edge_map_index];
@@ -267,6 +304,8 @@ static float *SCULPT_geodesic_mesh_create(Object *ob,
   BLI_LINKSTACK_FREE(queue_next);
   MEM_SAFE_FREE(edge_tag);
   MEM_SAFE_FREE(affected_vertex);
+  MEM_SAFE_FREE(initial_vertex);
+  MEM_SAFE_FREE(initial_vertices_array);
 
   return dists;
 }
@@ -767,6 +767,12 @@ typedef struct SculptUndoNode {
   /* Sculpt Face Sets */
   int *face_sets;
 
+  /* The arrays above are moved here once the undo step is finished, they are null then except
+   * while the step is restored. */
+  struct {
+    struct BArrayState *co, *orig_co, *col, *mask, *index;
+  } store;
+
   size_t undo_size;
 } SculptUndoNode;
 
@@ -973,6 +979,60 @@ float SCULPT_brush_strength_factor(struct SculptSession *ss,
                                    int vertex_index,
                                    int thread_id);
 
+/** Number of vertices gathered in a #SculptBrushVertBlock. */
+#define SCULPT_BRUSH_VERT_BLOCK_SIZE 64
+
+/**
+ * Vertices inside of the brush gathered while iterating over a node, so the strength factors of
+ * all of them are computed in one go with #SCULPT_brush_strength_factors_calc, one stage of the
+ * factor at a time instead of one vertex at a time.
+ */
+typedef struct SculptBrushVertBlock {
+  int len;
+  float co[SCULPT_BRUSH_VERT_BLOCK_SIZE][3];
+  float dist[SCULPT_BRUSH_VERT_BLOCK_SIZE];
+  float mask[SCULPT_BRUSH_VERT_BLOCK_SIZE];
+  const short *no[SCULPT_BRUSH_VERT_BLOCK_SIZE];
+  const float *fno[SCULPT_BRUSH_VERT_BLOCK_SIZE];
+  int vertex_index[SCULPT_BRUSH_VERT_BLOCK_SIZE];
+  /** Index of the vertex in the node (#PBVHVertexIter.i), used to write the proxies. */
+  int node_index[SCULPT_BRUSH_VERT_BLOCK_SIZE];
+  struct MVert *mvert[SCULPT_BRUSH_VERT_BLOCK_SIZE];
+  /** Result of #SCULPT_brush_strength_factors_calc. */
+  float factor[SCULPT_BRUSH_VERT_BLOCK_SIZE];
+} SculptBrushVertBlock;
+
+/**
+ * Add the current vertex of `vd` at distance `dist` from the brush to the block.
+ * \return true when the block is full.
+ */
+BLI_INLINE bool SCULPT_brush_vert_block_add(SculptBrushVertBlock *block,
+                                            const PBVHVertexIter *vd,
+                                            const float dist)
+{
+  const int i = block->len++;
+  block->co[i][0] = vd->co[0];
+  block->co[i][1] = vd->co[1];
+  block->co[i][2] = vd->co[2];
+  block->dist[i] = dist;
+  block->mask[i] = vd->mask ? *vd->mask : 0.0f;
+  block->no[i] = vd->no;
+  block->fno[i] = vd->fno;
+  block->vertex_index[i] = vd->index;
+  block->node_index[i] = vd->i;
+  block->mvert[i] = vd->mvert;
+  return block->len == SCULPT_BRUSH_VERT_BLOCK_SIZE;
+}
+
+/**
+ * Compute #SculptBrushVertBlock.factor for all vertices of the block,
+ * the same as #SCULPT_brush_strength_factor gives for each of them.
+ */
+void SCULPT_brush_strength_factors_calc(struct SculptSession *ss,
+                                        const struct Brush *br,
+                                        SculptBrushVertBlock *block,
+                                        int thread_id);
+
 /**
  * Tilts a normal by the x and y tilt values using the view axis.
  */
@@ -70,6 +70,17 @@
 #include "bmesh.h"
 #include "sculpt_intern.h"
 
+#define USE_ARRAY_STORE
+
+#ifdef USE_ARRAY_STORE
+#  include "BLI_array_store.h"
+#  include "BLI_array_store_utils.h"
+/* Number of elements per chunk, strokes usually only change parts of the arrays of a node. */
+#  define ARRAY_CHUNK_SIZE 128
+
+#  define USE_ARRAY_STORE_THREAD
+#endif
+
 /* Implementation of undo system for objects in sculpt mode.
  *
  * Each undo step in sculpt mode consists of list of nodes, each node contains:
@@ -113,6 +124,11 @@ typedef struct UndoSculpt {
   ListBase nodes;
 
   size_t undo_size;
+
+#ifdef USE_ARRAY_STORE
+  /** The arrays of the nodes have been moved into the array store. */
+  bool use_array_store;
+#endif
 } UndoSculpt;
 
 static UndoSculpt *sculpt_undo_get_nodes(void);
@@ -1426,6 +1442,210 @@ void SCULPT_undo_push_end_ex(const bool use_nested_undo)
   }
 }
 
+#ifdef USE_ARRAY_STORE
+
+/* -------------------------------------------------------------------- */
+/** \name Array Store
+ *
+ * Once an undo step is finished, the arrays of its nodes are moved into an array store which
+ * de-duplicates them against the same nodes of the previous step, so only the chunks that a
+ * stroke changed take extra memory. This runs in a background task, the arrays are expanded
+ * again while the step is undone or redone.
+ * \{ */
+
+static struct {
+  struct BArrayStore_AtSize bs_stride;
+  /** Number of undo steps using the array store. */
+  int users;
+
+#  ifdef USE_ARRAY_STORE_THREAD
+  TaskPool *task_pool;
+#  endif
+
+} sculpt_arraystore = {{NULL}};
+
+typedef struct SculptUndoStoreArray {
+  void **data;
+  BArrayState **state;
+  int stride;
+} SculptUndoStoreArray;
+
+#  define SCULPT_UNDO_STORE_ARRAYS_NUM 5
+
+static void sculpt_undo_node_store_arrays(SculptUndoNode *unode,
+                                          SculptUndoStoreArray r_arrays[])
+{
+  r_arrays[0] = (SculptUndoStoreArray){
+      (void **)&unode->co, &unode->store.co, (int)sizeof(*unode->co)};
+  r_arrays[1] = (SculptUndoStoreArray){
+      (void **)&unode->orig_co, &unode->store.orig_co, (int)sizeof(*unode->orig_co)};
+  r_arrays[2] = (SculptUndoStoreArray){
+      (void **)&unode->col, &unode->store.col, (int)sizeof(*unode->col)};
+  r_arrays[3] = (SculptUndoStoreArray){
+      (void **)&unode->mask, &unode->store.mask, (int)sizeof(*unode->mask)};
+  r_arrays[4] = (SculptUndoStoreArray){
+      (void **)&unode->index, &unode->store.index, (int)sizeof(*unode->index)};
+}
+
+static void sculpt_arraystore_wait(void)
+{
+#  ifdef USE_ARRAY_STORE_THREAD
+  /* Changes this waits is low, but must have finished. */
+  if (sculpt_arraystore.task_pool) {
+    BLI_task_pool_work_and_wait(sculpt_arraystore.task_pool);
+  }
+#  endif
+}
+
+/**
+ * Move the arrays of the nodes in \a lb into the array store and free them.
+ * Nodes which have been expanded use their previous states as reference,
+ * others use the node of the same PBVH node in \a lb_ref (can be NULL).
+ */
+static void sculpt_arraystore_compact(ListBase *lb, ListBase *lb_ref)
+{
+  GHash *node_ref_map = NULL;
+  if (lb_ref) {
+    /* Only used as keys, the PBVH nodes might not exist anymore. */
+    node_ref_map = BLI_ghash_ptr_new(__func__);
+    LISTBASE_FOREACH (SculptUndoNode *, unode_ref, lb_ref) {
+      if (unode_ref->node) {
+        void **val_p;
+        if (!BLI_ghash_ensure_p(node_ref_map, unode_ref->node, &val_p)) {
+          *val_p = unode_ref;
+        }
+      }
+    }
+  }
+
+  LISTBASE_FOREACH (SculptUndoNode *, unode, lb) {
+    SculptUndoNode *unode_ref = NULL;
+    if (node_ref_map && unode->node) {
+      unode_ref = BLI_ghash_lookup(node_ref_map, unode->node);
+      if (unode_ref && ((unode_ref->type != unode->type) ||
+                        (unode_ref->totvert != unode->totvert))) {
+        unode_ref = NULL;
+      }
+    }
+
+    SculptUndoStoreArray arrays[SCULPT_UNDO_STORE_ARRAYS_NUM];
+    SculptUndoStoreArray arrays_ref[SCULPT_UNDO_STORE_ARRAYS_NUM];
+    sculpt_undo_node_store_arrays(unode, arrays);
+    if (unode_ref) {
+      sculpt_undo_node_store_arrays(unode_ref, arrays_ref);
+    }
+
+    for (int i = 0; i < SCULPT_UNDO_STORE_ARRAYS_NUM; i++) {
+      void *data = *arrays[i].data;
+      if (data == NULL) {
+        continue;
+      }
+      BArrayStore *bs = BLI_array_store_at_size_ensure(
+          &sculpt_arraystore.bs_stride, arrays[i].stride, ARRAY_CHUNK_SIZE);
+      BArrayState *state_prev = *arrays[i].state;
+      const BArrayState *state_ref = state_prev;
+      if (state_ref == NULL && unode_ref) {
+        state_ref = *arrays_ref[i].state;
+      }
+
+      *arrays[i].state = BLI_array_store_state_add(bs, data, MEM_allocN_len(data), state_ref);
+      if (state_prev) {
+        BLI_array_store_state_remove(bs, state_prev);
+      }
+      MEM_freeN(data);
+      *arrays[i].data = NULL;
+    }
+  }
+
+  if (node_ref_map) {
+    BLI_ghash_free(node_ref_map, NULL, NULL);
+  }
+}
+
+#  ifdef USE_ARRAY_STORE_THREAD
+
+struct SculptArrayStoreData {
+  ListBase *lb;
+  ListBase *lb_ref; /* can be NULL */
+};
+
+static void sculpt_arraystore_compact_cb(TaskPool *__restrict UNUSED(pool), void *taskdata)
+{
+  struct SculptArrayStoreData *data = taskdata;
+  sculpt_arraystore_compact(data->lb, data->lb_ref);
+}
+
+#  endif /* USE_ARRAY_STORE_THREAD */
+
+static void sculpt_arraystore_compact_push(ListBase *lb, ListBase *lb_ref)
+{
+#  ifdef USE_ARRAY_STORE_THREAD
+  if (sculpt_arraystore.task_pool == NULL) {
+    sculpt_arraystore.task_pool = BLI_task_pool_create_background(NULL, TASK_PRIORITY_LOW);
+  }
+
+  struct SculptArrayStoreData *data = MEM_mallocN(sizeof(*data), __func__);
+  data->lb = lb;
+  data->lb_ref = lb_ref;
+
+  BLI_task_pool_push(sculpt_arraystore.task_pool, sculpt_arraystore_compact_cb, data, true, NULL);
+#  else
+  sculpt_arraystore_compact(lb, lb_ref);
+#  endif
+}
+
+/**
+ * Allocate the arrays of the nodes from their states again,
+ * the states are kept until the nodes are compacted again.
+ */
+static void sculpt_arraystore_expand(ListBase *lb)
+{
+  LISTBASE_FOREACH (SculptUndoNode *, unode, lb) {
+    SculptUndoStoreArray arrays[SCULPT_UNDO_STORE_ARRAYS_NUM];
+    sculpt_undo_node_store_arrays(unode, arrays);
+    for (int i = 0; i < SCULPT_UNDO_STORE_ARRAYS_NUM; i++) {
+      if (*arrays[i].state) {
+        BLI_assert(*arrays[i].data == NULL);
+        size_t data_len;
+        *arrays[i].data = BLI_array_store_state_data_get_alloc(*arrays[i].state, &data_len);
+      }
+    }
+  }
+}
+
+static void sculpt_arraystore_free(ListBase *lb)
+{
+  LISTBASE_FOREACH (SculptUndoNode *, unode, lb) {
+    SculptUndoStoreArray arrays[SCULPT_UNDO_STORE_ARRAYS_NUM];
+    sculpt_undo_node_store_arrays(unode, arrays);
+    for (int i = 0; i < SCULPT_UNDO_STORE_ARRAYS_NUM; i++) {
+      if (*arrays[i].state) {
+        BArrayStore *bs = BLI_array_store_at_size_get(&sculpt_arraystore.bs_stride,
+                                                      arrays[i].stride);
+        BLI_array_store_state_remove(bs, *arrays[i].state);
+        *arrays[i].state = NULL;
+      }
+    }
+  }
+
+  sculpt_arraystore.users -= 1;
+
+  BLI_assert(sculpt_arraystore.users >= 0);
+
+  if (sculpt_arraystore.users == 0) {
+    BLI_array_store_at_size_clear(&sculpt_arraystore.bs_stride);
+
+#  ifdef USE_ARRAY_STORE_THREAD
+    BLI_task_pool_free(sculpt_arraystore.task_pool);
+    sculpt_arraystore.task_pool = NULL;
+#  endif
+  }
+}
+
+/** \} */
+
+#endif /* USE_ARRAY_STORE */
+
 /* -------------------------------------------------------------------- */
 /** \name Implements ED Undo System
  * \{ */
@@ -1460,17 +1680,57 @@ static bool sculpt_undosys_step_encode(struct bContext *UNUSED(C),
 
   if (!BLI_listbase_is_empty(&us->data.nodes)) {
     bmain->is_memfile_undo_flush_needed = true;
+
+#ifdef USE_ARRAY_STORE
+    /* De-duplicate against the previous sculpt step, this step isn't in the stack yet. */
+    UndoStack *ustack = ED_undo_stack_get();
+    SculptUndoStep *us_ref = NULL;
+    for (UndoStep *us_iter = ustack->steps.last; us_iter; us_iter = us_iter->prev) {
+      if (us_iter->type == BKE_UNDOSYS_TYPE_SCULPT) {
+        if (((SculptUndoStep *)us_iter)->data.use_array_store) {
+          us_ref = (SculptUndoStep *)us_iter;
+        }
+        break;
+      }
+    }
+
+    sculpt_arraystore_wait();
+    us->data.use_array_store = true;
+    sculpt_arraystore.users += 1;
+    sculpt_arraystore_compact_push(&us->data.nodes, us_ref ? &us_ref->data.nodes : NULL);
+#endif
   }
 
   return true;
 }
 
+static void sculpt_undosys_step_restore_list(struct bContext *C,
+                                             Depsgraph *depsgraph,
+                                             SculptUndoStep *us)
+{
+#ifdef USE_ARRAY_STORE
+  if (us->data.use_array_store) {
+    sculpt_arraystore_wait();
+    sculpt_arraystore_expand(&us->data.nodes);
+  }
+#endif
+
+  sculpt_undo_restore_list(C, depsgraph, &us->data.nodes);
+
+#ifdef USE_ARRAY_STORE
+  if (us->data.use_array_store) {
+    /* Restoring swaps the stored data with the current state, for the opposite direction. */
+    sculpt_arraystore_compact_push(&us->data.nodes, NULL);
+  }
+#endif
+}
+
 static void sculpt_undosys_step_decode_undo_impl(struct bContext *C,
                                                  Depsgraph *depsgraph,
                                                  SculptUndoStep *us)
 {
   BLI_assert(us->step.is_applied == true);
-  sculpt_undo_restore_list(C, depsgraph, &us->data.nodes);
+  sculpt_undosys_step_restore_list(C, depsgraph, us);
   us->step.is_applied = false;
 }
 
@@ -1479,7 +1739,7 @@ static void sculpt_undosys_step_decode_redo_impl(struct bContext *C,
                                                  SculptUndoStep *us)
 {
   BLI_assert(us->step.is_applied == false);
-  sculpt_undo_restore_list(C, depsgraph, &us->data.nodes);
+  sculpt_undosys_step_restore_list(C, depsgraph, us);
   us->step.is_applied = true;
 }
 
@@ -1583,6 +1843,12 @@ static void sculpt_undosys_step_decode(
 static void sculpt_undosys_step_free(UndoStep *us_p)
 {
   SculptUndoStep *us = (SculptUndoStep *)us_p;
+#ifdef USE_ARRAY_STORE
+  if (us->data.use_array_store) {
+    sculpt_arraystore_wait();
+    sculpt_arraystore_free(&us->data.nodes);
+  }
+#endif
   sculpt_undo_free_list(&us->data.nodes);
 }
 
@@ -3018,6 +3018,11 @@ static uint64_t groupname_to_filter_id(const char *group)
 typedef struct TodoDir {
   int level;
   char *dir;
+
+  /** Entries of the library at `dir`, read ahead by #filelist_readjob_list_libs_prefetch. */
+  ListBase lib_entries;
+  int lib_entries_len;
+  bool is_lib_prefetched;
 } TodoDir;
 
 static int filelist_readjob_list_dir(const char *root,
@@ -3591,6 +3596,80 @@ static bool filelist_readjob_should_recurse_into_entry(const int max_recursion,
   return true;
 }
 
+static ListLibOptions filelist_readjob_list_lib_options(const FileList *filelist,
+                                                        const bool skip_currpar)
+{
+  ListLibOptions list_lib_options = 0;
+  if (!skip_currpar) {
+    list_lib_options |= LIST_LIB_ADD_PARENT;
+  }
+
+  /* Libraries are loaded recursively when max_recursion is set. It doesn't check if there is
+   * still a recursion level over. */
+  if (filelist->max_recursion > 0) {
+    list_lib_options |= LIST_LIB_RECURSIVE;
+  }
+  /* Only load assets when browsing an asset library. For normal file browsing we return all
+   * entries. `FLF_ASSETS_ONLY` filter can be enabled/disabled by the user.*/
+  if (filelist->asset_library_ref) {
+    list_lib_options |= LIST_LIB_ASSETS_ONLY;
+  }
+  return list_lib_options;
+}
+
+typedef struct FileListReadLibsPrefetchData {
+  TodoDir **todo_dirs;
+  ListLibOptions options;
+  FileIndexer *indexer_runtime;
+  const short *stop;
+} FileListReadLibsPrefetchData;
+
+static void filelist_readjob_list_libs_prefetch_task(void *__restrict userdata,
+                                                     const int i,
+                                                     const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  FileListReadLibsPrefetchData *data = userdata;
+  if (*data->stop) {
+    return;
+  }
+  TodoDir *td_dir = data->todo_dirs[i];
+  td_dir->lib_entries_len = filelist_readjob_list_lib(
+      td_dir->dir, &td_dir->lib_entries, data->options, data->indexer_runtime);
+  td_dir->is_lib_prefetched = true;
+}
+
+/**
+ * Read the libraries among `todo_dirs` in parallel, so the files of a directory containing many
+ * blend files (e.g. an asset library) are opened and parsed concurrently instead of one after the
+ * other. Directories that aren't libraries are still listed when they are popped from the stack.
+ *
+ * The callbacks of the indexer are called from multiple threads.
+ */
+static void filelist_readjob_list_libs_prefetch(TodoDir **todo_dirs,
+                                                const int todo_dirs_len,
+                                                const ListLibOptions options,
+                                                FileIndexer *indexer_runtime,
+                                                const short *stop)
+{
+  if (todo_dirs_len < 2) {
+    /* Nothing to gain, read when popped from the stack. */
+    return;
+  }
+
+  FileListReadLibsPrefetchData data = {
+      .todo_dirs = todo_dirs,
+      .options = options,
+      .indexer_runtime = indexer_runtime,
+      .stop = stop,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1;
+  BLI_task_parallel_range(
+      0, todo_dirs_len, &data, filelist_readjob_list_libs_prefetch_task, &settings);
+}
+
 static void filelist_readjob_recursive_dir_add_items(const bool do_lib,
                                                      FileListReadJob *job_params,
                                                      const short *stop,
@@ -3609,6 +3688,7 @@ static void filelist_readjob_recursive_dir_add_items(const bool do_lib,
 
   todo_dirs = BLI_stack_new(sizeof(*td_dir), __func__);
   td_dir = BLI_stack_push_r(todo_dirs);
+  memset(td_dir, 0, sizeof(*td_dir));
   td_dir->level = 1;
 
   BLI_strncpy(dir, filelist->filelist.root, sizeof(dir));
@@ -3637,8 +3717,6 @@ static void filelist_readjob_recursive_dir_add_items(const bool do_lib,
     recursion_level = td_dir->level;
     skip_currpar = (recursion_level > 1);
 
-    BLI_stack_discard(todo_dirs);
-
     /* ARRRG! We have to be very careful *not to use* common BLI_path_util helpers over
      * entry->relpath itself (nor any path containing it), since it may actually be a datablock
      * name inside .blend file, which can have slashes and backslashes! See T46827.
@@ -3649,22 +3727,14 @@ static void filelist_readjob_recursive_dir_add_items(const bool do_lib,
     BLI_path_rel(rel_subdir, root);
 
     bool is_lib = false;
-    if (do_lib) {
-      ListLibOptions list_lib_options = 0;
-      if (!skip_currpar) {
-        list_lib_options |= LIST_LIB_ADD_PARENT;
-      }
-
-      /* Libraries are loaded recursively when max_recursion is set. It doesn't check if there is
-       * still a recursion level over. */
-      if (max_recursion > 0) {
-        list_lib_options |= LIST_LIB_RECURSIVE;
-      }
-      /* Only load assets when browsing an asset library. For normal file browsing we return all
-       * entries. `FLF_ASSETS_ONLY` filter can be enabled/disabled by the user.*/
-      if (filelist->asset_library_ref) {
-        list_lib_options |= LIST_LIB_ASSETS_ONLY;
-      }
+    if (td_dir->is_lib_prefetched) {
+      entries = td_dir->lib_entries;
+      nbr_entries = td_dir->lib_entries_len;
+      is_lib = nbr_entries > 0;
+    }
+    else if (do_lib) {
+      const ListLibOptions list_lib_options = filelist_readjob_list_lib_options(filelist,
+                                                                                skip_currpar);
       nbr_entries = filelist_readjob_list_lib(
           subdir, &entries, list_lib_options, &indexer_runtime);
       if (nbr_entries > 0) {
@@ -3672,11 +3742,21 @@ static void filelist_readjob_recursive_dir_add_items(const bool do_lib,
       }
     }
 
+    BLI_stack_discard(todo_dirs);
+
     if (!is_lib) {
       nbr_entries = filelist_readjob_list_dir(
           subdir, &entries, filter_glob, do_lib, job_params->main_name, skip_currpar);
     }
 
+    /* Sub-directories added to `todo_dirs` by this iteration, see
+     * #filelist_readjob_list_libs_prefetch. */
+    TodoDir **new_todo_dirs = NULL;
+    int new_todo_dirs_len = 0;
+    if (do_lib && nbr_entries > 0) {
+      new_todo_dirs = MEM_malloc_arrayN(nbr_entries, sizeof(*new_todo_dirs), __func__);
+    }
+
     for (entry = entries.first; entry; entry = entry->next) {
       entry->uid = filelist_uid_generate(filelist);
 
@@ -3695,14 +3775,27 @@ static void filelist_readjob_recursive_dir_add_items(const bool do_lib,
         BLI_join_dirfile(dir, sizeof(dir), root, entry->relpath);
         BLI_path_normalize_dir(job_params->main_name, dir);
         td_dir = BLI_stack_push_r(todo_dirs);
+        memset(td_dir, 0, sizeof(*td_dir));
         td_dir->level = recursion_level + 1;
         td_dir->dir = BLI_strdup(dir);
         nbr_todo_dirs++;
+        if (new_todo_dirs) {
+          new_todo_dirs[new_todo_dirs_len++] = td_dir;
+        }
       }
     }
 
     filelist_readjob_append_entries(job_params, &entries, nbr_entries, do_update);
 
+    if (new_todo_dirs) {
+      filelist_readjob_list_libs_prefetch(new_todo_dirs,
+                                          new_todo_dirs_len,
+                                          filelist_readjob_list_lib_options(filelist, true),
+                                          &indexer_runtime,
+                                          stop);
+      MEM_freeN(new_todo_dirs);
+    }
+
     nbr_done_dirs++;
     *progress = (float)nbr_done_dirs / (float)nbr_todo_dirs;
     MEM_freeN(subdir);
@@ -3722,6 +3815,9 @@ static void filelist_readjob_recursive_dir_add_items(const bool do_lib,
   while (!BLI_stack_is_empty(todo_dirs)) {
     td_dir = BLI_stack_peek(todo_dirs);
     MEM_freeN(td_dir->dir);
+    LISTBASE_FOREACH_MUTABLE (FileListInternEntry *, lib_entry, &td_dir->lib_entries) {
+      filelist_intern_entry_free(lib_entry);
+    }
     BLI_stack_discard(todo_dirs);
   }
   BLI_stack_free(todo_dirs);
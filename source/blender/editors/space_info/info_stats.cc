@@ -637,7 +637,7 @@ static const char *info_statusbar_string(Main *bmain,
 {
   char formatted_mem[15];
   size_t ofs = 0;
-  static char info[256];
+  static char info[512];
   int len = sizeof(info);
 
   info[0] = '\0';
@@ -658,6 +658,27 @@ static const char *info_statusbar_string(Main *bmain,
     uintptr_t mem_in_use = MEM_get_memory_in_use();
     BLI_str_format_byte_unit(formatted_mem, mem_in_use, false);
     ofs += BLI_snprintf_rlen(info + ofs, len, TIP_("Memory: %s"), formatted_mem);
+
+    /* Only the categories holding a noticeable amount, to keep the status bar short. */
+    bool is_first_category = true;
+    for (int i = MEM_CATEGORY_NONE + 1; i < MEM_CATEGORY_NUM; i++) {
+      const eMEM_Category category = (eMEM_Category)i;
+      const size_t category_mem_in_use = MEM_get_category_memory_in_use(category);
+      if (category_mem_in_use < 1024 * 1024) {
+        continue;
+      }
+      BLI_str_format_byte_unit(formatted_mem, category_mem_in_use, false);
+      ofs += BLI_snprintf_rlen(info + ofs,
+                               len - ofs,
+                               "%s%s: %s",
+                               is_first_category ? " (" : ", ",
+                               IFACE_(MEM_category_name(category)),
+                               formatted_mem);
+      is_first_category = false;
+    }
+    if (!is_first_category) {
+      ofs += BLI_snprintf_rlen(info + ofs, len - ofs, ")");
+    }
   }
 
   /* GPU VRAM status. */
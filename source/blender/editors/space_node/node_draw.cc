@@ -40,6 +40,7 @@
 #include "BLI_map.hh"
 #include "BLI_set.hh"
 #include "BLI_span.hh"
+#include "BLI_string.h"
 #include "BLI_string_ref.hh"
 #include "BLI_vector.hh"
 #include "BLI_vector_set.hh"
@@ -81,6 +82,10 @@
 
 #include "RNA_access.h"
 
+#ifdef WITH_COMPOSITOR
+#  include "COM_compositor.h"
+#endif
+
 #include "NOD_geometry_nodes_eval_log.hh"
 #include "NOD_node_declaration.hh"
 
@@ -1591,18 +1596,8 @@ static std::chrono::microseconds node_get_execution_time(const bNodeTree &ntree,
   return exec_time;
 }
 
-static std::string node_get_execution_time_label(const SpaceNode &snode, const bNode &node)
+static std::string execution_time_label(const uint64_t exec_time_us)
 {
-  int node_count = 0;
-  std::chrono::microseconds exec_time = node_get_execution_time(
-      *snode.nodetree, node, snode, node_count);
-
-  if (node_count == 0) {
-    return std::string("");
-  }
-
-  uint64_t exec_time_us = exec_time.count();
-
   /* Don't show time if execution time is 0 microseconds. */
   if (exec_time_us == 0) {
     return std::string("-");
@@ -1625,12 +1620,58 @@ static std::string node_get_execution_time_label(const SpaceNode &snode, const b
   return stream.str() + " ms";
 }
 
+static std::string node_get_execution_time_label(const SpaceNode &snode, const bNode &node)
+{
+  int node_count = 0;
+  std::chrono::microseconds exec_time = node_get_execution_time(
+      *snode.nodetree, node, snode, node_count);
+
+  if (node_count == 0) {
+    return std::string("");
+  }
+
+  return execution_time_label(exec_time.count());
+}
+
 struct NodeExtraInfoRow {
   std::string text;
   const char *tooltip;
   int icon;
 };
 
+#ifdef WITH_COMPOSITOR
+static void node_get_compositor_extra_info(const SpaceNode &snode,
+                                           const bNode &node,
+                                           Vector<NodeExtraInfoRow> &rows)
+{
+  const bNodeTreePath *path = (const bNodeTreePath *)snode.treepath.last;
+  const bNodeInstanceKey key = BKE_node_instance_key(path->parent_key, snode.edittree, &node);
+  double execution_time;
+  size_t allocated_bytes;
+  if (!COM_get_node_profile(key, &execution_time, &allocated_bytes)) {
+    return;
+  }
+
+  NodeExtraInfoRow time_row;
+  time_row.text = execution_time_label((uint64_t)(execution_time * 1e6));
+  time_row.tooltip = TIP_("The execution time from the compositor's latest execution");
+  time_row.icon = ICON_PREVIEW_RANGE;
+  rows.append(std::move(time_row));
+
+  if (allocated_bytes > 0) {
+    char memory_str[15];
+    BLI_str_format_byte_unit(memory_str, allocated_bytes, false);
+    NodeExtraInfoRow memory_row;
+    memory_row.text = memory_str;
+    memory_row.tooltip = TIP_(
+        "The memory of the buffers allocated for the node's results in the compositor's latest "
+        "execution");
+    memory_row.icon = ICON_MEMORY;
+    rows.append(std::move(memory_row));
+  }
+}
+#endif
+
 static Vector<NodeExtraInfoRow> node_get_extra_info(const SpaceNode &snode, const bNode &node)
 {
   Vector<NodeExtraInfoRow> rows;
@@ -1651,6 +1692,12 @@ static Vector<NodeExtraInfoRow> node_get_extra_info(const SpaceNode &snode, cons
       rows.append(std::move(row));
     }
   }
+#ifdef WITH_COMPOSITOR
+  if (snode.overlay.flag & SN_OVERLAY_SHOW_TIMINGS && snode.edittree->type == NTREE_COMPOSIT &&
+      !ELEM(node.type, NODE_FRAME, NODE_GROUP, NODE_GROUP_INPUT, NODE_GROUP_OUTPUT)) {
+    node_get_compositor_extra_info(snode, node, rows);
+  }
+#endif
   const geo_log::NodeLog *node_log = geo_log::ModifierLog::find_node_by_node_editor_context(snode,
                                                                                             node);
   if (node_log != nullptr) {
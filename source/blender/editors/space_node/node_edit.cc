@@ -31,6 +31,9 @@
 #include "DNA_text_types.h"
 #include "DNA_world_types.h"
 
+#include "BLI_math_vector.h"
+#include "BLI_rect.h"
+
 #include "BKE_context.h"
 #include "BKE_global.h"
 #include "BKE_image.h"
@@ -41,6 +44,7 @@
 #include "BKE_node_tree_update.h"
 #include "BKE_report.h"
 #include "BKE_scene.h"
+#include "BKE_screen.h"
 #include "BKE_workspace.h"
 
 #include "DEG_depsgraph.h"
@@ -95,6 +99,9 @@ struct CompoJob {
   ViewLayer *view_layer;
   bNodeTree *ntree;
   int recalc_flags;
+  /* Normalized area of the viewer image displayed in node editors backdrop. */
+  rctf viewer_visible_area;
+  bool use_viewer_visible_area;
   /* Evaluated state/ */
   Depsgraph *compositor_depsgraph;
   bNodeTree *localtree;
@@ -176,6 +183,125 @@ static int compo_get_recalc_flags(const bContext *C)
   return recalc_flags;
 }
 
+/* Part of the viewer image around the displayed backdrop which is computed too, relative to the
+ * size of the displayed part. Avoids compositing again for small view changes. */
+#define COMPO_BACKDROP_MARGIN 0.25f
+
+/* Normalized area of the backdrop image displayed in the region, clipped to the image. Returns
+ * false when no part of the image is displayed. */
+static bool compo_backdrop_displayed_area(const SpaceNode &snode,
+                                          const ARegion &region,
+                                          const int backdrop_size[2],
+                                          const float margin,
+                                          rctf *r_area)
+{
+  const float bufx = backdrop_size[0] * snode.zoom;
+  const float bufy = backdrop_size[1] * snode.zoom;
+  if (bufx <= 0.0f || bufy <= 0.0f) {
+    return false;
+  }
+
+  rctf area;
+  area.xmin = (-0.5f * region.winx - snode.xof) / bufx + 0.5f;
+  area.xmax = (0.5f * region.winx - snode.xof) / bufx + 0.5f;
+  area.ymin = (-0.5f * region.winy - snode.yof) / bufy + 0.5f;
+  area.ymax = (0.5f * region.winy - snode.yof) / bufy + 0.5f;
+  BLI_rctf_pad(&area, BLI_rctf_size_x(&area) * margin, BLI_rctf_size_y(&area) * margin);
+
+  rctf image_area;
+  BLI_rctf_init(&image_area, 0.0f, 1.0f, 0.0f, 1.0f);
+  return BLI_rctf_isect(&area, &image_area, r_area);
+}
+
+/* Find the part of the viewer image displayed in all node editors backdrop and remember it as
+ * composited area. Returns false when the whole image must be computed, when it is displayed
+ * elsewhere or not at all. */
+static bool compo_get_viewer_visible_area(const bContext *C, rctf *r_area)
+{
+  Main *bmain = CTX_data_main(C);
+  wmWindowManager *wm = CTX_wm_manager(C);
+
+  void *lock;
+  Image *ima = BKE_image_ensure_viewer(bmain, IMA_TYPE_COMPOSITE, "Viewer Node");
+  ImBuf *ibuf = BKE_image_acquire_ibuf(ima, nullptr, &lock);
+  int backdrop_size[2] = {0, 0};
+  if (ibuf) {
+    backdrop_size[0] = ibuf->x;
+    backdrop_size[1] = ibuf->y;
+  }
+  BKE_image_release_ibuf(ima, ibuf, lock);
+
+  /* Image size is only known once the viewer was computed. */
+  bool use_visible_area = (backdrop_size[0] > 0 && backdrop_size[1] > 0);
+  bool has_backdrop = false;
+  BLI_rctf_init(r_area, 0.0f, 0.0f, 0.0f, 0.0f);
+
+  LISTBASE_FOREACH (wmWindow *, win, &wm->windows) {
+    const bScreen *screen = WM_window_get_active_screen(win);
+
+    LISTBASE_FOREACH (ScrArea *, area, &screen->areabase) {
+      if (area->spacetype == SPACE_IMAGE) {
+        const SpaceImage *sima = (const SpaceImage *)area->spacedata.first;
+        if (sima->image && sima->image->type == IMA_TYPE_COMPOSITE) {
+          use_visible_area = false;
+        }
+      }
+      else if (area->spacetype == SPACE_NODE) {
+        SpaceNode *snode = (SpaceNode *)area->spacedata.first;
+        const ARegion *region = BKE_area_find_region_type(area, RGN_TYPE_WINDOW);
+        rctf displayed_area;
+        if ((snode->flag & SNODE_BACKDRAW) && ED_node_is_compositor(snode) && region) {
+          has_backdrop = true;
+          if (compo_backdrop_displayed_area(
+                  *snode, *region, backdrop_size, COMPO_BACKDROP_MARGIN, &displayed_area)) {
+            if (BLI_rctf_is_empty(r_area)) {
+              *r_area = displayed_area;
+            }
+            else {
+              BLI_rctf_union(r_area, &displayed_area);
+            }
+          }
+        }
+      }
+    }
+  }
+
+  use_visible_area = use_visible_area && has_backdrop;
+
+  LISTBASE_FOREACH (wmWindow *, win, &wm->windows) {
+    const bScreen *screen = WM_window_get_active_screen(win);
+
+    LISTBASE_FOREACH (ScrArea *, area, &screen->areabase) {
+      if (area->spacetype == SPACE_NODE) {
+        SpaceNode *snode = (SpaceNode *)area->spacedata.first;
+        if (use_visible_area) {
+          snode->runtime->backdrop_composited_area = *r_area;
+        }
+        else {
+          BLI_rctf_init(&snode->runtime->backdrop_composited_area, 0.0f, 1.0f, 0.0f, 1.0f);
+        }
+        copy_v2_v2_int(snode->runtime->backdrop_size, backdrop_size);
+      }
+    }
+  }
+
+  return use_visible_area;
+}
+
+bool node_backdrop_needs_compositing(SpaceNode &snode, const ARegion &region)
+{
+  if (!(snode.flag & SNODE_BACKDRAW) || !ED_node_is_compositor(&snode)) {
+    return false;
+  }
+
+  rctf displayed_area;
+  if (!compo_backdrop_displayed_area(
+          snode, region, snode.runtime->backdrop_size, 0.0f, &displayed_area)) {
+    return false;
+  }
+  return !BLI_rctf_inside_rctf(&snode.runtime->backdrop_composited_area, &displayed_area);
+}
+
 /* called by compo, only to check job 'stop' value */
 static int compo_breakjob(void *cjv)
 {
@@ -297,7 +423,8 @@ static void compo_startjob(void *cjv,
                           true,
                           &scene->view_settings,
                           &scene->display_settings,
-                          "");
+                          "",
+                          cj->use_viewer_visible_area ? &cj->viewer_visible_area : nullptr);
   }
   else {
     LISTBASE_FOREACH (SceneRenderView *, srv, &scene->r.views) {
@@ -311,7 +438,8 @@ static void compo_startjob(void *cjv,
                             true,
                             &scene->view_settings,
                             &scene->display_settings,
-                            srv->name);
+                            srv->name,
+                            cj->use_viewer_visible_area ? &cj->viewer_visible_area : nullptr);
     }
   }
 
@@ -352,6 +480,7 @@ void ED_node_composite_job(const bContext *C, struct bNodeTree *nodetree, Scene
   cj->view_layer = view_layer;
   cj->ntree = nodetree;
   cj->recalc_flags = compo_get_recalc_flags(C);
+  cj->use_viewer_visible_area = compo_get_viewer_visible_area(C, &cj->viewer_visible_area);
 
   /* setup job */
   WM_jobs_customdata_set(wm_job, cj, compo_freejob);
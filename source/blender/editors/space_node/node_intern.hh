@@ -90,6 +90,14 @@ struct SpaceNode_Runtime {
   /** For auto compositing. */
   bool recalc;
 
+  /**
+   * Normalized area of the backdrop image computed by the last compositing, viewers only compute
+   * the displayed part of their image.
+   */
+  rctf backdrop_composited_area = {0.0f, 1.0f, 0.0f, 1.0f};
+  /** Size of the backdrop image when #backdrop_composited_area was set. */
+  int backdrop_size[2] = {0, 0};
+
   /** Temporary data for modal linking operator. */
   std::unique_ptr<bNodeLinkDrag> linkdrag;
 
@@ -166,6 +174,11 @@ void NODE_OT_view_all(wmOperatorType *ot);
 void NODE_OT_view_selected(wmOperatorType *ot);
 void NODE_OT_geometry_node_view_legacy(wmOperatorType *ot);
 
+/**
+ * Whether part of the displayed backdrop image was not computed by the last compositing.
+ */
+bool node_backdrop_needs_compositing(SpaceNode &snode, const ARegion &region);
+
 void NODE_OT_backimage_move(wmOperatorType *ot);
 void NODE_OT_backimage_zoom(wmOperatorType *ot);
 void NODE_OT_backimage_fit(wmOperatorType *ot);
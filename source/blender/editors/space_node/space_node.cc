@@ -418,6 +418,12 @@ static void node_area_listener(const wmSpaceTypeListenerParams *params)
       }
       else if (wmn->data == ND_SPACE_NODE_VIEW) {
         ED_area_tag_redraw(area);
+
+        /* Viewers only compute the displayed part of the backdrop. */
+        ARegion *region = BKE_area_find_region_type(area, RGN_TYPE_WINDOW);
+        if (region && node_backdrop_needs_compositing(*snode, *region)) {
+          ED_area_tag_refresh(area);
+        }
       }
       break;
     case NC_NODE:
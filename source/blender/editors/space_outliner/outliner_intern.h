@@ -55,6 +55,10 @@ typedef struct SpaceOutliner_Runtime {
   /** Pointers to tree-store elements, grouped by `(id, type, nr)`
    *  in hash-table for faster searching. */
   struct GHash *treehash;
+
+  /** The last tree build skipped the contents of elements inside collapsed parents (see
+   *  #outliner_add_object_contents), so opening an element requires a rebuild. */
+  bool has_lazy_contents;
 } SpaceOutliner_Runtime;
 
 typedef enum TreeElementInsertType {
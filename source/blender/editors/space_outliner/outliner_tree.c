@@ -231,9 +231,27 @@ bool outliner_requires_rebuild_on_select_or_active_change(const SpaceOutliner *s
 
 bool outliner_requires_rebuild_on_open_change(const SpaceOutliner *space_outliner)
 {
+  if (space_outliner->runtime && space_outliner->runtime->has_lazy_contents) {
+    return true;
+  }
   return ELEM(space_outliner->outlinevis, SO_DATA_API);
 }
 
+/**
+ * Check if \a te is inside a collapsed element, so neither it nor its children are drawn. The
+ * icon row of a collapsed element only shows objects and bones below its direct children.
+ */
+static bool outliner_element_is_in_collapsed_parent(const SpaceOutliner *space_outliner,
+                                                    const TreeElement *te)
+{
+  for (const TreeElement *te_parent = te->parent; te_parent; te_parent = te_parent->parent) {
+    if (!TSELEM_OPEN(TREESTORE(te_parent), space_outliner)) {
+      return true;
+    }
+  }
+  return false;
+}
+
 /* special handling of hierarchical non-lib data */
 static void outliner_add_bone(SpaceOutliner *space_outliner,
                               ListBase *lb,
@@ -299,6 +317,15 @@ static void outliner_add_object_contents(SpaceOutliner *space_outliner,
                                          TreeStoreElem *tselem,
                                          Object *ob)
 {
+  /* Don't build the contents of objects that can't be seen, building the tree for scenes with
+   * many objects would be slow otherwise. Child objects are still added to the hierarchy, and
+   * armatures are fully built since their bones are shown in the icon row of collapsed parents. */
+  if (!SEARCHING_OUTLINER(space_outliner) && (ob->type != OB_ARMATURE) &&
+      outliner_element_is_in_collapsed_parent(space_outliner, te)) {
+    space_outliner->runtime->has_lazy_contents = true;
+    return;
+  }
+
   if (outliner_animdata_test(ob->adt)) {
     outliner_add_element(space_outliner, &te->subtree, ob, te, TSE_ANIM_DATA, 0);
   }
@@ -1891,6 +1918,7 @@ void outliner_build_tree(Main *mainvar,
   outliner_free_tree(&space_outliner->tree);
   outliner_storage_cleanup(space_outliner);
   outliner_tree_display_destroy(&space_outliner->runtime->tree_display);
+  space_outliner->runtime->has_lazy_contents = false;
 
   space_outliner->runtime->tree_display = outliner_tree_display_create(space_outliner->outlinevis,
                                                                        space_outliner);
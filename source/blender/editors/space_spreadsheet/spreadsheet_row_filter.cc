@@ -16,7 +16,9 @@
 
 #include <cstring>
 
+#include "BLI_array.hh"
 #include "BLI_listbase.h"
+#include "BLI_task.hh"
 
 #include "DNA_screen_types.h"
 #include "DNA_space_types.h"
@@ -43,10 +45,40 @@ static void apply_filter_operation(const VArray<T> &data,
                                    const IndexMask mask,
                                    Vector<int64_t> &new_indices)
 {
-  for (const int64_t i : mask) {
-    if (check_fn(data[i])) {
-      new_indices.append(i);
+  /* Check the rows in parallel chunks and join the results in order, filtering huge geometries
+   * one element at a time froze the UI on every redraw. */
+  const int64_t chunk_size = 8192;
+  const int64_t chunks_num = (mask.size() + chunk_size - 1) / chunk_size;
+  Array<Vector<int64_t>> chunk_indices(chunks_num);
+
+  /* Avoid the virtual function call per element for the common case of a span. */
+  const bool is_span = data.is_span();
+  const Span<T> span = is_span ? data.get_internal_span() : Span<T>();
+
+  threading::parallel_for(IndexRange(chunks_num), 1, [&](const IndexRange chunks) {
+    for (const int64_t chunk : chunks) {
+      const IndexMask chunk_mask = mask.slice(
+          IndexRange(chunk * chunk_size, std::min(chunk_size, mask.size() - chunk * chunk_size)));
+      Vector<int64_t> &indices = chunk_indices[chunk];
+      if (is_span) {
+        for (const int64_t i : chunk_mask) {
+          if (check_fn(span[i])) {
+            indices.append(i);
+          }
+        }
+      }
+      else {
+        for (const int64_t i : chunk_mask) {
+          if (check_fn(data[i])) {
+            indices.append(i);
+          }
+        }
+      }
     }
+  });
+
+  for (const Vector<int64_t> &indices : chunk_indices) {
+    new_indices.extend(indices);
   }
 }
 
@@ -1923,7 +1923,8 @@ static void tc_mesh_partial_types_calc(TransInfo *t, struct PartialTypeState *r_
       }
       break;
     }
-    case TFM_ROTATION: {
+    case TFM_ROTATION:
+    case TFM_TRACKBALL: {
       partial_for_looptri = PARTIAL_TYPE_GROUP;
       partial_for_normals = PARTIAL_TYPE_ALL;
       break;
@@ -1941,6 +1942,16 @@ static void tc_mesh_partial_types_calc(TransInfo *t, struct PartialTypeState *r_
       }
       break;
     }
+    case TFM_SHEAR: {
+      /* Like non-uniform scale, the groups keep their tessellation but not their normals. */
+      partial_for_looptri = PARTIAL_TYPE_GROUP;
+      partial_for_normals = PARTIAL_TYPE_ALL;
+      break;
+    }
+    case TFM_NORMAL_ROTATION: {
+      /* Only custom normals are edited, vertices don't move. */
+      break;
+    }
     default: {
       partial_for_looptri = PARTIAL_TYPE_ALL;
       partial_for_normals = PARTIAL_TYPE_ALL;
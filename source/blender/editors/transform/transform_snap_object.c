@@ -27,6 +27,7 @@
 #include "BLI_listbase.h"
 #include "BLI_math.h"
 #include "BLI_memarena.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "DNA_armature_types.h"
@@ -2763,6 +2764,118 @@ static void snap_obj_fn(SnapObjectContext *sctx,
   }
 }
 
+/* An object to snap to, with the matrix it is instanced with. */
+typedef struct SnapObjectItem {
+  Object *ob_eval;
+  float obmat[4][4];
+  bool is_object_active;
+
+  /* Mesh for which the BVH-trees used by #snapMesh are built before snapping. */
+  Mesh *me_eval;
+  bool use_hide;
+} SnapObjectItem;
+
+struct SnapObjItemsUserData {
+  SnapObjectItem *items;
+  int items_len;
+  int items_alloc_len;
+};
+
+static void snap_obj_item_add_fn(SnapObjectContext *UNUSED(sctx),
+                                 const struct SnapObjectParams *UNUSED(params),
+                                 Object *ob_eval,
+                                 float obmat[4][4],
+                                 bool is_object_active,
+                                 void *data)
+{
+  struct SnapObjItemsUserData *dt = data;
+  if (dt->items_len == dt->items_alloc_len) {
+    dt->items_alloc_len = max_ii(16, dt->items_alloc_len * 2);
+    dt->items = MEM_reallocN(dt->items, sizeof(*dt->items) * (size_t)dt->items_alloc_len);
+  }
+  SnapObjectItem *item = &dt->items[dt->items_len++];
+  item->ob_eval = ob_eval;
+  copy_m4_m4(item->obmat, obmat);
+  item->is_object_active = is_object_active;
+  item->me_eval = NULL;
+  item->use_hide = false;
+}
+
+/**
+ * Find the mesh #snapMesh is going to use for this object, when its bounds are within `dist_px`.
+ */
+static Mesh *snap_obj_item_mesh_get(SnapObjectContext *sctx,
+                                    const struct SnapObjectParams *params,
+                                    const SnapObjectItem *item,
+                                    const float dist_px,
+                                    bool *r_use_hide)
+{
+  Object *ob_eval = item->ob_eval;
+  Mesh *me_eval = NULL;
+  *r_use_hide = false;
+
+  if (ob_eval->type == OB_MESH) {
+    if (ob_eval->dt == OB_BOUNDBOX) {
+      return NULL;
+    }
+    me_eval = mesh_for_snap(ob_eval, params->edit_mode_type, r_use_hide);
+  }
+  else if (ELEM(ob_eval->type, OB_SURF, OB_FONT)) {
+    me_eval = BKE_object_get_evaluated_mesh(ob_eval);
+  }
+
+  if (me_eval == NULL || me_eval->totvert == 0) {
+    return NULL;
+  }
+  if (me_eval->totedge == 0 && !(sctx->runtime.snap_to_flag & SCE_SNAP_MODE_VERTEX)) {
+    return NULL;
+  }
+
+  float lpmat[4][4];
+  mul_m4_m4m4(lpmat, sctx->runtime.pmat, item->obmat);
+  BoundBox *bb = BKE_object_boundbox_get(ob_eval);
+  if (bb && !snap_bound_box_check_dist(bb->vec[0],
+                                       bb->vec[6],
+                                       lpmat,
+                                       sctx->runtime.win_size,
+                                       sctx->runtime.mval,
+                                       square_f(dist_px))) {
+    return NULL;
+  }
+
+  return me_eval;
+}
+
+struct SnapObjBVHTreeData {
+  const SnapObjectItem *items;
+  bool use_loose_verts;
+};
+
+static void snap_obj_bvhtree_ensure_fn(void *__restrict userdata,
+                                       const int index,
+                                       const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const struct SnapObjBVHTreeData *data = userdata;
+  const SnapObjectItem *item = &data->items[index];
+  if (item->me_eval == NULL) {
+    return;
+  }
+
+  /* The trees are cached in the mesh, #snapMesh only has to look them up afterwards. */
+  BVHTreeFromMesh treedata;
+  BKE_bvhtree_from_mesh_get(&treedata,
+                            item->me_eval,
+                            item->use_hide ? BVHTREE_FROM_LOOPTRI_NO_HIDDEN : BVHTREE_FROM_LOOPTRI,
+                            4);
+  free_bvhtree_from_mesh(&treedata);
+  BKE_bvhtree_from_mesh_get(&treedata, item->me_eval, BVHTREE_FROM_LOOSEEDGES, 2);
+  free_bvhtree_from_mesh(&treedata);
+  if (data->use_loose_verts) {
+    BKE_bvhtree_from_mesh_get(&treedata, item->me_eval, BVHTREE_FROM_LOOSEVERTS, 2);
+    free_bvhtree_from_mesh(&treedata);
+  }
+}
+
 /**
  * Main Snapping Function
  * ======================
@@ -2809,7 +2922,36 @@ static short snapObjectsRay(SnapObjectContext *sctx,
       .ret = 0,
   };
 
-  iter_snap_objects(sctx, params, snap_obj_fn, &data);
+  /* Gather the objects first, so the BVH-trees of the meshes close to the cursor can be built in
+   * parallel. Snapping itself stays serial since every hit narrows `dist_px` for the next
+   * object. */
+  struct SnapObjItemsUserData items_data = {NULL};
+  iter_snap_objects(sctx, params, snap_obj_item_add_fn, &items_data);
+
+  int build_len = 0;
+  for (int i = 0; i < items_data.items_len; i++) {
+    SnapObjectItem *item = &items_data.items[i];
+    item->me_eval = snap_obj_item_mesh_get(sctx, params, item, *dist_px, &item->use_hide);
+    build_len += (item->me_eval != NULL);
+  }
+
+  struct SnapObjBVHTreeData bvhtree_data = {
+      .items = items_data.items,
+      .use_loose_verts = (sctx->runtime.snap_to_flag & SCE_SNAP_MODE_VERTEX) != 0,
+  };
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (build_len > 1);
+  settings.min_iter_per_thread = 1;
+  BLI_task_parallel_range(
+      0, items_data.items_len, &bvhtree_data, snap_obj_bvhtree_ensure_fn, &settings);
+
+  for (int i = 0; i < items_data.items_len; i++) {
+    SnapObjectItem *item = &items_data.items[i];
+    snap_obj_fn(sctx, params, item->ob_eval, item->obmat, item->is_object_active, &data);
+  }
+
+  MEM_SAFE_FREE(items_data.items);
 
   return data.ret;
 }
@@ -25,6 +25,7 @@
 
 #include "BLI_ghash.h"
 #include "BLI_listbase.h"
+#include "BLI_task.h"
 
 #include "DNA_ID.h"
 #include "DNA_collection_types.h"
@@ -309,6 +310,30 @@ static void memfile_undosys_step_decode(struct bContext *C,
   WM_event_add_notifier(C, NC_SCENE | ND_LAYER_CONTENT, CTX_data_scene(C));
 }
 
+/**
+ * Freeing the memory of undo steps of large files can take a noticeable time. Steps are freed
+ * when pushing new ones (to respect the undo steps and memory limits), so free them in the
+ * background to avoid stalling the UI after every operation.
+ *
+ * Once merged into the next step, the remaining chunks of a step are not referenced by any other
+ * step anymore, so freeing them doesn't need any further synchronization.
+ */
+static TaskPool *memfile_undosys_free_pool = NULL;
+
+static void memfile_undosys_free_task(TaskPool *__restrict UNUSED(pool), void *taskdata)
+{
+  BKE_memfile_undo_free((MemFileUndoData *)taskdata);
+}
+
+void ED_undosys_memfile_free_wait(void)
+{
+  if (memfile_undosys_free_pool != NULL) {
+    BLI_task_pool_work_and_wait(memfile_undosys_free_pool);
+    BLI_task_pool_free(memfile_undosys_free_pool);
+    memfile_undosys_free_pool = NULL;
+  }
+}
+
 static void memfile_undosys_step_free(UndoStep *us_p)
 {
   /* To avoid unnecessary slow down, free backwards
@@ -322,7 +347,11 @@ static void memfile_undosys_step_free(UndoStep *us_p)
     }
   }
 
-  BKE_memfile_undo_free(us->data);
+  if (memfile_undosys_free_pool == NULL) {
+    memfile_undosys_free_pool = BLI_task_pool_create_background(NULL, TASK_PRIORITY_LOW);
+  }
+  BLI_task_pool_push(memfile_undosys_free_pool, memfile_undosys_free_task, us->data, false, NULL);
+  us->data = NULL;
 }
 
 void ED_memfile_undosys_type(UndoType *ut)
@@ -28,6 +28,7 @@
 #include "BLI_polyfill_2d.h"
 #include "BLI_polyfill_2d_beautify.h"
 #include "BLI_rand.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "uvedit_parametrizer.h"
@@ -4597,60 +4598,121 @@ void param_construct_end(ParamHandle *handle,
   phandle->state = PHANDLE_STATE_CONSTRUCTED;
 }
 
+typedef struct PLscmTaskData {
+  PHandle *handle;
+  PBool live;
+  PBool abf;
+} PLscmTaskData;
+
+typedef struct PLscmSolveCount {
+  int changed;
+  int failed;
+} PLscmSolveCount;
+
+static void p_lscm_begin_task_cb(void *__restrict userdata,
+                                 const int i,
+                                 const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const PLscmTaskData *data = userdata;
+  PChart *chart = data->handle->charts[i];
+  PFace *f;
+
+  for (f = chart->faces; f; f = f->nextlink) {
+    p_face_backup_uvs(f);
+  }
+  p_chart_lscm_begin(chart, data->live, data->abf);
+}
+
+static void p_lscm_solve_task_cb(void *__restrict userdata,
+                                 const int i,
+                                 const TaskParallelTLS *__restrict tls)
+{
+  const PLscmTaskData *data = userdata;
+  PLscmSolveCount *count = tls->userdata_chunk;
+  PChart *chart = data->handle->charts[i];
+
+  if (chart->u.lscm.context == NULL) {
+    return;
+  }
+
+  const PBool result = p_chart_lscm_solve(data->handle, chart);
+
+  if (result && !(chart->flag & PCHART_HAS_PINS)) {
+    p_chart_rotate_minimum_area(chart);
+  }
+  else if (result && chart->u.lscm.single_pin) {
+    p_chart_rotate_fit_aabb(chart);
+    p_chart_lscm_transform_single_pin(chart);
+  }
+
+  if (!result || !(chart->flag & PCHART_HAS_PINS)) {
+    p_chart_lscm_end(chart);
+  }
+
+  if (result) {
+    count->changed++;
+  }
+  else {
+    count->failed++;
+  }
+}
+
+static void p_lscm_solve_reduce(const void *__restrict UNUSED(userdata),
+                                void *__restrict chunk_join,
+                                void *__restrict chunk)
+{
+  PLscmSolveCount *join = chunk_join;
+  const PLscmSolveCount *count = chunk;
+
+  join->changed += count->changed;
+  join->failed += count->failed;
+}
+
 void param_lscm_begin(ParamHandle *handle, ParamBool live, ParamBool abf)
 {
   PHandle *phandle = (PHandle *)handle;
-  PFace *f;
-  int i;
 
   param_assert(phandle->state == PHANDLE_STATE_CONSTRUCTED);
   phandle->state = PHANDLE_STATE_LSCM;
 
-  for (i = 0; i < phandle->ncharts; i++) {
-    for (f = phandle->charts[i]->faces; f; f = f->nextlink) {
-      p_face_backup_uvs(f);
-    }
-    p_chart_lscm_begin(phandle->charts[i], (PBool)live, (PBool)abf);
-  }
+  /* Charts share no vertices, edges or faces, so they can be set up (including the ABF solve)
+   * independently of each other. */
+  PLscmTaskData data = {
+      .handle = phandle,
+      .live = (PBool)live,
+      .abf = (PBool)abf,
+  };
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (phandle->ncharts > 1);
+  settings.min_iter_per_thread = 1;
+  BLI_task_parallel_range(0, phandle->ncharts, &data, p_lscm_begin_task_cb, &settings);
 }
 
 void param_lscm_solve(ParamHandle *handle, int *count_changed, int *count_failed)
 {
   PHandle *phandle = (PHandle *)handle;
-  PChart *chart;
-  int i;
 
   param_assert(phandle->state == PHANDLE_STATE_LSCM);
 
-  for (i = 0; i < phandle->ncharts; i++) {
-    chart = phandle->charts[i];
-
-    if (chart->u.lscm.context) {
-      const PBool result = p_chart_lscm_solve(phandle, chart);
-
-      if (result && !(chart->flag & PCHART_HAS_PINS)) {
-        p_chart_rotate_minimum_area(chart);
-      }
-      else if (result && chart->u.lscm.single_pin) {
-        p_chart_rotate_fit_aabb(chart);
-        p_chart_lscm_transform_single_pin(chart);
-      }
-
-      if (!result || !(chart->flag & PCHART_HAS_PINS)) {
-        p_chart_lscm_end(chart);
-      }
-
-      if (result) {
-        if (count_changed != NULL) {
-          *count_changed += 1;
-        }
-      }
-      else {
-        if (count_failed != NULL) {
-          *count_failed += 1;
-        }
-      }
-    }
+  PLscmTaskData data = {
+      .handle = phandle,
+  };
+  PLscmSolveCount count = {0, 0};
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (phandle->ncharts > 1);
+  settings.min_iter_per_thread = 1;
+  settings.userdata_chunk = &count;
+  settings.userdata_chunk_size = sizeof(count);
+  settings.func_reduce = p_lscm_solve_reduce;
+  BLI_task_parallel_range(0, phandle->ncharts, &data, p_lscm_solve_task_cb, &settings);
+
+  if (count_changed != NULL) {
+    *count_changed += count.changed;
+  }
+  if (count_failed != NULL) {
+    *count_failed += count.failed;
   }
 }
 
@@ -229,10 +229,15 @@ class FieldOperation : public FieldNode {
 
  public:
   FieldOperation(std::shared_ptr<const MultiFunction> function, Vector<GField> inputs = {});
+  /**
+   * The function is not owned. It is referenced by cached procedures after the field has been
+   * freed, so it is expected to have a static lifetime.
+   */
   FieldOperation(const MultiFunction &function, Vector<GField> inputs = {});
 
   Span<GField> inputs() const;
   const MultiFunction &multi_function() const;
+  bool owns_multi_function() const;
 
   const CPPType &output_cpp_type(int output_index) const override;
 };
@@ -628,6 +633,11 @@ inline const MultiFunction &FieldOperation::multi_function() const
   return *function_;
 }
 
+inline bool FieldOperation::owns_multi_function() const
+{
+  return bool(owned_function_);
+}
+
 inline const CPPType &FieldOperation::output_cpp_type(int output_index) const
 {
   int output_counter = 0;
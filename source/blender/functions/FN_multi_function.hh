@@ -68,6 +68,15 @@ class MultiFunction {
    */
   void call_auto(IndexMask mask, MFParams params, MFContext context) const;
   virtual void call(IndexMask mask, MFParams params, MFContext context) const = 0;
+  /**
+   * Call the function for the indices in a slice of the mask. Indices are offset when necessary,
+   * so that arrays allocated by the function only have to be as large as the slice. Only
+   * functions with single value parameters are supported.
+   */
+  void call_for_mask_slice(IndexMask mask,
+                           IndexRange slice,
+                           MFParams params,
+                           MFContext context) const;
 
   virtual uint64_t hash() const
   {
@@ -29,6 +29,11 @@ class MFProcedureExecutor : public MultiFunction {
  private:
   MFSignature signature_;
   const MFProcedure &procedure_;
+  /**
+   * Large masks are split into chunks of this size, that are processed one after another. Zero
+   * when the parameters of the procedure don't support that.
+   */
+  int64_t chunk_size_ = 0;
 
  public:
   MFProcedureExecutor(const MFProcedure &procedure);
@@ -36,6 +41,7 @@ class MFProcedureExecutor : public MultiFunction {
   void call(IndexMask mask, MFParams params, MFContext context) const override;
 
  private:
+  void execute(IndexMask mask, MFParams params, MFContext context) const;
   ExecutionHints get_execution_hints() const override;
 };
 
@@ -14,6 +14,9 @@
  * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
  */
 
+#include <mutex>
+#include <optional>
+
 #include "BLI_map.hh"
 #include "BLI_multi_value_map.hh"
 #include "BLI_set.hh"
@@ -150,23 +153,107 @@ static Set<GFieldRef> find_varying_fields(const FieldTreeInfo &field_tree_info,
   return found_fields;
 }
 
+/* --------------------------------------------------------------------
+ * Procedure Cache.
+ */
+
+/**
+ * Refers to a value that is passed into or computed by a procedure described by
+ * #FieldProcedureKey.
+ */
+struct ProcedureValueRef {
+  /** Index of the call that computes the value, or -1 when the value is a parameter. */
+  int call_index = -1;
+  /** Index of the parameter, or of the output of the call. */
+  int index = 0;
+
+  uint64_t hash() const
+  {
+    return get_default_hash_2(call_index, index);
+  }
+
+  friend bool operator==(const ProcedureValueRef &a, const ProcedureValueRef &b)
+  {
+    return a.call_index == b.call_index && a.index == b.index;
+  }
+};
+
+struct ProcedureCall {
+  const MultiFunction *fn = nullptr;
+  Vector<ProcedureValueRef, 4> inputs;
+
+  uint64_t hash() const
+  {
+    uint64_t hash = get_default_hash(fn);
+    for (const ProcedureValueRef &input : inputs) {
+      hash = hash * 33 ^ input.hash();
+    }
+    return hash;
+  }
+
+  friend bool operator==(const ProcedureCall &a, const ProcedureCall &b)
+  {
+    return a.fn == b.fn && a.inputs.as_span() == b.inputs.as_span();
+  }
+};
+
 /**
- * Builds the #procedure so that it computes the the fields.
+ * Describes the procedure that computes a set of fields without referencing the field nodes. The
+ * procedure is built from the key alone, so it can be reused for all field trees with the same
+ * structure, e.g. when the same node group is evaluated for many instances or in every frame.
  */
-static void build_multi_function_procedure_for_fields(MFProcedure &procedure,
-                                                      ResourceScope &scope,
-                                                      const FieldTreeInfo &field_tree_info,
-                                                      Span<GFieldRef> output_fields)
+struct FieldProcedureKey {
+  /**
+   * The field inputs followed by the constants. Constants are passed in as parameters, so that
+   * changing their values does not require a new procedure.
+   */
+  Vector<const CPPType *> parameter_types;
+  /** Calls in the order they are executed. Identical calls are only added once. */
+  VectorSet<ProcedureCall> calls;
+  Vector<ProcedureValueRef> outputs;
+
+  uint64_t hash() const
+  {
+    uint64_t hash = 0;
+    for (const CPPType *type : parameter_types) {
+      hash = hash * 33 ^ get_default_hash(type);
+    }
+    for (const ProcedureCall &call : calls) {
+      hash = hash * 33 ^ call.hash();
+    }
+    for (const ProcedureValueRef &output : outputs) {
+      hash = hash * 33 ^ output.hash();
+    }
+    return hash;
+  }
+
+  friend bool operator==(const FieldProcedureKey &a, const FieldProcedureKey &b)
+  {
+    return a.parameter_types == b.parameter_types &&
+           a.calls.as_span() == b.calls.as_span() && a.outputs == b.outputs;
+  }
+};
+
+/**
+ * Builds the key for the procedure that computes the #output_fields. The constants that have to
+ * be passed into the procedure are added to #r_constants.
+ * \return False when the procedure must not be cached, because it uses multi-functions that are
+ * owned by the field tree and might not exist anymore when the procedure is used again.
+ */
+static bool build_procedure_key_for_fields(const FieldTreeInfo &field_tree_info,
+                                           Span<GFieldRef> output_fields,
+                                           FieldProcedureKey &r_key,
+                                           Vector<const FieldConstant *> &r_constants)
 {
-  MFProcedureBuilder builder{procedure};
-  /* Every input, intermediate and output field corresponds to a variable in the procedure. */
-  Map<GFieldRef, MFVariable *> variable_by_field;
+  bool is_cacheable = true;
+  /* Every input, intermediate and output field corresponds to a value in the procedure. */
+  Map<GFieldRef, ProcedureValueRef> value_by_field;
 
   /* Start by adding the field inputs as parameters to the procedure. */
-  for (const FieldInput &field_input : field_tree_info.deduplicated_field_inputs) {
-    MFVariable &variable = builder.add_input_parameter(
-        MFDataType::ForSingle(field_input.cpp_type()), field_input.debug_name());
-    variable_by_field.add_new({field_input, 0}, &variable);
+  for (const int i : IndexRange(field_tree_info.deduplicated_field_inputs.size())) {
+    const FieldInput &field_input = field_tree_info.deduplicated_field_inputs[i];
+    r_key.parameter_types.append(&field_input.cpp_type());
+    value_by_field.add_new({field_input, 0}, {-1, i});
   }
 
   /* Utility struct that is used to do proper depth first search traversal of the tree below. */
@@ -183,7 +270,7 @@ static void build_multi_function_procedure_for_fields(MFProcedure &procedure,
     while (!fields_to_check.is_empty()) {
       FieldWithIndex &field_with_index = fields_to_check.peek();
       const GFieldRef &field = field_with_index.field;
-      if (variable_by_field.contains(field)) {
+      if (value_by_field.contains(field)) {
         /* The field has been handled already. */
         fields_to_check.pop();
         continue;
@@ -192,6 +279,7 @@ static void build_multi_function_procedure_for_fields(MFProcedure &procedure,
       switch (field_node.node_type()) {
         case FieldNodeType::Input: {
           /* Field inputs should already be handled above. */
+          BLI_assert_unreachable();
           break;
         }
         case FieldNodeType::Operation: {
@@ -205,78 +293,127 @@ static void build_multi_function_procedure_for_fields(MFProcedure &procedure,
             field_with_index.current_input_index++;
           }
           else {
-            /* All inputs variables are ready, now gather all variables that are used by the
-             * function and call it. */
+            /* All inputs are ready, add the call. Separate operations that call the same function
+             * with the same inputs compute the same values, so they share a single call. */
             const MultiFunction &multi_function = operation_node.multi_function();
-            Vector<MFVariable *> variables(multi_function.param_amount());
+            if (operation_node.owns_multi_function()) {
+              is_cacheable = false;
+            }
+            ProcedureCall call;
+            call.fn = &multi_function;
+            for (const GField &input_field : operation_inputs) {
+              call.inputs.append(value_by_field.lookup(input_field));
+            }
+            const int call_index = r_key.calls.index_of_or_add(std::move(call));
 
-            int param_input_index = 0;
-            int param_output_index = 0;
+            int output_index = 0;
             for (const int param_index : multi_function.param_indices()) {
-              const MFParamType param_type = multi_function.param_type(param_index);
-              const MFParamType::InterfaceType interface_type = param_type.interface_type();
-              if (interface_type == MFParamType::Input) {
-                const GField &input_field = operation_inputs[param_input_index];
-                variables[param_index] = variable_by_field.lookup(input_field);
-                param_input_index++;
-              }
-              else if (interface_type == MFParamType::Output) {
-                const GFieldRef output_field{operation_node, param_output_index};
-                const bool output_is_ignored =
-                    field_tree_info.field_users.lookup(output_field).is_empty() &&
-                    !output_fields.contains(output_field);
-                if (output_is_ignored) {
-                  /* Ignored outputs don't need a variable. */
-                  variables[param_index] = nullptr;
-                }
-                else {
-                  /* Create a new variable for used outputs. */
-                  MFVariable &new_variable = procedure.new_variable(param_type.data_type());
-                  variables[param_index] = &new_variable;
-                  variable_by_field.add_new(output_field, &new_variable);
-                }
-                param_output_index++;
-              }
-              else {
-                BLI_assert_unreachable();
+              if (multi_function.param_type(param_index).is_output()) {
+                value_by_field.add_new({operation_node, output_index},
+                                       {call_index, output_index});
+                output_index++;
               }
             }
-            builder.add_call_with_all_variables(multi_function, variables);
           }
           break;
         }
         case FieldNodeType::Constant: {
           const FieldConstant &constant_node = static_cast<const FieldConstant &>(field_node);
-          const MultiFunction &fn = procedure.construct_function<CustomMF_GenericConstant>(
-              constant_node.type(), constant_node.value().get(), false);
-          MFVariable &new_variable = *builder.add_call<1>(fn)[0];
-          variable_by_field.add_new(field, &new_variable);
+          value_by_field.add_new(field, {-1, int(r_key.parameter_types.size())});
+          r_key.parameter_types.append(&constant_node.type());
+          r_constants.append(&constant_node);
           break;
         }
       }
     }
   }
 
+  for (const GFieldRef &field : output_fields) {
+    r_key.outputs.append(value_by_field.lookup(field));
+  }
+  return is_cacheable;
+}
+
+/**
+ * Builds the #procedure so that it computes the outputs described by the #key.
+ */
+static void build_multi_function_procedure_from_key(MFProcedure &procedure,
+                                                    const FieldProcedureKey &key)
+{
+  MFProcedureBuilder builder{procedure};
+  Map<ProcedureValueRef, MFVariable *> variable_by_value;
+  /* All variables in the order they are created, used to add destruct instructions in the end. */
+  Vector<MFVariable *> variables_in_order;
+
+  for (const int i : key.parameter_types.index_range()) {
+    MFVariable &variable = builder.add_input_parameter(
+        MFDataType::ForSingle(*key.parameter_types[i]));
+    variable_by_value.add_new({-1, i}, &variable);
+    variables_in_order.append(&variable);
+  }
+
+  /* Outputs of calls that are never used don't need a variable. */
+  Set<ProcedureValueRef> used_values;
+  for (const ProcedureCall &call : key.calls) {
+    used_values.add_multiple(call.inputs);
+  }
+  used_values.add_multiple(key.outputs);
+
+  for (const int call_index : IndexRange(key.calls.size())) {
+    const ProcedureCall &call = key.calls[call_index];
+    const MultiFunction &multi_function = *call.fn;
+    Vector<MFVariable *> variables(multi_function.param_amount());
+
+    int param_input_index = 0;
+    int param_output_index = 0;
+    for (const int param_index : multi_function.param_indices()) {
+      const MFParamType param_type = multi_function.param_type(param_index);
+      const MFParamType::InterfaceType interface_type = param_type.interface_type();
+      if (interface_type == MFParamType::Input) {
+        variables[param_index] = variable_by_value.lookup(call.inputs[param_input_index]);
+        param_input_index++;
+      }
+      else if (interface_type == MFParamType::Output) {
+        const ProcedureValueRef output_value{call_index, param_output_index};
+        if (used_values.contains(output_value)) {
+          MFVariable &new_variable = procedure.new_variable(param_type.data_type());
+          variables[param_index] = &new_variable;
+          variable_by_value.add_new(output_value, &new_variable);
+          variables_in_order.append(&new_variable);
+        }
+        else {
+          /* Ignored outputs don't need a variable. */
+          variables[param_index] = nullptr;
+        }
+        param_output_index++;
+      }
+      else {
+        BLI_assert_unreachable();
+      }
+    }
+    builder.add_call_with_all_variables(multi_function, variables);
+  }
+
   /* Add output parameters to the procedure. */
   Set<MFVariable *> already_output_variables;
-  for (const GFieldRef &field : output_fields) {
-    MFVariable *variable = variable_by_field.lookup(field);
-    if (!already_output_variables.add(variable)) {
+  for (const ProcedureValueRef &output : key.outputs) {
+    MFVariable *variable = variable_by_value.lookup(output);
+    if (already_output_variables.contains(variable)) {
       /* One variable can be output at most once. To output the same value twice, we have to make
        * a copy first. */
-      const MultiFunction &copy_fn = scope.construct<CustomMF_GenericCopy>(variable->data_type());
+      const MultiFunction &copy_fn = procedure.construct_function<CustomMF_GenericCopy>(
+          variable->data_type());
       variable = builder.add_call<1>(copy_fn, {variable})[0];
     }
+    already_output_variables.add(variable);
     builder.add_output_parameter(*variable);
   }
 
-  /* Remove the variables that should not be destructed from the map. */
-  for (const GFieldRef &field : output_fields) {
-    variable_by_field.remove(field);
-  }
-  /* Add destructor calls for the remaining variables. */
-  for (MFVariable *variable : variable_by_field.values()) {
-    builder.add_destruct(*variable);
+  /* Add destructor calls for the variables that are not output. */
+  for (MFVariable *variable : variables_in_order) {
+    if (!already_output_variables.contains(variable)) {
+      builder.add_destruct(*variable);
+    }
   }
 
   MFReturnInstruction &return_instr = builder.add_return();
@@ -287,6 +424,86 @@ static void build_multi_function_procedure_for_fields(MFProcedure &procedure,
   BLI_assert(procedure.validate());
 }
 
+/**
+ * A procedure that is built for a #FieldProcedureKey and the executor that runs it. It is not
+ * modified after construction, so it can be used by multiple threads at the same time.
+ */
+class FieldProcedure : NonCopyable, NonMovable {
+ private:
+  MFProcedure procedure_;
+  std::optional<MFProcedureExecutor> executor_;
+
+ public:
+  FieldProcedure(const FieldProcedureKey &key)
+  {
+    build_multi_function_procedure_from_key(procedure_, key);
+    executor_.emplace(procedure_);
+  }
+
+  const MFProcedureExecutor &executor() const
+  {
+    return *executor_;
+  }
+};
+
+/**
+ * Building a procedure is expensive compared to the evaluation of small fields and the same field
+ * trees are evaluated over and over again, e.g. for every instance in a scattering setup. Built
+ * procedures are therefore cached globally. Procedures in the cache reference multi-functions that
+ * are not owned by the fields, those are expected to have a static lifetime.
+ */
+class FieldProcedureCache {
+ private:
+  /** The cache is simply cleared when it becomes full. */
+  static constexpr int64_t max_procedures_num = 1024;
+
+  std::mutex mutex_;
+  Map<FieldProcedureKey, std::shared_ptr<const FieldProcedure>> procedures_;
+
+ public:
+  std::shared_ptr<const FieldProcedure> lookup_or_build(FieldProcedureKey key)
+  {
+    {
+      std::lock_guard lock{mutex_};
+      const std::shared_ptr<const FieldProcedure> *procedure = procedures_.lookup_ptr(key);
+      if (procedure != nullptr) {
+        return *procedure;
+      }
+    }
+    /* Build the procedure without holding the lock, other threads can keep using the cache. Users
+     * of a procedure share its ownership, so it can be removed from the cache at any time. */
+    std::shared_ptr<const FieldProcedure> procedure = std::make_shared<const FieldProcedure>(key);
+
+    std::lock_guard lock{mutex_};
+    if (procedures_.size() >= max_procedures_num) {
+      procedures_.clear();
+    }
+    return procedures_.lookup_or_add(std::move(key), std::move(procedure));
+  }
+};
+
+static FieldProcedureCache &get_field_procedure_cache()
+{
+  static FieldProcedureCache cache;
+  return cache;
+}
+
+/**
+ * Get a procedure that computes the #output_fields. The constants that have to be passed into the
+ * procedure after the field inputs are added to #r_constants.
+ */
+static std::shared_ptr<const FieldProcedure> get_procedure_for_fields(
+    const FieldTreeInfo &field_tree_info,
+    Span<GFieldRef> output_fields,
+    Vector<const FieldConstant *> &r_constants)
+{
+  FieldProcedureKey key;
+  if (!build_procedure_key_for_fields(field_tree_info, output_fields, key, r_constants)) {
+    return std::make_shared<const FieldProcedure>(key);
+  }
+  return get_field_procedure_cache().lookup_or_build(std::move(key));
+}
+
 Vector<GVArray> evaluate_fields(ResourceScope &scope,
                                 Span<GFieldRef> fields_to_evaluate,
                                 IndexMask mask,
@@ -376,11 +593,11 @@ Vector<GVArray> evaluate_fields(ResourceScope &scope,
 
   /* Evaluate varying fields if necessary. */
   if (!varying_fields_to_evaluate.is_empty()) {
-    /* Build the procedure for those fields. */
-    MFProcedure procedure;
-    build_multi_function_procedure_for_fields(
-        procedure, scope, field_tree_info, varying_fields_to_evaluate);
-    MFProcedureExecutor procedure_executor{procedure};
+    /* Get the procedure for those fields. */
+    Vector<const FieldConstant *> constants;
+    const std::shared_ptr<const FieldProcedure> procedure = get_procedure_for_fields(
+        field_tree_info, varying_fields_to_evaluate, constants);
+    const MFProcedureExecutor &procedure_executor = procedure->executor();
 
     MFParamsBuilder mf_params{procedure_executor, &mask};
     MFContextBuilder mf_context;
@@ -389,6 +606,9 @@ Vector<GVArray> evaluate_fields(ResourceScope &scope,
     for (const GVArray &varray : field_context_inputs) {
       mf_params.add_readonly_single_input(varray);
     }
+    for (const FieldConstant *constant : constants) {
+      mf_params.add_readonly_single_input(constant->value());
+    }
 
     for (const int i : varying_fields_to_evaluate.index_range()) {
       const GFieldRef &field = varying_fields_to_evaluate[i];
@@ -428,11 +648,11 @@ Vector<GVArray> evaluate_fields(ResourceScope &scope,
 
   /* Evaluate constant fields if necessary. */
   if (!constant_fields_to_evaluate.is_empty()) {
-    /* Build the procedure for those fields. */
-    MFProcedure procedure;
-    build_multi_function_procedure_for_fields(
-        procedure, scope, field_tree_info, constant_fields_to_evaluate);
-    MFProcedureExecutor procedure_executor{procedure};
+    /* Get the procedure for those fields. */
+    Vector<const FieldConstant *> constants;
+    const std::shared_ptr<const FieldProcedure> procedure = get_procedure_for_fields(
+        field_tree_info, constant_fields_to_evaluate, constants);
+    const MFProcedureExecutor &procedure_executor = procedure->executor();
     MFParamsBuilder mf_params{procedure_executor, 1};
     MFContextBuilder mf_context;
 
@@ -440,6 +660,9 @@ Vector<GVArray> evaluate_fields(ResourceScope &scope,
     for (const GVArray &varray : field_context_inputs) {
       mf_params.add_readonly_single_input(varray);
     }
+    for (const FieldConstant *constant : constants) {
+      mf_params.add_readonly_single_input(constant->value());
+    }
 
     for (const int i : constant_fields_to_evaluate.index_range()) {
       const GFieldRef &field = constant_fields_to_evaluate[i];
@@ -483,6 +706,20 @@ Vector<GVArray> evaluate_fields(ResourceScope &scope,
         /* Materialize into a span. */
         computed_varray.materialize_to_uninitialized(mask, dst_varray.get_internal_span().data());
       }
+      else if (mask.size() == dst_varray.size()) {
+        /* All values are replaced, which can be done without a virtual call per element. */
+        const CPPType &type = computed_varray.type();
+        if (computed_varray.is_span()) {
+          dst_varray.set_all(computed_varray.get_internal_span().data());
+        }
+        else {
+          void *buffer = scope.linear_allocator().allocate(type.size() * array_size,
+                                                           type.alignment());
+          computed_varray.materialize_to_uninitialized(mask, buffer);
+          dst_varray.set_all(buffer);
+          type.destruct_n(buffer, array_size);
+        }
+      }
       else {
         /* Slower materialize into a different structure. */
         const CPPType &type = computed_varray.type();
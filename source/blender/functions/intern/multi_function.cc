@@ -66,6 +66,64 @@ static int64_t compute_grain_size(const ExecutionHints &hints, const IndexMask m
   return grain_size;
 }
 
+void MultiFunction::call_for_mask_slice(const IndexMask mask,
+                                        const IndexRange slice,
+                                        MFParams params,
+                                        MFContext context) const
+{
+  const IndexMask sliced_mask = mask.slice(slice);
+  if (sliced_mask[0] < slice.size()) {
+    /* The indices are low, no need to offset them. */
+    this->call(sliced_mask, params, context);
+    return;
+  }
+  const int64_t input_slice_start = sliced_mask[0];
+  const int64_t input_slice_size = sliced_mask.last() - input_slice_start + 1;
+  const IndexRange input_slice_range{input_slice_start, input_slice_size};
+
+  Vector<int64_t> offset_mask_indices;
+  const IndexMask offset_mask = mask.slice_and_offset(slice, offset_mask_indices);
+
+  MFParamsBuilder offset_params{*this, offset_mask.min_array_size()};
+
+  /* Slice all parameters so that for the actual function call. */
+  for (const int param_index : this->param_indices()) {
+    const MFParamType param_type = this->param_type(param_index);
+    switch (param_type.category()) {
+      case MFParamType::SingleInput: {
+        const GVArray &varray = params.readonly_single_input(param_index);
+        offset_params.add_readonly_single_input(varray.slice(input_slice_range));
+        break;
+      }
+      case MFParamType::SingleMutable: {
+        const GMutableSpan span = params.single_mutable(param_index);
+        const GMutableSpan sliced_span = span.slice(input_slice_range);
+        offset_params.add_single_mutable(sliced_span);
+        break;
+      }
+      case MFParamType::SingleOutput: {
+        const GMutableSpan span = params.uninitialized_single_output_if_required(param_index);
+        if (span.is_empty()) {
+          offset_params.add_ignored_single_output();
+        }
+        else {
+          const GMutableSpan sliced_span = span.slice(input_slice_range);
+          offset_params.add_uninitialized_single_output(sliced_span);
+        }
+        break;
+      }
+      case MFParamType::VectorInput:
+      case MFParamType::VectorMutable:
+      case MFParamType::VectorOutput: {
+        BLI_assert_unreachable();
+        break;
+      }
+    }
+  }
+
+  this->call(offset_mask, offset_params, context);
+}
+
 void MultiFunction::call_auto(IndexMask mask, MFParams params, MFContext context) const
 {
   if (mask.is_empty()) {
@@ -86,62 +144,21 @@ void MultiFunction::call_auto(IndexMask mask, MFParams params, MFContext context
   }
 
   threading::parallel_for(mask.index_range(), grain_size, [&](const IndexRange sub_range) {
-    const IndexMask sliced_mask = mask.slice(sub_range);
     if (!hints.allocates_array) {
       /* There is no benefit to changing indices in this case. */
-      this->call(sliced_mask, params, context);
+      this->call(mask.slice(sub_range), params, context);
       return;
     }
-    if (sliced_mask[0] < grain_size) {
-      /* The indices are low, no need to offset them. */
-      this->call(sliced_mask, params, context);
-      return;
-    }
-    const int64_t input_slice_start = sliced_mask[0];
-    const int64_t input_slice_size = sliced_mask.last() - input_slice_start + 1;
-    const IndexRange input_slice_range{input_slice_start, input_slice_size};
-
-    Vector<int64_t> offset_mask_indices;
-    const IndexMask offset_mask = mask.slice_and_offset(sub_range, offset_mask_indices);
-
-    MFParamsBuilder offset_params{*this, offset_mask.min_array_size()};
-
-    /* Slice all parameters so that for the actual function call. */
-    for (const int param_index : this->param_indices()) {
-      const MFParamType param_type = this->param_type(param_index);
-      switch (param_type.category()) {
-        case MFParamType::SingleInput: {
-          const GVArray &varray = params.readonly_single_input(param_index);
-          offset_params.add_readonly_single_input(varray.slice(input_slice_range));
-          break;
-        }
-        case MFParamType::SingleMutable: {
-          const GMutableSpan span = params.single_mutable(param_index);
-          const GMutableSpan sliced_span = span.slice(input_slice_range);
-          offset_params.add_single_mutable(sliced_span);
-          break;
-        }
-        case MFParamType::SingleOutput: {
-          const GMutableSpan span = params.uninitialized_single_output_if_required(param_index);
-          if (span.is_empty()) {
-            offset_params.add_ignored_single_output();
-          }
-          else {
-            const GMutableSpan sliced_span = span.slice(input_slice_range);
-            offset_params.add_uninitialized_single_output(sliced_span);
-          }
-          break;
-        }
-        case MFParamType::VectorInput:
-        case MFParamType::VectorMutable:
-        case MFParamType::VectorOutput: {
-          BLI_assert_unreachable();
-          break;
-        }
-      }
+    /* The range passed to a task can be much larger than the grain size. It is processed in
+     * segments anyway, so that the intermediate arrays allocated by the function stay small. For
+     * procedures, this keeps the temporary data of a chain of functions in the CPU cache instead
+     * of streaming a full array through memory for every function. */
+    for (int64_t segment_start = sub_range.start(); segment_start < sub_range.one_after_last();
+         segment_start += grain_size) {
+      const int64_t segment_size = std::min(grain_size,
+                                            sub_range.one_after_last() - segment_start);
+      this->call_for_mask_slice(mask, IndexRange(segment_start, segment_size), params, context);
     }
-
-    this->call(offset_mask, offset_params, context);
   });
 }
 
@@ -14,6 +14,8 @@
  * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
  */
 
+#include <algorithm>
+
 #include "FN_multi_function_procedure_executor.hh"
 
 #include "BLI_stack.hh"
@@ -24,12 +26,30 @@ MFProcedureExecutor::MFProcedureExecutor(const MFProcedure &procedure) : procedu
 {
   MFSignatureBuilder signature("Procedure Executor");
 
+  bool only_single_params = true;
   for (const ConstMFParameter &param : procedure.params()) {
     signature.add("Parameter", MFParamType(param.type, param.variable->data_type()));
+    if (!param.variable->data_type().is_single()) {
+      only_single_params = false;
+    }
   }
 
   signature_ = signature.build();
   this->set_signature(&signature_);
+
+  if (only_single_params) {
+    /* Choose the chunk size so that the values of all variables fit into the L2 cache of common
+     * CPUs, even if all of them are alive at the same time. */
+    const int64_t cache_size_target = 256 * 1024;
+    int64_t bytes_per_index = 0;
+    for (const MFVariable *variable : procedure.variables()) {
+      const MFDataType data_type = variable->data_type();
+      bytes_per_index += data_type.is_single() ? data_type.single_type().size() :
+                                                 data_type.vector_base_type().size();
+    }
+    chunk_size_ = std::clamp<int64_t>(
+        cache_size_target / std::max<int64_t>(bytes_per_index, 1), 512, 4096);
+  }
 }
 
 using IndicesSplitVectors = std::array<Vector<int64_t>, 2>;
@@ -1178,6 +1198,22 @@ class InstructionScheduler {
 };
 
 void MFProcedureExecutor::call(IndexMask full_mask, MFParams params, MFContext context) const
+{
+  if (chunk_size_ == 0 || full_mask.size() <= chunk_size_) {
+    this->execute(full_mask, params, context);
+    return;
+  }
+  /* Every instruction processes all indices before the next instruction runs. For large masks,
+   * the intermediate values would not be in the cache anymore when they are used. Therefore the
+   * entire procedure is executed for smaller chunks one after another. Multi-threading happens
+   * on a higher level, see #MultiFunction::call_auto. */
+  for (int64_t chunk_start = 0; chunk_start < full_mask.size(); chunk_start += chunk_size_) {
+    const int64_t size = std::min(chunk_size_, full_mask.size() - chunk_start);
+    this->call_for_mask_slice(full_mask, IndexRange(chunk_start, size), params, context);
+  }
+}
+
+void MFProcedureExecutor::execute(IndexMask full_mask, MFParams params, MFContext context) const
 {
   BLI_assert(procedure_.validate());
 
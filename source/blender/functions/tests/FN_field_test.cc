@@ -289,4 +289,52 @@ TEST(field, IgnoredOutput)
   EXPECT_EQ(results.get(3), 5);
 }
 
+TEST(field, ChangedConstantInSameTree)
+{
+  static CustomMF_SI_SI_SO<int, int, int> add_fn{"add", [](int a, int b) { return a + b; }};
+  GField index_field{std::make_shared<IndexFieldInput>()};
+
+  for (const int constant : {5, 10}) {
+    /* Both field trees have the same structure, but the constant must not be shared. */
+    GField constant_field{std::make_shared<FieldConstant>(CPPType::get<int>(), &constant)};
+    GField output_field{
+        std::make_shared<FieldOperation>(FieldOperation(add_fn, {index_field, constant_field})),
+        0};
+
+    Array<int> result(4);
+    FieldContext context;
+    FieldEvaluator evaluator{context, 4};
+    evaluator.add_with_destination(output_field, result.as_mutable_span());
+    evaluator.evaluate();
+    EXPECT_EQ(result[0], constant);
+    EXPECT_EQ(result[3], constant + 3);
+  }
+}
+
+TEST(field, IdenticalOperations)
+{
+  static CustomMF_SI_SI_SO<int, int, int> add_fn{"add", [](int a, int b) { return a + b; }};
+  GField index_field{std::make_shared<IndexFieldInput>()};
+
+  /* Separate operations with the same function and inputs. */
+  GField add_field_1{
+      std::make_shared<FieldOperation>(FieldOperation(add_fn, {index_field, index_field})), 0};
+  GField add_field_2{
+      std::make_shared<FieldOperation>(FieldOperation(add_fn, {index_field, index_field})), 0};
+  GField result_field{
+      std::make_shared<FieldOperation>(FieldOperation(add_fn, {add_field_1, add_field_2})), 0};
+
+  Array<int> result_1(10);
+  Array<int> result_2(10);
+  FieldContext context;
+  FieldEvaluator evaluator{context, 10};
+  evaluator.add_with_destination(result_field, result_1.as_mutable_span());
+  evaluator.add_with_destination(add_field_2, result_2.as_mutable_span());
+  evaluator.evaluate();
+  EXPECT_EQ(result_1[0], 0);
+  EXPECT_EQ(result_1[3], 12);
+  EXPECT_EQ(result_2[3], 6);
+  EXPECT_EQ(result_2[9], 18);
+}
+
 }  // namespace blender::fn::tests
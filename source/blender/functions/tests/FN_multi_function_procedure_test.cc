@@ -378,4 +378,101 @@ TEST(multi_function_procedure, BufferReuse)
   EXPECT_EQ(results[4], 53);
 }
 
+TEST(multi_function_procedure, CallAutoLargeMask)
+{
+  /**
+   * procedure(int var1, int *var3) {
+   *   int var2 = var1 + var1;
+   *   var3 = var2 + var1;
+   * }
+   */
+
+  CustomMF_SI_SI_SO<int, int, int> add_fn{"add", [](int a, int b) { return a + b; }};
+
+  MFProcedure procedure;
+  MFProcedureBuilder builder{procedure};
+
+  MFVariable *var1 = &builder.add_single_input_parameter<int>();
+  auto [var2] = builder.add_call<1>(add_fn, {var1, var1});
+  auto [var3] = builder.add_call<1>(add_fn, {var2, var1});
+  builder.add_destruct({var1, var2});
+  builder.add_return();
+  builder.add_output_parameter(*var3);
+
+  EXPECT_TRUE(procedure.validate());
+
+  MFProcedureExecutor executor{procedure};
+
+  /* Large enough to be split into multiple segments with offset indices. */
+  const int64_t size = 100003;
+  Array<int> input_array(size);
+  for (const int64_t i : input_array.index_range()) {
+    input_array[i] = int(i);
+  }
+  Array<int> output_array(size, -1);
+
+  const IndexRange range(1, size - 1);
+  MFParamsBuilder params{executor, size};
+  MFContextBuilder context;
+  params.add_readonly_single_input(input_array.as_span());
+  params.add_uninitialized_single_output(output_array.as_mutable_span());
+
+  executor.call_auto(range, params, context);
+
+  EXPECT_EQ(output_array[0], -1);
+  EXPECT_EQ(output_array[1], 3);
+  EXPECT_EQ(output_array[50000], 150000);
+  EXPECT_EQ(output_array[size - 1], int(size - 1) * 3);
+}
+
+TEST(multi_function_procedure, LargeSparseMask)
+{
+  /**
+   * procedure(int var1, int *var2) {
+   *   var2 = var1 + var1;
+   * }
+   */
+
+  CustomMF_SI_SI_SO<int, int, int> add_fn{"add", [](int a, int b) { return a + b; }};
+
+  MFProcedure procedure;
+  MFProcedureBuilder builder{procedure};
+
+  MFVariable *var1 = &builder.add_single_input_parameter<int>();
+  auto [var2] = builder.add_call<1>(add_fn, {var1, var1});
+  builder.add_destruct(*var1);
+  builder.add_return();
+  builder.add_output_parameter(*var2);
+
+  EXPECT_TRUE(procedure.validate());
+
+  MFProcedureExecutor executor{procedure};
+
+  /* The mask is processed in multiple chunks. */
+  const int64_t size = 30000;
+  Vector<int64_t> indices;
+  for (int64_t i = 1; i < size; i += 3) {
+    indices.append(i);
+  }
+  Array<int> input_array(size);
+  for (const int64_t i : input_array.index_range()) {
+    input_array[i] = int(i);
+  }
+  Array<int> output_array(size, -1);
+
+  MFParamsBuilder params{executor, size};
+  MFContextBuilder context;
+  params.add_readonly_single_input(input_array.as_span());
+  params.add_uninitialized_single_output(output_array.as_mutable_span());
+
+  executor.call(indices.as_span(), params, context);
+
+  EXPECT_EQ(output_array[0], -1);
+  EXPECT_EQ(output_array[1], 2);
+  EXPECT_EQ(output_array[2], -1);
+  EXPECT_EQ(output_array[20002], 40004);
+  EXPECT_EQ(output_array[29998], 59996);
+  EXPECT_EQ(output_array[29999], -1);
+}
+
 }  // namespace blender::fn::tests
@@ -78,6 +78,7 @@ struct AttributeFallbacksArray {
    */
   Array<const void *> array;
 
+  AttributeFallbacksArray() = default;
   AttributeFallbacksArray(int size) : array(size, nullptr)
   {
   }
@@ -339,6 +340,188 @@ static void foreach_geometry_in_reference(
   }
 }
 
+/**
+ * Preprocessed data for an instance reference whose geometry does not contain nested instances.
+ * All instances of such references can be gathered in parallel.
+ */
+struct LeafReferenceInfo {
+  const MeshRealizeInfo *mesh_info = nullptr;
+  const PointCloudRealizeInfo *pointcloud_info = nullptr;
+  const RealizeCurveInfo *curve_info = nullptr;
+};
+
+static std::optional<LeafReferenceInfo> try_get_leaf_reference_info(
+    const GatherTasksInfo &gather_info, const InstanceReference &reference)
+{
+  GeometrySet geometry_set;
+  switch (reference.type()) {
+    case InstanceReference::Type::Object: {
+      geometry_set = object_get_evaluated_geometry_set(reference.object());
+      break;
+    }
+    case InstanceReference::Type::GeometrySet: {
+      geometry_set = reference.geometry_set();
+      break;
+    }
+    case InstanceReference::Type::Collection: {
+      /* Collections can contain many objects with different transforms. */
+      return std::nullopt;
+    }
+    case InstanceReference::Type::None: {
+      return LeafReferenceInfo();
+    }
+  }
+  if (geometry_set.has<InstancesComponent>() || geometry_set.has<VolumeComponent>()) {
+    /* Volumes are rare and only the first one is used, so they don't need the fast path. */
+    return std::nullopt;
+  }
+
+  LeafReferenceInfo info;
+  if (const Mesh *mesh = geometry_set.get_mesh_for_read()) {
+    if (mesh->totvert > 0) {
+      const int mesh_index = gather_info.meshes.order.index_of(mesh);
+      info.mesh_info = &gather_info.meshes.realize_info[mesh_index];
+    }
+  }
+  if (const PointCloud *pointcloud = geometry_set.get_pointcloud_for_read()) {
+    if (pointcloud->totpoint > 0) {
+      const int pointcloud_index = gather_info.pointclouds.order.index_of(pointcloud);
+      info.pointcloud_info = &gather_info.pointclouds.realize_info[pointcloud_index];
+    }
+  }
+  if (const CurveEval *curve = geometry_set.get_curve_for_read()) {
+    if (!curve->splines().is_empty()) {
+      const int curve_index = gather_info.curves.order.index_of(curve);
+      info.curve_info = &gather_info.curves.realize_info[curve_index];
+    }
+  }
+  return info;
+}
+
+/**
+ * Same as #gather_realize_tasks_for_instances, but for instances that only reference geometry
+ * without nested instances. The offsets of all tasks are computed with a prefix sum first, so
+ * that the tasks can be filled in parallel afterwards. This results in the same tasks as the
+ * recursive gathering.
+ */
+static void gather_realize_tasks_for_leaf_instances(
+    GatherTasksInfo &gather_info,
+    const Span<LeafReferenceInfo> reference_infos,
+    const InstancesComponent &instances_component,
+    const float4x4 &base_transform,
+    const InstanceContext &base_instance_context,
+    const Span<int> stored_instance_ids,
+    const Span<std::pair<int, GSpan>> pointcloud_attributes_to_override,
+    const Span<std::pair<int, GSpan>> mesh_attributes_to_override,
+    const Span<std::pair<int, GSpan>> curve_attributes_to_override)
+{
+  const Span<int> handles = instances_component.instance_reference_handles();
+  const Span<float4x4> transforms = instances_component.instance_transforms();
+  GatherTasks &tasks = gather_info.r_tasks;
+  GatherOffsets &offsets = gather_info.r_offsets;
+
+  /* Indices of the tasks created for every instance, -1 if there is none. */
+  struct InstanceTaskIndices {
+    int mesh = -1;
+    int pointcloud = -1;
+    int curve = -1;
+  };
+  Array<InstanceTaskIndices> task_indices(handles.size());
+
+  int mesh_tasks_num = tasks.mesh_tasks.size();
+  int pointcloud_tasks_num = tasks.pointcloud_tasks.size();
+  int curve_tasks_num = tasks.curve_tasks.size();
+  for (const int i : handles.index_range()) {
+    const LeafReferenceInfo &reference_info = reference_infos[handles[i]];
+    if (reference_info.mesh_info != nullptr) {
+      task_indices[i].mesh = mesh_tasks_num++;
+    }
+    if (reference_info.pointcloud_info != nullptr) {
+      task_indices[i].pointcloud = pointcloud_tasks_num++;
+    }
+    if (reference_info.curve_info != nullptr) {
+      task_indices[i].curve = curve_tasks_num++;
+    }
+  }
+  tasks.mesh_tasks.resize(mesh_tasks_num);
+  tasks.pointcloud_tasks.resize(pointcloud_tasks_num);
+  tasks.curve_tasks.resize(curve_tasks_num);
+
+  /* Compute the start indices of the tasks in the realized geometry. */
+  for (const int i : handles.index_range()) {
+    const LeafReferenceInfo &reference_info = reference_infos[handles[i]];
+    if (reference_info.mesh_info != nullptr) {
+      const Mesh &mesh = *reference_info.mesh_info->mesh;
+      RealizeMeshTask &task = tasks.mesh_tasks[task_indices[i].mesh];
+      task.start_indices = offsets.mesh_offsets;
+      task.mesh_info = reference_info.mesh_info;
+      offsets.mesh_offsets.vertex += mesh.totvert;
+      offsets.mesh_offsets.edge += mesh.totedge;
+      offsets.mesh_offsets.loop += mesh.totloop;
+      offsets.mesh_offsets.poly += mesh.totpoly;
+    }
+    if (reference_info.pointcloud_info != nullptr) {
+      RealizePointCloudTask &task = tasks.pointcloud_tasks[task_indices[i].pointcloud];
+      task.start_index = offsets.pointcloud_offset;
+      task.pointcloud_info = reference_info.pointcloud_info;
+      offsets.pointcloud_offset += reference_info.pointcloud_info->pointcloud->totpoint;
+    }
+    if (reference_info.curve_info != nullptr) {
+      RealizeCurveTask &task = tasks.curve_tasks[task_indices[i].curve];
+      task.start_spline_index = offsets.spline_offset;
+      task.curve_info = reference_info.curve_info;
+      offsets.spline_offset += reference_info.curve_info->curve->splines().size();
+    }
+  }
+
+  /* Fill in the remaining data that is more expensive to compute. */
+  threading::parallel_for(handles.index_range(), 1024, [&](const IndexRange range) {
+    InstanceContext instance_context = base_instance_context;
+    for (const int i : range) {
+      for (const std::pair<int, GSpan> &pair : pointcloud_attributes_to_override) {
+        instance_context.pointclouds.array[pair.first] = pair.second[i];
+      }
+      for (const std::pair<int, GSpan> &pair : mesh_attributes_to_override) {
+        instance_context.meshes.array[pair.first] = pair.second[i];
+      }
+      for (const std::pair<int, GSpan> &pair : curve_attributes_to_override) {
+        instance_context.curves.array[pair.first] = pair.second[i];
+      }
+
+      uint32_t local_instance_id = 0;
+      if (gather_info.create_id_attribute_on_any_component) {
+        if (stored_instance_ids.is_empty()) {
+          local_instance_id = (uint32_t)i;
+        }
+        else {
+          local_instance_id = (uint32_t)stored_instance_ids[i];
+        }
+      }
+      const uint32_t instance_id = noise::hash(base_instance_context.id, local_instance_id);
+      const float4x4 transform = base_transform * transforms[i];
+
+      if (task_indices[i].mesh != -1) {
+        RealizeMeshTask &task = tasks.mesh_tasks[task_indices[i].mesh];
+        task.transform = transform;
+        task.attribute_fallbacks = instance_context.meshes;
+        task.id = instance_id;
+      }
+      if (task_indices[i].pointcloud != -1) {
+        RealizePointCloudTask &task = tasks.pointcloud_tasks[task_indices[i].pointcloud];
+        task.transform = transform;
+        task.attribute_fallbacks = instance_context.pointclouds;
+        task.id = instance_id;
+      }
+      if (task_indices[i].curve != -1) {
+        RealizeCurveTask &task = tasks.curve_tasks[task_indices[i].curve];
+        task.transform = transform;
+        task.attribute_fallbacks = instance_context.curves;
+        task.id = instance_id;
+      }
+    }
+  });
+}
+
 static void gather_realize_tasks_for_instances(GatherTasksInfo &gather_info,
                                                const InstancesComponent &instances_component,
                                                const float4x4 &base_transform,
@@ -365,6 +548,28 @@ static void gather_realize_tasks_for_instances(GatherTasksInfo &gather_info,
   Vector<std::pair<int, GSpan>> curve_attributes_to_override = prepare_attribute_fallbacks(
       gather_info, instances_component, gather_info.curves.attributes);
 
+  /* Use the parallel code path when no reference contains nested instances. */
+  Vector<LeafReferenceInfo> leaf_reference_infos;
+  for (const InstanceReference &reference : references) {
+    std::optional<LeafReferenceInfo> info = try_get_leaf_reference_info(gather_info, reference);
+    if (!info.has_value()) {
+      break;
+    }
+    leaf_reference_infos.append(*info);
+  }
+  if (leaf_reference_infos.size() == references.size()) {
+    gather_realize_tasks_for_leaf_instances(gather_info,
+                                            leaf_reference_infos,
+                                            instances_component,
+                                            base_transform,
+                                            base_instance_context,
+                                            stored_instance_ids,
+                                            pointcloud_attributes_to_override,
+                                            mesh_attributes_to_override,
+                                            curve_attributes_to_override);
+    return;
+  }
+
   for (const int i : transforms.index_range()) {
     const int handle = handles[i];
     const float4x4 &transform = transforms[i];
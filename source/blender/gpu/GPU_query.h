@@ -0,0 +1,53 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2020 Blender Foundation.
+ * All rights reserved.
+ */
+
+/** \file
+ * \ingroup gpu
+ *
+ * GPUQueryPool is an API to issue occlusion queries and to get their results afterwards.
+ * Results should be read one redraw later to avoid waiting for the GPU.
+ */
+
+#pragma once
+
+#include "BLI_sys_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Opaque type hiding blender::gpu::QueryPool. */
+typedef struct GPUQueryPool GPUQueryPool;
+
+GPUQueryPool *GPU_occlusion_query_pool_create(void);
+void GPU_query_pool_discard(GPUQueryPool *pool);
+
+/* Every query gets the index of the number of queries issued before it. */
+void GPU_query_begin(GPUQueryPool *pool);
+void GPU_query_end(GPUQueryPool *pool);
+
+/* Return true when the GPU finished all queries issued so far. */
+bool GPU_query_pool_results_available(GPUQueryPool *pool);
+/* Results are either binary or the number of samples drawn. `len` must be the number of queries
+ * issued. NOTE: This is a sync point. */
+void GPU_occlusion_query_results_get(GPUQueryPool *pool, uint32_t *r_values, int len);
+
+#ifdef __cplusplus
+}
+#endif
@@ -633,7 +633,6 @@ void GPU_pbvh_grid_buffers_update(GPU_PBVH_Buffers *buffers,
                                      key->grid_size);
   }
 
-  uint vbo_index_offset = 0;
   /* Build VBO */
   if (gpu_pbvh_vert_buf_data_set(buffers, vert_count)) {
     GPUIndexBufBuilder elb_lines;
@@ -642,10 +641,25 @@ void GPU_pbvh_grid_buffers_update(GPU_PBVH_Buffers *buffers,
       GPU_indexbuf_init(&elb_lines, GPU_PRIM_LINES, totgrid * key->grid_area * 2, vert_count);
     }
 
+    /* Write the attributes through raw steps, vertices are written in order. */
+    GPUVertBufRaw pos_step = {0};
+    GPUVertBufRaw nor_step = {0};
+    GPUVertBufRaw msk_step = {0};
+    GPUVertBufRaw fset_step = {0};
+    GPUVertBufRaw col_step = {0};
+
+    GPU_vertbuf_attr_get_raw_data(buffers->vert_buf, g_vbo_id.pos, &pos_step);
+    GPU_vertbuf_attr_get_raw_data(buffers->vert_buf, g_vbo_id.nor, &nor_step);
+    GPU_vertbuf_attr_get_raw_data(buffers->vert_buf, g_vbo_id.msk, &msk_step);
+    GPU_vertbuf_attr_get_raw_data(buffers->vert_buf, g_vbo_id.fset, &fset_step);
+    GPU_vertbuf_attr_get_raw_data(buffers->vert_buf, g_vbo_id.col, &col_step);
+
+    const bool use_mask = has_mask && show_mask;
+    const ushort vcol[4] = {USHRT_MAX, USHRT_MAX, USHRT_MAX, USHRT_MAX};
+
     for (i = 0; i < totgrid; i++) {
       const int grid_index = grid_indices[i];
       CCGElem *grid = grids[grid_index];
-      int vbo_index = vbo_index_offset;
 
       uchar face_set_color[4] = {UCHAR_MAX, UCHAR_MAX, UCHAR_MAX, UCHAR_MAX};
 
@@ -664,31 +678,23 @@ void GPU_pbvh_grid_buffers_update(GPU_PBVH_Buffers *buffers,
         for (y = 0; y < key->grid_size; y++) {
           for (x = 0; x < key->grid_size; x++) {
             CCGElem *elem = CCG_grid_elem(key, grid, x, y);
-            GPU_vertbuf_attr_set(
-                buffers->vert_buf, g_vbo_id.pos, vbo_index, CCG_elem_co(key, elem));
-
-            short no_short[3];
-            normal_float_to_short_v3(no_short, CCG_elem_no(key, elem));
-            GPU_vertbuf_attr_set(buffers->vert_buf, g_vbo_id.nor, vbo_index, no_short);
+            copy_v3_v3(GPU_vertbuf_raw_step(&pos_step), CCG_elem_co(key, elem));
+            normal_float_to_short_v3(GPU_vertbuf_raw_step(&nor_step), CCG_elem_no(key, elem));
 
-            if (has_mask && show_mask) {
+            if (use_mask) {
               float fmask = *CCG_elem_mask(key, elem);
               uchar cmask = (uchar)(fmask * 255);
-              GPU_vertbuf_attr_set(buffers->vert_buf, g_vbo_id.msk, vbo_index, &cmask);
+              *(uchar *)GPU_vertbuf_raw_step(&msk_step) = cmask;
               empty_mask = empty_mask && (cmask == 0);
             }
 
             if (show_vcol) {
-              const ushort vcol[4] = {USHRT_MAX, USHRT_MAX, USHRT_MAX, USHRT_MAX};
-              GPU_vertbuf_attr_set(buffers->vert_buf, g_vbo_id.col, vbo_index, &vcol);
+              memcpy(GPU_vertbuf_raw_step(&col_step), vcol, sizeof(vcol));
             }
 
-            GPU_vertbuf_attr_set(buffers->vert_buf, g_vbo_id.fset, vbo_index, &face_set_color);
-
-            vbo_index += 1;
+            memcpy(GPU_vertbuf_raw_step(&fset_step), face_set_color, sizeof(uchar[3]));
           }
         }
-        vbo_index_offset += key->grid_area;
       }
       else {
         for (j = 0; j < key->grid_size - 1; j++) {
@@ -712,42 +718,26 @@ void GPU_pbvh_grid_buffers_update(GPU_PBVH_Buffers *buffers,
             normal_quad_v3(fno, co[3], co[2], co[1], co[0]);
             normal_float_to_short_v3(no_short, fno);
 
-            GPU_vertbuf_attr_set(buffers->vert_buf, g_vbo_id.pos, vbo_index + 0, co[0]);
-            GPU_vertbuf_attr_set(buffers->vert_buf, g_vbo_id.nor, vbo_index + 0, no_short);
-            GPU_vertbuf_attr_set(buffers->vert_buf, g_vbo_id.pos, vbo_index + 1, co[1]);
-            GPU_vertbuf_attr_set(buffers->vert_buf, g_vbo_id.nor, vbo_index + 1, no_short);
-            GPU_vertbuf_attr_set(buffers->vert_buf, g_vbo_id.pos, vbo_index + 2, co[2]);
-            GPU_vertbuf_attr_set(buffers->vert_buf, g_vbo_id.nor, vbo_index + 2, no_short);
-            GPU_vertbuf_attr_set(buffers->vert_buf, g_vbo_id.pos, vbo_index + 3, co[3]);
-            GPU_vertbuf_attr_set(buffers->vert_buf, g_vbo_id.nor, vbo_index + 3, no_short);
-
-            if (has_mask && show_mask) {
+            uchar cmask = 0;
+            if (use_mask) {
               float fmask = (*CCG_elem_mask(key, elems[0]) + *CCG_elem_mask(key, elems[1]) +
                              *CCG_elem_mask(key, elems[2]) + *CCG_elem_mask(key, elems[3])) *
                             0.25f;
-              uchar cmask = (uchar)(fmask * 255);
-              GPU_vertbuf_attr_set(buffers->vert_buf, g_vbo_id.msk, vbo_index + 0, &cmask);
-              GPU_vertbuf_attr_set(buffers->vert_buf, g_vbo_id.msk, vbo_index + 1, &cmask);
-              GPU_vertbuf_attr_set(buffers->vert_buf, g_vbo_id.msk, vbo_index + 2, &cmask);
-              GPU_vertbuf_attr_set(buffers->vert_buf, g_vbo_id.msk, vbo_index + 3, &cmask);
+              cmask = (uchar)(fmask * 255);
               empty_mask = empty_mask && (cmask == 0);
             }
 
-            const ushort vcol[4] = {USHRT_MAX, USHRT_MAX, USHRT_MAX, USHRT_MAX};
-            GPU_vertbuf_attr_set(buffers->vert_buf, g_vbo_id.col, vbo_index + 0, &vcol);
-            GPU_vertbuf_attr_set(buffers->vert_buf, g_vbo_id.col, vbo_index + 1, &vcol);
-            GPU_vertbuf_attr_set(buffers->vert_buf, g_vbo_id.col, vbo_index + 2, &vcol);
-            GPU_vertbuf_attr_set(buffers->vert_buf, g_vbo_id.col, vbo_index + 3, &vcol);
-
-            GPU_vertbuf_attr_set(buffers->vert_buf, g_vbo_id.fset, vbo_index + 0, &face_set_color);
-            GPU_vertbuf_attr_set(buffers->vert_buf, g_vbo_id.fset, vbo_index + 1, &face_set_color);
-            GPU_vertbuf_attr_set(buffers->vert_buf, g_vbo_id.fset, vbo_index + 2, &face_set_color);
-            GPU_vertbuf_attr_set(buffers->vert_buf, g_vbo_id.fset, vbo_index + 3, &face_set_color);
-
-            vbo_index += 4;
+            for (int corner = 0; corner < 4; corner++) {
+              copy_v3_v3(GPU_vertbuf_raw_step(&pos_step), co[corner]);
+              copy_v3_v3_short(GPU_vertbuf_raw_step(&nor_step), no_short);
+              if (use_mask) {
+                *(uchar *)GPU_vertbuf_raw_step(&msk_step) = cmask;
+              }
+              memcpy(GPU_vertbuf_raw_step(&col_step), vcol, sizeof(vcol));
+              memcpy(GPU_vertbuf_raw_step(&fset_step), face_set_color, sizeof(uchar[3]));
+            }
           }
         }
-        vbo_index_offset += square_i(key->grid_size - 1) * 4;
       }
     }
 
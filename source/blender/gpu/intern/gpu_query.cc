@@ -21,8 +21,40 @@
  * \ingroup gpu
  */
 
+#include "gpu_backend.hh"
 #include "gpu_query.hh"
 
 using namespace blender::gpu;
 
-/* TODO(fclem): Make the associated C-API to use inside DRW profiler. */
+GPUQueryPool *GPU_occlusion_query_pool_create()
+{
+  QueryPool *pool = GPUBackend::get()->querypool_alloc();
+  pool->init(GPU_QUERY_OCCLUSION);
+  return wrap(pool);
+}
+
+void GPU_query_pool_discard(GPUQueryPool *pool)
+{
+  delete unwrap(pool);
+}
+
+void GPU_query_begin(GPUQueryPool *pool)
+{
+  unwrap(pool)->begin_query();
+}
+
+void GPU_query_end(GPUQueryPool *pool)
+{
+  unwrap(pool)->end_query();
+}
+
+bool GPU_query_pool_results_available(GPUQueryPool *pool)
+{
+  return unwrap(pool)->result_available();
+}
+
+void GPU_occlusion_query_results_get(GPUQueryPool *pool, uint32_t *r_values, int len)
+{
+  BLI_assert(len == unwrap(pool)->query_issued_len());
+  unwrap(pool)->get_occlusion_result(blender::MutableSpan<uint32_t>(r_values, len));
+}
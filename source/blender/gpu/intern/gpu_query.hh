@@ -25,6 +25,8 @@
 
 #include "BLI_span.hh"
 
+#include "GPU_query.h"
+
 namespace blender::gpu {
 
 typedef enum GPUQueryType {
@@ -54,6 +56,22 @@ class QueryPool {
    * drawn.
    */
   virtual void get_occlusion_result(MutableSpan<uint32_t> r_values) = 0;
+
+  /** Return true when the results of all issued queries can be read without waiting. */
+  virtual bool result_available() = 0;
+
+  /** Number of queries issued since initialization. */
+  virtual int query_issued_len() const = 0;
 };
 
+/* Syntactic sugar. */
+static inline GPUQueryPool *wrap(QueryPool *pool)
+{
+  return reinterpret_cast<GPUQueryPool *>(pool);
+}
+static inline QueryPool *unwrap(GPUQueryPool *pool)
+{
+  return reinterpret_cast<QueryPool *>(pool);
+}
+
 }  // namespace blender::gpu
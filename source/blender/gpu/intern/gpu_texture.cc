@@ -177,6 +177,19 @@ void Texture::update(eGPUDataFormat format, const void *data)
   this->update_sub(mip, offset, extent, format, data);
 }
 
+size_t Texture::memory_size_get() const
+{
+  const size_t pixel_size = to_bytesize(format_);
+  size_t size = 0;
+  for (int mip = 0; mip <= max_ii(0, mipmaps_); mip++) {
+    int extent[3] = {1, 1, 1};
+    this->mip_size_get(mip, extent);
+    size += pixel_size * size_t(extent[0]) * size_t(max_ii(1, extent[1])) *
+            size_t(max_ii(1, extent[2]));
+  }
+  return size;
+}
+
 /** \} */
 
 }  // namespace blender::gpu
@@ -543,6 +556,11 @@ int GPU_texture_orig_height(const GPUTexture *tex)
   return reinterpret_cast<const Texture *>(tex)->src_h;
 }
 
+size_t GPU_texture_memory_size_get(const GPUTexture *tex)
+{
+  return reinterpret_cast<const Texture *>(tex)->memory_size_get();
+}
+
 void GPU_texture_orig_size_set(GPUTexture *tex_, int w, int h)
 {
   Texture *tex = reinterpret_cast<Texture *>(tex_);
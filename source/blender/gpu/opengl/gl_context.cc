@@ -36,6 +36,7 @@
 
 #include "gl_debug.hh"
 #include "gl_immediate.hh"
+#include "gl_staging_buffer.hh"
 #include "gl_state.hh"
 #include "gl_uniform_buffer.hh"
 
@@ -62,6 +63,12 @@ GLContext::GLContext(void *ghost_window, GLSharedOrphanLists &shared_orphan_list
   glBufferData(GL_ARRAY_BUFFER, sizeof(data), data, GL_STATIC_DRAW);
   glBindBuffer(GL_ARRAY_BUFFER, 0);
 
+  if (GLContext::parallel_shader_compile_support) {
+    /* Let the driver use as many threads as it wants, so that the shader stages of a program
+     * compile in parallel. */
+    glMaxShaderCompilerThreadsARB(0xFFFFFFFF);
+  }
+
   state_manager = new GLStateManager();
   imm = new GLImmediate();
   ghost_window_ = ghost_window;
@@ -113,6 +120,7 @@ GLContext::~GLContext()
     cache->clear();
   }
   glDeleteBuffers(1, &default_attr_vbo_);
+  delete staging_buffer_;
 }
 
 /** \} */
@@ -266,6 +274,17 @@ void GLContext::buf_free(GLuint buf_id)
   }
 }
 
+bool GLContext::buf_staging_upload(GLenum target, size_t size, const void *data)
+{
+  if (!buffer_storage_support) {
+    return false;
+  }
+  if (staging_buffer_ == nullptr) {
+    staging_buffer_ = new GLStagingBuffer();
+  }
+  return staging_buffer_->upload(target, size, data);
+}
+
 void GLContext::tex_free(GLuint tex_id)
 {
   /* Any context can free. */
@@ -39,6 +39,7 @@
 namespace blender {
 namespace gpu {
 
+class GLStagingBuffer;
 class GLVaoCache;
 
 class GLSharedOrphanLists {
@@ -65,6 +66,7 @@ class GLContext : public Context {
   /** Extensions. */
 
   static bool base_instance_support;
+  static bool buffer_storage_support;
   static bool clear_texture_support;
   static bool copy_image_support;
   static bool debug_layer_support;
@@ -72,6 +74,8 @@ class GLContext : public Context {
   static bool fixed_restart_index_support;
   static bool multi_bind_support;
   static bool multi_draw_indirect_support;
+  static bool parallel_shader_compile_support;
+  static bool program_binary_support;
   static bool shader_draw_parameters_support;
   static bool texture_cube_map_array_support;
   static bool texture_filter_anisotropic_support;
@@ -105,6 +109,8 @@ class GLContext : public Context {
   Vector<GLuint> orphaned_framebuffers_;
   /** #GLBackend owns this data. */
   GLSharedOrphanLists &shared_orphan_list_;
+  /** Created on first use. */
+  GLStagingBuffer *staging_buffer_ = nullptr;
 
  public:
   GLContext(void *ghost_window, GLSharedOrphanLists &shared_orphan_list);
@@ -136,6 +142,11 @@ class GLContext : public Context {
   void fbo_free(GLuint fbo_id);
   /* These can be called by any threads even without OpenGL ctx. Deletion will be delayed. */
   static void buf_free(GLuint buf_id);
+  /**
+   * Upload data at the beginning of the buffer bound to \a target through the staging buffer.
+   * Return false when the caller has to upload the data itself.
+   */
+  bool buf_staging_upload(GLenum target, size_t size, const void *data);
   static void tex_free(GLuint tex_id);
 
   void vao_cache_register(GLVaoCache *cache);
@@ -50,7 +50,11 @@ void GLIndexBuf::bind()
   if (data_ != nullptr || allocate_on_device) {
     size_t size = this->size_get();
     /* Sends data to GPU. */
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, size, data_, GL_STATIC_DRAW);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, size, nullptr, GL_STATIC_DRAW);
+    if (data_ != nullptr &&
+        !GLContext::get()->buf_staging_upload(GL_ELEMENT_ARRAY_BUFFER, size, data_)) {
+      glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, size, data_);
+    }
     /* No need to keep copy of data in system memory. */
     MEM_SAFE_FREE(data_);
   }
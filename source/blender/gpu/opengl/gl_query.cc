@@ -75,4 +75,15 @@ void GLQueryPool::get_occlusion_result(MutableSpan<uint32_t> r_values)
   }
 }
 
+bool GLQueryPool::result_available()
+{
+  if (query_issued_ == 0) {
+    return true;
+  }
+  /* Queries complete in order, so the last one is enough. */
+  GLuint available = GL_FALSE;
+  glGetQueryObjectuiv(query_ids_[query_issued_ - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+  return available == GL_TRUE;
+}
+
 }  // namespace blender::gpu
@@ -54,6 +54,13 @@ class GLQueryPool : public QueryPool {
   void end_query() override;
 
   void get_occlusion_result(MutableSpan<uint32_t> r_values) override;
+
+  bool result_available() override;
+
+  int query_issued_len() const override
+  {
+    return int(query_issued_);
+  }
 };
 
 static inline GLenum to_gl(GPUQueryType type)
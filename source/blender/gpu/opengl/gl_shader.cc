@@ -151,67 +151,153 @@ GLuint GLShader::create_shader_stage(GLenum gl_stage, MutableSpan<const char *>
   glShaderSource(shader, sources.size(), sources.data(), nullptr);
   glCompileShader(shader);
 
-  GLint status;
-  glGetShaderiv(shader, GL_COMPILE_STATUS, &status);
-  if (!status || (G.debug & G_DEBUG_GPU)) {
-    char log[5000] = "";
-    glGetShaderInfoLog(shader, sizeof(log), nullptr, log);
-    if (log[0] != '\0') {
-      GLLogParser parser;
-      switch (gl_stage) {
-        case GL_VERTEX_SHADER:
-          this->print_log(sources, log, "VertShader", !status, &parser);
-          break;
-        case GL_GEOMETRY_SHADER:
-          this->print_log(sources, log, "GeomShader", !status, &parser);
-          break;
-        case GL_FRAGMENT_SHADER:
-          this->print_log(sources, log, "FragShader", !status, &parser);
-          break;
-        case GL_COMPUTE_SHADER:
-          this->print_log(sources, log, "ComputeShader", !status, &parser);
-          break;
+  /* The compilation status is only queried in #check_compiled_stages, so that drivers with
+   * parallel shader compilation can compile all stages of the program at the same time. The
+   * sources stay valid until the shader is finalized. */
+  compiled_stages_.append({gl_stage, shader, Vector<const char *>(sources.as_span())});
+  return shader;
+}
+
+void GLShader::check_compiled_stages()
+{
+  for (CompiledStage &stage : compiled_stages_) {
+    GLint status;
+    glGetShaderiv(stage.shader, GL_COMPILE_STATUS, &status);
+    if (!status || (G.debug & G_DEBUG_GPU)) {
+      char log[5000] = "";
+      glGetShaderInfoLog(stage.shader, sizeof(log), nullptr, log);
+      if (log[0] != '\0') {
+        GLLogParser parser;
+        switch (stage.gl_stage) {
+          case GL_VERTEX_SHADER:
+            this->print_log(stage.sources, log, "VertShader", !status, &parser);
+            break;
+          case GL_GEOMETRY_SHADER:
+            this->print_log(stage.sources, log, "GeomShader", !status, &parser);
+            break;
+          case GL_FRAGMENT_SHADER:
+            this->print_log(stage.sources, log, "FragShader", !status, &parser);
+            break;
+          case GL_COMPUTE_SHADER:
+            this->print_log(stage.sources, log, "ComputeShader", !status, &parser);
+            break;
+        }
       }
     }
+    if (!status) {
+      glDeleteShader(stage.shader);
+      this->stage_handle_get(stage.gl_stage) = 0;
+      compilation_failed_ = true;
+      continue;
+    }
+
+    debug::object_label(stage.gl_stage, stage.shader, name);
+
+    glAttachShader(shader_program_, stage.shader);
   }
-  if (!status) {
-    glDeleteShader(shader);
-    compilation_failed_ = true;
-    return 0;
+  compiled_stages_.clear();
+}
+
+GLuint &GLShader::stage_handle_get(GLenum gl_stage)
+{
+  switch (gl_stage) {
+    case GL_GEOMETRY_SHADER:
+      return geom_shader_;
+    case GL_FRAGMENT_SHADER:
+      return frag_shader_;
+    case GL_COMPUTE_SHADER:
+      return compute_shader_;
+    default:
+      BLI_assert(gl_stage == GL_VERTEX_SHADER);
+      return vert_shader_;
   }
+}
 
-  debug::object_label(gl_stage, shader, name);
+GLuint GLShader::shader_stage_from_glsl(GLenum gl_stage, MutableSpan<const char *> sources)
+{
+  /* Always compile when debugging, to get the compilation warnings. */
+  if (!GLContext::program_binary_support || (G.debug & G_DEBUG_GPU)) {
+    return this->create_shader_stage(gl_stage, sources);
+  }
+  /* The patch is part of the sources that identify the program. */
+  sources[0] = glsl_patch_get(gl_stage);
 
-  glAttachShader(shader_program_, shader);
-  return shader;
+  deferred_stages_.append({gl_stage, {}});
+  DeferredStage &stage = deferred_stages_.last();
+  for (const char *source : sources) {
+    stage.sources.append(source);
+  }
+  return 0;
+}
+
+void GLShader::compile_deferred_stages()
+{
+  for (const DeferredStage &stage : deferred_stages_) {
+    Vector<const char *> sources;
+    for (const std::string &source : stage.sources) {
+      sources.append(source.c_str());
+    }
+    this->stage_handle_get(stage.gl_stage) = this->create_shader_stage(stage.gl_stage, sources);
+  }
+}
+
+std::string GLShader::program_cache_key() const
+{
+  std::string key;
+  for (const DeferredStage &stage : deferred_stages_) {
+    key += "#pragma BLENDER_STAGE " + std::to_string(stage.gl_stage) + "\n";
+    for (const std::string &source : stage.sources) {
+      key += source;
+    }
+  }
+  key += transform_feedback_key_;
+  return key;
 }
 
 void GLShader::vertex_shader_from_glsl(MutableSpan<const char *> sources)
 {
-  vert_shader_ = this->create_shader_stage(GL_VERTEX_SHADER, sources);
+  vert_shader_ = this->shader_stage_from_glsl(GL_VERTEX_SHADER, sources);
 }
 
 void GLShader::geometry_shader_from_glsl(MutableSpan<const char *> sources)
 {
-  geom_shader_ = this->create_shader_stage(GL_GEOMETRY_SHADER, sources);
+  geom_shader_ = this->shader_stage_from_glsl(GL_GEOMETRY_SHADER, sources);
 }
 
 void GLShader::fragment_shader_from_glsl(MutableSpan<const char *> sources)
 {
-  frag_shader_ = this->create_shader_stage(GL_FRAGMENT_SHADER, sources);
+  frag_shader_ = this->shader_stage_from_glsl(GL_FRAGMENT_SHADER, sources);
 }
 
 void GLShader::compute_shader_from_glsl(MutableSpan<const char *> sources)
 {
-  compute_shader_ = this->create_shader_stage(GL_COMPUTE_SHADER, sources);
+  compute_shader_ = this->shader_stage_from_glsl(GL_COMPUTE_SHADER, sources);
 }
 
 bool GLShader::finalize()
 {
+  std::string cache_key;
+  if (!deferred_stages_.is_empty()) {
+    cache_key = this->program_cache_key();
+    if (GLShaderCache::program_load(shader_program_, cache_key)) {
+      deferred_stages_.clear();
+      interface = new GLShaderInterface(shader_program_);
+      return true;
+    }
+    this->compile_deferred_stages();
+  }
+
+  this->check_compiled_stages();
+  /* The sources of the compiled stages are not used anymore. */
+  deferred_stages_.clear();
+
   if (compilation_failed_) {
     return false;
   }
 
+  if (!cache_key.empty()) {
+    glProgramParameteri(shader_program_, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+  }
   glLinkProgram(shader_program_);
 
   GLint status;
@@ -225,6 +311,10 @@ bool GLShader::finalize()
     return false;
   }
 
+  if (!cache_key.empty()) {
+    GLShaderCache::program_store(shader_program_, cache_key);
+  }
+
   interface = new GLShaderInterface(shader_program_);
 
   return true;
@@ -263,6 +353,11 @@ void GLShader::transform_feedback_names_set(Span<const char *> name_list,
   glTransformFeedbackVaryings(
       shader_program_, name_list.size(), name_list.data(), GL_INTERLEAVED_ATTRIBS);
   transform_feedback_type_ = geom_type;
+
+  transform_feedback_key_ = "#pragma BLENDER_TRANSFORM_FEEDBACK " + std::to_string(geom_type);
+  for (const char *name : name_list) {
+    transform_feedback_key_ += std::string(" ") + name;
+  }
 }
 
 bool GLShader::transform_feedback_enable(GPUVertBuf *buf_)
@@ -23,8 +23,12 @@
 
 #pragma once
 
+#include <string>
+
 #include "MEM_guardedalloc.h"
 
+#include "BLI_vector.hh"
+
 #include "glew-mx.h"
 
 #include "gpu_shader_private.hh"
@@ -47,6 +51,26 @@ class GLShader : public Shader {
   /** True if any shader failed to compile. */
   bool compilation_failed_ = false;
 
+  /**
+   * Sources of the shader stages when the program binary cache is used. They are only compiled
+   * when no binary has been cached for them.
+   */
+  struct DeferredStage {
+    GLenum gl_stage;
+    Vector<std::string> sources;
+  };
+  Vector<DeferredStage> deferred_stages_;
+  /** Transform feedback varyings are part of the linked program too. */
+  std::string transform_feedback_key_;
+
+  /** Stages which have been compiled, but whose status has not been checked yet. */
+  struct CompiledStage {
+    GLenum gl_stage;
+    GLuint shader;
+    Vector<const char *> sources;
+  };
+  Vector<CompiledStage> compiled_stages_;
+
   eGPUShaderTFBType transform_feedback_type_ = GPU_SHADER_TFB_NONE;
 
  public:
@@ -80,12 +104,33 @@ class GLShader : public Shader {
  private:
   char *glsl_patch_get(GLenum gl_stage);
 
-  /** Create, compile and attach the shader stage to the shader program. */
+  /** Create the shader stage and start its compilation. */
   GLuint create_shader_stage(GLenum gl_stage, MutableSpan<const char *> sources);
+  /** Check the compilation status of the stages and attach them to the shader program. */
+  void check_compiled_stages();
+  GLuint &stage_handle_get(GLenum gl_stage);
+  /** Create the stage, or keep its sources when the program binary cache is used. */
+  GLuint shader_stage_from_glsl(GLenum gl_stage, MutableSpan<const char *> sources);
+  void compile_deferred_stages();
+  /** Identifies the program in the binary cache. */
+  std::string program_cache_key() const;
 
   MEM_CXX_CLASS_ALLOC_FUNCS("GLShader");
 };
 
+/**
+ * On disk cache of linked shader program binaries, so that shaders don't have to be compiled
+ * again every time Blender starts. Programs are identified by their full sources and are only
+ * reused with the same driver and GPU.
+ */
+class GLShaderCache {
+ public:
+  /** Load the cached binary for the key into the program. Return true if it is linked. */
+  static bool program_load(GLuint program, const std::string &key);
+  /** Write the binary of the linked program to the cache. */
+  static void program_store(GLuint program, const std::string &key);
+};
+
 class GLLogParser : public GPULogParser {
  public:
   char *parse_line(char *log_line, GPULogItem &log_item) override;
@@ -0,0 +1,191 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2021 Blender Foundation.
+ * All rights reserved.
+ */
+
+/** \file
+ * \ingroup gpu
+ *
+ * Every cached program is stored in its own file, named after a hash of the sources. The file
+ * also contains the full sources, so that hash collisions can't result in using a wrong program.
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <thread>
+
+#include "BKE_appdir.h"
+
+#include "BLI_fileops.h"
+#include "BLI_hash_mm2a.h"
+#include "BLI_path_util.h"
+#include "BLI_string.h"
+#include "BLI_system.h"
+
+#include BLI_SYSTEM_PID_H
+
+#include "gl_context.hh"
+#include "gl_shader.hh"
+
+namespace blender::gpu {
+
+/** Change when the layout of the files changes. */
+static constexpr char cache_file_magic[8] = {'B', 'G', 'L', 'P', 'R', 'G', '0', '1'};
+
+struct CacheFileHeader {
+  char magic[8];
+  /** Hash of the identification strings of the driver and GPU the binary was created with. */
+  uint32_t driver_hash;
+  uint32_t binary_format;
+  uint64_t key_len;
+  uint64_t binary_len;
+};
+
+static uint32_t driver_hash_get()
+{
+  static const uint32_t hash = []() {
+    std::string driver;
+    for (const GLenum name : {GL_VENDOR, GL_RENDERER, GL_VERSION, GL_SHADING_LANGUAGE_VERSION}) {
+      const char *str = (const char *)glGetString(name);
+      driver += (str) ? str : "";
+      driver += '\n';
+    }
+    return BLI_hash_mm2((const unsigned char *)driver.data(), driver.size(), 0);
+  }();
+  return hash;
+}
+
+/** Empty when there is no directory to store the cache in. */
+static const std::string &cache_dir_get()
+{
+  static const std::string dir = []() -> std::string {
+    char path[FILE_MAX];
+    if (!BKE_appdir_folder_caches(path, sizeof(path))) {
+      return "";
+    }
+    BLI_path_append(path, sizeof(path), "shaders");
+    BLI_path_slash_ensure(path);
+    if (!BLI_dir_create_recursive(path)) {
+      return "";
+    }
+    return path;
+  }();
+  return dir;
+}
+
+static std::string cache_file_path_get(const std::string &key)
+{
+  const std::string &dir = cache_dir_get();
+  if (dir.empty()) {
+    return "";
+  }
+  const unsigned char *data = (const unsigned char *)key.data();
+  char name[32];
+  BLI_snprintf(name,
+               sizeof(name),
+               "%08x%08x.bin",
+               BLI_hash_mm2(data, key.size(), 0),
+               BLI_hash_mm2(data, key.size(), 1));
+  return dir + name;
+}
+
+bool GLShaderCache::program_load(GLuint program, const std::string &key)
+{
+  const std::string path = cache_file_path_get(key);
+  if (path.empty() || !BLI_exists(path.c_str())) {
+    return false;
+  }
+  const size_t file_size = BLI_file_size(path.c_str());
+  FILE *file = BLI_fopen(path.c_str(), "rb");
+  if (file == nullptr) {
+    return false;
+  }
+
+  bool is_linked = false;
+  CacheFileHeader header;
+  if (fread(&header, sizeof(header), 1, file) == 1 &&
+      memcmp(header.magic, cache_file_magic, sizeof(cache_file_magic)) == 0 &&
+      header.driver_hash == driver_hash_get() && header.key_len == key.size() &&
+      sizeof(header) + header.key_len + header.binary_len == file_size) {
+    std::string file_key(key.size(), '\0');
+    Vector<char> binary(int64_t(header.binary_len));
+    if (fread(file_key.data(), 1, file_key.size(), file) == file_key.size() && file_key == key &&
+        fread(binary.data(), 1, size_t(binary.size()), file) == size_t(binary.size())) {
+      glProgramBinary(program, header.binary_format, binary.data(), GLsizei(binary.size()));
+      GLint status;
+      glGetProgramiv(program, GL_LINK_STATUS, &status);
+      is_linked = status;
+    }
+  }
+  fclose(file);
+
+  if (!is_linked) {
+    /* Outdated, e.g. after a driver update. It is written again after compiling. */
+    BLI_delete(path.c_str(), false, false);
+  }
+  return is_linked;
+}
+
+void GLShaderCache::program_store(GLuint program, const std::string &key)
+{
+  const std::string path = cache_file_path_get(key);
+  if (path.empty()) {
+    return;
+  }
+
+  GLint binary_len = 0;
+  glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &binary_len);
+  if (binary_len <= 0) {
+    return;
+  }
+  Vector<char> binary(binary_len);
+  GLsizei written_len = 0;
+  GLenum binary_format = 0;
+  glGetProgramBinary(program, binary_len, &written_len, &binary_format, binary.data());
+  if (written_len <= 0) {
+    return;
+  }
+
+  CacheFileHeader header;
+  memcpy(header.magic, cache_file_magic, sizeof(cache_file_magic));
+  header.driver_hash = driver_hash_get();
+  header.binary_format = binary_format;
+  header.key_len = key.size();
+  header.binary_len = uint64_t(written_len);
+
+  /* Write to a temporary file first, so that other threads and Blender instances never read a
+   * partially written file. */
+  const size_t thread_hash = std::hash<std::thread::id>()(std::this_thread::get_id());
+  const std::string tmp_path = path + "." + std::to_string(getpid()) + "." +
+                               std::to_string(thread_hash) + ".tmp";
+  FILE *file = BLI_fopen(tmp_path.c_str(), "wb");
+  if (file == nullptr) {
+    return;
+  }
+  const bool is_written = fwrite(&header, sizeof(header), 1, file) == 1 &&
+                          fwrite(key.data(), 1, key.size(), file) == key.size() &&
+                          fwrite(binary.data(), 1, size_t(written_len), file) ==
+                              size_t(written_len);
+  fclose(file);
+
+  if (!is_written || BLI_rename(tmp_path.c_str(), path.c_str()) != 0) {
+    BLI_delete(tmp_path.c_str(), false, false);
+  }
+}
+
+}  // namespace blender::gpu
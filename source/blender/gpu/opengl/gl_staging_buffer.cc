@@ -0,0 +1,119 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Copyright 2021, Blender Foundation.
+ * All rights reserved.
+ */
+
+/** \file
+ * \ingroup gpu
+ */
+
+#include <cstring>
+
+#include "gl_context.hh"
+
+#include "gl_staging_buffer.hh"
+
+namespace blender::gpu {
+
+/** Keep allocations aligned so copies from the staging buffer can use the fast path. */
+#define STAGING_ALIGNMENT 256
+
+GLStagingBuffer::GLStagingBuffer()
+{
+  const GLsizeiptr size = segment_size * segments_len;
+  const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+  glGenBuffers(1, &buffer_id_);
+  glBindBuffer(GL_COPY_READ_BUFFER, buffer_id_);
+  glBufferStorage(GL_COPY_READ_BUFFER, size, nullptr, flags);
+  data_ = (uchar *)glMapBufferRange(GL_COPY_READ_BUFFER, 0, size, flags);
+  glBindBuffer(GL_COPY_READ_BUFFER, 0);
+}
+
+GLStagingBuffer::~GLStagingBuffer()
+{
+  for (GLsync &fence : fences_) {
+    if (fence != nullptr) {
+      glDeleteSync(fence);
+    }
+  }
+  if (data_ != nullptr) {
+    glBindBuffer(GL_COPY_READ_BUFFER, buffer_id_);
+    glUnmapBuffer(GL_COPY_READ_BUFFER);
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+  }
+  glDeleteBuffers(1, &buffer_id_);
+}
+
+void GLStagingBuffer::segment_wait(int segment)
+{
+  GLsync &fence = fences_[segment];
+  if (fence == nullptr) {
+    return;
+  }
+  /* Usually signaled already, the ring contains multiple frames worth of uploads. */
+  GLenum result = glClientWaitSync(fence, 0, 0);
+  while (!ELEM(result, GL_ALREADY_SIGNALED, GL_CONDITION_SATISFIED, GL_WAIT_FAILED)) {
+    result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+  }
+  glDeleteSync(fence);
+  fence = nullptr;
+}
+
+void GLStagingBuffer::segment_fence(int segment)
+{
+  /* The copies from the segment have all been submitted. */
+  if (fences_[segment] != nullptr) {
+    glDeleteSync(fences_[segment]);
+  }
+  fences_[segment] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+bool GLStagingBuffer::upload(GLenum target, size_t size, const void *data)
+{
+  if (data_ == nullptr || size < min_upload_size || size > segment_size) {
+    return false;
+  }
+
+  size_t offset = offset_;
+  int segment = this->segment_get(offset);
+  if (this->segment_get(offset + size - 1) != segment) {
+    /* Allocations don't span multiple segments, so that every segment can be fenced on its own.
+     * Skip the remaining space of the segment. */
+    this->segment_fence(segment);
+    segment = (segment + 1) % segments_len;
+    offset = segment * segment_size;
+    this->segment_wait(segment);
+  }
+  else if (offset % segment_size == 0) {
+    this->segment_wait(segment);
+  }
+
+  memcpy(data_ + offset, data, size);
+
+  glBindBuffer(GL_COPY_READ_BUFFER, buffer_id_);
+  glCopyBufferSubData(GL_COPY_READ_BUFFER, target, offset, 0, size);
+  glBindBuffer(GL_COPY_READ_BUFFER, 0);
+
+  offset_ = offset + ((size + STAGING_ALIGNMENT - 1) / STAGING_ALIGNMENT) * STAGING_ALIGNMENT;
+  if (offset_ % segment_size == 0) {
+    this->segment_fence(segment);
+    offset_ %= segment_size * segments_len;
+  }
+  return true;
+}
+
+}  // namespace blender::gpu
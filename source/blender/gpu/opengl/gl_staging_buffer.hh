@@ -0,0 +1,72 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Copyright 2021, Blender Foundation.
+ * All rights reserved.
+ */
+
+/** \file
+ * \ingroup gpu
+ *
+ * Persistently mapped ring buffer used to upload buffer data without waiting for the driver to
+ * copy it. The data is written directly into memory the GPU can read from and then copied on the
+ * GPU into the destination buffer, so the CPU can keep going while previous frames are rendered.
+ *
+ * The ring is split into segments. A fence is inserted when a segment has been filled, and has
+ * to be signaled before the segment is written again.
+ */
+
+#pragma once
+
+#include "BLI_utility_mixins.hh"
+
+#include "glew-mx.h"
+
+namespace blender::gpu {
+
+class GLStagingBuffer : NonCopyable, NonMovable {
+ public:
+  static constexpr size_t segment_size = 8 * 1024 * 1024;
+  static constexpr int segments_len = 4;
+  /** Smaller uploads are handled by the driver as fast as going through the staging buffer. */
+  static constexpr size_t min_upload_size = 16 * 1024;
+
+ private:
+  GLuint buffer_id_ = 0;
+  uchar *data_ = nullptr;
+  /** Offset of the next allocation. */
+  size_t offset_ = 0;
+  GLsync fences_[segments_len] = {nullptr};
+
+ public:
+  GLStagingBuffer();
+  ~GLStagingBuffer();
+
+  /**
+   * Upload \a size bytes of \a data at the beginning of the buffer bound to \a target.
+   * Return false when the upload should be done directly by the caller.
+   */
+  bool upload(GLenum target, size_t size, const void *data);
+
+ private:
+  int segment_get(size_t offset) const
+  {
+    return int(offset / segment_size);
+  }
+  void segment_fence(int segment);
+  void segment_wait(int segment);
+};
+
+}  // namespace blender::gpu
@@ -107,7 +107,8 @@ void GLVertBuf::bind()
     /* Orphan the vbo to avoid sync then upload data. */
     glBufferData(GL_ARRAY_BUFFER, vbo_size_, nullptr, to_gl(usage_));
     /* Do not transfer data from host to device when buffer is device only. */
-    if (usage_ != GPU_USAGE_DEVICE_ONLY) {
+    if (usage_ != GPU_USAGE_DEVICE_ONLY &&
+        !GLContext::get()->buf_staging_upload(GL_ARRAY_BUFFER, vbo_size_, data)) {
       glBufferSubData(GL_ARRAY_BUFFER, 0, vbo_size_, data);
     }
     memory_usage += vbo_size_;
@@ -123,6 +123,17 @@ struct ImBuf *IMB_testiffname(const char *filepath, int flags);
  */
 struct ImBuf *IMB_loadiffname(const char *filepath, int flags, char colorspace[IM_MAX_SPACE]);
 
+/**
+ * Load an image like #IMB_loadiffname, sharing the buffer with other users which loaded the same
+ * file with the same flags and color space. The buffer must not be modified in place, use
+ * #IMB_makeSingleUser to get a buffer which can be modified.
+ *
+ * \attention Defined in readimage.c
+ */
+struct ImBuf *IMB_loadiffname_shared(const char *filepath,
+                                     int flags,
+                                     char colorspace[IM_MAX_SPACE]);
+
 /**
  *
  * \attention Defined in allocimbuf.c
@@ -84,6 +84,17 @@ struct IDProperty;
 struct _AviMovie;
 struct anim_index;
 
+#ifdef WITH_FFMPEG
+/* Key frame packet of the video stream, found while decoding. */
+struct anim_key_frame {
+  int64_t pts;
+  int64_t pos;
+  /* The next key frame in the index is also the next one in the stream, so all frames from this
+   * key frame up to the next one belong to its GOP. */
+  bool next_is_known;
+};
+#endif
+
 struct anim {
   int ib_flags;
   int curtype;
@@ -129,13 +140,28 @@ struct anim {
   int pFrameComplete;
   AVFrame *pFrameRGB;
   AVFrame *pFrameDeinterlaced;
-  struct SwsContext *img_convert_ctx;
+  /* Frame copied to system memory when the decoder output is a hardware frame. */
+  AVFrame *pFrameTransfer;
+  enum AVPixelFormat hw_pix_fmt;
+  /* Conversion contexts of the horizontal slices of the frame. */
+  struct SwsContext **img_convert_ctx;
+  int img_convert_num_slices;
+  int img_convert_slice_height;
+  enum AVPixelFormat img_convert_pix_fmt;
   int videoStream;
 
   struct ImBuf *cur_frame_final;
   int64_t cur_pts;
   int64_t cur_key_frame_pts;
   AVPacket *cur_packet;
+
+  /* Key frames of the video stream sorted by pts, to seek to the GOP of a frame directly when
+   * there is no time-code index. */
+  struct anim_key_frame *key_frames;
+  int key_frames_num;
+  int key_frames_len;
+  /* Index of the last key frame read, or -1 when the stream was not read continuously since. */
+  int key_frame_last;
 #endif
 
   char index_dir[768];
@@ -377,7 +377,10 @@ void *imb_alloc_pixels(
   }
 
   size_t size = (size_t)x * (size_t)y * (size_t)channels * typesize;
-  return MEM_callocN(size, name);
+  MEM_category_push(MEM_CATEGORY_IMAGE);
+  void *pixels = MEM_callocN(size, name);
+  MEM_category_pop();
+  return pixels;
 }
 
 bool imb_addrectfloatImBuf(ImBuf *ibuf)
@@ -476,6 +479,7 @@ struct ImBuf *IMB_allocFromBuffer(const unsigned int *rect,
 
   ibuf->channels = channels;
 
+  MEM_category_push(MEM_CATEGORY_IMAGE);
   /* Avoid #MEM_dupallocN since the buffers might not be allocated using guarded-allocation. */
   if (rectf) {
     const size_t size = sizeof(float[4]) * w * h;
@@ -493,6 +497,7 @@ struct ImBuf *IMB_allocFromBuffer(const unsigned int *rect,
     ibuf->flags |= IB_rect;
     ibuf->mall |= IB_rect;
   }
+  MEM_category_pop();
 
   return ibuf;
 }
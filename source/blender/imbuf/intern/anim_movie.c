@@ -53,8 +53,10 @@
 #  include <io.h>
 #endif
 
+#include "BLI_math_base.h"
 #include "BLI_path_util.h"
 #include "BLI_string.h"
+#include "BLI_task.h"
 #include "BLI_threads.h"
 #include "BLI_utildefines.h"
 
@@ -81,6 +83,7 @@
 
 #  include <libavcodec/avcodec.h>
 #  include <libavformat/avformat.h>
+#  include <libavutil/hwcontext.h>
 #  include <libavutil/imgutils.h>
 #  include <libavutil/rational.h>
 #  include <libswscale/swscale.h>
@@ -509,6 +512,223 @@ BLI_INLINE bool need_aligned_ffmpeg_buffer(struct anim *anim)
   return (anim->x & 31) != 0;
 }
 
+#  ifdef FFMPEG_HAVE_HW_DECODING
+static enum AVPixelFormat ffmpeg_get_hw_format(AVCodecContext *codec_ctx,
+                                               const enum AVPixelFormat *pix_fmts)
+{
+  struct anim *anim = codec_ctx->opaque;
+
+  for (const enum AVPixelFormat *pix_fmt = pix_fmts; *pix_fmt != AV_PIX_FMT_NONE; pix_fmt++) {
+    if (*pix_fmt == anim->hw_pix_fmt) {
+      return *pix_fmt;
+    }
+  }
+
+  /* The device can't decode this stream, fall back to software decoding. */
+  return avcodec_default_get_format(codec_ctx, pix_fmts);
+}
+#  endif
+
+/* Decode with the first hardware device the codec supports which can be created.
+ * Frames are then copied back to system memory in #ffmpeg_postprocess. */
+static void ffmpeg_hw_decode_init(struct anim *anim,
+                                  const AVCodec *codec,
+                                  AVCodecContext *codec_ctx)
+{
+  anim->hw_pix_fmt = AV_PIX_FMT_NONE;
+
+#  ifdef FFMPEG_HAVE_HW_DECODING
+  for (int i = 0;; i++) {
+    const AVCodecHWConfig *config = avcodec_get_hw_config(codec, i);
+    if (config == NULL) {
+      break;
+    }
+    if ((config->methods & AV_CODEC_HW_CONFIG_METHOD_HW_DEVICE_CTX) == 0) {
+      continue;
+    }
+
+    AVBufferRef *device_ctx = NULL;
+    if (av_hwdevice_ctx_create(&device_ctx, config->device_type, NULL, NULL, 0) < 0) {
+      continue;
+    }
+
+    /* The codec context owns the device reference from here on. */
+    codec_ctx->hw_device_ctx = device_ctx;
+    codec_ctx->opaque = anim;
+    codec_ctx->get_format = ffmpeg_get_hw_format;
+    anim->hw_pix_fmt = config->pix_fmt;
+
+    av_log(codec_ctx,
+           AV_LOG_INFO,
+           "Using %s hardware decoding\n",
+           av_hwdevice_get_type_name(config->device_type));
+    return;
+  }
+#  else
+  UNUSED_VARS(codec, codec_ctx);
+#  endif
+}
+
+/* Minimum number of rows converted by one thread. Also a multiple of the chroma subsampling of
+ * all pixel formats, so slices start at a chroma row. */
+#  define FFMPEG_SWSCALE_MIN_SLICE_HEIGHT 64
+
+/* Create the context converting rows of decoded frames of the given pixel format to RGBA. */
+static struct SwsContext *ffmpeg_swscale_create(struct anim *anim,
+                                                enum AVPixelFormat pix_fmt,
+                                                int height)
+{
+  /* The following for color space determination */
+  int srcRange, dstRange, brightness, contrast, saturation;
+  int *table;
+  const int *inv_table;
+
+  struct SwsContext *img_convert_ctx = sws_getContext(anim->x,
+                                                      height,
+                                                      pix_fmt,
+                                                      anim->x,
+                                                      height,
+                                                      AV_PIX_FMT_RGBA,
+                                                      SWS_BILINEAR | SWS_PRINT_INFO |
+                                                          SWS_FULL_CHR_H_INT,
+                                                      NULL,
+                                                      NULL,
+                                                      NULL);
+  if (!img_convert_ctx) {
+    return NULL;
+  }
+
+  /* Try do detect if input has 0-255 YCbCR range (JFIF Jpeg MotionJpeg) */
+  if (!sws_getColorspaceDetails(img_convert_ctx,
+                                (int **)&inv_table,
+                                &srcRange,
+                                &table,
+                                &dstRange,
+                                &brightness,
+                                &contrast,
+                                &saturation)) {
+    srcRange = srcRange || anim->pCodecCtx->color_range == AVCOL_RANGE_JPEG;
+    inv_table = sws_getCoefficients(anim->pCodecCtx->colorspace);
+
+    if (sws_setColorspaceDetails(img_convert_ctx,
+                                 (int *)inv_table,
+                                 srcRange,
+                                 table,
+                                 dstRange,
+                                 brightness,
+                                 contrast,
+                                 saturation)) {
+      fprintf(stderr, "Warning: Could not set libswscale colorspace details.\n");
+    }
+  }
+  else {
+    fprintf(stderr, "Warning: Could not set libswscale colorspace details.\n");
+  }
+
+  return img_convert_ctx;
+}
+
+static void ffmpeg_swscale_free(struct anim *anim)
+{
+  for (int i = 0; i < anim->img_convert_num_slices; i++) {
+    sws_freeContext(anim->img_convert_ctx[i]);
+  }
+  MEM_SAFE_FREE(anim->img_convert_ctx);
+  anim->img_convert_num_slices = 0;
+  anim->img_convert_pix_fmt = AV_PIX_FMT_NONE;
+}
+
+/* Create the conversion contexts for frames of the given pixel format. The frame is split into
+ * horizontal slices converted in parallel, each with its own context since they keep state of
+ * the rows they converted. */
+static bool ffmpeg_swscale_init(struct anim *anim, enum AVPixelFormat pix_fmt)
+{
+  ffmpeg_swscale_free(anim);
+
+  const AVPixFmtDescriptor *pix_fmt_descriptor = av_pix_fmt_desc_get(pix_fmt);
+  int num_slices = 1;
+  /* Palette formats store the palette in the second plane, which can't be offset. */
+  if (pix_fmt_descriptor != NULL && (pix_fmt_descriptor->flags & AV_PIX_FMT_FLAG_PAL) == 0) {
+    num_slices = max_ii(
+        1, min_ii(BLI_system_thread_count(), anim->y / FFMPEG_SWSCALE_MIN_SLICE_HEIGHT));
+  }
+
+  int slice_height = divide_ceil_u(anim->y, num_slices);
+  slice_height = divide_ceil_u(slice_height, FFMPEG_SWSCALE_MIN_SLICE_HEIGHT) *
+                 FFMPEG_SWSCALE_MIN_SLICE_HEIGHT;
+  num_slices = divide_ceil_u(anim->y, slice_height);
+
+  anim->img_convert_ctx = MEM_callocN(sizeof(*anim->img_convert_ctx) * num_slices,
+                                      "ffmpeg swscale contexts");
+  anim->img_convert_num_slices = num_slices;
+  anim->img_convert_slice_height = slice_height;
+  anim->img_convert_pix_fmt = pix_fmt;
+
+  for (int i = 0; i < num_slices; i++) {
+    const int height = min_ii(slice_height, anim->y - i * slice_height);
+    anim->img_convert_ctx[i] = ffmpeg_swscale_create(anim, pix_fmt, height);
+    if (anim->img_convert_ctx[i] == NULL) {
+      ffmpeg_swscale_free(anim);
+      return false;
+    }
+  }
+
+  return true;
+}
+
+typedef struct FFmpegSwscaleData {
+  struct anim *anim;
+  const AVFrame *input;
+  int num_planes;
+  int chroma_shift;
+  uint8_t *dst;
+  int dst_stride;
+} FFmpegSwscaleData;
+
+static void ffmpeg_swscale_slice(void *__restrict userdata,
+                                 const int slice,
+                                 const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const FFmpegSwscaleData *data = userdata;
+  const struct anim *anim = data->anim;
+  const AVFrame *input = data->input;
+  const int y = slice * anim->img_convert_slice_height;
+  const int height = min_ii(anim->img_convert_slice_height, anim->y - y);
+
+  const uint8_t *src[4];
+  for (int plane = 0; plane < 4; plane++) {
+    src[plane] = input->data[plane];
+    if (plane < data->num_planes) {
+      const int shift = (plane == 1 || plane == 2) ? data->chroma_shift : 0;
+      src[plane] += (ptrdiff_t)(y >> shift) * input->linesize[plane];
+    }
+  }
+
+  uint8_t *dst[4] = {data->dst + (ptrdiff_t)y * data->dst_stride, 0, 0, 0};
+  const int dst_stride[4] = {data->dst_stride, 0, 0, 0};
+
+  sws_scale(anim->img_convert_ctx[slice], src, input->linesize, 0, height, dst, dst_stride);
+}
+
+/* Convert the input frame to RGBA rows starting at dst, which may have a negative stride. */
+static void ffmpeg_swscale(struct anim *anim, const AVFrame *input, uint8_t *dst, int dst_stride)
+{
+  FFmpegSwscaleData data = {
+      .anim = anim,
+      .input = input,
+      .num_planes = av_pix_fmt_count_planes(input->format),
+      .chroma_shift = av_pix_fmt_desc_get(input->format)->log2_chroma_h,
+      .dst = dst,
+      .dst_stride = dst_stride,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1;
+  BLI_task_parallel_range(
+      0, anim->img_convert_num_slices, &data, ffmpeg_swscale_slice, &settings);
+}
+
 static int startffmpeg(struct anim *anim)
 {
   int i, video_stream_index;
@@ -522,11 +742,6 @@ static int startffmpeg(struct anim *anim)
   double frs_den;
   int streamcount;
 
-  /* The following for color space determination */
-  int srcRange, dstRange, brightness, contrast, saturation;
-  int *table;
-  const int *inv_table;
-
   if (anim == NULL) {
     return (-1);
   }
@@ -590,6 +805,13 @@ static int startffmpeg(struct anim *anim)
     pCodecCtx->thread_type = FF_THREAD_SLICE;
   }
 
+  /* Deinterlacing works on the decoder output format, which is only known for software
+   * decoding. */
+  anim->hw_pix_fmt = AV_PIX_FMT_NONE;
+  if ((anim->ib_flags & IB_animhwdecode) && !(anim->ib_flags & IB_animdeinterlace)) {
+    ffmpeg_hw_decode_init(anim, pCodec, pCodecCtx);
+  }
+
   if (avcodec_open2(pCodecCtx, pCodec, NULL) < 0) {
     avformat_close_input(&pFormatCtx);
     return -1;
@@ -703,10 +925,16 @@ static int startffmpeg(struct anim *anim)
   anim->cur_packet = av_packet_alloc();
   anim->cur_packet->stream_index = -1;
 
+  anim->key_frames = NULL;
+  anim->key_frames_num = 0;
+  anim->key_frames_len = 0;
+  anim->key_frame_last = -1;
+
   anim->pFrame = av_frame_alloc();
   anim->pFrameComplete = false;
   anim->pFrameDeinterlaced = av_frame_alloc();
   anim->pFrameRGB = av_frame_alloc();
+  anim->pFrameTransfer = av_frame_alloc();
 
   if (need_aligned_ffmpeg_buffer(anim)) {
     anim->pFrameRGB->format = AV_PIX_FMT_RGBA;
@@ -720,6 +948,7 @@ static int startffmpeg(struct anim *anim)
       av_packet_free(&anim->cur_packet);
       av_frame_free(&anim->pFrameRGB);
       av_frame_free(&anim->pFrameDeinterlaced);
+      av_frame_free(&anim->pFrameTransfer);
       av_frame_free(&anim->pFrame);
       anim->pCodecCtx = NULL;
       return -1;
@@ -733,6 +962,7 @@ static int startffmpeg(struct anim *anim)
     av_packet_free(&anim->cur_packet);
     av_frame_free(&anim->pFrameRGB);
     av_frame_free(&anim->pFrameDeinterlaced);
+    av_frame_free(&anim->pFrameTransfer);
     av_frame_free(&anim->pFrame);
     anim->pCodecCtx = NULL;
     return -1;
@@ -752,56 +982,19 @@ static int startffmpeg(struct anim *anim)
                          1);
   }
 
-  anim->img_convert_ctx = sws_getContext(anim->x,
-                                         anim->y,
-                                         anim->pCodecCtx->pix_fmt,
-                                         anim->x,
-                                         anim->y,
-                                         AV_PIX_FMT_RGBA,
-                                         SWS_BILINEAR | SWS_PRINT_INFO | SWS_FULL_CHR_H_INT,
-                                         NULL,
-                                         NULL,
-                                         NULL);
-
-  if (!anim->img_convert_ctx) {
+  if (!ffmpeg_swscale_init(anim, anim->pCodecCtx->pix_fmt)) {
     fprintf(stderr, "Can't transform color space??? Bailing out...\n");
     avcodec_free_context(&anim->pCodecCtx);
     avformat_close_input(&anim->pFormatCtx);
     av_packet_free(&anim->cur_packet);
     av_frame_free(&anim->pFrameRGB);
     av_frame_free(&anim->pFrameDeinterlaced);
+    av_frame_free(&anim->pFrameTransfer);
     av_frame_free(&anim->pFrame);
     anim->pCodecCtx = NULL;
     return -1;
   }
 
-  /* Try do detect if input has 0-255 YCbCR range (JFIF Jpeg MotionJpeg) */
-  if (!sws_getColorspaceDetails(anim->img_convert_ctx,
-                                (int **)&inv_table,
-                                &srcRange,
-                                &table,
-                                &dstRange,
-                                &brightness,
-                                &contrast,
-                                &saturation)) {
-    srcRange = srcRange || anim->pCodecCtx->color_range == AVCOL_RANGE_JPEG;
-    inv_table = sws_getCoefficients(anim->pCodecCtx->colorspace);
-
-    if (sws_setColorspaceDetails(anim->img_convert_ctx,
-                                 (int *)inv_table,
-                                 srcRange,
-                                 table,
-                                 dstRange,
-                                 brightness,
-                                 contrast,
-                                 saturation)) {
-      fprintf(stderr, "Warning: Could not set libswscale colorspace details.\n");
-    }
-  }
-  else {
-    fprintf(stderr, "Warning: Could not set libswscale colorspace details.\n");
-  }
-
   return 0;
 }
 
@@ -821,6 +1014,18 @@ static void ffmpeg_postprocess(struct anim *anim)
     return;
   }
 
+#  ifdef FFMPEG_HAVE_HW_DECODING
+  if (input->hw_frames_ctx != NULL) {
+    /* Hardware frame, copy it to system memory for conversion. */
+    av_frame_unref(anim->pFrameTransfer);
+    if (av_hwframe_transfer_data(anim->pFrameTransfer, input, 0) < 0) {
+      fprintf(stderr, "ffmpeg_fetchibuf: could not transfer hardware frame\n");
+      return;
+    }
+    input = anim->pFrameTransfer;
+  }
+#  endif
+
   /* This means the data wasn't read properly,
    * this check stops crashing */
   if (input->data[0] == 0 && input->data[1] == 0 && input->data[2] == 0 && input->data[3] == 0) {
@@ -830,6 +1035,14 @@ static void ffmpeg_postprocess(struct anim *anim)
     return;
   }
 
+  /* The software format of hardware frames is only known once they are decoded. */
+  if (input->format != anim->img_convert_pix_fmt) {
+    if (!ffmpeg_swscale_init(anim, input->format)) {
+      fprintf(stderr, "ffmpeg_fetchibuf: can't transform color space\n");
+      return;
+    }
+  }
+
   av_log(anim->pFormatCtx,
          AV_LOG_DEBUG,
          "  POSTPROC: anim->pFrame planes: %p %p %p %p\n",
@@ -868,33 +1081,17 @@ static void ffmpeg_postprocess(struct anim *anim)
    * http://trac.ffmpeg.org/ticket/9060 */
   int *dstStride = anim->pFrameRGB->linesize;
   uint8_t **dst = anim->pFrameRGB->data;
-  const int dstStride2[4] = {-dstStride[0], 0, 0, 0};
-  uint8_t *dst2[4] = {dst[0] + (anim->y - 1) * dstStride[0], 0, 0, 0};
-
-  sws_scale(anim->img_convert_ctx,
-            (const uint8_t *const *)input->data,
-            input->linesize,
-            0,
-            anim->y,
-            dst2,
-            dstStride2);
+
+  ffmpeg_swscale(anim, input, dst[0] + (anim->y - 1) * dstStride[0], -dstStride[0]);
 #  else
   /* Scale with swscale then flip image over Y axis. */
   int *dstStride = anim->pFrameRGB->linesize;
   uint8_t **dst = anim->pFrameRGB->data;
-  const int dstStride2[4] = {dstStride[0], 0, 0, 0};
-  uint8_t *dst2[4] = {dst[0], 0, 0, 0};
   int x, y, h, w;
   unsigned char *bottom;
   unsigned char *top;
 
-  sws_scale(anim->img_convert_ctx,
-            (const uint8_t *const *)input->data,
-            input->linesize,
-            0,
-            anim->y,
-            dst2,
-            dstStride2);
+  ffmpeg_swscale(anim, input, dst[0], dstStride[0]);
 
   bottom = (unsigned char *)ibuf->rect;
   top = bottom + ibuf->x * (ibuf->y - 1) * 4;
@@ -941,6 +1138,77 @@ static void ffmpeg_postprocess(struct anim *anim)
   }
 }
 
+/* Find the key frame with the largest pts which is not larger than the given one. */
+static int ffmpeg_key_frame_index_find(const struct anim *anim, int64_t pts)
+{
+  int first = 0;
+  int len = anim->key_frames_num;
+  while (len > 0) {
+    const int half_len = len >> 1;
+    const int middle = first + half_len;
+    if (anim->key_frames[middle].pts <= pts) {
+      first = middle + 1;
+      len -= half_len + 1;
+    }
+    else {
+      len = half_len;
+    }
+  }
+  return first - 1;
+}
+
+/* Remember the key frame packet which was just read while decoding. */
+static void ffmpeg_key_frame_index_add(struct anim *anim, const AVPacket *packet)
+{
+  const int64_t pts = timestamp_from_pts_or_dts(packet->pts, packet->dts);
+  if (pts == AV_NOPTS_VALUE) {
+    anim->key_frame_last = -1;
+    return;
+  }
+
+  int index = ffmpeg_key_frame_index_find(anim, pts);
+  if (index == -1 || anim->key_frames[index].pts != pts) {
+    index++;
+
+    if (anim->key_frames_num == anim->key_frames_len) {
+      anim->key_frames_len = max_ii(64, anim->key_frames_len * 2);
+      anim->key_frames = MEM_reallocN(anim->key_frames,
+                                      sizeof(*anim->key_frames) * anim->key_frames_len);
+    }
+    memmove(&anim->key_frames[index + 1],
+            &anim->key_frames[index],
+            sizeof(*anim->key_frames) * (anim->key_frames_num - index));
+    anim->key_frames_num++;
+
+    /* Inserting can only move the last key frame when reading continuously, if the stream has
+     * key frames out of order. */
+    if (anim->key_frame_last >= index) {
+      anim->key_frame_last = -1;
+    }
+
+    anim->key_frames[index].pts = pts;
+    anim->key_frames[index].pos = packet->pos;
+    anim->key_frames[index].next_is_known = false;
+  }
+
+  /* Read continuously from the previous key frame, so there is none in between. */
+  if (anim->key_frame_last != -1 && anim->key_frame_last == index - 1) {
+    anim->key_frames[index - 1].next_is_known = true;
+  }
+  anim->key_frame_last = index;
+}
+
+/* Key frame of the GOP containing the pts, if it is known. */
+static const struct anim_key_frame *ffmpeg_key_frame_index_lookup(const struct anim *anim,
+                                                                  int64_t pts)
+{
+  const int index = ffmpeg_key_frame_index_find(anim, pts);
+  if (index == -1 || !anim->key_frames[index].next_is_known) {
+    return NULL;
+  }
+  return &anim->key_frames[index];
+}
+
 static void ffmpeg_decode_store_frame_pts(struct anim *anim)
 {
   anim->cur_pts = av_get_pts_from_frame(anim->pFrame);
@@ -987,6 +1255,9 @@ static int ffmpeg_decode_video_frame(struct anim *anim)
            (anim->cur_packet->pts == AV_NOPTS_VALUE) ? -1 : (int64_t)anim->cur_packet->pts,
            (anim->cur_packet->flags & AV_PKT_FLAG_KEY) ? " KEY" : "");
     if (anim->cur_packet->stream_index == anim->videoStream) {
+      if (anim->cur_packet->flags & AV_PKT_FLAG_KEY) {
+        ffmpeg_key_frame_index_add(anim, anim->cur_packet);
+      }
       avcodec_send_packet(anim->pCodecCtx, anim->cur_packet);
       anim->pFrameComplete = avcodec_receive_frame(anim->pCodecCtx, anim->pFrame) == 0;
 
@@ -1267,6 +1538,14 @@ static int ffmpeg_seek_to_key_frame(struct anim *anim,
   int64_t pos;
   int ret;
 
+  /* Seeking moves the stream, key frames read next do not follow the last one. */
+  const int key_frame_last = anim->key_frame_last;
+  anim->key_frame_last = -1;
+
+  const struct anim_key_frame *key_frame = (tc_index) ?
+                                               NULL :
+                                               ffmpeg_key_frame_index_lookup(anim, pts_to_search);
+
   if (tc_index) {
     /* We can use timestamps generated from our indexer to seek. */
     int new_frame_index = IMB_indexer_get_frame_index(tc_index, position);
@@ -1274,6 +1553,7 @@ static int ffmpeg_seek_to_key_frame(struct anim *anim,
 
     if (IMB_indexer_can_scan(tc_index, old_frame_index, new_frame_index)) {
       /* No need to seek, return early. */
+      anim->key_frame_last = key_frame_last;
       return 0;
     }
     uint64_t pts;
@@ -1300,6 +1580,27 @@ static int ffmpeg_seek_to_key_frame(struct anim *anim,
           anim->pFormatCtx, anim->videoStream, anim->cur_key_frame_pts, AVSEEK_FLAG_BACKWARD);
     }
   }
+  else if (key_frame) {
+    /* The GOP of the frame is known from decoding it before. */
+    if (key_frame->pts == anim->cur_key_frame_pts && position > anim->cur_position &&
+        anim->cur_pts <= pts_to_search) {
+      /* The frame comes later in the GOP being decoded, continue decoding from there. */
+      anim->key_frame_last = key_frame_last;
+      return 0;
+    }
+
+    anim->cur_key_frame_pts = key_frame->pts;
+
+    if (ffmpeg_seek_by_byte(anim->pFormatCtx) && key_frame->pos != -1) {
+      pos = key_frame->pos;
+      ret = av_seek_frame(anim->pFormatCtx, -1, pos, AVSEEK_FLAG_BYTE);
+    }
+    else {
+      pos = key_frame->pts;
+      ret = av_seek_frame(anim->pFormatCtx, anim->videoStream, pos, AVSEEK_FLAG_BACKWARD);
+    }
+    av_log(anim->pFormatCtx, AV_LOG_DEBUG, "KEY FRAME INDEX seek pos = %" PRId64 "\n", pos);
+  }
   else {
     /* We have to manually seek with ffmpeg to get to the key frame we want to start decoding from.
      */
@@ -1337,6 +1638,7 @@ static int ffmpeg_seek_to_key_frame(struct anim *anim,
 
         if (cur_pts == gop_pts) {
           /* We are already at the correct position. */
+          anim->key_frame_last = key_frame_last;
           return 0;
         }
         AVPacket *temp = av_packet_alloc();
@@ -1349,6 +1651,7 @@ static int ffmpeg_seek_to_key_frame(struct anim *anim,
           av_packet_unref(temp);
         }
         av_packet_free(&temp);
+        anim->key_frame_last = key_frame_last;
         return 0;
       }
 
@@ -1497,9 +1800,11 @@ static void free_anim_ffmpeg(struct anim *anim)
     }
     av_frame_free(&anim->pFrameRGB);
     av_frame_free(&anim->pFrameDeinterlaced);
+    av_frame_free(&anim->pFrameTransfer);
 
-    sws_freeContext(anim->img_convert_ctx);
+    ffmpeg_swscale_free(anim);
     IMB_freeImBuf(anim->cur_frame_final);
+    MEM_SAFE_FREE(anim->key_frames);
   }
   anim->duration_in_frames = 0;
 }
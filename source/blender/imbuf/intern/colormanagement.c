@@ -1586,9 +1586,12 @@ static void display_buffer_apply_get_linear_buffer(DisplayBufferThread *handle,
   }
 }
 
-static void *do_display_buffer_apply_thread(void *handle_v)
+/* Number of pixels converted at once by a thread, so that the intermediate linear buffer stays in
+ * the CPU cache instead of spanning all lines of the thread. */
+#define DISPLAY_BUFFER_BLOCK_PIXELS (64 * 1024)
+
+static void display_buffer_apply_block(DisplayBufferThread *handle, float *linear_buffer)
 {
-  DisplayBufferThread *handle = (DisplayBufferThread *)handle_v;
   ColormanageProcessor *cm_processor = handle->cm_processor;
   float *display_buffer = handle->display_buffer;
   unsigned char *display_buffer_byte = handle->display_buffer_byte;
@@ -1625,8 +1628,6 @@ static void *do_display_buffer_apply_thread(void *handle_v)
   }
   else {
     bool is_straight_alpha;
-    float *linear_buffer = MEM_mallocN(((size_t)channels) * width * height * sizeof(float),
-                                       "color conversion linear buffer");
 
     display_buffer_apply_get_linear_buffer(handle, height, linear_buffer, &is_straight_alpha);
 
@@ -1672,10 +1673,48 @@ static void *do_display_buffer_apply_thread(void *handle_v)
         }
       }
     }
+  }
+}
+
+static void *do_display_buffer_apply_thread(void *handle_v)
+{
+  DisplayBufferThread *handle = (DisplayBufferThread *)handle_v;
+  const int width = handle->width;
+  const int channels = handle->channels;
+  const int block_lines = max_ii(DISPLAY_BUFFER_BLOCK_PIXELS / max_ii(width, 1), 1);
+  float *linear_buffer = NULL;
+
+  if (handle->cm_processor != NULL) {
+    linear_buffer = MEM_mallocN(
+        ((size_t)channels) * width * min_ii(block_lines, handle->tot_line) * sizeof(float),
+        "color conversion linear buffer");
+  }
+
+  for (int line = 0; line < handle->tot_line; line += block_lines) {
+    const size_t offset = ((size_t)channels) * line * width;
+    const size_t display_buffer_byte_offset = ((size_t)DISPLAY_BUFFER_CHANNELS) * line * width;
+    DisplayBufferThread block = *handle;
+
+    block.start_line = handle->start_line + line;
+    block.tot_line = min_ii(block_lines, handle->tot_line - line);
+    if (block.buffer) {
+      block.buffer += offset;
+    }
+    if (block.byte_buffer) {
+      block.byte_buffer += offset;
+    }
+    if (block.display_buffer) {
+      block.display_buffer += offset;
+    }
+    if (block.display_buffer_byte) {
+      block.display_buffer_byte += display_buffer_byte_offset;
+    }
 
-    MEM_freeN(linear_buffer);
+    display_buffer_apply_block(&block, linear_buffer);
   }
 
+  MEM_SAFE_FREE(linear_buffer);
+
   return NULL;
 }
 
@@ -3874,15 +3913,30 @@ void IMB_colormanagement_processor_apply_byte(
    * but for now it's not so important.
    */
   BLI_assert(channels == 4);
-  float pixel[4];
-  for (int y = 0; y < height; y++) {
-    for (int x = 0; x < width; x++) {
-      size_t offset = channels * (((size_t)y) * width + x);
-      rgba_uchar_to_float(pixel, buffer + offset);
-      IMB_colormanagement_processor_apply_v4(cm_processor, pixel);
-      rgba_float_to_uchar(buffer + offset, pixel);
+
+  /* Convert lines to float in blocks, so the processor is applied to whole packed images instead
+   * of being called for every pixel. */
+  const int block_lines = max_ii(DISPLAY_BUFFER_BLOCK_PIXELS / max_ii(width, 1), 1);
+  float *float_buffer = MEM_mallocN(
+      sizeof(float[4]) * width * min_ii(block_lines, height), "color conversion byte buffer");
+
+  for (int y = 0; y < height; y += block_lines) {
+    const int lines = min_ii(block_lines, height - y);
+    const size_t num_pixels = ((size_t)width) * lines;
+    unsigned char *byte_block = buffer + channels * ((size_t)y) * width;
+
+    for (size_t i = 0; i < num_pixels; i++) {
+      rgba_uchar_to_float(float_buffer + 4 * i, byte_block + 4 * i);
+    }
+
+    IMB_colormanagement_processor_apply(cm_processor, float_buffer, width, lines, 4, false);
+
+    for (size_t i = 0; i < num_pixels; i++) {
+      rgba_float_to_uchar(byte_block + 4 * i, float_buffer + 4 * i);
     }
   }
+
+  MEM_freeN(float_buffer);
 }
 
 void IMB_colormanagement_processor_free(ColormanageProcessor *cm_processor)
@@ -78,6 +78,7 @@ _CRTIMP void __cdecl _invalid_parameter_noinfo(void)
 }
 #include "BLI_blenlib.h"
 #include "BLI_math_color.h"
+#include "BLI_task.h"
 #include "BLI_threads.h"
 
 #include "BKE_idprop.h"
@@ -325,6 +326,79 @@ static half float_to_half_safe(const float value)
   return half(clamp_f(value, -HALF_MAX, HALF_MAX));
 }
 
+/* Conversion of images to half float is done in parallel over scan-lines, for large images it
+ * takes about as long as the compression, which OpenEXR does on its own threads. */
+
+struct ExrHalfChannelConvertData {
+  const float *rect;
+  int xstride;
+  int width;
+  half *rect_half;
+};
+
+static void exr_half_channel_convert_line(void *__restrict userdata,
+                                          const int y,
+                                          const TaskParallelTLS *__restrict /*tls*/)
+{
+  const ExrHalfChannelConvertData *data = (const ExrHalfChannelConvertData *)userdata;
+  const float *from = data->rect + ((size_t)y) * data->width * data->xstride;
+  half *to = data->rect_half + ((size_t)y) * data->width;
+
+  for (int x = 0; x < data->width; x++, from += data->xstride) {
+    to[x] = float_to_half_safe(*from);
+  }
+}
+
+struct ExrHalfImageConvertData {
+  const ImBuf *ibuf;
+  RGBAZ *pixels;
+};
+
+static void exr_half_image_convert_line(void *__restrict userdata,
+                                        const int y,
+                                        const TaskParallelTLS *__restrict /*tls*/)
+{
+  const ExrHalfImageConvertData *data = (const ExrHalfImageConvertData *)userdata;
+  const ImBuf *ibuf = data->ibuf;
+  const int channels = ibuf->channels;
+  const int width = ibuf->x;
+  /* Scan-lines are written from the top, ImBuf starts at the bottom. */
+  const size_t from_y = ibuf->y - 1 - y;
+  RGBAZ *to = data->pixels + ((size_t)y) * width;
+
+  if (ibuf->rect_float) {
+    const float *from = ibuf->rect_float + channels * from_y * width;
+
+    for (int j = width; j > 0; j--) {
+      to->r = float_to_half_safe(from[0]);
+      to->g = float_to_half_safe((channels >= 2) ? from[1] : from[0]);
+      to->b = float_to_half_safe((channels >= 3) ? from[2] : from[0]);
+      to->a = float_to_half_safe((channels >= 4) ? from[3] : 1.0f);
+      to++;
+      from += channels;
+    }
+  }
+  else {
+    const unsigned char *from = (const unsigned char *)ibuf->rect + 4 * from_y * width;
+
+    for (int j = width; j > 0; j--) {
+      to->r = srgb_to_linearrgb((float)from[0] / 255.0f);
+      to->g = srgb_to_linearrgb((float)from[1] / 255.0f);
+      to->b = srgb_to_linearrgb((float)from[2] / 255.0f);
+      to->a = channels >= 4 ? (float)from[3] / 255.0f : 1.0f;
+      to++;
+      from += 4;
+    }
+  }
+}
+
+static void exr_parallel_range_settings(TaskParallelSettings *settings, const int width)
+{
+  BLI_parallel_range_settings_defaults(settings);
+  /* Don't bother threads with short scan-lines. */
+  settings->min_iter_per_thread = max_ii(1, 16384 / max_ii(width, 1));
+}
+
 extern "C" {
 
 bool imb_is_a_openexr(const unsigned char *mem, const size_t size)
@@ -462,38 +536,13 @@ static bool imb_save_openexr_half(ImBuf *ibuf, const char *name, const int flags
                                sizeof(float),
                                sizeof(float) * -width));
     }
-    if (ibuf->rect_float) {
-      float *from;
+    ExrHalfImageConvertData convert_data;
+    convert_data.ibuf = ibuf;
+    convert_data.pixels = to;
 
-      for (int i = ibuf->y - 1; i >= 0; i--) {
-        from = ibuf->rect_float + channels * i * width;
-
-        for (int j = ibuf->x; j > 0; j--) {
-          to->r = float_to_half_safe(from[0]);
-          to->g = float_to_half_safe((channels >= 2) ? from[1] : from[0]);
-          to->b = float_to_half_safe((channels >= 3) ? from[2] : from[0]);
-          to->a = float_to_half_safe((channels >= 4) ? from[3] : 1.0f);
-          to++;
-          from += channels;
-        }
-      }
-    }
-    else {
-      unsigned char *from;
-
-      for (int i = ibuf->y - 1; i >= 0; i--) {
-        from = (unsigned char *)ibuf->rect + 4 * i * width;
-
-        for (int j = ibuf->x; j > 0; j--) {
-          to->r = srgb_to_linearrgb((float)from[0] / 255.0f);
-          to->g = srgb_to_linearrgb((float)from[1] / 255.0f);
-          to->b = srgb_to_linearrgb((float)from[2] / 255.0f);
-          to->a = channels >= 4 ? (float)from[3] / 255.0f : 1.0f;
-          to++;
-          from += 4;
-        }
-      }
-    }
+    TaskParallelSettings settings;
+    exr_parallel_range_settings(&settings, width);
+    BLI_task_parallel_range(0, height, &convert_data, exr_half_image_convert_line, &settings);
 
     exr_printf("OpenEXR-save: Writing OpenEXR file of height %d.\n", height);
 
@@ -1116,11 +1165,17 @@ void IMB_exr_write_channels(void *handle)
     for (echan = (ExrChannel *)data->channels.first; echan; echan = echan->next) {
       /* Writing starts from last scan-line, stride negative. */
       if (echan->use_half_float) {
-        float *rect = echan->rect;
-        half *cur = current_rect_half;
-        for (size_t i = 0; i < num_pixels; i++, cur++) {
-          *cur = float_to_half_safe(rect[i * echan->xstride]);
-        }
+        ExrHalfChannelConvertData convert_data;
+        convert_data.rect = echan->rect;
+        convert_data.xstride = echan->xstride;
+        convert_data.width = data->width;
+        convert_data.rect_half = current_rect_half;
+
+        TaskParallelSettings settings;
+        exr_parallel_range_settings(&settings, data->width);
+        BLI_task_parallel_range(
+            0, data->height, &convert_data, exr_half_channel_convert_line, &settings);
+
         half *rect_to_write = current_rect_half + (data->height - 1L) * data->width;
         frameBuffer.insert(
             echan->name,
@@ -29,9 +29,11 @@
 #endif
 
 #include "BLI_fileops.h"
+#include "BLI_ghash.h"
 #include "BLI_mmap.h"
 #include "BLI_path_util.h"
 #include "BLI_string.h"
+#include "BLI_threads.h"
 #include "BLI_utildefines.h"
 #include <stdlib.h>
 
@@ -39,6 +41,7 @@
 #include "IMB_filetype.h"
 #include "IMB_imbuf.h"
 #include "IMB_imbuf_types.h"
+#include "IMB_moviecache.h"
 #include "imbuf.h"
 
 #include "IMB_colormanagement.h"
@@ -251,6 +254,96 @@ ImBuf *IMB_loadiffname(const char *filepath, int flags, char colorspace[IM_MAX_S
   return ibuf;
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Shared File Cache
+ *
+ * Users which load the same file with the same flags and color space share one image buffer.
+ * The buffers are kept in a movie cache, so they are limited by the same memory budget as the
+ * other movie caches.
+ * \{ */
+
+typedef struct SharedFileKey {
+  char filepath[IMB_FILENAME_SIZE];
+  char colorspace[IM_MAX_SPACE];
+  int flags;
+  /* Reload files which changed on disk. */
+  int64_t mtime;
+  int64_t size;
+} SharedFileKey;
+
+static struct MovieCache *shared_file_cache = NULL;
+static ThreadMutex shared_file_cache_lock = BLI_MUTEX_INITIALIZER;
+
+static unsigned int shared_file_key_hash(const void *key_v)
+{
+  const SharedFileKey *key = key_v;
+  return BLI_ghashutil_strhash_p(key->filepath) ^ BLI_ghashutil_uinthash(key->flags);
+}
+
+static bool shared_file_key_cmp(const void *a_v, const void *b_v)
+{
+  const SharedFileKey *a = a_v;
+  const SharedFileKey *b = b_v;
+  return (a->flags != b->flags) || (a->mtime != b->mtime) || (a->size != b->size) ||
+         !STREQ(a->filepath, b->filepath) || !STREQ(a->colorspace, b->colorspace);
+}
+
+ImBuf *IMB_loadiffname_shared(const char *filepath, int flags, char colorspace[IM_MAX_SPACE])
+{
+  BLI_stat_t st;
+
+  /* Loaders resolve an empty color space, which can't be known before loading. */
+  if (colorspace == NULL || colorspace[0] == '\0' || (flags & (IB_test | IB_tilecache)) ||
+      BLI_stat(filepath, &st) == -1) {
+    return IMB_loadiffname(filepath, flags, colorspace);
+  }
+
+  SharedFileKey key;
+  memset(&key, 0, sizeof(key));
+  BLI_strncpy(key.filepath, filepath, sizeof(key.filepath));
+  BLI_strncpy(key.colorspace, colorspace, sizeof(key.colorspace));
+  key.flags = flags;
+  key.mtime = (int64_t)st.st_mtime;
+  key.size = (int64_t)st.st_size;
+
+  ImBuf *ibuf = NULL;
+  BLI_mutex_lock(&shared_file_cache_lock);
+  if (shared_file_cache) {
+    ibuf = IMB_moviecache_get(shared_file_cache, &key, NULL);
+  }
+  BLI_mutex_unlock(&shared_file_cache_lock);
+
+  if (ibuf) {
+    return ibuf;
+  }
+
+  ibuf = IMB_loadiffname(filepath, flags, colorspace);
+
+  /* Buffers with loader data attached, like multilayer EXR files, are converted by their users
+   * after loading, don't share them. */
+  if (ibuf && ibuf->userdata == NULL) {
+    BLI_mutex_lock(&shared_file_cache_lock);
+    if (shared_file_cache == NULL) {
+      shared_file_cache = IMB_moviecache_create(
+          "shared files", sizeof(SharedFileKey), shared_file_key_hash, shared_file_key_cmp);
+    }
+    IMB_moviecache_put(shared_file_cache, &key, ibuf);
+    BLI_mutex_unlock(&shared_file_cache_lock);
+  }
+
+  return ibuf;
+}
+
+void imb_shared_file_cache_exit(void)
+{
+  if (shared_file_cache) {
+    IMB_moviecache_free(shared_file_cache);
+    shared_file_cache = NULL;
+  }
+}
+
+/** \} */
+
 ImBuf *IMB_testiffname(const char *filepath, int flags)
 {
   ImBuf *ibuf;
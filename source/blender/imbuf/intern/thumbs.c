@@ -590,9 +590,12 @@ ImBuf *IMB_thumb_manage(const char *org_path, ThumbSize size, ThumbSource source
   }
   if (thumbpath_from_uri(uri, thumb_path, sizeof(thumb_path), THB_FAIL)) {
     /* failure thumb exists, don't try recreating */
-    if (BLI_exists(thumb_path)) {
-      /* clear out of date fail case (note for blen IDs we use blender file itself here) */
-      if (BLI_file_older(thumb_path, file_path)) {
+    BLI_stat_t thumb_st;
+    if (BLI_stat(thumb_path, &thumb_st) != -1) {
+      /* clear out of date fail case (note for blen IDs we use blender file itself here).
+       * Compare with the stat from above, avoids accessing the file again which can be slow on
+       * network file systems. */
+      if (thumb_st.st_mtime < st.st_mtime) {
         BLI_delete(thumb_path, false, false);
       }
       else {
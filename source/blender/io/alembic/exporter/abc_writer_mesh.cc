@@ -80,6 +80,7 @@ static void get_creases(struct Mesh *mesh,
                         std::vector<int32_t> &indices,
                         std::vector<int32_t> &lengths,
                         std::vector<float> &sharpnesses);
+static void ensure_loop_normals(struct Mesh *mesh);
 static void get_loop_normals(struct Mesh *mesh,
                              std::vector<Imath::V3f> &normals,
                              bool has_flat_shaded_poly);
@@ -89,6 +90,11 @@ ABCGenericMeshWriter::ABCGenericMeshWriter(const ABCWriterConstructorArgs &args)
 {
 }
 
+ABCGenericMeshWriter::~ABCGenericMeshWriter()
+{
+  free_deferred_sample();
+}
+
 void ABCGenericMeshWriter::create_alembic_objects(const HierarchyContext *context)
 {
   if (!args_.export_params->apply_subdiv && export_as_subdivision_surface(context->object)) {
@@ -161,6 +167,32 @@ void ABCGenericMeshWriter::do_write(HierarchyContext &context)
     return;
   }
 
+  free_deferred_sample();
+  deferred_sample_ = std::make_unique<DeferredSample>();
+  deferred_sample_->object = object;
+  deferred_sample_->mesh = mesh;
+  deferred_sample_->mesh_needs_free = needsfree;
+  deferred_sample_->write_face_sets = !frame_has_been_written_ && args_.export_params->face_sets;
+
+  /* Split normals are stored in the mesh, which is not owned by this writer and may be shared
+   * with other objects, so compute them before the samples are prepared in parallel. */
+  if (!is_subd_ && args_.export_params->normals && !needsfree &&
+      !args_.export_params->triangulate) {
+    ensure_loop_normals(mesh);
+  }
+
+  update_bounding_box(object);
+}
+
+bool ABCGenericMeshWriter::has_deferred_data() const
+{
+  return deferred_sample_ != nullptr;
+}
+
+void ABCGenericMeshWriter::prepare_deferred_data()
+{
+  DeferredSample &sample = *deferred_sample_;
+
   if (args_.export_params->triangulate) {
     const bool tag_only = false;
     const int quad_method = args_.export_params->quad_method;
@@ -169,20 +201,22 @@ void ABCGenericMeshWriter::do_write(HierarchyContext &context)
     BMeshCreateParams bmesh_create_params{};
     BMeshFromMeshParams bmesh_from_mesh_params{};
     bmesh_from_mesh_params.calc_face_normal = true;
-    BMesh *bm = BKE_mesh_to_bmesh_ex(mesh, &bmesh_create_params, &bmesh_from_mesh_params);
+    BMesh *bm = BKE_mesh_to_bmesh_ex(sample.mesh, &bmesh_create_params, &bmesh_from_mesh_params);
 
     BM_mesh_triangulate(bm, quad_method, ngon_method, 4, tag_only, nullptr, nullptr, nullptr);
 
-    Mesh *triangulated_mesh = BKE_mesh_from_bmesh_for_eval_nomain(bm, nullptr, mesh);
+    Mesh *triangulated_mesh = BKE_mesh_from_bmesh_for_eval_nomain(bm, nullptr, sample.mesh);
     BM_mesh_free(bm);
 
-    if (needsfree) {
-      free_export_mesh(mesh);
+    if (sample.mesh_needs_free) {
+      free_export_mesh(sample.mesh);
     }
-    mesh = triangulated_mesh;
-    needsfree = true;
+    sample.mesh = triangulated_mesh;
+    sample.mesh_needs_free = true;
   }
 
+  Mesh *mesh = sample.mesh;
+
   m_custom_data_config.pack_uvs = args_.export_params->packuv;
   m_custom_data_config.mesh = mesh;
   m_custom_data_config.mpoly = mesh->mpoly;
@@ -192,24 +226,53 @@ void ABCGenericMeshWriter::do_write(HierarchyContext &context)
   m_custom_data_config.totvert = mesh->totvert;
   m_custom_data_config.timesample_index = timesample_index_;
 
-  try {
-    if (is_subd_) {
-      write_subd(context, mesh);
-    }
-    else {
-      write_mesh(context, mesh);
-    }
+  bool has_flat_shaded_poly = false;
+  get_vertices(mesh, sample.points);
+  get_topology(mesh, sample.poly_verts, sample.loop_counts, has_flat_shaded_poly);
 
-    if (needsfree) {
-      free_export_mesh(mesh);
-    }
+  if (sample.write_face_sets) {
+    get_geo_groups(sample.object, mesh, sample.geo_groups);
+  }
+
+  if (args_.export_params->uvs) {
+    sample.uv_name = get_uv_sample(sample.uvs, m_custom_data_config, &mesh->ldata);
   }
-  catch (...) {
-    if (needsfree) {
-      free_export_mesh(mesh);
+
+  if (is_subd_) {
+    get_creases(mesh, sample.crease_indices, sample.crease_lengths, sample.crease_sharpness);
+    return;
+  }
+
+  if (args_.export_params->normals) {
+    if (sample.mesh_needs_free) {
+      ensure_loop_normals(mesh);
     }
-    throw;
+    get_loop_normals(mesh, sample.normals, has_flat_shaded_poly);
+  }
+
+  sample.has_velocities = get_velocities(mesh, sample.velocities);
+}
+
+void ABCGenericMeshWriter::write_deferred_data()
+{
+  if (is_subd_) {
+    write_subd(*deferred_sample_);
+  }
+  else {
+    write_mesh(*deferred_sample_);
   }
+  free_deferred_sample();
+}
+
+void ABCGenericMeshWriter::free_deferred_sample()
+{
+  if (deferred_sample_ == nullptr) {
+    return;
+  }
+  if (deferred_sample_->mesh_needs_free) {
+    free_export_mesh(deferred_sample_->mesh);
+  }
+  deferred_sample_.reset();
 }
 
 void ABCGenericMeshWriter::free_export_mesh(Mesh *mesh)
@@ -217,35 +280,27 @@ void ABCGenericMeshWriter::free_export_mesh(Mesh *mesh)
   BKE_id_free(nullptr, mesh);
 }
 
-void ABCGenericMeshWriter::write_mesh(HierarchyContext &context, Mesh *mesh)
+void ABCGenericMeshWriter::write_mesh(DeferredSample &sample)
 {
-  std::vector<Imath::V3f> points, normals;
-  std::vector<int32_t> poly_verts, loop_counts;
-  std::vector<Imath::V3f> velocities;
-  bool has_flat_shaded_poly = false;
+  Mesh *mesh = sample.mesh;
 
-  get_vertices(mesh, points);
-  get_topology(mesh, poly_verts, loop_counts, has_flat_shaded_poly);
-
-  if (!frame_has_been_written_ && args_.export_params->face_sets) {
-    write_face_sets(context.object, mesh, abc_poly_mesh_schema_);
+  if (sample.write_face_sets) {
+    write_face_sets(sample.geo_groups, abc_poly_mesh_schema_);
   }
 
   OPolyMeshSchema::Sample mesh_sample = OPolyMeshSchema::Sample(
-      V3fArraySample(points), Int32ArraySample(poly_verts), Int32ArraySample(loop_counts));
-
-  UVSample uvs_and_indices;
+      V3fArraySample(sample.points),
+      Int32ArraySample(sample.poly_verts),
+      Int32ArraySample(sample.loop_counts));
 
   if (args_.export_params->uvs) {
-    const char *name = get_uv_sample(uvs_and_indices, m_custom_data_config, &mesh->ldata);
-
-    if (!uvs_and_indices.indices.empty() && !uvs_and_indices.uvs.empty()) {
+    if (!sample.uvs.indices.empty() && !sample.uvs.uvs.empty()) {
       OV2fGeomParam::Sample uv_sample;
-      uv_sample.setVals(V2fArraySample(uvs_and_indices.uvs));
-      uv_sample.setIndices(UInt32ArraySample(uvs_and_indices.indices));
+      uv_sample.setVals(V2fArraySample(sample.uvs.uvs));
+      uv_sample.setIndices(UInt32ArraySample(sample.uvs.indices));
       uv_sample.setScope(kFacevaryingScope);
 
-      abc_poly_mesh_schema_.setUVSourceName(name);
+      abc_poly_mesh_schema_.setUVSourceName(sample.uv_name);
       mesh_sample.setUVs(uv_sample);
     }
 
@@ -254,12 +309,10 @@ void ABCGenericMeshWriter::write_mesh(HierarchyContext &context, Mesh *mesh)
   }
 
   if (args_.export_params->normals) {
-    get_loop_normals(mesh, normals, has_flat_shaded_poly);
-
     ON3fGeomParam::Sample normals_sample;
-    if (!normals.empty()) {
+    if (!sample.normals.empty()) {
       normals_sample.setScope(kFacevaryingScope);
-      normals_sample.setVals(V3fArraySample(normals));
+      normals_sample.setVals(V3fArraySample(sample.normals));
     }
 
     mesh_sample.setNormals(normals_sample);
@@ -269,11 +322,10 @@ void ABCGenericMeshWriter::write_mesh(HierarchyContext &context, Mesh *mesh)
     write_generated_coordinates(abc_poly_mesh_schema_.getArbGeomParams(), m_custom_data_config);
   }
 
-  if (get_velocities(mesh, velocities)) {
-    mesh_sample.setVelocities(V3fArraySample(velocities));
+  if (sample.has_velocities) {
+    mesh_sample.setVelocities(V3fArraySample(sample.velocities));
   }
 
-  update_bounding_box(context.object);
   mesh_sample.setSelfBounds(bounding_box_);
 
   abc_poly_mesh_schema_.set(mesh_sample);
@@ -281,36 +333,27 @@ void ABCGenericMeshWriter::write_mesh(HierarchyContext &context, Mesh *mesh)
   write_arb_geo_params(mesh);
 }
 
-void ABCGenericMeshWriter::write_subd(HierarchyContext &context, struct Mesh *mesh)
+void ABCGenericMeshWriter::write_subd(DeferredSample &sample)
 {
-  std::vector<float> crease_sharpness;
-  std::vector<Imath::V3f> points;
-  std::vector<int32_t> poly_verts, loop_counts;
-  std::vector<int32_t> crease_indices, crease_lengths;
-  bool has_flat_poly = false;
-
-  get_vertices(mesh, points);
-  get_topology(mesh, poly_verts, loop_counts, has_flat_poly);
-  get_creases(mesh, crease_indices, crease_lengths, crease_sharpness);
+  Mesh *mesh = sample.mesh;
 
-  if (!frame_has_been_written_ && args_.export_params->face_sets) {
-    write_face_sets(context.object, mesh, abc_subdiv_schema_);
+  if (sample.write_face_sets) {
+    write_face_sets(sample.geo_groups, abc_subdiv_schema_);
   }
 
   OSubDSchema::Sample subdiv_sample = OSubDSchema::Sample(
-      V3fArraySample(points), Int32ArraySample(poly_verts), Int32ArraySample(loop_counts));
+      V3fArraySample(sample.points),
+      Int32ArraySample(sample.poly_verts),
+      Int32ArraySample(sample.loop_counts));
 
-  UVSample sample;
   if (args_.export_params->uvs) {
-    const char *name = get_uv_sample(sample, m_custom_data_config, &mesh->ldata);
-
-    if (!sample.indices.empty() && !sample.uvs.empty()) {
+    if (!sample.uvs.indices.empty() && !sample.uvs.uvs.empty()) {
       OV2fGeomParam::Sample uv_sample;
-      uv_sample.setVals(V2fArraySample(sample.uvs));
-      uv_sample.setIndices(UInt32ArraySample(sample.indices));
+      uv_sample.setVals(V2fArraySample(sample.uvs.uvs));
+      uv_sample.setIndices(UInt32ArraySample(sample.uvs.indices));
       uv_sample.setScope(kFacevaryingScope);
 
-      abc_subdiv_schema_.setUVSourceName(name);
+      abc_subdiv_schema_.setUVSourceName(sample.uv_name);
       subdiv_sample.setUVs(uv_sample);
     }
 
@@ -322,13 +365,12 @@ void ABCGenericMeshWriter::write_subd(HierarchyContext &context, struct Mesh *me
     write_generated_coordinates(abc_poly_mesh_schema_.getArbGeomParams(), m_custom_data_config);
   }
 
-  if (!crease_indices.empty()) {
-    subdiv_sample.setCreaseIndices(Int32ArraySample(crease_indices));
-    subdiv_sample.setCreaseLengths(Int32ArraySample(crease_lengths));
-    subdiv_sample.setCreaseSharpnesses(FloatArraySample(crease_sharpness));
+  if (!sample.crease_indices.empty()) {
+    subdiv_sample.setCreaseIndices(Int32ArraySample(sample.crease_indices));
+    subdiv_sample.setCreaseLengths(Int32ArraySample(sample.crease_lengths));
+    subdiv_sample.setCreaseSharpnesses(FloatArraySample(sample.crease_sharpness));
   }
 
-  update_bounding_box(context.object);
   subdiv_sample.setSelfBounds(bounding_box_);
   abc_subdiv_schema_.set(subdiv_sample);
 
@@ -336,12 +378,10 @@ void ABCGenericMeshWriter::write_subd(HierarchyContext &context, struct Mesh *me
 }
 
 template<typename Schema>
-void ABCGenericMeshWriter::write_face_sets(Object *object, struct Mesh *mesh, Schema &schema)
+void ABCGenericMeshWriter::write_face_sets(
+    const std::map<std::string, std::vector<int32_t>> &geo_groups, Schema &schema)
 {
-  std::map<std::string, std::vector<int32_t>> geo_groups;
-  get_geo_groups(object, mesh, geo_groups);
-
-  std::map<std::string, std::vector<int32_t>>::iterator it;
+  std::map<std::string, std::vector<int32_t>>::const_iterator it;
   for (it = geo_groups.begin(); it != geo_groups.end(); ++it) {
     OFaceSet face_set = schema.createFaceSet(it->first);
     OFaceSetSchema::Sample samp;
@@ -503,22 +543,41 @@ static void get_creases(struct Mesh *mesh,
   lengths.resize(sharpnesses.size(), 2);
 }
 
+/* If all polygons are smooth shaded, and there are no custom normals, we don't need to export
+ * normals at all. This is also done by other software, see T71246. */
+static bool loop_normals_needed(const Mesh *mesh, const bool has_flat_shaded_poly)
+{
+  return has_flat_shaded_poly || CustomData_has_layer(&mesh->ldata, CD_CUSTOMLOOPNORMAL) ||
+         (mesh->flag & ME_AUTOSMOOTH) != 0;
+}
+
+static void ensure_loop_normals(struct Mesh *mesh)
+{
+  bool has_flat_shaded_poly = false;
+  for (int i = 0, e = mesh->totpoly; i < e; i++) {
+    if ((mesh->mpoly[i].flag & ME_SMOOTH) == 0) {
+      has_flat_shaded_poly = true;
+      break;
+    }
+  }
+
+  if (loop_normals_needed(mesh, has_flat_shaded_poly)) {
+    BKE_mesh_calc_normals_split(mesh);
+  }
+}
+
 static void get_loop_normals(struct Mesh *mesh,
                              std::vector<Imath::V3f> &normals,
                              bool has_flat_shaded_poly)
 {
   normals.clear();
 
-  /* If all polygons are smooth shaded, and there are no custom normals, we don't need to export
-   * normals at all. This is also done by other software, see T71246. */
-  if (!has_flat_shaded_poly && !CustomData_has_layer(&mesh->ldata, CD_CUSTOMLOOPNORMAL) &&
-      (mesh->flag & ME_AUTOSMOOTH) == 0) {
+  if (!loop_normals_needed(mesh, has_flat_shaded_poly)) {
     return;
   }
 
-  BKE_mesh_calc_normals_split(mesh);
   const float(*lnors)[3] = static_cast<float(*)[3]>(CustomData_get_layer(&mesh->ldata, CD_NORMAL));
-  BLI_assert_msg(lnors != nullptr, "BKE_mesh_calc_normals_split() should have computed CD_NORMAL");
+  BLI_assert_msg(lnors != nullptr, "ensure_loop_normals() should have computed CD_NORMAL");
 
   normals.resize(mesh->totloop);
 
@@ -25,6 +25,9 @@
 #include <Alembic/AbcGeom/OPolyMesh.h>
 #include <Alembic/AbcGeom/OSubD.h>
 
+#include <map>
+#include <memory>
+
 struct ModifierData;
 
 namespace blender::io::alembic {
@@ -48,13 +51,41 @@ class ABCGenericMeshWriter : public ABCAbstractWriter {
 
   CDStreamConfig m_custom_data_config;
 
+  /* Mesh gathered by do_write() and its data converted to Alembic arrays, kept until the frame's
+   * samples are written. */
+  struct DeferredSample {
+    Object *object = nullptr;
+    Mesh *mesh = nullptr;
+    bool mesh_needs_free = false;
+    bool write_face_sets = false;
+
+    std::vector<Imath::V3f> points;
+    std::vector<int32_t> poly_verts;
+    std::vector<int32_t> loop_counts;
+    std::vector<Imath::V3f> normals;
+    std::vector<Imath::V3f> velocities;
+    bool has_velocities = false;
+    UVSample uvs;
+    const char *uv_name = nullptr;
+    std::vector<int32_t> crease_indices;
+    std::vector<int32_t> crease_lengths;
+    std::vector<float> crease_sharpness;
+    std::map<std::string, std::vector<int32_t>> geo_groups;
+  };
+  std::unique_ptr<DeferredSample> deferred_sample_;
+
  public:
   explicit ABCGenericMeshWriter(const ABCWriterConstructorArgs &args);
+  virtual ~ABCGenericMeshWriter();
 
   virtual void create_alembic_objects(const HierarchyContext *context) override;
   virtual Alembic::Abc::OObject get_alembic_object() const override;
   Alembic::Abc::OCompoundProperty abc_prop_for_custom_props() override;
 
+  virtual bool has_deferred_data() const override;
+  virtual void prepare_deferred_data() override;
+  virtual void write_deferred_data() override;
+
  protected:
   virtual bool is_supported(const HierarchyContext *context) const override;
   virtual void do_write(HierarchyContext &context) override;
@@ -65,9 +96,12 @@ class ABCGenericMeshWriter : public ABCAbstractWriter {
   virtual bool export_as_subdivision_surface(Object *ob_eval) const;
 
  private:
-  void write_mesh(HierarchyContext &context, Mesh *mesh);
-  void write_subd(HierarchyContext &context, Mesh *mesh);
-  template<typename Schema> void write_face_sets(Object *object, Mesh *mesh, Schema &schema);
+  void write_mesh(DeferredSample &sample);
+  void write_subd(DeferredSample &sample);
+  template<typename Schema>
+  void write_face_sets(const std::map<std::string, std::vector<int32_t>> &geo_groups,
+                       Schema &schema);
+  void free_deferred_sample();
 
   void write_arb_geo_params(Mesh *me);
   bool get_velocities(Mesh *mesh, std::vector<Imath::V3f> &vels);
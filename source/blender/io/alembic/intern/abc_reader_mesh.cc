@@ -20,10 +20,12 @@
 
 #include "abc_reader_mesh.h"
 #include "abc_axis_conversion.h"
+#include "abc_reader_prefetch.h"
 #include "abc_reader_transform.h"
 #include "abc_util.h"
 
 #include <algorithm>
+#include <atomic>
 
 #include "MEM_guardedalloc.h"
 
@@ -36,6 +38,7 @@
 #include "BLI_compiler_compat.h"
 #include "BLI_listbase.h"
 #include "BLI_math_geom.h"
+#include "BLI_task.hh"
 
 #include "BKE_attribute.h"
 #include "BKE_main.h"
@@ -135,17 +138,19 @@ static void read_mverts_interp(MVert *mverts,
                                const P3fArraySamplePtr &ceil_positions,
                                const float weight)
 {
-  float tmp[3];
-  for (int i = 0; i < positions->size(); i++) {
-    MVert &mvert = mverts[i];
-    const Imath::V3f &floor_pos = (*positions)[i];
-    const Imath::V3f &ceil_pos = (*ceil_positions)[i];
+  threading::parallel_for(IndexRange(positions->size()), 4096, [&](IndexRange range) {
+    float tmp[3];
+    for (const int i : range) {
+      MVert &mvert = mverts[i];
+      const Imath::V3f &floor_pos = (*positions)[i];
+      const Imath::V3f &ceil_pos = (*ceil_positions)[i];
 
-    interp_v3_v3v3(tmp, floor_pos.getValue(), ceil_pos.getValue(), weight);
-    copy_zup_from_yup(mvert.co, tmp);
+      interp_v3_v3v3(tmp, floor_pos.getValue(), ceil_pos.getValue(), weight);
+      copy_zup_from_yup(mvert.co, tmp);
 
-    mvert.bweight = 0;
-  }
+      mvert.bweight = 0;
+    }
+  });
 }
 
 static void read_mverts(CDStreamConfig &config, const AbcMeshData &mesh_data)
@@ -165,44 +170,135 @@ static void read_mverts(CDStreamConfig &config, const AbcMeshData &mesh_data)
 
 void read_mverts(MVert *mverts, const P3fArraySamplePtr positions, const N3fArraySamplePtr normals)
 {
-  for (int i = 0; i < positions->size(); i++) {
-    MVert &mvert = mverts[i];
-    Imath::V3f pos_in = (*positions)[i];
+  threading::parallel_for(IndexRange(positions->size()), 4096, [&](IndexRange range) {
+    for (const int i : range) {
+      MVert &mvert = mverts[i];
+      Imath::V3f pos_in = (*positions)[i];
 
-    copy_zup_from_yup(mvert.co, pos_in.getValue());
+      copy_zup_from_yup(mvert.co, pos_in.getValue());
 
-    mvert.bweight = 0;
+      mvert.bweight = 0;
 
-    if (normals) {
-      Imath::V3f nor_in = (*normals)[i];
+      if (normals) {
+        Imath::V3f nor_in = (*normals)[i];
 
-      short no[3];
-      normal_float_to_short_v3(no, nor_in.getValue());
+        short no[3];
+        normal_float_to_short_v3(no, nor_in.getValue());
 
-      copy_zup_from_yup(mvert.no, no);
+        copy_zup_from_yup(mvert.no, no);
+      }
     }
+  });
+}
+
+/**
+ * Check whether the polygons and loops of the mesh are those of the sample, as is the case for
+ * every frame of a cache with constant topology. Only the order written by #read_mpolys() is
+ * accepted, and the mesh must already have its edges.
+ */
+static bool mesh_topology_matches(const CDStreamConfig &config, const AbcMeshData &mesh_data)
+{
+  const Mesh *mesh = config.mesh;
+  const Int32ArraySamplePtr &face_indices = mesh_data.face_indices;
+  const Int32ArraySamplePtr &face_counts = mesh_data.face_counts;
+
+  if (face_counts->size() != mesh->totpoly || face_indices->size() != mesh->totloop) {
+    return false;
+  }
+  if (mesh->totpoly > 0 && (mesh->totedge == 0 || mesh->mpoly[0].loopstart != 0)) {
+    return false;
   }
+
+  std::atomic<bool> matches = true;
+  threading::parallel_for(IndexRange(mesh->totpoly), 1024, [&](IndexRange range) {
+    for (const int i : range) {
+      if (!matches.load(std::memory_order_relaxed)) {
+        return;
+      }
+
+      const MPoly &poly = mesh->mpoly[i];
+      const int face_size = (*face_counts)[i];
+      const int next_loopstart = (i + 1 < mesh->totpoly) ? mesh->mpoly[i + 1].loopstart :
+                                                           mesh->totloop;
+      if (poly.totloop != face_size || poly.loopstart + face_size != next_loopstart ||
+          (poly.flag & ME_SMOOTH) == 0) {
+        matches = false;
+        return;
+      }
+
+      /* NOTE: Alembic data is stored in the reverse order. */
+      for (int f = 0; f < face_size; f++) {
+        const int loop_index = poly.loopstart + f;
+        const int rev_loop_index = poly.loopstart + (face_size - 1) - f;
+        if (mesh->mloop[rev_loop_index].v != (*face_indices)[loop_index]) {
+          matches = false;
+          return;
+        }
+      }
+    }
+  });
+
+  return matches;
 }
 
-static void read_mpolys(CDStreamConfig &config, const AbcMeshData &mesh_data)
+static void read_mloopuvs(CDStreamConfig &config, const AbcMeshData &mesh_data)
 {
   MPoly *mpolys = config.mpoly;
   MLoop *mloops = config.mloop;
   MLoopUV *mloopuvs = config.mloopuv;
 
-  const Int32ArraySamplePtr &face_indices = mesh_data.face_indices;
-  const Int32ArraySamplePtr &face_counts = mesh_data.face_counts;
   const V2fArraySamplePtr &uvs = mesh_data.uvs;
   const size_t uvs_size = uvs == nullptr ? 0 : uvs->size();
-
   const UInt32ArraySamplePtr &uvs_indices = mesh_data.uvs_indices;
 
   const bool do_uvs = (mloopuvs && uvs && uvs_indices);
-  const bool do_uvs_per_loop = do_uvs && mesh_data.uv_scope == ABC_UV_SCOPE_LOOP;
-  BLI_assert(!do_uvs || mesh_data.uv_scope != ABC_UV_SCOPE_NONE);
+  if (!do_uvs) {
+    return;
+  }
+  const bool do_uvs_per_loop = mesh_data.uv_scope == ABC_UV_SCOPE_LOOP;
+  BLI_assert(mesh_data.uv_scope != ABC_UV_SCOPE_NONE);
+
+  threading::parallel_for(IndexRange(config.totpoly), 1024, [&](IndexRange range) {
+    for (const int i : range) {
+      const MPoly &poly = mpolys[i];
+
+      /* NOTE: Alembic data is stored in the reverse order. */
+      for (int f = 0; f < poly.totloop; f++) {
+        const int loop_index = poly.loopstart + f;
+        const int rev_loop_index = poly.loopstart + (poly.totloop - 1) - f;
+        const uint uv_index = (*uvs_indices)[do_uvs_per_loop ? loop_index :
+                                                               mloops[rev_loop_index].v];
+
+        /* Some Alembic files are broken (or at least export UVs in a way we don't expect). */
+        if (uv_index >= uvs_size) {
+          continue;
+        }
+
+        MLoopUV &loopuv = mloopuvs[rev_loop_index];
+        loopuv.uv[0] = (*uvs)[uv_index][0];
+        loopuv.uv[1] = (*uvs)[uv_index][1];
+      }
+    }
+  });
+}
+
+static void read_mpolys(CDStreamConfig &config, const AbcMeshData &mesh_data)
+{
+  if (mesh_topology_matches(config, mesh_data)) {
+    /* Keep the polygons, loops and edges, only per-loop data can differ from the existing mesh.
+     * This avoids recomputing the edges every frame, and keeps edge data such as creases. */
+    read_mloopuvs(config, mesh_data);
+    return;
+  }
+
+  MPoly *mpolys = config.mpoly;
+  MLoop *mloops = config.mloop;
+
+  const Int32ArraySamplePtr &face_indices = mesh_data.face_indices;
+  const Int32ArraySamplePtr &face_counts = mesh_data.face_counts;
+
   unsigned int loop_index = 0;
   unsigned int rev_loop_index = 0;
-  unsigned int uv_index = 0;
   bool seen_invalid_geometry = false;
 
   for (int i = 0; i < face_counts->size(); i++) {
@@ -230,22 +326,11 @@ static void read_mpolys(CDStreamConfig &config, const AbcMeshData &mesh_data)
         seen_invalid_geometry = true;
       }
       last_vertex_index = loop.v;
-
-      if (do_uvs) {
-        MLoopUV &loopuv = mloopuvs[rev_loop_index];
-        uv_index = (*uvs_indices)[do_uvs_per_loop ? loop_index : loop.v];
-
-        /* Some Alembic files are broken (or at least export UVs in a way we don't expect). */
-        if (uv_index >= uvs_size) {
-          continue;
-        }
-
-        loopuv.uv[0] = (*uvs)[uv_index][0];
-        loopuv.uv[1] = (*uvs)[uv_index][1];
-      }
     }
   }
 
+  read_mloopuvs(config, mesh_data);
+
   BKE_mesh_calc_edges(config.mesh, false, false);
   if (seen_invalid_geometry) {
     if (config.modifier_error_message) {
@@ -283,16 +368,20 @@ static void process_loop_normals(CDStreamConfig &config, const N3fArraySamplePtr
   float(*lnors)[3] = static_cast<float(*)[3]>(
       MEM_malloc_arrayN(loop_count, sizeof(float[3]), "ABC::FaceNormals"));
 
-  MPoly *mpoly = mesh->mpoly;
+  const MPoly *mpolys = mesh->mpoly;
   const N3fArraySample &loop_normals = *loop_normals_ptr;
-  int abc_index = 0;
-  for (int i = 0, e = mesh->totpoly; i < e; i++, mpoly++) {
-    /* As usual, ABC orders the loops in reverse. */
-    for (int j = mpoly->totloop - 1; j >= 0; j--, abc_index++) {
-      int blender_index = mpoly->loopstart + j;
-      copy_zup_from_yup(lnors[blender_index], loop_normals[abc_index].getValue());
+  threading::parallel_for(IndexRange(mesh->totpoly), 1024, [&](IndexRange range) {
+    for (const int i : range) {
+      const MPoly &mpoly = mpolys[i];
+      /* As usual, ABC orders the loops in reverse. The loops of the polygons are consecutive, as
+       * written by read_mpolys(). */
+      int abc_index = mpoly.loopstart;
+      for (int j = mpoly.totloop - 1; j >= 0; j--, abc_index++) {
+        int blender_index = mpoly.loopstart + j;
+        copy_zup_from_yup(lnors[blender_index], loop_normals[abc_index].getValue());
+      }
     }
-  }
+  });
 
   mesh->flag |= ME_AUTOSMOOTH;
   BKE_mesh_set_custom_normals(mesh, lnors);
@@ -313,9 +402,11 @@ static void process_vertex_normals(CDStreamConfig &config,
       MEM_malloc_arrayN(normals_count, sizeof(float[3]), "ABC::VertexNormals"));
 
   const N3fArraySample &vertex_normals = *vertex_normals_ptr;
-  for (int index = 0; index < normals_count; index++) {
-    copy_zup_from_yup(vnors[index], vertex_normals[index].getValue());
-  }
+  threading::parallel_for(IndexRange(normals_count), 4096, [&](IndexRange range) {
+    for (const int index : range) {
+      copy_zup_from_yup(vnors[index], vertex_normals[index].getValue());
+    }
+  });
 
   config.mesh->flag |= ME_AUTOSMOOTH;
   BKE_mesh_set_custom_normals_from_vertices(config.mesh, vnors);
@@ -474,20 +565,23 @@ static void read_velocity(const V3fArraySamplePtr &velocities,
       &config.mesh->id, "velocity", CD_PROP_FLOAT3, ATTR_DOMAIN_POINT, nullptr);
   float(*velocity)[3] = (float(*)[3])velocity_layer->data;
 
-  for (int i = 0; i < num_velocity_vectors; i++) {
-    const Imath::V3f &vel_in = (*velocities)[i];
-    copy_zup_from_yup(velocity[i], vel_in.getValue());
-    mul_v3_fl(velocity[i], velocity_scale);
-  }
+  threading::parallel_for(IndexRange(num_velocity_vectors), 4096, [&](IndexRange range) {
+    for (const int i : range) {
+      const Imath::V3f &vel_in = (*velocities)[i];
+      copy_zup_from_yup(velocity[i], vel_in.getValue());
+      mul_v3_fl(velocity[i], velocity_scale);
+    }
+  });
 }
 
 static void read_mesh_sample(const std::string &iobject_full_name,
                              ImportSettings *settings,
                              const IPolyMeshSchema &schema,
+                             SamplePrefetcher<IPolyMeshSchema> &prefetcher,
+                             const IPolyMeshSchema::Sample &sample,
                              const ISampleSelector &selector,
                              CDStreamConfig &config)
 {
-  const IPolyMeshSchema::Sample sample = schema.getValue(selector);
 
   AbcMeshData abc_mesh_data;
   abc_mesh_data.face_counts = sample.getFaceCounts();
@@ -497,8 +591,8 @@ static void read_mesh_sample(const std::string &iobject_full_name,
   get_weight_and_index(config, schema.getTimeSampling(), schema.getNumSamples());
 
   if (config.weight != 0.0f) {
-    Alembic::AbcGeom::IPolyMeshSchema::Sample ceil_sample;
-    schema.get(ceil_sample, Alembic::Abc::ISampleSelector(config.ceil_index));
+    const IPolyMeshSchema::Sample ceil_sample = prefetcher.get_value(
+        schema, Alembic::Abc::ISampleSelector(config.ceil_index));
     abc_mesh_data.ceil_positions = ceil_sample.getPositions();
   }
 
@@ -675,7 +769,7 @@ bool AbcMeshReader::topology_changed(Mesh *existing_mesh, const ISampleSelector
 {
   IPolyMeshSchema::Sample sample;
   try {
-    sample = m_schema.getValue(sample_sel);
+    sample = m_prefetcher.get_value(m_schema, sample_sel);
   }
   catch (Alembic::Util::Exception &ex) {
     printf("Alembic: error reading mesh sample for '%s/%s' at time %f: %s\n",
@@ -705,7 +799,7 @@ Mesh *AbcMeshReader::read_mesh(Mesh *existing_mesh,
 {
   IPolyMeshSchema::Sample sample;
   try {
-    sample = m_schema.getValue(sample_sel);
+    sample = m_prefetcher.get_value(m_schema, sample_sel);
   }
   catch (Alembic::Util::Exception &ex) {
     if (err_str != nullptr) {
@@ -774,7 +868,8 @@ Mesh *AbcMeshReader::read_mesh(Mesh *existing_mesh,
   config.time = sample_sel.getRequestedTime();
   config.modifier_error_message = err_str;
 
-  read_mesh_sample(m_iobject.getFullName(), &settings, m_schema, sample_sel, config);
+  read_mesh_sample(
+      m_iobject.getFullName(), &settings, m_schema, m_prefetcher, sample, sample_sel, config);
 
   if (new_mesh) {
     /* Here we assume that the number of materials doesn't change, i.e. that
@@ -792,6 +887,11 @@ Mesh *AbcMeshReader::read_mesh(Mesh *existing_mesh,
   return existing_mesh;
 }
 
+void AbcMeshReader::prefetch_samples(const ISampleSelector &sample_sel)
+{
+  m_prefetcher.prefetch(m_schema, sample_sel);
+}
+
 void AbcMeshReader::assign_facesets_to_mpoly(const ISampleSelector &sample_sel,
                                              MPoly *mpoly,
                                              int totpoly,
@@ -864,10 +964,11 @@ BLI_INLINE MEdge *find_edge(MEdge *edges, int totedge, int v1, int v2)
 static void read_subd_sample(const std::string &iobject_full_name,
                              ImportSettings *settings,
                              const ISubDSchema &schema,
+                             SamplePrefetcher<ISubDSchema> &prefetcher,
+                             const ISubDSchema::Sample &sample,
                              const ISampleSelector &selector,
                              CDStreamConfig &config)
 {
-  const ISubDSchema::Sample sample = schema.getValue(selector);
 
   AbcMeshData abc_mesh_data;
   abc_mesh_data.face_counts = sample.getFaceCounts();
@@ -877,8 +978,8 @@ static void read_subd_sample(const std::string &iobject_full_name,
   get_weight_and_index(config, schema.getTimeSampling(), schema.getNumSamples());
 
   if (config.weight != 0.0f) {
-    Alembic::AbcGeom::ISubDSchema::Sample ceil_sample;
-    schema.get(ceil_sample, Alembic::Abc::ISampleSelector(config.ceil_index));
+    const ISubDSchema::Sample ceil_sample = prefetcher.get_value(
+        schema, Alembic::Abc::ISampleSelector(config.ceil_index));
     abc_mesh_data.ceil_positions = ceil_sample.getPositions();
   }
 
@@ -962,7 +1063,7 @@ void AbcSubDReader::readObjectData(Main *bmain, const Alembic::Abc::ISampleSelec
 
   ISubDSchema::Sample sample;
   try {
-    sample = m_schema.getValue(sample_sel);
+    sample = m_prefetcher.get_value(m_schema, sample_sel);
   }
   catch (Alembic::Util::Exception &ex) {
     printf("Alembic: error reading mesh sample for '%s/%s' at time %f: %s\n",
@@ -1021,7 +1122,7 @@ Mesh *AbcSubDReader::read_mesh(Mesh *existing_mesh,
 {
   ISubDSchema::Sample sample;
   try {
-    sample = m_schema.getValue(sample_sel);
+    sample = m_prefetcher.get_value(m_schema, sample_sel);
   }
   catch (Alembic::Util::Exception &ex) {
     if (err_str != nullptr) {
@@ -1073,9 +1174,15 @@ Mesh *AbcSubDReader::read_mesh(Mesh *existing_mesh,
   const bool use_vertex_interpolation = read_flag & MOD_MESHSEQ_INTERPOLATE_VERTICES;
   CDStreamConfig config = get_config(mesh_to_export, use_vertex_interpolation);
   config.time = sample_sel.getRequestedTime();
-  read_subd_sample(m_iobject.getFullName(), &settings, m_schema, sample_sel, config);
+  read_subd_sample(
+      m_iobject.getFullName(), &settings, m_schema, m_prefetcher, sample, sample_sel, config);
 
   return mesh_to_export;
 }
 
+void AbcSubDReader::prefetch_samples(const ISampleSelector &sample_sel)
+{
+  m_prefetcher.prefetch(m_schema, sample_sel);
+}
+
 }  // namespace blender::io::alembic
@@ -21,6 +21,7 @@
 
 #include "abc_customdata.h"
 #include "abc_reader_object.h"
+#include "abc_reader_prefetch.h"
 
 struct Mesh;
 
@@ -28,6 +29,7 @@ namespace blender::io::alembic {
 
 class AbcMeshReader final : public AbcObjectReader {
   Alembic::AbcGeom::IPolyMeshSchema m_schema;
+  SamplePrefetcher<Alembic::AbcGeom::IPolyMeshSchema> m_prefetcher;
 
   CDStreamConfig m_mesh_data;
 
@@ -46,6 +48,7 @@ class AbcMeshReader final : public AbcObjectReader {
                          const char *velocity_name,
                          float velocity_scale,
                          const char **err_str) override;
+  void prefetch_samples(const Alembic::Abc::ISampleSelector &sample_sel) override;
   bool topology_changed(Mesh *existing_mesh,
                         const Alembic::Abc::ISampleSelector &sample_sel) override;
 
@@ -62,6 +65,7 @@ class AbcMeshReader final : public AbcObjectReader {
 
 class AbcSubDReader final : public AbcObjectReader {
   Alembic::AbcGeom::ISubDSchema m_schema;
+  SamplePrefetcher<Alembic::AbcGeom::ISubDSchema> m_prefetcher;
 
   CDStreamConfig m_mesh_data;
 
@@ -79,6 +83,7 @@ class AbcSubDReader final : public AbcObjectReader {
                          const char *velocity_name,
                          float velocity_scale,
                          const char **err_str) override;
+  void prefetch_samples(const Alembic::Abc::ISampleSelector &sample_sel) override;
 };
 
 void read_mverts(MVert *mverts,
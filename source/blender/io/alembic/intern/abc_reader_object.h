@@ -156,6 +156,10 @@ class AbcObjectReader {
   virtual bool topology_changed(Mesh *existing_mesh,
                                 const Alembic::Abc::ISampleSelector &sample_sel);
 
+  /* Start reading the data following `sample_sel` in the background, for faster reading of the
+   * next frames during playback. */
+  virtual void prefetch_samples(const Alembic::Abc::ISampleSelector &sample_sel);
+
   /** Reads the object matrix and sets up an object transform if animated. */
   void setupObjectTransform(float time);
 
@@ -0,0 +1,162 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+#pragma once
+
+/** \file
+ * \ingroup balembic
+ */
+
+#include <Alembic/Abc/All.h>
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <set>
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_task.h"
+
+namespace blender::io::alembic {
+
+/**
+ * Reads the samples following the last requested one in a background task pool, so that reading
+ * them when playing back a cache does not wait for I/O. Only the samples in a small window after
+ * the last requested sample are kept, others are dropped when the window moves.
+ *
+ * Ogawa archives can be read from multiple threads, reads of the same stream are serialized by
+ * Alembic itself.
+ */
+template<typename Schema> class SamplePrefetcher {
+ public:
+  using Sample = typename Schema::Sample;
+  using index_t = Alembic::AbcCoreAbstract::index_t;
+
+  /* Number of samples read ahead of the last requested sample. */
+  static constexpr index_t prefetch_count = 3;
+
+ private:
+  /* Copy of the schema of the reader, only read by the prefetch tasks. */
+  Schema schema_;
+  TaskPool *task_pool_ = nullptr;
+
+  /* Protects all members below. */
+  std::mutex mutex_;
+  std::map<index_t, Sample> samples_;
+  std::set<index_t> scheduled_;
+  index_t window_start_ = 0;
+  index_t window_end_ = 0;
+
+  struct PrefetchTask {
+    index_t index;
+  };
+
+ public:
+  SamplePrefetcher() = default;
+  SamplePrefetcher(const SamplePrefetcher &other) = delete;
+  SamplePrefetcher &operator=(const SamplePrefetcher &other) = delete;
+
+  ~SamplePrefetcher()
+  {
+    if (task_pool_) {
+      BLI_task_pool_cancel(task_pool_);
+      BLI_task_pool_free(task_pool_);
+    }
+  }
+
+  /* Read the sample for `selector`, using the prefetched sample when there is one. */
+  Sample get_value(const Schema &schema, const Alembic::Abc::ISampleSelector &selector)
+  {
+    const index_t index = selector.getIndex(schema.getTimeSampling(), schema.getNumSamples());
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      typename std::map<index_t, Sample>::const_iterator it = samples_.find(index);
+      if (it != samples_.end()) {
+        return it->second;
+      }
+    }
+
+    Sample sample;
+    schema.get(sample, Alembic::Abc::ISampleSelector(index));
+    return sample;
+  }
+
+  /* Start reading the samples following the sample for `selector`. */
+  void prefetch(const Schema &schema, const Alembic::Abc::ISampleSelector &selector)
+  {
+    const index_t num_samples = schema.getNumSamples();
+    if (num_samples < 2) {
+      return;
+    }
+    const index_t index = selector.getIndex(schema.getTimeSampling(), num_samples);
+
+    if (task_pool_ == nullptr) {
+      schema_ = schema;
+      task_pool_ = BLI_task_pool_create_background(this, TASK_PRIORITY_LOW);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    window_start_ = index;
+    window_end_ = std::min(index + prefetch_count, num_samples - 1);
+
+    for (typename std::map<index_t, Sample>::iterator it = samples_.begin();
+         it != samples_.end();) {
+      if (it->first < window_start_ || it->first > window_end_) {
+        it = samples_.erase(it);
+      }
+      else {
+        ++it;
+      }
+    }
+
+    for (index_t i = index + 1; i <= window_end_; i++) {
+      if (samples_.count(i) || scheduled_.count(i)) {
+        continue;
+      }
+      scheduled_.insert(i);
+
+      PrefetchTask *task = static_cast<PrefetchTask *>(
+          MEM_mallocN(sizeof(PrefetchTask), "ABC prefetch task"));
+      task->index = i;
+      BLI_task_pool_push(task_pool_, prefetch_task_run, task, true, nullptr);
+    }
+  }
+
+ private:
+  static void prefetch_task_run(TaskPool *__restrict pool, void *taskdata)
+  {
+    SamplePrefetcher *prefetcher = static_cast<SamplePrefetcher *>(BLI_task_pool_user_data(pool));
+    const index_t index = static_cast<PrefetchTask *>(taskdata)->index;
+
+    Sample sample;
+    bool is_valid = true;
+    try {
+      prefetcher->schema_.get(sample, Alembic::Abc::ISampleSelector(index));
+    }
+    catch (Alembic::Util::Exception & /*ex*/) {
+      /* Reading again when the sample is requested reports the error. */
+      is_valid = false;
+    }
+
+    std::lock_guard<std::mutex> lock(prefetcher->mutex_);
+    prefetcher->scheduled_.erase(index);
+    if (is_valid && index >= prefetcher->window_start_ && index <= prefetcher->window_end_) {
+      prefetcher->samples_[index] = sample;
+    }
+  }
+};
+
+}  // namespace blender::io::alembic
@@ -796,8 +796,12 @@ Mesh *ABC_read_mesh(CacheReader *reader,
   }
 
   ISampleSelector sample_sel = sample_selector_for_time(time);
-  return abc_reader->read_mesh(
+  Mesh *mesh = abc_reader->read_mesh(
       existing_mesh, sample_sel, read_flag, velocity_name, velocity_scale, err_str);
+
+  /* Read the next samples in the background while the rest of the frame is evaluated. */
+  abc_reader->prefetch_samples(sample_sel);
+  return mesh;
 }
 
 bool ABC_mesh_topology_changed(
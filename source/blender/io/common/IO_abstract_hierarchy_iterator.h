@@ -42,6 +42,7 @@
 #include <map>
 #include <set>
 #include <string>
+#include <vector>
 
 struct Depsgraph;
 struct DupliObject;
@@ -125,6 +126,19 @@ class AbstractHierarchyWriter {
  public:
   virtual ~AbstractHierarchyWriter() = default;
   virtual void write(HierarchyContext &context) = 0;
+
+  /* Writers with expensive data conversion can defer it, so that it runs on multiple threads.
+   * write() then only gathers the data, prepare_deferred_data() converts it and
+   * write_deferred_data() writes the result to the file. After calling the writers of a frame,
+   * the AbstractHierarchyIterator calls prepare_deferred_data() of all writers that have deferred
+   * data in parallel, and then write_deferred_data() of each of them in export path order.
+   *
+   * prepare_deferred_data() must not modify data shared with other writers, and must not write to
+   * the file. */
+  virtual bool has_deferred_data() const;
+  virtual void prepare_deferred_data();
+  virtual void write_deferred_data();
+
   /* TODO(Sybren): add function like absent() that's called when a writer was previously created,
    * but wasn't used while exporting the current frame (for example, a particle-instanced mesh of
    * which the particle is no longer alive). */
@@ -279,10 +293,14 @@ class AbstractHierarchyIterator {
   void determine_duplication_references(const HierarchyContext *parent_context,
                                         std::string indent);
 
-  /* These three functions create writers and call their write() method. */
+  /* These functions create writers and call their write() method. */
   void make_writers(const HierarchyContext *parent_context);
   void make_writer_object_data(const HierarchyContext *context);
   void make_writers_particle_systems(const HierarchyContext *context);
+  void make_writers_instancer(const HierarchyContext *context);
+
+  /* Prepare the deferred data of all writers in parallel, then write it in export path order. */
+  void write_deferred_data();
 
   /* Return the appropriate HierarchyContext for the data of the object represented by
    * object_context. */
@@ -323,6 +341,18 @@ class AbstractHierarchyIterator {
 
   virtual bool should_visit_dupli_object(const DupliObject *dupli_object) const;
 
+  /* Return whether the instances of this object should be written by a single instancer writer,
+   * see create_instancer_writer(), instead of visiting each dupli-object separately.
+   *
+   * When this returns true, the dupli-objects of this object are not visited. Instead a writer
+   * for the instancer is created as child of the object, and the objects returned by
+   * get_instancer_prototypes() are written once as children of the instancer. */
+  virtual bool should_export_as_instancer(const Object *object) const;
+
+  /* Return the objects instanced by this object, in the order the instancer writer refers to
+   * them. Only called when should_export_as_instancer() returned true. */
+  virtual std::vector<Object *> get_instancer_prototypes(const Object *object) const;
+
   virtual ExportGraph::key_type determine_graph_index_object(const HierarchyContext *context);
   virtual ExportGraph::key_type determine_graph_index_dupli(
       const HierarchyContext *context,
@@ -342,6 +372,8 @@ class AbstractHierarchyIterator {
   virtual AbstractHierarchyWriter *create_data_writer(const HierarchyContext *context) = 0;
   virtual AbstractHierarchyWriter *create_hair_writer(const HierarchyContext *context) = 0;
   virtual AbstractHierarchyWriter *create_particle_writer(const HierarchyContext *context) = 0;
+  /* Only called when should_export_as_instancer() returns true, so this is not pure virtual. */
+  virtual AbstractHierarchyWriter *create_instancer_writer(const HierarchyContext *context);
 
   /* Called by release_writers() to free what the create_XXX_writer() functions allocated. */
   virtual void release_writer(AbstractHierarchyWriter *writer) = 0;
@@ -34,6 +34,8 @@
 #include "BLI_assert.h"
 #include "BLI_listbase.h"
 #include "BLI_math_matrix.h"
+#include "BLI_task.hh"
+#include "BLI_vector.hh"
 
 #include "DNA_ID.h"
 #include "DNA_layer_types.h"
@@ -137,6 +139,19 @@ AbstractHierarchyWriter *EnsuredWriter::operator->()
   return writer_;
 }
 
+bool AbstractHierarchyWriter::has_deferred_data() const
+{
+  return false;
+}
+
+void AbstractHierarchyWriter::prepare_deferred_data()
+{
+}
+
+void AbstractHierarchyWriter::write_deferred_data()
+{
+}
+
 bool AbstractHierarchyWriter::check_is_animated(const HierarchyContext &context) const
 {
   const Object *object = context.object;
@@ -200,6 +215,7 @@ void AbstractHierarchyIterator::iterate_and_write()
   determine_export_paths(HierarchyContext::root());
   determine_duplication_references(HierarchyContext::root(), "");
   make_writers(HierarchyContext::root());
+  write_deferred_data();
   export_graph_clear();
 }
 
@@ -296,6 +312,11 @@ void AbstractHierarchyIterator::export_graph_construct()
       continue;
     }
 
+    if (should_export_as_instancer(object)) {
+      /* The instances are written by the instancer writer of this object. */
+      continue;
+    }
+
     /* Export the duplicated objects instanced by this object. */
     ListBase *lb = object_duplilist(depsgraph_, scene, object);
     if (lb) {
@@ -610,6 +631,10 @@ void AbstractHierarchyIterator::make_writers(const HierarchyContext *parent_cont
     if (!context->weak_export) {
       make_writers_particle_systems(context);
       make_writer_object_data(context);
+
+      if (context->duplicator == nullptr && should_export_as_instancer(context->object)) {
+        make_writers_instancer(context);
+      }
     }
 
     /* Recurse into this object's children. */
@@ -620,6 +645,30 @@ void AbstractHierarchyIterator::make_writers(const HierarchyContext *parent_cont
    */
 }
 
+void AbstractHierarchyIterator::write_deferred_data()
+{
+  Vector<AbstractHierarchyWriter *> deferred_writers;
+  for (WriterMap::value_type &it : writers_) {
+    if (it.second->has_deferred_data()) {
+      deferred_writers.append(it.second);
+    }
+  }
+  if (deferred_writers.is_empty()) {
+    return;
+  }
+
+  /* Converting the data is independent per writer, but files can only be written from one thread
+   * at a time. */
+  threading::parallel_for(deferred_writers.index_range(), 1, [&](IndexRange range) {
+    for (const int i : range) {
+      deferred_writers[i]->prepare_deferred_data();
+    }
+  });
+  for (AbstractHierarchyWriter *writer : deferred_writers) {
+    writer->write_deferred_data();
+  }
+}
+
 HierarchyContext AbstractHierarchyIterator::context_for_object_data(
     const HierarchyContext *object_context) const
 {
@@ -704,6 +753,54 @@ void AbstractHierarchyIterator::make_writers_particle_systems(
   }
 }
 
+void AbstractHierarchyIterator::make_writers_instancer(const HierarchyContext *context)
+{
+  HierarchyContext instancer_context = *context;
+  instancer_context.export_name = "Instances";
+  instancer_context.export_path = path_concatenate(context->export_path,
+                                                   instancer_context.export_name);
+  instancer_context.higher_up_export_path = context->export_path;
+
+  EnsuredWriter instancer_writer = ensure_writer(
+      &instancer_context, &AbstractHierarchyIterator::create_instancer_writer);
+  if (!instancer_writer) {
+    return;
+  }
+
+  /* Always write upon creation, otherwise depend on which subset is active. */
+  if (instancer_writer.is_newly_created() || export_subset_.shapes) {
+    instancer_writer->write(instancer_context);
+  }
+
+  /* Write each prototype once, in the space of the instancer. Instance transforms are relative
+   * to the instancer, so the prototypes themselves are not transformed. */
+  for (Object *prototype : get_instancer_prototypes(context->object)) {
+    HierarchyContext prototype_context = *context;
+    prototype_context.object = prototype;
+    prototype_context.export_parent = context->object;
+    /* The prototype isn't moved by the duplicator, so it's written as a regular object. */
+    prototype_context.duplicator = nullptr;
+    prototype_context.animation_check_include_parent = false;
+    prototype_context.export_name = get_object_name(prototype);
+    prototype_context.export_path = path_concatenate(instancer_context.export_path,
+                                                     prototype_context.export_name);
+    prototype_context.higher_up_export_path = instancer_context.export_path;
+    prototype_context.original_export_path = "";
+    unit_m4(prototype_context.matrix_world);
+    unit_m4(prototype_context.parent_matrix_inv_world);
+
+    EnsuredWriter transform_writer = ensure_writer(
+        &prototype_context, &AbstractHierarchyIterator::create_transform_writer);
+    if (!transform_writer) {
+      continue;
+    }
+    if (transform_writer.is_newly_created() || export_subset_.transforms) {
+      transform_writer->write(prototype_context);
+    }
+    make_writer_object_data(&prototype_context);
+  }
+}
+
 std::string AbstractHierarchyIterator::get_object_name(const Object *object) const
 {
   return get_id_name(&object->id);
@@ -759,4 +856,21 @@ bool AbstractHierarchyIterator::should_visit_dupli_object(const DupliObject *dup
   return !dupli_object->no_draw;
 }
 
+bool AbstractHierarchyIterator::should_export_as_instancer(const Object * /*object*/) const
+{
+  return false;
+}
+
+std::vector<Object *> AbstractHierarchyIterator::get_instancer_prototypes(
+    const Object * /*object*/) const
+{
+  return {};
+}
+
+AbstractHierarchyWriter *AbstractHierarchyIterator::create_instancer_writer(
+    const HierarchyContext * /*context*/)
+{
+  return nullptr;
+}
+
 }  // namespace blender::io
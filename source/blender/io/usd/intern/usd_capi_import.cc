@@ -46,6 +46,7 @@
 #include "BLI_math_rotation.h"
 #include "BLI_path_util.h"
 #include "BLI_string.h"
+#include "BLI_task.hh"
 
 #include "DEG_depsgraph.h"
 #include "DEG_depsgraph_build.h"
@@ -232,13 +233,36 @@ static void import_startjob(void *customdata, short *stop, short *do_update, flo
   archive->collect_readers(data->bmain);
 
   *data->progress = 0.2f;
+  *data->do_update = true;
+
+  /* Read the prim data that doesn't need Main in parallel, the rest is read below. */
+  const std::vector<USDPrimReader *> &readers = archive->readers();
+  blender::threading::parallel_for(
+      blender::IndexRange(readers.size()), 1, [&](blender::IndexRange range) {
+        for (const int64_t reader_index : range) {
+          if (G.is_break) {
+            return;
+          }
+          if (USDPrimReader *reader = readers[reader_index]) {
+            reader->prepare_object_data(0.0);
+          }
+        }
+      });
+
+  if (G.is_break) {
+    data->was_canceled = true;
+    return;
+  }
+
+  *data->progress = 0.6f;
+  *data->do_update = true;
 
-  const float size = static_cast<float>(archive->readers().size());
+  const float size = static_cast<float>(readers.size());
   size_t i = 0;
 
   /* Setup parenthood */
 
-  for (USDPrimReader *reader : archive->readers()) {
+  for (USDPrimReader *reader : readers) {
 
     if (!reader) {
       continue;
@@ -257,7 +281,7 @@ static void import_startjob(void *customdata, short *stop, short *do_update, flo
       ob->parent = parent->object();
     }
 
-    *data->progress = 0.2f + 0.8f * (++i / size);
+    *data->progress = 0.6f + 0.4f * (++i / size);
     *data->do_update = true;
 
     if (G.is_break) {
@@ -25,6 +25,7 @@
 #include "usd_writer_light.h"
 #include "usd_writer_mesh.h"
 #include "usd_writer_metaball.h"
+#include "usd_writer_point_instancer.h"
 #include "usd_writer_transform.h"
 
 #include <string>
@@ -59,6 +60,16 @@ bool USDHierarchyIterator::mark_as_weak_export(const Object *object) const
   return false;
 }
 
+bool USDHierarchyIterator::should_export_as_instancer(const Object *object) const
+{
+  return params_.use_instancing && USDPointInstancerWriter::get_instances(object) != nullptr;
+}
+
+std::vector<Object *> USDHierarchyIterator::get_instancer_prototypes(const Object *object) const
+{
+  return USDPointInstancerWriter::get_prototypes(object);
+}
+
 void USDHierarchyIterator::release_writer(AbstractHierarchyWriter *writer)
 {
   delete static_cast<USDAbstractWriter *>(writer);
@@ -147,4 +158,10 @@ AbstractHierarchyWriter *USDHierarchyIterator::create_particle_writer(
   return nullptr;
 }
 
+AbstractHierarchyWriter *USDHierarchyIterator::create_instancer_writer(
+    const HierarchyContext *context)
+{
+  return new USDPointInstancerWriter(create_usd_export_context(context));
+}
+
 }  // namespace blender::io::usd
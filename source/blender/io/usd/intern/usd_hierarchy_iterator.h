@@ -23,6 +23,7 @@
 #include "usd_exporter_context.h"
 
 #include <string>
+#include <vector>
 
 #include <pxr/usd/usd/common.h>
 #include <pxr/usd/usd/timeCode.h>
@@ -54,6 +55,8 @@ class USDHierarchyIterator : public AbstractHierarchyIterator {
 
  protected:
   virtual bool mark_as_weak_export(const Object *object) const override;
+  virtual bool should_export_as_instancer(const Object *object) const override;
+  virtual std::vector<Object *> get_instancer_prototypes(const Object *object) const override;
 
   virtual AbstractHierarchyWriter *create_transform_writer(
       const HierarchyContext *context) override;
@@ -61,6 +64,8 @@ class USDHierarchyIterator : public AbstractHierarchyIterator {
   virtual AbstractHierarchyWriter *create_hair_writer(const HierarchyContext *context) override;
   virtual AbstractHierarchyWriter *create_particle_writer(
       const HierarchyContext *context) override;
+  virtual AbstractHierarchyWriter *create_instancer_writer(
+      const HierarchyContext *context) override;
 
   virtual void release_writer(AbstractHierarchyWriter *writer) override;
 
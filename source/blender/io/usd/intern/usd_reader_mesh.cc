@@ -23,6 +23,7 @@
 #include "usd_reader_material.h"
 
 #include "BKE_customdata.h"
+#include "BKE_lib_id.h"
 #include "BKE_main.h"
 #include "BKE_material.h"
 #include "BKE_mesh.h"
@@ -190,10 +191,25 @@ USDMeshReader::USDMeshReader(const pxr::UsdPrim &prim,
       is_left_handed_(false),
       has_uvs_(false),
       is_time_varying_(false),
-      is_initial_load_(false)
+      is_initial_load_(false),
+      prepared_mesh_(nullptr),
+      instance_source_(nullptr)
 {
 }
 
+USDMeshReader::~USDMeshReader()
+{
+  /* The import was cancelled before the prepared mesh was used. */
+  if (prepared_mesh_) {
+    BKE_id_free(nullptr, prepared_mesh_);
+  }
+}
+
+void USDMeshReader::set_instance_source(USDMeshReader *instance_source)
+{
+  instance_source_ = instance_source;
+}
+
 void USDMeshReader::create_object(Main *bmain, const double /* motionSampleTime */)
 {
   Mesh *mesh = BKE_mesh_add(bmain, name_.c_str());
@@ -202,27 +218,61 @@ void USDMeshReader::create_object(Main *bmain, const double /* motionSampleTime
   object_->data = mesh;
 }
 
-void USDMeshReader::read_object_data(Main *bmain, const double motionSampleTime)
+void USDMeshReader::prepare_object_data(const double motionSampleTime)
 {
+  if (instance_source_) {
+    return;
+  }
+
   Mesh *mesh = (Mesh *)object_->data;
 
   is_initial_load_ = true;
   Mesh *read_mesh = this->read_mesh(
       mesh, motionSampleTime, import_params_.mesh_read_flag, nullptr);
-
   is_initial_load_ = false;
+
   if (read_mesh != mesh) {
-    /* FIXME: after 2.80; `mesh->flag` isn't copied by #BKE_mesh_nomain_to_mesh() */
-    /* read_mesh can be freed by BKE_mesh_nomain_to_mesh(), so get the flag before that happens. */
-    short autosmooth = (read_mesh->flag & ME_AUTOSMOOTH);
-    BKE_mesh_nomain_to_mesh(read_mesh, mesh, object_, &CD_MASK_MESH, true);
-    mesh->flag |= autosmooth;
+    prepared_mesh_ = read_mesh;
   }
+}
 
-  readFaceSetsSample(bmain, mesh, motionSampleTime);
+void USDMeshReader::read_object_data(Main *bmain, const double motionSampleTime)
+{
+  Mesh *mesh = (Mesh *)object_->data;
 
-  if (mesh_prim_.GetPointsAttr().ValueMightBeTimeVarying()) {
-    is_time_varying_ = true;
+  if (instance_source_ && instance_source_->object()) {
+    /* Share the mesh of the first instance of the same prototype. */
+    Mesh *shared_mesh = (Mesh *)instance_source_->object()->data;
+    id_us_plus(&shared_mesh->id);
+    object_->data = shared_mesh;
+    BKE_id_free(bmain, mesh);
+    BKE_object_materials_test(bmain, object_, &shared_mesh->id);
+    is_time_varying_ = instance_source_->is_time_varying_;
+  }
+  else {
+    Mesh *read_mesh = prepared_mesh_;
+    prepared_mesh_ = nullptr;
+
+    if (read_mesh == nullptr) {
+      is_initial_load_ = true;
+      read_mesh = this->read_mesh(mesh, motionSampleTime, import_params_.mesh_read_flag, nullptr);
+      is_initial_load_ = false;
+    }
+
+    if (read_mesh != mesh) {
+      /* FIXME: after 2.80; `mesh->flag` isn't copied by #BKE_mesh_nomain_to_mesh() */
+      /* read_mesh can be freed by BKE_mesh_nomain_to_mesh(), so get the flag before that
+       * happens. */
+      short autosmooth = (read_mesh->flag & ME_AUTOSMOOTH);
+      BKE_mesh_nomain_to_mesh(read_mesh, mesh, object_, &CD_MASK_MESH, true);
+      mesh->flag |= autosmooth;
+    }
+
+    readFaceSetsSample(bmain, mesh, motionSampleTime);
+
+    if (mesh_prim_.GetPointsAttr().ValueMightBeTimeVarying()) {
+      is_time_varying_ = true;
+    }
   }
 
   if (is_time_varying_) {
@@ -55,6 +55,13 @@ class USDMeshReader : public USDGeomReader {
    * implemented.  Note this will break if faces or positions vary. */
   bool is_initial_load_;
 
+  /* Mesh read by prepare_object_data(), to be moved into the object data by read_object_data(). */
+  Mesh *prepared_mesh_;
+
+  /* Reader of the first instance of the same prototype, whose mesh is shared with this reader's
+   * object instead of reading it again. Only set for instance proxies. */
+  USDMeshReader *instance_source_;
+
  public:
   USDMeshReader(const pxr::UsdPrim &prim,
                 const USDImportParams &import_params,
@@ -62,9 +69,14 @@ class USDMeshReader : public USDGeomReader {
 
   bool valid() const override;
 
+  ~USDMeshReader() override;
+
   void create_object(Main *bmain, double motionSampleTime) override;
+  void prepare_object_data(double motionSampleTime) override;
   void read_object_data(Main *bmain, double motionSampleTime) override;
 
+  void set_instance_source(USDMeshReader *instance_source);
+
   struct Mesh *read_mesh(struct Mesh *existing_mesh,
                          double motionSampleTime,
                          int read_flag,
@@ -91,6 +91,9 @@ class USDPrimReader {
   virtual bool valid() const;
 
   virtual void create_object(Main *bmain, double motionSampleTime) = 0;
+  /* Read the data of the prim that doesn't require access to Main. The import calls this for all
+   * readers in parallel, before calling read_object_data() on each of them. */
+  virtual void prepare_object_data(double /* motionSampleTime */){};
   virtual void read_object_data(Main * /* bmain */, double /* motionSampleTime */){};
 
   Object *object() const;
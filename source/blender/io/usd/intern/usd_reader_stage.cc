@@ -37,6 +37,7 @@
 #include <pxr/usd/usdLux/light.h>
 
 #include <iostream>
+#include <map>
 
 namespace blender::io::usd {
 
@@ -292,6 +293,36 @@ void USDStageReader::collect_readers(Main *bmain)
 
   stage_->SetInterpolationType(pxr::UsdInterpolationType::UsdInterpolationTypeHeld);
   collect_readers(bmain, root);
+
+  if (params_.import_instance_proxies) {
+    share_instance_meshes();
+  }
+}
+
+void USDStageReader::share_instance_meshes()
+{
+  /* Instance proxies of the same prototype have the same mesh, so only the first of them reads
+   * it and the others share its mesh data. */
+  std::map<pxr::SdfPath, USDMeshReader *> prototype_readers;
+
+  for (USDPrimReader *reader : readers_) {
+    USDMeshReader *mesh_reader = dynamic_cast<USDMeshReader *>(reader);
+    if (!mesh_reader) {
+      continue;
+    }
+
+    const pxr::UsdPrim &prim = mesh_reader->prim();
+    if (!prim.IsInstanceProxy()) {
+      continue;
+    }
+
+    const pxr::SdfPath prototype_path = prim.GetPrimInPrototype().GetPath();
+    std::pair<std::map<pxr::SdfPath, USDMeshReader *>::iterator, bool> result =
+        prototype_readers.insert(std::make_pair(prototype_path, mesh_reader));
+    if (!result.second) {
+      mesh_reader->set_instance_source(result.first->second);
+    }
+  }
 }
 
 void USDStageReader::clear_readers()
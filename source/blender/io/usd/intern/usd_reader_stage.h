@@ -82,6 +82,12 @@ class USDStageReader {
  private:
   USDPrimReader *collect_readers(Main *bmain, const pxr::UsdPrim &prim);
 
+  /**
+   * Let the mesh readers of instance proxies share the mesh of the
+   * first reader of the same prototype, so that it's only read once.
+   */
+  void share_instance_meshes();
+
   /**
    * Returns true if the given prim should be included in the
    * traversal based on the import options and the prim's visibility
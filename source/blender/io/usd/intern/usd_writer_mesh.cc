@@ -51,6 +51,11 @@ USDGenericMeshWriter::USDGenericMeshWriter(const USDExporterContext &ctx) : USDA
 {
 }
 
+USDGenericMeshWriter::~USDGenericMeshWriter()
+{
+  free_deferred_mesh();
+}
+
 bool USDGenericMeshWriter::is_supported(const HierarchyContext *context) const
 {
   if (usd_export_context_.export_params.visible_objects_only) {
@@ -59,31 +64,6 @@ bool USDGenericMeshWriter::is_supported(const HierarchyContext *context) const
   return true;
 }
 
-void USDGenericMeshWriter::do_write(HierarchyContext &context)
-{
-  Object *object_eval = context.object;
-  bool needsfree = false;
-  Mesh *mesh = get_export_mesh(object_eval, needsfree);
-
-  if (mesh == nullptr) {
-    return;
-  }
-
-  try {
-    write_mesh(context, mesh);
-
-    if (needsfree) {
-      free_export_mesh(mesh);
-    }
-  }
-  catch (...) {
-    if (needsfree) {
-      free_export_mesh(mesh);
-    }
-    throw;
-  }
-}
-
 void USDGenericMeshWriter::free_export_mesh(Mesh *mesh)
 {
   BKE_id_free(nullptr, mesh);
@@ -112,6 +92,68 @@ struct USDMeshData {
   pxr::VtFloatArray crease_sharpnesses;
 };
 
+struct USDGenericMeshWriter::DeferredMesh {
+  HierarchyContext context;
+  Mesh *mesh;
+  bool mesh_needs_free;
+  bool is_first_frame;
+  USDMeshData usd_mesh_data;
+};
+
+void USDGenericMeshWriter::do_write(HierarchyContext &context)
+{
+  Object *object_eval = context.object;
+  bool needsfree = false;
+  Mesh *mesh = get_export_mesh(object_eval, needsfree);
+
+  if (mesh == nullptr) {
+    return;
+  }
+
+  free_deferred_mesh();
+  deferred_mesh_ = std::make_unique<DeferredMesh>();
+  deferred_mesh_->context = context;
+  deferred_mesh_->mesh = mesh;
+  deferred_mesh_->mesh_needs_free = needsfree;
+  deferred_mesh_->is_first_frame = !frame_has_been_written_;
+}
+
+bool USDGenericMeshWriter::has_deferred_data() const
+{
+  return deferred_mesh_ != nullptr;
+}
+
+void USDGenericMeshWriter::prepare_deferred_data()
+{
+  get_geometry_data(deferred_mesh_->mesh, deferred_mesh_->usd_mesh_data);
+}
+
+void USDGenericMeshWriter::write_deferred_data()
+{
+  try {
+    write_mesh(deferred_mesh_->context,
+               deferred_mesh_->mesh,
+               deferred_mesh_->usd_mesh_data,
+               deferred_mesh_->is_first_frame);
+  }
+  catch (...) {
+    free_deferred_mesh();
+    throw;
+  }
+  free_deferred_mesh();
+}
+
+void USDGenericMeshWriter::free_deferred_mesh()
+{
+  if (deferred_mesh_ == nullptr) {
+    return;
+  }
+  if (deferred_mesh_->mesh_needs_free) {
+    free_export_mesh(deferred_mesh_->mesh);
+  }
+  deferred_mesh_.reset();
+}
+
 void USDGenericMeshWriter::write_uv_maps(const Mesh *mesh, pxr::UsdGeomMesh usd_mesh)
 {
   pxr::UsdTimeCode timecode = get_export_time_code();
@@ -145,7 +187,10 @@ void USDGenericMeshWriter::write_uv_maps(const Mesh *mesh, pxr::UsdGeomMesh usd_
   }
 }
 
-void USDGenericMeshWriter::write_mesh(HierarchyContext &context, Mesh *mesh)
+void USDGenericMeshWriter::write_mesh(HierarchyContext &context,
+                                      Mesh *mesh,
+                                      const USDMeshData &usd_mesh_data,
+                                      const bool is_first_frame)
 {
   pxr::UsdTimeCode timecode = get_export_time_code();
   pxr::UsdTimeCode defaultTime = pxr::UsdTimeCode::Default();
@@ -155,9 +200,6 @@ void USDGenericMeshWriter::write_mesh(HierarchyContext &context, Mesh *mesh)
   pxr::UsdGeomMesh usd_mesh = pxr::UsdGeomMesh::Define(stage, usd_path);
   write_visibility(context, timecode, usd_mesh);
 
-  USDMeshData usd_mesh_data;
-  get_geometry_data(mesh, usd_mesh_data);
-
   if (usd_export_context_.export_params.use_instancing && context.is_instance()) {
     if (!mark_as_instance(context, usd_mesh.GetPrim())) {
       return;
@@ -223,7 +265,7 @@ void USDGenericMeshWriter::write_mesh(HierarchyContext &context, Mesh *mesh)
   write_surface_velocity(mesh, usd_mesh);
 
   /* TODO(Sybren): figure out what happens when the face groups change. */
-  if (frame_has_been_written_) {
+  if (!is_first_frame) {
     return;
   }
 
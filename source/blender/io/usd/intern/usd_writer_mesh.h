@@ -20,6 +20,8 @@
 
 #include "usd_writer_abstract.h"
 
+#include <memory>
+
 #include <pxr/usd/usdGeom/mesh.h>
 
 namespace blender::io::usd {
@@ -30,6 +32,13 @@ struct USDMeshData;
 class USDGenericMeshWriter : public USDAbstractWriter {
  public:
   USDGenericMeshWriter(const USDExporterContext &ctx);
+  ~USDGenericMeshWriter() override;
+
+  /* do_write() only gathers the export mesh, which is converted to USD arrays in parallel with
+   * the other meshes and then written to the stage. */
+  virtual bool has_deferred_data() const override;
+  virtual void prepare_deferred_data() override;
+  virtual void write_deferred_data() override;
 
  protected:
   virtual bool is_supported(const HierarchyContext *context) const override;
@@ -42,7 +51,15 @@ class USDGenericMeshWriter : public USDAbstractWriter {
   /* Mapping from material slot number to array of face indices with that material. */
   typedef std::map<short, pxr::VtIntArray> MaterialFaceGroups;
 
-  void write_mesh(HierarchyContext &context, Mesh *mesh);
+  /* The mesh gathered by do_write() for the current frame. */
+  struct DeferredMesh;
+  std::unique_ptr<DeferredMesh> deferred_mesh_;
+
+  void free_deferred_mesh();
+  void write_mesh(HierarchyContext &context,
+                  Mesh *mesh,
+                  const USDMeshData &usd_mesh_data,
+                  bool is_first_frame);
   void get_geometry_data(const Mesh *mesh, struct USDMeshData &usd_mesh_data);
   void assign_materials(const HierarchyContext &context,
                         pxr::UsdGeomMesh usd_mesh,
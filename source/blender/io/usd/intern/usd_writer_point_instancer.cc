@@ -0,0 +1,128 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ * The Original Code is Copyright (C) 2021 Blender Foundation.
+ * All rights reserved.
+ */
+#include "usd_writer_point_instancer.h"
+#include "usd_hierarchy_iterator.h"
+
+#include <pxr/usd/usdGeom/pointInstancer.h>
+
+#include "BKE_geometry_set.hh"
+
+#include "BLI_math_matrix.h"
+
+#include "DNA_object_types.h"
+
+namespace blender::io::usd {
+
+USDPointInstancerWriter::USDPointInstancerWriter(const USDExporterContext &ctx)
+    : USDAbstractWriter(ctx)
+{
+}
+
+const InstancesComponent *USDPointInstancerWriter::get_instances(const Object *object)
+{
+  const GeometrySet *geometry_set = object->runtime.geometry_set_eval;
+  if (object->type != OB_MESH || geometry_set == nullptr) {
+    return nullptr;
+  }
+  /* These components are instanced as well on mesh objects, they would not be exported. */
+  if (geometry_set->has_curve() || geometry_set->has_pointcloud() || geometry_set->has_volume()) {
+    return nullptr;
+  }
+
+  const InstancesComponent *instances =
+      geometry_set->get_component_for_read<InstancesComponent>();
+  if (instances == nullptr || instances->instances_amount() == 0) {
+    return nullptr;
+  }
+  for (const InstanceReference &reference : instances->references()) {
+    if (reference.type() != InstanceReference::Type::Object) {
+      return nullptr;
+    }
+  }
+  return instances;
+}
+
+std::vector<Object *> USDPointInstancerWriter::get_prototypes(const Object *object)
+{
+  std::vector<Object *> prototypes;
+  const InstancesComponent *instances = get_instances(object);
+  if (instances == nullptr) {
+    return prototypes;
+  }
+
+  /* References are unique, so every object is a prototype only once and the reference handles
+   * of the instances can be used as prototype indices. */
+  for (const InstanceReference &reference : instances->references()) {
+    prototypes.push_back(&reference.object());
+  }
+  return prototypes;
+}
+
+void USDPointInstancerWriter::do_write(HierarchyContext &context)
+{
+  const InstancesComponent *instances = get_instances(context.object);
+  if (instances == nullptr) {
+    return;
+  }
+
+  pxr::UsdTimeCode timecode = get_export_time_code();
+  pxr::UsdGeomPointInstancer instancer = pxr::UsdGeomPointInstancer::Define(
+      usd_export_context_.stage, usd_export_context_.usd_path);
+
+  pxr::SdfPathVector prototype_paths;
+  for (const Object *prototype : get_prototypes(context.object)) {
+    const std::string name = usd_export_context_.hierarchy_iterator->get_id_name(&prototype->id);
+    prototype_paths.push_back(usd_export_context_.usd_path.AppendChild(pxr::TfToken(name)));
+  }
+  instancer.CreatePrototypesRel().SetTargets(prototype_paths);
+
+  const Span<int> handles = instances->instance_reference_handles();
+  const Span<float4x4> transforms = instances->instance_transforms();
+  const Span<int> ids = instances->almost_unique_ids();
+  const int instances_num = instances->instances_amount();
+
+  pxr::VtIntArray proto_indices(instances_num);
+  pxr::VtInt64Array usd_ids(instances_num);
+  pxr::VtVec3fArray positions(instances_num);
+  pxr::VtQuathArray orientations(instances_num);
+  pxr::VtVec3fArray scales(instances_num);
+
+  for (const int i : IndexRange(instances_num)) {
+    proto_indices[i] = handles[i];
+    usd_ids[i] = ids[i];
+
+    float loc[3], quat[4], size[3];
+    mat4_decompose(loc, quat, size, transforms[i].values);
+    positions[i] = pxr::GfVec3f(loc);
+    orientations[i] = pxr::GfQuath(quat[0], quat[1], quat[2], quat[3]);
+    scales[i] = pxr::GfVec3f(size);
+  }
+
+  usd_value_writer_.SetAttribute(
+      instancer.CreateProtoIndicesAttr(), pxr::VtValue(proto_indices), timecode);
+  usd_value_writer_.SetAttribute(instancer.CreateIdsAttr(), pxr::VtValue(usd_ids), timecode);
+  usd_value_writer_.SetAttribute(
+      instancer.CreatePositionsAttr(), pxr::VtValue(positions), timecode);
+  usd_value_writer_.SetAttribute(
+      instancer.CreateOrientationsAttr(), pxr::VtValue(orientations), timecode);
+  usd_value_writer_.SetAttribute(instancer.CreateScalesAttr(), pxr::VtValue(scales), timecode);
+}
+
+}  // namespace blender::io::usd
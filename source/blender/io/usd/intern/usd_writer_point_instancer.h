@@ -0,0 +1,47 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ * The Original Code is Copyright (C) 2021 Blender Foundation.
+ * All rights reserved.
+ */
+#pragma once
+
+#include "usd_writer_abstract.h"
+
+#include <vector>
+
+class InstancesComponent;
+
+namespace blender::io::usd {
+
+/* Writer for the geometry instances of an object as a USD point instancer. The instanced objects
+ * are written once as prototypes below the point instancer, see
+ * #AbstractHierarchyIterator::get_instancer_prototypes(). */
+class USDPointInstancerWriter : public USDAbstractWriter {
+ public:
+  USDPointInstancerWriter(const USDExporterContext &ctx);
+
+  /* Return the instances of the object when they can be written as a point instancer, which is
+   * when they only instance objects and the object has no other data that creates instances. */
+  static const InstancesComponent *get_instances(const Object *object);
+  /* The instanced objects, in the order of the prototype indices of the instances. */
+  static std::vector<Object *> get_prototypes(const Object *object);
+
+ protected:
+  virtual void do_write(HierarchyContext &context) override;
+};
+
+}  // namespace blender::io::usd
@@ -52,60 +52,66 @@ const char *DEFORM_GROUP_DISABLED = "off";
  * So an empty material name is written. */
 const char *MATERIAL_GROUP_DISABLED = "";
 
-void OBJWriter::write_vert_uv_normal_indices(Span<int> vert_indices,
+void OBJWriter::write_vert_uv_normal_indices(FormatHandler<eFileType::OBJ> &fh,
+                                             const IndexOffsets &offsets,
+                                             Span<int> vert_indices,
                                              Span<int> uv_indices,
                                              Span<int> normal_indices) const
 {
   BLI_assert(vert_indices.size() == uv_indices.size() &&
              vert_indices.size() == normal_indices.size());
-  file_handler_->write<eOBJSyntaxElement::poly_element_begin>();
+  fh.write<eOBJSyntaxElement::poly_element_begin>();
   for (int j = 0; j < vert_indices.size(); j++) {
-    file_handler_->write<eOBJSyntaxElement::vertex_uv_normal_indices>(
-        vert_indices[j] + index_offsets_.vertex_offset + 1,
-        uv_indices[j] + index_offsets_.uv_vertex_offset + 1,
-        normal_indices[j] + index_offsets_.normal_offset + 1);
+    fh.write<eOBJSyntaxElement::vertex_uv_normal_indices>(
+        vert_indices[j] + offsets.vertex_offset + 1,
+        uv_indices[j] + offsets.uv_vertex_offset + 1,
+        normal_indices[j] + offsets.normal_offset + 1);
   }
-  file_handler_->write<eOBJSyntaxElement::poly_element_end>();
+  fh.write<eOBJSyntaxElement::poly_element_end>();
 }
 
-void OBJWriter::write_vert_normal_indices(Span<int> vert_indices,
+void OBJWriter::write_vert_normal_indices(FormatHandler<eFileType::OBJ> &fh,
+                                          const IndexOffsets &offsets,
+                                          Span<int> vert_indices,
                                           Span<int> /*uv_indices*/,
                                           Span<int> normal_indices) const
 {
   BLI_assert(vert_indices.size() == normal_indices.size());
-  file_handler_->write<eOBJSyntaxElement::poly_element_begin>();
+  fh.write<eOBJSyntaxElement::poly_element_begin>();
   for (int j = 0; j < vert_indices.size(); j++) {
-    file_handler_->write<eOBJSyntaxElement::vertex_normal_indices>(
-        vert_indices[j] + index_offsets_.vertex_offset + 1,
-        normal_indices[j] + index_offsets_.normal_offset + 1);
+    fh.write<eOBJSyntaxElement::vertex_normal_indices>(
+        vert_indices[j] + offsets.vertex_offset + 1,
+        normal_indices[j] + offsets.normal_offset + 1);
   }
-  file_handler_->write<eOBJSyntaxElement::poly_element_end>();
+  fh.write<eOBJSyntaxElement::poly_element_end>();
 }
 
-void OBJWriter::write_vert_uv_indices(Span<int> vert_indices,
+void OBJWriter::write_vert_uv_indices(FormatHandler<eFileType::OBJ> &fh,
+                                      const IndexOffsets &offsets,
+                                      Span<int> vert_indices,
                                       Span<int> uv_indices,
                                       Span<int> /*normal_indices*/) const
 {
   BLI_assert(vert_indices.size() == uv_indices.size());
-  file_handler_->write<eOBJSyntaxElement::poly_element_begin>();
+  fh.write<eOBJSyntaxElement::poly_element_begin>();
   for (int j = 0; j < vert_indices.size(); j++) {
-    file_handler_->write<eOBJSyntaxElement::vertex_uv_indices>(
-        vert_indices[j] + index_offsets_.vertex_offset + 1,
-        uv_indices[j] + index_offsets_.uv_vertex_offset + 1);
+    fh.write<eOBJSyntaxElement::vertex_uv_indices>(vert_indices[j] + offsets.vertex_offset + 1,
+                                                   uv_indices[j] + offsets.uv_vertex_offset + 1);
   }
-  file_handler_->write<eOBJSyntaxElement::poly_element_end>();
+  fh.write<eOBJSyntaxElement::poly_element_end>();
 }
 
-void OBJWriter::write_vert_indices(Span<int> vert_indices,
+void OBJWriter::write_vert_indices(FormatHandler<eFileType::OBJ> &fh,
+                                   const IndexOffsets &offsets,
+                                   Span<int> vert_indices,
                                    Span<int> /*uv_indices*/,
                                    Span<int> /*normal_indices*/) const
 {
-  file_handler_->write<eOBJSyntaxElement::poly_element_begin>();
+  fh.write<eOBJSyntaxElement::poly_element_begin>();
   for (const int vert_index : vert_indices) {
-    file_handler_->write<eOBJSyntaxElement::vertex_indices>(vert_index +
-                                                            index_offsets_.vertex_offset + 1);
+    fh.write<eOBJSyntaxElement::vertex_indices>(vert_index + offsets.vertex_offset + 1);
   }
-  file_handler_->write<eOBJSyntaxElement::poly_element_end>();
+  fh.write<eOBJSyntaxElement::poly_element_end>();
 }
 
 void OBJWriter::write_header() const
@@ -125,7 +131,8 @@ void OBJWriter::write_mtllib_name(const StringRefNull mtl_filepath) const
   file_handler_->write<eOBJSyntaxElement::mtllib>(mtl_file_name);
 }
 
-void OBJWriter::write_object_group(const OBJMesh &obj_mesh_data) const
+void OBJWriter::write_object_group(FormatHandler<eFileType::OBJ> &fh,
+                                   const OBJMesh &obj_mesh_data) const
 {
   /* "o object_name" is not mandatory. A valid .OBJ file may contain neither
    * "o name" nor "g group_name". */
@@ -138,64 +145,63 @@ void OBJWriter::write_object_group(const OBJMesh &obj_mesh_data) const
   const char *object_material_name = obj_mesh_data.get_object_material_name(0);
   if (export_params_.export_materials && export_params_.export_material_groups &&
       object_material_name) {
-    file_handler_->write<eOBJSyntaxElement::object_group>(object_name + "_" + object_mesh_name +
-                                                          "_" + object_material_name);
+    fh.write<eOBJSyntaxElement::object_group>(object_name + "_" + object_mesh_name + "_" +
+                                              object_material_name);
     return;
   }
-  file_handler_->write<eOBJSyntaxElement::object_group>(object_name + "_" + object_mesh_name);
+  fh.write<eOBJSyntaxElement::object_group>(object_name + "_" + object_mesh_name);
 }
 
-void OBJWriter::write_object_name(const OBJMesh &obj_mesh_data) const
+void OBJWriter::write_object_name(FormatHandler<eFileType::OBJ> &fh,
+                                  const OBJMesh &obj_mesh_data) const
 {
   const char *object_name = obj_mesh_data.get_object_name();
   if (export_params_.export_object_groups) {
-    write_object_group(obj_mesh_data);
+    write_object_group(fh, obj_mesh_data);
     return;
   }
-  file_handler_->write<eOBJSyntaxElement::object_name>(object_name);
+  fh.write<eOBJSyntaxElement::object_name>(object_name);
 }
 
-void OBJWriter::write_vertex_coords(const OBJMesh &obj_mesh_data) const
+void OBJWriter::write_vertex_coords(FormatHandler<eFileType::OBJ> &fh,
+                                    const OBJMesh &obj_mesh_data) const
 {
   const int tot_vertices = obj_mesh_data.tot_vertices();
   for (int i = 0; i < tot_vertices; i++) {
     float3 vertex = obj_mesh_data.calc_vertex_coords(i, export_params_.scaling_factor);
-    file_handler_->write<eOBJSyntaxElement::vertex_coords>(vertex[0], vertex[1], vertex[2]);
+    fh.write<eOBJSyntaxElement::vertex_coords>(vertex[0], vertex[1], vertex[2]);
   }
 }
 
-void OBJWriter::write_uv_coords(OBJMesh &r_obj_mesh_data) const
+void OBJWriter::write_uv_coords(FormatHandler<eFileType::OBJ> &fh,
+                                const OBJMesh &obj_mesh_data) const
 {
-  Vector<std::array<float, 2>> uv_coords;
-  /* UV indices are calculated and stored in an OBJMesh member here. */
-  r_obj_mesh_data.store_uv_coords_and_indices(uv_coords);
-
-  for (const std::array<float, 2> &uv_vertex : uv_coords) {
-    file_handler_->write<eOBJSyntaxElement::uv_vertex_coords>(uv_vertex[0], uv_vertex[1]);
+  for (const std::array<float, 2> &uv_vertex : obj_mesh_data.get_uv_coords()) {
+    fh.write<eOBJSyntaxElement::uv_vertex_coords>(uv_vertex[0], uv_vertex[1]);
   }
 }
 
-void OBJWriter::write_poly_normals(const OBJMesh &obj_mesh_data) const
+void OBJWriter::write_poly_normals(FormatHandler<eFileType::OBJ> &fh,
+                                   const OBJMesh &obj_mesh_data) const
 {
-  obj_mesh_data.ensure_mesh_normals();
   Vector<float3> lnormals;
   const int tot_polygons = obj_mesh_data.tot_polygons();
   for (int i = 0; i < tot_polygons; i++) {
     if (obj_mesh_data.is_ith_poly_smooth(i)) {
       obj_mesh_data.calc_loop_normals(i, lnormals);
       for (const float3 &lnormal : lnormals) {
-        file_handler_->write<eOBJSyntaxElement::normal>(lnormal[0], lnormal[1], lnormal[2]);
+        fh.write<eOBJSyntaxElement::normal>(lnormal[0], lnormal[1], lnormal[2]);
       }
     }
     else {
       float3 poly_normal = obj_mesh_data.calc_poly_normal(i);
-      file_handler_->write<eOBJSyntaxElement::normal>(
-          poly_normal[0], poly_normal[1], poly_normal[2]);
+      fh.write<eOBJSyntaxElement::normal>(poly_normal[0], poly_normal[1], poly_normal[2]);
     }
   }
 }
 
-int OBJWriter::write_smooth_group(const OBJMesh &obj_mesh_data,
+int OBJWriter::write_smooth_group(FormatHandler<eFileType::OBJ> &fh,
+                                  const OBJMesh &obj_mesh_data,
                                   const int poly_index,
                                   const int last_poly_smooth_group) const
 {
@@ -213,11 +219,12 @@ int OBJWriter::write_smooth_group(const OBJMesh &obj_mesh_data,
     /* Group has already been written, even if it is "s 0". */
     return current_group;
   }
-  file_handler_->write<eOBJSyntaxElement::smooth_group>(current_group);
+  fh.write<eOBJSyntaxElement::smooth_group>(current_group);
   return current_group;
 }
 
-int16_t OBJWriter::write_poly_material(const OBJMesh &obj_mesh_data,
+int16_t OBJWriter::write_poly_material(FormatHandler<eFileType::OBJ> &fh,
+                                       const OBJMesh &obj_mesh_data,
                                        const int poly_index,
                                        const int16_t last_poly_mat_nr,
                                        std::function<const char *(int)> matname_fn) const
@@ -232,22 +239,23 @@ int16_t OBJWriter::write_poly_material(const OBJMesh &obj_mesh_data,
     return current_mat_nr;
   }
   if (current_mat_nr == NOT_FOUND) {
-    file_handler_->write<eOBJSyntaxElement::poly_usemtl>(MATERIAL_GROUP_DISABLED);
+    fh.write<eOBJSyntaxElement::poly_usemtl>(MATERIAL_GROUP_DISABLED);
     return current_mat_nr;
   }
   if (export_params_.export_object_groups) {
-    write_object_group(obj_mesh_data);
+    write_object_group(fh, obj_mesh_data);
   }
   const char *mat_name = matname_fn(current_mat_nr);
   if (!mat_name) {
     mat_name = MATERIAL_GROUP_DISABLED;
   }
-  file_handler_->write<eOBJSyntaxElement::poly_usemtl>(mat_name);
+  fh.write<eOBJSyntaxElement::poly_usemtl>(mat_name);
 
   return current_mat_nr;
 }
 
-int16_t OBJWriter::write_vertex_group(const OBJMesh &obj_mesh_data,
+int16_t OBJWriter::write_vertex_group(FormatHandler<eFileType::OBJ> &fh,
+                                      const OBJMesh &obj_mesh_data,
                                       const int poly_index,
                                       const int16_t last_poly_vertex_group) const
 {
@@ -261,10 +269,10 @@ int16_t OBJWriter::write_vertex_group(const OBJMesh &obj_mesh_data,
     return current_group;
   }
   if (current_group == NOT_FOUND) {
-    file_handler_->write<eOBJSyntaxElement::object_group>(DEFORM_GROUP_DISABLED);
+    fh.write<eOBJSyntaxElement::object_group>(DEFORM_GROUP_DISABLED);
     return current_group;
   }
-  file_handler_->write<eOBJSyntaxElement::object_group>(
+  fh.write<eOBJSyntaxElement::object_group>(
       obj_mesh_data.get_poly_deform_group_name(current_group));
   return current_group;
 }
@@ -288,8 +296,10 @@ OBJWriter::func_vert_uv_normal_indices OBJWriter::get_poly_element_writer(
   return &OBJWriter::write_vert_indices;
 }
 
-void OBJWriter::write_poly_elements(const OBJMesh &obj_mesh_data,
-                                    std::function<const char *(int)> matname_fn)
+void OBJWriter::write_poly_elements(FormatHandler<eFileType::OBJ> &fh,
+                                    const IndexOffsets &offsets,
+                                    const OBJMesh &obj_mesh_data,
+                                    std::function<const char *(int)> matname_fn) const
 {
   int last_poly_smooth_group = NEGATIVE_INIT;
   int16_t last_poly_vertex_group = NEGATIVE_INIT;
@@ -313,18 +323,20 @@ void OBJWriter::write_poly_elements(const OBJMesh &obj_mesh_data,
         i, per_object_tot_normals);
     per_object_tot_normals += new_normals;
 
-    last_poly_smooth_group = write_smooth_group(obj_mesh_data, i, last_poly_smooth_group);
-    last_poly_vertex_group = write_vertex_group(obj_mesh_data, i, last_poly_vertex_group);
-    last_poly_mat_nr = write_poly_material(obj_mesh_data, i, last_poly_mat_nr, matname_fn);
-    (this->*poly_element_writer)(poly_vertex_indices, poly_uv_indices, poly_normal_indices);
+    last_poly_smooth_group = write_smooth_group(fh, obj_mesh_data, i, last_poly_smooth_group);
+    last_poly_vertex_group = write_vertex_group(fh, obj_mesh_data, i, last_poly_vertex_group);
+    last_poly_mat_nr = write_poly_material(fh, obj_mesh_data, i, last_poly_mat_nr, matname_fn);
+    (this->*poly_element_writer)(
+        fh, offsets, poly_vertex_indices, poly_uv_indices, poly_normal_indices);
   }
-  /* Unusual: Other indices are updated in #OBJWriter::update_index_offsets. */
-  index_offsets_.normal_offset += per_object_tot_normals;
+  BLI_assert(!export_params_.export_normals ||
+             per_object_tot_normals == obj_mesh_data.tot_normals());
 }
 
-void OBJWriter::write_edges_indices(const OBJMesh &obj_mesh_data) const
+void OBJWriter::write_edges_indices(FormatHandler<eFileType::OBJ> &fh,
+                                    const IndexOffsets &offsets,
+                                    const OBJMesh &obj_mesh_data) const
 {
-  obj_mesh_data.ensure_mesh_edges();
   const int tot_edges = obj_mesh_data.tot_edges();
   for (int edge_index = 0; edge_index < tot_edges; edge_index++) {
     const std::optional<std::array<int, 2>> vertex_indices =
@@ -332,13 +344,13 @@ void OBJWriter::write_edges_indices(const OBJMesh &obj_mesh_data) const
     if (!vertex_indices) {
       continue;
     }
-    file_handler_->write<eOBJSyntaxElement::edge>(
-        (*vertex_indices)[0] + index_offsets_.vertex_offset + 1,
-        (*vertex_indices)[1] + index_offsets_.vertex_offset + 1);
+    fh.write<eOBJSyntaxElement::edge>((*vertex_indices)[0] + offsets.vertex_offset + 1,
+                                      (*vertex_indices)[1] + offsets.vertex_offset + 1);
   }
 }
 
-void OBJWriter::write_nurbs_curve(const OBJCurve &obj_nurbs_data) const
+void OBJWriter::write_nurbs_curve(FormatHandler<eFileType::OBJ> &fh,
+                                  const OBJCurve &obj_nurbs_data) const
 {
   const int total_splines = obj_nurbs_data.total_splines();
   for (int spline_idx = 0; spline_idx < total_splines; spline_idx++) {
@@ -346,15 +358,15 @@ void OBJWriter::write_nurbs_curve(const OBJCurve &obj_nurbs_data) const
     for (int vertex_idx = 0; vertex_idx < total_vertices; vertex_idx++) {
       const float3 vertex_coords = obj_nurbs_data.vertex_coordinates(
           spline_idx, vertex_idx, export_params_.scaling_factor);
-      file_handler_->write<eOBJSyntaxElement::vertex_coords>(
+      fh.write<eOBJSyntaxElement::vertex_coords>(
           vertex_coords[0], vertex_coords[1], vertex_coords[2]);
     }
 
     const char *nurbs_name = obj_nurbs_data.get_curve_name();
     const int nurbs_degree = obj_nurbs_data.get_nurbs_degree(spline_idx);
-    file_handler_->write<eOBJSyntaxElement::object_group>(nurbs_name);
-    file_handler_->write<eOBJSyntaxElement::cstype>();
-    file_handler_->write<eOBJSyntaxElement::nurbs_degree>(nurbs_degree);
+    fh.write<eOBJSyntaxElement::object_group>(nurbs_name);
+    fh.write<eOBJSyntaxElement::cstype>();
+    fh.write<eOBJSyntaxElement::nurbs_degree>(nurbs_degree);
     /**
      * The numbers written here are indices into the vertex coordinates written
      * earlier, relative to the line that is going to be written.
@@ -363,34 +375,31 @@ void OBJWriter::write_nurbs_curve(const OBJCurve &obj_nurbs_data) const
      * 0.0 1.0 -1 -2 -3 -4 -1 -2 -3 for a cyclic curve with 4 vertices.
      */
     const int total_control_points = obj_nurbs_data.total_spline_control_points(spline_idx);
-    file_handler_->write<eOBJSyntaxElement::curve_element_begin>();
+    fh.write<eOBJSyntaxElement::curve_element_begin>();
     for (int i = 0; i < total_control_points; i++) {
       /* "+1" to keep indices one-based, even if they're negative: i.e., -1 refers to the
        * last vertex coordinate, -2 second last. */
-      file_handler_->write<eOBJSyntaxElement::vertex_indices>(-((i % total_vertices) + 1));
+      fh.write<eOBJSyntaxElement::vertex_indices>(-((i % total_vertices) + 1));
     }
-    file_handler_->write<eOBJSyntaxElement::curve_element_end>();
+    fh.write<eOBJSyntaxElement::curve_element_end>();
 
     /**
      * In `parm u 0 0.1 ..` line:, (total control points + 2) equidistant numbers in the
      * parameter range are inserted.
      */
-    file_handler_->write<eOBJSyntaxElement::nurbs_parameter_begin>();
+    fh.write<eOBJSyntaxElement::nurbs_parameter_begin>();
     for (int i = 1; i <= total_control_points + 2; i++) {
-      file_handler_->write<eOBJSyntaxElement::nurbs_parameters>(1.0f * i /
-                                                                (total_control_points + 2 + 1));
+      fh.write<eOBJSyntaxElement::nurbs_parameters>(1.0f * i / (total_control_points + 2 + 1));
     }
-    file_handler_->write<eOBJSyntaxElement::nurbs_parameter_end>();
+    fh.write<eOBJSyntaxElement::nurbs_parameter_end>();
 
-    file_handler_->write<eOBJSyntaxElement::nurbs_group_end>();
+    fh.write<eOBJSyntaxElement::nurbs_group_end>();
   }
 }
 
-void OBJWriter::update_index_offsets(const OBJMesh &obj_mesh_data)
+void OBJWriter::write_buffer(FormatHandler<eFileType::OBJ> &fh) const
 {
-  index_offsets_.vertex_offset += obj_mesh_data.tot_vertices();
-  index_offsets_.uv_vertex_offset += obj_mesh_data.tot_uv_vertices();
-  /* Normal index is updated right after writing the normals. */
+  file_handler_->write_buffer(fh);
 }
 
 /* -------------------------------------------------------------------- */
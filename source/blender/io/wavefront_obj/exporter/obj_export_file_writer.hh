@@ -45,12 +45,15 @@ struct IndexOffsets {
 
 /**
  * Responsible for writing a .OBJ file.
+ *
+ * The header and the material library name are written to the file directly. Everything else is
+ * formatted into a #FormatHandler, so that objects can be formatted in parallel and written to
+ * the file in order with #write_buffer.
  */
 class OBJWriter : NonMovable, NonCopyable {
  private:
   const OBJExportParams &export_params_;
   std::unique_ptr<FileHandler<eFileType::OBJ>> file_handler_ = nullptr;
-  IndexOffsets index_offsets_{0, 0, 0};
 
  public:
   OBJWriter(const char *filepath, const OBJExportParams &export_params) noexcept(false)
@@ -64,11 +67,11 @@ class OBJWriter : NonMovable, NonCopyable {
   /**
    * Write object's name or group.
    */
-  void write_object_name(const OBJMesh &obj_mesh_data) const;
+  void write_object_name(FormatHandler<eFileType::OBJ> &fh, const OBJMesh &obj_mesh_data) const;
   /**
    * Write an object's group with mesh and/or material name appended conditionally.
    */
-  void write_object_group(const OBJMesh &obj_mesh_data) const;
+  void write_object_group(FormatHandler<eFileType::OBJ> &fh, const OBJMesh &obj_mesh_data) const;
   /**
    * Write file name of Material Library in .OBJ file.
    */
@@ -76,20 +79,23 @@ class OBJWriter : NonMovable, NonCopyable {
   /**
    * Write vertex coordinates for all vertices as "v x y z".
    */
-  void write_vertex_coords(const OBJMesh &obj_mesh_data) const;
+  void write_vertex_coords(FormatHandler<eFileType::OBJ> &fh, const OBJMesh &obj_mesh_data) const;
   /**
    * Write UV vertex coordinates for all vertices as `vt u v`.
-   * \note UV indices are stored here, but written later.
+   * \note UV coordinates and indices are calculated before, with
+   * #OBJMesh::store_uv_coords_and_indices.
    */
-  void write_uv_coords(OBJMesh &obj_mesh_data) const;
+  void write_uv_coords(FormatHandler<eFileType::OBJ> &fh, const OBJMesh &obj_mesh_data) const;
   /**
    * Write loop normals for smooth-shaded polygons, and polygon normals otherwise, as "vn x y z".
+   * \note Normals are calculated before, with #OBJMesh::ensure_mesh_normals.
    */
-  void write_poly_normals(const OBJMesh &obj_mesh_data) const;
+  void write_poly_normals(FormatHandler<eFileType::OBJ> &fh, const OBJMesh &obj_mesh_data) const;
   /**
    * Write smooth group if polygon at the given index is shaded smooth else "s 0"
    */
-  int write_smooth_group(const OBJMesh &obj_mesh_data,
+  int write_smooth_group(FormatHandler<eFileType::OBJ> &fh,
+                         const OBJMesh &obj_mesh_data,
                          int poly_index,
                          int last_poly_smooth_group) const;
   /**
@@ -97,14 +103,16 @@ class OBJWriter : NonMovable, NonCopyable {
    * \return #mat_nr of the polygon at the given index.
    * \note It doesn't write to the material library.
    */
-  int16_t write_poly_material(const OBJMesh &obj_mesh_data,
+  int16_t write_poly_material(FormatHandler<eFileType::OBJ> &fh,
+                              const OBJMesh &obj_mesh_data,
                               int poly_index,
                               int16_t last_poly_mat_nr,
                               std::function<const char *(int)> matname_fn) const;
   /**
    * Write the name of the deform group of a polygon.
    */
-  int16_t write_vertex_group(const OBJMesh &obj_mesh_data,
+  int16_t write_vertex_group(FormatHandler<eFileType::OBJ> &fh,
+                             const OBJMesh &obj_mesh_data,
                              int poly_index,
                              int16_t last_poly_vertex_group) const;
   /**
@@ -112,27 +120,34 @@ class OBJWriter : NonMovable, NonCopyable {
    * indices and polygon normal indices. Also write groups: smooth, vertex, material.
    * The matname_fn turns a 0-indexed material slot number in an Object into the
    * name used in the .obj file.
+   * \param offsets: Totals of the objects written before this one.
    * \note UV indices were stored while writing UV vertices.
    */
-  void write_poly_elements(const OBJMesh &obj_mesh_data,
-                           std::function<const char *(int)> matname_fn);
+  void write_poly_elements(FormatHandler<eFileType::OBJ> &fh,
+                           const IndexOffsets &offsets,
+                           const OBJMesh &obj_mesh_data,
+                           std::function<const char *(int)> matname_fn) const;
   /**
    * Write loose edges of a mesh as "l v1 v2".
+   * \note Loose edges are calculated before, with #OBJMesh::ensure_mesh_edges.
    */
-  void write_edges_indices(const OBJMesh &obj_mesh_data) const;
+  void write_edges_indices(FormatHandler<eFileType::OBJ> &fh,
+                           const IndexOffsets &offsets,
+                           const OBJMesh &obj_mesh_data) const;
   /**
    * Write a NURBS curve to the .OBJ file in parameter form.
    */
-  void write_nurbs_curve(const OBJCurve &obj_nurbs_data) const;
+  void write_nurbs_curve(FormatHandler<eFileType::OBJ> &fh, const OBJCurve &obj_nurbs_data) const;
 
   /**
-   * When there are multiple objects in a frame, the indices of previous objects' coordinates or
-   * normals add up.
+   * Write text formatted by the other functions to the file, and clear it.
    */
-  void update_index_offsets(const OBJMesh &obj_mesh_data);
+  void write_buffer(FormatHandler<eFileType::OBJ> &fh) const;
 
  private:
-  using func_vert_uv_normal_indices = void (OBJWriter::*)(Span<int> vert_indices,
+  using func_vert_uv_normal_indices = void (OBJWriter::*)(FormatHandler<eFileType::OBJ> &fh,
+                                                          const IndexOffsets &offsets,
+                                                          Span<int> vert_indices,
                                                           Span<int> uv_indices,
                                                           Span<int> normal_indices) const;
   /**
@@ -143,25 +158,33 @@ class OBJWriter : NonMovable, NonCopyable {
   /**
    * Write one line of polygon indices as "f v1/vt1/vn1 v2/vt2/vn2 ...".
    */
-  void write_vert_uv_normal_indices(Span<int> vert_indices,
+  void write_vert_uv_normal_indices(FormatHandler<eFileType::OBJ> &fh,
+                                    const IndexOffsets &offsets,
+                                    Span<int> vert_indices,
                                     Span<int> uv_indices,
                                     Span<int> normal_indices) const;
   /**
    * Write one line of polygon indices as "f v1//vn1 v2//vn2 ...".
    */
-  void write_vert_normal_indices(Span<int> vert_indices,
+  void write_vert_normal_indices(FormatHandler<eFileType::OBJ> &fh,
+                                 const IndexOffsets &offsets,
+                                 Span<int> vert_indices,
                                  Span<int> /*uv_indices*/,
                                  Span<int> normal_indices) const;
   /**
    * Write one line of polygon indices as "f v1/vt1 v2/vt2 ...".
    */
-  void write_vert_uv_indices(Span<int> vert_indices,
+  void write_vert_uv_indices(FormatHandler<eFileType::OBJ> &fh,
+                             const IndexOffsets &offsets,
+                             Span<int> vert_indices,
                              Span<int> uv_indices,
                              Span<int> /*normal_indices*/) const;
   /**
    * Write one line of polygon indices as "f v1 v2 ...".
    */
-  void write_vert_indices(Span<int> vert_indices,
+  void write_vert_indices(FormatHandler<eFileType::OBJ> &fh,
+                          const IndexOffsets &offsets,
+                          Span<int> vert_indices,
                           Span<int> /*uv_indices*/,
                           Span<int> /*normal_indices*/) const;
 };
@@ -20,13 +20,20 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cmath>
 #include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
 #include <string>
 #include <system_error>
 #include <type_traits>
+#include <vector>
 
 #include "BLI_compiler_attrs.h"
 #include "BLI_string_ref.hh"
+#include "BLI_utildefines.h"
 #include "BLI_utility_mixins.hh"
 
 namespace blender::io::obj {
@@ -261,10 +268,247 @@ syntax_elem_to_formatting(const eMTLSyntaxElement key)
   }
 }
 
+/* Remove this after upgrading to C++20. */
+template<typename T> using remove_cvref_t = std::remove_cv_t<std::remove_reference_t<T>>;
+
+/**
+ * Make #std::string etc., usable for the formatting functions.
+ * \return: `const char *` or the original argument if the argument is
+ * not related to #std::string.
+ */
+template<typename T> constexpr auto string_to_primitive(T &&arg)
+{
+  if constexpr (std::is_same_v<remove_cvref_t<T>, std::string> ||
+                std::is_same_v<remove_cvref_t<T>, blender::StringRefNull>) {
+    return arg.c_str();
+  }
+  else if constexpr (std::is_same_v<remove_cvref_t<T>, blender::StringRef>) {
+    BLI_STATIC_ASSERT(
+        (always_false<T>::value),
+        "Null-terminated string not present. Please use blender::StringRefNull instead.");
+    /* Another trick to cause a compile-time error: returning nothing to #std::printf. */
+    return;
+  }
+  else {
+    return std::forward<T>(arg);
+  }
+}
+
+/**
+ * Maximum number of characters written for one number. Enough for `%f` of any value which takes
+ * the fast path in #format_float, slower paths write to a temporary buffer first.
+ */
+const int FORMAT_NUMBER_MAX_LEN = 64;
+
+/**
+ * Write `value` in decimal form.
+ * \return End of the written characters.
+ */
+inline char *format_int(char *r_str, const int64_t value)
+{
+  uint64_t abs_value = value < 0 ? -uint64_t(value) : uint64_t(value);
+  if (value < 0) {
+    *r_str++ = '-';
+  }
+  char digits[20];
+  int len = 0;
+  do {
+    digits[len++] = char('0' + abs_value % 10);
+    abs_value /= 10;
+  } while (abs_value);
+  while (len) {
+    *r_str++ = digits[--len];
+  }
+  return r_str;
+}
+
+/**
+ * Write `value` like `printf("%.*f", precision, value)` does.
+ *
+ * A single precision float has at most 24 significant bits, and multiplying it by a power of ten
+ * up to 10^9 adds at most 21 more (the power of two part only changes the exponent). So the
+ * scaled value is exact in double precision, and rounding it to an integer is the same correctly
+ * rounded result `printf` produces. Numbers which do not fit in the 64 bit integer, NaN and
+ * infinity use `snprintf`.
+ *
+ * \return End of the written characters.
+ */
+inline char *format_float(char *r_str, const float value, const int precision)
+{
+  static const uint64_t powers_of_ten[] = {
+      1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
+  if (precision < 0 || precision > 9 || !(std::fabs(value) < 1e9f)) {
+    return r_str + std::snprintf(r_str, FORMAT_NUMBER_MAX_LEN, "%.*f", precision, value);
+  }
+
+  const uint64_t scale = powers_of_ten[precision];
+  /* Rounds half to even, like `printf` does for values exactly in the middle. */
+  const uint64_t scaled = uint64_t(std::nearbyint(std::fabs(double(value)) * double(scale)));
+  if (std::signbit(value)) {
+    /* Also for negative zero and small negative numbers which round to zero. */
+    *r_str++ = '-';
+  }
+  r_str = format_int(r_str, int64_t(scaled / scale));
+  if (precision > 0) {
+    *r_str++ = '.';
+    uint64_t fraction = scaled % scale;
+    for (int i = precision - 1; i >= 0; i--) {
+      r_str[i] = char('0' + fraction % 10);
+      fraction /= 10;
+    }
+    r_str += precision;
+  }
+  return r_str;
+}
+
+/**
+ * Text of a file, formatted into memory.
+ *
+ * Formatting does not use `printf`, the format string of a syntax element is interpreted by
+ * #write with fast integer and float conversions. The text is stored in blocks of about
+ * `block_size` bytes, so a growing buffer never has to be copied. Different objects can be
+ * formatted into separate handlers on different threads, and written to the file in order
+ * afterwards.
+ */
+template<eFileType filetype, size_t block_size = 64 * 1024>
+class FormatHandler : NonCopyable, NonMovable {
+ private:
+  std::vector<std::vector<char>> blocks_;
+  size_t size_ = 0;
+
+ public:
+  template<typename FileTypeTraits<filetype>::SyntaxType key, typename... T>
+  constexpr void write(T &&...args)
+  {
+    constexpr Formatting<filetype> fmt_nargs_valid = syntax_elem_to_formatting<filetype, T...>(
+        key);
+    /* Types of all arguments and the number of arguments should match
+     * what the formatting specifies. */
+    static_assert(fmt_nargs_valid.is_type_valid && (sizeof...(T) == fmt_nargs_valid.total_args),
+                  "Arguments do not match the formatting of the syntax element");
+    write_format(fmt_nargs_valid.fmt, string_to_primitive(std::forward<T>(args))...);
+  }
+
+  /** Total size of the formatted text in bytes. */
+  size_t size() const
+  {
+    return size_;
+  }
+
+  void clear()
+  {
+    blocks_.clear();
+    size_ = 0;
+  }
+
+  /**
+   * Write the formatted text to `outfile` and clear the buffer.
+   * \return False when writing failed.
+   */
+  bool write_to_file(FILE *outfile)
+  {
+    bool ok = true;
+    for (const std::vector<char> &block : blocks_) {
+      if (!block.empty() && std::fwrite(block.data(), 1, block.size(), outfile) != block.size()) {
+        ok = false;
+      }
+    }
+    clear();
+    return ok;
+  }
+
+ private:
+  /** Space for `len` more characters in the last block. */
+  char *ensure_space(const size_t len)
+  {
+    if (blocks_.empty() || blocks_.back().size() + len > blocks_.back().capacity()) {
+      blocks_.emplace_back();
+      blocks_.back().reserve(std::max(block_size, len));
+    }
+    std::vector<char> &block = blocks_.back();
+    const size_t old_size = block.size();
+    block.resize(old_size + len);
+    size_ += len;
+    return block.data() + old_size;
+  }
+
+  /** Give back space requested by #ensure_space which was not used. */
+  void shrink_to(const char *end)
+  {
+    std::vector<char> &block = blocks_.back();
+    const size_t new_size = end - block.data();
+    size_ -= block.size() - new_size;
+    block.resize(new_size);
+  }
+
+  void append(const char *str, const size_t len)
+  {
+    memcpy(ensure_space(len), str, len);
+  }
+
+  /** Write literal text of the format up to the next conversion, and return its position. */
+  const char *write_literal(const char *fmt)
+  {
+    const char *conversion = std::strchr(fmt, '%');
+    const char *end = conversion ? conversion : fmt + std::strlen(fmt);
+    append(fmt, end - fmt);
+    return conversion;
+  }
+
+  void write_format(const char *fmt)
+  {
+    const char *conversion = write_literal(fmt);
+    BLI_assert(conversion == nullptr);
+    UNUSED_VARS_NDEBUG(conversion);
+  }
+
+  template<typename Arg, typename... Rest>
+  void write_format(const char *fmt, Arg arg, Rest... rest)
+  {
+    const char *conversion = write_literal(fmt);
+    BLI_assert(conversion != nullptr);
+    conversion++;
+
+    /* Only the conversions used by #syntax_elem_to_formatting are supported. */
+    int precision = 6;
+    if (*conversion == '.') {
+      precision = int(std::strtol(conversion + 1, const_cast<char **>(&conversion), 10));
+    }
+    const char type = *conversion++;
+
+    if constexpr (std::is_floating_point_v<Arg>) {
+      BLI_assert(type == 'f');
+      if (float(arg) == arg || !std::isfinite(arg)) {
+        shrink_to(format_float(ensure_space(FORMAT_NUMBER_MAX_LEN), float(arg), precision));
+      }
+      else {
+        char tmp[512];
+        append(tmp, std::snprintf(tmp, sizeof(tmp), "%.*f", precision, double(arg)));
+      }
+    }
+    else if constexpr (std::is_integral_v<Arg>) {
+      BLI_assert(type == 'd');
+      shrink_to(format_int(ensure_space(FORMAT_NUMBER_MAX_LEN), int64_t(arg)));
+    }
+    else {
+      BLI_assert(type == 's');
+      append(arg, std::strlen(arg));
+    }
+    UNUSED_VARS_NDEBUG(type);
+
+    write_format(conversion, rest...);
+  }
+};
+
 template<eFileType filetype> class FileHandler : NonCopyable, NonMovable {
  private:
   FILE *outfile_ = nullptr;
   std::string outfile_path_;
+  /** Text which is not written to the file yet. */
+  FormatHandler<filetype> buffer_;
+
+  /** Write the buffer to the file once it is larger than this. */
+  static const size_t flush_size = 1024 * 1024;
 
  public:
   FileHandler(std::string outfile_path) noexcept(false) : outfile_path_(std::move(outfile_path))
@@ -277,6 +521,7 @@ template<eFileType filetype> class FileHandler : NonCopyable, NonMovable {
 
   ~FileHandler()
   {
+    flush();
     if (outfile_ && std::fclose(outfile_)) {
       std::cerr << "Error: could not close the file '" << outfile_path_
                 << "'  properly, it may be corrupted." << std::endl;
@@ -284,56 +529,31 @@ template<eFileType filetype> class FileHandler : NonCopyable, NonMovable {
   }
 
   template<typename FileTypeTraits<filetype>::SyntaxType key, typename... T>
-  constexpr void write(T &&...args) const
+  constexpr void write(T &&...args)
   {
-    constexpr Formatting<filetype> fmt_nargs_valid = syntax_elem_to_formatting<filetype, T...>(
-        key);
-    write__impl<fmt_nargs_valid.total_args>(fmt_nargs_valid.fmt, std::forward<T>(args)...);
-    /* Types of all arguments and the number of arguments should match
-     * what the formatting specifies. */
-    return std::enable_if_t < fmt_nargs_valid.is_type_valid &&
-               (sizeof...(T) == fmt_nargs_valid.total_args),
-           void > ();
+    buffer_.template write<key>(std::forward<T>(args)...);
+    if (buffer_.size() > flush_size) {
+      flush();
+    }
   }
 
- private:
-  /* Remove this after upgrading to C++20. */
-  template<typename T> using remove_cvref_t = std::remove_cv_t<std::remove_reference_t<T>>;
-
   /**
-   * Make #std::string etc., usable for `fprintf` family.
-   * \return: `const char *` or the original argument if the argument is
-   * not related to #std::string.
+   * Write text which was formatted separately, after all text written to this handler so far.
+   * The given handler is cleared.
    */
-  template<typename T> constexpr auto string_to_primitive(T &&arg) const
+  void write_buffer(FormatHandler<filetype> &fh)
   {
-    if constexpr (std::is_same_v<remove_cvref_t<T>, std::string> ||
-                  std::is_same_v<remove_cvref_t<T>, blender::StringRefNull>) {
-      return arg.c_str();
-    }
-    else if constexpr (std::is_same_v<remove_cvref_t<T>, blender::StringRef>) {
-      BLI_STATIC_ASSERT(
-          (always_false<T>::value),
-          "Null-terminated string not present. Please use blender::StringRefNull instead.");
-      /* Another trick to cause a compile-time error: returning nothing to #std::printf. */
-      return;
-    }
-    else {
-      return std::forward<T>(arg);
+    flush();
+    if (!fh.write_to_file(outfile_)) {
+      std::cerr << "Error: could not write to the file '" << outfile_path_ << "'." << std::endl;
     }
   }
 
-  template<int total_args, typename... T>
-  constexpr std::enable_if_t<(total_args != 0), void> write__impl(const char *fmt,
-                                                                  T &&...args) const
+  void flush()
   {
-    std::fprintf(outfile_, fmt, string_to_primitive(std::forward<T>(args))...);
-  }
-  template<int total_args, typename... T>
-  constexpr std::enable_if_t<(total_args == 0), void> write__impl(const char *fmt,
-                                                                  T &&...args) const
-  {
-    std::fputs(fmt, outfile_);
+    if (outfile_ && !buffer_.write_to_file(outfile_)) {
+      std::cerr << "Error: could not write to the file '" << outfile_path_ << "'." << std::endl;
+    }
   }
 };
 
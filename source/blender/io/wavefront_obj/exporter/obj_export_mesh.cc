@@ -141,6 +141,16 @@ int OBJMesh::tot_edges() const
   return export_mesh_eval_->totedge;
 }
 
+int OBJMesh::tot_normals() const
+{
+  int r_tot_normals = 0;
+  const int tot_polygons = export_mesh_eval_->totpoly;
+  for (int i = 0; i < tot_polygons; i++) {
+    r_tot_normals += is_ith_poly_smooth(i) ? export_mesh_eval_->mpoly[i].totloop : 1;
+  }
+  return r_tot_normals;
+}
+
 int16_t OBJMesh::tot_materials() const
 {
   return export_mesh_eval_->totcol;
@@ -242,7 +252,7 @@ Vector<int> OBJMesh::calc_poly_vertex_indices(const int poly_index) const
   return r_poly_vertex_indices;
 }
 
-void OBJMesh::store_uv_coords_and_indices(Vector<std::array<float, 2>> &r_uv_coords)
+void OBJMesh::store_uv_coords_and_indices()
 {
   const MPoly *mpoly = export_mesh_eval_->mpoly;
   const MLoop *mloop = export_mesh_eval_->mloop;
@@ -262,7 +272,7 @@ void OBJMesh::store_uv_coords_and_indices(Vector<std::array<float, 2>> &r_uv_coo
   uv_indices_.resize(totpoly);
   /* At least total vertices of a mesh will be present in its texture map. So
    * reserve minimum space early. */
-  r_uv_coords.reserve(totvert);
+  uv_coords_.reserve(totvert);
 
   tot_uv_vertices_ = 0;
   for (int vertex_index = 0; vertex_index < totvert; vertex_index++) {
@@ -274,11 +284,11 @@ void OBJMesh::store_uv_coords_and_indices(Vector<std::array<float, 2>> &r_uv_coo
       const int vertices_in_poly = mpoly[uv_vert->poly_index].totloop;
 
       /* Store UV vertex coordinates. */
-      r_uv_coords.resize(tot_uv_vertices_);
+      uv_coords_.resize(tot_uv_vertices_);
       const int loopstart = mpoly[uv_vert->poly_index].loopstart;
       Span<float> vert_uv_coords(mloopuv[loopstart + uv_vert->loop_of_poly_index].uv, 2);
-      r_uv_coords[tot_uv_vertices_ - 1][0] = vert_uv_coords[0];
-      r_uv_coords[tot_uv_vertices_ - 1][1] = vert_uv_coords[1];
+      uv_coords_[tot_uv_vertices_ - 1][0] = vert_uv_coords[0];
+      uv_coords_[tot_uv_vertices_ - 1][1] = vert_uv_coords[1];
 
       /* Store UV vertex indices. */
       uv_indices_[uv_vert->poly_index].resize(vertices_in_poly);
@@ -289,6 +299,11 @@ void OBJMesh::store_uv_coords_and_indices(Vector<std::array<float, 2>> &r_uv_coo
   BKE_mesh_uv_vert_map_free(uv_vert_map);
 }
 
+Span<std::array<float, 2>> OBJMesh::get_uv_coords() const
+{
+  return uv_coords_;
+}
+
 Span<int> OBJMesh::calc_poly_uv_indices(const int poly_index) const
 {
   if (uv_indices_.size() <= 0) {
@@ -73,6 +73,10 @@ class OBJMesh : NonCopyable {
    * Total UV vertices in a mesh's texture map.
    */
   int tot_uv_vertices_ = 0;
+  /**
+   * UV vertex coordinates, in the order of their indices.
+   */
+  Vector<std::array<float, 2>> uv_coords_;
   /**
    * Per-polygon-per-vertex UV vertex indices.
    */
@@ -98,6 +102,11 @@ class OBJMesh : NonCopyable {
   int tot_polygons() const;
   int tot_uv_vertices() const;
   int tot_edges() const;
+  /**
+   * \return Total normals written for the object: the loop normals of smooth-shaded polygons,
+   * and one normal for every flat-shaded polygon.
+   */
+  int tot_normals() const;
 
   /**
    * \return Total materials in the object.
@@ -149,11 +158,11 @@ class OBJMesh : NonCopyable {
    */
   Vector<int> calc_poly_vertex_indices(int poly_index) const;
   /**
-   * Calculate UV vertex coordinates of an Object.
-   *
-   * \note Also store the UV vertex indices in the member variable.
+   * Calculate UV vertex coordinates and indices of an Object, and store them in the member
+   * variables.
    */
-  void store_uv_coords_and_indices(Vector<std::array<float, 2>> &r_uv_coords);
+  void store_uv_coords_and_indices();
+  Span<std::array<float, 2>> get_uv_coords() const;
   Span<int> calc_poly_uv_indices(int poly_index) const;
   /**
    * Calculate polygon normal of a polygon at given index.
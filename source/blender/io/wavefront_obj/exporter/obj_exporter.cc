@@ -24,7 +24,9 @@
 
 #include "BKE_scene.h"
 
+#include "BLI_array.hh"
 #include "BLI_path_util.h"
+#include "BLI_task.hh"
 #include "BLI_vector.hh"
 
 #include "DEG_depsgraph_query.h"
@@ -157,40 +159,88 @@ static void write_mesh_objects(Vector<std::unique_ptr<OBJMesh>> exportable_as_me
     obj_writer.write_mtllib_name(mtl_writer->mtl_file_path());
   }
 
-  /* Smooth groups and UV vertex indices may make huge memory allocations, so they should be freed
-   * right after they're written, instead of waiting for #blender::Vector to clean them up after
-   * all the objects are exported. */
-  for (auto &obj_mesh : exportable_as_mesh) {
-    obj_writer.write_object_name(*obj_mesh);
-    obj_writer.write_vertex_coords(*obj_mesh);
-    Vector<int> obj_mtlindices;
-
-    if (obj_mesh->tot_polygons() > 0) {
-      if (export_params.export_smooth_groups) {
-        obj_mesh->calc_smooth_groups(export_params.smooth_groups_bitflags);
-      }
+  const int tot_objects = exportable_as_mesh.size();
+
+  /* Evaluated meshes can be shared by several objects, and so can materials. Everything which
+   * modifies them is done up front, before the objects are processed in parallel. */
+  Array<Vector<int>> obj_mtlindices(tot_objects);
+  for (const int i : IndexRange(tot_objects)) {
+    OBJMesh &obj_mesh = *exportable_as_mesh[i];
+    if (obj_mesh.tot_polygons() > 0) {
       if (export_params.export_normals) {
-        obj_writer.write_poly_normals(*obj_mesh);
-      }
-      if (export_params.export_uv) {
-        obj_writer.write_uv_coords(*obj_mesh);
+        obj_mesh.ensure_mesh_normals();
       }
       if (mtl_writer) {
-        obj_mtlindices = mtl_writer->add_materials(*obj_mesh);
+        obj_mtlindices[i] = mtl_writer->add_materials(obj_mesh);
       }
-      /* This function takes a 0-indexed slot index for the obj_mesh object and
-       * returns the material name that we are using in the .obj file for it. */
-      std::function<const char *(int)> matname_fn = [&](int s) -> const char * {
-        if (!mtl_writer || s < 0 || s >= obj_mtlindices.size()) {
-          return nullptr;
+    }
+    obj_mesh.ensure_mesh_edges();
+  }
+
+  threading::parallel_for(IndexRange(tot_objects), 1, [&](IndexRange range) {
+    for (const int i : range) {
+      OBJMesh &obj_mesh = *exportable_as_mesh[i];
+      if (obj_mesh.tot_polygons() > 0) {
+        if (export_params.export_smooth_groups) {
+          obj_mesh.calc_smooth_groups(export_params.smooth_groups_bitflags);
+        }
+        if (export_params.export_uv) {
+          obj_mesh.store_uv_coords_and_indices();
         }
-        return mtl_writer->mtlmaterial_name(obj_mtlindices[s]);
-      };
-      obj_writer.write_poly_elements(*obj_mesh, matname_fn);
+      }
+    }
+  });
+
+  /* Indices written for an object are offset by the totals of the objects before it. */
+  Array<IndexOffsets> index_offsets(tot_objects);
+  IndexOffsets offsets{0, 0, 0};
+  for (const int i : IndexRange(tot_objects)) {
+    const OBJMesh &obj_mesh = *exportable_as_mesh[i];
+    index_offsets[i] = offsets;
+    offsets.vertex_offset += obj_mesh.tot_vertices();
+    offsets.uv_vertex_offset += obj_mesh.tot_uv_vertices();
+    if (export_params.export_normals && obj_mesh.tot_polygons() > 0) {
+      offsets.normal_offset += obj_mesh.tot_normals();
+    }
+  }
+
+  /* Every object is formatted into its own buffer, and the buffers are written in order. */
+  Array<FormatHandler<eFileType::OBJ>> buffers(tot_objects);
+  threading::parallel_for(IndexRange(tot_objects), 1, [&](IndexRange range) {
+    for (const int i : range) {
+      FormatHandler<eFileType::OBJ> &fh = buffers[i];
+      OBJMesh &obj_mesh = *exportable_as_mesh[i];
+      obj_writer.write_object_name(fh, obj_mesh);
+      obj_writer.write_vertex_coords(fh, obj_mesh);
+
+      if (obj_mesh.tot_polygons() > 0) {
+        if (export_params.export_normals) {
+          obj_writer.write_poly_normals(fh, obj_mesh);
+        }
+        if (export_params.export_uv) {
+          obj_writer.write_uv_coords(fh, obj_mesh);
+        }
+        /* This function takes a 0-indexed slot index for the obj_mesh object and
+         * returns the material name that we are using in the .obj file for it. */
+        const Vector<int> &mtlindices = obj_mtlindices[i];
+        std::function<const char *(int)> matname_fn = [&](int s) -> const char * {
+          if (!mtl_writer || s < 0 || s >= mtlindices.size()) {
+            return nullptr;
+          }
+          return mtl_writer->mtlmaterial_name(mtlindices[s]);
+        };
+        obj_writer.write_poly_elements(fh, index_offsets[i], obj_mesh, matname_fn);
+      }
+      obj_writer.write_edges_indices(fh, index_offsets[i], obj_mesh);
+
+      /* Smooth groups and UV vertex indices may make huge memory allocations, so they should be
+       * freed right after they're written, instead of waiting for all objects to be exported. */
+      exportable_as_mesh[i].reset();
     }
-    obj_writer.write_edges_indices(*obj_mesh);
+  });
 
-    obj_writer.update_index_offsets(*obj_mesh);
+  for (FormatHandler<eFileType::OBJ> &fh : buffers) {
+    obj_writer.write_buffer(fh);
   }
 }
 
@@ -200,11 +250,13 @@ static void write_mesh_objects(Vector<std::unique_ptr<OBJMesh>> exportable_as_me
 static void write_nurbs_curve_objects(const Vector<std::unique_ptr<OBJCurve>> &exportable_as_nurbs,
                                       const OBJWriter &obj_writer)
 {
+  FormatHandler<eFileType::OBJ> fh;
   /* #OBJCurve doesn't have any dynamically allocated memory, so it's fine
    * to wait for #blender::Vector to clean the objects up. */
   for (const std::unique_ptr<OBJCurve> &obj_curve : exportable_as_nurbs) {
-    obj_writer.write_nurbs_curve(*obj_curve);
+    obj_writer.write_nurbs_curve(fh, *obj_curve);
   }
+  obj_writer.write_buffer(fh);
 }
 
 void export_frame(Depsgraph *depsgraph, const OBJExportParams &export_params, const char *filepath)
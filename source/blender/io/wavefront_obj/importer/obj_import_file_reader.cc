@@ -0,0 +1,795 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/** \file
+ * \ingroup obj
+ */
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+
+#include "BLI_array.hh"
+#include "BLI_fileops.h"
+#include "BLI_map.hh"
+#include "BLI_mmap.h"
+#include "BLI_task.hh"
+#include "BLI_utildefines.h"
+
+#include "obj_import_file_reader.hh"
+
+#ifdef WIN32
+#  include <io.h>
+#else
+#  include <unistd.h>
+#endif
+
+#ifndef O_BINARY
+#  define O_BINARY 0
+#endif
+
+namespace blender::io::obj {
+
+/** Approximate size of the chunks of the file which are parsed in parallel. */
+static const int64_t CHUNK_SIZE = 1 << 20;
+
+/** Material or smooth shading state which is inherited from the previous chunk. */
+static const int STATE_INHERIT = -2;
+
+/* -------------------------------------------------------------------- */
+/** \name Tokenizing
+ * \{ */
+
+static bool is_whitespace(const char c)
+{
+  /* Backslashes only appear in numeric data to continue lines, treat them as whitespace. */
+  return ELEM(c, ' ', '\t', '\r', '\n', '\\', '\f', '\v');
+}
+
+static bool is_digit(const char c)
+{
+  return c >= '0' && c <= '9';
+}
+
+static const char *skip_whitespace(const char *p, const char *end)
+{
+  while (p < end && is_whitespace(*p)) {
+    p++;
+  }
+  return p;
+}
+
+static const char *skip_token(const char *p, const char *end)
+{
+  while (p < end && !is_whitespace(*p)) {
+    p++;
+  }
+  return p;
+}
+
+/**
+ * End of the line starting at `p`. Lines ending with a backslash continue on the next line.
+ */
+static const char *find_line_end(const char *p, const char *end)
+{
+  const char *line_start = p;
+  while (p < end) {
+    const char *newline = static_cast<const char *>(memchr(p, '\n', end - p));
+    if (newline == nullptr) {
+      return end;
+    }
+    const char *last = newline;
+    if (last > line_start && last[-1] == '\r') {
+      last--;
+    }
+    if (last > line_start && last[-1] == '\\') {
+      p = newline + 1;
+      continue;
+    }
+    return newline;
+  }
+  return end;
+}
+
+static const double POWERS_OF_TEN[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                                       1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                                       1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+static double power_of_ten(const int exponent)
+{
+  if (exponent >= 0 && exponent < (int)ARRAY_SIZE(POWERS_OF_TEN)) {
+    return POWERS_OF_TEN[exponent];
+  }
+  return pow(10.0, exponent);
+}
+
+/**
+ * Parse a floating point number. Decimal numbers, which is what OBJ files consist of, are parsed
+ * without going through the C library. Anything else like `nan` or `inf` falls back to `strtod`.
+ *
+ * \return Position after the number, or `p` when there is no number.
+ */
+static const char *parse_float(const char *p, const char *end, float &r_value)
+{
+  const char *start = p;
+  bool negative = false;
+  if (p < end && ELEM(*p, '-', '+')) {
+    negative = (*p == '-');
+    p++;
+  }
+
+  uint64_t mantissa = 0;
+  int significant_digits = 0;
+  int exponent = 0;
+  bool has_digits = false;
+
+  for (; p < end && is_digit(*p); p++) {
+    has_digits = true;
+    if (significant_digits < 19) {
+      mantissa = mantissa * 10 + (*p - '0');
+      significant_digits += (mantissa != 0);
+    }
+    else {
+      exponent++;
+    }
+  }
+  if (p < end && *p == '.') {
+    p++;
+    for (; p < end && is_digit(*p); p++) {
+      has_digits = true;
+      if (significant_digits < 19) {
+        mantissa = mantissa * 10 + (*p - '0');
+        significant_digits += (mantissa != 0);
+        exponent--;
+      }
+    }
+  }
+
+  if (!has_digits) {
+    /* Not a decimal number, let the C library handle special values. */
+    const char *token_end = skip_token(start, end);
+    char token[64];
+    const size_t token_len = std::min<size_t>(token_end - start, sizeof(token) - 1);
+    memcpy(token, start, token_len);
+    token[token_len] = '\0';
+    char *parse_end;
+    const double value = strtod(token, &parse_end);
+    if (parse_end == token) {
+      return start;
+    }
+    r_value = (float)value;
+    return start + (parse_end - token);
+  }
+
+  if (p < end && ELEM(*p, 'e', 'E')) {
+    const char *exponent_start = p;
+    p++;
+    bool exponent_negative = false;
+    if (p < end && ELEM(*p, '-', '+')) {
+      exponent_negative = (*p == '-');
+      p++;
+    }
+    if (p < end && is_digit(*p)) {
+      int exponent_value = 0;
+      for (; p < end && is_digit(*p); p++) {
+        exponent_value = std::min(exponent_value * 10 + (*p - '0'), 1000);
+      }
+      exponent += exponent_negative ? -exponent_value : exponent_value;
+    }
+    else {
+      /* Not an exponent, leave the character for the caller. */
+      p = exponent_start;
+    }
+  }
+
+  double value = (double)mantissa;
+  if (exponent < 0) {
+    value /= power_of_ten(-exponent);
+  }
+  else if (exponent > 0) {
+    value *= power_of_ten(exponent);
+  }
+  r_value = (float)(negative ? -value : value);
+  return p;
+}
+
+/**
+ * \return Position after the integer, or `p` when there is no integer.
+ */
+static const char *parse_int(const char *p, const char *end, int &r_value)
+{
+  const char *start = p;
+  bool negative = false;
+  if (p < end && ELEM(*p, '-', '+')) {
+    negative = (*p == '-');
+    p++;
+  }
+  if (p == end || !is_digit(*p)) {
+    return start;
+  }
+  int64_t value = 0;
+  for (; p < end && is_digit(*p); p++) {
+    value = std::min<int64_t>(value * 10 + (*p - '0'), INT32_MAX);
+  }
+  r_value = (int)(negative ? -value : value);
+  return p;
+}
+
+/** Parse up to `count` floats, missing values are left unchanged. */
+static const char *parse_floats(const char *p, const char *end, float *r_values, const int count)
+{
+  for (int i = 0; i < count; i++) {
+    p = skip_whitespace(p, end);
+    p = parse_float(p, end, r_values[i]);
+  }
+  return p;
+}
+
+/** Rest of the line without surrounding whitespace, used for names. */
+static std::string parse_name(const char *p, const char *end)
+{
+  return std::string(StringRef(p, end - p).trim());
+}
+
+/** Keywords of the statements which are read, or #eKeyword::other for the rest. */
+enum class eKeyword {
+  vertex,
+  uv_vertex,
+  normal,
+  face,
+  line,
+  object,
+  usemtl,
+  smooth,
+  other,
+};
+
+static eKeyword parse_keyword(const char *&p, const char *end)
+{
+  const char *start = skip_whitespace(p, end);
+  p = skip_token(start, end);
+  const StringRef keyword(start, p - start);
+
+  if (keyword == "v") {
+    return eKeyword::vertex;
+  }
+  if (keyword == "vt") {
+    return eKeyword::uv_vertex;
+  }
+  if (keyword == "vn") {
+    return eKeyword::normal;
+  }
+  if (keyword == "f") {
+    return eKeyword::face;
+  }
+  if (keyword == "l") {
+    return eKeyword::line;
+  }
+  if (keyword == "o") {
+    return eKeyword::object;
+  }
+  if (keyword == "usemtl") {
+    return eKeyword::usemtl;
+  }
+  if (keyword == "s") {
+    return eKeyword::smooth;
+  }
+  return eKeyword::other;
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Chunk Parsing
+ * \{ */
+
+struct ChunkFace {
+  int corner_start;
+  int corner_count;
+  /** Index into #ChunkData::material_names, or #OBJ_INDEX_NONE or #STATE_INHERIT. */
+  int material_index;
+  /** Boolean, or #STATE_INHERIT. */
+  int shaded_smooth;
+};
+
+/** Geometry of the chunk up to the next `o` statement. */
+struct ChunkSegment {
+  /** The segment starts a new object, otherwise it continues the object of the previous one. */
+  bool starts_object = false;
+  std::string object_name;
+  Vector<ChunkFace> faces;
+  Vector<FaceCorner> face_corners;
+  Vector<EdgeElem> edges;
+};
+
+struct ChunkData {
+  const char *start;
+  const char *end;
+
+  int vertices_num = 0;
+  int uv_vertices_num = 0;
+  int normals_num = 0;
+
+  /* Offsets of the vertices of the chunk in #GlobalVertices. */
+  int vertex_offset = 0;
+  int uv_vertex_offset = 0;
+  int normal_offset = 0;
+
+  Vector<ChunkSegment> segments;
+  Vector<std::string> material_names;
+  /** State at the end of the chunk, passed on to the next chunk. */
+  int last_material_index = STATE_INHERIT;
+  int last_shaded_smooth = STATE_INHERIT;
+};
+
+/** Split the buffer into chunks of whole lines. */
+static Vector<ChunkData> split_into_chunks(const char *start, const char *end)
+{
+  Vector<ChunkData> chunks;
+  const char *p = start;
+  while (p < end) {
+    ChunkData chunk;
+    chunk.start = p;
+    if (end - p <= CHUNK_SIZE) {
+      p = end;
+    }
+    else {
+      p = find_line_end(p + CHUNK_SIZE, end);
+      p = std::min(p + 1, end);
+    }
+    chunk.end = p;
+    chunks.append(std::move(chunk));
+  }
+  return chunks;
+}
+
+static void count_chunk_vertices(ChunkData &chunk)
+{
+  const char *p = chunk.start;
+  while (p < chunk.end) {
+    const char *line_end = find_line_end(p, chunk.end);
+    switch (parse_keyword(p, line_end)) {
+      case eKeyword::vertex:
+        chunk.vertices_num++;
+        break;
+      case eKeyword::uv_vertex:
+        chunk.uv_vertices_num++;
+        break;
+      case eKeyword::normal:
+        chunk.normals_num++;
+        break;
+      default:
+        break;
+    }
+    p = line_end + 1;
+  }
+}
+
+/**
+ * Resolve a one-based, possibly relative OBJ index to a zero-based index.
+ *
+ * \param defined_num: Number of elements defined before the index is used.
+ * \return #OBJ_INDEX_NONE for invalid indices.
+ */
+static int resolve_index(const int index, const int defined_num, const int total_num)
+{
+  const int resolved = (index < 0) ? defined_num + index : index - 1;
+  if (index == 0 || resolved < 0 || resolved >= total_num) {
+    return OBJ_INDEX_NONE;
+  }
+  return resolved;
+}
+
+struct ChunkParser {
+  ChunkData &chunk;
+  GlobalVertices &global_vertices;
+
+  int vertices_num = 0;
+  int uv_vertices_num = 0;
+  int normals_num = 0;
+
+  int material_index = STATE_INHERIT;
+  int shaded_smooth = STATE_INHERIT;
+  Map<std::string, int> material_indices;
+
+  ChunkSegment *segment;
+
+  ChunkParser(ChunkData &chunk, GlobalVertices &global_vertices)
+      : chunk(chunk), global_vertices(global_vertices)
+  {
+    chunk.segments.append_as();
+    segment = &chunk.segments.last();
+  }
+
+  int resolve_vertex(const int index) const
+  {
+    return resolve_index(index,
+                         chunk.vertex_offset + vertices_num,
+                         (int)global_vertices.vertices.size());
+  }
+
+  void parse_vertex(const char *p, const char *end)
+  {
+    float3 &vert = global_vertices.vertices[chunk.vertex_offset + vertices_num++];
+    vert = float3(0.0f);
+    parse_floats(p, end, vert, 3);
+  }
+
+  void parse_uv_vertex(const char *p, const char *end)
+  {
+    float2 &uv = global_vertices.uv_vertices[chunk.uv_vertex_offset + uv_vertices_num++];
+    uv = float2(0.0f);
+    parse_floats(p, end, uv, 2);
+  }
+
+  void parse_normal(const char *p, const char *end)
+  {
+    float3 &normal = global_vertices.normals[chunk.normal_offset + normals_num++];
+    normal = float3(0.0f);
+    parse_floats(p, end, normal, 3);
+  }
+
+  void parse_face(const char *p, const char *end)
+  {
+    const int corner_start = segment->face_corners.size();
+    bool is_valid = true;
+
+    while (true) {
+      p = skip_whitespace(p, end);
+      if (p == end) {
+        break;
+      }
+
+      int index;
+      const char *next = parse_int(p, end, index);
+      if (next == p) {
+        is_valid = false;
+        break;
+      }
+      p = next;
+
+      FaceCorner corner;
+      corner.vert_index = resolve_vertex(index);
+      if (corner.vert_index == OBJ_INDEX_NONE) {
+        is_valid = false;
+      }
+
+      if (p < end && *p == '/') {
+        p++;
+        if (p < end && *p != '/') {
+          if ((next = parse_int(p, end, index)) != p) {
+            corner.uv_vert_index = resolve_index(index,
+                                                 chunk.uv_vertex_offset + uv_vertices_num,
+                                                 (int)global_vertices.uv_vertices.size());
+            p = next;
+          }
+        }
+        if (p < end && *p == '/') {
+          p++;
+          if ((next = parse_int(p, end, index)) != p) {
+            corner.normal_index = resolve_index(index,
+                                                chunk.normal_offset + normals_num,
+                                                (int)global_vertices.normals.size());
+            p = next;
+          }
+        }
+      }
+      /* Ignore anything else attached to the corner. */
+      p = skip_token(p, end);
+
+      segment->face_corners.append(corner);
+    }
+
+    const int corner_count = segment->face_corners.size() - corner_start;
+    if (is_valid && corner_count == 2) {
+      /* Faces with two corners are used as edges by some exporters. */
+      segment->edges.append({segment->face_corners[corner_start].vert_index,
+                             segment->face_corners[corner_start + 1].vert_index});
+    }
+    if (!is_valid || corner_count < 3) {
+      segment->face_corners.resize(corner_start);
+      return;
+    }
+
+    ChunkFace face;
+    face.corner_start = corner_start;
+    face.corner_count = corner_count;
+    face.material_index = material_index;
+    face.shaded_smooth = shaded_smooth;
+    segment->faces.append(face);
+  }
+
+  void parse_line(const char *p, const char *end)
+  {
+    int prev_vert = OBJ_INDEX_NONE;
+    while (true) {
+      p = skip_whitespace(p, end);
+      int index;
+      const char *next = parse_int(p, end, index);
+      if (next == p) {
+        break;
+      }
+      /* UV vertices of lines are not used. */
+      p = skip_token(next, end);
+
+      const int vert = resolve_vertex(index);
+      if (vert != OBJ_INDEX_NONE && prev_vert != OBJ_INDEX_NONE && vert != prev_vert) {
+        segment->edges.append({prev_vert, vert});
+      }
+      prev_vert = vert;
+    }
+  }
+
+  void parse_object(const char *p, const char *end)
+  {
+    chunk.segments.append_as();
+    segment = &chunk.segments.last();
+    segment->starts_object = true;
+    segment->object_name = parse_name(p, end);
+  }
+
+  void parse_usemtl(const char *p, const char *end)
+  {
+    std::string name = parse_name(p, end);
+    material_index = material_indices.lookup_or_add_cb(name, [&]() {
+      chunk.material_names.append(name);
+      return (int)chunk.material_names.size() - 1;
+    });
+  }
+
+  void parse_smooth(const char *p, const char *end)
+  {
+    p = skip_whitespace(p, end);
+    const StringRef value(p, skip_token(p, end) - p);
+    shaded_smooth = !(value.is_empty() || value == "off" || value == "0");
+  }
+
+  void parse()
+  {
+    const char *p = chunk.start;
+    while (p < chunk.end) {
+      const char *line_end = find_line_end(p, chunk.end);
+      switch (parse_keyword(p, line_end)) {
+        case eKeyword::vertex:
+          parse_vertex(p, line_end);
+          break;
+        case eKeyword::uv_vertex:
+          parse_uv_vertex(p, line_end);
+          break;
+        case eKeyword::normal:
+          parse_normal(p, line_end);
+          break;
+        case eKeyword::face:
+          parse_face(p, line_end);
+          break;
+        case eKeyword::line:
+          parse_line(p, line_end);
+          break;
+        case eKeyword::object:
+          parse_object(p, line_end);
+          break;
+        case eKeyword::usemtl:
+          parse_usemtl(p, line_end);
+          break;
+        case eKeyword::smooth:
+          parse_smooth(p, line_end);
+          break;
+        case eKeyword::other:
+          break;
+      }
+      p = line_end + 1;
+    }
+
+    chunk.last_material_index = material_index;
+    chunk.last_shaded_smooth = shaded_smooth;
+  }
+};
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Merging Chunks
+ * \{ */
+
+/** Segments of all chunks which make up one object. */
+struct ObjectSegments {
+  std::string name;
+  Vector<ChunkSegment *> segments;
+  /** Material and shading state of the faces inherited by each segment. */
+  Vector<int> inherited_material_index;
+  Vector<bool> inherited_shaded_smooth;
+  /** Global material index of the chunk material indices for each segment. */
+  Vector<const Array<int> *> material_maps;
+};
+
+static void build_geometry(const ObjectSegments &object, Geometry &geometry)
+{
+  const int segments_num = object.segments.size();
+  Array<int> face_offsets(segments_num + 1);
+  Array<int> corner_offsets(segments_num + 1);
+  Array<int> edge_offsets(segments_num + 1);
+  face_offsets[0] = corner_offsets[0] = edge_offsets[0] = 0;
+  for (const int i : IndexRange(segments_num)) {
+    const ChunkSegment &segment = *object.segments[i];
+    face_offsets[i + 1] = face_offsets[i] + segment.faces.size();
+    corner_offsets[i + 1] = corner_offsets[i] + segment.face_corners.size();
+    edge_offsets[i + 1] = edge_offsets[i] + segment.edges.size();
+  }
+
+  geometry.name = object.name;
+  geometry.faces.resize(face_offsets.last());
+  geometry.face_corners.resize(corner_offsets.last());
+  geometry.edges.resize(edge_offsets.last());
+
+  threading::parallel_for(IndexRange(segments_num), 1, [&](IndexRange range) {
+    for (const int i : range) {
+      const ChunkSegment &segment = *object.segments[i];
+      const Array<int> &material_map = *object.material_maps[i];
+
+      for (const int face_index : segment.faces.index_range()) {
+        const ChunkFace &chunk_face = segment.faces[face_index];
+        FaceElem &face = geometry.faces[face_offsets[i] + face_index];
+        face.corner_start = corner_offsets[i] + chunk_face.corner_start;
+        face.corner_count = chunk_face.corner_count;
+        if (chunk_face.material_index == STATE_INHERIT) {
+          face.material_index = object.inherited_material_index[i];
+        }
+        else {
+          face.material_index = material_map[chunk_face.material_index];
+        }
+        face.shaded_smooth = (chunk_face.shaded_smooth == STATE_INHERIT) ?
+                                 object.inherited_shaded_smooth[i] :
+                                 (bool)chunk_face.shaded_smooth;
+      }
+
+      std::copy(segment.face_corners.begin(),
+                segment.face_corners.end(),
+                geometry.face_corners.begin() + corner_offsets[i]);
+      std::copy(segment.edges.begin(), segment.edges.end(), geometry.edges.begin() + edge_offsets[i]);
+    }
+  });
+}
+
+void parse_obj_buffer(StringRef buffer, OBJParseResult &r_result)
+{
+  Vector<ChunkData> chunks = split_into_chunks(buffer.begin(), buffer.end());
+
+  /* First pass: count the vertices of each chunk so vertex offsets are known while parsing. */
+  threading::parallel_for(chunks.index_range(), 1, [&](IndexRange range) {
+    for (const int i : range) {
+      count_chunk_vertices(chunks[i]);
+    }
+  });
+
+  int vertices_num = 0;
+  int uv_vertices_num = 0;
+  int normals_num = 0;
+  for (ChunkData &chunk : chunks) {
+    chunk.vertex_offset = vertices_num;
+    chunk.uv_vertex_offset = uv_vertices_num;
+    chunk.normal_offset = normals_num;
+    vertices_num += chunk.vertices_num;
+    uv_vertices_num += chunk.uv_vertices_num;
+    normals_num += chunk.normals_num;
+  }
+
+  GlobalVertices &global_vertices = r_result.global_vertices;
+  global_vertices.vertices.resize(vertices_num);
+  global_vertices.uv_vertices.resize(uv_vertices_num);
+  global_vertices.normals.resize(normals_num);
+
+  /* Second pass: parse all data of the chunks. */
+  threading::parallel_for(chunks.index_range(), 1, [&](IndexRange range) {
+    for (const int i : range) {
+      ChunkParser parser(chunks[i], global_vertices);
+      parser.parse();
+    }
+  });
+
+  /* Gather materials of all chunks, and pass the state at the end of a chunk to the next one. */
+  Map<std::string, int> material_indices;
+  Array<Array<int>> material_maps(chunks.size());
+  Vector<ObjectSegments> objects;
+  int material_index = OBJ_INDEX_NONE;
+  bool shaded_smooth = false;
+
+  for (const int i : chunks.index_range()) {
+    ChunkData &chunk = chunks[i];
+    Array<int> &material_map = material_maps[i];
+    material_map.reinitialize(chunk.material_names.size());
+    for (const int local_index : chunk.material_names.index_range()) {
+      const std::string &name = chunk.material_names[local_index];
+      material_map[local_index] = material_indices.lookup_or_add_cb(name, [&]() {
+        r_result.material_names.append(name);
+        return (int)r_result.material_names.size() - 1;
+      });
+    }
+
+    for (ChunkSegment &segment : chunk.segments) {
+      if (segment.starts_object || objects.is_empty()) {
+        objects.append_as();
+        objects.last().name = segment.object_name;
+      }
+      ObjectSegments &object = objects.last();
+      object.segments.append(&segment);
+      object.inherited_material_index.append(material_index);
+      object.inherited_shaded_smooth.append(shaded_smooth);
+      object.material_maps.append(&material_map);
+    }
+
+    if (chunk.last_material_index != STATE_INHERIT) {
+      material_index = (chunk.last_material_index == OBJ_INDEX_NONE) ?
+                           OBJ_INDEX_NONE :
+                           material_map[chunk.last_material_index];
+    }
+    if (chunk.last_shaded_smooth != STATE_INHERIT) {
+      shaded_smooth = chunk.last_shaded_smooth;
+    }
+  }
+
+  Array<std::unique_ptr<Geometry>> geometries(objects.size());
+  threading::parallel_for(objects.index_range(), 1, [&](IndexRange range) {
+    for (const int i : range) {
+      geometries[i] = std::make_unique<Geometry>();
+      build_geometry(objects[i], *geometries[i]);
+    }
+  });
+
+  /* Objects without faces and edges have no vertices either, since vertices are only part of an
+   * object by being used. Files which only contain vertices become one point cloud like mesh. */
+  for (std::unique_ptr<Geometry> &geometry : geometries) {
+    if (!geometry->faces.is_empty() || !geometry->edges.is_empty()) {
+      r_result.geometries.append(std::move(geometry));
+    }
+  }
+  if (r_result.geometries.is_empty() && vertices_num > 0) {
+    std::unique_ptr<Geometry> geometry = std::move(geometries.first());
+    geometry->use_all_vertices = true;
+    r_result.geometries.append(std::move(geometry));
+  }
+}
+
+/** \} */
+
+bool parse_obj_file(const char *filepath, OBJParseResult &r_result)
+{
+  const int file = BLI_open(filepath, O_BINARY | O_RDONLY, 0);
+  if (file == -1) {
+    return false;
+  }
+
+  const size_t size = BLI_file_descriptor_size(file);
+  if (size == 0 || size == (size_t)-1) {
+    close(file);
+    return size == 0;
+  }
+
+  BLI_mmap_file *mmap_file = BLI_mmap_open(file);
+  if (mmap_file == nullptr) {
+    close(file);
+    return false;
+  }
+
+  const char *data = static_cast<const char *>(BLI_mmap_get_pointer(mmap_file));
+  parse_obj_buffer(StringRef(data, (int64_t)size), r_result);
+
+  BLI_mmap_free(mmap_file);
+  close(file);
+  return true;
+}
+
+}  // namespace blender::io::obj
@@ -0,0 +1,103 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/** \file
+ * \ingroup obj
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "BLI_float2.hh"
+#include "BLI_float3.hh"
+#include "BLI_string_ref.hh"
+#include "BLI_vector.hh"
+
+namespace blender::io::obj {
+
+/** Denote absence of a UV vertex or normal in a face corner. */
+const int OBJ_INDEX_NONE = -1;
+
+/**
+ * Indices of a face corner into #GlobalVertices. OBJ indices are one-based and can be relative,
+ * these are resolved to zero-based absolute indices while parsing.
+ */
+struct FaceCorner {
+  int vert_index;
+  int uv_vert_index = OBJ_INDEX_NONE;
+  int normal_index = OBJ_INDEX_NONE;
+};
+
+struct FaceElem {
+  /** First corner of the face in #Geometry::face_corners. */
+  int corner_start;
+  int corner_count;
+  /** Index into #OBJParseResult::material_names, or #OBJ_INDEX_NONE. */
+  int material_index;
+  bool shaded_smooth;
+};
+
+struct EdgeElem {
+  int v1;
+  int v2;
+};
+
+/**
+ * Faces and loose edges of one object of the file, started by an `o` statement. Geometry before
+ * the first `o` statement belongs to an object without name.
+ */
+struct Geometry {
+  std::string name;
+  Vector<FaceElem> faces;
+  Vector<FaceCorner> face_corners;
+  Vector<EdgeElem> edges;
+  /** The object consists of all vertices of the file, used when there are no faces or edges. */
+  bool use_all_vertices = false;
+};
+
+/** Vertex data of the whole file, indices of all objects refer to it. */
+struct GlobalVertices {
+  Vector<float3> vertices;
+  Vector<float2> uv_vertices;
+  Vector<float3> normals;
+};
+
+struct OBJParseResult {
+  GlobalVertices global_vertices;
+  /** Names used by `usemtl` statements, in order of first use. */
+  Vector<std::string> material_names;
+  Vector<std::unique_ptr<Geometry>> geometries;
+};
+
+/**
+ * Parse the contents of an OBJ file. The buffer is split into chunks of whole lines which are
+ * parsed in parallel: a first pass counts the vertices of every chunk, so the second pass can
+ * resolve relative indices and write vertices directly to their place in #GlobalVertices.
+ *
+ * Only polygonal geometry is read, free-form curves and surfaces are skipped.
+ */
+void parse_obj_buffer(StringRef buffer, OBJParseResult &r_result);
+
+/**
+ * Read the OBJ file at `filepath` and parse it with #parse_obj_buffer.
+ *
+ * \return False when the file cannot be read.
+ */
+bool parse_obj_file(const char *filepath, OBJParseResult &r_result);
+
+}  // namespace blender::io::obj
@@ -0,0 +1,283 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/** \file
+ * \ingroup obj
+ */
+
+#include "MEM_guardedalloc.h"
+
+#include "BKE_customdata.h"
+#include "BKE_material.h"
+#include "BKE_mesh.h"
+#include "BKE_object.h"
+
+#include "BLI_map.hh"
+#include "BLI_math.h"
+#include "BLI_set.hh"
+#include "BLI_task.hh"
+
+#include "DNA_customdata_types.h"
+#include "DNA_material_types.h"
+#include "DNA_mesh_types.h"
+#include "DNA_meshdata_types.h"
+#include "DNA_object_types.h"
+
+#include "obj_import_mesh.hh"
+
+namespace blender::io::obj {
+
+MeshFromGeometry::MeshFromGeometry(const Geometry &geometry,
+                                   const GlobalVertices &global_vertices,
+                                   MutableSpan<int> global_to_local_vertices,
+                                   const OBJImportParams &import_params)
+    : geometry_(geometry),
+      global_vertices_(global_vertices),
+      global_to_local_vertices_(global_to_local_vertices)
+{
+  unit_m3(axes_transform_);
+  /* +Y-forward and +Z-up are the default Blender axis settings. */
+  mat3_from_axis_conversion(import_params.forward_axis,
+                            import_params.up_axis,
+                            OBJ_AXIS_Y_FORWARD,
+                            OBJ_AXIS_Z_UP,
+                            axes_transform_);
+  /* mat3_from_axis_conversion returns a transposed matrix! */
+  transpose_m3(axes_transform_);
+}
+
+/**
+ * Give the vertices used by the geometry local indices, in order of first use.
+ */
+void MeshFromGeometry::map_vertices()
+{
+  if (geometry_.use_all_vertices) {
+    return;
+  }
+  auto add_vertex = [&](const int global_index) {
+    if (global_to_local_vertices_[global_index] == OBJ_INDEX_NONE) {
+      global_to_local_vertices_[global_index] = local_to_global_vertices_.size();
+      local_to_global_vertices_.append(global_index);
+    }
+  };
+  for (const FaceCorner &corner : geometry_.face_corners) {
+    add_vertex(corner.vert_index);
+  }
+
+  /* #BKE_mesh_calc_edges expects the existing edges to be unique. */
+  Set<std::pair<int, int>> added_edges;
+  for (const EdgeElem &edge : geometry_.edges) {
+    add_vertex(edge.v1);
+    add_vertex(edge.v2);
+    const int v1 = global_to_local_vertices_[edge.v1];
+    const int v2 = global_to_local_vertices_[edge.v2];
+    if (v1 != v2 && added_edges.add({std::min(v1, v2), std::max(v1, v2)})) {
+      loose_edges_.append({v1, v2});
+    }
+  }
+}
+
+void MeshFromGeometry::reset_vertex_map()
+{
+  for (const int global_index : local_to_global_vertices_) {
+    global_to_local_vertices_[global_index] = OBJ_INDEX_NONE;
+  }
+}
+
+void MeshFromGeometry::create_vertices(Mesh *mesh)
+{
+  const Span<float3> vertices = global_vertices_.vertices;
+  threading::parallel_for(IndexRange(mesh->totvert), 4096, [&](IndexRange range) {
+    for (const int i : range) {
+      const int global_index = geometry_.use_all_vertices ? i : local_to_global_vertices_[i];
+      mul_v3_m3v3(mesh->mvert[i].co, axes_transform_, vertices[global_index]);
+    }
+  });
+}
+
+void MeshFromGeometry::create_polys_loops(Mesh *mesh, Vector<int> &r_material_indices)
+{
+  /* Material slots of the object, in order of first use by the faces. */
+  Map<int, int> material_slots;
+  for (const FaceElem &face : geometry_.faces) {
+    if (face.material_index != OBJ_INDEX_NONE) {
+      material_slots.lookup_or_add_cb(face.material_index, [&]() {
+        r_material_indices.append(face.material_index);
+        return (int)r_material_indices.size() - 1;
+      });
+    }
+  }
+
+  threading::parallel_for(geometry_.faces.index_range(), 4096, [&](IndexRange range) {
+    for (const int i : range) {
+      const FaceElem &face = geometry_.faces[i];
+      MPoly &mpoly = mesh->mpoly[i];
+      mpoly.loopstart = face.corner_start;
+      mpoly.totloop = face.corner_count;
+      mpoly.mat_nr = (face.material_index == OBJ_INDEX_NONE) ?
+                         0 :
+                         material_slots.lookup(face.material_index);
+      if (face.shaded_smooth) {
+        mpoly.flag |= ME_SMOOTH;
+      }
+
+      for (const int corner : IndexRange(face.corner_start, face.corner_count)) {
+        const int global_index = geometry_.face_corners[corner].vert_index;
+        mesh->mloop[corner].v = geometry_.use_all_vertices ?
+                                    global_index :
+                                    global_to_local_vertices_[global_index];
+      }
+    }
+  });
+}
+
+void MeshFromGeometry::create_loose_edges(Mesh *mesh)
+{
+  for (const int i : loose_edges_.index_range()) {
+    MEdge &medge = mesh->medge[i];
+    medge.v1 = loose_edges_[i].v1;
+    medge.v2 = loose_edges_[i].v2;
+    medge.flag = ME_EDGEDRAW | ME_EDGERENDER;
+  }
+}
+
+bool MeshFromGeometry::has_uv_verts() const
+{
+  for (const FaceCorner &corner : geometry_.face_corners) {
+    if (corner.uv_vert_index != OBJ_INDEX_NONE) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool MeshFromGeometry::has_normals() const
+{
+  for (const FaceCorner &corner : geometry_.face_corners) {
+    if (corner.normal_index != OBJ_INDEX_NONE) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void MeshFromGeometry::create_uv_verts(Mesh *mesh)
+{
+  MLoopUV *mluv = static_cast<MLoopUV *>(CustomData_add_layer_named(
+      &mesh->ldata, CD_MLOOPUV, CD_DEFAULT, nullptr, mesh->totloop, "UVMap"));
+  const Span<float2> uv_vertices = global_vertices_.uv_vertices;
+  threading::parallel_for(geometry_.face_corners.index_range(), 4096, [&](IndexRange range) {
+    for (const int i : range) {
+      const int uv_index = geometry_.face_corners[i].uv_vert_index;
+      if (uv_index == OBJ_INDEX_NONE) {
+        zero_v2(mluv[i].uv);
+      }
+      else {
+        copy_v2_v2(mluv[i].uv, uv_vertices[uv_index]);
+      }
+    }
+  });
+}
+
+void MeshFromGeometry::create_normals(Mesh *mesh)
+{
+  float(*lnors)[3] = static_cast<float(*)[3]>(
+      MEM_malloc_arrayN(mesh->totloop, sizeof(float[3]), "OBJ::CustomNormals"));
+  const Span<float3> normals = global_vertices_.normals;
+  threading::parallel_for(geometry_.face_corners.index_range(), 4096, [&](IndexRange range) {
+    for (const int i : range) {
+      const int normal_index = geometry_.face_corners[i].normal_index;
+      if (normal_index == OBJ_INDEX_NONE) {
+        /* Zero custom normals use the automatically computed normal. */
+        zero_v3(lnors[i]);
+      }
+      else {
+        mul_v3_m3v3(lnors[i], axes_transform_, normals[normal_index]);
+        normalize_v3(lnors[i]);
+      }
+    }
+  });
+
+  /* Custom normals are only used on smooth faces. */
+  for (const int i : IndexRange(mesh->totpoly)) {
+    mesh->mpoly[i].flag |= ME_SMOOTH;
+  }
+  mesh->flag |= ME_AUTOSMOOTH;
+  BKE_mesh_set_custom_normals(mesh, lnors);
+  MEM_freeN(lnors);
+}
+
+Mesh *MeshFromGeometry::create_mesh()
+{
+  map_vertices();
+
+  const int verts_len = geometry_.use_all_vertices ? global_vertices_.vertices.size() :
+                                                     local_to_global_vertices_.size();
+  Mesh *mesh = BKE_mesh_new_nomain(verts_len,
+                                   loose_edges_.size(),
+                                   0,
+                                   geometry_.face_corners.size(),
+                                   geometry_.faces.size());
+  return mesh;
+}
+
+Object *MeshFromGeometry::create_mesh_object(Main *bmain,
+                                             Span<Material *> materials,
+                                             const char *default_name,
+                                             const OBJImportParams &import_params)
+{
+  Mesh *mesh = create_mesh();
+  Vector<int> material_indices;
+  create_vertices(mesh);
+  create_polys_loops(mesh, material_indices);
+  create_loose_edges(mesh);
+  reset_vertex_map();
+
+  BKE_mesh_calc_edges(mesh, true, false);
+  BKE_mesh_calc_edges_loose(mesh);
+  BKE_mesh_calc_normals(mesh);
+
+  if (has_uv_verts()) {
+    create_uv_verts(mesh);
+    BKE_mesh_update_customdata_pointers(mesh, false);
+  }
+  if (has_normals()) {
+    create_normals(mesh);
+  }
+
+  if (import_params.validate_meshes) {
+    BKE_mesh_validate(mesh, false, true);
+  }
+
+  const char *name = geometry_.name.empty() ? default_name : geometry_.name.c_str();
+  Mesh *mesh_dst = BKE_mesh_add(bmain, name);
+  Object *ob = BKE_object_add_only_object(bmain, OB_MESH, name);
+  ob->data = mesh_dst;
+  const bool use_autosmooth = (mesh->flag & ME_AUTOSMOOTH) != 0;
+  BKE_mesh_nomain_to_mesh(mesh, mesh_dst, ob, &CD_MASK_MESH, true);
+  if (use_autosmooth) {
+    mesh_dst->flag |= ME_AUTOSMOOTH;
+  }
+
+  for (const int slot : material_indices.index_range()) {
+    BKE_object_material_assign(
+        bmain, ob, materials[material_indices[slot]], slot + 1, BKE_MAT_ASSIGN_OBDATA);
+  }
+
+  return ob;
+}
+
+}  // namespace blender::io::obj
@@ -0,0 +1,85 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/** \file
+ * \ingroup obj
+ */
+
+#pragma once
+
+#include "BLI_span.hh"
+#include "BLI_utility_mixins.hh"
+#include "BLI_vector.hh"
+
+#include "IO_wavefront_obj.h"
+
+#include "obj_import_file_reader.hh"
+
+struct Main;
+struct Material;
+struct Mesh;
+struct Object;
+
+namespace blender::io::obj {
+
+/**
+ * Create a mesh object from one #Geometry of the parsed file.
+ */
+class MeshFromGeometry : NonMovable, NonCopyable {
+ private:
+  const Geometry &geometry_;
+  const GlobalVertices &global_vertices_;
+  /** Conversion from the axes of the file to Blender's axes. */
+  float axes_transform_[3][3];
+
+  /** Global vertex indices of the vertices used by the geometry, in order of first use. */
+  Vector<int> local_to_global_vertices_;
+  /**
+   * Local index of every global vertex, or #OBJ_INDEX_NONE. The array is shared by all objects so
+   * it does not have to be allocated for each of them, entries are reset after use.
+   */
+  MutableSpan<int> global_to_local_vertices_;
+  /** Unique edges which are not part of faces, with local vertex indices. */
+  Vector<EdgeElem> loose_edges_;
+
+ public:
+  MeshFromGeometry(const Geometry &geometry,
+                   const GlobalVertices &global_vertices,
+                   MutableSpan<int> global_to_local_vertices,
+                   const OBJImportParams &import_params);
+
+  /**
+   * Create the mesh object. `materials` are the materials of #OBJParseResult::material_names.
+   */
+  Object *create_mesh_object(Main *bmain,
+                             Span<Material *> materials,
+                             const char *default_name,
+                             const OBJImportParams &import_params);
+
+ private:
+  void map_vertices();
+  void reset_vertex_map();
+  Mesh *create_mesh();
+  void create_vertices(Mesh *mesh);
+  void create_polys_loops(Mesh *mesh, Vector<int> &r_material_indices);
+  void create_loose_edges(Mesh *mesh);
+  void create_uv_verts(Mesh *mesh);
+  void create_normals(Mesh *mesh);
+  bool has_uv_verts() const;
+  bool has_normals() const;
+};
+
+}  // namespace blender::io::obj
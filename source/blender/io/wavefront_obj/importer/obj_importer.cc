@@ -0,0 +1,120 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/** \file
+ * \ingroup obj
+ */
+
+#include <cstdio>
+
+#include "BKE_collection.h"
+#include "BKE_layer.h"
+#include "BKE_lib_id.h"
+#include "BKE_main.h"
+#include "BKE_material.h"
+
+#include "BLI_array.hh"
+#include "BLI_listbase.h"
+#include "BLI_path_util.h"
+#include "BLI_string.h"
+
+#include "DEG_depsgraph.h"
+#include "DEG_depsgraph_build.h"
+
+#include "DNA_collection_types.h"
+#include "DNA_material_types.h"
+#include "DNA_object_types.h"
+#include "DNA_scene_types.h"
+
+#include "obj_import_file_reader.hh"
+#include "obj_import_mesh.hh"
+#include "obj_importer.hh"
+
+namespace blender::io::obj {
+
+/**
+ * Find the materials used by `usemtl` statements by name, and create the missing ones.
+ */
+static Vector<Material *> find_or_create_materials(Main *bmain, Span<std::string> names)
+{
+  Vector<Material *> materials;
+  for (const std::string &name : names) {
+    Material *material = static_cast<Material *>(
+        BLI_findstring(&bmain->materials, name.c_str(), offsetof(ID, name) + 2));
+    if (material == nullptr) {
+      material = BKE_material_add(bmain, name.c_str());
+      /* Users are added when the material is assigned to objects. */
+      id_us_min(&material->id);
+    }
+    materials.append(material);
+  }
+  return materials;
+}
+
+void importer_main(Main *bmain,
+                   Scene *scene,
+                   ViewLayer *view_layer,
+                   const OBJImportParams &import_params)
+{
+  OBJParseResult parse_result;
+  if (!parse_obj_file(import_params.filepath, parse_result)) {
+    fprintf(stderr, "Cannot read OBJ file '%s'.\n", import_params.filepath);
+    return;
+  }
+
+  /* Objects without a name use the name of the file. */
+  char default_name[FILE_MAX];
+  BLI_strncpy(default_name, BLI_path_basename(import_params.filepath), sizeof(default_name));
+  BLI_path_extension_replace(default_name, sizeof(default_name), "");
+
+  const Vector<Material *> materials = find_or_create_materials(bmain,
+                                                                parse_result.material_names);
+
+  BKE_view_layer_base_deselect_all(view_layer);
+  LayerCollection *lc = BKE_layer_collection_get_active(view_layer);
+
+  Array<int> global_to_local_vertices(parse_result.global_vertices.vertices.size(),
+                                      OBJ_INDEX_NONE);
+  for (const std::unique_ptr<Geometry> &geometry : parse_result.geometries) {
+    MeshFromGeometry mesh_from_geometry{
+        *geometry, parse_result.global_vertices, global_to_local_vertices, import_params};
+    Object *ob = mesh_from_geometry.create_mesh_object(
+        bmain, materials, default_name, import_params);
+
+    BKE_collection_object_add(bmain, lc->collection, ob);
+    Base *base = BKE_view_layer_base_find(view_layer, ob);
+    BKE_view_layer_base_select_and_set_active(view_layer, base);
+
+    DEG_id_tag_update(&lc->collection->id, ID_RECALC_COPY_ON_WRITE);
+    DEG_id_tag_update_ex(bmain,
+                         &ob->id,
+                         ID_RECALC_TRANSFORM | ID_RECALC_GEOMETRY | ID_RECALC_ANIMATION |
+                             ID_RECALC_BASE_FLAGS);
+  }
+
+  DEG_id_tag_update(&scene->id, ID_RECALC_BASE_FLAGS);
+  DEG_relations_tag_update(bmain);
+}
+
+void importer_main(bContext *C, const OBJImportParams &import_params)
+{
+  Main *bmain = CTX_data_main(C);
+  Scene *scene = CTX_data_scene(C);
+  ViewLayer *view_layer = CTX_data_view_layer(C);
+  importer_main(bmain, scene, view_layer, import_params);
+}
+
+}  // namespace blender::io::obj
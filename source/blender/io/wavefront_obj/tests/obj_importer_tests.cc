@@ -0,0 +1,182 @@
+/* Apache License, Version 2.0 */
+
+#include <gtest/gtest.h>
+#include <string>
+
+#include "testing/testing.h"
+
+#include "obj_import_file_reader.hh"
+
+namespace blender::io::obj {
+
+static void parse_string(const std::string &text, OBJParseResult &r_result)
+{
+  parse_obj_buffer(StringRef(text), r_result);
+}
+
+TEST(obj_importer_parse, empty)
+{
+  OBJParseResult result;
+  parse_string("", result);
+  EXPECT_EQ(result.global_vertices.vertices.size(), 0);
+  EXPECT_EQ(result.geometries.size(), 0);
+}
+
+TEST(obj_importer_parse, vertices)
+{
+  OBJParseResult result;
+  parse_string(
+      "# comment\n"
+      "v 1 2 3\n"
+      "v -1.5e1 .5 +2\r\n"
+      "v 0 0 \\\n"
+      "  1\n"
+      "vt 0.5 0.25\n"
+      "vn 0 0 1\n",
+      result);
+  ASSERT_EQ(result.global_vertices.vertices.size(), 3);
+  EXPECT_EQ(result.global_vertices.uv_vertices.size(), 1);
+  EXPECT_EQ(result.global_vertices.normals.size(), 1);
+  EXPECT_EQ(result.global_vertices.vertices[0], float3(1.0f, 2.0f, 3.0f));
+  EXPECT_EQ(result.global_vertices.vertices[1], float3(-15.0f, 0.5f, 2.0f));
+  EXPECT_EQ(result.global_vertices.vertices[2], float3(0.0f, 0.0f, 1.0f));
+  EXPECT_EQ(result.global_vertices.uv_vertices[0], float2(0.5f, 0.25f));
+
+  /* Without faces or edges, all vertices make up one object. */
+  ASSERT_EQ(result.geometries.size(), 1);
+  EXPECT_TRUE(result.geometries[0]->use_all_vertices);
+}
+
+TEST(obj_importer_parse, face_corners)
+{
+  OBJParseResult result;
+  parse_string(
+      "v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\n"
+      "vt 0 0\nvt 1 0\nvt 1 1\n"
+      "vn 0 0 1\n"
+      "f 1/1/1 2/2/1 3/3/1\n"
+      "f 1//1 3//1 4//1\n"
+      "f 1/1 2/2 4/3\n"
+      "f -4 -3 -2 -1\n",
+      result);
+  ASSERT_EQ(result.geometries.size(), 1);
+  const Geometry &geometry = *result.geometries[0];
+  EXPECT_TRUE(geometry.name.empty());
+  ASSERT_EQ(geometry.faces.size(), 4);
+  ASSERT_EQ(geometry.face_corners.size(), 13);
+
+  EXPECT_EQ(geometry.face_corners[1].vert_index, 1);
+  EXPECT_EQ(geometry.face_corners[1].uv_vert_index, 1);
+  EXPECT_EQ(geometry.face_corners[1].normal_index, 0);
+  EXPECT_EQ(geometry.face_corners[4].uv_vert_index, OBJ_INDEX_NONE);
+  EXPECT_EQ(geometry.face_corners[4].normal_index, 0);
+  EXPECT_EQ(geometry.face_corners[8].uv_vert_index, 2);
+  EXPECT_EQ(geometry.face_corners[8].normal_index, OBJ_INDEX_NONE);
+
+  /* Relative indices. */
+  const FaceElem &quad = geometry.faces[3];
+  EXPECT_EQ(quad.corner_count, 4);
+  for (const int i : IndexRange(4)) {
+    EXPECT_EQ(geometry.face_corners[quad.corner_start + i].vert_index, i);
+  }
+}
+
+TEST(obj_importer_parse, invalid_faces_and_edges)
+{
+  OBJParseResult result;
+  parse_string(
+      "v 0 0 0\nv 1 0 0\nv 1 1 0\n"
+      "f 1 2 4\n"
+      "f 1 2\n"
+      "l 1 2 3\n"
+      "f 1/5 2/5 3/5\n",
+      result);
+  ASSERT_EQ(result.geometries.size(), 1);
+  const Geometry &geometry = *result.geometries[0];
+  /* The face with an out of range vertex is skipped, the invalid UV index is ignored. */
+  ASSERT_EQ(geometry.faces.size(), 1);
+  EXPECT_EQ(geometry.face_corners[0].uv_vert_index, OBJ_INDEX_NONE);
+  /* A face with two vertices is an edge. */
+  ASSERT_EQ(geometry.edges.size(), 3);
+  EXPECT_EQ(geometry.edges[0].v1, 0);
+  EXPECT_EQ(geometry.edges[0].v2, 1);
+  EXPECT_EQ(geometry.edges[2].v1, 1);
+  EXPECT_EQ(geometry.edges[2].v2, 2);
+}
+
+TEST(obj_importer_parse, objects_materials_smoothing)
+{
+  OBJParseResult result;
+  parse_string(
+      "mtllib scene.mtl\n"
+      "v 0 0 0\nv 1 0 0\nv 1 1 0\n"
+      "o Cube\n"
+      "usemtl Red\n"
+      "s 1\n"
+      "f 1 2 3\n"
+      "usemtl Blue\n"
+      "s off\n"
+      "f 1 2 3\n"
+      "o Empty\n"
+      "o Plane\n"
+      "g group\n"
+      "f 1 2 3\n"
+      "usemtl Red\n"
+      "f 1 2 3\n",
+      result);
+  ASSERT_EQ(result.material_names.size(), 2);
+  EXPECT_EQ(result.material_names[0], "Red");
+  EXPECT_EQ(result.material_names[1], "Blue");
+
+  /* Objects without geometry are skipped. */
+  ASSERT_EQ(result.geometries.size(), 2);
+  const Geometry &cube = *result.geometries[0];
+  const Geometry &plane = *result.geometries[1];
+  EXPECT_EQ(cube.name, "Cube");
+  EXPECT_EQ(plane.name, "Plane");
+
+  ASSERT_EQ(cube.faces.size(), 2);
+  EXPECT_EQ(cube.faces[0].material_index, 0);
+  EXPECT_TRUE(cube.faces[0].shaded_smooth);
+  EXPECT_EQ(cube.faces[1].material_index, 1);
+  EXPECT_FALSE(cube.faces[1].shaded_smooth);
+
+  /* Material and smoothing state continue into the next object. */
+  ASSERT_EQ(plane.faces.size(), 2);
+  EXPECT_EQ(plane.faces[0].material_index, 1);
+  EXPECT_FALSE(plane.faces[0].shaded_smooth);
+  EXPECT_EQ(plane.faces[1].material_index, 0);
+}
+
+TEST(obj_importer_parse, multiple_chunks)
+{
+  /* Large enough to be split into several chunks which are parsed in parallel. */
+  std::string text = "o Big\nusemtl Material\ns 1\n";
+  const int verts_num = 200000;
+  for (const int i : IndexRange(verts_num)) {
+    text += "v " + std::to_string(i) + " 0.125 -3\n";
+  }
+  const int faces_num = 100000;
+  for (int i = 0; i < faces_num; i++) {
+    text += "f -1 -2 -3\n";
+  }
+
+  OBJParseResult result;
+  parse_string(text, result);
+  ASSERT_EQ(result.global_vertices.vertices.size(), verts_num);
+  for (const int i : IndexRange(verts_num)) {
+    EXPECT_EQ(result.global_vertices.vertices[i], float3(i, 0.125f, -3.0f));
+  }
+
+  ASSERT_EQ(result.geometries.size(), 1);
+  const Geometry &geometry = *result.geometries[0];
+  EXPECT_EQ(geometry.name, "Big");
+  ASSERT_EQ(geometry.faces.size(), faces_num);
+  for (const FaceElem &face : geometry.faces) {
+    EXPECT_EQ(face.material_index, 0);
+    EXPECT_TRUE(face.shaded_smooth);
+    EXPECT_EQ(geometry.face_corners[face.corner_start].vert_index, verts_num - 1);
+  }
+}
+
+}  // namespace blender::io::obj
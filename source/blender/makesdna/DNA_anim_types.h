@@ -643,6 +643,13 @@ typedef struct FCurve {
   float color[3];
 
   float prev_norm_factor, prev_offset;
+
+  /**
+   * Runtime: index of the keyframe starting the segment that was evaluated last. Used to skip the
+   * keyframe search when the curve is evaluated at nearby times, as during playback.
+   */
+  int eval_segment_hint;
+  char _pad1[4];
 } FCurve;
 
 /* user-editable flags/settings */
@@ -62,6 +62,11 @@ typedef struct CustomDataLayer {
    * automatically.
    */
   const struct AnonymousAttributeID *anonymous_id;
+  /**
+   * Run-time reference counted ownership of #data, set when the array is shared with layers of
+   * other #CustomData (see #CD_SHARE). The array is freed when the last layer releases it.
+   */
+  struct CustomDataSharingInfo *sharing_info;
 } CustomDataLayer;
 
 #define MAX_CUSTOMDATA_LAYER_NAME 64
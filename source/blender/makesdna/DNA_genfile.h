@@ -138,6 +138,22 @@ void *DNA_struct_reconstruct(const struct DNA_ReconstructInfo *reconstruct_info,
                              int old_struct_nr,
                              int blocks,
                              const void *old_blocks);
+/**
+ * Like #DNA_struct_reconstruct, but only converts the elements in range
+ * `[block_start, block_start + blocks)` into an array allocated (and cleared) by the caller.
+ * Ranges don't overlap, so large arrays can be converted by multiple threads.
+ *
+ * \param new_struct_nr: Index of struct info within newsdna.
+ * \param old_blocks: Start of the entire array of old struct data.
+ * \param new_blocks: Start of the entire array to put the converted data in.
+ */
+void DNA_struct_reconstruct_range(const struct DNA_ReconstructInfo *reconstruct_info,
+                                  int old_struct_nr,
+                                  int new_struct_nr,
+                                  int block_start,
+                                  int blocks,
+                                  const void *old_blocks,
+                                  void *new_blocks);
 
 /**
  * Returns the offset of the field with the specified name and type within the specified
@@ -84,6 +84,8 @@ typedef struct Mesh_Runtime {
 
   /** Needed to ensure some thread-safety during render data pre-processing. */
   void *render_mutex;
+  /** Protects building #topology_maps. */
+  void *topology_maps_mutex;
 
   /** Lazily initialized SoA data from the #edit_mesh field in #Mesh. */
   struct EditMeshData *edit_data;
@@ -96,6 +98,11 @@ typedef struct Mesh_Runtime {
 
   /** Cache for derived triangulation of the mesh. */
   struct MLoopTri_Store looptris;
+  /**
+   * Triangulation of the mesh this one was copied from to be deformed, used to skip filling the
+   * n-gons again when calculating #looptris. Defined in 'mesh_runtime.c'.
+   */
+  struct MeshLoopTriReuse *looptris_reuse;
 
   /** Cache for BVH trees generated for the mesh. Defined in 'BKE_bvhutil.c' */
   struct BVHCache *bvh_cache;
@@ -103,6 +110,9 @@ typedef struct Mesh_Runtime {
   /** Cache of non-manifold boundary data for Shrinkwrap Target Project. */
   struct ShrinkwrapBoundaryData *shrinkwrap_data;
 
+  /** Cache of adjacency maps shared by all users of the mesh. Defined in 'mesh_runtime.c'. */
+  struct MeshTopologyMaps *topology_maps;
+
   /** Needed in case we need to lazily initialize the mesh. */
   CustomData_MeshMasks cd_mask_extra;
 
@@ -144,7 +154,9 @@ typedef struct Mesh_Runtime {
    */
   char subsurf_apply_render;
   char subsurf_use_optimal_display;
-  char _pad[2];
+  /** Set by the modifier stack if only deformed from original, before a GPU subdivision. */
+  char subsurf_deformed_only;
+  char _pad[1];
   int subsurf_resolution;
 
 } Mesh_Runtime;
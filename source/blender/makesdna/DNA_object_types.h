@@ -152,6 +152,9 @@ typedef struct Object_Runtime {
   /** Start time of the mode transfer overlay animation. */
   double overlay_mode_transfer_start_time;
 
+  /** Hash of the input and settings #mesh_modifier_cache was computed from. */
+  uint64_t mesh_modifier_cache_key;
+
   /** Axis aligned bound-box (in local-space). */
   struct BoundBox *bb;
 
@@ -208,6 +211,12 @@ typedef struct Object_Runtime {
   /** Runtime evaluated curve-specific data, not stored in the file. */
   struct CurveCache *curve_cache;
 
+  /**
+   * Output of the leading modifiers which only depend on the input mesh and their own settings,
+   * reused while #mesh_modifier_cache_key is unchanged. Not freed with the other derived caches.
+   */
+  struct Mesh *mesh_modifier_cache;
+
   unsigned short local_collections_bits;
   short _pad2[3];
 } Object_Runtime;
@@ -795,7 +795,8 @@ typedef struct UserDef {
   short gp_manhattandist, gp_euclideandist, gp_eraser;
   /** #eGP_UserdefSettings. */
   short gp_settings;
-  char _pad13[4];
+  /** Memory limit for the outputs of geometry nodes cached by all modifiers, in megabytes. */
+  int geometry_nodes_cache_limit;
   struct SolidLight light_param[4];
   float light_ambient[3];
   char gizmo_flag;
@@ -813,7 +814,8 @@ typedef struct UserDef {
   int prefetchframes;
   /** Control the rotation step of the view when PAD2, PAD4, PAD6&PAD8 is use. */
   float pad_rot_angle;
-  char _pad12[4];
+  /** Graphics memory limit for image textures in megabytes, 0 for no limit. */
+  int texmemlimit;
   /** Rotating view icon size. */
   short rvisize;
   /** Rotating view icon brightness. */
@@ -944,7 +946,7 @@ typedef struct UserDef {
 
   float collection_instance_empty_size;
   char text_flag;
-  char _pad10[1];
+  char sequencer_flag; /* eUserpref_SeqFlag */
 
   char file_preview_type; /* eUserpref_File_Preview_Type */
   char statusbar_flag;    /* eUserpref_StatusBar_Flag */
@@ -1029,6 +1031,7 @@ typedef enum eUserPref_Flag {
   USER_TXT_TABSTOSPACES_DISABLE = (1 << 25),
   USER_TOOLTIPS_PYTHON = (1 << 26),
   USER_FLAG_UNUSED_27 = (1 << 27), /* dirty */
+  USER_GEOMETRY_NODES_CACHE_DISABLE = (1 << 28),
 } eUserPref_Flag;
 
 /** #UserDef.file_preview_type */
@@ -1436,6 +1439,12 @@ typedef enum eUserpref_SeqProxySetup {
   USER_SEQ_PROXY_SETUP_AUTOMATIC = 1,
 } eUserpref_SeqProxySetup;
 
+/** #UserDef.sequencer_flag */
+typedef enum eUserpref_SeqFlag {
+  USER_SEQ_HW_DECODE = (1 << 0),
+  USER_SEQ_CACHE_COMPRESS = (1 << 1),
+} eUserpref_SeqFlag;
+
 /* Locale Ids. Auto will try to get local from OS. Our default is English though. */
 /** #UserDef.language */
 enum {
@@ -1229,6 +1229,28 @@ void *DNA_struct_reconstruct(const DNA_ReconstructInfo *reconstruct_info,
   return new_blocks;
 }
 
+void DNA_struct_reconstruct_range(const DNA_ReconstructInfo *reconstruct_info,
+                                  int old_struct_nr,
+                                  int new_struct_nr,
+                                  int block_start,
+                                  int blocks,
+                                  const void *old_blocks,
+                                  void *new_blocks)
+{
+  const SDNA_Struct *old_struct = reconstruct_info->oldsdna->structs[old_struct_nr];
+  const SDNA_Struct *new_struct = reconstruct_info->newsdna->structs[new_struct_nr];
+
+  const size_t old_block_size = (size_t)reconstruct_info->oldsdna->types_size[old_struct->type];
+  const size_t new_block_size = (size_t)reconstruct_info->newsdna->types_size[new_struct->type];
+
+  reconstruct_structs(reconstruct_info,
+                      blocks,
+                      old_struct_nr,
+                      new_struct_nr,
+                      (const char *)old_blocks + (size_t)block_start * old_block_size,
+                      (char *)new_blocks + (size_t)block_start * new_block_size);
+}
+
 /** Finds a member in the given struct with the given name. */
 static const SDNA_StructMember *find_member_with_matching_name(const SDNA *sdna,
                                                                const SDNA_Struct *struct_info,
@@ -4306,6 +4306,26 @@ static int rna_property_array_length_all_dimensions(PointerRNA *ptr, PropertyRNA
   return size;
 }
 
+/**
+ * Whether #rna_raw_access can convert between raw types without the RNA accessors. Getters of raw
+ * integer and float properties return the value as is, setters also clamp it to the hard range.
+ */
+static bool rna_raw_access_convert_supported(PropertyRNA *prop, const bool set)
+{
+  switch (prop->type) {
+    case PROP_INT: {
+      IntPropertyRNA *iprop = (IntPropertyRNA *)prop;
+      return !set || (iprop->hardmin == INT_MIN && iprop->hardmax == INT_MAX && !iprop->range);
+    }
+    case PROP_FLOAT: {
+      FloatPropertyRNA *fprop = (FloatPropertyRNA *)prop;
+      return !set || (fprop->hardmin == -FLT_MAX && fprop->hardmax == FLT_MAX && !fprop->range);
+    }
+    default:
+      return false;
+  }
+}
+
 static int rna_raw_access(ReportList *reports,
                           PointerRNA *ptr,
                           PropertyRNA *prop,
@@ -4373,6 +4393,17 @@ static int rna_raw_access(ReportList *reports,
 
         size = RNA_raw_type_sizeof(out.type) * arraylen;
 
+        /* The items only contain this property, copy them all at once. */
+        if (out.stride == size) {
+          if (set) {
+            memcpy(outp, inp, (size_t)size * out.len);
+          }
+          else {
+            memcpy(inp, outp, (size_t)size * out.len);
+          }
+          return 1;
+        }
+
         for (a = 0; a < out.len; a++) {
           if (set) {
             memcpy(outp, inp, size);
@@ -4388,8 +4419,42 @@ static int rna_raw_access(ReportList *reports,
         return 1;
       }
 
-      /* Could also be faster with non-matching types,
-       * for now we just do slower loop. */
+      /* Non-matching types, convert directly between the raw arrays when the accessors would do
+       * nothing more than assigning the value. */
+      if (rna_raw_access_convert_supported(itemprop, set)) {
+        int i = 0;
+        for (int a = 0; a < out.len; a++) {
+          RawArray item = out;
+          item.array = (char *)out.array + (size_t)out.stride * a;
+
+          for (int j = 0; j < arraylen; j++, i++) {
+            if (itemtype == PROP_INT) {
+              int value;
+              if (set) {
+                RAW_GET(int, value, in, i);
+                RAW_SET(int, item, j, value);
+              }
+              else {
+                RAW_GET(int, value, item, j);
+                RAW_SET(int, in, i, value);
+              }
+            }
+            else {
+              float value;
+              if (set) {
+                RAW_GET(float, value, in, i);
+                RAW_SET(float, item, j, value);
+              }
+              else {
+                RAW_GET(float, value, item, j);
+                RAW_SET(float, in, i, value);
+              }
+            }
+          }
+        }
+
+        return 1;
+      }
     }
   }
 
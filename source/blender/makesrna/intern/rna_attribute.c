@@ -254,6 +254,8 @@ static void rna_Attribute_data_begin(CollectionPropertyIterator *iter, PointerRN
       break;
   }
 
+  /* The data can be written through the iterator. */
+  CustomData_layer_ensure_unshared(layer);
   rna_iterator_array_begin(iter, layer->data, struct_size, length, 0, NULL);
 }
 
@@ -254,6 +254,25 @@ static void rna_Depsgraph_debug_stats_gnuplot(Depsgraph *depsgraph,
   fclose(f);
 }
 
+static void rna_Depsgraph_debug_trace_begin(Depsgraph *depsgraph,
+                                           float frame_start,
+                                           float frame_end)
+{
+  DEG_debug_trace_begin(depsgraph, frame_start, frame_end);
+}
+
+static void rna_Depsgraph_debug_trace_end(Depsgraph *depsgraph, const char *filename)
+{
+  if (filename[0] != '\0') {
+    FILE *f = fopen(filename, "w");
+    if (f != NULL) {
+      DEG_debug_trace_write(depsgraph, f);
+      fclose(f);
+    }
+  }
+  DEG_debug_trace_end(depsgraph);
+}
+
 static void rna_Depsgraph_debug_tag_update(Depsgraph *depsgraph)
 {
   DEG_graph_tag_relations_update(depsgraph);
@@ -667,6 +686,36 @@ static void rna_def_depsgraph(BlenderRNA *brna)
                                   "File name where gnuplot script will save the result");
   RNA_def_parameter_flags(parm, 0, PARM_REQUIRED);
 
+  func = RNA_def_function(srna, "debug_trace_begin", "rna_Depsgraph_debug_trace_begin");
+  RNA_def_function_ui_description(
+      func, "Start recording a timeline of the evaluated operations of the given frame range");
+  parm = RNA_def_float(func,
+                       "frame_start",
+                       0.0f,
+                       -FLT_MAX,
+                       FLT_MAX,
+                       "Start",
+                       "First recorded frame",
+                       -FLT_MAX,
+                       FLT_MAX);
+  RNA_def_parameter_flags(parm, 0, PARM_REQUIRED);
+  parm = RNA_def_float(func,
+                       "frame_end",
+                       0.0f,
+                       -FLT_MAX,
+                       FLT_MAX,
+                       "End",
+                       "Last recorded frame",
+                       -FLT_MAX,
+                       FLT_MAX);
+  RNA_def_parameter_flags(parm, 0, PARM_REQUIRED);
+
+  func = RNA_def_function(srna, "debug_trace_end", "rna_Depsgraph_debug_trace_end");
+  RNA_def_function_ui_description(
+      func, "Stop recording the evaluation timeline, optionally saving it as Chrome trace JSON");
+  RNA_def_string_file_path(
+      func, "filename", NULL, FILE_MAX, "File Name", "Output path for the trace file (optional)");
+
   func = RNA_def_function(srna, "debug_tag_update", "rna_Depsgraph_debug_tag_update");
 
   func = RNA_def_function(srna, "debug_stats", "rna_Depsgraph_debug_stats");
@@ -5747,6 +5747,16 @@ static void rna_def_scene_ffmpeg_settings(BlenderRNA *brna)
   RNA_def_property_ui_text(prop, "Use Max B-Frames", "Set a maximum number of B-frames");
   RNA_def_property_update(prop, NC_SCENE | ND_RENDER_OPTIONS, NULL);
 
+  prop = RNA_def_property(srna, "use_hardware_encoder", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "flags", FFMPEG_USE_HARDWARE_ENCODER);
+  RNA_def_property_clear_flag(prop, PROP_ANIMATABLE);
+  RNA_def_property_ui_text(prop,
+                           "Hardware Encoder",
+                           "Encode with the GPU when a hardware encoder for the codec is "
+                           "available (NVENC, Quick Sync, AMF or VideoToolbox), falling back to "
+                           "the software encoder otherwise");
+  RNA_def_property_update(prop, NC_SCENE | ND_RENDER_OPTIONS, NULL);
+
   prop = RNA_def_property(srna, "buffersize", PROP_INT, PROP_NONE);
   RNA_def_property_int_sdna(prop, NULL, "rc_buffer_size");
   RNA_def_property_clear_flag(prop, PROP_ANIMATABLE);
@@ -111,7 +111,7 @@ static void createFacepa(ExplodeModifierData *emd, ParticleSystemModifierData *p
   ParticleData *pa;
   KDTree_3d *tree;
   RNG *rng;
-  float center[3], co[3];
+  float co[3];
   int *facepa = NULL, *vertpa = NULL, totvert = 0, totface = 0, totpart = 0;
   int i, p, v1, v2, v3, v4 = 0;
   const bool invert_vgroup = (emd->flag & eExplodeFlag_INVERT_VGROUP) != 0;
@@ -174,19 +174,28 @@ static void createFacepa(ExplodeModifierData *emd, ParticleSystemModifierData *p
   }
   BLI_kdtree_3d_balance(tree);
 
-  /* set face-particle-indexes to nearest particle to face center */
+  /* Find the nearest particle to all face centers at once, the assignment below depends on the
+   * order of the faces so it is done afterwards. */
+  float(*centers)[3] = MEM_malloc_arrayN(totface, sizeof(*centers), __func__);
+  int *nearest_particles = MEM_malloc_arrayN(totface, sizeof(*nearest_particles), __func__);
   for (i = 0, fa = mface; i < totface; i++, fa++) {
-    add_v3_v3v3(center, mvert[fa->v1].co, mvert[fa->v2].co);
-    add_v3_v3(center, mvert[fa->v3].co);
+    add_v3_v3v3(centers[i], mvert[fa->v1].co, mvert[fa->v2].co);
+    add_v3_v3(centers[i], mvert[fa->v3].co);
     if (fa->v4) {
-      add_v3_v3(center, mvert[fa->v4].co);
-      mul_v3_fl(center, 0.25);
+      add_v3_v3(centers[i], mvert[fa->v4].co);
+      mul_v3_fl(centers[i], 0.25);
     }
     else {
-      mul_v3_fl(center, 1.0f / 3.0f);
+      mul_v3_fl(centers[i], 1.0f / 3.0f);
     }
+  }
+  BLI_kdtree_3d_find_nearest_batch(
+      tree, (const float(*)[3])centers, (uint)totface, nearest_particles, NULL);
+  MEM_freeN(centers);
 
-    p = BLI_kdtree_3d_find_nearest(tree, center, NULL);
+  /* set face-particle-indexes to nearest particle to face center */
+  for (i = 0, fa = mface; i < totface; i++, fa++) {
+    p = nearest_particles[i];
 
     v1 = vertpa[fa->v1];
     v2 = vertpa[fa->v2];
@@ -213,6 +222,7 @@ static void createFacepa(ExplodeModifierData *emd, ParticleSystemModifierData *p
     }
   }
 
+  MEM_freeN(nearest_particles);
   if (vertpa) {
     MEM_freeN(vertpa);
   }
@@ -85,6 +85,7 @@
 
 #include "MOD_modifiertypes.h"
 #include "MOD_nodes.h"
+#include "MOD_nodes_cache.hh"
 #include "MOD_nodes_evaluator.hh"
 #include "MOD_ui_common.h"
 
@@ -115,6 +116,7 @@ using blender::StringRef;
 using blender::StringRefNull;
 using blender::Vector;
 using blender::bke::OutputAttribute;
+using blender::modifiers::geometry_nodes::NodeOutputsCache;
 using blender::fn::Field;
 using blender::fn::GField;
 using blender::fn::GMutablePointer;
@@ -1038,6 +1040,17 @@ static GeometrySet compute_geometry(const DerivedNodeTree &tree,
   eval_params.depsgraph = ctx->depsgraph;
   eval_params.self_object = ctx->object;
   eval_params.geo_logger = geo_logger.has_value() ? &*geo_logger : nullptr;
+  /* The runtime data of the evaluated modifier is kept when the depsgraph updates it. */
+  if (NodeOutputsCache::is_enabled()) {
+    if (nmd->modifier.runtime == nullptr) {
+      nmd->modifier.runtime = new NodeOutputsCache();
+    }
+    eval_params.cache = static_cast<NodeOutputsCache *>(nmd->modifier.runtime);
+  }
+  else if (nmd->modifier.runtime != nullptr) {
+    delete static_cast<NodeOutputsCache *>(nmd->modifier.runtime);
+    nmd->modifier.runtime = nullptr;
+  }
   blender::modifiers::geometry_nodes::evaluate_geometry_nodes(eval_params);
 
   GeometrySet output_geometry_set = eval_params.r_output_values[0].relocate_out<GeometrySet>();
@@ -1575,6 +1588,11 @@ static void copyData(const ModifierData *md, ModifierData *target, const int fla
   }
 }
 
+static void freeRuntimeData(void *runtime_data)
+{
+  delete static_cast<NodeOutputsCache *>(runtime_data);
+}
+
 static void freeData(ModifierData *md)
 {
   NodesModifierData *nmd = reinterpret_cast<NodesModifierData *>(md);
@@ -1584,6 +1602,10 @@ static void freeData(ModifierData *md)
   }
 
   clear_runtime_data(nmd);
+  if (md->runtime != nullptr) {
+    freeRuntimeData(md->runtime);
+    md->runtime = nullptr;
+  }
 }
 
 static void requiredDataMask(Object *UNUSED(ob),
@@ -1628,7 +1650,7 @@ ModifierTypeInfo modifierType_Nodes = {
     /* dependsOnNormals */ nullptr,
     /* foreachIDLink */ foreachIDLink,
     /* foreachTexLink */ foreachTexLink,
-    /* freeRuntimeData */ nullptr,
+    /* freeRuntimeData */ freeRuntimeData,
     /* panelRegister */ panelRegister,
     /* blendWrite */ blendWrite,
     /* blendRead */ blendRead,
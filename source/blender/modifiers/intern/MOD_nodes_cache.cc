@@ -0,0 +1,379 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/** \file
+ * \ingroup modifiers
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+#include "MEM_guardedalloc.h"
+
+#include "MOD_nodes_cache.hh"
+
+#include "BKE_geometry_set.hh"
+
+#include "DNA_node_types.h"
+#include "DNA_userdef_types.h"
+
+#include "FN_field_cpp_type.hh"
+
+#include "BLI_hash.hh"
+
+namespace blender::modifiers::geometry_nodes {
+
+using fn::ValueOrFieldCPPType;
+
+/** Approximate size of the geometry cached by all modifiers. */
+static std::atomic<int64_t> global_memory_usage = 0;
+
+static GMutablePointer copy_value(const GPointer value)
+{
+  const CPPType &type = *value.type();
+  void *buffer = MEM_mallocN_aligned(type.size(), type.alignment(), __func__);
+  type.copy_construct(value.get(), buffer);
+  return {type, buffer};
+}
+
+static void free_value(GMutablePointer value)
+{
+  if (value.get() != nullptr) {
+    value.destruct();
+    MEM_freeN(value.get());
+  }
+}
+
+static bool is_geometry_type(const CPPType &type)
+{
+  return type == CPPType::get<GeometrySet>();
+}
+
+static uint64_t hash_value(const GPointer value)
+{
+  const CPPType &type = *value.type();
+  if (is_geometry_type(type)) {
+    uint64_t hash = 0;
+    for (const GeometryComponent *component :
+         static_cast<const GeometrySet *>(value.get())->get_components_for_read()) {
+      hash = hash * 33 ^ get_default_hash(component);
+    }
+    return hash;
+  }
+  if (const ValueOrFieldCPPType *value_or_field_type = dynamic_cast<const ValueOrFieldCPPType *>(
+          &type)) {
+    return value_or_field_type->base_type().hash(
+        value_or_field_type->get_value_ptr(value.get()));
+  }
+  return type.hash(value.get());
+}
+
+static bool values_equal(const GPointer a, const GPointer b)
+{
+  const CPPType &type = *a.type();
+  if (type != *b.type()) {
+    return false;
+  }
+  if (is_geometry_type(type)) {
+    return static_cast<const GeometrySet *>(a.get())->get_components_for_read() ==
+           static_cast<const GeometrySet *>(b.get())->get_components_for_read();
+  }
+  if (const ValueOrFieldCPPType *value_or_field_type = dynamic_cast<const ValueOrFieldCPPType *>(
+          &type)) {
+    return value_or_field_type->base_type().is_equal(
+        value_or_field_type->get_value_ptr(a.get()), value_or_field_type->get_value_ptr(b.get()));
+  }
+  return type.is_equal(a.get(), b.get());
+}
+
+/**
+ * Only the attributes are taken into account, which is good enough to keep the memory usage of
+ * the cache in check.
+ */
+static int64_t estimate_geometry_size(const GeometrySet &geometry_set)
+{
+  int64_t size = 0;
+  for (const GeometryComponent *component : geometry_set.get_components_for_read()) {
+    component->attribute_foreach(
+        [&](const bke::AttributeIDRef &UNUSED(attribute_id), const AttributeMetaData &meta_data) {
+          if (const CPPType *type = bke::custom_data_type_to_cpp_type(meta_data.data_type)) {
+            size += type->size() * component->attribute_domain_size(meta_data.domain);
+          }
+          return true;
+        });
+  }
+  return size;
+}
+
+NodeOutputsCacheKey::NodeOutputsCacheKey(const bNode &bnode) : node_type_(bnode.typeinfo)
+{
+  this->append_properties(&bnode.custom1, sizeof(bnode.custom1));
+  this->append_properties(&bnode.custom2, sizeof(bnode.custom2));
+  this->append_properties(&bnode.custom3, sizeof(bnode.custom3));
+  this->append_properties(&bnode.custom4, sizeof(bnode.custom4));
+  if (bnode.storage != nullptr) {
+    /* Node storage only contains settings, so comparing its bytes is enough. */
+    this->append_properties(bnode.storage, int64_t(MEM_allocN_len(bnode.storage)));
+  }
+}
+
+NodeOutputsCacheKey::~NodeOutputsCacheKey()
+{
+  for (GMutablePointer value : inputs_) {
+    free_value(value);
+  }
+}
+
+void NodeOutputsCacheKey::append_properties(const void *data, const int64_t size)
+{
+  properties_.extend(Span<char>(static_cast<const char *>(data), size));
+}
+
+bool operator==(const NodeOutputsCacheKey &a, const NodeOutputsCacheKey &b)
+{
+  if (a.hash_ != b.hash_ || a.node_type_ != b.node_type_ || a.properties_ != b.properties_ ||
+      a.inputs_.size() != b.inputs_.size()) {
+    return false;
+  }
+  for (const int i : a.inputs_.index_range()) {
+    if (!values_equal(a.inputs_[i], b.inputs_[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+NodeOutputsCache::~NodeOutputsCache()
+{
+  this->clear();
+}
+
+bool NodeOutputsCache::is_enabled()
+{
+  return (U.flag & USER_GEOMETRY_NODES_CACHE_DISABLE) == 0;
+}
+
+int64_t NodeOutputsCache::memory_budget()
+{
+  return int64_t(U.geometry_nodes_cache_limit) * 1024 * 1024;
+}
+
+bool NodeOutputsCache::geometry_is_cached(const GeometrySet &geometry_set) const
+{
+  for (const GeometryComponent *component : geometry_set.get_components_for_read()) {
+    if (!cached_components_.contains(component)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::optional<NodeOutputsCacheKey> NodeOutputsCache::try_build_key(
+    const bNode &bnode, const Span<Vector<GPointer>> input_values)
+{
+  /* Check all values before copying any, so that no references to geometry that is not cached
+   * are added. */
+  {
+    std::lock_guard lock{mutex_};
+    for (const Span<GPointer> values : input_values) {
+      for (const GPointer value : values) {
+        const CPPType &type = *value.type();
+        if (is_geometry_type(type)) {
+          if (!this->geometry_is_cached(*static_cast<const GeometrySet *>(value.get()))) {
+            return std::nullopt;
+          }
+        }
+        else if (const ValueOrFieldCPPType *value_or_field_type =
+                     dynamic_cast<const ValueOrFieldCPPType *>(&type)) {
+          /* Fields are built again in every evaluation, so they would never be equal. */
+          if (value_or_field_type->is_field(value.get())) {
+            return std::nullopt;
+          }
+        }
+        else if (!type.is_hashable() || !type.is_equality_comparable()) {
+          return std::nullopt;
+        }
+      }
+    }
+  }
+
+  NodeOutputsCacheKey key{bnode};
+  for (const Span<GPointer> values : input_values) {
+    const int64_t values_num = values.size();
+    key.append_properties(&values_num, sizeof(values_num));
+    for (const GPointer value : values) {
+      key.inputs_.append(copy_value(value));
+    }
+  }
+
+  uint64_t hash = get_default_hash_2(key.node_type_, key.properties_.size());
+  for (const char c : key.properties_) {
+    hash = hash * 33 ^ uint64_t(c);
+  }
+  for (const GMutablePointer value : key.inputs_) {
+    hash = hash * 33 ^ hash_value(value);
+  }
+  key.hash_ = hash;
+  return key;
+}
+
+bool NodeOutputsCache::lookup(const NodeOutputsCacheKey &key,
+                             FunctionRef<bool(Span<GPointer> outputs)> fn)
+{
+  std::lock_guard lock{mutex_};
+  for (Entry *entry : entries_by_hash_.lookup(key.hash())) {
+    if (entry->key == key) {
+      Vector<GPointer> outputs;
+      for (const GMutablePointer value : entry->outputs) {
+        outputs.append(value);
+      }
+      if (!fn(outputs)) {
+        return false;
+      }
+      entry->last_used = ++usage_counter_;
+      return true;
+    }
+  }
+  return false;
+}
+
+void NodeOutputsCache::add(NodeOutputsCacheKey key, const Span<GPointer> outputs)
+{
+  int64_t memory_size = 0;
+  for (const GPointer value : outputs) {
+    if (value.get() != nullptr && is_geometry_type(*value.type())) {
+      const GeometrySet &geometry_set = *value.get<GeometrySet>();
+      if (!geometry_set.owns_direct_data()) {
+        /* The data might be freed while it is still in the cache. */
+        return;
+      }
+      memory_size += estimate_geometry_size(geometry_set);
+    }
+  }
+  const int64_t memory_budget = NodeOutputsCache::memory_budget();
+  if (memory_size > memory_budget) {
+    return;
+  }
+
+  std::lock_guard lock{mutex_};
+
+  /* Replace an existing entry for the same key, it might have fewer computed outputs. */
+  const NodeOutputsCacheKey &key_ref = key;
+  this->remove_entries_if([&](const Entry &entry) { return entry.key == key_ref; });
+
+  if (global_memory_usage + memory_size > memory_budget) {
+    /* Keep the most recently used entries that fit into the budget together with the new one and
+     * the entries of other caches. */
+    Vector<const Entry *> sorted_entries;
+    for (const std::unique_ptr<Entry> &entry : entries_) {
+      sorted_entries.append(entry.get());
+    }
+    std::sort(sorted_entries.begin(),
+              sorted_entries.end(),
+              [](const Entry *a, const Entry *b) { return a->last_used > b->last_used; });
+    int64_t kept_memory = global_memory_usage - memory_usage_ + memory_size;
+    uint64_t newest_removed_usage = 0;
+    for (const Entry *entry : sorted_entries) {
+      kept_memory += entry->memory_size;
+      if (kept_memory > memory_budget) {
+        newest_removed_usage = entry->last_used;
+        break;
+      }
+    }
+    this->remove_entries_if(
+        [&](const Entry &entry) { return entry.last_used <= newest_removed_usage; });
+    if (global_memory_usage + memory_size > memory_budget) {
+      /* The budget is used by other caches. */
+      return;
+    }
+  }
+
+  Vector<GMutablePointer> output_copies;
+  for (const GPointer value : outputs) {
+    output_copies.append(value.get() == nullptr ? GMutablePointer() : copy_value(value));
+  }
+  std::unique_ptr<Entry> entry = std::make_unique<Entry>(
+      Entry{std::move(key), std::move(output_copies), memory_size, ++usage_counter_});
+  for (const GMutablePointer value : entry->outputs) {
+    if (value.get() != nullptr && is_geometry_type(*value.type())) {
+      for (const GeometryComponent *component : value.get<GeometrySet>()->get_components_for_read()) {
+        cached_components_.lookup_or_add(component, 0)++;
+      }
+    }
+  }
+  memory_usage_ += memory_size;
+  global_memory_usage += memory_size;
+  entries_by_hash_.add(entry->key.hash(), entry.get());
+  entries_.append(std::move(entry));
+}
+
+void NodeOutputsCache::remove_entries_if(FunctionRef<bool(const Entry &entry)> predicate)
+{
+  bool removed_any = false;
+  for (int64_t i = entries_.size() - 1; i >= 0; i--) {
+    Entry &entry = *entries_[i];
+    if (!predicate(entry)) {
+      continue;
+    }
+    for (GMutablePointer value : entry.outputs) {
+      if (value.get() == nullptr) {
+        continue;
+      }
+      if (is_geometry_type(*value.type())) {
+        for (const GeometryComponent *component :
+             value.get<GeometrySet>()->get_components_for_read()) {
+          int &users = cached_components_.lookup(component);
+          users--;
+          if (users == 0) {
+            cached_components_.remove(component);
+          }
+        }
+      }
+      free_value(value);
+    }
+    memory_usage_ -= entry.memory_size;
+    global_memory_usage -= entry.memory_size;
+    entries_.remove_and_reorder(i);
+    removed_any = true;
+  }
+  if (removed_any) {
+    entries_by_hash_ = {};
+    for (const std::unique_ptr<Entry> &entry : entries_) {
+      entries_by_hash_.add(entry->key.hash(), entry.get());
+    }
+  }
+}
+
+void NodeOutputsCache::begin_evaluation()
+{
+  std::lock_guard lock{mutex_};
+  evaluation_start_ = usage_counter_;
+}
+
+void NodeOutputsCache::end_evaluation()
+{
+  std::lock_guard lock{mutex_};
+  this->remove_entries_if([&](const Entry &entry) { return entry.last_used <= evaluation_start_; });
+}
+
+void NodeOutputsCache::clear()
+{
+  std::lock_guard lock{mutex_};
+  this->remove_entries_if([](const Entry &UNUSED(entry)) { return true; });
+}
+
+}  // namespace blender::modifiers::geometry_nodes
@@ -0,0 +1,155 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#pragma once
+
+/** \file
+ * \ingroup modifiers
+ *
+ * Outputs of geometry nodes are cached across evaluations of the same modifier. When a node gets
+ * the same inputs as in a previous evaluation and its properties did not change, its previous
+ * outputs are reused. This way only the parts of a node tree that depend on e.g. the scene time
+ * are executed again when the frame changes.
+ *
+ * Geometry inputs are compared by the identity of their components. That is only correct when the
+ * components can't be modified in place, so geometry is only used in keys when all its components
+ * are already referenced by the cache, i.e. when they have been output by another cached node.
+ * This also avoids that keys keep references to geometry that would otherwise be modified in
+ * place.
+ *
+ * The caches of all modifiers share the memory limit from the user preferences, where caching
+ * can also be disabled.
+ */
+
+#include <memory>
+#include <mutex>
+#include <optional>
+
+#include "BLI_function_ref.hh"
+#include "BLI_map.hh"
+#include "BLI_multi_value_map.hh"
+#include "BLI_utility_mixins.hh"
+#include "BLI_vector.hh"
+
+#include "FN_generic_pointer.hh"
+
+struct bNode;
+struct bNodeType;
+class GeometryComponent;
+struct GeometrySet;
+
+namespace blender::modifiers::geometry_nodes {
+
+using fn::CPPType;
+using fn::GMutablePointer;
+using fn::GPointer;
+
+class NodeOutputsCacheKey : NonCopyable {
+ private:
+  const bNodeType *node_type_;
+  /** Node properties and the number of values passed to every input. */
+  Vector<char> properties_;
+  /** Owned copies of the input values. */
+  Vector<GMutablePointer> inputs_;
+  uint64_t hash_ = 0;
+
+  friend class NodeOutputsCache;
+
+ public:
+  NodeOutputsCacheKey(const bNode &bnode);
+  NodeOutputsCacheKey(NodeOutputsCacheKey &&other) = default;
+  ~NodeOutputsCacheKey();
+
+  uint64_t hash() const
+  {
+    return hash_;
+  }
+
+  friend bool operator==(const NodeOutputsCacheKey &a, const NodeOutputsCacheKey &b);
+
+ private:
+  void append_properties(const void *data, int64_t size);
+};
+
+class NodeOutputsCache : NonCopyable, NonMovable {
+ private:
+  struct Entry {
+    NodeOutputsCacheKey key;
+    /** Owned copies of the outputs, null for outputs that have not been computed. */
+    Vector<GMutablePointer> outputs;
+    int64_t memory_size = 0;
+    uint64_t last_used = 0;
+  };
+
+  std::mutex mutex_;
+  /** Approximate size of the geometry cached here, part of the usage of all caches. */
+  int64_t memory_usage_ = 0;
+  /** Incremented whenever an entry is used, to find the least recently used entries. */
+  uint64_t usage_counter_ = 0;
+  uint64_t evaluation_start_ = 0;
+  Vector<std::unique_ptr<Entry>> entries_;
+  MultiValueMap<uint64_t, Entry *> entries_by_hash_;
+  /** Number of cached outputs that reference each geometry component. */
+  Map<const GeometryComponent *, int> cached_components_;
+
+ public:
+  NodeOutputsCache() = default;
+  ~NodeOutputsCache();
+
+  /** Whether caching is enabled in the user preferences. */
+  static bool is_enabled();
+  /** Upper bound for the approximate size of the geometry cached by all modifiers. */
+  static int64_t memory_budget();
+
+  /**
+   * Build the key for a node, based on its properties and the values passed to each of its
+   * inputs (which may be empty for unused inputs). None is returned when the outputs of the node
+   * can't be cached for these inputs.
+   */
+  std::optional<NodeOutputsCacheKey> try_build_key(const bNode &bnode,
+                                                   Span<Vector<GPointer>> input_values);
+
+  /**
+   * Find the outputs that have been cached for the key. When they exist, \a fn is called with
+   * them while the cache is locked, so it should only copy the values it needs. Return false from
+   * it when the cached outputs are not sufficient.
+   */
+  bool lookup(const NodeOutputsCacheKey &key, FunctionRef<bool(Span<GPointer> outputs)> fn);
+
+  /**
+   * Cache copies of the outputs of the node, outputs that have not been computed are null.
+   * Least recently used entries of this cache are removed when the memory budget is exceeded.
+   * Nothing is cached when the other caches use the budget already.
+   */
+  void add(NodeOutputsCacheKey key, Span<GPointer> outputs);
+
+  /** Called before the node tree is evaluated. */
+  void begin_evaluation();
+  /**
+   * Called after the node tree has been evaluated. Entries that have not been used during the
+   * evaluation are removed, they are likely from an older version of the node tree or a frame
+   * that is not displayed anymore.
+   */
+  void end_evaluation();
+
+  void clear();
+
+ private:
+  bool geometry_is_cached(const GeometrySet &geometry_set) const;
+  void remove_entries_if(FunctionRef<bool(const Entry &entry)> predicate);
+};
+
+}  // namespace blender::modifiers::geometry_nodes
@@ -0,0 +1,182 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include "testing/testing.h"
+
+#include "MOD_nodes_cache.hh"
+
+#include "BKE_geometry_set.hh"
+#include "BKE_idtype.h"
+#include "BKE_mesh.h"
+#include "BKE_node.h"
+
+#include "DNA_node_types.h"
+#include "DNA_userdef_types.h"
+
+namespace blender::modifiers::geometry_nodes::tests {
+
+class NodeOutputsCacheTest : public testing::Test {
+ protected:
+  bNodeType node_type_{};
+  bNode bnode_{};
+  int cache_limit_;
+
+  void SetUp() override
+  {
+    BKE_idtype_init();
+    bnode_.typeinfo = &node_type_;
+    cache_limit_ = U.geometry_nodes_cache_limit;
+    U.geometry_nodes_cache_limit = 256;
+  }
+
+  void TearDown() override
+  {
+    U.geometry_nodes_cache_limit = cache_limit_;
+  }
+
+  std::optional<NodeOutputsCacheKey> build_key(NodeOutputsCache &cache, int input)
+  {
+    Vector<Vector<GPointer>> input_values = {{GPointer(CPPType::get<int>(), &input)}};
+    return cache.try_build_key(bnode_, input_values);
+  }
+
+  /** Add an entry with a single output for an integer input. */
+  template<typename T> void add(NodeOutputsCache &cache, const int input, T output)
+  {
+    std::optional<NodeOutputsCacheKey> key = this->build_key(cache, input);
+    ASSERT_TRUE(key.has_value());
+    const Vector<GPointer> outputs = {GPointer(CPPType::get<T>(), &output)};
+    cache.add(std::move(*key), outputs);
+  }
+
+  /** \return The cached float output for the input, or none when there is no entry. */
+  std::optional<float> lookup_float(NodeOutputsCache &cache, const int input)
+  {
+    std::optional<NodeOutputsCacheKey> key = this->build_key(cache, input);
+    if (!key.has_value()) {
+      return std::nullopt;
+    }
+    std::optional<float> result;
+    cache.lookup(*key, [&](Span<GPointer> outputs) {
+      result = *outputs[0].get<float>();
+      return true;
+    });
+    return result;
+  }
+
+  bool lookup_geometry(NodeOutputsCache &cache, const int input)
+  {
+    std::optional<NodeOutputsCacheKey> key = this->build_key(cache, input);
+    return key.has_value() && cache.lookup(*key, [](Span<GPointer> UNUSED(outputs)) {
+      return true;
+    });
+  }
+};
+
+static GeometrySet create_mesh_geometry(const int verts_num)
+{
+  return GeometrySet::create_with_mesh(BKE_mesh_new_nomain(verts_num, 0, 0, 0, 0));
+}
+
+TEST_F(NodeOutputsCacheTest, hit)
+{
+  NodeOutputsCache cache;
+  cache.begin_evaluation();
+  this->add(cache, 2, 4.0f);
+  this->add(cache, 3, 9.0f);
+  cache.end_evaluation();
+
+  cache.begin_evaluation();
+  EXPECT_EQ(this->lookup_float(cache, 2), 4.0f);
+  EXPECT_EQ(this->lookup_float(cache, 3), 9.0f);
+  cache.end_evaluation();
+}
+
+TEST_F(NodeOutputsCacheTest, invalidate_changed_inputs_and_properties)
+{
+  NodeOutputsCache cache;
+  cache.begin_evaluation();
+  this->add(cache, 2, 4.0f);
+  EXPECT_FALSE(this->lookup_float(cache, 5).has_value());
+
+  bnode_.custom1 = 1;
+  EXPECT_FALSE(this->lookup_float(cache, 2).has_value());
+  bnode_.custom1 = 0;
+  EXPECT_EQ(this->lookup_float(cache, 2), 4.0f);
+  cache.end_evaluation();
+}
+
+TEST_F(NodeOutputsCacheTest, remove_unused_entries)
+{
+  NodeOutputsCache cache;
+  cache.begin_evaluation();
+  this->add(cache, 2, 4.0f);
+  this->add(cache, 3, 9.0f);
+  cache.end_evaluation();
+
+  /* Only the used entry is kept after the evaluation. */
+  cache.begin_evaluation();
+  EXPECT_EQ(this->lookup_float(cache, 3), 9.0f);
+  cache.end_evaluation();
+
+  cache.begin_evaluation();
+  EXPECT_FALSE(this->lookup_float(cache, 2).has_value());
+  EXPECT_EQ(this->lookup_float(cache, 3), 9.0f);
+  cache.end_evaluation();
+}
+
+TEST_F(NodeOutputsCacheTest, uncached_geometry_input)
+{
+  NodeOutputsCache cache;
+  GeometrySet geometry_set = create_mesh_geometry(4);
+  Vector<Vector<GPointer>> input_values = {
+      {GPointer(CPPType::get<GeometrySet>(), &geometry_set)}};
+  /* Geometry can only be compared when it is not modified in place, i.e. owned by the cache. */
+  EXPECT_FALSE(cache.try_build_key(bnode_, input_values).has_value());
+}
+
+TEST_F(NodeOutputsCacheTest, memory_budget)
+{
+  /* Only positions are stored for meshes without faces, 12 bytes per vertex. */
+  U.geometry_nodes_cache_limit = 1;
+  NodeOutputsCache cache_a;
+  NodeOutputsCache cache_b;
+
+  /* Geometry larger than the budget isn't cached at all. */
+  cache_a.begin_evaluation();
+  this->add(cache_a, 1, create_mesh_geometry(200000));
+  EXPECT_FALSE(this->lookup_geometry(cache_a, 1));
+
+  /* The budget is shared by the caches of all modifiers. */
+  this->add(cache_a, 2, create_mesh_geometry(60000));
+  EXPECT_TRUE(this->lookup_geometry(cache_a, 2));
+  cache_b.begin_evaluation();
+  this->add(cache_b, 2, create_mesh_geometry(60000));
+  EXPECT_FALSE(this->lookup_geometry(cache_b, 2));
+
+  cache_a.clear();
+  this->add(cache_b, 2, create_mesh_geometry(60000));
+  EXPECT_TRUE(this->lookup_geometry(cache_b, 2));
+
+  /* The least recently used entries of a cache make room for new ones. */
+  this->add(cache_b, 3, create_mesh_geometry(60000));
+  EXPECT_FALSE(this->lookup_geometry(cache_b, 2));
+  EXPECT_TRUE(this->lookup_geometry(cache_b, 3));
+  cache_a.end_evaluation();
+  cache_b.end_evaluation();
+}
+
+}  // namespace blender::modifiers::geometry_nodes::tests
@@ -14,6 +14,7 @@
  * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
  */
 
+#include "MOD_nodes_cache.hh"
 #include "MOD_nodes_evaluator.hh"
 
 #include "BKE_type_conversions.hh"
@@ -36,7 +37,9 @@
 #include "BLI_task.hh"
 #include "BLI_vector_set.hh"
 
+#include <atomic>
 #include <chrono>
+#include <optional>
 
 namespace blender::modifiers::geometry_nodes {
 
@@ -141,8 +144,11 @@ struct InputState {
    * outputs are used, a node can tell the evaluator that an input will definitely be used or is
    * never used. This allows the evaluator to free values early, avoid copies and other unnecessary
    * computations.
+   *
+   * It is only modified while the node is locked. Once it is #ValueUsage::Unused, it does not
+   * change anymore, so it can be checked without a lock to skip work for unused inputs.
    */
-  ValueUsage usage = ValueUsage::Maybe;
+  std::atomic<ValueUsage> usage = ValueUsage::Maybe;
 
   /**
    * True when this input is/was used for an execution. While a node is running, only the inputs
@@ -174,8 +180,11 @@ struct OutputState {
    * Keeps track of how the output value is used. If a connected input becomes required, this
    * output has to become required as well. The output becomes ignored when it has zero potential
    * users that are counted below.
+   *
+   * It is only modified while the node is locked. Once it is #ValueUsage::Required, it does not
+   * change anymore, so it can be checked without a lock to avoid notifying the node again.
    */
-  ValueUsage output_usage = ValueUsage::Maybe;
+  std::atomic<ValueUsage> output_usage = ValueUsage::Maybe;
 
   /**
    * This is a copy of `output_usage` that is done right before node execution starts. This is
@@ -425,6 +434,9 @@ class NodeParamsProvider : public nodes::GeoNodeExecParamsProvider {
   NodeTaskRunState *run_state_;
 
  public:
+  /** When set, copies of the computed outputs are stored here, indexed by the socket index. */
+  MutableSpan<GMutablePointer> outputs_to_cache;
+
   NodeParamsProvider(GeometryNodesEvaluator &evaluator,
                      DNode dnode,
                      NodeState &node_state,
@@ -490,6 +502,9 @@ class GeometryNodesEvaluator {
   void execute()
   {
     task_pool_ = BLI_task_pool_create(this, TASK_PRIORITY_HIGH);
+    if (params_.cache != nullptr) {
+      params_.cache->begin_evaluation();
+    }
 
     this->create_states_for_reachable_nodes();
     this->forward_group_inputs();
@@ -498,6 +513,9 @@ class GeometryNodesEvaluator {
     /* This runs until all initially requested inputs have been computed. */
     BLI_task_pool_work_and_wait(task_pool_);
     BLI_task_pool_free(task_pool_);
+    if (params_.cache != nullptr) {
+      params_.cache->end_evaluation();
+    }
 
     this->extract_group_outputs();
     this->destruct_node_states();
@@ -999,7 +1017,36 @@ class GeometryNodesEvaluator {
     }
     using Clock = std::chrono::steady_clock;
     Clock::time_point begin = Clock::now();
-    bnode.typeinfo->geometry_node_execute(params);
+
+    std::optional<NodeOutputsCacheKey> cache_key = this->try_build_cache_key(node, node_state);
+    if (!cache_key.has_value() ||
+        !this->try_forward_cached_outputs(node, node_state, *cache_key, run_state)) {
+      LinearAllocator<> &allocator = local_allocators_.local();
+      if (cache_key.has_value()) {
+        params_provider.outputs_to_cache = allocator.construct_array<GMutablePointer>(
+            node->outputs().size());
+        /* Warnings added by the evaluator itself are also shown when the cache is used. */
+        params_provider.outputs_are_cacheable = true;
+      }
+
+      bnode.typeinfo->geometry_node_execute(params);
+
+      if (cache_key.has_value()) {
+        Vector<GPointer> outputs;
+        for (GMutablePointer value : params_provider.outputs_to_cache) {
+          outputs.append(value);
+        }
+        if (params_provider.outputs_are_cacheable) {
+          params_.cache->add(std::move(*cache_key), outputs);
+        }
+        for (GMutablePointer value : params_provider.outputs_to_cache) {
+          if (value.get() != nullptr) {
+            value.destruct();
+          }
+        }
+      }
+    }
+
     Clock::time_point end = Clock::now();
     const std::chrono::microseconds duration =
         std::chrono::duration_cast<std::chrono::microseconds>(end - begin);
@@ -1008,6 +1055,116 @@ class GeometryNodesEvaluator {
     }
   }
 
+  /**
+   * The outputs of a node can be cached when they only depend on the input values and node
+   * properties, which can all be compared to the ones from a previous evaluation.
+   */
+  std::optional<NodeOutputsCacheKey> try_build_cache_key(const DNode node, NodeState &node_state)
+  {
+    if (params_.cache == nullptr) {
+      return std::nullopt;
+    }
+    const bNode &bnode = *node->bnode();
+    if (bnode.id != nullptr || node_supports_laziness(node)) {
+      return std::nullopt;
+    }
+    /* Geometry output by the node tree is passed on to the following modifiers, which would have
+     * to copy it before modifying it while the cache still references it. */
+    for (const int i : node->outputs().index_range()) {
+      if (node->output(i).bsocket()->type != SOCK_GEOMETRY) {
+        continue;
+      }
+      bool is_tree_output = false;
+      node.output(i).foreach_target_socket(
+          [&](const DInputSocket target_socket,
+              const DOutputSocket::TargetSocketPathInfo &UNUSED(path_info)) {
+            if (params_.output_sockets.contains(target_socket)) {
+              is_tree_output = true;
+            }
+          });
+      if (is_tree_output) {
+        return std::nullopt;
+      }
+    }
+
+    Vector<Vector<GPointer>> input_values;
+    for (const int i : node->inputs().index_range()) {
+      const InputSocketRef &socket_ref = node->input(i);
+      InputState &input_state = node_state.inputs[i];
+      input_values.append({});
+      Vector<GPointer> &values = input_values.last();
+      if (input_state.type == nullptr || !input_state.was_ready_for_execution) {
+        continue;
+      }
+      if (ELEM(socket_ref.bsocket()->type,
+               SOCK_OBJECT,
+               SOCK_COLLECTION,
+               SOCK_TEXTURE,
+               SOCK_IMAGE,
+               SOCK_MATERIAL)) {
+        /* The data-blocks can change without their pointers changing. */
+        return std::nullopt;
+      }
+      if (socket_ref.is_multi_input_socket()) {
+        for (const void *value : input_state.value.multi->values) {
+          values.append({input_state.type, value});
+        }
+      }
+      else {
+        values.append({input_state.type, input_state.value.single->value});
+      }
+      for (const GPointer value : values) {
+        if (value.get() == nullptr) {
+          return std::nullopt;
+        }
+      }
+    }
+    return params_.cache->try_build_key(bnode, input_values);
+  }
+
+  bool try_forward_cached_outputs(const DNode node,
+                                  NodeState &node_state,
+                                  const NodeOutputsCacheKey &cache_key,
+                                  NodeTaskRunState *run_state)
+  {
+    LinearAllocator<> &allocator = local_allocators_.local();
+    Vector<GMutablePointer> outputs(node->outputs().size());
+
+    const bool found = params_.cache->lookup(cache_key, [&](Span<GPointer> cached_outputs) {
+      for (const int i : node->outputs().index_range()) {
+        const OutputState &output_state = node_state.outputs[i];
+        if (output_state.output_usage_for_execution == ValueUsage::Unused) {
+          continue;
+        }
+        if (cached_outputs[i].get() == nullptr) {
+          /* The output was not required when the node was cached. */
+          for (GMutablePointer value : outputs) {
+            if (value.get() != nullptr) {
+              value.destruct();
+            }
+          }
+          return false;
+        }
+        const CPPType &type = *cached_outputs[i].type();
+        void *buffer = allocator.allocate(type.size(), type.alignment());
+        type.copy_construct(cached_outputs[i].get(), buffer);
+        outputs[i] = {type, buffer};
+      }
+      return true;
+    });
+    if (!found) {
+      return false;
+    }
+
+    for (const int i : node->outputs().index_range()) {
+      if (outputs[i].get() != nullptr) {
+        this->forward_output(node.output(i), outputs[i], run_state);
+        node_state.outputs[i].has_been_computed = true;
+      }
+    }
+    return true;
+  }
+
   void execute_multi_function_node(const DNode node,
                                    const nodes::NodeMultiFunctions::Item &fn_item,
                                    NodeState &node_state,
@@ -1368,6 +1525,12 @@ class GeometryNodesEvaluator {
     NodeState &node_state = this->get_node_state(node);
     OutputState &output_state = node_state.outputs[socket->index()];
 
+    /* Avoid locking the node when the output has been required before, which is common for
+     * outputs that are linked to many inputs. A required output never changes its usage. */
+    if (output_state.output_usage.load(std::memory_order_relaxed) == ValueUsage::Required) {
+      return;
+    }
+
     this->with_locked_node(node, node_state, run_state, [&](LockedNode &locked_node) {
       if (output_state.output_usage == ValueUsage::Required) {
         /* Output is marked as required already. So the node is scheduled already. */
@@ -1488,9 +1651,10 @@ class GeometryNodesEvaluator {
     NodeState &target_node_state = *target_node_with_state->state;
     InputState &target_input_state = target_node_state.inputs[socket->index()];
 
-    std::lock_guard lock{target_node_state.mutex};
-    /* Do not forward to an input socket whose value won't be used. */
-    return target_input_state.usage != ValueUsage::Unused;
+    /* Do not forward to an input socket whose value won't be used. No lock is necessary, because
+     * an unused input never becomes used again. Forwarding a value that turns out to be unused
+     * is still correct, it is just destructed later. */
+    return target_input_state.usage.load(std::memory_order_relaxed) != ValueUsage::Unused;
   }
 
   void forward_to_sockets_with_same_type(LinearAllocator<> &allocator,
@@ -1863,6 +2027,13 @@ void NodeParamsProvider::set_output(StringRef identifier, GMutablePointer value)
 
   OutputState &output_state = node_state_.outputs[socket->index()];
   BLI_assert(!output_state.has_been_computed);
+  if (!outputs_to_cache.is_empty()) {
+    /* Copy the value before it is forwarded, because it might be modified by other nodes. */
+    LinearAllocator<> &allocator = evaluator_.local_allocators_.local();
+    void *buffer = allocator.allocate(value.type()->size(), value.type()->alignment());
+    value.type()->copy_construct(value.get(), buffer);
+    outputs_to_cache[socket->index()] = {value.type(), buffer};
+  }
   evaluator_.forward_output(socket, value, run_state_);
   output_state.has_been_computed = true;
 }
@@ -1925,6 +2096,8 @@ bool NodeParamsProvider::lazy_output_is_required(StringRef identifier) const
 void NodeParamsProvider::set_default_remaining_outputs()
 {
   LinearAllocator<> &allocator = evaluator_.local_allocators_.local();
+  /* Default outputs are only used when the node could not compute its outputs. */
+  this->outputs_are_cacheable = false;
 
   for (const int i : this->dnode->outputs().index_range()) {
     OutputState &output_state = node_state_.outputs[i];
@@ -36,6 +36,8 @@ using namespace nodes::derived_node_tree_types;
 using fn::GMutablePointer;
 using fn::GPointer;
 
+class NodeOutputsCache;
+
 struct GeometryNodesEvaluationParams {
   blender::LinearAllocator<> allocator;
 
@@ -52,6 +54,8 @@ struct GeometryNodesEvaluationParams {
   Depsgraph *depsgraph;
   Object *self_object;
   geo_log::GeoLogger *geo_logger;
+  /** Outputs of nodes kept across evaluations, may be null. */
+  NodeOutputsCache *cache = nullptr;
 
   Vector<GMutablePointer> r_output_values;
 };
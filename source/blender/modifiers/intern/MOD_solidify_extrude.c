@@ -30,6 +30,8 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_task.h"
+
 #include "BKE_deform.h"
 #include "BKE_mesh.h"
 #include "BKE_particle.h"
@@ -56,6 +58,121 @@ BLI_INLINE void madd_v3v3short_fl(float r[3], const short a[3], const float f)
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Shell Offset
+ *
+ * Offsetting the vertices of one side of the shell, in parallel.
+ * \{ */
+
+typedef struct SolidifyOffsetData {
+  /** First vertex of the side of the shell to offset. */
+  MVert *mvert;
+  /** Original vertex of each vertex to offset, or null when they are aligned. */
+  const uint *new_vert_arr;
+  const MDeformVert *dvert;
+  int defgrp_index;
+  bool defgrp_invert;
+  float offset_fac_vg;
+  float offset_fac_vg_inv;
+  const float (*vert_nors)[3];
+
+  /* Simple mode. */
+  float ofs;
+  bool is_orig;
+  bool do_clamp;
+  bool do_angle_clamp;
+  const float *vert_lens;
+  const float *vert_angs;
+  float offset;
+  float offset_sq;
+
+  /* Even thickness mode. */
+  const float *vert_angles;
+  const float *vert_accum;
+} SolidifyOffsetData;
+
+static void solidify_offset_simple_task(void *__restrict userdata,
+                                        const int iter,
+                                        const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const SolidifyOffsetData *data = (const SolidifyOffsetData *)userdata;
+  const uint i_orig = (uint)iter;
+  const uint i = data->new_vert_arr ? data->new_vert_arr[i_orig] : i_orig;
+  const float ofs = data->ofs;
+  const float offset = data->offset;
+  MVert *mv = &data->mvert[i_orig];
+  float ofs_vgroup = ofs;
+
+  if (data->dvert) {
+    const MDeformVert *dv = &data->dvert[i];
+    if (data->defgrp_invert) {
+      ofs_vgroup = 1.0f - BKE_defvert_find_weight(dv, data->defgrp_index);
+    }
+    else {
+      ofs_vgroup = BKE_defvert_find_weight(dv, data->defgrp_index);
+    }
+    ofs_vgroup = (data->offset_fac_vg + (ofs_vgroup * data->offset_fac_vg_inv)) * ofs;
+  }
+  if (data->do_clamp && offset > FLT_EPSILON) {
+    if (data->do_angle_clamp) {
+      float cos_ang = data->is_orig ? cosf(data->vert_angs[i_orig] * 0.5f) :
+                                      cosf(((2 * M_PI) - data->vert_angs[i]) * 0.5f);
+      if (cos_ang > 0) {
+        float max_off = sqrtf(data->vert_lens[i]) * 0.5f / cos_ang;
+        if (max_off < offset * 0.5f) {
+          ofs_vgroup *= max_off / offset * 2;
+        }
+      }
+    }
+    else {
+      if (data->vert_lens[i] < data->offset_sq) {
+        float scalar = sqrtf(data->vert_lens[i]) / offset;
+        ofs_vgroup *= scalar;
+      }
+    }
+  }
+  if (data->vert_nors) {
+    madd_v3_v3fl(mv->co, data->vert_nors[i], ofs_vgroup);
+  }
+  else {
+    madd_v3v3short_fl(mv->co, mv->no, ofs_vgroup / 32767.0f);
+  }
+}
+
+static void solidify_offset_even_task(void *__restrict userdata,
+                                      const int iter,
+                                      const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const SolidifyOffsetData *data = (const SolidifyOffsetData *)userdata;
+  const uint i_orig = (uint)iter;
+  const uint i_other = data->new_vert_arr ? data->new_vert_arr[i_orig] : i_orig;
+  if (data->vert_accum[i_other]) { /* zero if unselected */
+    madd_v3_v3fl(data->mvert[i_orig].co,
+                 data->vert_nors[i_other],
+                 data->ofs * (data->vert_angles[i_other] / data->vert_accum[i_other]));
+  }
+}
+
+static void solidify_offset_apply(SolidifyOffsetData *data,
+                                  MVert *mvert,
+                                  const uint *new_vert_arr,
+                                  const uint i_end,
+                                  const bool do_shell_align,
+                                  const float ofs,
+                                  TaskParallelRangeFunc func)
+{
+  data->mvert = mvert;
+  data->new_vert_arr = do_shell_align ? NULL : new_vert_arr;
+  data->ofs = ofs;
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (i_end > 1024);
+  BLI_task_parallel_range(0, (int)i_end, data, func, &settings);
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name High Quality Normal Calculation Function
  * \{ */
@@ -506,7 +623,6 @@ Mesh *MOD_solidify_extrude_modifyMesh(ModifierData *md, const ModifierEvalContex
   /* NOTE: copied vertex layers don't have flipped normals yet. do this after applying offset. */
   if ((smd->flag & MOD_SOLIDIFY_EVEN) == 0) {
     /* no even thickness, very simple */
-    float ofs_new_vgroup;
 
     /* for clamping */
     float *vert_lens = NULL;
@@ -591,105 +707,52 @@ Mesh *MOD_solidify_extrude_modifyMesh(ModifierData *md, const ModifierEvalContex
       MEM_freeN(edge_user_pairs);
     }
 
+    SolidifyOffsetData offset_data = {
+        .dvert = dvert,
+        .defgrp_index = defgrp_index,
+        .defgrp_invert = defgrp_invert,
+        .offset_fac_vg = offset_fac_vg,
+        .offset_fac_vg_inv = offset_fac_vg_inv,
+        .vert_nors = (const float(*)[3])vert_nors,
+        .do_clamp = do_clamp,
+        .do_angle_clamp = do_angle_clamp,
+        .vert_lens = vert_lens,
+        .vert_angs = vert_angs,
+        .offset = offset,
+        .offset_sq = offset_sq,
+    };
+
     if (ofs_new != 0.0f) {
-      uint i_orig, i_end;
+      uint i_end;
       bool do_shell_align;
 
-      ofs_new_vgroup = ofs_new;
-
       INIT_VERT_ARRAY_OFFSETS(false);
 
-      for (i_orig = 0; i_orig < i_end; i_orig++, mv++) {
-        const uint i = do_shell_align ? i_orig : new_vert_arr[i_orig];
-        if (dvert) {
-          MDeformVert *dv = &dvert[i];
-          if (defgrp_invert) {
-            ofs_new_vgroup = 1.0f - BKE_defvert_find_weight(dv, defgrp_index);
-          }
-          else {
-            ofs_new_vgroup = BKE_defvert_find_weight(dv, defgrp_index);
-          }
-          ofs_new_vgroup = (offset_fac_vg + (ofs_new_vgroup * offset_fac_vg_inv)) * ofs_new;
-        }
-        if (do_clamp && offset > FLT_EPSILON) {
-          /* always reset because we may have set before */
-          if (dvert == NULL) {
-            ofs_new_vgroup = ofs_new;
-          }
-          if (do_angle_clamp) {
-            float cos_ang = cosf(((2 * M_PI) - vert_angs[i]) * 0.5f);
-            if (cos_ang > 0) {
-              float max_off = sqrtf(vert_lens[i]) * 0.5f / cos_ang;
-              if (max_off < offset * 0.5f) {
-                ofs_new_vgroup *= max_off / offset * 2;
-              }
-            }
-          }
-          else {
-            if (vert_lens[i] < offset_sq) {
-              float scalar = sqrtf(vert_lens[i]) / offset;
-              ofs_new_vgroup *= scalar;
-            }
-          }
-        }
-        if (vert_nors) {
-          madd_v3_v3fl(mv->co, vert_nors[i], ofs_new_vgroup);
-        }
-        else {
-          madd_v3v3short_fl(mv->co, mv->no, ofs_new_vgroup / 32767.0f);
-        }
-      }
+      offset_data.is_orig = false;
+      solidify_offset_apply(&offset_data,
+                            mv,
+                            new_vert_arr,
+                            i_end,
+                            do_shell_align,
+                            ofs_new,
+                            solidify_offset_simple_task);
     }
 
     if (ofs_orig != 0.0f) {
-      uint i_orig, i_end;
+      uint i_end;
       bool do_shell_align;
 
-      ofs_new_vgroup = ofs_orig;
-
       /* as above but swapped */
       INIT_VERT_ARRAY_OFFSETS(true);
 
-      for (i_orig = 0; i_orig < i_end; i_orig++, mv++) {
-        const uint i = do_shell_align ? i_orig : new_vert_arr[i_orig];
-        if (dvert) {
-          MDeformVert *dv = &dvert[i];
-          if (defgrp_invert) {
-            ofs_new_vgroup = 1.0f - BKE_defvert_find_weight(dv, defgrp_index);
-          }
-          else {
-            ofs_new_vgroup = BKE_defvert_find_weight(dv, defgrp_index);
-          }
-          ofs_new_vgroup = (offset_fac_vg + (ofs_new_vgroup * offset_fac_vg_inv)) * ofs_orig;
-        }
-        if (do_clamp && offset > FLT_EPSILON) {
-          /* always reset because we may have set before */
-          if (dvert == NULL) {
-            ofs_new_vgroup = ofs_orig;
-          }
-          if (do_angle_clamp) {
-            float cos_ang = cosf(vert_angs[i_orig] * 0.5f);
-            if (cos_ang > 0) {
-              float max_off = sqrtf(vert_lens[i]) * 0.5f / cos_ang;
-              if (max_off < offset * 0.5f) {
-                ofs_new_vgroup *= max_off / offset * 2;
-              }
-            }
-          }
-          else {
-            if (vert_lens[i] < offset_sq) {
-              float scalar = sqrtf(vert_lens[i]) / offset;
-              ofs_new_vgroup *= scalar;
-            }
-          }
-        }
-        if (vert_nors) {
-          madd_v3_v3fl(mv->co, vert_nors[i], ofs_new_vgroup);
-        }
-        else {
-          madd_v3v3short_fl(mv->co, mv->no, ofs_new_vgroup / 32767.0f);
-        }
-      }
+      offset_data.is_orig = true;
+      solidify_offset_apply(&offset_data,
+                            mv,
+                            new_vert_arr,
+                            i_end,
+                            do_shell_align,
+                            ofs_orig,
+                            solidify_offset_simple_task);
     }
 
     if (do_bevel_convex) {
@@ -949,35 +1012,41 @@ Mesh *MOD_solidify_extrude_modifyMesh(ModifierData *md, const ModifierEvalContex
 #undef INVALID_UNUSED
 #undef INVALID_PAIR
 
+    SolidifyOffsetData offset_data = {
+        .vert_nors = (const float(*)[3])vert_nors,
+        .vert_angles = vert_angles,
+        .vert_accum = vert_accum,
+    };
+
     if (ofs_new != 0.0f) {
-      uint i_orig, i_end;
+      uint i_end;
       bool do_shell_align;
 
       INIT_VERT_ARRAY_OFFSETS(false);
 
-      for (i_orig = 0; i_orig < i_end; i_orig++, mv++) {
-        const uint i_other = do_shell_align ? i_orig : new_vert_arr[i_orig];
-        if (vert_accum[i_other]) { /* zero if unselected */
-          madd_v3_v3fl(
-              mv->co, vert_nors[i_other], ofs_new * (vert_angles[i_other] / vert_accum[i_other]));
-        }
-      }
+      solidify_offset_apply(&offset_data,
+                            mv,
+                            new_vert_arr,
+                            i_end,
+                            do_shell_align,
+                            ofs_new,
+                            solidify_offset_even_task);
     }
 
     if (ofs_orig != 0.0f) {
-      uint i_orig, i_end;
+      uint i_end;
       bool do_shell_align;
 
       /* same as above but swapped, intentional use of 'ofs_new' */
       INIT_VERT_ARRAY_OFFSETS(true);
 
-      for (i_orig = 0; i_orig < i_end; i_orig++, mv++) {
-        const uint i_other = do_shell_align ? i_orig : new_vert_arr[i_orig];
-        if (vert_accum[i_other]) { /* zero if unselected */
-          madd_v3_v3fl(
-              mv->co, vert_nors[i_other], ofs_orig * (vert_angles[i_other] / vert_accum[i_other]));
-        }
-      }
+      solidify_offset_apply(&offset_data,
+                            mv,
+                            new_vert_arr,
+                            i_end,
+                            do_shell_align,
+                            ofs_orig,
+                            solidify_offset_even_task);
     }
 
     MEM_freeN(vert_angles);
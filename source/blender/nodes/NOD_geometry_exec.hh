@@ -75,6 +75,11 @@ class GeoNodeExecParamsProvider {
   const ModifierData *modifier = nullptr;
   Depsgraph *depsgraph = nullptr;
   geometry_nodes_eval_log::GeoLogger *logger = nullptr;
+  /**
+   * Cleared when the outputs of the node may depend on more than its inputs and properties, e.g.
+   * when it accessed the evaluation context or reported a warning.
+   */
+  bool outputs_are_cacheable = true;
 
   /**
    * Returns true when the node is allowed to get/extract the input value. The identifier is
@@ -305,11 +310,13 @@ class GeoNodeExecParams {
 
   const Object *self_object() const
   {
+    provider_->outputs_are_cacheable = false;
     return provider_->self_object;
   }
 
   Depsgraph *depsgraph() const
   {
+    provider_->outputs_are_cacheable = false;
     return provider_->depsgraph;
   }
 
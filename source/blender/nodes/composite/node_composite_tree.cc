@@ -223,12 +223,21 @@ void ntreeCompositExecTree(Scene *scene,
                            int do_preview,
                            const ColorManagedViewSettings *view_settings,
                            const ColorManagedDisplaySettings *display_settings,
-                           const char *view_name)
+                           const char *view_name,
+                           const rctf *viewer_visible_area)
 {
 #ifdef WITH_COMPOSITOR
-  COM_execute(rd, scene, ntree, rendering, view_settings, display_settings, view_name);
+  COM_execute(rd,
+              scene,
+              ntree,
+              rendering,
+              view_settings,
+              display_settings,
+              view_name,
+              viewer_visible_area);
 #else
-  UNUSED_VARS(scene, ntree, rd, rendering, view_settings, display_settings, view_name);
+  UNUSED_VARS(
+      scene, ntree, rd, rendering, view_settings, display_settings, view_name, viewer_visible_area);
 #endif
 
   UNUSED_VARS(do_preview);
@@ -287,6 +296,11 @@ void ntreeCompositTagRender(Scene *scene)
     }
   }
   BKE_ntree_update_main(G_MAIN, nullptr);
+
+#ifdef WITH_COMPOSITOR
+  /* Buffers composited from the previous render result are out of date. */
+  COM_clear_caches();
+#endif
 }
 
 /* XXX after render animation system gets a refresh, this call allows composite to end clean */
@@ -30,6 +30,8 @@ namespace blender::nodes {
 
 void GeoNodeExecParams::error_message_add(const NodeWarningType type, std::string message) const
 {
+  /* The warning would not be shown when the outputs are taken from a cache. */
+  provider_->outputs_are_cacheable = false;
   if (provider_->logger == nullptr) {
     return;
   }
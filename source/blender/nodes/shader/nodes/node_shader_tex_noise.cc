@@ -152,60 +152,71 @@ class NoiseFunction : public fn::MultiFunction {
     const bool compute_factor = !r_factor.is_empty();
     const bool compute_color = !r_color.is_empty();
 
+    /* The first channel of the color is the factor, it is not computed twice when both outputs
+     * are used. */
     switch (dimensions_) {
       case 1: {
         const VArray<float> &w = params.readonly_single_input<float>(0, "W");
-        if (compute_factor) {
+        if (compute_color) {
           for (int64_t i : mask) {
             const float position = w[i] * scale[i];
-            r_factor[i] = noise::perlin_fractal_distorted(
+            const float3 c = noise::perlin_float3_fractal_distorted(
                 position, detail[i], roughness[i], distortion[i]);
+            r_color[i] = ColorGeometry4f(c[0], c[1], c[2], 1.0f);
+            if (compute_factor) {
+              r_factor[i] = c[0];
+            }
           }
         }
-        if (compute_color) {
+        else if (compute_factor) {
           for (int64_t i : mask) {
             const float position = w[i] * scale[i];
-            const float3 c = noise::perlin_float3_fractal_distorted(
+            r_factor[i] = noise::perlin_fractal_distorted(
                 position, detail[i], roughness[i], distortion[i]);
-            r_color[i] = ColorGeometry4f(c[0], c[1], c[2], 1.0f);
           }
         }
         break;
       }
       case 2: {
         const VArray<float3> &vector = params.readonly_single_input<float3>(0, "Vector");
-        if (compute_factor) {
+        if (compute_color) {
           for (int64_t i : mask) {
             const float2 position = vector[i] * scale[i];
-            r_factor[i] = noise::perlin_fractal_distorted(
+            const float3 c = noise::perlin_float3_fractal_distorted(
                 position, detail[i], roughness[i], distortion[i]);
+            r_color[i] = ColorGeometry4f(c[0], c[1], c[2], 1.0f);
+            if (compute_factor) {
+              r_factor[i] = c[0];
+            }
           }
         }
-        if (compute_color) {
+        else if (compute_factor) {
           for (int64_t i : mask) {
             const float2 position = vector[i] * scale[i];
-            const float3 c = noise::perlin_float3_fractal_distorted(
+            r_factor[i] = noise::perlin_fractal_distorted(
                 position, detail[i], roughness[i], distortion[i]);
-            r_color[i] = ColorGeometry4f(c[0], c[1], c[2], 1.0f);
           }
         }
         break;
       }
       case 3: {
         const VArray<float3> &vector = params.readonly_single_input<float3>(0, "Vector");
-        if (compute_factor) {
+        if (compute_color) {
           for (int64_t i : mask) {
             const float3 position = vector[i] * scale[i];
-            r_factor[i] = noise::perlin_fractal_distorted(
+            const float3 c = noise::perlin_float3_fractal_distorted(
                 position, detail[i], roughness[i], distortion[i]);
+            r_color[i] = ColorGeometry4f(c[0], c[1], c[2], 1.0f);
+            if (compute_factor) {
+              r_factor[i] = c[0];
+            }
           }
         }
-        if (compute_color) {
+        else if (compute_factor) {
           for (int64_t i : mask) {
             const float3 position = vector[i] * scale[i];
-            const float3 c = noise::perlin_float3_fractal_distorted(
+            r_factor[i] = noise::perlin_fractal_distorted(
                 position, detail[i], roughness[i], distortion[i]);
-            r_color[i] = ColorGeometry4f(c[0], c[1], c[2], 1.0f);
           }
         }
         break;
@@ -213,25 +224,28 @@ class NoiseFunction : public fn::MultiFunction {
       case 4: {
         const VArray<float3> &vector = params.readonly_single_input<float3>(0, "Vector");
         const VArray<float> &w = params.readonly_single_input<float>(1, "W");
-        if (compute_factor) {
+        if (compute_color) {
           for (int64_t i : mask) {
             const float3 position_vector = vector[i] * scale[i];
             const float position_w = w[i] * scale[i];
             const float4 position{
                 position_vector[0], position_vector[1], position_vector[2], position_w};
-            r_factor[i] = noise::perlin_fractal_distorted(
+            const float3 c = noise::perlin_float3_fractal_distorted(
                 position, detail[i], roughness[i], distortion[i]);
+            r_color[i] = ColorGeometry4f(c[0], c[1], c[2], 1.0f);
+            if (compute_factor) {
+              r_factor[i] = c[0];
+            }
           }
         }
-        if (compute_color) {
+        else if (compute_factor) {
           for (int64_t i : mask) {
             const float3 position_vector = vector[i] * scale[i];
             const float position_w = w[i] * scale[i];
             const float4 position{
                 position_vector[0], position_vector[1], position_vector[2], position_w};
-            const float3 c = noise::perlin_float3_fractal_distorted(
+            r_factor[i] = noise::perlin_fractal_distorted(
                 position, detail[i], roughness[i], distortion[i]);
-            r_color[i] = ColorGeometry4f(c[0], c[1], c[2], 1.0f);
           }
         }
         break;
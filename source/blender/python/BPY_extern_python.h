@@ -38,6 +38,8 @@ void BPY_python_start(struct bContext *C, int argc, const char **argv);
 void BPY_python_end(void);
 void BPY_python_reset(struct bContext *C);
 void BPY_python_use_system_env(void);
+/** Directory to cache the byte-code of scripts in, see `sys.pycache_prefix`. */
+void BPY_python_cache_dir_set(const char *dirpath);
 void BPY_python_backtrace(FILE *fp);
 
 #ifdef __cplusplus
@@ -45,6 +45,8 @@
 #include "bpy_app_icons.h"
 #include "bpy_app_timers.h"
 
+#include "MEM_guardedalloc.h"
+
 #include "BLI_utildefines.h"
 
 #include "BKE_appdir.h"
@@ -350,6 +352,40 @@ static PyObject *bpy_app_preview_render_size_get(PyObject *UNUSED(self), void *c
   return PyLong_FromLong((long)UI_icon_preview_to_render_size(POINTER_AS_INT(closure)));
 }
 
+PyDoc_STRVAR(bpy_app_memory_statistics_doc,
+             "Dictionary of the memory in use and the peak memory in bytes, in total and for "
+             "every memory category (read-only)");
+static PyObject *bpy_app_memory_statistics_get(PyObject *UNUSED(self), void *UNUSED(closure))
+{
+  PyObject *ret = PyDict_New();
+  PyObject *item = Py_BuildValue("{s:K,s:K}",
+                                 "in_use",
+                                 (unsigned long long)MEM_get_memory_in_use(),
+                                 "peak",
+                                 (unsigned long long)MEM_get_peak_memory());
+  PyDict_SetItemString(ret, "Total", item);
+  Py_DECREF(item);
+
+  for (int i = 0; i < MEM_CATEGORY_NUM; i++) {
+    const eMEM_Category category = (eMEM_Category)i;
+    const unsigned long long in_use = MEM_get_category_memory_in_use(category);
+    if (category == MEM_CATEGORY_NONE) {
+      /* The peak of the memory outside of categories is not tracked. */
+      item = Py_BuildValue("{s:K}", "in_use", in_use);
+    }
+    else {
+      item = Py_BuildValue("{s:K,s:K}",
+                           "in_use",
+                           in_use,
+                           "peak",
+                           (unsigned long long)MEM_get_category_peak_memory(category));
+    }
+    PyDict_SetItemString(ret, MEM_category_name(category), item);
+    Py_DECREF(item);
+  }
+  return ret;
+}
+
 static PyObject *bpy_app_autoexec_fail_message_get(PyObject *UNUSED(self), void *UNUSED(closure))
 {
   return PyC_UnicodeFromByte(G.autoexec_fail);
@@ -439,6 +475,11 @@ static PyGetSetDef bpy_app_getsets[] = {
      NULL},
     {"tempdir", bpy_app_tempdir_get, NULL, bpy_app_tempdir_doc, NULL},
     {"driver_namespace", bpy_app_driver_dict_get, NULL, bpy_app_driver_dict_doc, NULL},
+    {"memory_statistics",
+     bpy_app_memory_statistics_get,
+     NULL,
+     bpy_app_memory_statistics_doc,
+     NULL},
 
     {"render_icon_size",
      bpy_app_preview_render_size_get,
@@ -93,6 +93,7 @@ static int py_call_level = 0;
 
 /* Set by command line arguments before Python starts. */
 static bool py_use_system_env = false;
+static char py_cache_dir[FILE_MAX] = "";
 
 // #define TIME_PY_RUN /* simple python tests. prints on exit. */
 
@@ -378,6 +379,13 @@ void BPY_python_start(bContext *C, int argc, const char **argv)
     /* When using the system's Python, allow the site-directory as well. */
     config.user_site_directory = py_use_system_env;
 
+    /* Cache the byte-code of all scripts and add-ons in a writable directory, installations
+     * are often read-only on render farms, which means compiling all scripts on every start. */
+    if (py_cache_dir[0]) {
+      status = PyConfig_SetBytesString(&config, &config.pycache_prefix, py_cache_dir);
+      pystatus_exit_on_error(status);
+    }
+
     /* While `sys.argv` is set, we don't want Python to interpret it. */
     config.parse_argv = 0;
     status = PyConfig_SetBytesArgv(&config, argc, (char *const *)argv);
@@ -587,6 +595,12 @@ void BPY_python_use_system_env(void)
   py_use_system_env = true;
 }
 
+void BPY_python_cache_dir_set(const char *dirpath)
+{
+  BLI_assert(!Py_IsInitialized());
+  BLI_strncpy(py_cache_dir, dirpath, sizeof(py_cache_dir));
+}
+
 void BPY_python_backtrace(FILE *fp)
 {
   fputs("\n# Python backtrace\n", fp);
@@ -275,6 +275,18 @@ static PyObject *bpy_lib_enter(BPy_Library *self)
     return NULL;
   }
 
+  /* Listing the names of one type reads through the whole file, only do it for the types which
+   * are in the file. */
+  bool idcode_in_file[INDEX_ID_MAX] = {false};
+  LinkNode *groups = BLO_blendhandle_get_linkable_groups(self->blo_handle);
+  for (LinkNode *l = groups; l; l = l->next) {
+    const short code = BKE_idtype_idcode_from_name((const char *)l->link);
+    if (code != 0) {
+      idcode_in_file[BKE_idtype_idcode_to_index(code)] = true;
+    }
+  }
+  BLI_linklist_freeN(groups);
+
   int i = 0, code;
   while ((code = BKE_idtype_idcode_iter_step(&i))) {
     if (BKE_idtype_idcode_is_linkable(code)) {
@@ -284,7 +296,13 @@ static PyObject *bpy_lib_enter(BPy_Library *self)
 
       PyDict_SetItem(self->dict, str, item = PyList_New(0));
       Py_DECREF(item);
-      PyDict_SetItem(from_dict, str, item = _bpy_names(self, code));
+      if (idcode_in_file[BKE_idtype_idcode_to_index(code)]) {
+        item = _bpy_names(self, code);
+      }
+      else {
+        item = PyList_New(0);
+      }
+      PyDict_SetItem(from_dict, str, item);
       Py_DECREF(item);
 
       Py_DECREF(str);
@@ -401,11 +419,37 @@ static bool bpy_lib_exit_lapp_context_items_cb(BlendfileLinkAppendContext *lapp_
   return true;
 }
 
+/* Check whether any data-block names were requested, to skip linking when only reading. */
+static bool bpy_lib_exit_has_items(BPy_Library *self, const bool do_append)
+{
+  int idcode_step = 0;
+  short idcode;
+  while ((idcode = BKE_idtype_idcode_iter_step(&idcode_step))) {
+    if (!BKE_idtype_idcode_is_linkable(idcode) || (idcode == ID_WS && !do_append)) {
+      continue;
+    }
+    const char *name_plural = BKE_idtype_idcode_to_name_plural(idcode);
+    PyObject *ls = PyDict_GetItemString(self->dict, name_plural);
+    if (ls != NULL && PyList_Check(ls) && PyList_GET_SIZE(ls) != 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
 static PyObject *bpy_lib_exit(BPy_Library *self, PyObject *UNUSED(args))
 {
   Main *bmain = self->bmain;
   const bool do_append = ((self->flag & FILE_LINK) == 0);
 
+  /* Only the names were read (when scanning library files for example), there is nothing to link
+   * and no need to tag all the existing data-blocks. */
+  if (!bpy_lib_exit_has_items(self, do_append)) {
+    BLO_blendhandle_close(self->blo_handle);
+    self->blo_handle = NULL;
+    Py_RETURN_NONE;
+  }
+
   BKE_main_id_tag_all(bmain, LIB_TAG_PRE_EXISTING, true);
 
   /* here appending/linking starts */
@@ -5201,6 +5201,100 @@ static bool foreach_compat_buffer(RawPropertyType raw_type, int attr_signed, con
   return 0;
 }
 
+/**
+ * Get the raw type of a buffer that doesn't match the attribute type, so RNA can convert the
+ * values. Only flat buffers of native signed and floating point types are supported.
+ */
+static bool foreach_buffer_raw_type(const Py_buffer *buf,
+                                    const int tot,
+                                    RawPropertyType *r_raw_type)
+{
+  const char *format = buf->format;
+  if (format == NULL || format[0] == '\0' || format[1] != '\0') {
+    return false;
+  }
+
+  switch (format[0]) {
+    case '?':
+      *r_raw_type = PROP_RAW_BOOLEAN;
+      break;
+    case 'h':
+      *r_raw_type = PROP_RAW_SHORT;
+      break;
+    case 'i':
+      *r_raw_type = PROP_RAW_INT;
+      break;
+    case 'f':
+      *r_raw_type = PROP_RAW_FLOAT;
+      break;
+    case 'd':
+      *r_raw_type = PROP_RAW_DOUBLE;
+      break;
+    default:
+      return false;
+  }
+
+  return buf->len == (Py_ssize_t)tot * RNA_raw_type_sizeof(*r_raw_type);
+}
+
+/**
+ * Read string and pointer attributes, which have no raw type, as Python objects. The property is
+ * only looked up again when the type of the items changes.
+ */
+static PyObject *foreach_get_objects(BPy_PropertyRNA *self,
+                                     const char *attr,
+                                     PyObject *seq,
+                                     const int tot)
+{
+  StructRNA *item_type = NULL;
+  PropertyRNA *prop = NULL;
+  int i = 0;
+  bool error = false;
+
+  RNA_PROP_BEGIN (&self->ptr, itemptr, self->prop) {
+    if (i >= tot) {
+      i++;
+      break;
+    }
+    if (itemptr.type != item_type) {
+      item_type = itemptr.type;
+      prop = RNA_struct_find_property(&itemptr, attr);
+      if (prop == NULL || !ELEM(RNA_property_type(prop), PROP_STRING, PROP_POINTER)) {
+        PyErr_Format(PyExc_AttributeError,
+                     "foreach_get '%.200s.%200s[...]' attribute '%.200s' is not supported",
+                     RNA_struct_identifier(self->ptr.type),
+                     RNA_property_identifier(self->prop),
+                     attr);
+        error = true;
+        break;
+      }
+    }
+
+    PyObject *item = pyrna_prop_to_py(&itemptr, prop);
+    if (item == NULL || PySequence_SetItem(seq, i, item) == -1) {
+      Py_XDECREF(item);
+      error = true;
+      break;
+    }
+    Py_DECREF(item);
+    i++;
+  }
+  RNA_PROP_END;
+
+  if (error) {
+    return NULL;
+  }
+  if (i != tot) {
+    PyErr_Format(PyExc_TypeError,
+                 "foreach_get(attr, sequence) sequence length mismatch given %d, needed %d",
+                 tot,
+                 RNA_property_collection_length(&self->ptr, self->prop));
+    return NULL;
+  }
+
+  Py_RETURN_NONE;
+}
+
 static PyObject *foreach_getset(BPy_PropertyRNA *self, PyObject *args, int set)
 {
   PyObject *item = NULL;
@@ -5214,6 +5308,7 @@ static PyObject *foreach_getset(BPy_PropertyRNA *self, PyObject *args, int set)
   int tot, size, attr_tot;
   bool attr_signed;
   RawPropertyType raw_type;
+  RawPropertyType buffer_raw_type;
 
   if (foreach_parse_args(
           self, args, &attr, &seq, &tot, &size, &raw_type, &attr_tot, &attr_signed) == -1) {
@@ -5224,6 +5319,10 @@ static PyObject *foreach_getset(BPy_PropertyRNA *self, PyObject *args, int set)
     Py_RETURN_NONE;
   }
 
+  if (!set && raw_type == PROP_RAW_UNSET) {
+    return foreach_get_objects(self, attr, seq, tot);
+  }
+
   if (set) { /* Get the array from python. */
     buffer_is_compat = false;
     if (PyObject_CheckBuffer(seq)) {
@@ -5238,6 +5337,12 @@ static PyObject *foreach_getset(BPy_PropertyRNA *self, PyObject *args, int set)
         ok = RNA_property_collection_raw_set(
             NULL, &self->ptr, self->prop, attr, buf.buf, raw_type, tot);
       }
+      else if (foreach_buffer_raw_type(&buf, tot, &buffer_raw_type)) {
+        /* Let RNA convert the values, instead of going through Python objects. */
+        buffer_is_compat = true;
+        ok = RNA_property_collection_raw_set(
+            NULL, &self->ptr, self->prop, attr, buf.buf, buffer_raw_type, tot);
+      }
 
       PyBuffer_Release(&buf);
     }
@@ -5294,6 +5399,12 @@ static PyObject *foreach_getset(BPy_PropertyRNA *self, PyObject *args, int set)
         ok = RNA_property_collection_raw_get(
             NULL, &self->ptr, self->prop, attr, buf.buf, raw_type, tot);
       }
+      else if (foreach_buffer_raw_type(&buf, tot, &buffer_raw_type)) {
+        /* Let RNA convert the values, instead of going through Python objects. */
+        buffer_is_compat = true;
+        ok = RNA_property_collection_raw_get(
+            NULL, &self->ptr, self->prop, attr, buf.buf, buffer_raw_type, tot);
+      }
 
       PyBuffer_Release(&buf);
     }
@@ -5366,7 +5477,8 @@ static PyObject *foreach_getset(BPy_PropertyRNA *self, PyObject *args, int set)
 PyDoc_STRVAR(pyrna_prop_collection_foreach_get_doc,
              ".. method:: foreach_get(attr, seq)\n"
              "\n"
-             "   This is a function to give fast access to attributes within a collection.\n");
+             "   This is a function to give fast access to attributes within a collection.\n"
+             "   String and pointer attributes are read into the sequence as objects.\n");
 static PyObject *pyrna_prop_collection_foreach_get(BPy_PropertyRNA *self, PyObject *args)
 {
   PYRNA_PROP_CHECK_OBJ(self);
@@ -387,6 +387,16 @@ static void re_ensure_passes_allocated_thread_safe(Render *re)
   }
 }
 
+/* Hand over the buffers of a result covering the entire frame to the render result, instead of
+ * allocating the passes of the render result and copying the result into them. */
+static bool re_merge_shared_thread_safe(Render *re, RenderResult *result)
+{
+  BLI_rw_mutex_lock(&re->resultmutex, THREAD_LOCK_WRITE);
+  const bool merged_shared = render_result_merge_shared(re->result, result);
+  BLI_rw_mutex_unlock(&re->resultmutex);
+  return merged_shared;
+}
+
 void RE_engine_update_result(RenderEngine *engine, RenderResult *result)
 {
   if (engine->bake.pixels) {
@@ -441,8 +451,10 @@ void RE_engine_end_result(
     engine_tile_highlight_set(engine, &tile, highlight);
   }
 
+  bool merged_shared = false;
   if (!cancel || merge_results) {
     if (!(re->test_break(re->tbh) && (re->r.scemode & R_BUTS_PREVIEW))) {
+      merged_shared = re_merge_shared_thread_safe(re, result);
       re_ensure_passes_allocated_thread_safe(re);
       render_result_merge(re->result, result);
     }
@@ -456,7 +468,14 @@ void RE_engine_end_result(
 
   /* free */
   BLI_remlink(&engine->fullresult, result);
-  render_result_free(result);
+  if (merged_shared) {
+    BLI_rw_mutex_lock(&re->resultmutex, THREAD_LOCK_READ);
+    render_result_free_shared(re->result, result);
+    BLI_rw_mutex_unlock(&re->resultmutex);
+  }
+  else {
+    render_result_free(result);
+  }
 }
 
 RenderResult *RE_engine_get_result(RenderEngine *engine)
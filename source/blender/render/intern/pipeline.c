@@ -1225,7 +1225,8 @@ static void do_render_compositor(Render *re)
                                 G.background == 0,
                                 &re->scene->view_settings,
                                 &re->scene->display_settings,
-                                rv->name);
+                                rv->name,
+                                NULL);
         }
 
         ntree->stats_draw = NULL;
@@ -126,6 +126,25 @@ void render_result_free(RenderResult *rr)
   MEM_freeN(rr);
 }
 
+void render_result_free_shared(RenderResult *rr, RenderResult *rrpart)
+{
+  LISTBASE_FOREACH (RenderLayer *, rlp, &rrpart->layers) {
+    RenderLayer *rl = RE_GetRenderLayer(rr, rlp->name);
+    if (rl == NULL) {
+      continue;
+    }
+    LISTBASE_FOREACH (RenderPass *, rpassp, &rlp->passes) {
+      RenderPass *rpass = BLI_findstring(
+          &rl->passes, rpassp->fullname, offsetof(RenderPass, fullname));
+      if (rpass != NULL && rpass->rect == rpassp->rect) {
+        rpassp->rect = NULL;
+      }
+    }
+  }
+
+  render_result_free(rrpart);
+}
+
 void render_result_free_list(ListBase *lb, RenderResult *rr)
 {
   RenderResult *rrnext;
@@ -852,7 +871,10 @@ void render_result_merge(RenderResult *rr, RenderResult *rrpart)
           continue;
         }
 
-        do_merge_tile(rr, rrpart, rpass->rect, rpassp->rect, rpass->channels);
+        /* Buffers handed over by #render_result_merge_shared are already in place. */
+        if (rpass->rect != rpassp->rect) {
+          do_merge_tile(rr, rrpart, rpass->rect, rpassp->rect, rpass->channels);
+        }
 
         /* manually get next render pass */
         rpassp = rpassp->next;
@@ -861,6 +883,37 @@ void render_result_merge(RenderResult *rr, RenderResult *rrpart)
   }
 }
 
+bool render_result_merge_shared(RenderResult *rr, RenderResult *rrpart)
+{
+  if (rrpart->rectx != rr->rectx || rrpart->recty != rr->recty || rrpart->tilerect.xmin != 0 ||
+      rrpart->tilerect.ymin != 0) {
+    return false;
+  }
+
+  LISTBASE_FOREACH (RenderLayer *, rl, &rr->layers) {
+    RenderLayer *rlp = RE_GetRenderLayer(rrpart, rl->name);
+    if (rlp == NULL) {
+      continue;
+    }
+    LISTBASE_FOREACH (RenderPass *, rpass, &rl->passes) {
+      /* Only hand over buffers of passes which are not allocated yet, so the buffer of a pass
+       * never changes once other code may be reading it. For save buffers, skip any passes that
+       * are only saved to disk. */
+      if (rpass->rect != NULL ||
+          (rl->exrhandle != NULL && !STREQ(rpass->name, RE_PASSNAME_COMBINED))) {
+        continue;
+      }
+      RenderPass *rpassp = BLI_findstring(
+          &rlp->passes, rpass->fullname, offsetof(RenderPass, fullname));
+      if (rpassp != NULL && rpassp->channels == rpass->channels) {
+        rpass->rect = rpassp->rect;
+      }
+    }
+  }
+
+  return true;
+}
+
 bool RE_WriteRenderResult(ReportList *reports,
                           RenderResult *rr,
                           const char *filename,
@@ -77,6 +77,13 @@ void render_result_views_new(struct RenderResult *rr, const struct RenderData *r
  * \note Is used within threads.
  */
 void render_result_merge(struct RenderResult *rr, struct RenderResult *rrpart);
+/**
+ * Merge `rrpart` into `rr` without copying, when it covers the entire result: its pass buffers
+ * are handed over to `rr`. They stay readable from `rrpart`, which must then be freed with
+ * #render_result_free_shared.
+ * \return False when `rrpart` only covers a part of `rr`, nothing is merged in that case.
+ */
+bool render_result_merge_shared(struct RenderResult *rr, struct RenderResult *rrpart);
 
 /* Add Passes */
 
@@ -85,6 +92,10 @@ void render_result_clone_passes(struct Render *re, struct RenderResult *rr, cons
 /* Free */
 
 void render_result_free(struct RenderResult *rr);
+/**
+ * Free `rrpart` after #render_result_merge_shared, without freeing the buffers now owned by `rr`.
+ */
+void render_result_free_shared(struct RenderResult *rr, struct RenderResult *rrpart);
 /**
  * Version that's compatible with full-sample buffers.
  */
@@ -24,6 +24,7 @@
 #include <memory.h>
 #include <stddef.h>
 #include <time.h>
+#include <zstd.h>
 
 #include "MEM_guardedalloc.h"
 
@@ -44,6 +45,7 @@
 #include "BLI_listbase.h"
 #include "BLI_mempool.h"
 #include "BLI_path_util.h"
+#include "BLI_task.h"
 #include "BLI_threads.h"
 
 #include "BKE_main.h"
@@ -74,6 +76,10 @@
  * size specified in user preferences.
  * To distinguish 2 blend files with same name, scene->ed->disk_cache_timestamp
  * is used as UID. Blend file can still be copied manually which may cause conflict.
+ *
+ * Images are compressed and written by background tasks, so that rendering does not wait for
+ * them. Pending writes are canceled on invalidation, so no outdated image is written after it.
+ * Reading only holds the lock for file access, decompression happens after it.
  */
 
 /* Format string:
@@ -102,8 +108,16 @@ typedef struct SeqDiskCache {
   ListBase files;
   ThreadMutex read_write_mutex;
   size_t size_total;
+  /* Background tasks writing images, see #seq_disk_cache_write_file. */
+  struct TaskPool *write_pool;
 } SeqDiskCache;
 
+typedef struct DiskCacheWriteTask {
+  char path[FILE_MAX];
+  uint64_t frameno;
+  ImBuf *ibuf;
+} DiskCacheWriteTask;
+
 typedef struct DiskCacheFile {
   struct DiskCacheFile *next, *prev;
   char path[FILE_MAX];
@@ -424,6 +438,9 @@ void seq_disk_cache_invalidate(SeqDiskCache *disk_cache,
   int start;
   int end;
 
+  /* Images waiting to be written may be outdated now. */
+  BLI_task_pool_cancel(disk_cache->write_pool);
+
   BLI_mutex_lock(&disk_cache->read_write_mutex);
 
   start = seq_changed->startdisp - DCACHE_IMAGES_PER_FILE;
@@ -434,39 +451,27 @@ void seq_disk_cache_invalidate(SeqDiskCache *disk_cache,
   BLI_mutex_unlock(&disk_cache->read_write_mutex);
 }
 
-static size_t deflate_imbuf_to_file(ImBuf *ibuf,
-                                    FILE *file,
-                                    int level,
-                                    DiskCacheHeaderEntry *header_entry)
+/* Compress image data in memory, returns the size of the compressed data in r_data or 0 when
+ * it is stored uncompressed. */
+static size_t seq_disk_cache_compress_imbuf(ImBuf *ibuf, size_t size_raw, int level, void **r_data)
 {
-  void *data = (ibuf->rect != NULL) ? (void *)ibuf->rect : (void *)ibuf->rect_float;
-
-  /* Apply compression if wanted, otherwise just write directly to the file. */
-  if (level > 0) {
-    return BLI_file_zstd_from_mem_at_pos(
-        data, header_entry->size_raw, file, header_entry->offset, level);
+  *r_data = NULL;
+  if (level <= 0) {
+    return 0;
   }
 
-  fseek(file, header_entry->offset, SEEK_SET);
-  return fwrite(data, 1, header_entry->size_raw, file);
-}
+  const void *data = (ibuf->rect != NULL) ? (void *)ibuf->rect : (void *)ibuf->rect_float;
+  const size_t buffer_size = ZSTD_compressBound(size_raw);
+  void *buffer = MEM_mallocN(buffer_size, __func__);
+  const size_t compressed_size = ZSTD_compress(buffer, buffer_size, data, size_raw, level);
 
-static size_t inflate_file_to_imbuf(ImBuf *ibuf, FILE *file, DiskCacheHeaderEntry *header_entry)
-{
-  void *data = (ibuf->rect != NULL) ? (void *)ibuf->rect : (void *)ibuf->rect_float;
-  char header[4];
-  fseek(file, header_entry->offset, SEEK_SET);
-  if (fread(header, 1, sizeof(header), file) != sizeof(header)) {
+  if (ZSTD_isError(compressed_size)) {
+    MEM_freeN(buffer);
     return 0;
   }
 
-  /* Check if the data is compressed or raw. */
-  if (BLI_file_magic_is_zstd(header)) {
-    return BLI_file_unzstd_to_mem_at_pos(data, header_entry->size_raw, file, header_entry->offset);
-  }
-
-  fseek(file, header_entry->offset, SEEK_SET);
-  return fread(data, 1, header_entry->size_raw, file);
+  *r_data = buffer;
+  return compressed_size;
 }
 
 static bool seq_disk_cache_read_header(FILE *file, DiskCacheHeader *header)
@@ -497,7 +502,9 @@ static size_t seq_disk_cache_write_header(FILE *file, DiskCacheHeader *header)
   return fwrite(header, sizeof(*header), 1, file);
 }
 
-static int seq_disk_cache_add_header_entry(SeqCacheKey *key, ImBuf *ibuf, DiskCacheHeader *header)
+static int seq_disk_cache_add_header_entry(uint64_t frameno,
+                                           ImBuf *ibuf,
+                                           DiskCacheHeader *header)
 {
   int i;
   uint64_t offset = sizeof(*header);
@@ -530,7 +537,7 @@ static int seq_disk_cache_add_header_entry(SeqCacheKey *key, ImBuf *ibuf, DiskCa
   }
 
   header->entry[i].offset = offset;
-  header->entry[i].frameno = key->frame_index;
+  header->entry[i].frameno = frameno;
 
   /* Store colorspace name of ibuf. */
   const char *colorspace_name;
@@ -559,26 +566,34 @@ static int seq_disk_cache_get_header_entry(SeqCacheKey *key, DiskCacheHeader *he
   return -1;
 }
 
-bool seq_disk_cache_write_file(SeqDiskCache *disk_cache, SeqCacheKey *key, ImBuf *ibuf)
+static bool seq_disk_cache_write_task_exec(SeqDiskCache *disk_cache, DiskCacheWriteTask *task)
 {
-  BLI_mutex_lock(&disk_cache->read_write_mutex);
+  ImBuf *ibuf = task->ibuf;
+  const size_t size_raw = (ibuf->rect != NULL) ?
+                              (size_t)ibuf->x * ibuf->y * ibuf->channels :
+                              (size_t)ibuf->x * ibuf->y * ibuf->channels * 4;
 
-  char path[FILE_MAX];
+  /* Compress before locking, so reading and other writes don't wait for it. */
+  void *compressed_data;
+  const size_t compressed_size = seq_disk_cache_compress_imbuf(
+      ibuf, size_raw, seq_disk_cache_compression_level(), &compressed_data);
 
-  seq_disk_cache_get_file_path(disk_cache, key, path, sizeof(path));
-  BLI_make_existing_file(path);
+  BLI_mutex_lock(&disk_cache->read_write_mutex);
+
+  BLI_make_existing_file(task->path);
 
-  FILE *file = BLI_fopen(path, "rb+");
+  FILE *file = BLI_fopen(task->path, "rb+");
   if (!file) {
-    file = BLI_fopen(path, "wb+");
+    file = BLI_fopen(task->path, "wb+");
     if (!file) {
       BLI_mutex_unlock(&disk_cache->read_write_mutex);
+      MEM_SAFE_FREE(compressed_data);
       return false;
     }
-    seq_disk_cache_add_file_to_list(disk_cache, path);
+    seq_disk_cache_add_file_to_list(disk_cache, task->path);
   }
 
-  DiskCacheFile *cache_file = seq_disk_cache_get_file_entry_by_path(disk_cache, path);
+  DiskCacheFile *cache_file = seq_disk_cache_get_file_entry_by_path(disk_cache, task->path);
   DiskCacheHeader header;
   memset(&header, 0, sizeof(header));
   /* #BLI_make_existing_file() above may create an empty file. This is fine, don't attempt reading
@@ -587,12 +602,24 @@ bool seq_disk_cache_write_file(SeqDiskCache *disk_cache, SeqCacheKey *key, ImBuf
     fclose(file);
     seq_disk_cache_delete_file(disk_cache, cache_file);
     BLI_mutex_unlock(&disk_cache->read_write_mutex);
+    MEM_SAFE_FREE(compressed_data);
     return false;
   }
-  int entry_index = seq_disk_cache_add_header_entry(key, ibuf, &header);
+  int entry_index = seq_disk_cache_add_header_entry(task->frameno, ibuf, &header);
 
-  size_t bytes_written = deflate_imbuf_to_file(
-      ibuf, file, seq_disk_cache_compression_level(), &header.entry[entry_index]);
+  fseek(file, header.entry[entry_index].offset, SEEK_SET);
+  size_t bytes_written;
+  if (compressed_data) {
+    bytes_written = fwrite(compressed_data, 1, compressed_size, file);
+    if (bytes_written != compressed_size) {
+      bytes_written = 0;
+    }
+  }
+  else {
+    void *data = (ibuf->rect != NULL) ? (void *)ibuf->rect : (void *)ibuf->rect_float;
+    bytes_written = fwrite(data, 1, header.entry[entry_index].size_raw, file);
+  }
+  MEM_SAFE_FREE(compressed_data);
 
   if (bytes_written != 0) {
     /* Last step is writing header, as image data can be overwritten,
@@ -600,17 +627,50 @@ bool seq_disk_cache_write_file(SeqDiskCache *disk_cache, SeqCacheKey *key, ImBuf
      */
     header.entry[entry_index].size_compressed = bytes_written;
     seq_disk_cache_write_header(file, &header);
-    seq_disk_cache_update_file(disk_cache, path);
+    seq_disk_cache_update_file(disk_cache, task->path);
     fclose(file);
 
     BLI_mutex_unlock(&disk_cache->read_write_mutex);
     return true;
   }
 
+  fclose(file);
   BLI_mutex_unlock(&disk_cache->read_write_mutex);
   return false;
 }
 
+static void seq_disk_cache_write_task_run(TaskPool *__restrict pool, void *taskdata)
+{
+  SeqDiskCache *disk_cache = BLI_task_pool_user_data(pool);
+  if (seq_disk_cache_write_task_exec(disk_cache, taskdata)) {
+    seq_disk_cache_enforce_limits(disk_cache);
+  }
+}
+
+static void seq_disk_cache_write_task_free(TaskPool *__restrict UNUSED(pool), void *taskdata)
+{
+  DiskCacheWriteTask *task = taskdata;
+  IMB_freeImBuf(task->ibuf);
+  MEM_freeN(task);
+}
+
+bool seq_disk_cache_write_file(SeqDiskCache *disk_cache, SeqCacheKey *key, ImBuf *ibuf)
+{
+  DiskCacheWriteTask *task = MEM_mallocN(sizeof(*task), "DiskCacheWriteTask");
+  /* The strip may be gone by the time the task runs, so resolve its path now. */
+  seq_disk_cache_get_file_path(disk_cache, key, task->path, sizeof(task->path));
+  task->frameno = key->frame_index;
+  task->ibuf = ibuf;
+  IMB_refImBuf(ibuf);
+
+  BLI_task_pool_push(disk_cache->write_pool,
+                     seq_disk_cache_write_task_run,
+                     task,
+                     false,
+                     seq_disk_cache_write_task_free);
+  return true;
+}
+
 ImBuf *seq_disk_cache_read_file(SeqDiskCache *disk_cache, SeqCacheKey *key)
 {
   BLI_mutex_lock(&disk_cache->read_write_mutex);
@@ -641,20 +701,21 @@ ImBuf *seq_disk_cache_read_file(SeqDiskCache *disk_cache, SeqCacheKey *key)
     return NULL;
   }
 
+  DiskCacheHeaderEntry *header_entry = &header.entry[entry_index];
   ImBuf *ibuf;
   uint64_t size_char = (uint64_t)key->context.rectx * key->context.recty * 4;
   uint64_t size_float = (uint64_t)key->context.rectx * key->context.recty * 16;
   size_t expected_size;
 
-  if (header.entry[entry_index].size_raw == size_char) {
+  if (header_entry->size_raw == size_char) {
     expected_size = size_char;
     ibuf = IMB_allocImBuf(key->context.rectx, key->context.recty, 32, IB_rect);
-    IMB_colormanagement_assign_rect_colorspace(ibuf, header.entry[entry_index].colorspace_name);
+    IMB_colormanagement_assign_rect_colorspace(ibuf, header_entry->colorspace_name);
   }
-  else if (header.entry[entry_index].size_raw == size_float) {
+  else if (header_entry->size_raw == size_float) {
     expected_size = size_float;
     ibuf = IMB_allocImBuf(key->context.rectx, key->context.recty, 32, IB_rectfloat);
-    IMB_colormanagement_assign_float_colorspace(ibuf, header.entry[entry_index].colorspace_name);
+    IMB_colormanagement_assign_float_colorspace(ibuf, header_entry->colorspace_name);
   }
   else {
     fclose(file);
@@ -662,20 +723,51 @@ ImBuf *seq_disk_cache_read_file(SeqDiskCache *disk_cache, SeqCacheKey *key)
     return NULL;
   }
 
-  size_t bytes_read = inflate_file_to_imbuf(ibuf, file, &header.entry[entry_index]);
+  void *data = (ibuf->rect != NULL) ? (void *)ibuf->rect : (void *)ibuf->rect_float;
+  void *compressed_data = NULL;
+  size_t bytes_read = 0;
+  char magic[4];
+
+  /* Check if the data is compressed or raw. Compressed data is only read here, decompressing it
+   * doesn't need the lock. */
+  fseek(file, header_entry->offset, SEEK_SET);
+  if (fread(magic, 1, sizeof(magic), file) == sizeof(magic)) {
+    fseek(file, header_entry->offset, SEEK_SET);
+    if (BLI_file_magic_is_zstd(magic)) {
+      compressed_data = MEM_mallocN(header_entry->size_compressed, __func__);
+      if (fread(compressed_data, 1, header_entry->size_compressed, file) !=
+          header_entry->size_compressed) {
+        MEM_SAFE_FREE(compressed_data);
+      }
+    }
+    else {
+      bytes_read = fread(data, 1, header_entry->size_raw, file);
+    }
+  }
+
+  if (bytes_read == expected_size || compressed_data) {
+    BLI_file_touch(path);
+    seq_disk_cache_update_file(disk_cache, path);
+  }
+  fclose(file);
+
+  BLI_mutex_unlock(&disk_cache->read_write_mutex);
+
+  if (compressed_data) {
+    bytes_read = ZSTD_decompress(
+        data, header_entry->size_raw, compressed_data, header_entry->size_compressed);
+    if (ZSTD_isError(bytes_read)) {
+      bytes_read = 0;
+    }
+    MEM_freeN(compressed_data);
+  }
 
   /* Sanity check. */
   if (bytes_read != expected_size) {
-    fclose(file);
     IMB_freeImBuf(ibuf);
-    BLI_mutex_unlock(&disk_cache->read_write_mutex);
     return NULL;
   }
-  BLI_file_touch(path);
-  seq_disk_cache_update_file(disk_cache, path);
-  fclose(file);
 
-  BLI_mutex_unlock(&disk_cache->read_write_mutex);
   return ibuf;
 }
 
@@ -684,6 +776,7 @@ SeqDiskCache *seq_disk_cache_create(Main *bmain, Scene *scene)
   SeqDiskCache *disk_cache = MEM_callocN(sizeof(SeqDiskCache), "SeqDiskCache");
   disk_cache->bmain = bmain;
   BLI_mutex_init(&disk_cache->read_write_mutex);
+  disk_cache->write_pool = BLI_task_pool_create_background(disk_cache, TASK_PRIORITY_LOW);
   seq_disk_cache_handle_versioning(disk_cache);
   seq_disk_cache_get_files(disk_cache, seq_disk_cache_base_dir());
   disk_cache->timestamp = scene->ed->disk_cache_timestamp;
@@ -693,6 +786,8 @@ SeqDiskCache *seq_disk_cache_create(Main *bmain, Scene *scene)
 
 void seq_disk_cache_free(SeqDiskCache *disk_cache)
 {
+  BLI_task_pool_cancel(disk_cache->write_pool);
+  BLI_task_pool_free(disk_cache->write_pool);
   BLI_freelistN(&disk_cache->files);
   BLI_mutex_end(&disk_cache->read_write_mutex);
   MEM_freeN(disk_cache);
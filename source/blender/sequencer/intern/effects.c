@@ -2786,11 +2786,10 @@ static void do_gaussian_blur_effect_byte_x(Sequence *seq,
       float accum[4] = {0.0f, 0.0f, 0.0f, 0.0f};
       float accum_weight = 0.0f;
 
-      for (int current_x = j - size_x; current_x <= j + size_x; current_x++) {
-        if (current_x < 0 || current_x >= frame_width) {
-          /* Out of bounds. */
-          continue;
-        }
+      /* Only pixels within bounds. */
+      const int min_x = max_ii(j - size_x, 0);
+      const int max_x = min_ii(j + size_x, frame_width - 1);
+      for (int current_x = min_x; current_x <= max_x; current_x++) {
         int index = INDEX(current_x, i + start_line);
         float weight = gausstab_x[current_x - j + size_x];
         accum[0] += rect[index] * weight;
@@ -2812,6 +2811,8 @@ static void do_gaussian_blur_effect_byte_x(Sequence *seq,
 #undef INDEX
 }
 
+/* The vertical pass accumulates whole rows instead of going down columns of the image, which
+ * reads memory in order. Pixels are accumulated in the same order, giving the same result. */
 static void do_gaussian_blur_effect_byte_y(Sequence *seq,
                                            int start_line,
                                            int x,
@@ -2824,38 +2825,39 @@ static void do_gaussian_blur_effect_byte_y(Sequence *seq,
 #define INDEX(_x, _y) (((_y) * (x) + (_x)) * 4)
   GaussianBlurVars *data = seq->effectdata;
   const int size_y = (int)(data->size_y + 0.5f);
-  int i, j;
+  const int row_len = x * 4;
+  int i, k;
 
   /* Make gaussian weight table. */
   float *gausstab_y;
   gausstab_y = make_gaussian_blur_kernel(data->size_y, size_y);
 
+  float *accum = (float *)MEM_mallocN(sizeof(float) * row_len, __func__);
+
   for (i = 0; i < y; i++) {
-    for (j = 0; j < x; j++) {
-      int out_index = INDEX(j, i);
-      float accum[4] = {0.0f, 0.0f, 0.0f, 0.0f};
-      float accum_weight = 0.0f;
-      for (int current_y = i - size_y; current_y <= i + size_y; current_y++) {
-        if (current_y < -start_line || current_y + start_line >= frame_height) {
-          /* Out of bounds. */
-          continue;
-        }
-        int index = INDEX(j, current_y + start_line);
-        float weight = gausstab_y[current_y - i + size_y];
-        accum[0] += rect[index] * weight;
-        accum[1] += rect[index + 1] * weight;
-        accum[2] += rect[index + 2] * weight;
-        accum[3] += rect[index + 3] * weight;
-        accum_weight += weight;
-      }
-      float inv_accum_weight = 1.0f / accum_weight;
-      out[out_index + 0] = accum[0] * inv_accum_weight;
-      out[out_index + 1] = accum[1] * inv_accum_weight;
-      out[out_index + 2] = accum[2] * inv_accum_weight;
-      out[out_index + 3] = accum[3] * inv_accum_weight;
+    float accum_weight = 0.0f;
+    memset(accum, 0, sizeof(float) * row_len);
+
+    /* Only rows within bounds. */
+    const int min_y = max_ii(i - size_y, -start_line);
+    const int max_y = min_ii(i + size_y, frame_height - start_line - 1);
+    for (int current_y = min_y; current_y <= max_y; current_y++) {
+      const unsigned char *row = &rect[INDEX(0, current_y + start_line)];
+      float weight = gausstab_y[current_y - i + size_y];
+      for (k = 0; k < row_len; k++) {
+        accum[k] += row[k] * weight;
+      }
+      accum_weight += weight;
+    }
+
+    float inv_accum_weight = 1.0f / accum_weight;
+    unsigned char *out_row = &out[INDEX(0, i)];
+    for (k = 0; k < row_len; k++) {
+      out_row[k] = accum[k] * inv_accum_weight;
     }
   }
 
+  MEM_freeN(accum);
   MEM_freeN(gausstab_y);
 #undef INDEX
 }
@@ -2883,11 +2885,11 @@ static void do_gaussian_blur_effect_float_x(Sequence *seq,
       int out_index = INDEX(j, i);
       float accum[4] = {0.0f, 0.0f, 0.0f, 0.0f};
       float accum_weight = 0.0f;
-      for (int current_x = j - size_x; current_x <= j + size_x; current_x++) {
-        if (current_x < 0 || current_x >= frame_width) {
-          /* Out of bounds. */
-          continue;
-        }
+
+      /* Only pixels within bounds. */
+      const int min_x = max_ii(j - size_x, 0);
+      const int max_x = min_ii(j + size_x, frame_width - 1);
+      for (int current_x = min_x; current_x <= max_x; current_x++) {
         int index = INDEX(current_x, i + start_line);
         float weight = gausstab_x[current_x - j + size_x];
         madd_v4_v4fl(accum, &rect[index], weight);
@@ -2901,6 +2903,7 @@ static void do_gaussian_blur_effect_float_x(Sequence *seq,
 #undef INDEX
 }
 
+/* See #do_gaussian_blur_effect_byte_y. */
 static void do_gaussian_blur_effect_float_y(Sequence *seq,
                                             int start_line,
                                             int x,
@@ -2913,28 +2916,33 @@ static void do_gaussian_blur_effect_float_y(Sequence *seq,
 #define INDEX(_x, _y) (((_y) * (x) + (_x)) * 4)
   GaussianBlurVars *data = seq->effectdata;
   const int size_y = (int)(data->size_y + 0.5f);
-  int i, j;
+  const int row_len = x * 4;
+  int i, k;
 
   /* Make gaussian weight table. */
   float *gausstab_y;
   gausstab_y = make_gaussian_blur_kernel(data->size_y, size_y);
 
   for (i = 0; i < y; i++) {
-    for (j = 0; j < x; j++) {
-      int out_index = INDEX(j, i);
-      float accum[4] = {0.0f, 0.0f, 0.0f, 0.0f};
-      float accum_weight = 0.0f;
-      for (int current_y = i - size_y; current_y <= i + size_y; current_y++) {
-        if (current_y < -start_line || current_y + start_line >= frame_height) {
-          /* Out of bounds. */
-          continue;
-        }
-        int index = INDEX(j, current_y + start_line);
-        float weight = gausstab_y[current_y - i + size_y];
-        madd_v4_v4fl(accum, &rect[index], weight);
-        accum_weight += weight;
-      }
-      mul_v4_v4fl(&out[out_index], accum, 1.0f / accum_weight);
+    float *accum = &out[INDEX(0, i)];
+    float accum_weight = 0.0f;
+    memset(accum, 0, sizeof(float) * row_len);
+
+    /* Only rows within bounds. */
+    const int min_y = max_ii(i - size_y, -start_line);
+    const int max_y = min_ii(i + size_y, frame_height - start_line - 1);
+    for (int current_y = min_y; current_y <= max_y; current_y++) {
+      const float *row = &rect[INDEX(0, current_y + start_line)];
+      float weight = gausstab_y[current_y - i + size_y];
+      for (k = 0; k < row_len; k++) {
+        accum[k] += row[k] * weight;
+      }
+      accum_weight += weight;
+    }
+
+    float inv_accum_weight = 1.0f / accum_weight;
+    for (k = 0; k < row_len; k++) {
+      accum[k] *= inv_accum_weight;
     }
   }
 
@@ -20,9 +20,11 @@
  * \ingroup bke
  */
 
+#include <math.h>
 #include <memory.h>
 #include <stddef.h>
 #include <time.h>
+#include <zstd.h>
 
 #include "MEM_guardedalloc.h"
 
@@ -43,6 +45,7 @@
 #include "BLI_listbase.h"
 #include "BLI_mempool.h"
 #include "BLI_path_util.h"
+#include "BLI_task.h"
 #include "BLI_threads.h"
 
 #include "BKE_main.h"
@@ -80,10 +83,19 @@
  * entries one by one in reverse order to their creation.
  *
  * User can exclude caching of some images. Such entries will have is_temp_cache set.
+ *
+ * Compression: When enabled in the preferences, the pixels of the permanent entries furthest
+ * from the current frame are compressed before any frame is freed, so that more frames fit in
+ * the cache. Compression is lossless and entries are decompressed when they are requested.
  */
 
 #define THUMB_CACHE_LIMIT 5000
 
+/* Compressed pixels are split in pages, so that they are compressed in parallel. */
+#define SEQ_CACHE_PAGE_SIZE (1 << 20)
+/* Favor speed, pages are decompressed whenever the frame is needed again. */
+#define SEQ_CACHE_COMPRESSION_LEVEL 1
+
 typedef struct SeqCache {
   Main *bmain;
   struct GHash *hash;
@@ -95,9 +107,20 @@ typedef struct SeqCache {
   int thumbnail_count;
 } SeqCache;
 
+typedef struct SeqCachePage {
+  void *data;
+  size_t data_size;
+  /* Pages which don't compress are stored as they are. */
+  bool is_compressed;
+} SeqCachePage;
+
 typedef struct SeqCacheItem {
   struct SeqCache *cache_owner;
   struct ImBuf *ibuf;
+  /* Pixels of the image while it is compressed, its pixel buffer is freed meanwhile. */
+  SeqCachePage *pages;
+  int pages_num;
+  size_t pixels_size;
 } SeqCacheItem;
 
 static ThreadMutex cache_create_lock = BLI_MUTEX_INITIALIZER;
@@ -201,10 +224,21 @@ static void seq_cache_keyfree(void *val)
   BLI_mempool_free(key->cache_owner->keys_pool, key);
 }
 
+static void seq_cache_item_free_pages(SeqCacheItem *item)
+{
+  for (int i = 0; i < item->pages_num; i++) {
+    MEM_freeN(item->pages[i].data);
+  }
+  MEM_SAFE_FREE(item->pages);
+  item->pages_num = 0;
+}
+
 static void seq_cache_valfree(void *val)
 {
   SeqCacheItem *item = (SeqCacheItem *)val;
 
+  seq_cache_item_free_pages(item);
+
   if (item->ibuf) {
     IMB_freeImBuf(item->ibuf);
   }
@@ -235,6 +269,9 @@ static void seq_cache_put_ex(Scene *scene, SeqCacheKey *key, ImBuf *ibuf)
   item = BLI_mempool_alloc(cache->items_pool);
   item->cache_owner = cache;
   item->ibuf = ibuf;
+  item->pages = NULL;
+  item->pages_num = 0;
+  item->pixels_size = 0;
 
   const int stored_types_flag = get_stored_types_flag(scene, key);
 
@@ -268,10 +305,183 @@ static void seq_cache_put_ex(Scene *scene, SeqCacheKey *key, ImBuf *ibuf)
   }
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Compression
+ * \{ */
+
+typedef struct SeqCachePageData {
+  SeqCachePage *pages;
+  void *pixels;
+  size_t pixels_size;
+} SeqCachePageData;
+
+static size_t seq_cache_page_size(const SeqCachePageData *data, const int page_index)
+{
+  const size_t offset = (size_t)page_index * SEQ_CACHE_PAGE_SIZE;
+  return MIN2(SEQ_CACHE_PAGE_SIZE, data->pixels_size - offset);
+}
+
+static void seq_cache_compress_page(void *__restrict userdata,
+                                    const int page_index,
+                                    const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const SeqCachePageData *data = userdata;
+  SeqCachePage *page = &data->pages[page_index];
+  const void *src = POINTER_OFFSET(data->pixels, (size_t)page_index * SEQ_CACHE_PAGE_SIZE);
+  const size_t src_size = seq_cache_page_size(data, page_index);
+
+  const size_t buffer_size = ZSTD_compressBound(src_size);
+  void *buffer = MEM_mallocN(buffer_size, __func__);
+  const size_t compressed_size = ZSTD_compress(
+      buffer, buffer_size, src, src_size, SEQ_CACHE_COMPRESSION_LEVEL);
+
+  if (ZSTD_isError(compressed_size) || compressed_size >= src_size) {
+    page->data = MEM_mallocN(src_size, __func__);
+    memcpy(page->data, src, src_size);
+    page->data_size = src_size;
+    page->is_compressed = false;
+  }
+  else {
+    page->data = MEM_mallocN(compressed_size, __func__);
+    memcpy(page->data, buffer, compressed_size);
+    page->data_size = compressed_size;
+    page->is_compressed = true;
+  }
+
+  MEM_freeN(buffer);
+}
+
+static void seq_cache_decompress_page(void *__restrict userdata,
+                                      const int page_index,
+                                      const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const SeqCachePageData *data = userdata;
+  const SeqCachePage *page = &data->pages[page_index];
+  void *dst = POINTER_OFFSET(data->pixels, (size_t)page_index * SEQ_CACHE_PAGE_SIZE);
+  const size_t dst_size = seq_cache_page_size(data, page_index);
+
+  if (!page->is_compressed) {
+    memcpy(dst, page->data, dst_size);
+    return;
+  }
+
+  const size_t decompressed_size = ZSTD_decompress(dst, dst_size, page->data, page->data_size);
+  BLI_assert(decompressed_size == dst_size);
+  UNUSED_VARS_NDEBUG(decompressed_size);
+}
+
+static bool seq_cache_compression_is_enabled(void)
+{
+  return (U.sequencer_flag & USER_SEQ_CACHE_COMPRESS) != 0;
+}
+
+/* Only images owned by the cache alone with a single pixel buffer are compressed. */
+static bool seq_cache_item_can_compress(const SeqCacheKey *key, const SeqCacheItem *item)
+{
+  const ImBuf *ibuf = item->ibuf;
+  if (key->is_temp_cache || key->type == SEQ_CACHE_STORE_THUMBNAIL || ibuf == NULL ||
+      item->pages != NULL) {
+    return false;
+  }
+  if (ibuf->refcounter != 0 || ibuf->zbuf != NULL || ibuf->zbuf_float != NULL) {
+    return false;
+  }
+  if (ibuf->rect_float != NULL) {
+    return ibuf->rect == NULL && (ibuf->mall & IB_rectfloat);
+  }
+  return ibuf->rect != NULL && (ibuf->mall & IB_rect);
+}
+
+static void seq_cache_item_compress(SeqCacheItem *item)
+{
+  ImBuf *ibuf = item->ibuf;
+  void *pixels;
+  if (ibuf->rect_float) {
+    pixels = ibuf->rect_float;
+    item->pixels_size = sizeof(float) * ibuf->channels * ibuf->x * ibuf->y;
+  }
+  else {
+    pixels = ibuf->rect;
+    item->pixels_size = sizeof(uint) * ibuf->x * ibuf->y;
+  }
+
+  item->pages_num = (int)((item->pixels_size + SEQ_CACHE_PAGE_SIZE - 1) / SEQ_CACHE_PAGE_SIZE);
+  item->pages = MEM_callocN(sizeof(*item->pages) * item->pages_num, "SeqCachePage");
+
+  SeqCachePageData data = {item->pages, pixels, item->pixels_size};
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1;
+  BLI_task_parallel_range(0, item->pages_num, &data, seq_cache_compress_page, &settings);
+
+  MEM_freeN(pixels);
+  ibuf->rect_float = NULL;
+  ibuf->rect = NULL;
+}
+
+static void seq_cache_item_decompress(SeqCacheItem *item)
+{
+  ImBuf *ibuf = item->ibuf;
+  void *pixels = MEM_mallocN(item->pixels_size, "SeqCache pixels");
+
+  SeqCachePageData data = {item->pages, pixels, item->pixels_size};
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1;
+  BLI_task_parallel_range(0, item->pages_num, &data, seq_cache_decompress_page, &settings);
+
+  if (ibuf->mall & IB_rectfloat) {
+    ibuf->rect_float = pixels;
+  }
+  else {
+    ibuf->rect = pixels;
+  }
+
+  seq_cache_item_free_pages(item);
+}
+
+/* Compress the permanent entry furthest from the current frame. Returns false when there is no
+ * entry left to compress. */
+static bool seq_cache_compress_item(Scene *scene)
+{
+  SeqCache *cache = seq_cache_get_from_scene(scene);
+  SeqCacheItem *finalitem = NULL;
+  float max_distance = -1.0f;
+
+  GHashIterator gh_iter;
+  GHASH_ITER (gh_iter, cache->hash) {
+    SeqCacheKey *key = BLI_ghashIterator_getKey(&gh_iter);
+    SeqCacheItem *item = BLI_ghashIterator_getValue(&gh_iter);
+
+    if (!seq_cache_item_can_compress(key, item)) {
+      continue;
+    }
+
+    const float distance = fabsf(key->timeline_frame - (float)scene->r.cfra);
+    if (distance > max_distance) {
+      max_distance = distance;
+      finalitem = item;
+    }
+  }
+
+  if (finalitem == NULL) {
+    return false;
+  }
+
+  seq_cache_item_compress(finalitem);
+  return true;
+}
+
+/** \} */
+
 static ImBuf *seq_cache_get_ex(SeqCache *cache, SeqCacheKey *key)
 {
   SeqCacheItem *item = BLI_ghash_lookup(cache->hash, key);
 
+  if (item && item->pages) {
+    seq_cache_item_decompress(item);
+  }
+
   if (item && item->ibuf) {
     IMB_refImBuf(item->ibuf);
 
@@ -463,6 +673,10 @@ bool seq_cache_recycle_item(Scene *scene)
   seq_cache_lock(scene);
 
   while (seq_cache_is_full()) {
+    if (seq_cache_compression_is_enabled() && seq_cache_compress_item(scene)) {
+      continue;
+    }
+
     SeqCacheKey *finalkey = seq_cache_get_item_for_removal(scene);
 
     if (finalkey) {
@@ -891,11 +1105,11 @@ void seq_cache_put(
   if (!key->is_temp_cache) {
     if (seq_disk_cache_is_enabled(context->bmain)) {
       if (cache->disk_cache == NULL) {
-        seq_disk_cache_create(context->bmain, context->scene);
+        cache->disk_cache = seq_disk_cache_create(context->bmain, context->scene);
       }
 
+      /* Written in the background, the size limit is enforced after writing. */
       seq_disk_cache_write_file(cache->disk_cache, key, i);
-      seq_disk_cache_enforce_limits(cache->disk_cache);
     }
   }
 }
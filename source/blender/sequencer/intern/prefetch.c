@@ -34,11 +34,14 @@
 #include "DNA_windowmanager_types.h"
 
 #include "BLI_listbase.h"
+#include "BLI_math_base.h"
 #include "BLI_threads.h"
 
 #include "IMB_imbuf.h"
 #include "IMB_imbuf_types.h"
 
+#include "PIL_time.h"
+
 #include "BKE_anim_data.h"
 #include "BKE_animsys.h"
 #include "BKE_context.h"
@@ -86,6 +89,8 @@ typedef struct PrefetchJob {
   /* prefetch area */
   float cfra;
   int num_frames_prefetched;
+  /* Average time to render a frame, in seconds. */
+  double avg_frame_render_time;
 
   /* control */
   bool running;
@@ -460,6 +465,27 @@ static bool seq_prefetch_must_skip_frame(PrefetchJob *pfjob, ListBase *seqbase)
   return false;
 }
 
+/* Number of frames ahead of the current frame which prefetch can render during playback, before
+ * playback reaches them. Frames in between are rendered by playback itself. */
+static int seq_prefetch_playback_lead(PrefetchJob *pfjob)
+{
+  const Scene *scene = pfjob->scene;
+  const double frames_per_render = pfjob->avg_frame_render_time * FPS;
+  /* Playback renders the frames it doesn't find in the cache with the same lock as prefetch,
+   * leave time for both. */
+  return max_ii(2, (int)ceil(2.0 * frames_per_render) + 1);
+}
+
+static void seq_prefetch_update_render_time(PrefetchJob *pfjob, const double render_time)
+{
+  if (pfjob->avg_frame_render_time == 0.0) {
+    pfjob->avg_frame_render_time = render_time;
+  }
+  else {
+    pfjob->avg_frame_render_time = 0.8 * pfjob->avg_frame_render_time + 0.2 * render_time;
+  }
+}
+
 static bool seq_prefetch_need_suspend(PrefetchJob *pfjob)
 {
   return seq_prefetch_is_cache_full(pfjob->scene) || seq_prefetch_is_scrubbing(pfjob->bmain) ||
@@ -506,20 +532,30 @@ static void *seq_prefetch_frames(void *job)
       continue;
     }
 
+    const double start_time = PIL_check_seconds_timer();
     ImBuf *ibuf = SEQ_render_give_ibuf(&pfjob->context_cpy, seq_prefetch_cfra(pfjob), 0);
     seq_cache_free_temp_cache(pfjob->scene, pfjob->context.task_id, seq_prefetch_cfra(pfjob));
     IMB_freeImBuf(ibuf);
+    seq_prefetch_update_render_time(pfjob, PIL_check_seconds_timer() - start_time);
 
     /* Suspend thread if there is nothing to be prefetched. */
     seq_prefetch_do_suspend(pfjob);
 
-    /* Avoid "collision" with main thread, but make sure to fetch at least few frames */
-    if (pfjob->num_frames_prefetched > 5 &&
-        (seq_prefetch_cfra(pfjob) - pfjob->scene->r.cfra) < 2) {
+    if (!(pfjob->scene->ed->cache_flag & SEQ_CACHE_PREFETCH_ENABLE) || pfjob->stop) {
       break;
     }
 
-    if (!(pfjob->scene->ed->cache_flag & SEQ_CACHE_PREFETCH_ENABLE) || pfjob->stop) {
+    /* During playback, skip ahead to frames which can be rendered before playback reaches them,
+     * instead of rendering the same frames as playback. */
+    const bool is_caught_up = (seq_prefetch_cfra(pfjob) - pfjob->scene->r.cfra) < 2;
+    if (is_caught_up && seq_prefetch_is_playing(pfjob->bmain)) {
+      pfjob->cfra = pfjob->scene->r.cfra;
+      pfjob->num_frames_prefetched = seq_prefetch_playback_lead(pfjob);
+      continue;
+    }
+
+    /* Avoid "collision" with main thread, but make sure to fetch at least few frames */
+    if (pfjob->num_frames_prefetched > 5 && is_caught_up) {
       break;
     }
 
@@ -32,6 +32,7 @@
 #include "DNA_mask_types.h"
 #include "DNA_scene_types.h"
 #include "DNA_sequence_types.h"
+#include "DNA_userdef_types.h"
 
 #include "BLI_blenlib.h"
 
@@ -264,6 +265,18 @@ ListBase *SEQ_get_seqbase_from_sequence(Sequence *seq, int *r_offset)
   return seqbase;
 }
 
+int seq_anim_ib_flags(const Sequence *seq)
+{
+  int flags = IB_rect;
+  if (seq->flag & SEQ_FILTERY) {
+    flags |= IB_animdeinterlace;
+  }
+  if (U.sequencer_flag & USER_SEQ_HW_DECODE) {
+    flags |= IB_animhwdecode;
+  }
+  return flags;
+}
+
 void seq_open_anim_file(Scene *scene, Sequence *seq, bool openfile)
 {
   char dir[FILE_MAX];
@@ -325,14 +338,13 @@ void seq_open_anim_file(Scene *scene, Sequence *seq, bool openfile)
 
         if (openfile) {
           sanim->anim = openanim(str,
-                                 IB_rect | ((seq->flag & SEQ_FILTERY) ? IB_animdeinterlace : 0),
+                                 seq_anim_ib_flags(seq),
                                  seq->streamindex,
                                  seq->strip->colorspace_settings.name);
         }
         else {
           sanim->anim = openanim_noload(str,
-                                        IB_rect |
-                                            ((seq->flag & SEQ_FILTERY) ? IB_animdeinterlace : 0),
+                                        seq_anim_ib_flags(seq),
                                         seq->streamindex,
                                         seq->strip->colorspace_settings.name);
         }
@@ -344,14 +356,13 @@ void seq_open_anim_file(Scene *scene, Sequence *seq, bool openfile)
         else {
           if (openfile) {
             sanim->anim = openanim(name,
-                                   IB_rect | ((seq->flag & SEQ_FILTERY) ? IB_animdeinterlace : 0),
+                                   seq_anim_ib_flags(seq),
                                    seq->streamindex,
                                    seq->strip->colorspace_settings.name);
           }
           else {
             sanim->anim = openanim_noload(name,
-                                          IB_rect |
-                                              ((seq->flag & SEQ_FILTERY) ? IB_animdeinterlace : 0),
+                                          seq_anim_ib_flags(seq),
                                           seq->streamindex,
                                           seq->strip->colorspace_settings.name);
           }
@@ -376,13 +387,13 @@ void seq_open_anim_file(Scene *scene, Sequence *seq, bool openfile)
 
     if (openfile) {
       sanim->anim = openanim(name,
-                             IB_rect | ((seq->flag & SEQ_FILTERY) ? IB_animdeinterlace : 0),
+                             seq_anim_ib_flags(seq),
                              seq->streamindex,
                              seq->strip->colorspace_settings.name);
     }
     else {
       sanim->anim = openanim_noload(name,
-                                    IB_rect | ((seq->flag & SEQ_FILTERY) ? IB_animdeinterlace : 0),
+                                    seq_anim_ib_flags(seq),
                                     seq->streamindex,
                                     seq->strip->colorspace_settings.name);
     }
@@ -27,10 +27,12 @@
 extern "C" {
 #endif
 
-struct Scene;
 struct ListBase;
+struct Scene;
+struct Sequence;
 
 bool sequencer_seq_generates_image(struct Sequence *seq);
+int seq_anim_ib_flags(const struct Sequence *seq);
 void seq_open_anim_file(struct Scene *scene, struct Sequence *seq, bool openfile);
 Sequence *SEQ_get_meta_by_seqbase(struct ListBase *seqbase_main, struct ListBase *meta_seqbase);
 
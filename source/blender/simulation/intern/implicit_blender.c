@@ -34,6 +34,7 @@
 #  include "DNA_texture_types.h"
 
 #  include "BLI_math.h"
+#  include "BLI_task.h"
 #  include "BLI_utildefines.h"
 
 #  include "BKE_cloth.h"
@@ -644,6 +645,123 @@ DO_INLINE void mul_bfmatrix_lfvector(float (*to)[3], fmatrix3x3 *from, lfVector
   del_lfvector(temp);
 }
 
+/**
+ * For every vertex, the off-diagonal blocks of a big matrix in which it is the row and the
+ * column, in block order. Lets #mul_bfmatrix_lfvector_parallel compute every vertex of the result
+ * independently, instead of scattering the contribution of each block to two vertices.
+ */
+typedef struct BFMatrixVertexBlocks {
+  /* Blocks of vertex `v` are `row_blocks[row_offsets[v]]` to `row_blocks[row_offsets[v + 1]]`. */
+  unsigned int *row_offsets;
+  unsigned int *row_blocks;
+  unsigned int *col_offsets;
+  unsigned int *col_blocks;
+} BFMatrixVertexBlocks;
+
+static void create_bfmatrix_vertex_blocks(BFMatrixVertexBlocks *vblocks,
+                                          unsigned int verts,
+                                          unsigned int springs)
+{
+  vblocks->row_offsets = MEM_mallocN(sizeof(unsigned int) * (verts + 1), __func__);
+  vblocks->col_offsets = MEM_mallocN(sizeof(unsigned int) * (verts + 1), __func__);
+  vblocks->row_blocks = MEM_mallocN(sizeof(unsigned int) * max_ii(springs, 1), __func__);
+  vblocks->col_blocks = MEM_mallocN(sizeof(unsigned int) * max_ii(springs, 1), __func__);
+}
+
+static void del_bfmatrix_vertex_blocks(BFMatrixVertexBlocks *vblocks)
+{
+  MEM_freeN(vblocks->row_offsets);
+  MEM_freeN(vblocks->col_offsets);
+  MEM_freeN(vblocks->row_blocks);
+  MEM_freeN(vblocks->col_blocks);
+}
+
+/* Sort the block indices by vertex (counting sort, keeps the block order for every vertex). */
+static void bfmatrix_vertex_blocks_sort(unsigned int *offsets,
+                                        unsigned int *blocks,
+                                        const fmatrix3x3 *matrix,
+                                        const bool use_row)
+{
+  const unsigned int vcount = matrix[0].vcount;
+  const unsigned int scount = matrix[0].scount;
+
+  memset(offsets, 0, sizeof(unsigned int) * (vcount + 1));
+  for (unsigned int i = vcount; i < vcount + scount; i++) {
+    offsets[(use_row ? matrix[i].r : matrix[i].c) + 1]++;
+  }
+  for (unsigned int v = 0; v < vcount; v++) {
+    offsets[v + 1] += offsets[v];
+  }
+  for (unsigned int i = vcount; i < vcount + scount; i++) {
+    blocks[offsets[use_row ? matrix[i].r : matrix[i].c]++] = i;
+  }
+  /* Filling moved every offset to the start of the next vertex. */
+  for (unsigned int v = vcount; v > 0; v--) {
+    offsets[v] = offsets[v - 1];
+  }
+  offsets[0] = 0;
+}
+
+/* Update the vertex blocks from the row and column indices of the blocks of `matrix`. */
+static void update_bfmatrix_vertex_blocks(BFMatrixVertexBlocks *vblocks, const fmatrix3x3 *matrix)
+{
+  bfmatrix_vertex_blocks_sort(vblocks->row_offsets, vblocks->row_blocks, matrix, true);
+  bfmatrix_vertex_blocks_sort(vblocks->col_offsets, vblocks->col_blocks, matrix, false);
+}
+
+typedef struct MulBFMatrixLFVectorData {
+  float (*to)[3];
+  const fmatrix3x3 *from;
+  const lfVector *fLongVector;
+  const BFMatrixVertexBlocks *vblocks;
+} MulBFMatrixLFVectorData;
+
+static void mul_bfmatrix_lfvector_cb(void *__restrict userdata,
+                                     const int v,
+                                     const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const MulBFMatrixLFVectorData *data = userdata;
+  const fmatrix3x3 *from = data->from;
+  const lfVector *fLongVector = data->fLongVector;
+  const BFMatrixVertexBlocks *vblocks = data->vblocks;
+
+  /* Sum in the same order as #mul_bfmatrix_lfvector, so the results are identical. */
+  float col_sum[3] = {0.0f, 0.0f, 0.0f};
+  for (unsigned int k = vblocks->col_offsets[v]; k < vblocks->col_offsets[v + 1]; k++) {
+    const fmatrix3x3 *block = &from[vblocks->col_blocks[k]];
+    muladd_fmatrixT_fvector(col_sum, block->m, fLongVector[block->r]);
+  }
+
+  float row_sum[3] = {0.0f, 0.0f, 0.0f};
+  muladd_fmatrix_fvector(row_sum, from[v].m, fLongVector[v]);
+  for (unsigned int k = vblocks->row_offsets[v]; k < vblocks->row_offsets[v + 1]; k++) {
+    const fmatrix3x3 *block = &from[vblocks->row_blocks[k]];
+    muladd_fmatrix_fvector(row_sum, block->m, fLongVector[block->c]);
+  }
+
+  add_v3_v3v3(data->to[v], col_sum, row_sum);
+}
+
+/* SPARSE SYMMETRIC multiply big matrix with long vector, computing all vertices in parallel.
+ * `vblocks` must be up to date with the block indices of `from`. */
+static void mul_bfmatrix_lfvector_parallel(float (*to)[3],
+                                           const fmatrix3x3 *from,
+                                           const lfVector *fLongVector,
+                                           const BFMatrixVertexBlocks *vblocks)
+{
+  MulBFMatrixLFVectorData data = {
+      .to = to,
+      .from = from,
+      .fLongVector = fLongVector,
+      .vblocks = vblocks,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1024;
+  BLI_task_parallel_range(0, from[0].vcount, &data, mul_bfmatrix_lfvector_cb, &settings);
+}
+
 /* SPARSE SYMMETRIC sub big matrix with big matrix. */
 /* A -= B * float + C * float --> for big matrix */
 /* VERIFIED */
@@ -683,6 +801,8 @@ typedef struct Implicit_Data {
   lfVector *z;          /* target velocity in constrained directions */
   fmatrix3x3 *S;        /* filtering matrix for constraints */
   fmatrix3x3 *P, *Pinv; /* pre-conditioning matrix */
+
+  BFMatrixVertexBlocks vblocks; /* blocks of each vertex in A and dFdX */
 } Implicit_Data;
 
 Implicit_Data *SIM_mass_spring_solver_create(int numverts, int numsprings)
@@ -708,6 +828,8 @@ Implicit_Data *SIM_mass_spring_solver_create(int numverts, int numsprings)
   id->dV = create_lfvector(numverts);
   id->z = create_lfvector(numverts);
 
+  create_bfmatrix_vertex_blocks(&id->vblocks, numverts, numsprings);
+
   initdiag_bfmatrix(id->bigI, I);
 
   return id;
@@ -734,6 +856,8 @@ void SIM_mass_spring_solver_free(Implicit_Data *id)
   del_lfvector(id->dV);
   del_lfvector(id->z);
 
+  del_bfmatrix_vertex_blocks(&id->vblocks);
+
   MEM_freeN(id);
 }
 
@@ -855,6 +979,7 @@ static int cg_filtered(lfVector *ldV,
                        lfVector *lB,
                        lfVector *z,
                        fmatrix3x3 *S,
+                       const BFMatrixVertexBlocks *vblocks,
                        ImplicitSolverResult *result)
 {
   /* Solves for unknown X in equation AX=B */
@@ -879,7 +1004,7 @@ static int cg_filtered(lfVector *ldV,
   delta_target = conjgrad_epsilon * conjgrad_epsilon * bnorm2;
 
   /* r = filter(B - A * dV) */
-  mul_bfmatrix_lfvector(AdV, lA, ldV);
+  mul_bfmatrix_lfvector_parallel(AdV, lA, ldV, vblocks);
   sub_lfvector_lfvector(r, lB, AdV, numverts);
   filter(r, S);
 
@@ -902,7 +1027,7 @@ static int cg_filtered(lfVector *ldV,
 #  endif
 
   while (delta_new > delta_target && conjgrad_loopcount < conjgrad_looplimit) {
-    mul_bfmatrix_lfvector(q, lA, c);
+    mul_bfmatrix_lfvector_parallel(q, lA, c, vblocks);
     filter(q, S);
 
     alpha = delta_new / dot_lfvector(c, q, numverts);
@@ -1162,7 +1287,10 @@ bool SIM_mass_spring_solve_velocities(Implicit_Data *data, float dt, ImplicitSol
 
   subadd_bfmatrixS_bfmatrixS(data->A, data->dFdV, dt, data->dFdX, (dt * dt));
 
-  mul_bfmatrix_lfvector(dFdXmV, data->dFdX, data->V);
+  /* A and dFdX have the same blocks. */
+  update_bfmatrix_vertex_blocks(&data->vblocks, data->A);
+
+  mul_bfmatrix_lfvector_parallel(dFdXmV, data->dFdX, data->V, &data->vblocks);
 
   add_lfvectorS_lfvectorS(data->B, data->F, dt, dFdXmV, (dt * dt), numverts);
 
@@ -1171,7 +1299,7 @@ bool SIM_mass_spring_solve_velocities(Implicit_Data *data, float dt, ImplicitSol
 #  endif
 
   /* Conjugate gradient algorithm to solve Ax=b. */
-  cg_filtered(data->dV, data->A, data->B, data->z, data->S, result);
+  cg_filtered(data->dV, data->A, data->B, data->z, data->S, &data->vblocks, result);
 
   // cg_filtered_pre(id->dV, id->A, id->B, id->z, id->S, id->P, id->Pinv, id->bigI);
 
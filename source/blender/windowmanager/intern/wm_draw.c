@@ -37,6 +37,7 @@
 #include "MEM_guardedalloc.h"
 
 #include "BLI_blenlib.h"
+#include "BLI_profile.h"
 #include "BLI_utildefines.h"
 
 #include "BKE_context.h"
@@ -1056,34 +1057,37 @@ void wm_draw_update(bContext *C)
   BKE_image_free_unused_gpu_textures();
 
   LISTBASE_FOREACH (wmWindow *, win, &wm->windows) {
-#ifdef WIN32
-    GHOST_TWindowState state = GHOST_GetWindowState(win->ghostwin);
-
-    if (state == GHOST_kWindowStateMinimized) {
-      /* do not update minimized windows, gives issues on Intel (see T33223)
-       * and AMD (see T50856). it seems logical to skip update for invisible
-       * window anyway.
-       */
+    CTX_wm_window_set(C, win);
+
+    if (!wm_draw_update_test_window(bmain, C, win)) {
       continue;
     }
-#endif
 
-    CTX_wm_window_set(C, win);
+    /* Do not update minimized windows, gives issues on Intel (see T33223) and AMD (see T50856)
+     * on WIN32. Skip them on all platforms since drawing invisible windows only takes time away
+     * from the visible ones (e.g. during playback with many windows open). The draw flags are
+     * kept, so the window is drawn once it's restored.
+     *
+     * Only query the state of windows that need drawing, it's a round-trip to the windowing
+     * system on some platforms. */
+    if (GHOST_GetWindowState(win->ghostwin) == GHOST_kWindowStateMinimized) {
+      continue;
+    }
 
-    if (wm_draw_update_test_window(bmain, C, win)) {
-      bScreen *screen = WM_window_get_active_screen(win);
+    bScreen *screen = WM_window_get_active_screen(win);
 
-      /* sets context window+screen */
-      wm_window_make_drawable(wm, win);
+    /* sets context window+screen */
+    wm_window_make_drawable(wm, win);
 
-      /* notifiers for screen redraw */
-      ED_screen_ensure_updated(wm, win, screen);
+    /* notifiers for screen redraw */
+    ED_screen_ensure_updated(wm, win, screen);
 
-      wm_draw_window(C, win);
-      wm_draw_update_clear_window(C, win);
+    BLI_PROFILE_ZONE_BEGIN(zone, "WM draw window", screen->id.name + 2);
+    wm_draw_window(C, win);
+    wm_draw_update_clear_window(C, win);
 
-      wm_window_swap_buffers(win);
-    }
+    wm_window_swap_buffers(win);
+    BLI_PROFILE_ZONE_END(zone);
   }
 
   CTX_wm_window_set(C, NULL);
@@ -563,6 +563,9 @@ void WM_exit_ex(bContext *C, const bool do_python)
   BKE_blender_free(); /* blender.c, does entire library and spacetypes */
                       //  BKE_material_copybuf_free();
 
+  /* Undo stacks are freed with the window-manager, wait for their memory to be released. */
+  ED_undosys_memfile_free_wait();
+
   /* Free the GPU subdivision data after the database to ensure that subdivision structs used by
    * the modifiers were garbage collected. */
   if (opengl_is_init) {
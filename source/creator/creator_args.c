@@ -37,14 +37,17 @@
 #  include "BLI_listbase.h"
 #  include "BLI_mempool.h"
 #  include "BLI_path_util.h"
+#  include "BLI_profile.h"
 #  include "BLI_string.h"
 #  include "BLI_string_utf8.h"
 #  include "BLI_system.h"
+#  include "BLI_task.h"
 #  include "BLI_threads.h"
 #  include "BLI_utildefines.h"
 
 #  include "BLO_readfile.h" /* only for BLO_has_bfile_extension */
 
+#  include "BKE_blender.h"
 #  include "BKE_blender_version.h"
 #  include "BKE_context.h"
 
@@ -511,12 +514,14 @@ static int arg_handle_print_help(int UNUSED(argc), const char **UNUSED(argv), vo
   BLI_args_print_arg_doc(ba, "--render-anim");
   BLI_args_print_arg_doc(ba, "--scene");
   BLI_args_print_arg_doc(ba, "--render-frame");
+  BLI_args_print_arg_doc(ba, "--render-worker");
   BLI_args_print_arg_doc(ba, "--frame-start");
   BLI_args_print_arg_doc(ba, "--frame-end");
   BLI_args_print_arg_doc(ba, "--frame-jump");
   BLI_args_print_arg_doc(ba, "--render-output");
   BLI_args_print_arg_doc(ba, "--engine");
   BLI_args_print_arg_doc(ba, "--threads");
+  BLI_args_print_arg_doc(ba, "--threads-numa");
 
   printf("\n");
   printf("Format Options:\n");
@@ -550,6 +555,7 @@ static int arg_handle_print_help(int UNUSED(argc), const char **UNUSED(argv), vo
   BLI_args_print_arg_doc(ba, "--python-console");
   BLI_args_print_arg_doc(ba, "--python-exit-code");
   BLI_args_print_arg_doc(ba, "--python-use-system-env");
+  BLI_args_print_arg_doc(ba, "--python-cache-dir");
   BLI_args_print_arg_doc(ba, "--addons");
 
   printf("\n");
@@ -599,6 +605,9 @@ static int arg_handle_print_help(int UNUSED(argc), const char **UNUSED(argv), vo
 #  endif
   BLI_args_print_arg_doc(ba, "--debug-all");
   BLI_args_print_arg_doc(ba, "--debug-io");
+#  ifdef WITH_PROFILE_MARKERS
+  BLI_args_print_arg_doc(ba, "--profile-markers");
+#  endif
 
   printf("\n");
   BLI_args_print_arg_doc(ba, "--debug-fpe");
@@ -1108,6 +1117,42 @@ static int arg_handle_debug_fpe_set(int UNUSED(argc),
   return 0;
 }
 
+#  ifdef WITH_PROFILE_MARKERS
+static char profile_markers_filepath[FILE_MAX];
+
+static void profile_markers_write_at_exit(void *UNUSED(user_data))
+{
+  FILE *fp = BLI_fopen(profile_markers_filepath, "w");
+  if (fp == NULL) {
+    fprintf(stderr, "Could not write profile markers to '%s'\n", profile_markers_filepath);
+    BLI_profile_recording_end(NULL);
+    return;
+  }
+  BLI_profile_recording_end(fp);
+  fclose(fp);
+  printf("Profile markers written to '%s'\n", profile_markers_filepath);
+}
+
+static const char arg_handle_profile_markers_doc[] =
+    "<filepath>\n"
+    "\tRecord the profiling markers until Blender exits, and write them to a Chrome trace JSON\n"
+    "\tfile which can be opened in Perfetto.";
+static int arg_handle_profile_markers(int argc, const char **argv, void *UNUSED(data))
+{
+  if (argc > 1) {
+    if (!BLI_profile_is_recording()) {
+      BKE_blender_atexit_register(profile_markers_write_at_exit, NULL);
+    }
+    BLI_strncpy(profile_markers_filepath, argv[1], sizeof(profile_markers_filepath));
+    BLI_path_abs_from_cwd(profile_markers_filepath, sizeof(profile_markers_filepath));
+    BLI_profile_recording_begin();
+    return 1;
+  }
+  printf("\nError: you must specify a filepath after '--profile-markers'.\n");
+  return 0;
+}
+#  endif
+
 static const char arg_handle_app_template_doc[] =
     "<template>\n"
     "\tSet the application template (matching the directory name), use 'default' for none.";
@@ -1494,6 +1539,18 @@ static int arg_handle_threads_set(int argc, const char **argv, void *UNUSED(data
   return 0;
 }
 
+static const char arg_handle_threads_numa_set_doc[] =
+    "\n"
+    "\tOn systems with multiple NUMA nodes, distribute the work of large parallel loops over the\n"
+    "\tnodes, keeping memory local to the threads that use it.";
+static int arg_handle_threads_numa_set(int UNUSED(argc),
+                                       const char **UNUSED(argv),
+                                       void *UNUSED(data))
+{
+  BLI_task_scheduler_numa_set(true);
+  return 0;
+}
+
 static const char arg_handle_verbosity_set_doc[] =
     "<verbose>\n"
     "\tSet the logging verbosity level for debug messages that support it.";
@@ -1635,6 +1692,100 @@ static int arg_handle_render_animation(int UNUSED(argc), const char **UNUSED(arg
   return 0;
 }
 
+static const char arg_handle_render_worker_doc[] =
+    "\n\t"
+    "Keep the blend-file loaded and render the frames requested on the standard input, one\n"
+    "\tcommand per line, until the input ends:\n"
+    "\n"
+    "\t* 'frame <frame>' renders and saves a frame.\n"
+    "\t* 'scene <name>' sets the active scene.\n"
+    "\t* 'python <expression>' runs a Python expression, to change the scene in between frames.\n"
+    "\t* 'quit' stops the worker.\n"
+    "\n"
+    "\tEvery command is answered with a line starting with 'worker: done' or 'worker: error'.\n"
+    "\tThe render data is kept between frames, as with the 'Persistent Data' render option.";
+static int arg_handle_render_worker(int UNUSED(argc), const char **UNUSED(argv), void *data)
+{
+  bContext *C = data;
+  if (CTX_data_scene(C) == NULL) {
+    printf("\nError: no blend loaded. cannot use '--render-worker'.\n");
+    return 0;
+  }
+
+  /* Commands of up to 4096 characters, followed by the newline and the terminator. */
+  char line[4096 + 2];
+  printf("worker: ready\n");
+  fflush(stdout);
+  while (fgets(line, sizeof(line), stdin)) {
+    const size_t line_len = strlen(line);
+    if (line_len > 0 && line[line_len - 1] != '\n' && !feof(stdin)) {
+      /* Reject the whole line, rather than running what remains of it as another command. */
+      int c;
+      do {
+        c = fgetc(stdin);
+      } while (!ELEM(c, '\n', EOF));
+      printf("worker: error line longer than %d characters\n", (int)sizeof(line) - 2);
+      fflush(stdout);
+      continue;
+    }
+    BLI_str_rstrip(line);
+    Main *bmain = CTX_data_main(C);
+    Scene *scene = CTX_data_scene(C);
+    bool ok = true;
+
+    if (STREQ(line, "quit")) {
+      break;
+    }
+    if (STRPREFIX(line, "frame ")) {
+      const char *err_msg = NULL;
+      int frame;
+      if (parse_int_clamp(line + 6, NULL, MINAFRAME, MAXFRAME, &frame, &err_msg)) {
+        /* Keep the render engine data, only what changed is synchronized for the next frame. */
+        scene->r.mode |= R_PERSISTENT_DATA;
+        Render *re = RE_NewSceneRender(scene);
+        ReportList reports;
+        BKE_reports_init(&reports, RPT_STORE);
+        RE_SetReports(re, &reports);
+        /* A cancelled frame must not cancel the frames requested after it. */
+        G.is_break = false;
+        RE_RenderAnim(re, bmain, scene, NULL, NULL, frame, frame, scene->r.frame_step);
+        ok = !G.is_break && (BKE_reports_contain(&reports, RPT_ERROR) == false);
+        RE_SetReports(re, NULL);
+        BKE_reports_clear(&reports);
+      }
+      else {
+        printf("worker: error %s '%s'\n", err_msg, line);
+        fflush(stdout);
+        continue;
+      }
+    }
+    else if (STRPREFIX(line, "scene ")) {
+      scene = BKE_scene_set_name(bmain, line + 6);
+      if (scene) {
+        CTX_data_scene_set(C, scene);
+      }
+      ok = (scene != NULL);
+    }
+#  ifdef WITH_PYTHON
+    else if (STRPREFIX(line, "python ")) {
+      struct BlendePyContextStore py_c;
+      arg_py_context_backup(C, &py_c, "render worker");
+      ok = BPY_run_string_exec(C, NULL, line + 7);
+      arg_py_context_restore(C, &py_c);
+    }
+#  endif
+    else {
+      printf("worker: error unknown command '%s'\n", line);
+      fflush(stdout);
+      continue;
+    }
+
+    printf("worker: %s '%s'\n", ok ? "done" : "error", line);
+    fflush(stdout);
+  }
+  return 0;
+}
+
 static const char arg_handle_scene_set_doc[] =
     "<name>\n"
     "\tSet the active scene <name> for rendering.";
@@ -1918,6 +2069,26 @@ static int arg_handle_python_use_system_env_set(int UNUSED(argc),
   return 0;
 }
 
+static const char arg_handle_python_cache_dir_set_doc[] =
+    "<dir>\n"
+    "\tCache the compiled byte-code of scripts and add-ons in this directory\n"
+    "\t(see 'sys.pycache_prefix'). Speeds up starting from read-only installations,\n"
+    "\tsuch as on render farms.";
+static int arg_handle_python_cache_dir_set(int argc, const char **argv, void *UNUSED(data))
+{
+  if (argc > 1) {
+#  ifdef WITH_PYTHON
+    char dirpath[FILE_MAX];
+    BLI_strncpy(dirpath, argv[1], sizeof(dirpath));
+    BLI_path_abs_from_cwd(dirpath, sizeof(dirpath));
+    BPY_python_cache_dir_set(dirpath);
+#  endif
+    return 1;
+  }
+  printf("\nError: you must specify a directory after '--python-cache-dir'.\n");
+  return 0;
+}
+
 static const char arg_handle_addons_set_doc[] =
     "<addon(s)>\n"
     "\tComma separated list (no spaces) of add-ons to enable in addition to any default add-ons.";
@@ -2042,6 +2213,7 @@ void main_args_setup(bContext *C, bArgs *ba)
   BLI_args_pass_set(ba, ARG_PASS_ENVIRONMENT);
   BLI_args_add(
       ba, NULL, "--python-use-system-env", CB(arg_handle_python_use_system_env_set), NULL);
+  BLI_args_add(ba, NULL, "--python-cache-dir", CB(arg_handle_python_cache_dir_set), NULL);
 
   /* Note that we could add used environment variables too. */
   BLI_args_add(
@@ -2050,6 +2222,7 @@ void main_args_setup(bContext *C, bArgs *ba)
   BLI_args_add(ba, NULL, "--env-system-python", CB_EX(arg_handle_env_system_set, python), NULL);
 
   BLI_args_add(ba, "-t", "--threads", CB(arg_handle_threads_set), NULL);
+  BLI_args_add(ba, NULL, "--threads-numa", CB(arg_handle_threads_numa_set), NULL);
 
   /* Include in the environment pass so it's possible display errors initializing subsystems,
    * especially `bpy.appdir` since it's useful to show errors finding paths on startup. */
@@ -2204,6 +2377,9 @@ void main_args_setup(bContext *C, bArgs *ba)
                CB_EX(arg_handle_debug_mode_generic_set, gpu_force_workarounds),
                (void *)G_DEBUG_GPU_FORCE_WORKAROUNDS);
   BLI_args_add(ba, NULL, "--debug-exit-on-error", CB(arg_handle_debug_exit_on_error), NULL);
+#  ifdef WITH_PROFILE_MARKERS
+  BLI_args_add(ba, NULL, "--profile-markers", CB(arg_handle_profile_markers), NULL);
+#  endif
 
   BLI_args_add(ba, NULL, "--verbose", CB(arg_handle_verbosity_set), NULL);
 
@@ -2232,6 +2408,7 @@ void main_args_setup(bContext *C, bArgs *ba)
   BLI_args_pass_set(ba, ARG_PASS_FINAL);
   BLI_args_add(ba, "-f", "--render-frame", CB(arg_handle_render_frame), C);
   BLI_args_add(ba, "-a", "--render-anim", CB(arg_handle_render_animation), C);
+  BLI_args_add(ba, NULL, "--render-worker", CB(arg_handle_render_worker), C);
   BLI_args_add(ba, "-S", "--scene", CB(arg_handle_scene_set), C);
   BLI_args_add(ba, "-s", "--frame-start", CB(arg_handle_frame_start_set), C);
   BLI_args_add(ba, "-e", "--frame-end", CB(arg_handle_frame_end_set), C);
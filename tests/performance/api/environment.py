@@ -241,6 +241,11 @@ class TestEnvironment:
                       f'result = {modulename}.{functionname}(args)\n'
                       f'result = base64.b64encode(pickle.dumps(result))\n'
                       f'print("{output_prefix}" + result.decode())\n')
+        if foreground:
+            # Blender keeps running after the expression when it has a window.
+            expression += ('import bpy\n'
+                           'window = bpy.context.window_manager.windows[0]\n'
+                           'bpy.ops.wm.quit_blender({"window": window})\n')
 
         expr_args = blender_args + ['--python-expr', expression]
         lines = self.call_blender(expr_args, foreground=foreground)
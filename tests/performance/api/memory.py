@@ -0,0 +1,20 @@
+# Apache License, Version 2.0
+
+import sys
+from typing import Optional
+
+
+def peak_memory() -> Optional[float]:
+    # Peak resident memory of the current process in MB, to be called from
+    # inside Blender at the end of a test. Returns None on platforms without
+    # the resource module.
+    try:
+        import resource
+    except ImportError:
+        return None
+
+    peak = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss
+    # Bytes on macOS, kilobytes on other platforms.
+    if sys.platform == 'darwin':
+        return peak / (1024.0 * 1024.0)
+    return peak / 1024.0
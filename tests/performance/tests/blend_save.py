@@ -0,0 +1,61 @@
+# Apache License, Version 2.0
+
+import api
+import os
+
+
+def _run(args):
+    import bpy
+    import os
+    import time
+
+    filepath = args['filepath']
+
+    def save(compress):
+        start_time = time.time()
+        bpy.ops.wm.save_as_mainfile(filepath=filepath, compress=compress, copy=True)
+        return time.time() - start_time
+
+    # Save once so the output file exists, as when saving over a file.
+    time_initial = save(False)
+
+    start_time = time.time()
+    elapsed_time = 0.0
+    num_saves = 0
+
+    while elapsed_time < 10.0:
+        save(False)
+        num_saves += 1
+        elapsed_time = time.time() - start_time
+
+    time_compressed = save(True)
+    os.remove(filepath)
+
+    result = {'time': elapsed_time / num_saves,
+              'time_initial': time_initial,
+              'time_compressed': time_compressed}
+    peak_memory = api.peak_memory()
+    if peak_memory is not None:
+        result['peak_memory'] = peak_memory
+    return result
+
+
+class BlendSaveTest(api.Test):
+    def __init__(self, filepath):
+        self.filepath = filepath
+
+    def name(self):
+        return self.filepath.stem
+
+    def category(self):
+        return "blend_save"
+
+    def run(self, env, device_id):
+        args = {'filepath': str(env.log_file.parent / (env.log_file.stem + '.blend'))}
+        result, _ = env.run_in_blender(_run, args, [self.filepath])
+        return result
+
+
+def generate(env):
+    filepaths = env.find_blend_files('*/*')
+    return [BlendSaveTest(filepath) for filepath in filepaths]
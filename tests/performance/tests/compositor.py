@@ -0,0 +1,54 @@
+# Apache License, Version 2.0
+
+import api
+import os
+
+
+def _run(args):
+    import bpy
+    import time
+
+    scene = bpy.context.scene
+    scene.render.use_compositing = True
+    scene.use_nodes = True
+    scene.node_tree.execution_mode = args['execution_mode']
+
+    # Trees of benchmark files read their inputs from images, without Render Layers nodes,
+    # so that rendering only executes the compositor.
+    bpy.ops.render.render()
+
+    start_time = time.time()
+    elapsed_time = 0.0
+    num_executions = 0
+
+    while elapsed_time < 10.0:
+        bpy.ops.render.render()
+        num_executions += 1
+        elapsed_time = time.time() - start_time
+
+    result = {'time': elapsed_time / num_executions}
+    return result
+
+
+class CompositorTest(api.Test):
+    def __init__(self, filepath, execution_mode):
+        self.filepath = filepath
+        self.execution_mode = execution_mode
+
+    def name(self):
+        return f"{self.filepath.stem}_{self.execution_mode.lower()}"
+
+    def category(self):
+        return "compositor"
+
+    def run(self, env, device_id):
+        args = {'execution_mode': self.execution_mode}
+        result, _ = env.run_in_blender(_run, args, [self.filepath])
+        return result
+
+
+def generate(env):
+    filepaths = env.find_blend_files('compositor/*')
+    return [CompositorTest(filepath, execution_mode)
+            for filepath in filepaths
+            for execution_mode in ('TILED', 'FULL_FRAME')]
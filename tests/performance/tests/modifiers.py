@@ -0,0 +1,67 @@
+# Apache License, Version 2.0
+
+import api
+import os
+
+
+def _run(args):
+    import bpy
+    import time
+
+    # Initial evaluation of the whole scene.
+    start_time = time.time()
+    depsgraph = bpy.context.evaluated_depsgraph_get()
+    time_initial = time.time() - start_time
+
+    if args['use_nodes']:
+        objects = [ob for ob in bpy.context.scene.objects
+                   if any(md.type == 'NODES' for md in ob.modifiers)]
+    else:
+        objects = [ob for ob in bpy.context.scene.objects if len(ob.modifiers)]
+    if not objects:
+        raise Exception("No objects with modifiers to evaluate")
+
+    # Re-evaluate the modifier stacks, without changing the frame so that
+    # only the tagged objects are evaluated.
+    start_time = time.time()
+    elapsed_time = 0.0
+    num_evaluations = 0
+
+    while elapsed_time < 10.0:
+        for ob in objects:
+            ob.update_tag(refresh={'DATA'})
+        depsgraph.update()
+        num_evaluations += 1
+        elapsed_time = time.time() - start_time
+
+    result = {'time': elapsed_time / num_evaluations,
+              'time_initial': time_initial}
+    peak_memory = api.peak_memory()
+    if peak_memory is not None:
+        result['peak_memory'] = peak_memory
+    return result
+
+
+class ModifiersTest(api.Test):
+    def __init__(self, filepath, category):
+        self.filepath = filepath
+        self._category = category
+
+    def name(self):
+        return self.filepath.stem
+
+    def category(self):
+        return self._category
+
+    def run(self, env, device_id):
+        args = {'use_nodes': self._category == 'geometry_nodes'}
+        result, _ = env.run_in_blender(_run, args, [self.filepath])
+        return result
+
+
+def generate(env):
+    tests = []
+    for category in ('geometry_nodes', 'modifiers'):
+        filepaths = env.find_blend_files(f'{category}/*')
+        tests += [ModifiersTest(filepath, category) for filepath in filepaths]
+    return tests
@@ -0,0 +1,59 @@
+# Apache License, Version 2.0
+
+import api
+import os
+
+
+def _run(args):
+    import bpy
+    import time
+
+    # Undo is not initialized in background mode until the first push, which
+    # stores the whole file. Following pushes only write changed data-blocks.
+    start_time = time.time()
+    bpy.ops.ed.undo_push(message="Initial")
+    time_initial = time.time() - start_time
+
+    objects = [ob for ob in bpy.data.objects if ob.library is None]
+    if not objects:
+        raise Exception("No objects to change between undo pushes")
+
+    start_time = time.time()
+    elapsed_time = 0.0
+    num_pushes = 0
+
+    while elapsed_time < 10.0:
+        # Change one object for every step, as a transform would.
+        ob = objects[num_pushes % len(objects)]
+        ob.location[0] += 1e-3 if num_pushes % 2 == 0 else -1e-3
+        bpy.ops.ed.undo_push(message="Step")
+        num_pushes += 1
+        elapsed_time = time.time() - start_time
+
+    result = {'time': elapsed_time / num_pushes,
+              'time_initial': time_initial}
+    peak_memory = api.peak_memory()
+    if peak_memory is not None:
+        result['peak_memory'] = peak_memory
+    return result
+
+
+class UndoTest(api.Test):
+    def __init__(self, filepath):
+        self.filepath = filepath
+
+    def name(self):
+        return self.filepath.stem
+
+    def category(self):
+        return "undo"
+
+    def run(self, env, device_id):
+        args = {}
+        result, _ = env.run_in_blender(_run, args, [self.filepath])
+        return result
+
+
+def generate(env):
+    filepaths = env.find_blend_files('*/*')
+    return [UndoTest(filepath) for filepath in filepaths]
@@ -0,0 +1,90 @@
+# Apache License, Version 2.0
+
+import api
+import os
+
+
+def _run(args):
+    import bpy
+    import gpu
+    import time
+
+    window = bpy.context.window_manager.windows[0]
+    areas = [area for area in window.screen.areas if area.type == 'VIEW_3D']
+    if not areas:
+        raise Exception("No 3D viewport to draw")
+    space = areas[0].spaces.active
+    region = [region for region in areas[0].regions if region.type == 'WINDOW'][0]
+
+    scene = window.scene
+    view_layer = window.view_layer
+    view_matrix = space.region_3d.view_matrix
+    projection_matrix = space.region_3d.window_matrix
+    offscreen = gpu.types.GPUOffScreen(region.width, region.height)
+
+    def draw():
+        offscreen.draw_view3d(scene, view_layer, space, region, view_matrix, projection_matrix)
+        # Reading back the result waits for the GPU to finish drawing.
+        offscreen.texture_color.read()
+
+    # First redraw creates the draw caches. Shaders are compiled in a job
+    # which does not run here, so their compilation time is not measured.
+    start_time = time.time()
+    draw()
+    time_initial = time.time() - start_time
+
+    # Redraw without changes.
+    start_time = time.time()
+    elapsed_time = 0.0
+    num_redraws = 0
+
+    while elapsed_time < 5.0:
+        draw()
+        num_redraws += 1
+        elapsed_time = time.time() - start_time
+
+    time_redraw = elapsed_time / num_redraws
+
+    # Play back the animation, which also updates the draw caches.
+    start_time = time.time()
+    elapsed_time = 0.0
+    num_frames = 0
+
+    while elapsed_time < 5.0:
+        for i in range(scene.frame_start, scene.frame_end + 1):
+            scene.frame_set(i)
+            draw()
+
+        num_frames += scene.frame_end + 1 - scene.frame_start
+        elapsed_time = time.time() - start_time
+
+    offscreen.free()
+
+    result = {'time': time_redraw,
+              'time_initial': time_initial,
+              'time_animation': elapsed_time / num_frames}
+    peak_memory = api.peak_memory()
+    if peak_memory is not None:
+        result['peak_memory'] = peak_memory
+    return result
+
+
+class ViewportTest(api.Test):
+    def __init__(self, filepath):
+        self.filepath = filepath
+
+    def name(self):
+        return self.filepath.stem
+
+    def category(self):
+        return "viewport"
+
+    def run(self, env, device_id):
+        args = {}
+        result, _ = env.run_in_blender(_run, args, [self.filepath], foreground=True)
+        return result
+
+
+def generate(env):
+    filepaths = env.find_blend_files('viewport/*')
+    return [ViewportTest(filepath) for filepath in filepaths]